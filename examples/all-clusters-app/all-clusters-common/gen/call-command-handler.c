@@ -60,7 +60,7 @@
 #include "command-id.h"
 #include "util.h"
 
-static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecific)
+static EmberAfStatus commandStatus(bool wasHandled, bool clusterExists, bool mfgSpecific)
 {
     if (wasHandled)
     {
@@ -80,2220 +80,2105 @@ static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecifi
     }
 }
 
-// Main command parsing controller.
-EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
+// Cluster: Basic, server
+
+static EmberAfStatus emberAfBasicClusterResetToFactoryDefaultsCommandParse(EmberAfClusterCommand * cmd)
 {
-    EmberAfStatus result = status(false, false, cmd->mfgSpecific);
-    if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT &&
-        emberAfContainsClientWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfBasicClusterResetToFactoryDefaultsCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: Identify, client
+
+static EmberAfStatus emberAfIdentifyClusterIdentifyQueryResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t timeout; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    timeout = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
     {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_BASIC_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_IDENTIFY_CLUSTER_ID:
-            result = emberAfIdentifyClusterClientCommandParse(cmd);
-            break;
-        case ZCL_GROUPS_CLUSTER_ID:
-            result = emberAfGroupsClusterClientCommandParse(cmd);
-            break;
-        case ZCL_SCENES_CLUSTER_ID:
-            result = emberAfScenesClusterClientCommandParse(cmd);
-            break;
-        case ZCL_ON_OFF_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_ON_OFF_SWITCH_CONFIG_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_LEVEL_CONTROL_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_DOOR_LOCK_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_BARRIER_CONTROL_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_COLOR_CONTROL_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_IAS_ZONE_CLUSTER_ID:
-            result = emberAfIasZoneClusterClientCommandParse(cmd);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
     }
-    else if (cmd->direction == (uint8_t) ZCL_DIRECTION_CLIENT_TO_SERVER &&
-             emberAfContainsServerWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
+    wasHandled = emberAfIdentifyClusterIdentifyQueryResponseCallback(timeout);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: Identify, server
+
+static EmberAfStatus emberAfIdentifyClusterIdentifyCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t identifyTime; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    identifyTime = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
     {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_BASIC_CLUSTER_ID:
-            result = emberAfBasicClusterServerCommandParse(cmd);
-            break;
-        case ZCL_IDENTIFY_CLUSTER_ID:
-            result = emberAfIdentifyClusterServerCommandParse(cmd);
-            break;
-        case ZCL_GROUPS_CLUSTER_ID:
-            result = emberAfGroupsClusterServerCommandParse(cmd);
-            break;
-        case ZCL_SCENES_CLUSTER_ID:
-            result = emberAfScenesClusterServerCommandParse(cmd);
-            break;
-        case ZCL_ON_OFF_CLUSTER_ID:
-            result = emberAfOnOffClusterServerCommandParse(cmd);
-            break;
-        case ZCL_ON_OFF_SWITCH_CONFIG_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_LEVEL_CONTROL_CLUSTER_ID:
-            result = emberAfLevelControlClusterServerCommandParse(cmd);
-            break;
-        case ZCL_DOOR_LOCK_CLUSTER_ID:
-            result = emberAfDoorLockClusterServerCommandParse(cmd);
-            break;
-        case ZCL_BARRIER_CONTROL_CLUSTER_ID:
-            result = emberAfBarrierControlClusterServerCommandParse(cmd);
-            break;
-        case ZCL_COLOR_CONTROL_CLUSTER_ID:
-            result = emberAfColorControlClusterServerCommandParse(cmd);
-            break;
-        case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_IAS_ZONE_CLUSTER_ID:
-            result = emberAfIasZoneClusterServerCommandParse(cmd);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
-    }
-    return result;
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfIdentifyClusterIdentifyCallback(identifyTime);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Basic, server
-EmberAfStatus emberAfBasicClusterServerCommandParse(EmberAfClusterCommand * cmd)
+static EmberAfStatus emberAfIdentifyClusterIdentifyQueryCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfIdentifyClusterIdentifyQueryCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: Groups, client
+
+static EmberAfStatus emberAfGroupsClusterAddGroupResponseCommandParse(EmberAfClusterCommand * cmd)
 {
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
+    EmberAfCommandDecoder decoder;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
     {
-        switch (cmd->commandId)
-        {
-        case ZCL_RESET_TO_FACTORY_DEFAULTS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfBasicClusterResetToFactoryDefaultsCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
     }
-    return status(wasHandled, true, cmd->mfgSpecific);
+    wasHandled = emberAfGroupsClusterAddGroupResponseCallback(status, groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Identify, client
-EmberAfStatus emberAfIdentifyClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_IDENTIFY_QUERY_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t timeout; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            timeout    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfIdentifyClusterIdentifyQueryResponseCallback(timeout);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfGroupsClusterViewGroupResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;      // Ver.: always
+    uint16_t groupId;    // Ver.: always
+    uint8_t * groupName; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    status    = emberAfDecodeInt8u(&decoder);
+    groupId   = emberAfDecodeInt16u(&decoder);
+    groupName = emberAfDecodeString(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterViewGroupResponseCallback(status, groupId, groupName);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Identify, server
-EmberAfStatus emberAfIdentifyClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_IDENTIFY_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t identifyTime; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            identifyTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled   = emberAfIdentifyClusterIdentifyCallback(identifyTime);
-            break;
-        }
-        case ZCL_IDENTIFY_QUERY_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfIdentifyClusterIdentifyQueryCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfGroupsClusterGetGroupMembershipResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t capacity;    // Ver.: always
+    uint8_t groupCount;  // Ver.: always
+    uint8_t * groupList; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    capacity   = emberAfDecodeInt8u(&decoder);
+    groupCount = emberAfDecodeInt8u(&decoder);
+    groupList  = emberAfDecodeArray(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterGetGroupMembershipResponseCallback(capacity, groupCount, groupList);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Groups, client
-EmberAfStatus emberAfGroupsClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_GROUP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterAddGroupResponseCallback(status, groupId);
-            break;
-        }
-        case ZCL_VIEW_GROUP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;      // Ver.: always
-            uint16_t groupId;    // Ver.: always
-            uint8_t * groupName; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterViewGroupResponseCallback(status, groupId, groupName);
-            break;
-        }
-        case ZCL_GET_GROUP_MEMBERSHIP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t capacity;    // Ver.: always
-            uint8_t groupCount;  // Ver.: always
-            uint8_t * groupList; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            capacity = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupList  = cmd->buffer + payloadOffset;
-            wasHandled = emberAfGroupsClusterGetGroupMembershipResponseCallback(capacity, groupCount, groupList);
-            break;
-        }
-        case ZCL_REMOVE_GROUP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterRemoveGroupResponseCallback(status, groupId);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfGroupsClusterRemoveGroupResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterRemoveGroupResponseCallback(status, groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
 // Cluster: Groups, server
-EmberAfStatus emberAfGroupsClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_GROUP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;    // Ver.: always
-            uint8_t * groupName; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterAddGroupCallback(groupId, groupName);
-            break;
-        }
-        case ZCL_VIEW_GROUP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterViewGroupCallback(groupId);
-            break;
-        }
-        case ZCL_GET_GROUP_MEMBERSHIP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t groupCount;  // Ver.: always
-            uint8_t * groupList; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupList  = cmd->buffer + payloadOffset;
-            wasHandled = emberAfGroupsClusterGetGroupMembershipCallback(groupCount, groupList);
-            break;
-        }
-        case ZCL_REMOVE_GROUP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterRemoveGroupCallback(groupId);
-            break;
-        }
-        case ZCL_REMOVE_ALL_GROUPS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfGroupsClusterRemoveAllGroupsCallback();
-            break;
-        }
-        case ZCL_ADD_GROUP_IF_IDENTIFYING_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;    // Ver.: always
-            uint8_t * groupName; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterAddGroupIfIdentifyingCallback(groupId, groupName);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+
+static EmberAfStatus emberAfGroupsClusterAddGroupCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId;    // Ver.: always
+    uint8_t * groupName; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    groupId   = emberAfDecodeInt16u(&decoder);
+    groupName = emberAfDecodeString(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterAddGroupCallback(groupId, groupName);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfGroupsClusterViewGroupCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterViewGroupCallback(groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfGroupsClusterGetGroupMembershipCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t groupCount;  // Ver.: always
+    uint8_t * groupList; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 1
+    groupCount = emberAfDecodeInt8u(&decoder);
+    groupList  = emberAfDecodeArray(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterGetGroupMembershipCallback(groupCount, groupList);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfGroupsClusterRemoveGroupCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterRemoveGroupCallback(groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfGroupsClusterRemoveAllGroupsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfGroupsClusterRemoveAllGroupsCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfGroupsClusterAddGroupIfIdentifyingCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId;    // Ver.: always
+    uint8_t * groupName; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    groupId   = emberAfDecodeInt16u(&decoder);
+    groupName = emberAfDecodeString(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfGroupsClusterAddGroupIfIdentifyingCallback(groupId, groupName);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
 // Cluster: Scenes, client
-EmberAfStatus emberAfScenesClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterAddSceneResponseCallback(status, groupId, sceneId);
-            break;
-        }
-        case ZCL_VIEW_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;               // Ver.: always
-            uint16_t groupId;             // Ver.: always
-            uint8_t sceneId;              // Ver.: always
-            uint16_t transitionTime;      // Ver.: always
-            uint8_t * sceneName;          // Ver.: always
-            uint8_t * extensionFieldSets; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (!(status == 0))
-            {
-                // Argument is not always present:
-                // - it is conditionally present based on expression: status==0
-                transitionTime = 0xFFFF;
-            }
-            else
-            {
-                transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 2u;
-            }
-            if (!(status == 0))
-            {
-                // Argument is not always present:
-                // - it is conditionally present based on expression: status==0
-                sceneName = NULL;
-            }
-            else
-            {
-                sceneName = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += emberAfStringLength(cmd->buffer + payloadOffset) + 1u;
-            }
-            if (status == 0)
-            {
-                // Array is conditionally present based on expression: status==0
-                extensionFieldSets = cmd->buffer + payloadOffset;
-            }
-            else
-            {
-                extensionFieldSets = NULL;
-            }
-            wasHandled = emberAfScenesClusterViewSceneResponseCallback(status, groupId, sceneId, transitionTime, sceneName,
-                                                                       extensionFieldSets);
-            break;
-        }
-        case ZCL_REMOVE_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveSceneResponseCallback(status, groupId, sceneId);
-            break;
-        }
-        case ZCL_REMOVE_ALL_SCENES_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveAllScenesResponseCallback(status, groupId);
-            break;
-        }
-        case ZCL_STORE_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterStoreSceneResponseCallback(status, groupId, sceneId);
-            break;
-        }
-        case ZCL_GET_SCENE_MEMBERSHIP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;      // Ver.: always
-            uint8_t capacity;    // Ver.: always
-            uint16_t groupId;    // Ver.: always
-            uint8_t sceneCount;  // Ver.: always
-            uint8_t * sceneList; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            capacity = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (!(status == 0))
-            {
-                // Argument is not always present:
-                // - it is conditionally present based on expression: status==0
-                sceneCount = 0xFF;
-            }
-            else
-            {
-                sceneCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if (status == 0)
-            {
-                // Array is conditionally present based on expression: status==0
-                sceneList = cmd->buffer + payloadOffset;
-            }
-            else
-            {
-                sceneList = NULL;
-            }
-            wasHandled = emberAfScenesClusterGetSceneMembershipResponseCallback(status, capacity, groupId, sceneCount, sceneList);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+
+static EmberAfStatus emberAfScenesClusterAddSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 4
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterAddSceneResponseCallback(status, groupId, sceneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterViewSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;               // Ver.: always
+    uint16_t groupId;             // Ver.: always
+    uint8_t sceneId;              // Ver.: always
+    uint16_t transitionTime;      // Ver.: always
+    uint8_t * sceneName;          // Ver.: always
+    uint8_t * extensionFieldSets; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (!(status == 0))
+    {
+        // Argument is not always present:
+        // - it is conditionally present based on expression: status==0
+        transitionTime = 0xFFFF;
+    }
+    else
+    {
+        transitionTime = emberAfDecodeInt16u(&decoder);
+    }
+    if (!(status == 0))
+    {
+        // Argument is not always present:
+        // - it is conditionally present based on expression: status==0
+        sceneName = NULL;
+    }
+    else
+    {
+        sceneName = emberAfDecodeString(&decoder);
+    }
+    if (status == 0)
+    {
+        // Array is conditionally present based on expression: status==0
+        extensionFieldSets = emberAfDecodeArray(&decoder);
+    }
+    else
+    {
+        extensionFieldSets = NULL;
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterViewSceneResponseCallback(status, groupId, sceneId, transitionTime, sceneName,
+                                                               extensionFieldSets);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterRemoveSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 4
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterRemoveSceneResponseCallback(status, groupId, sceneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterRemoveAllScenesResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterRemoveAllScenesResponseCallback(status, groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterStoreSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 4
+    status  = emberAfDecodeInt8u(&decoder);
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterStoreSceneResponseCallback(status, groupId, sceneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterGetSceneMembershipResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t status;      // Ver.: always
+    uint8_t capacity;    // Ver.: always
+    uint16_t groupId;    // Ver.: always
+    uint8_t sceneCount;  // Ver.: always
+    uint8_t * sceneList; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    status   = emberAfDecodeInt8u(&decoder);
+    capacity = emberAfDecodeInt8u(&decoder);
+    groupId  = emberAfDecodeInt16u(&decoder);
+    if (!(status == 0))
+    {
+        // Argument is not always present:
+        // - it is conditionally present based on expression: status==0
+        sceneCount = 0xFF;
+    }
+    else
+    {
+        sceneCount = emberAfDecodeInt8u(&decoder);
+    }
+    if (status == 0)
+    {
+        // Array is conditionally present based on expression: status==0
+        sceneList = emberAfDecodeArray(&decoder);
+    }
+    else
+    {
+        sceneList = NULL;
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterGetSceneMembershipResponseCallback(status, capacity, groupId, sceneCount, sceneList);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
 // Cluster: Scenes, server
-EmberAfStatus emberAfScenesClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;             // Ver.: always
-            uint8_t sceneId;              // Ver.: always
-            uint16_t transitionTime;      // Ver.: always
-            uint8_t * sceneName;          // Ver.: always
-            uint8_t * extensionFieldSets; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneName = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += emberAfStringLength(cmd->buffer + payloadOffset) + 1u;
-            extensionFieldSets = cmd->buffer + payloadOffset;
-            wasHandled = emberAfScenesClusterAddSceneCallback(groupId, sceneId, transitionTime, sceneName, extensionFieldSets);
-            break;
-        }
-        case ZCL_VIEW_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterViewSceneCallback(groupId, sceneId);
-            break;
-        }
-        case ZCL_REMOVE_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveSceneCallback(groupId, sceneId);
-            break;
-        }
-        case ZCL_REMOVE_ALL_SCENES_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveAllScenesCallback(groupId);
-            break;
-        }
-        case ZCL_STORE_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterStoreSceneCallback(groupId, sceneId);
-            break;
-        }
-        case ZCL_RECALL_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;        // Ver.: always
-            uint8_t sceneId;         // Ver.: always
-            uint16_t transitionTime; // Ver.: since zcl-7.0-07-5123-07
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 2u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl-7.0-07-5123-07
-                transitionTime = 0xFFFF;
-            }
-            else
-            {
-                transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfScenesClusterRecallSceneCallback(groupId, sceneId, transitionTime);
-            break;
-        }
-        case ZCL_GET_SCENE_MEMBERSHIP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterGetSceneMembershipCallback(groupId);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+
+static EmberAfStatus emberAfScenesClusterAddSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId;             // Ver.: always
+    uint8_t sceneId;              // Ver.: always
+    uint16_t transitionTime;      // Ver.: always
+    uint8_t * sceneName;          // Ver.: always
+    uint8_t * extensionFieldSets; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    groupId            = emberAfDecodeInt16u(&decoder);
+    sceneId            = emberAfDecodeInt8u(&decoder);
+    transitionTime     = emberAfDecodeInt16u(&decoder);
+    sceneName          = emberAfDecodeString(&decoder);
+    extensionFieldSets = emberAfDecodeArray(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterAddSceneCallback(groupId, sceneId, transitionTime, sceneName, extensionFieldSets);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterViewSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterViewSceneCallback(groupId, sceneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterRemoveSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterRemoveSceneCallback(groupId, sceneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterRemoveAllScenesCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterRemoveAllScenesCallback(groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterStoreSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterStoreSceneCallback(groupId, sceneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterRecallSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId;        // Ver.: always
+    uint8_t sceneId;         // Ver.: always
+    uint16_t transitionTime; // Ver.: since zcl-7.0-07-5123-07
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    groupId = emberAfDecodeInt16u(&decoder);
+    sceneId = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 2u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl-7.0-07-5123-07
+        transitionTime = 0xFFFF;
+    }
+    else
+    {
+        transitionTime = emberAfDecodeInt16u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterRecallSceneCallback(groupId, sceneId, transitionTime);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfScenesClusterGetSceneMembershipCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t groupId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    groupId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfScenesClusterGetSceneMembershipCallback(groupId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
 // Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_OFF_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOffCallback();
-            break;
-        }
-        case ZCL_ON_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOnCallback();
-            break;
-        }
-        case ZCL_TOGGLE_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterToggleCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+
+static EmberAfStatus emberAfOnOffClusterOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOffCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfOnOffClusterOnCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOnCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfOnOffClusterToggleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterToggleCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
 // Cluster: Level Control, server
-EmberAfStatus emberAfLevelControlClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_MOVE_TO_LEVEL_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t level;           // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            level = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterMoveToLevelCallback(level, transitionTime, optionMask, optionOverride);
-            break;
-        }
-        case ZCL_MOVE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;       // Ver.: always
-            uint8_t rate;           // Ver.: always
-            uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterMoveCallback(moveMode, rate, optionMask, optionOverride);
-            break;
-        }
-        case ZCL_STEP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterStepCallback(stepMode, stepSize, transitionTime, optionMask, optionOverride);
-            break;
-        }
-        case ZCL_STOP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterStopCallback(optionMask, optionOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_LEVEL_WITH_ON_OFF_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t level;           // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            level = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled     = emberAfLevelControlClusterMoveToLevelWithOnOffCallback(level, transitionTime);
-            break;
-        }
-        case ZCL_MOVE_WITH_ON_OFF_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode; // Ver.: always
-            uint8_t rate;     // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            rate       = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfLevelControlClusterMoveWithOnOffCallback(moveMode, rate);
-            break;
-        }
-        case ZCL_STEP_WITH_ON_OFF_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled     = emberAfLevelControlClusterStepWithOnOffCallback(stepMode, stepSize, transitionTime);
-            break;
-        }
-        case ZCL_STOP_WITH_ON_OFF_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfLevelControlClusterStopWithOnOffCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+
+static EmberAfStatus emberAfLevelControlClusterMoveToLevelCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t level;           // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    level          = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterMoveToLevelCallback(level, transitionTime, optionMask, optionOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Door Lock, server
-EmberAfStatus emberAfDoorLockClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_LOCK_DOOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                PIN = NULL;
-            }
-            else
-            {
-                PIN = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfDoorLockClusterLockDoorCallback(PIN);
-            break;
-        }
-        case ZCL_UNLOCK_DOOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                PIN = NULL;
-            }
-            else
-            {
-                PIN = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfDoorLockClusterUnlockDoorCallback(PIN);
-            break;
-        }
-        case ZCL_UNLOCK_WITH_TIMEOUT_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t timeoutInSeconds; // Ver.: always
-            uint8_t * pin;             // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            timeoutInSeconds = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                pin = NULL;
-            }
-            else
-            {
-                pin = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfDoorLockClusterUnlockWithTimeoutCallback(timeoutInSeconds, pin);
-            break;
-        }
-        case ZCL_GET_LOG_RECORD_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t logIndex; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            logIndex   = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetLogRecordCallback(logIndex);
-            break;
-        }
-        case ZCL_SET_PIN_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId;    // Ver.: always
-            uint8_t userStatus; // Ver.: always
-            uint8_t userType;   // Ver.: always
-            uint8_t * pin;      // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userType = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            pin        = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetPinCallback(userId, userStatus, userType, pin);
-            break;
-        }
-        case ZCL_GET_PIN_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetPinCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_PIN_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearPinCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_ALL_PINS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfDoorLockClusterClearAllPinsCallback();
-            break;
-        }
-        case ZCL_SET_WEEKDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId;  // Ver.: always
-            uint16_t userId;     // Ver.: always
-            uint8_t daysMask;    // Ver.: always
-            uint8_t startHour;   // Ver.: always
-            uint8_t startMinute; // Ver.: always
-            uint8_t endHour;     // Ver.: always
-            uint8_t endMinute;   // Ver.: always
-            // Command is fixed length: 8
-            if (cmd->bufLen < payloadOffset + 8u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            daysMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            startHour = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            startMinute = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            endHour = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            endMinute  = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetWeekdayScheduleCallback(scheduleId, userId, daysMask, startHour, startMinute,
-                                                                          endHour, endMinute);
-            break;
-        }
-        case ZCL_GET_WEEKDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetWeekdayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_CLEAR_WEEKDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearWeekdayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_SET_YEARDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId;      // Ver.: always
-            uint16_t userId;         // Ver.: always
-            uint32_t localStartTime; // Ver.: always
-            uint32_t localEndTime;   // Ver.: always
-            // Command is fixed length: 11
-            if (cmd->bufLen < payloadOffset + 11u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            localStartTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 4u;
-            localEndTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled   = emberAfDoorLockClusterSetYeardayScheduleCallback(scheduleId, userId, localStartTime, localEndTime);
-            break;
-        }
-        case ZCL_GET_YEARDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetYeardayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_CLEAR_YEARDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearYeardayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_SET_HOLIDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId;                 // Ver.: always
-            uint32_t localStartTime;            // Ver.: always
-            uint32_t localEndTime;              // Ver.: always
-            uint8_t operatingModeDuringHoliday; // Ver.: always
-            // Command is fixed length: 10
-            if (cmd->bufLen < payloadOffset + 10u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            localStartTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 4u;
-            localEndTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 4u;
-            operatingModeDuringHoliday = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled                 = emberAfDoorLockClusterSetHolidayScheduleCallback(scheduleId, localStartTime, localEndTime,
-                                                                          operatingModeDuringHoliday);
-            break;
-        }
-        case ZCL_GET_HOLIDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetHolidayScheduleCallback(scheduleId);
-            break;
-        }
-        case ZCL_CLEAR_HOLIDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearHolidayScheduleCallback(scheduleId);
-            break;
-        }
-        case ZCL_SET_USER_TYPE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId;  // Ver.: always
-            uint8_t userType; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            userType   = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetUserTypeCallback(userId, userType);
-            break;
-        }
-        case ZCL_GET_USER_TYPE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetUserTypeCallback(userId);
-            break;
-        }
-        case ZCL_SET_RFID_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId;    // Ver.: always
-            uint8_t userStatus; // Ver.: always
-            uint8_t userType;   // Ver.: always
-            uint8_t * id;       // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userType = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            id         = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetRfidCallback(userId, userStatus, userType, id);
-            break;
-        }
-        case ZCL_GET_RFID_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetRfidCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_RFID_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearRfidCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_ALL_RFIDS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfDoorLockClusterClearAllRfidsCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfLevelControlClusterMoveCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t moveMode;       // Ver.: always
+    uint8_t rate;           // Ver.: always
+    uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    moveMode = emberAfDecodeInt8u(&decoder);
+    rate     = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterMoveCallback(moveMode, rate, optionMask, optionOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Barrier Control, server
-EmberAfStatus emberAfBarrierControlClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_BARRIER_CONTROL_GO_TO_PERCENT_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t percentOpen; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            percentOpen = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled  = emberAfBarrierControlClusterBarrierControlGoToPercentCallback(percentOpen);
-            break;
-        }
-        case ZCL_BARRIER_CONTROL_STOP_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfBarrierControlClusterBarrierControlStopCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfLevelControlClusterStepCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    stepMode       = emberAfDecodeInt8u(&decoder);
+    stepSize       = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterStepCallback(stepMode, stepSize, transitionTime, optionMask, optionOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: Color Control, server
-EmberAfStatus emberAfColorControlClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_MOVE_TO_HUE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t hue;             // Ver.: always
-            uint8_t direction;       // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            hue = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            direction = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveToHueCallback(hue, direction, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_HUE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;        // Ver.: always
-            uint8_t rate;            // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveHueCallback(moveMode, rate, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_HUE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint8_t transitionTime;  // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterStepHueCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t saturation;      // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            saturation = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterMoveToSaturationCallback(saturation, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;        // Ver.: always
-            uint8_t rate;            // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveSaturationCallback(moveMode, rate, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint8_t transitionTime;  // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterStepSaturationCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_HUE_AND_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t hue;             // Ver.: always
-            uint8_t saturation;      // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            hue = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            saturation = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveToHueAndSaturationCallback(hue, saturation, transitionTime, optionsMask,
-                                                                                  optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_COLOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t colorX;         // Ver.: always
-            uint16_t colorY;         // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterMoveToColorCallback(colorX, colorY, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_COLOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            int16_t rateX;           // Ver.: always
-            int16_t rateY;           // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rateX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rateY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveColorCallback(rateX, rateY, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_COLOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            int16_t stepX;           // Ver.: always
-            int16_t stepY;           // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterStepColorCallback(stepX, stepY, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_COLOR_TEMPERATURE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t colorTemperature; // Ver.: always
-            uint16_t transitionTime;   // Ver.: always
-            uint8_t optionsMask;       // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride;   // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperature = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveToColorTemperatureCallback(colorTemperature, transitionTime, optionsMask,
-                                                                                  optionsOverride);
-            break;
-        }
-        case ZCL_STOP_MOVE_STEP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterStopMoveStepCallback(optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_COLOR_TEMPERATURE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;                 // Ver.: always
-            uint16_t rate;                    // Ver.: always
-            uint16_t colorTemperatureMinimum; // Ver.: always
-            uint16_t colorTemperatureMaximum; // Ver.: always
-            uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMinimum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMaximum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveColorTemperatureCallback(
-                moveMode, rate, colorTemperatureMinimum, colorTemperatureMaximum, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_COLOR_TEMPERATURE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;                 // Ver.: always
-            uint16_t stepSize;                // Ver.: always
-            uint16_t transitionTime;          // Ver.: always
-            uint16_t colorTemperatureMinimum; // Ver.: always
-            uint16_t colorTemperatureMaximum; // Ver.: always
-            uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMinimum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMaximum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterStepColorTemperatureCallback(
-                stepMode, stepSize, transitionTime, colorTemperatureMinimum, colorTemperatureMaximum, optionsMask, optionsOverride);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfLevelControlClusterStopCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterStopCallback(optionMask, optionOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: IAS Zone, client
-EmberAfStatus emberAfIasZoneClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ZONE_STATUS_CHANGE_NOTIFICATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t zoneStatus;    // Ver.: always
-            uint8_t extendedStatus; // Ver.: always
-            uint8_t zoneId;         // Ver.: since ha-1.2-05-3520-29
-            uint16_t delay;         // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            zoneStatus = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            extendedStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                zoneId = 0xFF;
-            }
-            else
-            {
-                zoneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 2u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                delay = 0xFFFF;
-            }
-            else
-            {
-                delay = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfIasZoneClusterZoneStatusChangeNotificationCallback(zoneStatus, extendedStatus, zoneId, delay);
-            break;
-        }
-        case ZCL_ZONE_ENROLL_REQUEST_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t zoneType;         // Ver.: always
-            uint16_t manufacturerCode; // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            zoneType = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            manufacturerCode = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled       = emberAfIasZoneClusterZoneEnrollRequestCallback(zoneType, manufacturerCode);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfLevelControlClusterMoveToLevelWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t level;           // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    level          = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterMoveToLevelWithOnOffCallback(level, transitionTime);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
 }
 
-// Cluster: IAS Zone, server
-EmberAfStatus emberAfIasZoneClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ZONE_ENROLL_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t enrollResponseCode; // Ver.: always
-            uint8_t zoneId;             // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            enrollResponseCode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            zoneId     = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfIasZoneClusterZoneEnrollResponseCallback(enrollResponseCode, zoneId);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus emberAfLevelControlClusterMoveWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t moveMode; // Ver.: always
+    uint8_t rate;     // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    moveMode = emberAfDecodeInt8u(&decoder);
+    rate     = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterMoveWithOnOffCallback(moveMode, rate);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfLevelControlClusterStepWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 4
+    stepMode       = emberAfDecodeInt8u(&decoder);
+    stepSize       = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfLevelControlClusterStepWithOnOffCallback(stepMode, stepSize, transitionTime);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfLevelControlClusterStopWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfLevelControlClusterStopWithOnOffCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: Door Lock, server
+
+static EmberAfStatus emberAfDoorLockClusterLockDoorCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    if (!emberAfCommandDecoderHasString(&decoder))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        PIN = NULL;
+    }
+    else
+    {
+        PIN = emberAfDecodeString(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterLockDoorCallback(PIN);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterUnlockDoorCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    if (!emberAfCommandDecoderHasString(&decoder))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        PIN = NULL;
+    }
+    else
+    {
+        PIN = emberAfDecodeString(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterUnlockDoorCallback(PIN);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterUnlockWithTimeoutCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t timeoutInSeconds; // Ver.: always
+    uint8_t * pin;             // Ver.: since ha-1.2-05-3520-29
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    timeoutInSeconds = emberAfDecodeInt16u(&decoder);
+    if (!emberAfCommandDecoderHasString(&decoder))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        pin = NULL;
+    }
+    else
+    {
+        pin = emberAfDecodeString(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterUnlockWithTimeoutCallback(timeoutInSeconds, pin);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetLogRecordCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t logIndex; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    logIndex = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetLogRecordCallback(logIndex);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterSetPinCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId;    // Ver.: always
+    uint8_t userStatus; // Ver.: always
+    uint8_t userType;   // Ver.: always
+    uint8_t * pin;      // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    userId     = emberAfDecodeInt16u(&decoder);
+    userStatus = emberAfDecodeInt8u(&decoder);
+    userType   = emberAfDecodeInt8u(&decoder);
+    pin        = emberAfDecodeString(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterSetPinCallback(userId, userStatus, userType, pin);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetPinCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    userId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetPinCallback(userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearPinCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    userId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterClearPinCallback(userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearAllPinsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfDoorLockClusterClearAllPinsCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterSetWeekdayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId;  // Ver.: always
+    uint16_t userId;     // Ver.: always
+    uint8_t daysMask;    // Ver.: always
+    uint8_t startHour;   // Ver.: always
+    uint8_t startMinute; // Ver.: always
+    uint8_t endHour;     // Ver.: always
+    uint8_t endMinute;   // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 8
+    scheduleId  = emberAfDecodeInt8u(&decoder);
+    userId      = emberAfDecodeInt16u(&decoder);
+    daysMask    = emberAfDecodeInt8u(&decoder);
+    startHour   = emberAfDecodeInt8u(&decoder);
+    startMinute = emberAfDecodeInt8u(&decoder);
+    endHour     = emberAfDecodeInt8u(&decoder);
+    endMinute   = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterSetWeekdayScheduleCallback(scheduleId, userId, daysMask, startHour, startMinute, endHour,
+                                                                  endMinute);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetWeekdayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    scheduleId = emberAfDecodeInt8u(&decoder);
+    userId     = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetWeekdayScheduleCallback(scheduleId, userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearWeekdayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    scheduleId = emberAfDecodeInt8u(&decoder);
+    userId     = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterClearWeekdayScheduleCallback(scheduleId, userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterSetYeardayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId;      // Ver.: always
+    uint16_t userId;         // Ver.: always
+    uint32_t localStartTime; // Ver.: always
+    uint32_t localEndTime;   // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 11
+    scheduleId     = emberAfDecodeInt8u(&decoder);
+    userId         = emberAfDecodeInt16u(&decoder);
+    localStartTime = emberAfDecodeInt32u(&decoder);
+    localEndTime   = emberAfDecodeInt32u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterSetYeardayScheduleCallback(scheduleId, userId, localStartTime, localEndTime);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetYeardayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    scheduleId = emberAfDecodeInt8u(&decoder);
+    userId     = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetYeardayScheduleCallback(scheduleId, userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearYeardayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    scheduleId = emberAfDecodeInt8u(&decoder);
+    userId     = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterClearYeardayScheduleCallback(scheduleId, userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterSetHolidayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId;                 // Ver.: always
+    uint32_t localStartTime;            // Ver.: always
+    uint32_t localEndTime;              // Ver.: always
+    uint8_t operatingModeDuringHoliday; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 10
+    scheduleId                 = emberAfDecodeInt8u(&decoder);
+    localStartTime             = emberAfDecodeInt32u(&decoder);
+    localEndTime               = emberAfDecodeInt32u(&decoder);
+    operatingModeDuringHoliday = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterSetHolidayScheduleCallback(scheduleId, localStartTime, localEndTime,
+                                                                  operatingModeDuringHoliday);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetHolidayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 1
+    scheduleId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetHolidayScheduleCallback(scheduleId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearHolidayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t scheduleId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 1
+    scheduleId = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterClearHolidayScheduleCallback(scheduleId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterSetUserTypeCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId;  // Ver.: always
+    uint8_t userType; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 3
+    userId   = emberAfDecodeInt16u(&decoder);
+    userType = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterSetUserTypeCallback(userId, userType);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetUserTypeCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    userId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetUserTypeCallback(userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterSetRfidCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId;    // Ver.: always
+    uint8_t userStatus; // Ver.: always
+    uint8_t userType;   // Ver.: always
+    uint8_t * id;       // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    userId     = emberAfDecodeInt16u(&decoder);
+    userStatus = emberAfDecodeInt8u(&decoder);
+    userType   = emberAfDecodeInt8u(&decoder);
+    id         = emberAfDecodeString(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterSetRfidCallback(userId, userStatus, userType, id);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterGetRfidCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    userId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterGetRfidCallback(userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearRfidCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t userId; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    userId = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfDoorLockClusterClearRfidCallback(userId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfDoorLockClusterClearAllRfidsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfDoorLockClusterClearAllRfidsCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: Barrier Control, server
+
+static EmberAfStatus emberAfBarrierControlClusterBarrierControlGoToPercentCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t percentOpen; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 1
+    percentOpen = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfBarrierControlClusterBarrierControlGoToPercentCallback(percentOpen);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfBarrierControlClusterBarrierControlStopCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfBarrierControlClusterBarrierControlStopCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: Color Control, server
+
+static EmberAfStatus emberAfColorControlClusterMoveToHueCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t hue;             // Ver.: always
+    uint8_t direction;       // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    hue            = emberAfDecodeInt8u(&decoder);
+    direction      = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveToHueCallback(hue, direction, transitionTime, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveHueCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t moveMode;        // Ver.: always
+    uint8_t rate;            // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    moveMode = emberAfDecodeInt8u(&decoder);
+    rate     = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveHueCallback(moveMode, rate, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterStepHueCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint8_t transitionTime;  // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    stepMode       = emberAfDecodeInt8u(&decoder);
+    stepSize       = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterStepHueCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveToSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t saturation;      // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    saturation     = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveToSaturationCallback(saturation, transitionTime, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t moveMode;        // Ver.: always
+    uint8_t rate;            // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    moveMode = emberAfDecodeInt8u(&decoder);
+    rate     = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveSaturationCallback(moveMode, rate, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterStepSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint8_t transitionTime;  // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    stepMode       = emberAfDecodeInt8u(&decoder);
+    stepSize       = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterStepSaturationCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveToHueAndSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t hue;             // Ver.: always
+    uint8_t saturation;      // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    hue            = emberAfDecodeInt8u(&decoder);
+    saturation     = emberAfDecodeInt8u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveToHueAndSaturationCallback(hue, saturation, transitionTime, optionsMask,
+                                                                          optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveToColorCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t colorX;         // Ver.: always
+    uint16_t colorY;         // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    colorX         = emberAfDecodeInt16u(&decoder);
+    colorY         = emberAfDecodeInt16u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveToColorCallback(colorX, colorY, transitionTime, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveColorCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    int16_t rateX;           // Ver.: always
+    int16_t rateY;           // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    rateX = emberAfDecodeInt16u(&decoder);
+    rateY = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveColorCallback(rateX, rateY, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterStepColorCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    int16_t stepX;           // Ver.: always
+    int16_t stepY;           // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    stepX          = emberAfDecodeInt16u(&decoder);
+    stepY          = emberAfDecodeInt16u(&decoder);
+    transitionTime = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterStepColorCallback(stepX, stepY, transitionTime, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveToColorTemperatureCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t colorTemperature; // Ver.: always
+    uint16_t transitionTime;   // Ver.: always
+    uint8_t optionsMask;       // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride;   // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    colorTemperature = emberAfDecodeInt16u(&decoder);
+    transitionTime   = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveToColorTemperatureCallback(colorTemperature, transitionTime, optionsMask,
+                                                                          optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterStopMoveStepCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterStopMoveStepCallback(optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterMoveColorTemperatureCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t moveMode;                 // Ver.: always
+    uint16_t rate;                    // Ver.: always
+    uint16_t colorTemperatureMinimum; // Ver.: always
+    uint16_t colorTemperatureMaximum; // Ver.: always
+    uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    moveMode                = emberAfDecodeInt8u(&decoder);
+    rate                    = emberAfDecodeInt16u(&decoder);
+    colorTemperatureMinimum = emberAfDecodeInt16u(&decoder);
+    colorTemperatureMaximum = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterMoveColorTemperatureCallback(moveMode, rate, colorTemperatureMinimum,
+                                                                        colorTemperatureMaximum, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfColorControlClusterStepColorTemperatureCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t stepMode;                 // Ver.: always
+    uint16_t stepSize;                // Ver.: always
+    uint16_t transitionTime;          // Ver.: always
+    uint16_t colorTemperatureMinimum; // Ver.: always
+    uint16_t colorTemperatureMaximum; // Ver.: always
+    uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    stepMode                = emberAfDecodeInt8u(&decoder);
+    stepSize                = emberAfDecodeInt16u(&decoder);
+    transitionTime          = emberAfDecodeInt16u(&decoder);
+    colorTemperatureMinimum = emberAfDecodeInt16u(&decoder);
+    colorTemperatureMaximum = emberAfDecodeInt16u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfDecodeInt8u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfColorControlClusterStepColorTemperatureCallback(stepMode, stepSize, transitionTime, colorTemperatureMinimum,
+                                                                        colorTemperatureMaximum, optionsMask, optionsOverride);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: IAS Zone, client
+
+static EmberAfStatus emberAfIasZoneClusterZoneStatusChangeNotificationCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t zoneStatus;    // Ver.: always
+    uint8_t extendedStatus; // Ver.: always
+    uint8_t zoneId;         // Ver.: since ha-1.2-05-3520-29
+    uint16_t delay;         // Ver.: since ha-1.2-05-3520-29
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is not a fixed length
+    zoneStatus     = emberAfDecodeInt16u(&decoder);
+    extendedStatus = emberAfDecodeInt8u(&decoder);
+    if (emberAfCommandDecoderRemaining(&decoder) < 1u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        zoneId = 0xFF;
+    }
+    else
+    {
+        zoneId = emberAfDecodeInt8u(&decoder);
+    }
+    if (emberAfCommandDecoderRemaining(&decoder) < 2u)
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        delay = 0xFFFF;
+    }
+    else
+    {
+        delay = emberAfDecodeInt16u(&decoder);
+    }
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfIasZoneClusterZoneStatusChangeNotificationCallback(zoneStatus, extendedStatus, zoneId, delay);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfIasZoneClusterZoneEnrollRequestCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint16_t zoneType;         // Ver.: always
+    uint16_t manufacturerCode; // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 4
+    zoneType         = emberAfDecodeInt16u(&decoder);
+    manufacturerCode = emberAfDecodeInt16u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfIasZoneClusterZoneEnrollRequestCallback(zoneType, manufacturerCode);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Cluster: IAS Zone, server
+
+static EmberAfStatus emberAfIasZoneClusterZoneEnrollResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandDecoder decoder;
+    uint8_t enrollResponseCode; // Ver.: always
+    uint8_t zoneId;             // Ver.: always
+    bool wasHandled;
+    emberAfCommandDecoderInit(&decoder, cmd);
+    // Command is fixed length: 2
+    enrollResponseCode = emberAfDecodeInt8u(&decoder);
+    zoneId             = emberAfDecodeInt8u(&decoder);
+    if (decoder.malformed)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    wasHandled = emberAfIasZoneClusterZoneEnrollResponseCallback(enrollResponseCode, zoneId);
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Commands sent from clients to the servers of this application, laid out for
+// emberAfFindCommandHandler().
+static const EmberAfCommandDispatchEntry serverCommandDispatchEntries[256] = {
+    [0] = { ZCL_BASIC_CLUSTER_ID, ZCL_RESET_TO_FACTORY_DEFAULTS_COMMAND_ID, emberAfBasicClusterResetToFactoryDefaultsCommandParse },
+    [1] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_HUE_COMMAND_ID, emberAfColorControlClusterMoveToHueCommandParse },
+    [2] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_HUE_COMMAND_ID, emberAfColorControlClusterMoveHueCommandParse },
+    [3] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_STEP_HUE_COMMAND_ID, emberAfColorControlClusterStepHueCommandParse },
+    [4] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_SATURATION_COMMAND_ID,
+            emberAfColorControlClusterMoveToSaturationCommandParse },
+    [5] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_SATURATION_COMMAND_ID, emberAfColorControlClusterMoveSaturationCommandParse },
+    [6] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_STEP_SATURATION_COMMAND_ID, emberAfColorControlClusterStepSaturationCommandParse },
+    [7] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_HUE_AND_SATURATION_COMMAND_ID,
+            emberAfColorControlClusterMoveToHueAndSaturationCommandParse },
+    [8] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_COLOR_COMMAND_ID, emberAfColorControlClusterMoveToColorCommandParse },
+    [9] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_COLOR_COMMAND_ID, emberAfColorControlClusterMoveColorCommandParse },
+    [10] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_STEP_COLOR_COMMAND_ID, emberAfColorControlClusterStepColorCommandParse },
+    [11] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_COLOR_TEMPERATURE_COMMAND_ID,
+             emberAfColorControlClusterMoveToColorTemperatureCommandParse },
+    [12] = { ZCL_IAS_ZONE_CLUSTER_ID, ZCL_ZONE_ENROLL_RESPONSE_COMMAND_ID, emberAfIasZoneClusterZoneEnrollResponseCommandParse },
+    [31] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_DOOR_COMMAND_ID, emberAfDoorLockClusterLockDoorCommandParse },
+    [32] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_UNLOCK_DOOR_COMMAND_ID, emberAfDoorLockClusterUnlockDoorCommandParse },
+    [34] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_UNLOCK_WITH_TIMEOUT_COMMAND_ID, emberAfDoorLockClusterUnlockWithTimeoutCommandParse },
+    [35] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_LOG_RECORD_COMMAND_ID, emberAfDoorLockClusterGetLogRecordCommandParse },
+    [36] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_SET_PIN_COMMAND_ID, emberAfDoorLockClusterSetPinCommandParse },
+    [37] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_PIN_COMMAND_ID, emberAfDoorLockClusterGetPinCommandParse },
+    [38] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_PIN_COMMAND_ID, emberAfDoorLockClusterClearPinCommandParse },
+    [39] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_ALL_PINS_COMMAND_ID, emberAfDoorLockClusterClearAllPinsCommandParse },
+    [42] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_SET_WEEKDAY_SCHEDULE_COMMAND_ID, emberAfDoorLockClusterSetWeekdayScheduleCommandParse },
+    [43] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_WEEKDAY_SCHEDULE_COMMAND_ID, emberAfDoorLockClusterGetWeekdayScheduleCommandParse },
+    [44] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_WEEKDAY_SCHEDULE_COMMAND_ID,
+             emberAfDoorLockClusterClearWeekdayScheduleCommandParse },
+    [45] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_SET_YEARDAY_SCHEDULE_COMMAND_ID, emberAfDoorLockClusterSetYeardayScheduleCommandParse },
+    [46] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_YEARDAY_SCHEDULE_COMMAND_ID, emberAfDoorLockClusterGetYeardayScheduleCommandParse },
+    [47] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_YEARDAY_SCHEDULE_COMMAND_ID,
+             emberAfDoorLockClusterClearYeardayScheduleCommandParse },
+    [48] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_SET_HOLIDAY_SCHEDULE_COMMAND_ID, emberAfDoorLockClusterSetHolidayScheduleCommandParse },
+    [49] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_HOLIDAY_SCHEDULE_COMMAND_ID, emberAfDoorLockClusterGetHolidayScheduleCommandParse },
+    [50] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_HOLIDAY_SCHEDULE_COMMAND_ID,
+             emberAfDoorLockClusterClearHolidayScheduleCommandParse },
+    [51] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_SET_USER_TYPE_COMMAND_ID, emberAfDoorLockClusterSetUserTypeCommandParse },
+    [52] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_USER_TYPE_COMMAND_ID, emberAfDoorLockClusterGetUserTypeCommandParse },
+    [53] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_SET_RFID_COMMAND_ID, emberAfDoorLockClusterSetRfidCommandParse },
+    [54] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_GET_RFID_COMMAND_ID, emberAfDoorLockClusterGetRfidCommandParse },
+    [55] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_RFID_COMMAND_ID, emberAfDoorLockClusterClearRfidCommandParse },
+    [56] = { ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_CLEAR_ALL_RFIDS_COMMAND_ID, emberAfDoorLockClusterClearAllRfidsCommandParse },
+    [71] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_STOP_MOVE_STEP_COMMAND_ID, emberAfColorControlClusterStopMoveStepCommandParse },
+    [75] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_MOVE_COLOR_TEMPERATURE_COMMAND_ID,
+             emberAfColorControlClusterMoveColorTemperatureCommandParse },
+    [76] = { ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_STEP_COLOR_TEMPERATURE_COMMAND_ID,
+             emberAfColorControlClusterStepColorTemperatureCommandParse },
+    [93] = { ZCL_IDENTIFY_CLUSTER_ID, ZCL_IDENTIFY_COMMAND_ID, emberAfIdentifyClusterIdentifyCommandParse },
+    [94] = { ZCL_IDENTIFY_CLUSTER_ID, ZCL_IDENTIFY_QUERY_COMMAND_ID, emberAfIdentifyClusterIdentifyQueryCommandParse },
+    [95] = { ZCL_BARRIER_CONTROL_CLUSTER_ID, ZCL_BARRIER_CONTROL_GO_TO_PERCENT_COMMAND_ID,
+             emberAfBarrierControlClusterBarrierControlGoToPercentCommandParse },
+    [96] = { ZCL_BARRIER_CONTROL_CLUSTER_ID, ZCL_BARRIER_CONTROL_STOP_COMMAND_ID,
+             emberAfBarrierControlClusterBarrierControlStopCommandParse },
+    [124] = { ZCL_GROUPS_CLUSTER_ID, ZCL_ADD_GROUP_COMMAND_ID, emberAfGroupsClusterAddGroupCommandParse },
+    [125] = { ZCL_GROUPS_CLUSTER_ID, ZCL_VIEW_GROUP_COMMAND_ID, emberAfGroupsClusterViewGroupCommandParse },
+    [126] = { ZCL_GROUPS_CLUSTER_ID, ZCL_GET_GROUP_MEMBERSHIP_COMMAND_ID, emberAfGroupsClusterGetGroupMembershipCommandParse },
+    [127] = { ZCL_GROUPS_CLUSTER_ID, ZCL_REMOVE_GROUP_COMMAND_ID, emberAfGroupsClusterRemoveGroupCommandParse },
+    [128] = { ZCL_GROUPS_CLUSTER_ID, ZCL_REMOVE_ALL_GROUPS_COMMAND_ID, emberAfGroupsClusterRemoveAllGroupsCommandParse },
+    [129] = { ZCL_GROUPS_CLUSTER_ID, ZCL_ADD_GROUP_IF_IDENTIFYING_COMMAND_ID,
+              emberAfGroupsClusterAddGroupIfIdentifyingCommandParse },
+    [155] = { ZCL_SCENES_CLUSTER_ID, ZCL_ADD_SCENE_COMMAND_ID, emberAfScenesClusterAddSceneCommandParse },
+    [156] = { ZCL_SCENES_CLUSTER_ID, ZCL_VIEW_SCENE_COMMAND_ID, emberAfScenesClusterViewSceneCommandParse },
+    [157] = { ZCL_SCENES_CLUSTER_ID, ZCL_REMOVE_SCENE_COMMAND_ID, emberAfScenesClusterRemoveSceneCommandParse },
+    [158] = { ZCL_SCENES_CLUSTER_ID, ZCL_REMOVE_ALL_SCENES_COMMAND_ID, emberAfScenesClusterRemoveAllScenesCommandParse },
+    [159] = { ZCL_SCENES_CLUSTER_ID, ZCL_STORE_SCENE_COMMAND_ID, emberAfScenesClusterStoreSceneCommandParse },
+    [160] = { ZCL_SCENES_CLUSTER_ID, ZCL_RECALL_SCENE_COMMAND_ID, emberAfScenesClusterRecallSceneCommandParse },
+    [161] = { ZCL_SCENES_CLUSTER_ID, ZCL_GET_SCENE_MEMBERSHIP_COMMAND_ID, emberAfScenesClusterGetSceneMembershipCommandParse },
+    [186] = { ZCL_ON_OFF_CLUSTER_ID, ZCL_OFF_COMMAND_ID, emberAfOnOffClusterOffCommandParse },
+    [187] = { ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_COMMAND_ID, emberAfOnOffClusterOnCommandParse },
+    [188] = { ZCL_ON_OFF_CLUSTER_ID, ZCL_TOGGLE_COMMAND_ID, emberAfOnOffClusterToggleCommandParse },
+    [248] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_LEVEL_COMMAND_ID, emberAfLevelControlClusterMoveToLevelCommandParse },
+    [249] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_MOVE_COMMAND_ID, emberAfLevelControlClusterMoveCommandParse },
+    [250] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_STEP_COMMAND_ID, emberAfLevelControlClusterStepCommandParse },
+    [251] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_STOP_COMMAND_ID, emberAfLevelControlClusterStopCommandParse },
+    [252] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_MOVE_TO_LEVEL_WITH_ON_OFF_COMMAND_ID,
+              emberAfLevelControlClusterMoveToLevelWithOnOffCommandParse },
+    [253] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_MOVE_WITH_ON_OFF_COMMAND_ID, emberAfLevelControlClusterMoveWithOnOffCommandParse },
+    [254] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_STEP_WITH_ON_OFF_COMMAND_ID, emberAfLevelControlClusterStepWithOnOffCommandParse },
+    [255] = { ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_STOP_WITH_ON_OFF_COMMAND_ID, emberAfLevelControlClusterStopWithOnOffCommandParse },
+};
+
+const EmberAfCommandDispatchTable emberAfServerCommandDispatchTable = { serverCommandDispatchEntries, 256 };
+
+// Commands sent from servers to the clients of this application, laid out for
+// emberAfFindCommandHandler().
+static const EmberAfCommandDispatchEntry clientCommandDispatchEntries[32] = {
+    [0] = { ZCL_GROUPS_CLUSTER_ID, ZCL_REMOVE_GROUP_RESPONSE_COMMAND_ID, emberAfGroupsClusterRemoveGroupResponseCommandParse },
+    [1] = { ZCL_SCENES_CLUSTER_ID, ZCL_VIEW_SCENE_RESPONSE_COMMAND_ID, emberAfScenesClusterViewSceneResponseCommandParse },
+    [2] = { ZCL_SCENES_CLUSTER_ID, ZCL_REMOVE_SCENE_RESPONSE_COMMAND_ID, emberAfScenesClusterRemoveSceneResponseCommandParse },
+    [3] = { ZCL_SCENES_CLUSTER_ID, ZCL_REMOVE_ALL_SCENES_RESPONSE_COMMAND_ID,
+            emberAfScenesClusterRemoveAllScenesResponseCommandParse },
+    [4] = { ZCL_SCENES_CLUSTER_ID, ZCL_STORE_SCENE_RESPONSE_COMMAND_ID, emberAfScenesClusterStoreSceneResponseCommandParse },
+    [5] = { ZCL_SCENES_CLUSTER_ID, ZCL_GET_SCENE_MEMBERSHIP_RESPONSE_COMMAND_ID,
+            emberAfScenesClusterGetSceneMembershipResponseCommandParse },
+    [6] = { ZCL_IAS_ZONE_CLUSTER_ID, ZCL_ZONE_STATUS_CHANGE_NOTIFICATION_COMMAND_ID,
+            emberAfIasZoneClusterZoneStatusChangeNotificationCommandParse },
+    [7] = { ZCL_IAS_ZONE_CLUSTER_ID, ZCL_ZONE_ENROLL_REQUEST_COMMAND_ID, emberAfIasZoneClusterZoneEnrollRequestCommandParse },
+    [27] = { ZCL_SCENES_CLUSTER_ID, ZCL_ADD_SCENE_RESPONSE_COMMAND_ID, emberAfScenesClusterAddSceneResponseCommandParse },
+    [28] = { ZCL_GROUPS_CLUSTER_ID, ZCL_ADD_GROUP_RESPONSE_COMMAND_ID, emberAfGroupsClusterAddGroupResponseCommandParse },
+    [29] = { ZCL_IDENTIFY_CLUSTER_ID, ZCL_IDENTIFY_QUERY_RESPONSE_COMMAND_ID,
+             emberAfIdentifyClusterIdentifyQueryResponseCommandParse },
+    [30] = { ZCL_GROUPS_CLUSTER_ID, ZCL_VIEW_GROUP_RESPONSE_COMMAND_ID, emberAfGroupsClusterViewGroupResponseCommandParse },
+    [31] = { ZCL_GROUPS_CLUSTER_ID, ZCL_GET_GROUP_MEMBERSHIP_RESPONSE_COMMAND_ID,
+             emberAfGroupsClusterGetGroupMembershipResponseCommandParse },
+};
+
+const EmberAfCommandDispatchTable emberAfClientCommandDispatchTable = { clientCommandDispatchEntries, 32 };
+
+// Whether the server of the cluster is one this application parses commands for, even if it
+// handles none of them.
+static bool isServerCluster(EmberAfClusterId clusterId)
+{
+    switch (clusterId)
+    {
+    case ZCL_BASIC_CLUSTER_ID:
+    case ZCL_IDENTIFY_CLUSTER_ID:
+    case ZCL_GROUPS_CLUSTER_ID:
+    case ZCL_SCENES_CLUSTER_ID:
+    case ZCL_ON_OFF_CLUSTER_ID:
+    case ZCL_ON_OFF_SWITCH_CONFIG_CLUSTER_ID:
+    case ZCL_LEVEL_CONTROL_CLUSTER_ID:
+    case ZCL_DOOR_LOCK_CLUSTER_ID:
+    case ZCL_BARRIER_CONTROL_CLUSTER_ID:
+    case ZCL_COLOR_CONTROL_CLUSTER_ID:
+    case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
+    case ZCL_IAS_ZONE_CLUSTER_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Whether the client of the cluster is one this application parses commands for, even if it
+// handles none of them.
+static bool isClientCluster(EmberAfClusterId clusterId)
+{
+    switch (clusterId)
+    {
+    case ZCL_BASIC_CLUSTER_ID:
+    case ZCL_IDENTIFY_CLUSTER_ID:
+    case ZCL_GROUPS_CLUSTER_ID:
+    case ZCL_SCENES_CLUSTER_ID:
+    case ZCL_ON_OFF_CLUSTER_ID:
+    case ZCL_ON_OFF_SWITCH_CONFIG_CLUSTER_ID:
+    case ZCL_LEVEL_CONTROL_CLUSTER_ID:
+    case ZCL_DOOR_LOCK_CLUSTER_ID:
+    case ZCL_BARRIER_CONTROL_CLUSTER_ID:
+    case ZCL_COLOR_CONTROL_CLUSTER_ID:
+    case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
+    case ZCL_IAS_ZONE_CLUSTER_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static EmberAfCommandHandler findHandler(const EmberAfCommandDispatchTable * table, EmberAfClusterCommand * cmd)
+{
+    return cmd->mfgSpecific ? NULL : emberAfFindCommandHandler(table, cmd->apsFrame->clusterId, cmd->commandId);
+}
+
+// Main command parsing controller.
+EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
+{
+    EmberAfCommandHandler handler = NULL;
+    bool clusterExists            = false;
+    if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT &&
+        emberAfContainsClientWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
+    {
+        handler       = findHandler(&emberAfClientCommandDispatchTable, cmd);
+        clusterExists = (handler != NULL) || isClientCluster(cmd->apsFrame->clusterId);
+    }
+    else if (cmd->direction == (uint8_t) ZCL_DIRECTION_CLIENT_TO_SERVER &&
+             emberAfContainsServerWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
+    {
+        handler       = findHandler(&emberAfServerCommandDispatchTable, cmd);
+        clusterExists = (handler != NULL) || isServerCluster(cmd->apsFrame->clusterId);
+    }
+    if (handler == NULL)
+    {
+        // Unrecognized cluster or command ID, error status will apply.
+        return commandStatus(false, clusterExists, cmd->mfgSpecific);
+    }
+    return handler(cmd);
 }
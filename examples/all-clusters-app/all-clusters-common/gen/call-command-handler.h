@@ -40,50 +40,23 @@
 #define SILABS_EMBER_AF_COMMAND_PARSE_HEADER
 
 #include "af-types.h"
+#include "command-dispatch.h"
 
-// This is a set of generated prototype for functions that parse the
-// the incomming message, and call appropriate command handler.
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
 
-// Cluster: Basic, server
-EmberAfStatus emberAfBasicClusterServerCommandParse(EmberAfClusterCommand * cmd);
+// This is a set of generated tables of the functions that parse the
+// incoming message, and call appropriate command handler.
 
-// Cluster: Identify, client
-EmberAfStatus emberAfIdentifyClusterClientCommandParse(EmberAfClusterCommand * cmd);
+// Commands sent from clients to the servers of this application.
+extern const EmberAfCommandDispatchTable emberAfServerCommandDispatchTable;
 
-// Cluster: Identify, server
-EmberAfStatus emberAfIdentifyClusterServerCommandParse(EmberAfClusterCommand * cmd);
+// Commands sent from servers to the clients of this application.
+extern const EmberAfCommandDispatchTable emberAfClientCommandDispatchTable;
 
-// Cluster: Groups, client
-EmberAfStatus emberAfGroupsClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Groups, server
-EmberAfStatus emberAfGroupsClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Scenes, client
-EmberAfStatus emberAfScenesClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Scenes, server
-EmberAfStatus emberAfScenesClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Level Control, server
-EmberAfStatus emberAfLevelControlClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Door Lock, server
-EmberAfStatus emberAfDoorLockClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Barrier Control, server
-EmberAfStatus emberAfBarrierControlClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Color Control, server
-EmberAfStatus emberAfColorControlClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: IAS Zone, client
-EmberAfStatus emberAfIasZoneClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: IAS Zone, server
-EmberAfStatus emberAfIasZoneClusterServerCommandParse(EmberAfClusterCommand * cmd);
+#ifdef __cplusplus
+} // extern "C"
+#endif // #ifdef __cplusplus
 
 #endif // SILABS_EMBER_AF_COMMAND_PARSE_HEADER
@@ -0,0 +1,371 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a round-trip benchmark of batch messages against
+ *      the all-clusters-app. It reads every attribute of every server
+ *      cluster of the app, once with one read attributes message per
+ *      cluster and endpoint and once with batch messages. The requests go
+ *      through a secure session over a loopback transport to
+ *      HandleDataModelMessage(), and the responses come back the same way
+ *      and are decoded record by record. It reports the microseconds and
+ *      the messages per round.
+ *
+ *      Usage: all-clusters-batch-benchmark [<rounds>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "af.h"
+
+#include <DataModelHandler.h>
+#include <SessionManager.h>
+#include <app/chip-zcl-zpro-codec.h>
+#include <app/util/attribute-storage.h>
+#include <support/CHIPMem.h>
+#include <support/ErrorStr.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/SecurePairingSession.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/raw/Base.h>
+
+using namespace chip;
+
+extern "C" {
+// The cluster implementations of the all-clusters-app call these application callbacks, as in main.cpp.
+void emberAfPostAttributeChangeCallback(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId, uint8_t mask,
+                                        uint16_t manufacturerCode, uint8_t type, uint8_t size, uint8_t * value)
+{}
+
+void emberAfPluginBasicResetToFactoryDefaultsCallback(uint8_t endpointId) {}
+
+bool emberAfPluginDoorLockServerActivateDoorLockCallback(bool activate)
+{
+    return true;
+}
+} // extern "C"
+
+namespace {
+
+constexpr uint32_t kDefaultRounds = 1000;
+
+// The node both sends the requests and answers them.
+constexpr NodeId kNodeId = 12344321;
+
+constexpr size_t kMaxReads          = 64;
+constexpr size_t kMaxReadAttributes = 32;
+constexpr uint16_t kMaxBatchLength  = 1024;
+
+// One read attributes command: every server attribute of a cluster on an endpoint.
+struct Read
+{
+    EndpointId endpoint;
+    ClusterId cluster;
+    uint16_t attributeIds[kMaxReadAttributes];
+    uint16_t attributeCount;
+};
+
+Read sReads[kMaxReads];
+size_t sReadCount;
+
+uint32_t sRequestMessages;
+uint32_t sResponseMessages;
+uint32_t sAnsweredReads;
+bool sServing;
+
+class LoopbackTransport : public Transport::Base
+{
+public:
+    CHIP_ERROR Init(const char * unused) { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR SendMessage(const PacketHeader & header, Header::Flags payloadFlags, const Transport::PeerAddress & address,
+                           System::PacketBuffer * msgBuf) override
+    {
+        HandleMessageReceived(header, address, msgBuf);
+        return CHIP_NO_ERROR;
+    }
+
+    bool CanSendToPeer(const Transport::PeerAddress & address) override { return true; }
+};
+
+SecureSessionMgr<LoopbackTransport> sSessions;
+
+uint64_t GetMonotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Counts a ZCL response that answers a read, as a Read Attributes Response
+// or as the Default Response a read gets when its response cannot be sent.
+void CountResponse(const uint8_t * message, uint16_t messageLength)
+{
+    uint8_t commandId;
+
+    if (messageLength < EMBER_AF_ZCL_OVERHEAD || (message[0] & ZCL_MANUFACTURER_SPECIFIC_MASK) != 0)
+    {
+        return;
+    }
+
+    commandId = message[EMBER_AF_ZCL_OVERHEAD - 1];
+    if (commandId == ZCL_READ_ATTRIBUTES_RESPONSE_COMMAND_ID ||
+        (commandId == ZCL_DEFAULT_RESPONSE_COMMAND_ID && messageLength > EMBER_AF_ZCL_OVERHEAD &&
+         message[EMBER_AF_ZCL_OVERHEAD] == ZCL_READ_ATTRIBUTES_COMMAND_ID))
+    {
+        sAnsweredReads++;
+    }
+}
+
+void DecodeResponses(uint8_t * buffer, uint16_t length)
+{
+    uint8_t * message;
+    uint16_t messageLength;
+
+    sResponseMessages++;
+
+    if (!isBatchMessage(buffer, length))
+    {
+        messageLength = extractMessage(buffer, length, &message);
+        CountResponse(message, messageLength);
+        return;
+    }
+
+    for (uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH; offset < length;)
+    {
+        EmberApsFrame frame;
+        uint16_t recordOffset = offset;
+
+        messageLength = extractBatchMessage(buffer, length, &offset, &frame, &message);
+        if (offset == recordOffset)
+        {
+            break;
+        }
+        CountResponse(message, messageLength);
+    }
+}
+
+class BenchmarkCallback : public SecureSessionMgrDelegate
+{
+public:
+    void OnMessageReceived(const PacketHeader & header, const PayloadHeader & payloadHeader, Transport::PeerConnectionState * state,
+                           System::PacketBuffer * buffer, SecureSessionMgrBase * mgr) override
+    {
+        // The loopback transport delivers the responses while the app is
+        // still handling the request, so anything received in the meantime
+        // is a response.
+        if (!sServing)
+        {
+            sServing = true;
+            HandleDataModelMessage(header, buffer, mgr);
+            sServing = false;
+            return;
+        }
+
+        DecodeResponses(buffer->Start(), buffer->DataLength());
+        System::PacketBuffer::Free(buffer);
+    }
+};
+
+BenchmarkCallback sCallback;
+
+} // namespace
+
+// The app sends its responses through this session manager, so they come back
+// over the loopback transport.
+SecureSessionMgrBase & chip::SessionManager()
+{
+    return sSessions;
+}
+
+namespace {
+
+void Send(const uint8_t * message, uint16_t length)
+{
+    System::PacketBuffer * buffer = System::PacketBuffer::NewWithAvailableSize(length);
+    CHIP_ERROR err                = CHIP_ERROR_NO_MEMORY;
+
+    if (buffer != nullptr)
+    {
+        memcpy(buffer->Start(), message, length);
+        buffer->SetDataLength(length);
+        err = sSessions.SendMessage(kNodeId, buffer);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to send a request: %s\n", ErrorStr(err));
+        exit(EXIT_FAILURE);
+    }
+    sRequestMessages++;
+}
+
+uint16_t AddRead(uint8_t * batch, uint16_t batchLength, const Read & read)
+{
+    return encodeBatchReadAttributesCommand(batch, kMaxBatchLength, batchLength, read.endpoint, read.cluster, read.attributeIds,
+                                            read.attributeCount);
+}
+
+// Sends each read on its own, as the APS frame and ZCL message of a one record batch.
+void SendReads()
+{
+    uint8_t batch[kMaxBatchLength];
+
+    for (size_t i = 0; i < sReadCount; i++)
+    {
+        uint8_t * record;
+        uint16_t offset       = CHIP_ZCL_BATCH_HEADER_LENGTH;
+        uint16_t length       = AddRead(batch, encodeBatchHeader(batch, sizeof(batch)), sReads[i]);
+        uint16_t recordLength = extractBatchRecord(batch, length, &offset, &record);
+
+        Send(record, recordLength);
+    }
+}
+
+// Sends the reads in as few batch messages as they fit in.
+void SendBatchedReads()
+{
+    uint8_t batch[kMaxBatchLength];
+    uint16_t length = encodeBatchHeader(batch, sizeof(batch));
+
+    for (size_t i = 0; i < sReadCount; i++)
+    {
+        uint16_t newLength = AddRead(batch, length, sReads[i]);
+        if (newLength == 0)
+        {
+            Send(batch, length);
+            newLength = AddRead(batch, encodeBatchHeader(batch, sizeof(batch)), sReads[i]);
+        }
+        length = newLength;
+    }
+
+    Send(batch, length);
+}
+
+// Collects the reads of every server cluster of every enabled endpoint of the app.
+void CollectReads()
+{
+    for (uint8_t index = 0; index < emberAfEndpointCount(); index++)
+    {
+        EndpointId endpoint = emberAfEndpointFromIndex(index);
+        if (!emberAfEndpointIndexIsEnabled(index))
+        {
+            continue;
+        }
+
+        for (uint8_t n = 0; n < emberAfClusterCount(endpoint, true) && sReadCount < kMaxReads; n++)
+        {
+            const EmberAfCluster * cluster = emberAfGetNthCluster(endpoint, n, true);
+            Read & read                    = sReads[sReadCount++];
+
+            read.endpoint       = endpoint;
+            read.cluster        = cluster->clusterId;
+            read.attributeCount = 0;
+            for (uint16_t i = 0; i < cluster->attributeCount && read.attributeCount < kMaxReadAttributes; i++)
+            {
+                read.attributeIds[read.attributeCount++] = cluster->attributes[i].attributeId;
+            }
+        }
+    }
+}
+
+/**
+ * Sends all the reads the given number of times, one by one or in batches.
+ * Returns the microseconds per round.
+ */
+double TimeRounds(void (*sendReads)(), uint32_t rounds)
+{
+    sRequestMessages  = 0;
+    sResponseMessages = 0;
+    sAnsweredReads    = 0;
+
+    uint64_t startNs = GetMonotonicNs();
+
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        sendReads();
+    }
+
+    uint64_t elapsedNs = GetMonotonicNs() - startNs;
+
+    if (sAnsweredReads != rounds * sReadCount)
+    {
+        fprintf(stderr, "%" PRIu32 " of %zu reads answered\n", sAnsweredReads, rounds * sReadCount);
+        exit(EXIT_FAILURE);
+    }
+
+    return static_cast<double>(elapsedNs) / 1000.0 / static_cast<double>(rounds);
+}
+
+void Report(const char * name, void (*sendReads)(), uint32_t rounds)
+{
+    double usPerRound = TimeRounds(sendReads, rounds);
+
+    printf("%-8s %10.2f us per round, %6.2f requests and %6.2f responses per round\n", name, usPerRound,
+           static_cast<double>(sRequestMessages) / rounds, static_cast<double>(sResponseMessages) / rounds);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    CHIP_ERROR err  = CHIP_NO_ERROR;
+    uint32_t rounds = kDefaultRounds;
+    System::Layer systemLayer;
+    Optional<Transport::PeerAddress> peer(Transport::Type::kUndefined);
+    SecurePairingUsingTestSecret pairing(Optional<NodeId>::Value(kNodeId), 1, 1);
+
+    if (argc > 1)
+    {
+        rounds = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (rounds == 0)
+    {
+        fprintf(stderr, "Usage: %s [<rounds>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    SuccessOrExit(err = Platform::MemoryInit());
+    SuccessOrExit(err = systemLayer.Init(nullptr));
+    SuccessOrExit(err = sSessions.Init(kNodeId, &systemLayer, "LOOPBACK"));
+    SuccessOrExit(err = sSessions.NewPairing(peer, &pairing));
+    sSessions.SetDelegate(&sCallback);
+
+    InitDataModelHandler();
+    CollectReads();
+
+    printf("%zu reads of server clusters\n", sReadCount);
+    Report("Single", SendReads, rounds);
+    Report("Batched", SendBatchedReads, rounds);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to set up the benchmark: %s\n", ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,310 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the dispatch of cluster-specific
+ *      commands in the all-clusters-app. It sends every command of the
+ *      generated dispatch tables, and a command the app does not handle for
+ *      each of their clusters, to an endpoint with the cluster through
+ *      emberAfProcessMessage(), which looks up the command handler, decodes
+ *      the command arguments and calls the command callback. The responses go
+ *      through a secure session over a loopback transport and are checked for
+ *      commands that were not dispatched. It reports the nanoseconds per
+ *      command.
+ *
+ *      Usage: all-clusters-dispatch-benchmark [<rounds>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "af.h"
+#include "gen/call-command-handler.h"
+
+#include <DataModelHandler.h>
+#include <SessionManager.h>
+#include <app/chip-zcl-zpro-codec.h>
+#include <app/util/command-dispatch.h>
+#include <app/util/util.h>
+#include <support/CHIPMem.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/SecurePairingSession.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/raw/Base.h>
+
+using namespace chip;
+
+extern "C" {
+// The cluster implementations of the all-clusters-app call these application callbacks, as in main.cpp.
+void emberAfPostAttributeChangeCallback(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId, uint8_t mask,
+                                        uint16_t manufacturerCode, uint8_t type, uint8_t size, uint8_t * value)
+{}
+
+void emberAfPluginBasicResetToFactoryDefaultsCallback(uint8_t endpointId) {}
+
+bool emberAfPluginDoorLockServerActivateDoorLockCallback(bool activate)
+{
+    return true;
+}
+} // extern "C"
+
+namespace {
+
+constexpr uint32_t kDefaultRounds = 10000;
+
+// The node both sends the commands and gets the responses to them.
+constexpr NodeId kNodeId = 12344321;
+
+// A command ID no cluster of the all-clusters-app handles, for the commands that are not dispatched.
+constexpr uint8_t kUnhandledCommandId = 0xF0;
+
+constexpr size_t kMaxCommands = 256;
+
+// Zeros decode as valid arguments of every command: zero integers and empty strings and arrays.
+constexpr uint16_t kArgumentsLength = 16;
+
+// One cluster-specific command, as it reaches emberAfProcessMessage().
+struct Command
+{
+    EmberApsFrame apsFrame;
+    uint8_t message[EMBER_AF_ZCL_OVERHEAD + kArgumentsLength];
+};
+
+Command sCommands[kMaxCommands];
+size_t sCommandCount;
+
+// The Default Responses to the commands, by status.
+uint32_t sUnsupportedCommands;
+uint32_t sRejectedCommands;
+
+class LoopbackTransport : public Transport::Base
+{
+public:
+    CHIP_ERROR Init(const char * unused) { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR SendMessage(const PacketHeader & header, Header::Flags payloadFlags, const Transport::PeerAddress & address,
+                           System::PacketBuffer * msgBuf) override
+    {
+        HandleMessageReceived(header, address, msgBuf);
+        return CHIP_NO_ERROR;
+    }
+
+    bool CanSendToPeer(const Transport::PeerAddress & address) override { return true; }
+};
+
+SecureSessionMgr<LoopbackTransport> sSessions;
+
+uint64_t GetMonotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Counts the Default Responses that report a command as not dispatched.
+class BenchmarkCallback : public SecureSessionMgrDelegate
+{
+public:
+    void OnMessageReceived(const PacketHeader & header, const PayloadHeader & payloadHeader, Transport::PeerConnectionState * state,
+                           System::PacketBuffer * buffer, SecureSessionMgrBase * mgr) override
+    {
+        uint8_t * message;
+        uint16_t messageLength = extractMessage(buffer->Start(), buffer->DataLength(), &message);
+
+        if (messageLength >= EMBER_AF_ZCL_OVERHEAD + 2 && (message[0] & ZCL_CLUSTER_SPECIFIC_COMMAND) == 0 &&
+            message[EMBER_AF_ZCL_OVERHEAD - 1] == ZCL_DEFAULT_RESPONSE_COMMAND_ID)
+        {
+            switch (message[EMBER_AF_ZCL_OVERHEAD + 1])
+            {
+            case EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND:
+                sUnsupportedCommands++;
+                break;
+            case EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER:
+            case EMBER_ZCL_STATUS_MALFORMED_COMMAND:
+                sRejectedCommands++;
+                break;
+            default:
+                break;
+            }
+        }
+
+        System::PacketBuffer::Free(buffer);
+    }
+};
+
+BenchmarkCallback sCallback;
+
+} // namespace
+
+// The app sends its responses through this session manager, so they come back
+// over the loopback transport.
+SecureSessionMgrBase & chip::SessionManager()
+{
+    return sSessions;
+}
+
+namespace {
+
+// Returns an enabled endpoint with the cluster on the side that receives the command, or 0xFF if there is none.
+uint8_t FindEndpointIndex(EmberAfClusterId clusterId, bool toServer)
+{
+    for (uint8_t index = 0; index < emberAfEndpointCount(); index++)
+    {
+        EndpointId endpoint = emberAfEndpointFromIndex(index);
+        if (emberAfEndpointIndexIsEnabled(index) &&
+            (toServer ? emberAfContainsServer(endpoint, clusterId) : emberAfContainsClient(endpoint, clusterId)))
+        {
+            return index;
+        }
+    }
+
+    return 0xFF;
+}
+
+// Collects every command of a dispatch table that has an endpoint to go to.
+void CollectCommands(const EmberAfCommandDispatchTable & table, bool toServer)
+{
+    for (uint16_t slot = 0; slot < table.size && sCommandCount < kMaxCommands; slot++)
+    {
+        const EmberAfCommandDispatchEntry & entry = table.entries[slot];
+        uint8_t index;
+
+        if (entry.handler == nullptr || (index = FindEndpointIndex(entry.clusterId, toServer)) == 0xFF)
+        {
+            continue;
+        }
+
+        Command & command = sCommands[sCommandCount++];
+        memset(&command, 0, sizeof(command));
+
+        command.apsFrame.profileId           = emberAfProfileIdFromIndex(index);
+        command.apsFrame.clusterId           = entry.clusterId;
+        command.apsFrame.sourceEndpoint      = 1;
+        command.apsFrame.destinationEndpoint = emberAfEndpointFromIndex(index);
+
+        // Successful commands get no Default Response, so that the responses are the ones to commands that failed.
+        command.message[0] = ZCL_CLUSTER_SPECIFIC_COMMAND | ZCL_DISABLE_DEFAULT_RESPONSE_MASK;
+        command.message[0] |= toServer ? ZCL_FRAME_CONTROL_CLIENT_TO_SERVER : ZCL_FRAME_CONTROL_SERVER_TO_CLIENT;
+        command.message[EMBER_AF_ZCL_OVERHEAD - 1] = entry.commandId;
+    }
+}
+
+// Replaces every command with one of the same cluster the app does not handle.
+void ReplaceWithUnhandledCommands()
+{
+    for (size_t i = 0; i < sCommandCount; i++)
+    {
+        sCommands[i].message[EMBER_AF_ZCL_OVERHEAD - 1] = kUnhandledCommandId;
+    }
+}
+
+/**
+ * Sends every command the given number of times.  With handled false, every
+ * command must get an unsupported command response.  Returns the nanoseconds
+ * per command.
+ */
+double TimeDispatch(bool handled, uint32_t rounds)
+{
+    uint64_t dispatched = 0;
+
+    sUnsupportedCommands = 0;
+    sRejectedCommands    = 0;
+
+    uint64_t startNs = GetMonotonicNs();
+
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        for (size_t i = 0; i < sCommandCount; i++)
+        {
+            Command & command = sCommands[i];
+            dispatched += emberAfProcessMessage(&command.apsFrame, EMBER_INCOMING_UNICAST, command.message, sizeof(command.message),
+                                                kNodeId, nullptr);
+        }
+    }
+
+    uint64_t elapsedNs = GetMonotonicNs() - startNs;
+    uint64_t commands  = static_cast<uint64_t>(rounds) * sCommandCount;
+
+    if (dispatched != commands || sRejectedCommands != 0 || (!handled && sUnsupportedCommands != commands))
+    {
+        fprintf(stderr, "%" PRIu64 " of %" PRIu64 " commands processed, %" PRIu32 " rejected, %" PRIu32 " unsupported\n",
+                dispatched, commands, sRejectedCommands, sUnsupportedCommands);
+        exit(EXIT_FAILURE);
+    }
+
+    return static_cast<double>(elapsedNs) / static_cast<double>(commands);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    CHIP_ERROR err  = CHIP_NO_ERROR;
+    uint32_t rounds = kDefaultRounds;
+    System::Layer systemLayer;
+    Optional<Transport::PeerAddress> peer(Transport::Type::kUndefined);
+    SecurePairingUsingTestSecret pairing(Optional<NodeId>::Value(kNodeId), 1, 1);
+    double handledNs;
+
+    if (argc > 1)
+    {
+        rounds = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || rounds == 0)
+    {
+        fprintf(stderr, "Usage: %s [<rounds>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The app logs every message it processes, which would outweigh the dispatch.
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+
+    SuccessOrExit(err = Platform::MemoryInit());
+    SuccessOrExit(err = systemLayer.Init(nullptr));
+    SuccessOrExit(err = sSessions.Init(kNodeId, &systemLayer, "LOOPBACK"));
+    SuccessOrExit(err = sSessions.NewPairing(peer, &pairing));
+    sSessions.SetDelegate(&sCallback);
+
+    InitDataModelHandler();
+    CollectCommands(emberAfServerCommandDispatchTable, true);
+    CollectCommands(emberAfClientCommandDispatchTable, false);
+
+    handledNs = TimeDispatch(true, rounds);
+    printf("%zu commands, %" PRIu32 " declined by their callback\n", sCommandCount, sUnsupportedCommands / rounds);
+    printf("  handled:   %8.2f ns per command\n", handledNs);
+
+    ReplaceWithUnhandledCommands();
+    printf("  unhandled: %8.2f ns per command\n", TimeDispatch(false, rounds));
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to set up the benchmark: %s\n", ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*
+ *   Copyright (c) 2020 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "../clusters/Commands.h"
+#include "../common/BatchCommand.h"
+
+/*
+ * Reads attributes of several clusters and endpoints in as few messages as
+ * possible.  Each record is endpoint/cluster/attribute[/attribute...], for
+ * example: 1/0x0006/0x0000,1/0x0008/0x0000/0x0001
+ */
+class ReadBatch : public BatchCommand
+{
+public:
+    ReadBatch() : BatchCommand("read-attributes") { BatchCommand::AddArguments(); }
+
+    uint16_t EncodeRecord(uint8_t * buffer, uint16_t bufferSize, uint16_t batchLength, const uint64_t * values,
+                          size_t valueCount) override
+    {
+        uint16_t attributeIds[kMaxRecordValues];
+
+        if (valueCount < 3 || values[0] > CHIP_ZCL_ENDPOINT_MAX || values[1] > UINT16_MAX)
+        {
+            return 0;
+        }
+
+        for (size_t i = 2; i < valueCount; i++)
+        {
+            if (values[i] > UINT16_MAX)
+            {
+                return 0;
+            }
+            attributeIds[i - 2] = static_cast<uint16_t>(values[i]);
+        }
+
+        return encodeBatchReadAttributesCommand(buffer, bufferSize, batchLength, static_cast<uint8_t>(values[0]),
+                                                static_cast<uint16_t>(values[1]), attributeIds,
+                                                static_cast<uint16_t>(valueCount - 2));
+    }
+
+    // Global Response: ReadAttributesResponse, or DefaultResponse for a cluster the device does not have
+    bool HandleRecordResponse(const EmberApsFrame & frame, uint8_t commandId, uint8_t * message,
+                              uint16_t messageLen) const override
+    {
+        if (commandId == 0x0B)
+        {
+            DefaultResponse response;
+            return response.HandleCommandResponse(commandId, message, messageLen);
+        }
+
+        ReadAttributesResponse response;
+        return response.HandleCommandResponse(commandId, message, messageLen);
+    }
+};
+
+/*
+ * Writes one attribute per record, of several clusters and endpoints, in as
+ * few messages as possible.  Each record is endpoint/cluster/attribute/type/value,
+ * for example: 1/0x0008/0x0010/0x21/5,2/0x0008/0x0010/0x21/5
+ */
+class WriteBatch : public BatchCommand
+{
+public:
+    WriteBatch() : BatchCommand("write-attributes") { BatchCommand::AddArguments(); }
+
+    uint16_t EncodeRecord(uint8_t * buffer, uint16_t bufferSize, uint16_t batchLength, const uint64_t * values,
+                          size_t valueCount) override
+    {
+        if (valueCount != 5 || values[0] > CHIP_ZCL_ENDPOINT_MAX || values[1] > UINT16_MAX || values[2] > UINT16_MAX ||
+            values[3] > UINT8_MAX)
+        {
+            return 0;
+        }
+
+        return encodeBatchWriteAttributeCommand(buffer, bufferSize, batchLength, static_cast<uint8_t>(values[0]),
+                                                static_cast<uint16_t>(values[1]), static_cast<uint16_t>(values[2]),
+                                                static_cast<uint8_t>(values[3]), values[4]);
+    }
+
+    // Global Response: WriteAttributesResponse, or DefaultResponse for a cluster the device does not have
+    bool HandleRecordResponse(const EmberApsFrame & frame, uint8_t commandId, uint8_t * message,
+                              uint16_t messageLen) const override
+    {
+        if (commandId == 0x0B)
+        {
+            DefaultResponse response;
+            return response.HandleCommandResponse(commandId, message, messageLen);
+        }
+
+        WriteAttributesResponse response;
+        return response.HandleCommandResponse(commandId, message, messageLen);
+    }
+};
+
+void registerCommandsBatch(Commands & commands)
+{
+    const char * clusterName = "Batch";
+
+    commands_list clusterCommands = {
+        make_unique<ReadBatch>(),
+        make_unique<WriteBatch>(),
+    };
+
+    commands.Register(clusterName, clusterCommands);
+}
@@ -0,0 +1,275 @@
+/*
+ *   Copyright (c) 2020 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include "BatchCommand.h"
+
+#include <chrono>
+#include <stdlib.h>
+
+#include <core/CHIPEncoding.h>
+
+using namespace ::chip;
+using namespace ::chip::DeviceController;
+
+constexpr std::chrono::seconds kWaitingForResponseTimeout(10);
+
+namespace {
+constexpr uint16_t kBatchBufferSize                = 1024;
+constexpr uint8_t kZCLGlobalCmdFrameControlHeader  = 8;
+constexpr uint8_t kZCLClusterCmdFrameControlHeader = 9;
+
+// Parses the numbers of the record that starts at record, up to the next comma or the end of the records.  Returns
+// where the next record starts, or nullptr if the record is not a list of numbers separated by slashes.
+const char * ParseRecord(const char * record, uint64_t * values, size_t & valueCount)
+{
+    char * end;
+
+    for (valueCount = 0; valueCount < BatchCommand::kMaxRecordValues;)
+    {
+        values[valueCount++] = strtoull(record, &end, 0);
+        if (end == record)
+        {
+            break;
+        }
+
+        switch (*end)
+        {
+        case '/':
+            record = end + 1;
+            break;
+        case ',':
+            return end + 1;
+        case '\0':
+            return end;
+        default:
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+} // namespace
+
+void BatchCommand::OnConnect(ChipDeviceController * dc)
+{
+    // Responses may come in while later batches are still being sent.
+    UpdateWaitForResponse(true);
+
+    if (SendBatches(dc))
+    {
+        WaitForResponse();
+    }
+    else
+    {
+        UpdateWaitForResponse(false);
+    }
+}
+
+void BatchCommand::OnError(ChipDeviceController * dc, CHIP_ERROR err)
+{
+    UpdateWaitForResponse(false);
+}
+
+void BatchCommand::OnMessage(ChipDeviceController * dc, PacketBuffer * buffer)
+{
+    mSuccess = ReceiveBatchResponse(dc, buffer) && mSuccess;
+
+    if (mResponsesReceived >= mRecordCount)
+    {
+        SetCommandExitStatus(mSuccess);
+        UpdateWaitForResponse(false);
+    }
+}
+
+CHIP_ERROR BatchCommand::Run(ChipDeviceController * dc, NodeId remoteId)
+{
+    CHIP_ERROR err      = CHIP_NO_ERROR;
+    const char * record = mRecords;
+    uint64_t values[kMaxRecordValues];
+    size_t valueCount;
+
+    // Check all the records before connecting, and learn how many responses to wait for.
+    for (mRecordCount = 0; *record != '\0'; mRecordCount++)
+    {
+        const char * next = ParseRecord(record, values, valueCount);
+        if (next == nullptr)
+        {
+            ChipLogError(chipTool, "Invalid record: %s", record);
+            ExitNow(err = CHIP_ERROR_INVALID_ARGUMENT);
+        }
+        record = next;
+    }
+
+    if (mRecordCount == 0)
+    {
+        ChipLogError(chipTool, "No records to send");
+        ExitNow(err = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    err = NetworkCommand::Run(dc, remoteId);
+    SuccessOrExit(err);
+
+    err = dc->ServiceEventSignal();
+    SuccessOrExit(err);
+
+    VerifyOrExit(GetCommandExitStatus(), err = CHIP_ERROR_INTERNAL);
+
+exit:
+    return err;
+}
+
+bool BatchCommand::SendBatches(ChipDeviceController * dc)
+{
+    PacketBuffer * buffer = nullptr;
+    uint16_t batchLength  = 0;
+    const char * record   = mRecords;
+    bool success          = false;
+    uint64_t values[kMaxRecordValues];
+    size_t valueCount;
+
+    while (*record != '\0')
+    {
+        const char * next = ParseRecord(record, values, valueCount);
+        uint16_t newLength;
+
+        if (buffer == nullptr)
+        {
+            buffer = PacketBuffer::NewWithAvailableSize(kBatchBufferSize);
+            VerifyOrExit(buffer != nullptr, ChipLogError(chipTool, "Failed to allocate memory for packet data."));
+            batchLength = encodeBatchHeader(buffer->Start(), kBatchBufferSize);
+        }
+
+        newLength = EncodeRecord(buffer->Start(), kBatchBufferSize, batchLength, values, valueCount);
+        if (newLength == 0 && batchLength > CHIP_ZCL_BATCH_HEADER_LENGTH)
+        {
+            // The batch is full: send it, and try the record again in the next one.
+            VerifyOrExit(SendBatch(dc, buffer, batchLength), buffer = nullptr);
+            buffer = nullptr;
+            continue;
+        }
+        VerifyOrExit(newLength != 0, ChipLogError(chipTool, "Error while encoding record: %s", record));
+
+        batchLength = newLength;
+        record      = next;
+    }
+
+    success = SendBatch(dc, buffer, batchLength);
+    buffer  = nullptr;
+
+exit:
+    if (buffer != nullptr)
+    {
+        PacketBuffer::Free(buffer);
+    }
+    return success;
+}
+
+bool BatchCommand::SendBatch(ChipDeviceController * dc, PacketBuffer * buffer, uint16_t dataLength)
+{
+    uint8_t records = extractBatchRecordCount(buffer->Start(), dataLength);
+
+    buffer->SetDataLength(dataLength);
+    ChipLogProgress(chipTool, "Sending batch of %u records, length %u", records, dataLength);
+
+    CHIP_ERROR err = dc->SendMessage(NULL, buffer);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Failed to send batch: %s", ErrorStr(err));
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchCommand::ReceiveBatchResponse(ChipDeviceController * dc, PacketBuffer * buffer)
+{
+    uint8_t * data      = buffer->Start();
+    uint16_t dataLength = buffer->DataLength();
+    uint16_t offset     = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint8_t records     = extractBatchRecordCount(data, dataLength);
+    bool success        = true;
+
+    if (!isBatchMessage(data, dataLength))
+    {
+        ChipLogError(chipTool, "Unexpected response: not a batch");
+        ExitNow(success = false);
+    }
+    ChipLogDetail(chipTool, "Batch response with %u records", records);
+
+    for (uint8_t i = 0; i < records; i++)
+    {
+        EmberApsFrame frame;
+        uint8_t * message;
+        uint8_t frameControl;
+        uint8_t commandId;
+        uint16_t recordOffset = offset;
+        uint16_t messageLen   = extractBatchMessage(data, dataLength, &offset, &frame, &message);
+
+        // A record that cannot be delimited leaves the offset where it was; the ones after it are lost too.
+        if (offset == recordOffset)
+        {
+            ChipLogError(chipTool, "Truncated batch response");
+            ExitNow(success = false);
+        }
+        mResponsesReceived++;
+
+        if (messageLen < 3)
+        {
+            ChipLogError(chipTool, "Unexpected response length: %d", messageLen);
+            success = false;
+            continue;
+        }
+
+        frameControl = chip::Encoding::Read8(message);
+        chip::Encoding::Read8(message); // sequenceNumber
+        commandId  = chip::Encoding::Read8(message);
+        messageLen = static_cast<uint16_t>(messageLen - 3);
+
+        ChipLogProgress(chipTool, "Endpoint id: '0x%02x', Cluster id: '0x%04x'", frame.sourceEndpoint, frame.clusterId);
+        if (frameControl != kZCLGlobalCmdFrameControlHeader && frameControl != kZCLClusterCmdFrameControlHeader)
+        {
+            ChipLogError(chipTool, "Unexpected frame control byte: 0x%02x", frameControl);
+            success = false;
+            continue;
+        }
+
+        success = HandleRecordResponse(frame, commandId, message, messageLen) && success;
+    }
+
+exit:
+    return success;
+}
+
+void BatchCommand::UpdateWaitForResponse(bool value)
+{
+    {
+        std::lock_guard<std::mutex> lk(cvWaitingForResponseMutex);
+        mWaitingForResponse = value;
+    }
+    cvWaitingForResponse.notify_all();
+}
+
+void BatchCommand::WaitForResponse()
+{
+    std::unique_lock<std::mutex> lk(cvWaitingForResponseMutex);
+    auto waitingUntil = std::chrono::system_clock::now() + kWaitingForResponseTimeout;
+    if (!cvWaitingForResponse.wait_until(lk, waitingUntil, [this]() { return !this->mWaitingForResponse; }))
+    {
+        ChipLogError(chipTool, "Got %u of %u responses from device", mResponsesReceived, mRecordCount);
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ *   Copyright (c) 2020 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "NetworkCommand.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#include <app/chip-zcl-zpro-codec.h>
+
+/**
+ * A command that sends several ZCL commands, possibly for different clusters
+ * and endpoints, as batch messages (see CHIP_ZCL_BATCH_FRAME_CONTROL), and
+ * waits for the batch responses that answer them.
+ *
+ * The records argument lists the ZCL commands, separated by commas.  Each one
+ * is a list of numbers separated by slashes, which the subclass turns into a
+ * record of the batch.  As many records as fit go into each message.
+ */
+class BatchCommand : public NetworkCommand
+{
+public:
+    BatchCommand(const char * commandName) : NetworkCommand(commandName, NetworkType::UDP) {}
+
+    void AddArguments()
+    {
+        NetworkCommand::AddArguments();
+        AddArgument("records", &mRecords);
+    }
+
+    /////////// Command Interface /////////
+    CHIP_ERROR Run(ChipDeviceController * dc, NodeId remoteId) override;
+
+    /////////// IPCommand Interface /////////
+    void OnConnect(ChipDeviceController * dc) override;
+    void OnError(ChipDeviceController * dc, CHIP_ERROR err) override;
+    void OnMessage(ChipDeviceController * dc, chip::System::PacketBuffer * buffer) override;
+
+    /**
+     * Appends the ZCL command described by the numbers of one record to the batch.  Returns the new length of the
+     * batch, or 0 if the command does not fit or the numbers do not describe one; the batch is then left unchanged.
+     */
+    virtual uint16_t EncodeRecord(uint8_t * buffer, uint16_t bufferSize, uint16_t batchLength, const uint64_t * values,
+                                  size_t valueCount) = 0;
+    virtual bool HandleRecordResponse(const EmberApsFrame & frame, uint8_t commandId, uint8_t * message,
+                                      uint16_t messageLen) const = 0;
+
+    static constexpr size_t kMaxRecordValues = 16;
+
+private:
+    bool SendBatches(ChipDeviceController * dc);
+    bool SendBatch(ChipDeviceController * dc, chip::System::PacketBuffer * buffer, uint16_t dataLength);
+    bool ReceiveBatchResponse(ChipDeviceController * dc, chip::System::PacketBuffer * buffer);
+
+    void UpdateWaitForResponse(bool value);
+    void WaitForResponse(void);
+
+    std::condition_variable cvWaitingForResponse;
+    std::mutex cvWaitingForResponseMutex;
+    bool mWaitingForResponse{ false };
+    char * mRecords;
+    uint16_t mRecordCount{ 0 };
+    uint16_t mResponsesReceived{ 0 };
+    bool mSuccess{ true };
+};
@@ -18,6 +18,7 @@
 
 #include "commands/common/Commands.h"
 
+#include "commands/batch/Commands.h"
 #include "commands/clusters/Commands.h"
 #include "commands/echo/Commands.h"
 
@@ -36,6 +37,7 @@ int main(int argc, char * argv[])
 
     registerCommandsEcho(commands);
     registerClusters(commands);
+    registerCommandsBatch(commands);
 
     return commands.Run(kLocalDeviceId, kRemoteDeviceId, argc, argv);
 }
@@ -44,7 +44,17 @@ extern "C" {
 void HandleDataModelMessage(const PacketHeader & header, System::PacketBuffer * buffer, SecureSessionMgrBase * mgr)
 {
     EmberApsFrame frame;
-    bool ok = extractApsFrame(buffer->Start(), buffer->DataLength(), &frame) > 0;
+    bool ok;
+
+    if (isBatchMessage(buffer->Start(), buffer->DataLength()))
+    {
+        ok = emberAfProcessBatchMessage(buffer->Start(), buffer->DataLength(), header.GetSourceNodeId().Value());
+        ChipLogProgress(Zcl, "Batch data model processing %s!", ok ? "success" : "failure");
+        System::PacketBuffer::Free(buffer);
+        return;
+    }
+
+    ok = extractApsFrame(buffer->Start(), buffer->DataLength(), &frame) > 0;
     if (ok)
     {
         ChipLogProgress(Zcl, "APS frame processing success!");
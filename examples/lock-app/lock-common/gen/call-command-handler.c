@@ -60,7 +60,7 @@
 #include "command-id.h"
 #include "util.h"
 
-static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecific)
+static EmberAfStatus commandStatus(bool wasHandled, bool clusterExists, bool mfgSpecific)
 {
     if (wasHandled)
     {
@@ -80,64 +80,97 @@ static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecifi
     }
 }
 
+// Cluster: On/off, server
+
+static EmberAfStatus emberAfOnOffClusterOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOffCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfOnOffClusterOnCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOnCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+static EmberAfStatus emberAfOnOffClusterToggleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterToggleCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Commands sent from clients to the servers of this application, laid out for
+// emberAfFindCommandHandler().
+static const EmberAfCommandDispatchEntry serverCommandDispatchEntries[8] = {
+    [2] = { ZCL_ON_OFF_CLUSTER_ID, ZCL_OFF_COMMAND_ID, emberAfOnOffClusterOffCommandParse },
+    [3] = { ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_COMMAND_ID, emberAfOnOffClusterOnCommandParse },
+    [4] = { ZCL_ON_OFF_CLUSTER_ID, ZCL_TOGGLE_COMMAND_ID, emberAfOnOffClusterToggleCommandParse },
+};
+
+const EmberAfCommandDispatchTable emberAfServerCommandDispatchTable = { serverCommandDispatchEntries, 8 };
+
+// Commands sent from servers to the clients of this application, laid out for
+// emberAfFindCommandHandler().
+static const EmberAfCommandDispatchEntry clientCommandDispatchEntries[1] = {
+    { 0, 0, NULL },
+};
+
+const EmberAfCommandDispatchTable emberAfClientCommandDispatchTable = { clientCommandDispatchEntries, 1 };
+
+// Whether the server of the cluster is one this application parses commands for, even if it
+// handles none of them.
+static bool isServerCluster(EmberAfClusterId clusterId)
+{
+    switch (clusterId)
+    {
+    case ZCL_ON_OFF_CLUSTER_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Whether the client of the cluster is one this application parses commands for, even if it
+// handles none of them.
+static bool isClientCluster(EmberAfClusterId clusterId)
+{
+    (void) clusterId;
+    return false;
+}
+
+static EmberAfCommandHandler findHandler(const EmberAfCommandDispatchTable * table, EmberAfClusterCommand * cmd)
+{
+    return cmd->mfgSpecific ? NULL : emberAfFindCommandHandler(table, cmd->apsFrame->clusterId, cmd->commandId);
+}
+
 // Main command parsing controller.
 EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
 {
-    EmberAfStatus result = status(false, false, cmd->mfgSpecific);
+    EmberAfCommandHandler handler = NULL;
+    bool clusterExists            = false;
     if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT &&
         emberAfContainsClientWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
     {
-        switch (cmd->apsFrame->clusterId)
-        {
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
+        handler       = findHandler(&emberAfClientCommandDispatchTable, cmd);
+        clusterExists = (handler != NULL) || isClientCluster(cmd->apsFrame->clusterId);
     }
     else if (cmd->direction == (uint8_t) ZCL_DIRECTION_CLIENT_TO_SERVER &&
              emberAfContainsServerWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
     {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_ON_OFF_CLUSTER_ID:
-            result = emberAfOnOffClusterServerCommandParse(cmd);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
+        handler       = findHandler(&emberAfServerCommandDispatchTable, cmd);
+        clusterExists = (handler != NULL) || isServerCluster(cmd->apsFrame->clusterId);
     }
-    return result;
-}
-
-// Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
+    if (handler == NULL)
     {
-        switch (cmd->commandId)
-        {
-        case ZCL_OFF_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOffCallback();
-            break;
-        }
-        case ZCL_ON_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOnCallback();
-            break;
-        }
-        case ZCL_TOGGLE_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterToggleCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
+        // Unrecognized cluster or command ID, error status will apply.
+        return commandStatus(false, clusterExists, cmd->mfgSpecific);
     }
-    return status(wasHandled, true, cmd->mfgSpecific);
+    return handler(cmd);
 }
@@ -40,11 +40,23 @@
 #define SILABS_EMBER_AF_COMMAND_PARSE_HEADER
 
 #include "af-types.h"
+#include "command-dispatch.h"
 
-// This is a set of generated prototype for functions that parse the
-// the incomming message, and call appropriate command handler.
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
 
-// Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd);
+// This is a set of generated tables of the functions that parse the
+// incoming message, and call appropriate command handler.
+
+// Commands sent from clients to the servers of this application.
+extern const EmberAfCommandDispatchTable emberAfServerCommandDispatchTable;
+
+// Commands sent from servers to the clients of this application.
+extern const EmberAfCommandDispatchTable emberAfClientCommandDispatchTable;
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // #ifdef __cplusplus
 
 #endif // SILABS_EMBER_AF_COMMAND_PARSE_HEADER
@@ -40,7 +40,7 @@
 #include "command-id.h"
 #include "util.h"
 
-static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecific)
+static EmberAfStatus commandStatus(bool wasHandled, bool clusterExists, bool mfgSpecific)
 {
     if (wasHandled)
     {
@@ -60,63 +60,86 @@ static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecifi
     }
 }
 
+// Cluster: Basic, server
+
+static EmberAfStatus emberAfBasicClusterResetToFactoryDefaultsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfBasicClusterResetToFactoryDefaultsCallback();
+    return commandStatus(wasHandled, true, cmd->mfgSpecific);
+}
+
+// Commands sent from clients to the servers of this application, laid out for
+// emberAfFindCommandHandler().
+static const EmberAfCommandDispatchEntry serverCommandDispatchEntries[2] = {
+    [0] = { ZCL_BASIC_CLUSTER_ID, ZCL_RESET_TO_FACTORY_DEFAULTS_COMMAND_ID, emberAfBasicClusterResetToFactoryDefaultsCommandParse },
+};
+
+const EmberAfCommandDispatchTable emberAfServerCommandDispatchTable = { serverCommandDispatchEntries, 2 };
+
+// Commands sent from servers to the clients of this application, laid out for
+// emberAfFindCommandHandler().
+static const EmberAfCommandDispatchEntry clientCommandDispatchEntries[1] = {
+    { 0, 0, NULL },
+};
+
+const EmberAfCommandDispatchTable emberAfClientCommandDispatchTable = { clientCommandDispatchEntries, 1 };
+
+// Whether the server of the cluster is one this application parses commands for, even if it
+// handles none of them.
+static bool isServerCluster(EmberAfClusterId clusterId)
+{
+    switch (clusterId)
+    {
+    case ZCL_BASIC_CLUSTER_ID:
+    case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Whether the client of the cluster is one this application parses commands for, even if it
+// handles none of them.
+static bool isClientCluster(EmberAfClusterId clusterId)
+{
+    switch (clusterId)
+    {
+    case ZCL_BASIC_CLUSTER_ID:
+    case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static EmberAfCommandHandler findHandler(const EmberAfCommandDispatchTable * table, EmberAfClusterCommand * cmd)
+{
+    return cmd->mfgSpecific ? NULL : emberAfFindCommandHandler(table, cmd->apsFrame->clusterId, cmd->commandId);
+}
+
 // Main command parsing controller.
 EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
 {
-    EmberAfStatus result = status(false, false, cmd->mfgSpecific);
+    EmberAfCommandHandler handler = NULL;
+    bool clusterExists            = false;
     if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT &&
         emberAfContainsClientWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
     {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_BASIC_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
+        handler       = findHandler(&emberAfClientCommandDispatchTable, cmd);
+        clusterExists = (handler != NULL) || isClientCluster(cmd->apsFrame->clusterId);
     }
     else if (cmd->direction == (uint8_t) ZCL_DIRECTION_CLIENT_TO_SERVER &&
              emberAfContainsServerWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
     {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_BASIC_CLUSTER_ID:
-            result = emberAfBasicClusterServerCommandParse(cmd);
-            break;
-        case ZCL_TEMP_MEASUREMENT_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
+        handler       = findHandler(&emberAfServerCommandDispatchTable, cmd);
+        clusterExists = (handler != NULL) || isServerCluster(cmd->apsFrame->clusterId);
     }
-    return result;
-}
-
-// Cluster: Basic, server
-EmberAfStatus emberAfBasicClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
+    if (handler == NULL)
     {
-        switch (cmd->commandId)
-        {
-        case ZCL_RESET_TO_FACTORY_DEFAULTS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfBasicClusterResetToFactoryDefaultsCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
+        // Unrecognized cluster or command ID, error status will apply.
+        return commandStatus(false, clusterExists, cmd->mfgSpecific);
     }
-    return status(wasHandled, true, cmd->mfgSpecific);
+    return handler(cmd);
 }
@@ -0,0 +1,277 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the encoding and decoding of batch messages
+ *      (see CHIP_ZCL_BATCH_FRAME_CONTROL), which carry several APS/ZCL
+ *      messages in one buffer.  Running out of room is the normal way for
+ *      a batch to end, so each record is checked against the space left
+ *      before anything is encoded, and a record that does not fit is not
+ *      reported as an error.
+ */
+
+#include <app/chip-zcl-zpro-codec.h>
+#include <app/message-reader.h>
+#include <core/CHIPError.h>
+#include <support/BufBound.h>
+#include <support/logging/CHIPLogging.h>
+
+using namespace chip;
+
+namespace {
+
+// The ZCL header of the commands a batch carries: a client to server global
+// command frame control byte, a sequence number and a command ID.
+constexpr uint8_t kGlobalCommandFrameControl = 0x00;
+constexpr uint8_t kCommandSequenceNumber     = 1;
+constexpr uint16_t kZclHeaderLength          = 3;
+
+constexpr uint8_t kReadAttributesCommandId  = 0x00;
+constexpr uint8_t kWriteAttributesCommandId = 0x02;
+
+// Profile and source endpoint of the commands, the same as the generated encoders use.
+constexpr uint16_t kCommandProfileId        = 65535;
+constexpr EndpointId kCommandSourceEndpoint = 1;
+
+uint16_t apsFrameLength()
+{
+    static EmberApsFrame frame;
+    static const uint16_t length = encodeApsFrame(nullptr, 0, &frame);
+    return length;
+}
+
+// The size of a write attributes value of the given type, or 0 if the type is
+// not one the per-cluster write encoders support.
+uint16_t attributeValueLength(uint8_t attr_type)
+{
+    switch (attr_type)
+    {
+    case 0x18:
+        return 1;
+    case 0x21:
+        return 2;
+    case 0xF0:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+// Returns the offset of a record of record_length bytes appended to the batch,
+// or 0 if the batch has no room left for it.
+uint16_t reserveBatchRecord(const uint8_t * buffer, uint16_t buf_length, uint16_t batch_length, uint32_t record_length,
+                            const char * name)
+{
+    if (buffer == nullptr || batch_length < CHIP_ZCL_BATCH_HEADER_LENGTH || batch_length > buf_length)
+    {
+        return 0;
+    }
+
+    if (record_length == 0 || buffer[1] == CHIP_ZCL_BATCH_MAX_RECORDS ||
+        uint32_t(batch_length) + CHIP_ZCL_BATCH_RECORD_OVERHEAD + record_length > buf_length)
+    {
+        ChipLogDetail(Zcl, "%s does not fit in batch", name);
+        return 0;
+    }
+
+    return static_cast<uint16_t>(batch_length + CHIP_ZCL_BATCH_RECORD_OVERHEAD);
+}
+
+// Encodes the APS frame of a record at record_offset, and returns a BufBound
+// for the rest of the record.
+BufBound startBatchRecord(uint8_t * buffer, uint16_t record_offset, uint16_t record_length, EmberApsFrame * apsFrame)
+{
+    uint16_t frame_length = encodeApsFrame(buffer + record_offset, record_length, apsFrame);
+    return BufBound(buffer + record_offset + frame_length, static_cast<size_t>(record_length - frame_length));
+}
+
+// Turns a record encoded at the end of the batch into part of the batch, and
+// returns the new length of the batch.
+uint16_t commitBatchRecord(uint8_t * buffer, uint16_t batch_length, uint16_t record_length)
+{
+    BufBound prefix = BufBound(buffer + batch_length, CHIP_ZCL_BATCH_RECORD_OVERHEAD);
+    prefix.PutLE16(record_length);
+    buffer[1]++;
+
+    return static_cast<uint16_t>(batch_length + CHIP_ZCL_BATCH_RECORD_OVERHEAD + record_length);
+}
+
+// Appends a global command to the batch, with payload_length bytes after its
+// ZCL header left for the caller to fill in.  Returns the BufBound to write
+// the payload to, or one with no room if the command does not fit.
+BufBound startGlobalCommandRecord(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length, uint8_t destination_endpoint,
+                                  uint16_t cluster_id, uint8_t command, uint32_t payload_length, const char * name,
+                                  uint16_t & record_length)
+{
+    EmberApsFrame frame       = {};
+    uint32_t length           = uint32_t(apsFrameLength()) + kZclHeaderLength + payload_length;
+    uint16_t record_offset    = reserveBatchRecord(buffer, buf_length, batch_length, length, name);
+    frame.profileId           = kCommandProfileId;
+    frame.clusterId           = cluster_id;
+    frame.sourceEndpoint      = kCommandSourceEndpoint;
+    frame.destinationEndpoint = destination_endpoint;
+
+    if (record_offset == 0)
+    {
+        record_length = 0;
+        return BufBound(nullptr, 0);
+    }
+
+    record_length = static_cast<uint16_t>(length);
+    BufBound buf  = startBatchRecord(buffer, record_offset, record_length, &frame);
+    buf.Put(kGlobalCommandFrameControl);
+    buf.Put(kCommandSequenceNumber);
+    buf.Put(command);
+    return buf;
+}
+
+} // namespace
+
+extern "C" {
+
+uint16_t encodeBatchHeader(uint8_t * buffer, uint16_t buf_length)
+{
+    BufBound buf = BufBound(buffer, buf_length);
+    buf.Put(static_cast<uint8_t>(CHIP_ZCL_BATCH_FRAME_CONTROL));
+    buf.Put(static_cast<uint8_t>(0)); // Record count
+
+    return buf.Fit() ? static_cast<uint16_t>(buf.Written()) : 0;
+}
+
+uint16_t encodeBatchReadAttributesCommand(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length,
+                                          uint8_t destination_endpoint, uint16_t cluster_id, const uint16_t * attr_ids,
+                                          uint16_t attr_id_count)
+{
+    uint16_t record_length = 0;
+    BufBound buf           = startGlobalCommandRecord(buffer, buf_length, batch_length, destination_endpoint, cluster_id,
+                                                      kReadAttributesCommandId, uint32_t(attr_id_count) * sizeof(uint16_t),
+                                                      "BatchReadAttributes", record_length);
+    if (record_length == 0)
+    {
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < attr_id_count; ++i)
+    {
+        buf.PutLE16(attr_ids[i]);
+    }
+
+    return commitBatchRecord(buffer, batch_length, record_length);
+}
+
+uint16_t encodeBatchWriteAttributeCommand(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length,
+                                          uint8_t destination_endpoint, uint16_t cluster_id, uint16_t attr_id,
+                                          uint8_t attr_type, uint64_t value)
+{
+    uint16_t value_length = attributeValueLength(attr_type);
+    if (value_length == 0)
+    {
+        ChipLogError(Zcl, "Unsupported attribute type 0x%02x in batch write", attr_type);
+        return 0;
+    }
+
+    uint16_t record_length = 0;
+    BufBound buf           = startGlobalCommandRecord(buffer, buf_length, batch_length, destination_endpoint, cluster_id,
+                                                      kWriteAttributesCommandId, sizeof(attr_id) + sizeof(attr_type) + value_length,
+                                                      "BatchWriteAttribute", record_length);
+    if (record_length == 0)
+    {
+        return 0;
+    }
+
+    buf.PutLE16(attr_id);
+    buf.Put(attr_type);
+    buf.PutLE(value, value_length);
+
+    return commitBatchRecord(buffer, batch_length, record_length);
+}
+
+uint16_t encodeBatchMessage(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length, EmberApsFrame * apsFrame,
+                            const uint8_t * message, uint16_t message_length)
+{
+    uint32_t length        = uint32_t(apsFrameLength()) + message_length;
+    uint16_t record_offset = reserveBatchRecord(buffer, buf_length, batch_length, length, "BatchMessage");
+    if (record_offset == 0)
+    {
+        return 0;
+    }
+
+    uint16_t record_length = static_cast<uint16_t>(length);
+    BufBound buf           = startBatchRecord(buffer, record_offset, record_length, apsFrame);
+    buf.Put(message, message_length);
+
+    return commitBatchRecord(buffer, batch_length, record_length);
+}
+
+bool isBatchMessage(const uint8_t * buffer, uint16_t buf_length)
+{
+    return buffer != nullptr && buf_length >= CHIP_ZCL_BATCH_HEADER_LENGTH && buffer[0] == CHIP_ZCL_BATCH_FRAME_CONTROL;
+}
+
+uint16_t extractBatchRecord(uint8_t * buffer, uint16_t buf_length, uint16_t * offset, uint8_t ** record)
+{
+    if (buffer == nullptr || offset == nullptr || record == nullptr || *offset < CHIP_ZCL_BATCH_HEADER_LENGTH ||
+        *offset >= buf_length)
+    {
+        return 0;
+    }
+
+    DataModelReader reader(buffer + *offset, static_cast<uint16_t>(buf_length - *offset));
+
+    uint16_t record_length = 0;
+    CHIP_ERROR err         = reader.Read16(&record_length).StatusCode();
+    if (err != CHIP_NO_ERROR || record_length == 0 || record_length > buf_length - *offset - CHIP_ZCL_BATCH_RECORD_OVERHEAD)
+    {
+        ChipLogError(Zcl, "Error extracting batch record at offset %d", *offset);
+        return 0;
+    }
+
+    *record = buffer + *offset + CHIP_ZCL_BATCH_RECORD_OVERHEAD;
+    *offset = static_cast<uint16_t>(*offset + CHIP_ZCL_BATCH_RECORD_OVERHEAD + record_length);
+    return record_length;
+}
+
+uint8_t extractBatchRecordCount(const uint8_t * buffer, uint16_t buf_length)
+{
+    return isBatchMessage(buffer, buf_length) ? buffer[1] : 0;
+}
+
+uint16_t extractBatchMessage(uint8_t * buffer, uint16_t buf_length, uint16_t * offset, EmberApsFrame * outApsFrame,
+                             uint8_t ** msg)
+{
+    uint8_t * record;
+    uint16_t record_length = extractBatchRecord(buffer, buf_length, offset, &record);
+    uint16_t frame_length  = 0;
+
+    if (record_length == 0 || outApsFrame == nullptr || msg == nullptr)
+    {
+        return 0;
+    }
+
+    frame_length = extractApsFrame(record, record_length, outApsFrame);
+    if (frame_length == 0 || frame_length >= record_length)
+    {
+        ChipLogError(Zcl, "Error extracting batch message for record of length %d", record_length);
+        return 0;
+    }
+
+    *msg = record + frame_length;
+    return static_cast<uint16_t>(record_length - frame_length);
+}
+
+} // extern "C"
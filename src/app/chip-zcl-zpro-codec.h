@@ -88,6 +88,126 @@ void printApsFrame(EmberApsFrame * frame);
  */
 uint16_t encodeApsFrame(uint8_t * buffer, uint16_t buf_length, EmberApsFrame * apsFrame);
 
+/**
+ * A batch message carries several APS/ZCL messages, possibly for different
+ * clusters and endpoints, in one outgoing buffer.  It starts with a frame
+ * control byte equal to CHIP_ZCL_BATCH_FRAME_CONTROL and a one byte record
+ * count, followed by that many records.  Each record is a little-endian
+ * uint16_t length followed by an encoded APS frame and its ZCL message.
+ *
+ * A regular message always starts with a 0 frame control byte, so the two
+ * can be told apart by the first byte.
+ */
+#define CHIP_ZCL_BATCH_FRAME_CONTROL 0x80
+#define CHIP_ZCL_BATCH_HEADER_LENGTH 2
+#define CHIP_ZCL_BATCH_RECORD_OVERHEAD 2
+#define CHIP_ZCL_BATCH_MAX_RECORDS UINT8_MAX
+
+/**
+ * @brief Start an empty batch message in the given buffer.
+ *
+ * @return The number of bytes used by the batch header, or 0 if the buffer is
+ *         too small.
+ */
+uint16_t encodeBatchHeader(uint8_t * buffer, uint16_t buf_length);
+
+/**
+ * @brief Append a read attributes command to a batch started with
+ * encodeBatchHeader.
+ *
+ * @param[in] buffer The buffer holding the batch.
+ * @param[in] buf_length The size of the buffer.
+ * @param[in] batch_length The number of bytes of the batch encoded so far.
+ * @param[in] destination_endpoint The endpoint to read from.
+ * @param[in] cluster_id The cluster to read from.
+ * @param[in] attr_ids The attributes to read.
+ * @param[in] attr_id_count The number of entries in attr_ids.
+ *
+ * @return The new length of the batch, or 0 if the command does not fit in
+ *         the remaining space.  On failure the batch is left unchanged, so the
+ *         caller can send it and start a new one.
+ */
+uint16_t encodeBatchReadAttributesCommand(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length,
+                                          uint8_t destination_endpoint, uint16_t cluster_id, const uint16_t * attr_ids,
+                                          uint16_t attr_id_count);
+
+/**
+ * @brief Append a write attributes command for a single attribute to a batch
+ * started with encodeBatchHeader.  Supports the same attribute types as the
+ * per-cluster write encoders.
+ *
+ * @return The new length of the batch, or 0 if the command does not fit in
+ *         the remaining space or attr_type is not supported.  On failure the
+ *         batch is left unchanged.
+ */
+uint16_t encodeBatchWriteAttributeCommand(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length,
+                                          uint8_t destination_endpoint, uint16_t cluster_id, uint16_t attr_id,
+                                          uint8_t attr_type, uint64_t value);
+
+/**
+ * @brief Append an already encoded ZCL message, with the given APS frame, to
+ * a batch started with encodeBatchHeader.  This is how a batch response is
+ * built, one response per record.
+ *
+ * @param[in] buffer The buffer holding the batch.
+ * @param[in] buf_length The size of the buffer.
+ * @param[in] batch_length The number of bytes of the batch encoded so far.
+ * @param[in] apsFrame The APS frame of the record.
+ * @param[in] message The ZCL message of the record.
+ * @param[in] message_length The length of the ZCL message.
+ *
+ * @return The new length of the batch, or 0 if the record does not fit in
+ *         the remaining space.  On failure the batch is left unchanged.
+ */
+uint16_t encodeBatchMessage(uint8_t * buffer, uint16_t buf_length, uint16_t batch_length, EmberApsFrame * apsFrame,
+                            const uint8_t * message, uint16_t message_length);
+
+/** @brief Returns true if buffer holds a batch message.
+ */
+bool isBatchMessage(const uint8_t * buffer, uint16_t buf_length);
+
+/**
+ * @brief Get the next record out of a batch message.
+ *
+ * @param[in] buffer The buffer holding the batch.
+ * @param[in] buf_length The length of the batch.
+ * @param[in,out] offset Offset of the next record.  Should be
+ *                       CHIP_ZCL_BATCH_HEADER_LENGTH for the first record; it
+ *                       is advanced past the record on success.
+ * @param[out] record Set to the start of the record's APS frame.
+ *
+ * @return The length of the record, or 0 if there are no more records or the
+ *         record is truncated.
+ */
+uint16_t extractBatchRecord(uint8_t * buffer, uint16_t buf_length, uint16_t * offset, uint8_t ** record);
+
+/**
+ * @brief Get the number of records a batch message announces in its header.
+ *
+ * @return The record count, or 0 if buffer does not hold a batch message.
+ */
+uint8_t extractBatchRecordCount(const uint8_t * buffer, uint16_t buf_length);
+
+/**
+ * @brief Get the APS frame and the ZCL message of the next record out of a
+ * batch message, such as a batch response.
+ *
+ * @param[in] buffer The buffer holding the batch.
+ * @param[in] buf_length The length of the batch.
+ * @param[in,out] offset Offset of the next record, as for extractBatchRecord.
+ *                       It is advanced past any record that could be
+ *                       delimited, even if its contents are malformed, so the
+ *                       caller can go on with the next record.
+ * @param[out] outApsFrame The APS frame of the record.
+ * @param[out] msg Set to the start of the record's ZCL message.
+ *
+ * @return The length of the ZCL message, or 0 if there are no more records or
+ *         the record is malformed.  The batch ends when *offset reaches
+ *         buf_length.
+ */
+uint16_t extractBatchMessage(uint8_t * buffer, uint16_t buf_length, uint16_t * offset, EmberApsFrame * outApsFrame,
+                             uint8_t ** msg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,7 @@
 #include <app/util/af.h>
 
 #include <app/util/af-event.h>
+#include <app/util/af-transition.h>
 #include <app/util/attribute-storage.h>
 #include <assert.h>
 
@@ -50,10 +51,6 @@
 
 using namespace chip;
 
-#define COLOR_TEMP_CONTROL emberAfPluginColorControlServerTempTransitionEventControl
-#define COLOR_XY_CONTROL emberAfPluginColorControlServerXyTransitionEventControl
-#define COLOR_HSV_CONTROL emberAfPluginColorControlServerHueSatTransitionEventControl
-
 // move mode
 enum
 {
@@ -86,7 +83,10 @@ EmberEventControl emberAfPluginColorControlServerTempTransitionEventControl;
 EmberEventControl emberAfPluginColorControlServerXyTransitionEventControl;
 EmberEventControl emberAfPluginColorControlServerHueSatTransitionEventControl;
 
-#define UPDATE_TIME_MS 100
+// Transitions advance by one step per shared transition tick.  Transition times
+// are given in tenths of a second, so one step must last 100ms.
+static_assert(EMBER_AF_TRANSITION_TICK_MS == 100, "Color transition steps are counted in tenths of a second");
+
 #define TRANSITION_TIME_1S 10
 #define MIN_CIE_XY_VALUE 0
 // this value comes directly from the ZCL specification table 5.3
@@ -139,6 +139,12 @@ static Color16uTransitionState colorSaturationTransitionState;
 
 // Forward declarations:
 static bool computeNewColor16uValue(Color16uTransitionState * p);
+static void hueSatTransitionTick(EndpointId endpoint);
+static void xyTransitionTick(EndpointId endpoint);
+static void tempTransitionTick(EndpointId endpoint);
+static EmberAfStatus scheduleHueSatTransition(void);
+static EmberAfStatus scheduleXyTransition(void);
+static EmberAfStatus scheduleTempTransition(void);
 static void stopAllColorTransitions(void);
 static void handleModeSwitch(EndpointId endpoint, uint8_t newColorMode);
 static bool shouldExecuteIfOff(EndpointId endpoint, uint8_t optionMask, uint8_t optionOverride);
@@ -383,9 +389,7 @@ bool emberAfColorControlClusterMoveToHueAndSaturationCallback(uint8_t hue, uint8
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -442,9 +446,7 @@ bool emberAfColorControlClusterMoveHueCallback(uint8_t moveMode, uint8_t rate, u
     colorSaturationTransitionState.stepsRemaining = 0;
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -499,9 +501,7 @@ bool emberAfColorControlClusterMoveSaturationCallback(uint8_t moveMode, uint8_t
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -592,9 +592,7 @@ bool emberAfColorControlClusterMoveToHueCallback(uint8_t hue, uint8_t hueMoveMod
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -645,9 +643,7 @@ bool emberAfColorControlClusterMoveToSaturationCallback(uint8_t saturation, uint
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -707,9 +703,7 @@ bool emberAfColorControlClusterStepHueCallback(uint8_t stepMode, uint8_t stepSiz
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -768,9 +762,7 @@ bool emberAfColorControlClusterStepSaturationCallback(uint8_t stepMode, uint8_t
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleHueSatTransition());
     return true;
 }
 
@@ -883,9 +875,7 @@ bool emberAfColorControlClusterMoveToColorCallback(uint16_t colorX, uint16_t col
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_XY_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleXyTransition());
     return true;
 }
 
@@ -963,9 +953,7 @@ bool emberAfColorControlClusterMoveColorCallback(int16_t rateX, int16_t rateY, u
     }
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_XY_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleXyTransition());
     return true;
 }
 
@@ -1016,9 +1004,7 @@ bool emberAfColorControlClusterStepColorCallback(int16_t stepX, int16_t stepY, u
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_XY_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleXyTransition());
     return true;
 }
 
@@ -1071,7 +1057,7 @@ static uint16_t readColorY(EndpointId endpoint)
 
 #ifdef EMBER_AF_PLUGIN_COLOR_CONTROL_SERVER_TEMP
 
-static void moveToColorTemp(EndpointId endpoint, uint16_t colorTemperature, uint16_t transitionTime)
+static EmberAfStatus moveToColorTemp(EndpointId endpoint, uint16_t colorTemperature, uint16_t transitionTime)
 {
     uint16_t temperatureMin = readColorTemperatureMin(endpoint);
     uint16_t temperatureMax = readColorTemperatureMax(endpoint);
@@ -1108,7 +1094,7 @@ static void moveToColorTemp(EndpointId endpoint, uint16_t colorTemperature, uint
     colorTempTransitionState.highLimit      = temperatureMax;
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_TEMP_CONTROL, UPDATE_TIME_MS);
+    return scheduleTempTransition();
 }
 
 bool emberAfColorControlClusterMoveToColorTemperatureCallback(uint16_t colorTemperature, uint16_t transitionTime,
@@ -1122,9 +1108,7 @@ bool emberAfColorControlClusterMoveToColorTemperatureCallback(uint16_t colorTemp
         return true;
     }
 
-    moveToColorTemp(endpoint, colorTemperature, transitionTime);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(moveToColorTemp(endpoint, colorTemperature, transitionTime));
     return true;
 }
 
@@ -1206,9 +1190,7 @@ bool emberAfColorControlClusterMoveColorTemperatureCallback(uint8_t moveMode, ui
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_TEMP_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleTempTransition());
     return true;
 }
 
@@ -1273,9 +1255,7 @@ bool emberAfColorControlClusterStepColorTemperatureCallback(uint8_t stepMode, ui
     writeRemainingTime(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(&COLOR_TEMP_CONTROL, UPDATE_TIME_MS);
-
-    emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_SUCCESS);
+    emberAfSendImmediateDefaultResponse(scheduleTempTransition());
     return true;
 }
 
@@ -1365,11 +1345,40 @@ bool emberAfColorControlClusterStopMoveStepCallback(uint8_t optionsMask, uint8_t
 
 // **************** transition state machines ***********
 
+// Each transition is scheduled on the endpoint recorded in its state, so it is
+// cancelled on that same endpoint.  A transition that cannot be scheduled does
+// not start, and the command that asked for it fails.
+static EmberAfStatus scheduleTransition(EndpointId endpoint, EmberAfTickFunction tick)
+{
+    if (emberAfTransitionSchedule(endpoint, tick) != EMBER_SUCCESS)
+    {
+        emberAfColorControlClusterPrintln("ERR: no room to schedule transition");
+        writeRemainingTime(endpoint, 0);
+        return EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
+    }
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+static EmberAfStatus scheduleHueSatTransition(void)
+{
+    return scheduleTransition(colorHueTransitionState.endpoint, hueSatTransitionTick);
+}
+
+static EmberAfStatus scheduleXyTransition(void)
+{
+    return scheduleTransition(colorXTransitionState.endpoint, xyTransitionTick);
+}
+
+static EmberAfStatus scheduleTempTransition(void)
+{
+    return scheduleTransition(colorTempTransitionState.endpoint, tempTransitionTick);
+}
+
 static void stopAllColorTransitions(void)
 {
-    emberEventControlSetInactive(&COLOR_TEMP_CONTROL);
-    emberEventControlSetInactive(&COLOR_XY_CONTROL);
-    emberEventControlSetInactive(&COLOR_HSV_CONTROL);
+    emberAfTransitionCancel(colorTempTransitionState.endpoint, tempTransitionTick);
+    emberAfTransitionCancel(colorXTransitionState.endpoint, xyTransitionTick);
+    emberAfTransitionCancel(colorHueTransitionState.endpoint, hueSatTransitionTick);
 }
 
 void emberAfPluginColorControlServerStopTransition(void)
@@ -1532,9 +1541,10 @@ static bool computeNewHueValue(ColorHueTransitionState * p)
     return false;
 }
 
-extern "C" void emberAfPluginColorControlServerHueSatTransitionEventHandler(void)
+static void hueSatTransitionTick(EndpointId endpoint)
 {
-    EndpointId endpoint = colorHueTransitionState.endpoint;
+    uint8_t previousHue         = colorHueTransitionState.currentHue;
+    uint16_t previousSaturation = colorSaturationTransitionState.currentValue;
     bool limitReached1, limitReached2;
 
     limitReached1 = computeNewHueValue(&colorHueTransitionState);
@@ -1546,11 +1556,19 @@ extern "C" void emberAfPluginColorControlServerHueSatTransitionEventHandler(void
     }
     else
     {
-        emberEventControlSetDelayMS(&COLOR_HSV_CONTROL, UPDATE_TIME_MS);
+        scheduleHueSatTransition();
     }
 
-    writeHue(colorHueTransitionState.endpoint, colorHueTransitionState.currentHue);
-    writeSaturation(colorSaturationTransitionState.endpoint, (uint8_t) colorSaturationTransitionState.currentValue);
+    // Only write the attributes that changed during this step; slow transitions
+    // leave them unchanged for several steps.
+    if (colorHueTransitionState.currentHue != previousHue)
+    {
+        writeHue(colorHueTransitionState.endpoint, colorHueTransitionState.currentHue);
+    }
+    if (colorSaturationTransitionState.currentValue != previousSaturation)
+    {
+        writeSaturation(colorSaturationTransitionState.endpoint, (uint8_t) colorSaturationTransitionState.currentValue);
+    }
 
     emberAfColorControlClusterPrintln("Hue %d Saturation %d endpoint %d", colorHueTransitionState.currentHue,
                                       colorSaturationTransitionState.currentValue, endpoint);
@@ -1561,8 +1579,6 @@ extern "C" void emberAfPluginColorControlServerHueSatTransitionEventHandler(void
 // Return value of true means we need to stop.
 static bool computeNewColor16uValue(Color16uTransitionState * p)
 {
-    uint32_t newValue32u;
-
     if (p->stepsRemaining == 0)
     {
         return false;
@@ -1572,24 +1588,10 @@ static bool computeNewColor16uValue(Color16uTransitionState * p)
 
     writeRemainingTime(p->endpoint, p->stepsRemaining);
 
-    // handle sign
-    if (p->finalValue == p->currentValue)
+    if (p->finalValue != p->currentValue)
     {
-        // do nothing
-    }
-    else if (p->finalValue > p->initialValue)
-    {
-        newValue32u = ((uint32_t)(p->finalValue - p->initialValue));
-        newValue32u *= ((uint32_t)(p->stepsRemaining));
-        newValue32u /= ((uint32_t)(p->stepsTotal));
-        p->currentValue = static_cast<uint16_t>(p->finalValue - static_cast<uint16_t>(newValue32u));
-    }
-    else
-    {
-        newValue32u = ((uint32_t)(p->initialValue - p->finalValue));
-        newValue32u *= ((uint32_t)(p->stepsRemaining));
-        newValue32u /= ((uint32_t)(p->stepsTotal));
-        p->currentValue = static_cast<uint16_t>(p->finalValue + static_cast<uint16_t>(newValue32u));
+        p->currentValue = emberAfTransitionInterpolate(p->initialValue, p->finalValue,
+                                                       static_cast<uint32_t>(p->stepsTotal - p->stepsRemaining), p->stepsTotal);
     }
 
     if (p->stepsRemaining == 0)
@@ -1634,9 +1636,10 @@ static uint16_t computeTransitionTimeFromStateAndRate(Color16uTransitionState *
     return (uint16_t) transitionTime;
 }
 
-extern "C" void emberAfPluginColorControlServerXyTransitionEventHandler(void)
+static void xyTransitionTick(EndpointId endpoint)
 {
-    EndpointId endpoint = colorXTransitionState.endpoint;
+    uint16_t previousX = colorXTransitionState.currentValue;
+    uint16_t previousY = colorYTransitionState.currentValue;
     bool limitReachedX, limitReachedY;
 
     // compute new values for X and Y.
@@ -1650,12 +1653,18 @@ extern "C" void emberAfPluginColorControlServerXyTransitionEventHandler(void)
     }
     else
     {
-        emberEventControlSetDelayMS(&COLOR_XY_CONTROL, UPDATE_TIME_MS);
+        scheduleXyTransition();
     }
 
-    // update the attributes
-    writeColorX(colorXTransitionState.endpoint, colorXTransitionState.currentValue);
-    writeColorY(colorXTransitionState.endpoint, colorYTransitionState.currentValue);
+    // update the attributes that changed
+    if (colorXTransitionState.currentValue != previousX)
+    {
+        writeColorX(colorXTransitionState.endpoint, colorXTransitionState.currentValue);
+    }
+    if (colorYTransitionState.currentValue != previousY)
+    {
+        writeColorY(colorXTransitionState.endpoint, colorYTransitionState.currentValue);
+    }
 
     emberAfColorControlClusterPrintln("Color X %d Color Y %d", colorXTransitionState.currentValue,
                                       colorYTransitionState.currentValue);
@@ -1663,9 +1672,9 @@ extern "C" void emberAfPluginColorControlServerXyTransitionEventHandler(void)
     emberAfPluginColorControlServerComputePwmFromXyCallback(endpoint);
 }
 
-extern "C" void emberAfPluginColorControlServerTempTransitionEventHandler(void)
+static void tempTransitionTick(EndpointId endpoint)
 {
-    EndpointId endpoint = colorTempTransitionState.endpoint;
+    uint16_t previousTemp = colorTempTransitionState.currentValue;
     bool limitReached;
 
     limitReached = computeNewColor16uValue(&colorTempTransitionState);
@@ -1676,16 +1685,37 @@ extern "C" void emberAfPluginColorControlServerTempTransitionEventHandler(void)
     }
     else
     {
-        emberEventControlSetDelayMS(&COLOR_TEMP_CONTROL, UPDATE_TIME_MS);
+        scheduleTempTransition();
     }
 
-    writeColorTemperature(colorTempTransitionState.endpoint, colorTempTransitionState.currentValue);
+    if (colorTempTransitionState.currentValue != previousTemp)
+    {
+        writeColorTemperature(colorTempTransitionState.endpoint, colorTempTransitionState.currentValue);
+    }
 
     emberAfColorControlClusterPrintln("Color Temperature %d", colorTempTransitionState.currentValue);
 
     emberAfPluginColorControlServerComputePwmFromTempCallback(endpoint);
 }
 
+// The transition event controls are still part of the generated event table,
+// but transitions are now driven by the shared transition tick.  Running one of
+// these events just performs one step of the matching transition.
+extern "C" void emberAfPluginColorControlServerHueSatTransitionEventHandler(void)
+{
+    hueSatTransitionTick(colorHueTransitionState.endpoint);
+}
+
+extern "C" void emberAfPluginColorControlServerXyTransitionEventHandler(void)
+{
+    xyTransitionTick(colorXTransitionState.endpoint);
+}
+
+extern "C" void emberAfPluginColorControlServerTempTransitionEventHandler(void)
+{
+    tempTransitionTick(colorTempTransitionState.endpoint);
+}
+
 static bool shouldExecuteIfOff(EndpointId endpoint, uint8_t optionMask, uint8_t optionOverride)
 {
     // From 5.2.2.2.1.10 of ZCL7 document 14-0129-15f-zcl-ch-5-lighting.docx:
@@ -47,6 +47,7 @@
 
 #include <app/util/af.h>
 #include <app/util/binding-table.h>
+#include <app/util/util.h>
 
 using namespace chip;
 
@@ -54,7 +55,14 @@ static bool isGroupPresent(EndpointId endpoint, GroupId groupId);
 
 static bool bindingGroupMatch(EndpointId endpoint, GroupId groupId, EmberBindingTableEntry * entry);
 
-static uint8_t findGroupIndex(EndpointId endpoint, GroupId groupId);
+static uint16_t findGroupIndex(EndpointId endpoint, GroupId groupId);
+
+// The most group IDs a Get Group Membership Response can carry: what fits in
+// the response payload after the ZCL header and the capacity and count fields,
+// and never more than the count field can express.
+#define GROUP_MEMBERSHIP_LIST_MAX_IN_PAYLOAD (((EMBER_AF_RESPONSE_BUFFER_LEN) - EMBER_AF_ZCL_OVERHEAD - 2) >> 1)
+#define GROUP_MEMBERSHIP_LIST_MAX                                                                                                  \
+    (GROUP_MEMBERSHIP_LIST_MAX_IN_PAYLOAD < UINT8_MAX ? GROUP_MEMBERSHIP_LIST_MAX_IN_PAYLOAD : UINT8_MAX)
 
 void emberAfGroupsClusterServerInitCallback(EndpointId endpoint)
 {
@@ -80,7 +88,8 @@ void emberAfGroupsClusterServerInitCallback(EndpointId endpoint)
 // --------------------------
 static EmberAfStatus addEntryToGroupTable(EndpointId endpoint, GroupId groupId, uint8_t * groupName)
 {
-    uint8_t i;
+    uint16_t i;
+    EmberBindingTableEntry binding;
 
     // Check for duplicates.
     if (isGroupPresent(endpoint, groupId))
@@ -92,27 +101,25 @@ static EmberAfStatus addEntryToGroupTable(EndpointId endpoint, GroupId groupId,
     }
 
     // Look for an empty binding slot.
-    for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    i = emberBindingTableFindUnusedIndex();
+    if (i != EMBER_NULL_BINDING && emberGetBinding(i, &binding) == EMBER_SUCCESS)
     {
-        EmberBindingTableEntry binding;
-        if (emberGetBinding(i, &binding) == EMBER_SUCCESS && binding.type == EMBER_UNUSED_BINDING)
-        {
-            EmberStatus status;
-            binding.type    = EMBER_MULTICAST_BINDING;
-            binding.groupId = groupId;
-            binding.local   = endpoint;
+        EmberStatus status;
+        binding.type    = EMBER_MULTICAST_BINDING;
+        binding.groupId = groupId;
+        binding.local   = endpoint;
 
-            status = emberSetBinding(i, &binding);
-            if (status == EMBER_SUCCESS)
-            {
-                // Set the group name, if supported
-                emberAfPluginGroupsServerSetGroupNameCallback(endpoint, groupId, groupName);
-                return EMBER_ZCL_STATUS_SUCCESS;
-            }
-            else
-            {
-                emberAfGroupsClusterPrintln("ERR: Failed to create binding (0x%x)", status);
-            }
+        status = emberSetBinding(i, &binding);
+        if (status == EMBER_SUCCESS)
+        {
+            // Set the group name, if supported
+            emberAfPluginGroupsServerSetGroupNameCallback(endpoint, groupId, groupName);
+            return EMBER_ZCL_STATUS_SUCCESS;
+        }
+        else
+        {
+            emberAfGroupsClusterPrintln("ERR: Failed to create binding (0x%x)", status);
+            return EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
         }
     }
     emberAfGroupsClusterPrintln("ERR: Binding table is full");
@@ -123,7 +130,7 @@ static EmberAfStatus removeEntryFromGroupTable(EndpointId endpoint, GroupId grou
 {
     if (isGroupPresent(endpoint, groupId))
     {
-        uint8_t bindingIndex = findGroupIndex(endpoint, groupId);
+        uint16_t bindingIndex = findGroupIndex(endpoint, groupId);
         EmberStatus status   = emberDeleteBinding(bindingIndex);
         if (status == EMBER_SUCCESS)
         {
@@ -198,10 +205,10 @@ bool emberAfGroupsClusterViewGroupCallback(GroupId groupId)
 bool emberAfGroupsClusterGetGroupMembershipCallback(uint8_t groupCount, uint8_t * groupList)
 {
     EmberStatus status;
-    uint8_t i, j;
-    uint8_t count = 0;
-    uint8_t list[EMBER_BINDING_TABLE_SIZE << 1];
-    uint8_t listLen = 0;
+    uint16_t i, j;
+    uint16_t count = 0;
+    uint8_t list[GROUP_MEMBERSHIP_LIST_MAX << 1];
+    uint16_t listLen = 0;
 
     emberAfGroupsClusterPrint("RX: GetGroupMembership 0x%x,", groupCount);
     for (i = 0; i < groupCount; i++)
@@ -223,31 +230,33 @@ bool emberAfGroupsClusterGetGroupMembershipCallback(uint8_t groupCount, uint8_t
             status = emberGetBinding(i, &entry);
             if ((status == EMBER_SUCCESS) && (entry.type == EMBER_MULTICAST_BINDING) && (entry.local == emberAfCurrentEndpoint()))
             {
+                if (count == GROUP_MEMBERSHIP_LIST_MAX)
+                {
+                    break;
+                }
                 list[listLen]     = LOW_BYTE(entry.groupId);
                 list[listLen + 1] = HIGH_BYTE(entry.groupId);
-                listLen           = static_cast<uint8_t>(listLen + 2);
+                listLen           = static_cast<uint16_t>(listLen + 2);
                 count++;
             }
         }
     }
     else
     {
-        for (i = 0; i < groupCount; i++)
+        for (i = 0; i < groupCount && count < GROUP_MEMBERSHIP_LIST_MAX; i++)
         {
             GroupId groupId = emberAfGetInt16u(groupList + (i << 1), 0, 2);
-            for (j = 0; j < EMBER_BINDING_TABLE_SIZE; j++)
+            EmberBindingTableIterator iterator;
+            EmberBindingTableEntry entry;
+            emberBindingTableIterateGroup(&iterator, groupId);
+            while (count < GROUP_MEMBERSHIP_LIST_MAX && emberBindingTableIteratorNext(&iterator, &j, &entry))
             {
-                EmberBindingTableEntry entry;
-                status = emberGetBinding(j, &entry);
-                if ((status == EMBER_SUCCESS) && (entry.type == EMBER_MULTICAST_BINDING))
+                if (entry.local == emberAfCurrentEndpoint())
                 {
-                    if (entry.local == emberAfCurrentEndpoint() && entry.groupId == groupId)
-                    {
-                        list[listLen]     = LOW_BYTE(groupId);
-                        list[listLen + 1] = HIGH_BYTE(groupId);
-                        listLen           = static_cast<uint8_t>(listLen + 2);
-                        count++;
-                    }
+                    list[listLen]     = LOW_BYTE(groupId);
+                    list[listLen + 1] = HIGH_BYTE(groupId);
+                    listLen           = static_cast<uint16_t>(listLen + 2);
+                    count++;
                 }
             }
         }
@@ -311,7 +320,7 @@ bool emberAfGroupsClusterRemoveGroupCallback(GroupId groupId)
 bool emberAfGroupsClusterRemoveAllGroupsCallback(void)
 {
     EmberStatus sendStatus;
-    uint8_t i;
+    uint16_t i;
     EndpointId endpoint = emberAfCurrentEndpoint();
     bool success        = true;
 
@@ -390,7 +399,8 @@ bool emberAfGroupsClusterEndpointInGroupCallback(EndpointId endpoint, GroupId gr
 
 void emberAfGroupsClusterClearGroupTableCallback(EndpointId endpoint)
 {
-    uint8_t i, networkIndex = 0 /* emberGetCurrentNetwork() */;
+    uint16_t i;
+    uint8_t networkIndex = 0 /* emberGetCurrentNetwork() */;
     for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
     {
         EmberBindingTableEntry binding;
@@ -408,21 +418,7 @@ void emberAfGroupsClusterClearGroupTableCallback(EndpointId endpoint)
 
 static bool isGroupPresent(EndpointId endpoint, GroupId groupId)
 {
-    uint8_t i;
-
-    for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
-    {
-        EmberBindingTableEntry binding;
-        if (emberGetBinding(i, &binding) == EMBER_SUCCESS)
-        {
-            if (bindingGroupMatch(endpoint, groupId, &binding))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return findGroupIndex(endpoint, groupId) != EMBER_NULL_BINDING;
 }
 
 static bool bindingGroupMatch(EndpointId endpoint, GroupId groupId, EmberBindingTableEntry * entry)
@@ -430,19 +426,19 @@ static bool bindingGroupMatch(EndpointId endpoint, GroupId groupId, EmberBinding
     return (entry->type == EMBER_MULTICAST_BINDING && entry->groupId == groupId && entry->local == endpoint);
 }
 
-static uint8_t findGroupIndex(EndpointId endpoint, GroupId groupId)
+static uint16_t findGroupIndex(EndpointId endpoint, GroupId groupId)
 {
-    EmberStatus status;
-    uint8_t i;
+    EmberBindingTableIterator iterator;
+    EmberBindingTableEntry entry;
+    uint16_t i;
 
-    for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    emberBindingTableIterateGroup(&iterator, groupId);
+    while (emberBindingTableIteratorNext(&iterator, &i, &entry))
     {
-        EmberBindingTableEntry entry;
-        status = emberGetBinding(i, &entry);
-        if ((status == EMBER_SUCCESS) && bindingGroupMatch(endpoint, groupId, &entry))
+        if (bindingGroupMatch(endpoint, groupId, &entry))
         {
             return i;
         }
     }
-    return EMBER_AF_GROUP_TABLE_NULL_INDEX;
+    return EMBER_NULL_BINDING;
 }
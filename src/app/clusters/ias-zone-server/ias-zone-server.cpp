@@ -206,7 +206,7 @@ EmberAfStatus emberAfIasZoneClusterServerPreAttributeChangedCallback(EndpointId
                                                                      EmberAfAttributeType attributeType, uint8_t size,
                                                                      uint8_t * value)
 {
-    uint8_t i;
+    uint16_t i;
     bool zeroAddress;
     EmberBindingTableEntry bindingEntry;
     EmberBindingTableEntry currentBind;
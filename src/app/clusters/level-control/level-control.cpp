@@ -42,6 +42,7 @@
 #include "level-control.h"
 
 // this file contains all the common includes for clusters in the util
+#include <app/util/af-transition.h>
 #include <app/util/af.h>
 
 #ifdef EMBER_AF_PLUGIN_REPORTING
@@ -82,12 +83,12 @@ static bool areStartUpLevelControlServerAttributesTokenized(EndpointId endpoint)
 typedef struct
 {
     uint8_t commandId;
+    uint8_t initialLevel;
     uint8_t moveToLevel;
     bool increasing;
     bool useOnLevel;
     uint8_t onLevel;
     uint16_t storedLevel;
-    uint32_t eventDurationMs;
     uint32_t transitionTimeMs;
     uint32_t elapsedTimeMs;
 } EmberAfLevelControlState;
@@ -114,14 +115,36 @@ static void reallyUpdateCoupledColorTemp(EndpointId endpoint);
 #define updateCoupledColorTemp(endpoint)
 #endif // LEVEL...OPTIONS_ATTRIBUTE && COLOR...SERVER_TEMP
 
-static void schedule(EndpointId endpoint, uint32_t delayMs)
+// Transitions are driven by the shared transition tick, which calls
+// emberAfLevelControlClusterServerTickCallback every EMBER_AF_TRANSITION_TICK_MS
+// for as long as the endpoint keeps scheduling itself.  A transition that
+// cannot be scheduled does not start, and the command that asked for it fails.
+static EmberAfStatus schedule(EndpointId endpoint)
 {
-    emberAfScheduleServerTickExtended(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, delayMs, EMBER_AF_LONG_POLL, EMBER_AF_OK_TO_SLEEP);
+    if (emberAfTransitionSchedule(endpoint, emberAfLevelControlClusterServerTickCallback) != EMBER_SUCCESS)
+    {
+        emberAfLevelControlClusterPrintln("ERR: no room to schedule transition");
+        writeRemainingTime(endpoint, 0);
+        return EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
+    }
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+// A transition without duration completes right away instead of waiting for
+// the next tick.
+static EmberAfStatus startTransition(EndpointId endpoint, const EmberAfLevelControlState * state)
+{
+    if (state->transitionTimeMs == 0)
+    {
+        emberAfLevelControlClusterServerTickCallback(endpoint);
+        return EMBER_ZCL_STATUS_SUCCESS;
+    }
+    return schedule(endpoint);
 }
 
 static void deactivate(EndpointId endpoint)
 {
-    emberAfDeactivateServerTick(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfTransitionCancel(endpoint, emberAfLevelControlClusterServerTickCallback);
 }
 
 static EmberAfLevelControlState * getState(EndpointId endpoint)
@@ -153,14 +176,18 @@ extern "C" void emberAfLevelControlClusterServerTickCallback(EndpointId endpoint
 {
     EmberAfLevelControlState * state = getState(endpoint);
     EmberAfStatus status;
-    uint8_t currentLevel;
+    uint8_t currentLevel, newLevel;
 
     if (state == NULL)
     {
         return;
     }
 
-    state->elapsedTimeMs += state->eventDurationMs;
+    state->elapsedTimeMs += EMBER_AF_TRANSITION_TICK_MS;
+    if (state->elapsedTimeMs > state->transitionTimeMs)
+    {
+        state->elapsedTimeMs = state->transitionTimeMs;
+    }
 
 #if !defined(ZCL_USING_LEVEL_CONTROL_CLUSTER_OPTIONS_ATTRIBUTE) && defined(EMBER_AF_PLUGIN_ZLL_LEVEL_CONTROL_SERVER)
     if (emberAfPluginZllLevelControlServerIgnoreMoveToLevelMoveStepStop(endpoint, state->commandId))
@@ -179,45 +206,34 @@ extern "C" void emberAfLevelControlClusterServerTickCallback(EndpointId endpoint
         return;
     }
 
-    emberAfLevelControlClusterPrint("Event: move from %d", currentLevel);
+    // The level is interpolated from the start of the transition rather than
+    // stepped by one, so the transition keeps its duration whatever the tick
+    // interval, and ticks that do not change the level write nothing.
+    newLevel = static_cast<uint8_t>(
+        emberAfTransitionInterpolate(state->initialLevel, state->moveToLevel, state->elapsedTimeMs, state->transitionTimeMs));
 
-    // adjust by the proper amount, either up or down
-    if (state->transitionTimeMs == 0)
-    {
-        // Immediate, not over a time interval.
-        currentLevel = state->moveToLevel;
-    }
-    else if (state->increasing)
+    if (newLevel != currentLevel)
     {
-        assert(currentLevel < MAX_LEVEL);
-        assert(currentLevel < state->moveToLevel);
-        currentLevel++;
-    }
-    else
-    {
-        assert(MIN_LEVEL < currentLevel);
-        assert(state->moveToLevel < currentLevel);
-        currentLevel--;
-    }
+        emberAfLevelControlClusterPrintln("Event: move from %d to %d", currentLevel, newLevel);
 
-    emberAfLevelControlClusterPrint(" to %d ", currentLevel);
-    emberAfLevelControlClusterPrintln("(diff %c1)", state->increasing ? '+' : '-');
+        status = emberAfWriteServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID,
+                                             (uint8_t *) &newLevel, ZCL_INT8U_ATTRIBUTE_TYPE);
+        if (status != EMBER_ZCL_STATUS_SUCCESS)
+        {
+            emberAfLevelControlClusterPrintln("ERR: writing current level %x", status);
+            writeRemainingTime(endpoint, 0);
+            return;
+        }
 
-    status = emberAfWriteServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID,
-                                         (uint8_t *) &currentLevel, ZCL_INT8U_ATTRIBUTE_TYPE);
-    if (status != EMBER_ZCL_STATUS_SUCCESS)
-    {
-        emberAfLevelControlClusterPrintln("ERR: writing current level %x", status);
-        writeRemainingTime(endpoint, 0);
-        return;
-    }
+        updateCoupledColorTemp(endpoint);
 
-    updateCoupledColorTemp(endpoint);
+        // The level has changed, so the scene is no longer valid.
+        if (emberAfContainsServer(endpoint, ZCL_SCENES_CLUSTER_ID))
+        {
+            emberAfScenesClusterMakeInvalidCallback(endpoint);
+        }
 
-    // The level has changed, so the scene is no longer valid.
-    if (emberAfContainsServer(endpoint, ZCL_SCENES_CLUSTER_ID))
-    {
-        emberAfScenesClusterMakeInvalidCallback(endpoint);
+        currentLevel = newLevel;
     }
 
     // Are we at the requested level?
@@ -263,7 +279,7 @@ extern "C" void emberAfLevelControlClusterServerTickCallback(EndpointId endpoint
     else
     {
         writeRemainingTime(endpoint, static_cast<uint16_t>(state->transitionTimeMs - state->elapsedTimeMs));
-        schedule(endpoint, state->eventDurationMs);
+        schedule(endpoint);
     }
 }
 
@@ -458,7 +474,6 @@ static void moveToLevelHandler(uint8_t commandId, uint8_t level, uint16_t transi
     EmberAfLevelControlState * state = getState(endpoint);
     EmberAfStatus status;
     uint8_t currentLevel;
-    uint8_t actualStepSize;
 
     if (state == NULL)
     {
@@ -516,12 +531,10 @@ static void moveToLevelHandler(uint8_t commandId, uint8_t level, uint16_t transi
             goto send_default_response;
         }
         state->increasing = true;
-        actualStepSize    = static_cast<uint8_t>(state->moveToLevel - currentLevel);
     }
     else
     {
         state->increasing = false;
-        actualStepSize    = static_cast<uint8_t>(currentLevel - state->moveToLevel);
     }
 
     // If the Transition time field takes the value 0xFFFF, then the time taken
@@ -557,10 +570,8 @@ static void moveToLevelHandler(uint8_t commandId, uint8_t level, uint16_t transi
         state->transitionTimeMs = (transitionTimeDs * MILLISECOND_TICKS_PER_SECOND / 10);
     }
 
-    // The duration between events will be the transition time divided by the
-    // distance we must move.
-    state->eventDurationMs = state->transitionTimeMs / actualStepSize;
-    state->elapsedTimeMs   = 0;
+    state->initialLevel  = currentLevel;
+    state->elapsedTimeMs = 0;
 
     // OnLevel is not used for Move commands.
     state->useOnLevel = false;
@@ -568,8 +579,11 @@ static void moveToLevelHandler(uint8_t commandId, uint8_t level, uint16_t transi
     state->storedLevel = storedLevel;
 
     // The setup was successful, so mark the new state as active and return.
-    schedule(endpoint, state->eventDurationMs);
-    status = EMBER_ZCL_STATUS_SUCCESS;
+    status = startTransition(endpoint, state);
+    if (status != EMBER_ZCL_STATUS_SUCCESS)
+    {
+        goto send_default_response;
+    }
 
 #ifdef EMBER_AF_PLUGIN_ZLL_LEVEL_CONTROL_SERVER
     if (commandId == ZCL_MOVE_TO_LEVEL_WITH_ON_OFF_COMMAND_ID)
@@ -592,6 +606,7 @@ static void moveHandler(uint8_t commandId, uint8_t moveMode, uint8_t rate, uint8
     EmberAfStatus status;
     uint8_t currentLevel;
     uint8_t difference;
+    uint32_t stepDurationMs;
 
     if (state == NULL)
     {
@@ -664,7 +679,7 @@ static void moveHandler(uint8_t commandId, uint8_t moveMode, uint8_t rate, uint8
         if (status != EMBER_ZCL_STATUS_SUCCESS)
         {
             emberAfLevelControlClusterPrintln("ERR: reading default move rate %x", status);
-            state->eventDurationMs = FASTEST_TRANSITION_TIME_MS;
+            stepDurationMs = FASTEST_TRANSITION_TIME_MS;
         }
         else
         {
@@ -674,23 +689,23 @@ static void moveHandler(uint8_t commandId, uint8_t moveMode, uint8_t rate, uint8
                 status = EMBER_ZCL_STATUS_SUCCESS;
                 goto send_default_response;
             }
-            state->eventDurationMs = MILLISECOND_TICKS_PER_SECOND / defaultMoveRate;
+            stepDurationMs = MILLISECOND_TICKS_PER_SECOND / defaultMoveRate;
         }
     }
     else
     {
-        state->eventDurationMs = MILLISECOND_TICKS_PER_SECOND / rate;
+        stepDurationMs = MILLISECOND_TICKS_PER_SECOND / rate;
     }
 
-    state->transitionTimeMs = difference * state->eventDurationMs;
+    state->transitionTimeMs = difference * stepDurationMs;
+    state->initialLevel     = currentLevel;
     state->elapsedTimeMs    = 0;
 
     // OnLevel is not used for Move commands.
     state->useOnLevel = false;
 
     // The setup was successful, so mark the new state as active and return.
-    schedule(endpoint, state->eventDurationMs);
-    status = EMBER_ZCL_STATUS_SUCCESS;
+    status = startTransition(endpoint, state);
 
 send_default_response:
     emberAfSendImmediateDefaultResponse(status);
@@ -800,17 +815,14 @@ static void stepHandler(uint8_t commandId, uint8_t stepMode, uint8_t stepSize, u
         }
     }
 
-    // The duration between events will be the transition time divided by the
-    // distance we must move.
-    state->eventDurationMs = state->transitionTimeMs / actualStepSize;
-    state->elapsedTimeMs   = 0;
+    state->initialLevel  = currentLevel;
+    state->elapsedTimeMs = 0;
 
     // OnLevel is not used for Step commands.
     state->useOnLevel = false;
 
     // The setup was successful, so mark the new state as active and return.
-    schedule(endpoint, state->eventDurationMs);
-    status = EMBER_ZCL_STATUS_SUCCESS;
+    status = startTransition(endpoint, state);
 
 send_default_response:
     emberAfSendImmediateDefaultResponse(status);
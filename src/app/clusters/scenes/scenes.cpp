@@ -53,6 +53,207 @@ uint8_t emberAfPluginScenesServerEntriesInUse = 0;
 EmberAfSceneTableEntry emberAfPluginScenesServerSceneTable[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
 #endif
 
+// Index of the scene table, so that finding a scene, a free slot, or the
+// scenes of a group does not have to retrieve every entry from storage.  It
+// holds the key of every slot and links each used slot into two hash chains:
+// one by (endpoint, group id, scene id), which finds a scene, and one by
+// (endpoint, group id), the membership list of its group.  Unused slots are
+// linked into a free list instead.  The index is built from the table on first
+// use and then kept up to date by emberAfPluginScenesServerSaveSceneEntry.
+#ifndef EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT
+#define EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT 16
+#endif
+
+static_assert(EMBER_AF_PLUGIN_SCENES_TABLE_SIZE < EMBER_AF_SCENE_TABLE_NULL_INDEX, "Scene table indexes must fit in a uint8_t");
+static_assert((EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT & (EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT - 1)) == 0,
+              "EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT must be a power of two");
+
+typedef struct
+{
+    EndpointId endpoint;
+    GroupId groupId;
+    uint8_t sceneId;
+} SceneTableKey;
+
+static SceneTableKey sceneTableIndex[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
+
+// Each bucket holds the first slot of its chain, and each slot the next slot
+// of its scene hash chain, and of its membership list or of the free list.
+static uint8_t sceneBuckets[EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT];
+static uint8_t sceneNext[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
+static uint8_t groupBuckets[EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT];
+static uint8_t groupNext[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
+static uint8_t freeSlots          = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+static bool sceneTableIndexLoaded = false;
+
+static uint8_t groupHash(EndpointId endpoint, GroupId groupId)
+{
+    return static_cast<uint8_t>((groupId * 31u + endpoint) & (EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT - 1));
+}
+
+static uint8_t sceneHash(EndpointId endpoint, GroupId groupId, uint8_t sceneId)
+{
+    return static_cast<uint8_t>(((groupId * 31u + endpoint) * 31u + sceneId) & (EMBER_AF_PLUGIN_SCENES_INDEX_BUCKET_COUNT - 1));
+}
+
+static bool isUnusedSlot(uint8_t i)
+{
+    return sceneTableIndex[i].endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+}
+
+static void unlinkFromChain(uint8_t * head, uint8_t * next, uint8_t i)
+{
+    while (*head != EMBER_AF_SCENE_TABLE_NULL_INDEX)
+    {
+        if (*head == i)
+        {
+            *head = next[i];
+            return;
+        }
+        head = &next[*head];
+    }
+}
+
+static void linkSceneSlot(uint8_t i)
+{
+    const SceneTableKey * key = &sceneTableIndex[i];
+    uint8_t bucket;
+
+    if (isUnusedSlot(i))
+    {
+        groupNext[i] = freeSlots;
+        freeSlots    = i;
+        return;
+    }
+
+    bucket               = sceneHash(key->endpoint, key->groupId, key->sceneId);
+    sceneNext[i]         = sceneBuckets[bucket];
+    sceneBuckets[bucket] = i;
+
+    bucket               = groupHash(key->endpoint, key->groupId);
+    groupNext[i]         = groupBuckets[bucket];
+    groupBuckets[bucket] = i;
+}
+
+static void unlinkSceneSlot(uint8_t i)
+{
+    const SceneTableKey * key = &sceneTableIndex[i];
+
+    if (isUnusedSlot(i))
+    {
+        unlinkFromChain(&freeSlots, groupNext, i);
+        return;
+    }
+
+    unlinkFromChain(&sceneBuckets[sceneHash(key->endpoint, key->groupId, key->sceneId)], sceneNext, i);
+    unlinkFromChain(&groupBuckets[groupHash(key->endpoint, key->groupId)], groupNext, i);
+}
+
+static void setSceneKey(const EmberAfSceneTableEntry * entry, uint8_t i)
+{
+    sceneTableIndex[i].endpoint = entry->endpoint;
+    sceneTableIndex[i].groupId  = entry->groupId;
+    sceneTableIndex[i].sceneId  = entry->sceneId;
+}
+
+static void loadSceneTableIndex(void)
+{
+    uint8_t i;
+
+    if (sceneTableIndexLoaded)
+    {
+        return;
+    }
+
+    memset(sceneBuckets, EMBER_AF_SCENE_TABLE_NULL_INDEX, sizeof(sceneBuckets));
+    memset(groupBuckets, EMBER_AF_SCENE_TABLE_NULL_INDEX, sizeof(groupBuckets));
+    freeSlots = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+
+    // Linking the slots from the last one keeps the free list in slot order.
+    for (i = EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i-- > 0;)
+    {
+        EmberAfSceneTableEntry entry;
+        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
+        setSceneKey(&entry, i);
+        linkSceneSlot(i);
+    }
+    sceneTableIndexLoaded = true;
+}
+
+void emAfPluginScenesServerIndexSceneEntry(const EmberAfSceneTableEntry * entry, uint8_t i)
+{
+    // Loading the index reads the table, which already holds this entry.
+    if (!sceneTableIndexLoaded)
+    {
+        loadSceneTableIndex();
+        return;
+    }
+
+    unlinkSceneSlot(i);
+    setSceneKey(entry, i);
+    linkSceneSlot(i);
+}
+
+// Returns the slot holding the given scene, or EMBER_AF_SCENE_TABLE_NULL_INDEX.
+// If freeIndex is not NULL, it is set to an unused slot, or to
+// EMBER_AF_SCENE_TABLE_NULL_INDEX if the table is full.
+static uint8_t findSceneIndex(EndpointId endpoint, GroupId groupId, uint8_t sceneId, uint8_t * freeIndex)
+{
+    uint8_t i;
+
+    loadSceneTableIndex();
+
+    if (freeIndex != NULL)
+    {
+        *freeIndex = freeSlots;
+    }
+
+    for (i = sceneBuckets[sceneHash(endpoint, groupId, sceneId)]; i != EMBER_AF_SCENE_TABLE_NULL_INDEX;
+         i = sceneNext[i])
+    {
+        const SceneTableKey * key = &sceneTableIndex[i];
+        if (key->endpoint == endpoint && key->groupId == groupId && key->sceneId == sceneId)
+        {
+            return i;
+        }
+    }
+
+    return EMBER_AF_SCENE_TABLE_NULL_INDEX;
+}
+
+// Invalidates every scene of the given group on the given endpoint.  Only the
+// slots that change are written back, and the entries-in-use count is stored
+// once.  Returns the number of scenes removed.
+static uint8_t removeScenesInGroup(EndpointId endpoint, GroupId groupId)
+{
+    uint8_t i, next, removed = 0;
+
+    loadSceneTableIndex();
+
+    for (i = groupBuckets[groupHash(endpoint, groupId)]; i != EMBER_AF_SCENE_TABLE_NULL_INDEX; i = next)
+    {
+        // Saving the entry moves the slot to the free list.
+        next = groupNext[i];
+
+        if (sceneTableIndex[i].endpoint == endpoint && sceneTableIndex[i].groupId == groupId)
+        {
+            EmberAfSceneTableEntry entry;
+            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
+            entry.groupId  = ZCL_SCENES_GLOBAL_SCENE_GROUP_ID;
+            entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+            emberAfPluginScenesServerSaveSceneEntry(entry, i);
+            removed++;
+        }
+    }
+
+    if (removed > 0)
+    {
+        emberAfPluginScenesServerSetNumSceneEntriesInUse(
+            static_cast<uint8_t>(emberAfPluginScenesServerNumSceneEntriesInUse() - removed));
+    }
+    return removed;
+}
+
 static bool readServerAttribute(EndpointId endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId, const char * name,
                                 uint8_t * data, uint8_t size)
 {
@@ -222,20 +423,16 @@ bool emberAfScenesClusterRemoveSceneCallback(GroupId groupId, uint8_t sceneId)
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint8_t index = findSceneIndex(emberAfCurrentEndpoint(), groupId, sceneId, NULL);
+        if (index != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
             EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
-                entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-                emberAfPluginScenesServerSaveSceneEntry(entry, i);
-                emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-                emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
-                status = EMBER_ZCL_STATUS_SUCCESS;
-                break;
-            }
+            emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
+            entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+            emberAfPluginScenesServerSaveSceneEntry(entry, index);
+            emberAfPluginScenesServerDecrNumSceneEntriesInUse();
+            emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
+            status = EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -264,19 +461,8 @@ bool emberAfScenesClusterRemoveAllScenesCallback(GroupId groupId)
     if (groupId == ZCL_SCENES_GLOBAL_SCENE_GROUP_ID ||
         emberAfGroupsClusterEndpointInGroupCallback(emberAfCurrentEndpoint(), groupId))
     {
-        uint8_t i;
         status = EMBER_ZCL_STATUS_SUCCESS;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
-        {
-            EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId)
-            {
-                entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-                emberAfPluginScenesServerSaveSceneEntry(entry, i);
-                emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-            }
-        }
+        removeScenesInGroup(emberAfCurrentEndpoint(), groupId);
         emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
     }
 
@@ -375,13 +561,14 @@ bool emberAfScenesClusterGetSceneMembershipCallback(GroupId groupId)
     if (status == EMBER_ZCL_STATUS_SUCCESS)
     {
         uint8_t i, sceneList[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        loadSceneTableIndex();
+        for (i = groupBuckets[groupHash(emberAfCurrentEndpoint(), groupId)]; i != EMBER_AF_SCENE_TABLE_NULL_INDEX;
+             i = groupNext[i])
         {
-            EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId)
+            const SceneTableKey * key = &sceneTableIndex[i];
+            if (key->endpoint == emberAfCurrentEndpoint() && key->groupId == groupId)
             {
-                sceneList[sceneCount] = entry.sceneId;
+                sceneList[sceneCount] = key->sceneId;
                 sceneCount++;
             }
         }
@@ -409,7 +596,8 @@ bool emberAfScenesClusterGetSceneMembershipCallback(GroupId groupId)
 EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(EndpointId endpoint, GroupId groupId, uint8_t sceneId)
 {
     EmberAfSceneTableEntry entry;
-    uint8_t i, index = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    uint8_t freeIndex, index;
+    bool newEntry;
 
     // If a group id is specified but this endpoint isn't in it, take no action.
     if (groupId != ZCL_SCENES_GLOBAL_SCENE_GROUP_ID && !emberAfGroupsClusterEndpointInGroupCallback(endpoint, groupId))
@@ -417,18 +605,11 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(EndpointId endpoint,
         return EMBER_ZCL_STATUS_INVALID_FIELD;
     }
 
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    index    = findSceneIndex(endpoint, groupId, sceneId, &freeIndex);
+    newEntry = (index == EMBER_AF_SCENE_TABLE_NULL_INDEX);
+    if (newEntry)
     {
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-        {
-            index = i;
-            break;
-        }
-        else if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX && entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
-        {
-            index = i;
-        }
+        index = freeIndex;
     }
 
     // If the target index is still zero, the table is full.
@@ -501,7 +682,7 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(EndpointId endpoint,
     // length is set to zero) and the transition time is set to zero.  The scene
     // count must be increased and written to the attribute table when adding a
     // new scene.  Otherwise, these fields and the count are left alone.
-    if (i != index)
+    if (newEntry)
     {
         entry.endpoint = endpoint;
         entry.groupId  = groupId;
@@ -530,116 +711,111 @@ EmberAfStatus emberAfScenesClusterRecallSavedSceneCallback(EndpointId endpoint,
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint8_t index = findSceneIndex(endpoint, groupId, sceneId, NULL);
+        if (index != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
             EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
+            emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
 #ifdef ZCL_USING_ON_OFF_CLUSTER_SERVER
-                if (entry.hasOnOffValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, "on/off",
-                                         (uint8_t *) &entry.onOffValue, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasOnOffValue)
+            {
+                writeServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, "on/off",
+                                     (uint8_t *) &entry.onOffValue, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_LEVEL_CONTROL_CLUSTER_SERVER
-                if (entry.hasCurrentLevelValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, "current level",
-                                         (uint8_t *) &entry.currentLevelValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasCurrentLevelValue)
+            {
+                writeServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, "current level",
+                                     (uint8_t *) &entry.currentLevelValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_THERMOSTAT_CLUSTER_SERVER
-                if (entry.hasOccupiedCoolingSetpointValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_COOLING_SETPOINT_ATTRIBUTE_ID,
-                                         "occupied cooling setpoint", (uint8_t *) &entry.occupiedCoolingSetpointValue,
-                                         ZCL_INT16S_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasOccupiedHeatingSetpointValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_HEATING_SETPOINT_ATTRIBUTE_ID,
-                                         "occupied heating setpoint", (uint8_t *) &entry.occupiedHeatingSetpointValue,
-                                         ZCL_INT16S_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasSystemModeValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_SYSTEM_MODE_ATTRIBUTE_ID, "system mode",
-                                         (uint8_t *) &entry.systemModeValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasOccupiedCoolingSetpointValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_COOLING_SETPOINT_ATTRIBUTE_ID,
+                                     "occupied cooling setpoint", (uint8_t *) &entry.occupiedCoolingSetpointValue,
+                                     ZCL_INT16S_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasOccupiedHeatingSetpointValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_HEATING_SETPOINT_ATTRIBUTE_ID,
+                                     "occupied heating setpoint", (uint8_t *) &entry.occupiedHeatingSetpointValue,
+                                     ZCL_INT16S_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasSystemModeValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_SYSTEM_MODE_ATTRIBUTE_ID, "system mode",
+                                     (uint8_t *) &entry.systemModeValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_COLOR_CONTROL_CLUSTER_SERVER
-                if (entry.hasCurrentXValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_X_ATTRIBUTE_ID,
-                                         "current x", (uint8_t *) &entry.currentXValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentYValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_Y_ATTRIBUTE_ID,
-                                         "current y", (uint8_t *) &entry.currentYValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasCurrentXValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_X_ATTRIBUTE_ID, "current x",
+                                     (uint8_t *) &entry.currentXValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentYValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_Y_ATTRIBUTE_ID, "current y",
+                                     (uint8_t *) &entry.currentYValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
 
-                if (entry.hasEnhancedCurrentHueValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
-                                         ZCL_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ATTRIBUTE_ID, "enhanced current hue",
-                                         (uint8_t *) &entry.enhancedCurrentHueValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentSaturationValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_SATURATION_ATTRIBUTE_ID,
-                                         "current saturation", (uint8_t *) &entry.currentSaturationValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopActiveValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ATTRIBUTE_ID,
-                                         "color loop active", (uint8_t *) &entry.colorLoopActiveValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopDirectionValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
-                                         ZCL_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ATTRIBUTE_ID, "color loop direction",
-                                         (uint8_t *) &entry.colorLoopDirectionValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopTimeValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_TIME_ATTRIBUTE_ID,
-                                         "color loop time", (uint8_t *) &entry.colorLoopTimeValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorTemperatureMiredsValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
-                                         "color temp mireds", (uint8_t *) &entry.colorTemperatureMiredsValue,
-                                         ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasEnhancedCurrentHueValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ATTRIBUTE_ID,
+                                     "enhanced current hue", (uint8_t *) &entry.enhancedCurrentHueValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentSaturationValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_SATURATION_ATTRIBUTE_ID,
+                                     "current saturation", (uint8_t *) &entry.currentSaturationValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopActiveValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ATTRIBUTE_ID,
+                                     "color loop active", (uint8_t *) &entry.colorLoopActiveValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopDirectionValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ATTRIBUTE_ID,
+                                     "color loop direction", (uint8_t *) &entry.colorLoopDirectionValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopTimeValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_TIME_ATTRIBUTE_ID,
+                                     "color loop time", (uint8_t *) &entry.colorLoopTimeValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorTemperatureMiredsValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
+                                     "color temp mireds", (uint8_t *) &entry.colorTemperatureMiredsValue,
+                                     ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
 #endif // ZCL_USING_COLOR_CONTROL_CLUSTER_SERVER
 #ifdef ZCL_USING_DOOR_LOCK_CLUSTER_SERVER
-                if (entry.hasLockStateValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_STATE_ATTRIBUTE_ID, "lock state",
-                                         (uint8_t *) &entry.lockStateValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasLockStateValue)
+            {
+                writeServerAttribute(endpoint, ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_STATE_ATTRIBUTE_ID, "lock state",
+                                     (uint8_t *) &entry.lockStateValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_WINDOW_COVERING_CLUSTER_SERVER
-                if (entry.hasCurrentPositionLiftPercentageValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_LIFT_PERCENTAGE_ATTRIBUTE_ID,
-                                         "current position lift percentage", (uint8_t *) &entry.currentPositionLiftPercentageValue,
-                                         ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentPositionTiltPercentageValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_TILT_PERCENTAGE_ATTRIBUTE_ID,
-                                         "current position tilt percentage", (uint8_t *) &entry.currentPositionTiltPercentageValue,
-                                         ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-#endif
-                emberAfScenesMakeValid(endpoint, sceneId, groupId);
-                return EMBER_ZCL_STATUS_SUCCESS;
+            if (entry.hasCurrentPositionLiftPercentageValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_LIFT_PERCENTAGE_ATTRIBUTE_ID,
+                                     "current position lift percentage", (uint8_t *) &entry.currentPositionLiftPercentageValue,
+                                     ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentPositionTiltPercentageValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_TILT_PERCENTAGE_ATTRIBUTE_ID,
+                                     "current position tilt percentage", (uint8_t *) &entry.currentPositionTiltPercentageValue,
+                                     ZCL_INT8U_ATTRIBUTE_TYPE);
             }
+#endif
+            emberAfScenesMakeValid(endpoint, sceneId, groupId);
+            return EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -658,7 +834,8 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, G
         (cmd->payloadStartIndex + sizeof(groupId) + sizeof(sceneId) + sizeof(transitionTime) + emberAfStringLength(sceneName) + 1));
     uint16_t extensionFieldSetsIndex = 0;
     EndpointId endpoint              = cmd->apsFrame->destinationEndpoint;
-    uint8_t i, index = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    uint8_t freeIndex, index;
+    bool newEntry;
 
     emberAfScenesClusterPrint("RX: %pAddScene 0x%2x, 0x%x, 0x%2x, \"", (enhanced ? "Enhanced" : ""), groupId, sceneId,
                               transitionTime);
@@ -674,18 +851,11 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, G
         goto kickout;
     }
 
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    index    = findSceneIndex(endpoint, groupId, sceneId, &freeIndex);
+    newEntry = (index == EMBER_AF_SCENE_TABLE_NULL_INDEX);
+    if (newEntry)
     {
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-        {
-            index = i;
-            break;
-        }
-        else if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX && entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
-        {
-            index = i;
-        }
+        index = freeIndex;
     }
 
     // If the target index is still zero, the table is full.
@@ -716,7 +886,7 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, G
 
     // When adding a new scene, wipe out all of the extensions before parsing the
     // extension field sets data.
-    if (i != index)
+    if (newEntry)
     {
 #ifdef ZCL_USING_ON_OFF_CLUSTER_SERVER
         entry.hasOnOffValue = false;
@@ -942,7 +1112,7 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, G
     // If we got this far, we either added a new entry or updated an existing one.
     // If we added, store the basic data and increment the scene count.  In either
     // case, save the entry.
-    if (i != index)
+    if (newEntry)
     {
         entry.endpoint = endpoint;
         entry.groupId  = groupId;
@@ -988,15 +1158,11 @@ bool emberAfPluginScenesServerParseViewScene(const EmberAfClusterCommand * cmd,
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint8_t index = findSceneIndex(endpoint, groupId, sceneId, NULL);
+        if (index != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
-                status = EMBER_ZCL_STATUS_SUCCESS;
-                break;
-            }
+            emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
+            status = EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -1146,18 +1312,8 @@ bool emberAfPluginScenesServerParseViewScene(const EmberAfClusterCommand * cmd,
 
 void emberAfScenesClusterRemoveScenesInGroupCallback(EndpointId endpoint, GroupId groupId)
 {
-    uint8_t i;
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    if (removeScenesInGroup(endpoint, groupId) > 0)
     {
-        EmberAfSceneTableEntry entry;
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId)
-        {
-            entry.groupId  = ZCL_SCENES_GLOBAL_SCENE_GROUP_ID;
-            entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-            emberAfPluginScenesServerSaveSceneEntry(entry, i);
-            emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-            emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
-        }
+        emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
     }
 }
@@ -52,10 +52,17 @@ EmberAfStatus emberAfScenesMakeValid(CHIPEndpointId endpoint, uint8_t sceneId, C
 void emAfPluginScenesServerPrintInfo(void);
 
 extern uint8_t emberAfPluginScenesServerEntriesInUse;
+
+// Every write to the scene table goes through
+// emberAfPluginScenesServerSaveSceneEntry, which keeps the in-memory index of
+// (endpoint, group id, scene id) keys up to date through this function.
+void emAfPluginScenesServerIndexSceneEntry(const EmberAfSceneTableEntry * entry, uint8_t i);
+
 #if defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) && !defined(EZSP_HOST)
 // In this case, we use token storage
 #define emberAfPluginScenesServerRetrieveSceneEntry(entry, i) halCommonGetIndexedToken(&entry, TOKEN_SCENES_TABLE, i)
-#define emberAfPluginScenesServerSaveSceneEntry(entry, i) halCommonSetIndexedToken(TOKEN_SCENES_TABLE, i, &entry)
+#define emberAfPluginScenesServerSaveSceneEntry(entry, i)                                                                          \
+    (halCommonSetIndexedToken(TOKEN_SCENES_TABLE, i, &entry), emAfPluginScenesServerIndexSceneEntry(&entry, i))
 #define emberAfPluginScenesServerNumSceneEntriesInUse()                                                                            \
     (halCommonGetToken(&emberAfPluginScenesServerEntriesInUse, TOKEN_SCENES_NUM_ENTRIES), emberAfPluginScenesServerEntriesInUse)
 #define emberAfPluginScenesServerSetNumSceneEntriesInUse(x)                                                                        \
@@ -73,7 +80,8 @@ extern uint8_t emberAfPluginScenesServerEntriesInUse;
 // Use normal RAM storage
 extern EmberAfSceneTableEntry emberAfPluginScenesServerSceneTable[];
 #define emberAfPluginScenesServerRetrieveSceneEntry(entry, i) (entry = emberAfPluginScenesServerSceneTable[i])
-#define emberAfPluginScenesServerSaveSceneEntry(entry, i) (emberAfPluginScenesServerSceneTable[i] = entry)
+#define emberAfPluginScenesServerSaveSceneEntry(entry, i)                                                                          \
+    (emberAfPluginScenesServerSceneTable[i] = entry, emAfPluginScenesServerIndexSceneEntry(&entry, i))
 #define emberAfPluginScenesServerNumSceneEntriesInUse() (emberAfPluginScenesServerEntriesInUse)
 #define emberAfPluginScenesServerSetNumSceneEntriesInUse(x) (emberAfPluginScenesServerEntriesInUse = (x))
 #define emberAfPluginScenesServerIncrNumSceneEntriesInUse() (++emberAfPluginScenesServerEntriesInUse)
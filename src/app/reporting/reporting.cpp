@@ -68,6 +68,9 @@ static void retrySendReport(EmberOutgoingMessageType type, uint64_t indexOrDesti
                             uint8_t * message, EmberStatus status);
 static uint32_t computeStringHash(uint8_t * data, uint8_t length);
 
+static bool tickSchedulingDeferred = false;
+static bool tickSchedulePending    = false;
+
 EmberEventControl emberAfPluginReportingTickEventControl;
 
 EmAfPluginReportVolatileData emAfPluginReportVolatileData[REPORT_TABLE_SIZE];
@@ -185,10 +188,12 @@ extern "C" void emberAfPluginReportingTickEventHandler(void)
     uint16_t dataSize;
     bool clientToServer = false;
     EmberBindingTableEntry bindingEntry;
+    EmberBindingTableIterator bindingIterator;
     // reportSize needs to be able to fit a sum of dataSize and some other stuff
     // without overflowing.
     uint32_t reportSize;
-    uint8_t index, currentPayloadMaxLength = 0, smallestPayloadMaxLength = 0;
+    uint16_t bindingIndex;
+    uint8_t currentPayloadMaxLength = 0, smallestPayloadMaxLength = 0;
 
     for (i = 0; i < REPORT_TABLE_SIZE; i++)
     {
@@ -270,18 +275,13 @@ extern "C" void emberAfPluginReportingTickEventHandler(void)
 
             // find smallest maximum payload that the destination can receive for this cluster and source endpoint
             smallestPayloadMaxLength = MAX_INT8U_VALUE;
-            for (index = 0; index < EMBER_BINDING_TABLE_SIZE; index++)
+            emberBindingTableIterateCluster(&bindingIterator, entry.endpoint, entry.clusterId);
+            while (emberBindingTableIteratorNext(&bindingIterator, &bindingIndex, &bindingEntry))
             {
-                status = (EmberAfStatus) emberGetBinding(index, &bindingEntry);
-                if (status == (EmberAfStatus) EMBER_SUCCESS && bindingEntry.local == entry.endpoint &&
-                    bindingEntry.clusterId == entry.clusterId)
+                currentPayloadMaxLength = emberAfMaximumApsPayloadLength(bindingEntry.type, bindingEntry.networkIndex, apsFrame);
+                if (currentPayloadMaxLength < smallestPayloadMaxLength)
                 {
-                    currentPayloadMaxLength =
-                        emberAfMaximumApsPayloadLength(bindingEntry.type, bindingEntry.networkIndex, apsFrame);
-                    if (currentPayloadMaxLength < smallestPayloadMaxLength)
-                    {
-                        smallestPayloadMaxLength = currentPayloadMaxLength;
-                    }
+                    smallestPayloadMaxLength = currentPayloadMaxLength;
                 }
             }
         }
@@ -770,10 +770,32 @@ uint8_t emAfPluginReportingAddEntry(EmberAfPluginReportingEntry * newEntry)
     return 0xFF;
 }
 
+void emAfPluginReportingDeferTickScheduling(void)
+{
+    tickSchedulingDeferred = true;
+}
+
+void emAfPluginReportingResumeTickScheduling(void)
+{
+    tickSchedulingDeferred = false;
+    if (tickSchedulePending)
+    {
+        tickSchedulePending = false;
+        scheduleTick();
+    }
+}
+
 static void scheduleTick(void)
 {
     uint32_t delayMs = MAX_INT32U_VALUE;
     uint8_t i;
+
+    if (tickSchedulingDeferred)
+    {
+        tickSchedulePending = true;
+        return;
+    }
+
     for (i = 0; i < REPORT_TABLE_SIZE; i++)
     {
         EmberAfPluginReportingEntry entry;
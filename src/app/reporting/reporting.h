@@ -82,6 +82,12 @@ uint8_t emAfPluginReportingConditionallyAddReportingEntry(EmberAfPluginReporting
 void emberAfPluginReportingLoadReportingConfigDefaults(void);
 bool emberAfPluginReportingGetReportingConfigDefaults(EmberAfPluginReportingEntry * defaultConfiguration);
 
+// While tick scheduling is deferred, attribute changes only mark the matching
+// report entries as changed.  The report tick is rescheduled once, when
+// scheduling resumes.
+void emAfPluginReportingDeferTickScheduling(void);
+void emAfPluginReportingResumeTickScheduling(void);
+
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
@@ -0,0 +1,360 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "DataModelTestHelpers.h"
+
+#include <string.h>
+
+#include <app/clusters/level-control/level-control.h>
+#include <app/util/chip-message-send.h>
+#include <app/util/common.h>
+
+using namespace chip;
+
+namespace {
+
+EmberApsFrame sCommandApsFrame;
+EmberAfClusterCommand sCommand;
+bool sResponseSent;
+EmberAfStatus sDefaultResponseStatus;
+uint8_t sSequenceNumber;
+
+// The attributes are kept in an open-addressed hash table, large enough for
+// the transitions of every level control endpoint to be benchmarked.
+constexpr size_t kMaxAttributes = 2048;
+
+struct Attribute
+{
+    bool used;
+    EndpointId endpoint;
+    ClusterId cluster;
+    AttributeId attribute;
+    uint8_t size;
+    uint8_t value[4];
+};
+
+Attribute sAttributes[kMaxAttributes];
+uint32_t sAttributeWrites;
+
+// Batch messages past the first kMaxBatches are counted, but not recorded.
+constexpr uint32_t kMaxBatches = 16;
+
+uint8_t sBatches[kMaxBatches][EMBER_AF_BATCH_RESPONSE_BUFFER_LEN];
+uint16_t sBatchLengths[kMaxBatches];
+uint32_t sBatchCount;
+uint32_t sUnicastCount;
+
+// Returns the slot of the attribute, or the free slot it would go in, or nullptr if the table is full.
+Attribute * FindAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attribute)
+{
+    size_t slot = (static_cast<size_t>(endpoint) * 31 + cluster) * 31 + attribute;
+
+    for (size_t i = 0; i < kMaxAttributes; i++)
+    {
+        Attribute * entry = &sAttributes[(slot + i) % kMaxAttributes];
+        if (!entry->used || (entry->endpoint == endpoint && entry->cluster == cluster && entry->attribute == attribute))
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+EmberAfAttributeType AttributeType(uint8_t size)
+{
+    switch (size)
+    {
+    case 1:
+        return ZCL_INT8U_ATTRIBUTE_TYPE;
+    case 2:
+        return ZCL_INT16U_ATTRIBUTE_TYPE;
+    default:
+        return ZCL_INT32U_ATTRIBUTE_TYPE;
+    }
+}
+
+uint8_t AttributeSize(EmberAfAttributeType dataType)
+{
+    switch (dataType)
+    {
+    case ZCL_BOOLEAN_ATTRIBUTE_TYPE:
+    case ZCL_BITMAP8_ATTRIBUTE_TYPE:
+    case ZCL_ENUM8_ATTRIBUTE_TYPE:
+    case ZCL_INT8U_ATTRIBUTE_TYPE:
+        return 1;
+    case ZCL_BITMAP16_ATTRIBUTE_TYPE:
+    case ZCL_ENUM16_ATTRIBUTE_TYPE:
+    case ZCL_INT16S_ATTRIBUTE_TYPE:
+    case ZCL_INT16U_ATTRIBUTE_TYPE:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+} // namespace
+
+EmberAfClusterCommand * emAfCurrentCommand;
+uint8_t emberAfResponseType;
+
+namespace chip {
+namespace Test {
+
+void SetCurrentCommand(EndpointId endpoint, ClusterId clusterId)
+{
+    memset(&sCommandApsFrame, 0, sizeof(sCommandApsFrame));
+    memset(&sCommand, 0, sizeof(sCommand));
+    sCommandApsFrame.clusterId           = clusterId;
+    sCommandApsFrame.destinationEndpoint = endpoint;
+    sCommand.apsFrame                    = &sCommandApsFrame;
+    sCommand.type                        = EMBER_INCOMING_UNICAST;
+    emAfCurrentCommand                   = &sCommand;
+
+    emberAfClearResponseData();
+    emberAfSetExternalBuffer(appResponseData, EMBER_AF_RESPONSE_BUFFER_LEN, &appResponseLength, &emberAfResponseApsFrame);
+    sResponseSent          = false;
+    sDefaultResponseStatus = EMBER_ZCL_STATUS_SUCCESS;
+}
+
+const uint8_t * GetResponse(uint16_t & length)
+{
+    length = sResponseSent ? appResponseLength : 0;
+    return sResponseSent ? appResponseData : nullptr;
+}
+
+EmberAfStatus GetDefaultResponseStatus()
+{
+    return sDefaultResponseStatus;
+}
+
+void ClearAttributes()
+{
+    memset(sAttributes, 0, sizeof(sAttributes));
+    sAttributeWrites = 0;
+}
+
+uint32_t GetAttributeWriteCount()
+{
+    return sAttributeWrites;
+}
+
+void ClearSentMessages()
+{
+    sBatchCount   = 0;
+    sUnicastCount = 0;
+}
+
+uint32_t GetUnicastCount()
+{
+    return sUnicastCount;
+}
+
+uint32_t GetBatchCount()
+{
+    return sBatchCount;
+}
+
+uint8_t * GetBatch(uint32_t index, uint16_t & length)
+{
+    if (index >= sBatchCount || index >= kMaxBatches)
+    {
+        length = 0;
+        return nullptr;
+    }
+
+    length = sBatchLengths[index];
+    return sBatches[index];
+}
+
+} // namespace Test
+} // namespace chip
+
+uint8_t emberAfNextSequence(void)
+{
+    return ++sSequenceNumber;
+}
+
+EmberStatus emberAfSendResponse(void)
+{
+    sResponseSent = true;
+
+    if (emAfBatchResponseActive())
+    {
+        return emAfAppendBatchResponse(emberAfResponseDestination, &emberAfResponseApsFrame, appResponseLength, appResponseData);
+    }
+    return EMBER_SUCCESS;
+}
+
+// Answers read attributes commands the way the framework's global command
+// handler does, with the attributes of the attribute table.
+bool emberAfProcessMessage(EmberApsFrame * apsFrame, EmberIncomingMessageType type, uint8_t * message, uint16_t msgLen,
+                           ChipNodeId source, InterPanHeader * interPanHeader)
+{
+    if (msgLen < EMBER_AF_ZCL_OVERHEAD || message[0] != ZCL_GLOBAL_COMMAND ||
+        message[EMBER_AF_ZCL_OVERHEAD - 1] != ZCL_READ_ATTRIBUTES_COMMAND_ID)
+    {
+        return false;
+    }
+
+    Test::SetCurrentCommand(apsFrame->destinationEndpoint, apsFrame->clusterId);
+    sCommand.seqNum            = message[1];
+    sCommand.commandId         = message[EMBER_AF_ZCL_OVERHEAD - 1];
+    emberAfResponseDestination = source;
+
+    emberAfFillExternalBuffer(ZCL_GLOBAL_COMMAND | ZCL_FRAME_CONTROL_SERVER_TO_CLIENT | ZCL_DISABLE_DEFAULT_RESPONSE_MASK,
+                              apsFrame->clusterId, ZCL_READ_ATTRIBUTES_RESPONSE_COMMAND_ID, "");
+    appResponseData[1]                          = sCommand.seqNum;
+    emberAfResponseApsFrame.sourceEndpoint      = apsFrame->destinationEndpoint;
+    emberAfResponseApsFrame.destinationEndpoint = apsFrame->sourceEndpoint;
+
+    for (uint16_t index = EMBER_AF_ZCL_OVERHEAD; index + 1 < msgLen; index = static_cast<uint16_t>(index + 2))
+    {
+        AttributeId attributeId     = emberAfGetInt16u(message, index, msgLen);
+        const Attribute * attribute = FindAttribute(apsFrame->destinationEndpoint, apsFrame->clusterId, attributeId);
+
+        emberAfPutInt16uInResp(attributeId);
+        if (attribute == nullptr || !attribute->used)
+        {
+            emberAfPutInt8uInResp(EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE);
+            continue;
+        }
+
+        emberAfPutInt8uInResp(EMBER_ZCL_STATUS_SUCCESS);
+        emberAfPutInt8uInResp(AttributeType(attribute->size));
+        emberAfPutBlockInResp(attribute->value, attribute->size);
+    }
+
+    emberAfSendResponse();
+    return true;
+}
+
+EmberStatus chipSendUnicast(ChipNodeId destination, EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message)
+{
+    sUnicastCount++;
+    return EMBER_SUCCESS;
+}
+
+EmberStatus chipSendUnicastBatch(ChipNodeId destination, uint16_t messageLength, uint8_t * message)
+{
+    if (sBatchCount < kMaxBatches && messageLength <= sizeof(sBatches[0]))
+    {
+        memcpy(sBatches[sBatchCount], message, messageLength);
+        sBatchLengths[sBatchCount] = messageLength;
+    }
+
+    sBatchCount++;
+    return EMBER_SUCCESS;
+}
+
+EmberStatus emberAfSendImmediateDefaultResponse(EmberAfStatus status)
+{
+    sDefaultResponseStatus = status;
+    return EMBER_SUCCESS;
+}
+
+EmberStatus emberAfSendMulticastToBindings(EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message)
+{
+    return EMBER_SUCCESS;
+}
+
+EmberStatus emberAfSendUnicastToBindingsWithCallback(EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message,
+                                                     EmberAfMessageSentFunction callback)
+{
+    return EMBER_SUCCESS;
+}
+
+bool emberAfContainsServer(EndpointId endpoint, ClusterId clusterId)
+{
+    return true;
+}
+
+EmberAfStatus emberAfReadServerAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attributeID, uint8_t * dataPtr,
+                                         uint8_t readLength)
+{
+    const Attribute * attribute = FindAttribute(endpoint, cluster, attributeID);
+
+    if (attribute == nullptr || !attribute->used)
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE;
+    }
+    if (readLength < attribute->size)
+    {
+        return EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
+    }
+
+    memcpy(dataPtr, attribute->value, attribute->size);
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+EmberAfStatus emberAfWriteServerAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attributeID, uint8_t * dataPtr,
+                                          EmberAfAttributeType dataType)
+{
+    Attribute * attribute = FindAttribute(endpoint, cluster, attributeID);
+
+    if (attribute == nullptr)
+    {
+        return EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
+    }
+
+    attribute->used      = true;
+    attribute->endpoint  = endpoint;
+    attribute->cluster   = cluster;
+    attribute->attribute = attributeID;
+    attribute->size      = AttributeSize(dataType);
+    memcpy(attribute->value, dataPtr, attribute->size);
+    sAttributeWrites++;
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+EmberAfStatus emberAfWriteAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attributeID, uint8_t mask,
+                                    uint8_t * dataPtr, EmberAfAttributeType dataType)
+{
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+uint8_t emberAfFindClusterServerEndpointIndex(EndpointId endpoint, ClusterId clusterId)
+{
+    if (clusterId != ZCL_LEVEL_CONTROL_CLUSTER_ID || endpoint == 0 ||
+        endpoint > EMBER_AF_LEVEL_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT)
+    {
+        return 0xFF;
+    }
+    return static_cast<uint8_t>(endpoint - 1);
+}
+
+EmberAfStatus emberAfOnOffClusterSetValueCallback(EndpointId endpoint, uint8_t command, bool initiatedByLevelChange)
+{
+    uint8_t onOff = (command == ZCL_ON_COMMAND_ID);
+    return emberAfWriteServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &onOff,
+                                       ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+}
+
+void emberAfPluginLevelControlClusterServerPostInitCallback(EndpointId endpoint) {}
+
+bool emberAfIsDeviceIdentifying(EndpointId endpoint)
+{
+    return false;
+}
+
+bool emberAfPluginGroupsServerGroupNamesSupportedCallback(uint8_t endpoint)
+{
+    return false;
+}
+
+void emberAfPluginGroupsServerGetGroupNameCallback(uint8_t endpoint, uint16_t groupId, uint8_t * groupName) {}
+
+void emberAfPluginGroupsServerSetGroupNameCallback(uint8_t endpoint, uint16_t groupId, uint8_t * groupName) {}
@@ -0,0 +1,73 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Drives the data model's cluster handlers without the rest of the
+ *      application framework: the framework functions they call are
+ *      replaced by ones that record the response instead of sending it,
+ *      and server attributes live in a table of their own.  Every endpoint
+ *      up to EMBER_AF_LEVEL_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT is a level
+ *      control server.  emberAfProcessMessage answers read attributes
+ *      commands from the attribute table, so that batch messages can be
+ *      processed, and the messages sent are recorded as well.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <app/util/af.h>
+
+namespace chip {
+namespace Test {
+
+/**
+ * Makes the handlers see a unicast command to @p endpoint, of the cluster
+ * @p clusterId, as the one being processed, and clears the recorded response.
+ */
+void SetCurrentCommand(EndpointId endpoint, ClusterId clusterId = 0);
+
+/// The ZCL frame of the last response a handler sent, or nullptr if it sent none.
+const uint8_t * GetResponse(uint16_t & length);
+
+/// The status of the last default response a handler sent.
+EmberAfStatus GetDefaultResponseStatus();
+
+/**
+ * Forgets every server attribute written through emberAfWriteServerAttribute.
+ * Until an attribute is written, reading it fails as unsupported.
+ */
+void ClearAttributes();
+
+/// The number of emberAfWriteServerAttribute calls since the attributes were cleared.
+uint32_t GetAttributeWriteCount();
+
+/// Forgets the messages sent so far.
+void ClearSentMessages();
+
+/// The number of messages sent on their own with chipSendUnicast.
+uint32_t GetUnicastCount();
+
+/// The number of batch messages sent with chipSendUnicastBatch.
+uint32_t GetBatchCount();
+
+/// The batch message sent @p index-th, or nullptr if fewer were recorded.
+uint8_t * GetBatch(uint32_t index, uint16_t & length);
+
+} // namespace Test
+} // namespace chip
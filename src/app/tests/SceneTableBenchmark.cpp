@@ -0,0 +1,193 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the scene table of the Scenes
+ *      server. It fills the table, spreading the scenes over a number of
+ *      groups of one endpoint, and reports the time each store, recall,
+ *      failed recall and Get Scene Membership command takes with the table
+ *      full.
+ *
+ *      Usage: SceneTableBenchmark [<commands per operation>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <app/clusters/scenes/scenes.h>
+#include <app/util/binding-table.h>
+#include <app/util/util.h>
+#include <support/CHIPMem.h>
+#include <system/SystemClock.h>
+
+#include "DataModelTestHelpers.h"
+
+using namespace chip;
+
+namespace {
+
+constexpr EndpointId kEndpoint      = 1;
+constexpr GroupId kFirstGroupId     = 0x0100;
+constexpr uint8_t kGroupCount       = 10;
+constexpr uint32_t kDefaultCommands = 100000;
+
+GroupId GetGroupId(uint32_t scene)
+{
+    return static_cast<GroupId>(kFirstGroupId + scene % kGroupCount);
+}
+
+uint8_t GetSceneId(uint32_t scene)
+{
+    return static_cast<uint8_t>(scene / kGroupCount);
+}
+
+uint64_t GetTimeUs()
+{
+    return System::Platform::Layer::GetClock_MonotonicHiRes();
+}
+
+void Report(const char * operation, uint32_t commands, uint64_t elapsedUs)
+{
+    printf("%-22s %8" PRIu32 " commands %10" PRIu64 " us %8.1f ns/command\n", operation, commands, elapsedUs,
+           static_cast<double>(elapsedUs) * 1000 / commands);
+}
+
+bool Setup()
+{
+    EmberBindingTableEntry entry;
+    uint8_t level = 0;
+
+    // The endpoint is a member of the groups it has multicast bindings for.
+    memset(&entry, 0, sizeof(entry));
+    entry.type  = EMBER_MULTICAST_BINDING;
+    entry.local = kEndpoint;
+    for (uint8_t i = 0; i < kGroupCount; i++)
+    {
+        entry.groupId = static_cast<GroupId>(kFirstGroupId + i);
+        if (emberSetBinding(i, &entry) != EMBER_SUCCESS)
+        {
+            return false;
+        }
+    }
+
+    emberAfScenesClusterServerInitCallback(kEndpoint);
+    emberAfWriteServerAttribute(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, &level,
+                                ZCL_INT8U_ATTRIBUTE_TYPE);
+
+    for (uint32_t i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    {
+        if (emberAfScenesClusterStoreCurrentSceneCallback(kEndpoint, GetGroupId(i), GetSceneId(i)) != EMBER_ZCL_STATUS_SUCCESS)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int Run(uint32_t commands)
+{
+    uint64_t start;
+    uint32_t failures = 0;
+
+    if (!Setup())
+    {
+        fprintf(stderr, "Failed to fill the scene table\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%u scenes in %u groups\n", static_cast<unsigned>(EMBER_AF_PLUGIN_SCENES_TABLE_SIZE),
+           static_cast<unsigned>(kGroupCount));
+
+    start = GetTimeUs();
+    for (uint32_t i = 0; i < commands; i++)
+    {
+        uint32_t scene = i % EMBER_AF_PLUGIN_SCENES_TABLE_SIZE;
+        failures += emberAfScenesClusterStoreCurrentSceneCallback(kEndpoint, GetGroupId(scene), GetSceneId(scene)) !=
+            EMBER_ZCL_STATUS_SUCCESS;
+    }
+    Report("store scene", commands, GetTimeUs() - start);
+
+    start = GetTimeUs();
+    for (uint32_t i = 0; i < commands; i++)
+    {
+        uint32_t scene = i % EMBER_AF_PLUGIN_SCENES_TABLE_SIZE;
+        failures += emberAfScenesClusterRecallSavedSceneCallback(kEndpoint, GetGroupId(scene), GetSceneId(scene)) !=
+            EMBER_ZCL_STATUS_SUCCESS;
+    }
+    Report("recall scene", commands, GetTimeUs() - start);
+
+    // Scene ids past the last stored one hash into the same chains as the stored ones, but match no entry.
+    start = GetTimeUs();
+    for (uint32_t i = 0; i < commands; i++)
+    {
+        uint32_t scene = EMBER_AF_PLUGIN_SCENES_TABLE_SIZE + kGroupCount + i % kGroupCount;
+        failures += emberAfScenesClusterRecallSavedSceneCallback(kEndpoint, GetGroupId(scene), GetSceneId(scene)) !=
+            EMBER_ZCL_STATUS_NOT_FOUND;
+    }
+    Report("recall missing scene", commands, GetTimeUs() - start);
+
+    start = GetTimeUs();
+    for (uint32_t i = 0; i < commands; i++)
+    {
+        Test::SetCurrentCommand(kEndpoint);
+        emberAfScenesClusterGetSceneMembershipCallback(GetGroupId(i));
+    }
+    Report("get scene membership", commands, GetTimeUs() - start);
+
+    if (failures != 0)
+    {
+        fprintf(stderr, "%" PRIu32 " commands failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    uint32_t commands = kDefaultCommands;
+    int result;
+
+    if (argc > 1)
+    {
+        commands = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || commands == 0)
+    {
+        fprintf(stderr, "Usage: %s [<commands per operation>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize memory\n");
+        return EXIT_FAILURE;
+    }
+
+    result = Run(commands);
+
+    Platform::MemoryShutdown();
+
+    return result;
+}
@@ -0,0 +1,267 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the batch messages of the ZCL
+ *      codec: reads and writes for several clusters and endpoints encoded
+ *      into one batch and decoded back record by record, batch responses,
+ *      full batches and malformed batches.
+ *
+ */
+
+#include "TestDataModel.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <app/chip-zcl-zpro-codec-api.h>
+#include <app/chip-zcl-zpro-codec.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+constexpr uint16_t kOnOffClusterId        = 0x0006;
+constexpr uint16_t kLevelControlClusterId = 0x0008;
+constexpr uint8_t kReadAttributesId       = 0x00;
+constexpr uint8_t kWriteAttributesId      = 0x02;
+
+const uint16_t sOnOffAttributes[] = { 0x0000 };
+const uint16_t sLevelAttributes[] = { 0x0000, 0x0001, 0x0010 };
+
+constexpr uint16_t kOnOffAttributeCount = ArraySize(sOnOffAttributes);
+constexpr uint16_t kLevelAttributeCount = ArraySize(sLevelAttributes);
+
+// Decodes the next record of a batch, and checks that it addresses the given cluster and endpoint and carries
+// the given ZCL message.
+void CheckNextRecord(nlTestSuite * inSuite, uint8_t * batch, uint16_t batchLength, uint16_t & offset, uint8_t endpoint,
+                     uint16_t clusterId, const uint8_t * expected, uint16_t expectedLength)
+{
+    EmberApsFrame frame;
+    uint8_t * message      = nullptr;
+    uint16_t messageLength = extractBatchMessage(batch, batchLength, &offset, &frame, &message);
+
+    NL_TEST_ASSERT(inSuite, messageLength == expectedLength);
+    NL_TEST_ASSERT(inSuite, frame.clusterId == clusterId);
+    NL_TEST_ASSERT(inSuite, frame.destinationEndpoint == endpoint);
+    NL_TEST_ASSERT(inSuite, message != nullptr && memcmp(message, expected, expectedLength) == 0);
+}
+
+void CheckReadWriteRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t batch[256];
+    uint8_t single[64];
+    uint8_t * expected;
+    uint16_t expectedLength;
+    uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint16_t length = encodeBatchHeader(batch, sizeof(batch));
+
+    NL_TEST_ASSERT(inSuite, length == CHIP_ZCL_BATCH_HEADER_LENGTH);
+    NL_TEST_ASSERT(inSuite, isBatchMessage(batch, length));
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(batch, length) == 0);
+
+    length = encodeBatchReadAttributesCommand(batch, sizeof(batch), length, 1, kOnOffClusterId, sOnOffAttributes,
+                                              kOnOffAttributeCount);
+    NL_TEST_ASSERT(inSuite, length != 0);
+    length = encodeBatchReadAttributesCommand(batch, sizeof(batch), length, 2, kLevelControlClusterId, sLevelAttributes,
+                                              kLevelAttributeCount);
+    NL_TEST_ASSERT(inSuite, length != 0);
+    length = encodeBatchWriteAttributeCommand(batch, sizeof(batch), length, 2, kLevelControlClusterId, 0x0010, 0x21, 0x1234);
+    NL_TEST_ASSERT(inSuite, length != 0);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(batch, length) == 3);
+
+    // Each record carries what the single-command encoder would have sent on its own.
+    expectedLength = extractMessage(single, encodeOnOffClusterReadOnOffAttribute(single, sizeof(single), 1), &expected);
+    NL_TEST_ASSERT(inSuite, expectedLength > 0 && expected[2] == kReadAttributesId);
+    CheckNextRecord(inSuite, batch, length, offset, 1, kOnOffClusterId, expected, expectedLength);
+
+    // Read Attributes: ZCL header, then the attribute IDs.
+    const uint8_t read[] = { 0x00, 0x01, kReadAttributesId, 0x00, 0x00, 0x01, 0x00, 0x10, 0x00 };
+    CheckNextRecord(inSuite, batch, length, offset, 2, kLevelControlClusterId, read, sizeof(read));
+
+    // Write Attributes of an uint16 (0x21) attribute: ZCL header, attribute ID, type, value.
+    const uint8_t write[] = { 0x00, 0x01, kWriteAttributesId, 0x10, 0x00, 0x21, 0x34, 0x12 };
+    CheckNextRecord(inSuite, batch, length, offset, 2, kLevelControlClusterId, write, sizeof(write));
+
+    NL_TEST_ASSERT(inSuite, offset == length);
+}
+
+void CheckResponseRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t batch[128];
+    uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint16_t length = encodeBatchHeader(batch, sizeof(batch));
+    EmberApsFrame frame;
+    EmberApsFrame decoded;
+    uint8_t * message;
+
+    // Read Attributes Response: attribute 0x0000 is a boolean (0x10) set to 1, attribute 0x0001 is unsupported (0x86).
+    const uint8_t readResponse[] = { 0x08, 0x01, 0x01, 0x00, 0x00, 0x00, 0x10, 0x01, 0x01, 0x00, 0x86 };
+    // Write Attributes Response: all writes succeeded.
+    const uint8_t writeResponse[] = { 0x08, 0x01, 0x04, 0x00 };
+
+    memset(&frame, 0, sizeof(frame));
+    frame.profileId           = 0x0104;
+    frame.clusterId           = kOnOffClusterId;
+    frame.sourceEndpoint      = 3;
+    frame.destinationEndpoint = 1;
+    frame.sequence            = 7;
+    length                    = encodeBatchMessage(batch, sizeof(batch), length, &frame, readResponse, sizeof(readResponse));
+    NL_TEST_ASSERT(inSuite, length != 0);
+
+    frame.clusterId      = kLevelControlClusterId;
+    frame.sourceEndpoint = 4;
+    length               = encodeBatchMessage(batch, sizeof(batch), length, &frame, writeResponse, sizeof(writeResponse));
+    NL_TEST_ASSERT(inSuite, length != 0);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(batch, length) == 2);
+
+    NL_TEST_ASSERT(inSuite, extractBatchMessage(batch, length, &offset, &decoded, &message) == sizeof(readResponse));
+    NL_TEST_ASSERT(inSuite, decoded.profileId == 0x0104 && decoded.clusterId == kOnOffClusterId);
+    NL_TEST_ASSERT(inSuite, decoded.sourceEndpoint == 3 && decoded.destinationEndpoint == 1 && decoded.sequence == 7);
+    NL_TEST_ASSERT(inSuite, memcmp(message, readResponse, sizeof(readResponse)) == 0);
+
+    NL_TEST_ASSERT(inSuite, extractBatchMessage(batch, length, &offset, &decoded, &message) == sizeof(writeResponse));
+    NL_TEST_ASSERT(inSuite, decoded.clusterId == kLevelControlClusterId && decoded.sourceEndpoint == 4);
+    NL_TEST_ASSERT(inSuite, memcmp(message, writeResponse, sizeof(writeResponse)) == 0);
+
+    NL_TEST_ASSERT(inSuite, offset == length);
+    NL_TEST_ASSERT(inSuite, extractBatchMessage(batch, length, &offset, &decoded, &message) == 0);
+}
+
+void CheckFullBatch(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t batch[64];
+    uint8_t copy[sizeof(batch)];
+    uint16_t length = encodeBatchHeader(batch, sizeof(batch));
+    uint16_t next;
+    uint16_t records = 0;
+
+    while ((next = encodeBatchReadAttributesCommand(batch, sizeof(batch), length, 1, kLevelControlClusterId, sLevelAttributes,
+                                                    kLevelAttributeCount)) != 0)
+    {
+        length = next;
+        records++;
+    }
+    NL_TEST_ASSERT(inSuite, records > 0 && extractBatchRecordCount(batch, length) == records);
+
+    // A command that does not fit leaves the batch as it was, ready to be sent.
+    memcpy(copy, batch, sizeof(batch));
+    NL_TEST_ASSERT(inSuite,
+                   encodeBatchWriteAttributeCommand(batch, sizeof(batch), length, 1, kOnOffClusterId, 0x4000, 0xF0, 0) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(copy, batch, length) == 0);
+
+    // So does a write of an attribute type the encoder does not support.
+    length = encodeBatchHeader(batch, sizeof(batch));
+    NL_TEST_ASSERT(inSuite,
+                   encodeBatchWriteAttributeCommand(batch, sizeof(batch), length, 1, kOnOffClusterId, 0x4000, 0x42, 0) == 0);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(batch, length) == 0);
+}
+
+void CheckRecordLimit(nlTestSuite * inSuite, void * inContext)
+{
+    static uint8_t batch[8192];
+    const uint8_t response[] = { 0x08, 0x01, 0x04, 0x00 };
+    uint16_t length          = encodeBatchHeader(batch, sizeof(batch));
+    EmberApsFrame frame;
+
+    memset(&frame, 0, sizeof(frame));
+    for (unsigned i = 0; i < CHIP_ZCL_BATCH_MAX_RECORDS; i++)
+    {
+        length = encodeBatchMessage(batch, sizeof(batch), length, &frame, response, sizeof(response));
+    }
+    NL_TEST_ASSERT(inSuite, length != 0 && extractBatchRecordCount(batch, length) == CHIP_ZCL_BATCH_MAX_RECORDS);
+
+    // The record count is one byte, so the next record goes into the next batch however much room is left.
+    NL_TEST_ASSERT(inSuite, encodeBatchMessage(batch, sizeof(batch), length, &frame, response, sizeof(response)) == 0);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(batch, length) == CHIP_ZCL_BATCH_MAX_RECORDS);
+}
+
+void CheckMalformedBatch(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t batch[128];
+    uint16_t length = encodeBatchHeader(batch, sizeof(batch));
+    uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint16_t first;
+    EmberApsFrame frame;
+    uint8_t * message;
+
+    length = encodeBatchReadAttributesCommand(batch, sizeof(batch), length, 1, kOnOffClusterId, sOnOffAttributes,
+                                              kOnOffAttributeCount);
+    first  = length;
+    length = encodeBatchReadAttributesCommand(batch, sizeof(batch), length, 1, kOnOffClusterId, sOnOffAttributes,
+                                              kOnOffAttributeCount);
+    NL_TEST_ASSERT(inSuite, length != 0);
+
+    // A truncated last record cannot be delimited, and leaves the offset where it was.
+    NL_TEST_ASSERT(inSuite, extractBatchMessage(batch, static_cast<uint16_t>(length - 1), &offset, &frame, &message) != 0);
+    NL_TEST_ASSERT(inSuite, offset == first);
+    NL_TEST_ASSERT(inSuite, extractBatchMessage(batch, static_cast<uint16_t>(length - 1), &offset, &frame, &message) == 0);
+    NL_TEST_ASSERT(inSuite, offset == first);
+
+    // A record too short for its APS frame is skipped over.
+    offset                                  = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    batch[CHIP_ZCL_BATCH_HEADER_LENGTH]     = 4;
+    batch[CHIP_ZCL_BATCH_HEADER_LENGTH + 1] = 0;
+    NL_TEST_ASSERT(inSuite, extractBatchMessage(batch, length, &offset, &frame, &message) == 0);
+    NL_TEST_ASSERT(inSuite, offset == CHIP_ZCL_BATCH_HEADER_LENGTH + CHIP_ZCL_BATCH_RECORD_OVERHEAD + 4);
+
+    // A regular message is not a batch.
+    length = encodeOnOffClusterReadOnOffAttribute(batch, sizeof(batch), 1);
+    NL_TEST_ASSERT(inSuite, length != 0 && !isBatchMessage(batch, length));
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(batch, length) == 0);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Read/Write Round Trip", CheckReadWriteRoundTrip),
+    NL_TEST_DEF("Response Round Trip",   CheckResponseRoundTrip),
+    NL_TEST_DEF("Full Batch",            CheckFullBatch),
+    NL_TEST_DEF("Record Limit",          CheckRecordLimit),
+    NL_TEST_DEF("Malformed Batch",       CheckMalformedBatch),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestBatchCodec(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DataModel-BatchCodec",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBatchCodec)
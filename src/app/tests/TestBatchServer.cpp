@@ -0,0 +1,311 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the processing of batch messages
+ *      by the server: responses collected into one batch, responses split
+ *      over several batches, responses too large for any batch, and
+ *      records that are not read/write attributes commands.
+ *
+ */
+
+#include "DataModelTestHelpers.h"
+#include "TestDataModel.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <app/chip-zcl-zpro-codec.h>
+#include <app/util/util.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr ChipNodeId kSourceNodeId = 0x1234;
+
+const AttributeId sOnOff[]        = { ZCL_ON_OFF_ATTRIBUTE_ID };
+const AttributeId sCurrentLevel[] = { ZCL_CURRENT_LEVEL_ATTRIBUTE_ID };
+
+// A Read Attributes Response for one uint8_t attribute: the ZCL header, the
+// attribute id, the status, the type and the value.
+constexpr uint16_t kReadResponseLength = EMBER_AF_ZCL_OVERHEAD + 5;
+constexpr uint16_t kStatusOffset       = EMBER_AF_ZCL_OVERHEAD + 2;
+constexpr uint16_t kValueOffset        = EMBER_AF_ZCL_OVERHEAD + 4;
+
+// A Default Response: the ZCL header, the command it answers and the status.
+constexpr uint16_t kDefaultResponseLength = EMBER_AF_ZCL_OVERHEAD + 2;
+
+void Init()
+{
+    Test::ClearAttributes();
+    Test::ClearSentMessages();
+}
+
+void WriteAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attribute, uint8_t value)
+{
+    emberAfWriteServerAttribute(endpoint, cluster, attribute, &value, ZCL_INT8U_ATTRIBUTE_TYPE);
+}
+
+uint16_t AddLevelRead(uint8_t * batch, uint16_t batchSize, uint16_t batchLength, EndpointId endpoint)
+{
+    return encodeBatchReadAttributesCommand(batch, batchSize, batchLength, endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, sCurrentLevel,
+                                            ArraySize(sCurrentLevel));
+}
+
+// Decodes the next record of a batch response, and returns the length of its
+// ZCL message after checking that it comes from the given endpoint and cluster.
+uint16_t NextResponse(nlTestSuite * inSuite, uint8_t * batch, uint16_t batchLength, uint16_t & offset, EndpointId endpoint,
+                      ClusterId cluster, uint8_t *& message)
+{
+    EmberApsFrame frame;
+    uint16_t messageLength = extractBatchMessage(batch, batchLength, &offset, &frame, &message);
+
+    NL_TEST_ASSERT(inSuite, messageLength != 0);
+    NL_TEST_ASSERT(inSuite, frame.clusterId == cluster);
+    NL_TEST_ASSERT(inSuite, frame.sourceEndpoint == endpoint);
+    return messageLength;
+}
+
+// Checks that the next record of a batch response reports the given value
+// for the single attribute it answers.
+void CheckReadResponse(nlTestSuite * inSuite, uint8_t * batch, uint16_t batchLength, uint16_t & offset, EndpointId endpoint,
+                       ClusterId cluster, uint8_t value)
+{
+    uint8_t * message      = nullptr;
+    uint16_t messageLength = NextResponse(inSuite, batch, batchLength, offset, endpoint, cluster, message);
+
+    NL_TEST_ASSERT(inSuite, messageLength == kReadResponseLength);
+    if (messageLength == kReadResponseLength)
+    {
+        NL_TEST_ASSERT(inSuite, message[EMBER_AF_ZCL_OVERHEAD - 1] == ZCL_READ_ATTRIBUTES_RESPONSE_COMMAND_ID);
+        NL_TEST_ASSERT(inSuite, message[kStatusOffset] == EMBER_ZCL_STATUS_SUCCESS);
+        NL_TEST_ASSERT(inSuite, message[kValueOffset] == value);
+    }
+}
+
+void CheckBatchResponse(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t request[128];
+    uint8_t * response;
+    uint16_t responseLength;
+    uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint16_t length = encodeBatchHeader(request, sizeof(request));
+
+    Init();
+    WriteAttribute(1, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, 1);
+    WriteAttribute(2, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, 0x42);
+
+    length =
+        encodeBatchReadAttributesCommand(request, sizeof(request), length, 1, ZCL_ON_OFF_CLUSTER_ID, sOnOff, ArraySize(sOnOff));
+    length = AddLevelRead(request, sizeof(request), length, 2);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(request, length) == 2);
+
+    // Both responses go back in one batch, and nothing is sent on its own.
+    NL_TEST_ASSERT(inSuite, emberAfProcessBatchMessage(request, length, kSourceNodeId));
+    NL_TEST_ASSERT(inSuite, !emAfBatchResponseActive());
+    NL_TEST_ASSERT(inSuite, Test::GetBatchCount() == 1);
+    NL_TEST_ASSERT(inSuite, Test::GetUnicastCount() == 0);
+
+    response = Test::GetBatch(0, responseLength);
+    NL_TEST_ASSERT(inSuite, response != nullptr && extractBatchRecordCount(response, responseLength) == 2);
+    if (response != nullptr)
+    {
+        CheckReadResponse(inSuite, response, responseLength, offset, 1, ZCL_ON_OFF_CLUSTER_ID, 1);
+        CheckReadResponse(inSuite, response, responseLength, offset, 2, ZCL_LEVEL_CONTROL_CLUSTER_ID, 0x42);
+        NL_TEST_ASSERT(inSuite, offset == responseLength);
+    }
+}
+
+void CheckSplitResponse(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr EndpointId kEndpointCount = 5;
+
+    uint8_t request[256];
+    uint16_t length     = encodeBatchHeader(request, sizeof(request));
+    EndpointId endpoint = 1;
+
+    Init();
+    for (EndpointId i = 1; i <= kEndpointCount; i++)
+    {
+        WriteAttribute(i, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, static_cast<uint8_t>(i * 10));
+        length = AddLevelRead(request, sizeof(request), length, i);
+    }
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(request, length) == kEndpointCount);
+
+    // Two responses fill the response buffer, so the last batch carries one.
+    NL_TEST_ASSERT(inSuite, emberAfProcessBatchMessage(request, length, kSourceNodeId));
+    NL_TEST_ASSERT(inSuite, Test::GetBatchCount() == 3);
+    NL_TEST_ASSERT(inSuite, Test::GetUnicastCount() == 0);
+
+    for (uint32_t batch = 0; batch < Test::GetBatchCount(); batch++)
+    {
+        uint16_t responseLength;
+        uint8_t * response = Test::GetBatch(batch, responseLength);
+        uint16_t offset    = CHIP_ZCL_BATCH_HEADER_LENGTH;
+
+        NL_TEST_ASSERT(inSuite, response != nullptr && responseLength <= EMBER_AF_BATCH_RESPONSE_BUFFER_LEN);
+        while (response != nullptr && offset < responseLength && endpoint <= kEndpointCount)
+        {
+            CheckReadResponse(inSuite, response, responseLength, offset, endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID,
+                              static_cast<uint8_t>(endpoint * 10));
+            endpoint++;
+        }
+    }
+    NL_TEST_ASSERT(inSuite, endpoint == kEndpointCount + 1);
+}
+
+void CheckOversizedResponse(nlTestSuite * inSuite, void * inContext)
+{
+    // The response to a read of this many unsupported attributes takes three
+    // bytes per attribute, more than a batch response can hold.
+    AttributeId attributes[EMBER_AF_BATCH_RESPONSE_BUFFER_LEN / 3];
+
+    uint8_t request[256];
+    uint8_t * response;
+    uint8_t * message = nullptr;
+    uint16_t responseLength;
+    uint16_t messageLength;
+    uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint16_t length = encodeBatchHeader(request, sizeof(request));
+
+    Init();
+    WriteAttribute(2, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, 0x42);
+    for (uint16_t i = 0; i < ArraySize(attributes); i++)
+    {
+        attributes[i] = static_cast<AttributeId>(0x4000 + i);
+    }
+
+    length = encodeBatchReadAttributesCommand(request, sizeof(request), length, 1, ZCL_LEVEL_CONTROL_CLUSTER_ID, attributes,
+                                              ArraySize(attributes));
+    length = AddLevelRead(request, sizeof(request), length, 2);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(request, length) == 2);
+
+    // The oversized response becomes a batched Default Response instead of a message of its own.
+    NL_TEST_ASSERT(inSuite, emberAfProcessBatchMessage(request, length, kSourceNodeId));
+    NL_TEST_ASSERT(inSuite, Test::GetBatchCount() == 1);
+    NL_TEST_ASSERT(inSuite, Test::GetUnicastCount() == 0);
+
+    response = Test::GetBatch(0, responseLength);
+    NL_TEST_ASSERT(inSuite, response != nullptr);
+    if (response != nullptr)
+    {
+        messageLength = NextResponse(inSuite, response, responseLength, offset, 1, ZCL_LEVEL_CONTROL_CLUSTER_ID, message);
+        NL_TEST_ASSERT(inSuite, messageLength == kDefaultResponseLength);
+        if (messageLength == kDefaultResponseLength)
+        {
+            NL_TEST_ASSERT(inSuite, message[EMBER_AF_ZCL_OVERHEAD - 1] == ZCL_DEFAULT_RESPONSE_COMMAND_ID);
+            NL_TEST_ASSERT(inSuite, message[EMBER_AF_ZCL_OVERHEAD] == ZCL_READ_ATTRIBUTES_COMMAND_ID);
+            NL_TEST_ASSERT(inSuite, message[EMBER_AF_ZCL_OVERHEAD + 1] == EMBER_ZCL_STATUS_INSUFFICIENT_SPACE);
+        }
+
+        CheckReadResponse(inSuite, response, responseLength, offset, 2, ZCL_LEVEL_CONTROL_CLUSTER_ID, 0x42);
+        NL_TEST_ASSERT(inSuite, offset == responseLength);
+    }
+}
+
+void CheckUnbatchableRecords(nlTestSuite * inSuite, void * inContext)
+{
+    // An Off command: a cluster-specific command, which batches do not carry.
+    uint8_t off[]             = { ZCL_CLUSTER_SPECIFIC_COMMAND, 1, ZCL_OFF_COMMAND_ID };
+    EmberApsFrame frame       = {};
+    frame.clusterId           = ZCL_ON_OFF_CLUSTER_ID;
+    frame.destinationEndpoint = 1;
+
+    uint8_t request[128];
+    uint8_t * response;
+    uint16_t responseLength;
+    uint16_t offset = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    uint16_t length = encodeBatchHeader(request, sizeof(request));
+
+    Init();
+    WriteAttribute(2, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, 0x42);
+
+    length = encodeBatchMessage(request, sizeof(request), length, &frame, off, sizeof(off));
+    length = AddLevelRead(request, sizeof(request), length, 2);
+    NL_TEST_ASSERT(inSuite, extractBatchRecordCount(request, length) == 2);
+
+    // A record longer than the rest of the message ends the batch.
+    request[length]     = 0xFF;
+    request[length + 1] = 0x00;
+    length              = static_cast<uint16_t>(length + 2);
+
+    NL_TEST_ASSERT(inSuite, emberAfProcessBatchMessage(request, length, kSourceNodeId));
+    NL_TEST_ASSERT(inSuite, Test::GetBatchCount() == 1);
+    NL_TEST_ASSERT(inSuite, Test::GetUnicastCount() == 0);
+
+    response = Test::GetBatch(0, responseLength);
+    NL_TEST_ASSERT(inSuite, response != nullptr && extractBatchRecordCount(response, responseLength) == 1);
+    if (response != nullptr)
+    {
+        CheckReadResponse(inSuite, response, responseLength, offset, 2, ZCL_LEVEL_CONTROL_CLUSTER_ID, 0x42);
+        NL_TEST_ASSERT(inSuite, offset == responseLength);
+    }
+
+    // A batch with only records that are dropped is not answered at all, and
+    // a message that is not a batch is left to the regular processing.
+    Test::ClearSentMessages();
+    length = encodeBatchHeader(request, sizeof(request));
+    length = encodeBatchMessage(request, sizeof(request), length, &frame, off, sizeof(off));
+    NL_TEST_ASSERT(inSuite, !emberAfProcessBatchMessage(request, length, kSourceNodeId));
+
+    request[0] = 0;
+    NL_TEST_ASSERT(inSuite, !emberAfProcessBatchMessage(request, length, kSourceNodeId));
+    NL_TEST_ASSERT(inSuite, Test::GetBatchCount() == 0);
+    NL_TEST_ASSERT(inSuite, Test::GetUnicastCount() == 0);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Batch Response",      CheckBatchResponse),
+    NL_TEST_DEF("Split Response",      CheckSplitResponse),
+    NL_TEST_DEF("Oversized Response",  CheckOversizedResponse),
+    NL_TEST_DEF("Unbatchable Records", CheckUnbatchableRecords),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestBatchServer(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DataModel-BatchServer",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBatchServer)
@@ -0,0 +1,277 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the indexes of the binding
+ *      table: lookups of keys whose hash chains collide, removal of entries
+ *      from their chains, and a full table of thousands of entries.
+ *
+ */
+
+#include "TestDataModel.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <app/util/binding-table.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+static_assert(EMBER_BINDING_TABLE_SIZE > UINT8_MAX, "The test table must not fit uint8_t indexes");
+
+namespace {
+
+constexpr CHIPEndpointId kEndpoint = 1;
+
+// Cluster IDs that differ by the bucket count, and group and node IDs that differ by 0x10, share a hash chain.
+constexpr CHIPClusterId kOnOffClusterId   = 0x0006;
+constexpr CHIPClusterId kCollidingCluster = kOnOffClusterId + EMBER_BINDING_TABLE_BUCKET_COUNT;
+constexpr CHIPGroupId kGroupId            = 0x0001;
+constexpr CHIPGroupId kCollidingGroupId   = 0x0011;
+constexpr ChipNodeId kNodeId              = 0x0001;
+constexpr ChipNodeId kCollidingNodeId     = 0x0011;
+
+void ClearTable()
+{
+    for (uint16_t i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    {
+        emberDeleteBinding(i);
+    }
+}
+
+void SetUnicast(nlTestSuite * inSuite, uint16_t index, CHIPClusterId clusterId, ChipNodeId nodeId)
+{
+    EmberBindingTableEntry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.type      = EMBER_UNICAST_BINDING;
+    entry.local     = kEndpoint;
+    entry.clusterId = clusterId;
+    entry.nodeId    = nodeId;
+    NL_TEST_ASSERT(inSuite, emberSetBinding(index, &entry) == EMBER_SUCCESS);
+}
+
+void SetMulticast(nlTestSuite * inSuite, uint16_t index, CHIPClusterId clusterId, CHIPGroupId groupId)
+{
+    EmberBindingTableEntry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.type      = EMBER_MULTICAST_BINDING;
+    entry.local     = kEndpoint;
+    entry.clusterId = clusterId;
+    entry.groupId   = groupId;
+    NL_TEST_ASSERT(inSuite, emberSetBinding(index, &entry) == EMBER_SUCCESS);
+}
+
+// Returns the indexes an iterator yields as a bit per index, checking that none is yielded twice.
+uint32_t CollectIndexes(nlTestSuite * inSuite, EmberBindingTableIterator & iterator)
+{
+    EmberBindingTableEntry entry;
+    uint32_t found = 0;
+    uint16_t index;
+
+    while (emberBindingTableIteratorNext(&iterator, &index, &entry))
+    {
+        NL_TEST_ASSERT(inSuite, index < 32 && (found & (1u << index)) == 0);
+        found |= 1u << index;
+    }
+
+    return found;
+}
+
+uint32_t ClusterIndexes(nlTestSuite * inSuite, CHIPClusterId clusterId)
+{
+    EmberBindingTableIterator iterator;
+
+    emberBindingTableIterateCluster(&iterator, kEndpoint, clusterId);
+    return CollectIndexes(inSuite, iterator);
+}
+
+uint32_t NodeIndexes(nlTestSuite * inSuite, ChipNodeId nodeId)
+{
+    EmberBindingTableIterator iterator;
+
+    emberBindingTableIterateNode(&iterator, nodeId);
+    return CollectIndexes(inSuite, iterator);
+}
+
+uint32_t GroupIndexes(nlTestSuite * inSuite, CHIPGroupId groupId)
+{
+    EmberBindingTableIterator iterator;
+
+    emberBindingTableIterateGroup(&iterator, groupId);
+    return CollectIndexes(inSuite, iterator);
+}
+
+void CheckCollisions(nlTestSuite * inSuite, void * inContext)
+{
+    ClearTable();
+
+    // Node 1 and group 1 share a chain of the destination index as well.
+    SetUnicast(inSuite, 0, kOnOffClusterId, kNodeId);
+    SetUnicast(inSuite, 1, kCollidingCluster, kCollidingNodeId);
+    SetMulticast(inSuite, 2, kOnOffClusterId, kGroupId);
+    SetMulticast(inSuite, 3, kCollidingCluster, kCollidingGroupId);
+    SetUnicast(inSuite, 4, kOnOffClusterId, kCollidingNodeId);
+
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kOnOffClusterId) == ((1u << 0) | (1u << 2) | (1u << 4)));
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster) == ((1u << 1) | (1u << 3)));
+    NL_TEST_ASSERT(inSuite, NodeIndexes(inSuite, kNodeId) == (1u << 0));
+    NL_TEST_ASSERT(inSuite, NodeIndexes(inSuite, kCollidingNodeId) == ((1u << 1) | (1u << 4)));
+    NL_TEST_ASSERT(inSuite, GroupIndexes(inSuite, kGroupId) == (1u << 2));
+    NL_TEST_ASSERT(inSuite, GroupIndexes(inSuite, kCollidingGroupId) == (1u << 3));
+
+    // Keys without bindings, in the same chains.
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster + EMBER_BINDING_TABLE_BUCKET_COUNT) == 0);
+    NL_TEST_ASSERT(inSuite, NodeIndexes(inSuite, 0x0021) == 0);
+    NL_TEST_ASSERT(inSuite, GroupIndexes(inSuite, 0x0021) == 0);
+
+    ClearTable();
+}
+
+void CheckRemoval(nlTestSuite * inSuite, void * inContext)
+{
+    EmberBindingTableIterator iterator;
+    EmberBindingTableEntry entry;
+    uint16_t index;
+
+    ClearTable();
+
+    for (uint16_t i = 0; i < 6; i++)
+    {
+        SetUnicast(inSuite, i, (i % 2 == 0) ? kOnOffClusterId : kCollidingCluster, (i % 2 == 0) ? kNodeId : kCollidingNodeId);
+    }
+
+    // The entry last returned can be deleted without disturbing the iteration.
+    emberBindingTableIterateCluster(&iterator, kEndpoint, kOnOffClusterId);
+    while (emberBindingTableIteratorNext(&iterator, &index, &entry))
+    {
+        if (index != 2)
+        {
+            NL_TEST_ASSERT(inSuite, emberDeleteBinding(index) == EMBER_SUCCESS);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kOnOffClusterId) == (1u << 2));
+    NL_TEST_ASSERT(inSuite, NodeIndexes(inSuite, kNodeId) == (1u << 2));
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster) == ((1u << 1) | (1u << 3) | (1u << 5)));
+
+    // Removing the head, the middle and the tail of a chain.
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(3) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster) == ((1u << 1) | (1u << 5)));
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(5) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(1) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster) == 0);
+    NL_TEST_ASSERT(inSuite, NodeIndexes(inSuite, kCollidingNodeId) == 0);
+
+    // Deleting an unused entry changes nothing.
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(1) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kOnOffClusterId) == (1u << 2));
+
+    // Overwriting an entry moves it to the chains of its new keys.
+    SetMulticast(inSuite, 2, kCollidingCluster, kGroupId);
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kOnOffClusterId) == 0);
+    NL_TEST_ASSERT(inSuite, NodeIndexes(inSuite, kNodeId) == 0);
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster) == (1u << 2));
+    NL_TEST_ASSERT(inSuite, GroupIndexes(inSuite, kGroupId) == (1u << 2));
+
+    ClearTable();
+    NL_TEST_ASSERT(inSuite, ClusterIndexes(inSuite, kCollidingCluster) == 0);
+    NL_TEST_ASSERT(inSuite, GroupIndexes(inSuite, kGroupId) == 0);
+}
+
+void CheckFullTable(nlTestSuite * inSuite, void * inContext)
+{
+    EmberBindingTableIterator iterator;
+    EmberBindingTableEntry entry;
+    uint16_t index;
+    uint16_t count    = 0;
+    uint32_t indexSum = 0;
+
+    memset(&entry, 0, sizeof(entry));
+    ClearTable();
+    NL_TEST_ASSERT(inSuite, emberBindingTableFindUnusedIndex() == 0);
+
+    for (uint16_t i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    {
+        SetUnicast(inSuite, i, kOnOffClusterId, 0x1000 + i);
+    }
+    NL_TEST_ASSERT(inSuite, emberBindingTableFindUnusedIndex() == EMBER_NULL_BINDING);
+    NL_TEST_ASSERT(inSuite, emberSetBinding(EMBER_BINDING_TABLE_SIZE, &entry) == EMBER_BAD_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(EMBER_BINDING_TABLE_SIZE) == EMBER_BAD_ARGUMENT);
+
+    // Every entry is found once, including those past index 255.
+    emberBindingTableIterateCluster(&iterator, kEndpoint, kOnOffClusterId);
+    while (emberBindingTableIteratorNext(&iterator, &index, &entry))
+    {
+        NL_TEST_ASSERT(inSuite, entry.nodeId == 0x1000u + index);
+        indexSum += index;
+        count++;
+    }
+    NL_TEST_ASSERT(inSuite, count == EMBER_BINDING_TABLE_SIZE);
+    NL_TEST_ASSERT(inSuite, indexSum == EMBER_BINDING_TABLE_SIZE * (EMBER_BINDING_TABLE_SIZE - 1) / 2);
+
+    emberBindingTableIterateNode(&iterator, 0x1000 + EMBER_BINDING_TABLE_SIZE - 1);
+    NL_TEST_ASSERT(inSuite, emberBindingTableIteratorNext(&iterator, &index, &entry));
+    NL_TEST_ASSERT(inSuite, index == EMBER_BINDING_TABLE_SIZE - 1);
+    NL_TEST_ASSERT(inSuite, !emberBindingTableIteratorNext(&iterator, &index, &entry));
+
+    // A deleted entry past index 255 is the one to reuse.
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(EMBER_BINDING_TABLE_SIZE - 2) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberBindingTableFindUnusedIndex() == EMBER_BINDING_TABLE_SIZE - 2);
+    emberBindingTableIterateNode(&iterator, 0x1000 + EMBER_BINDING_TABLE_SIZE - 2);
+    NL_TEST_ASSERT(inSuite, !emberBindingTableIteratorNext(&iterator, &index, &entry));
+
+    ClearTable();
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Colliding Keys", CheckCollisions),
+    NL_TEST_DEF("Removal",        CheckRemoval),
+    NL_TEST_DEF("Full Table",     CheckFullTable),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestBindingTable(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DataModel-BindingTable",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBindingTable)
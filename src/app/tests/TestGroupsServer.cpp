@@ -0,0 +1,189 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the Get Group Membership command
+ *      of the Groups server: responses listing more groups than a uint8_t
+ *      length can count, which are capped to what fits in the response.
+ *
+ */
+
+#include "DataModelTestHelpers.h"
+#include "TestDataModel.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <app/util/binding-table.h>
+#include <app/util/util.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr EndpointId kEndpoint      = 1;
+constexpr EndpointId kOtherEndpoint = 2;
+constexpr GroupId kFirstGroupId     = 0x0100;
+constexpr uint16_t kGroupCount      = 300;
+
+// The response holds the ZCL header, the capacity and count fields and two bytes per group.
+constexpr uint16_t kResponseHeaderLength = EMBER_AF_ZCL_OVERHEAD + 2;
+constexpr uint16_t kGroupsInPayload      = ((EMBER_AF_RESPONSE_BUFFER_LEN) - kResponseHeaderLength) / 2;
+constexpr uint16_t kMaxListedGroups      = kGroupsInPayload < UINT8_MAX ? kGroupsInPayload : UINT8_MAX;
+
+static_assert(kGroupCount > 128 && kGroupCount <= EMBER_BINDING_TABLE_SIZE, "The groups must overflow a uint8_t list length");
+
+void ClearTable()
+{
+    for (uint16_t i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    {
+        emberDeleteBinding(i);
+    }
+}
+
+void AddGroups(nlTestSuite * inSuite, EndpointId endpoint, uint16_t first, uint16_t count)
+{
+    EmberBindingTableEntry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.type  = EMBER_MULTICAST_BINDING;
+    entry.local = endpoint;
+    for (uint16_t i = first; i < first + count; i++)
+    {
+        entry.groupId = static_cast<GroupId>(kFirstGroupId + i);
+        NL_TEST_ASSERT(inSuite, emberSetBinding(i, &entry) == EMBER_SUCCESS);
+    }
+}
+
+// Checks the response lists count groups in table order from the given one, and returns the count.
+uint8_t CheckResponse(nlTestSuite * inSuite, GroupId firstGroupId)
+{
+    uint16_t length;
+    const uint8_t * response = Test::GetResponse(length);
+
+    NL_TEST_ASSERT(inSuite, response != nullptr);
+    if (response == nullptr || length < kResponseHeaderLength)
+    {
+        return 0;
+    }
+
+    uint8_t count = response[kResponseHeaderLength - 1];
+    NL_TEST_ASSERT(inSuite, response[2] == ZCL_GET_GROUP_MEMBERSHIP_RESPONSE_COMMAND_ID);
+    NL_TEST_ASSERT(inSuite, response[kResponseHeaderLength - 2] == 0xFF);
+    NL_TEST_ASSERT(inSuite, length == kResponseHeaderLength + 2 * count);
+    for (uint16_t i = 0; i < count && kResponseHeaderLength + 2 * i + 1 < length; i++)
+    {
+        NL_TEST_ASSERT(inSuite, emberAfGetInt16u(response, static_cast<uint16_t>(kResponseHeaderLength + 2 * i), length) ==
+                           firstGroupId + i);
+    }
+
+    return count;
+}
+
+void CheckAllGroups(nlTestSuite * inSuite, void * inContext)
+{
+    ClearTable();
+    AddGroups(inSuite, kOtherEndpoint, 0, 10);
+    AddGroups(inSuite, kEndpoint, 10, kGroupCount);
+
+    // Group Count 0 asks for every group of the endpoint.
+    Test::SetCurrentCommand(kEndpoint);
+    NL_TEST_ASSERT(inSuite, emberAfGroupsClusterGetGroupMembershipCallback(0, nullptr));
+    NL_TEST_ASSERT(inSuite, CheckResponse(inSuite, kFirstGroupId + 10) == kMaxListedGroups);
+
+    // An endpoint in no group gets an empty list.
+    Test::SetCurrentCommand(3);
+    NL_TEST_ASSERT(inSuite, emberAfGroupsClusterGetGroupMembershipCallback(0, nullptr));
+    NL_TEST_ASSERT(inSuite, CheckResponse(inSuite, kFirstGroupId) == 0);
+
+    ClearTable();
+}
+
+void CheckRequestedGroups(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t groupList[2 * UINT8_MAX];
+
+    ClearTable();
+    AddGroups(inSuite, kEndpoint, 0, kGroupCount);
+
+    // Every requested group matches, more than fit in the response.
+    for (uint16_t i = 0; i < UINT8_MAX; i++)
+    {
+        groupList[2 * i]     = LOW_BYTE(kFirstGroupId + i);
+        groupList[2 * i + 1] = HIGH_BYTE(kFirstGroupId + i);
+    }
+    Test::SetCurrentCommand(kEndpoint);
+    NL_TEST_ASSERT(inSuite, emberAfGroupsClusterGetGroupMembershipCallback(UINT8_MAX, groupList));
+    NL_TEST_ASSERT(inSuite, CheckResponse(inSuite, kFirstGroupId) == kMaxListedGroups);
+
+    // Only the groups the endpoint is in are listed.
+    groupList[0] = LOW_BYTE(kFirstGroupId + kGroupCount);
+    groupList[1] = HIGH_BYTE(kFirstGroupId + kGroupCount);
+    groupList[2] = LOW_BYTE(kFirstGroupId + kGroupCount - 2);
+    groupList[3] = HIGH_BYTE(kFirstGroupId + kGroupCount - 2);
+    groupList[4] = LOW_BYTE(kFirstGroupId + kGroupCount - 1);
+    groupList[5] = HIGH_BYTE(kFirstGroupId + kGroupCount - 1);
+    Test::SetCurrentCommand(kEndpoint);
+    NL_TEST_ASSERT(inSuite, emberAfGroupsClusterGetGroupMembershipCallback(3, groupList));
+    NL_TEST_ASSERT(inSuite, CheckResponse(inSuite, kFirstGroupId + kGroupCount - 2) == 2);
+
+    // No match is answered with a default response.
+    Test::SetCurrentCommand(kEndpoint);
+    NL_TEST_ASSERT(inSuite, emberAfGroupsClusterGetGroupMembershipCallback(1, groupList));
+    NL_TEST_ASSERT(inSuite, Test::GetDefaultResponseStatus() == EMBER_ZCL_STATUS_NOT_FOUND);
+
+    ClearTable();
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("All Groups",       CheckAllGroups),
+    NL_TEST_DEF("Requested Groups", CheckRequestedGroups),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestGroupsServer(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DataModel-GroupsServer",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestGroupsServer)
@@ -0,0 +1,288 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the scene table index of the
+ *      Scenes server: scenes sharing a hash chain, the membership lists of
+ *      groups sharing a bucket, and a table filled to capacity.
+ *
+ */
+
+#include "DataModelTestHelpers.h"
+#include "TestDataModel.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <app/clusters/scenes/scenes.h>
+#include <app/util/binding-table.h>
+#include <app/util/util.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 1;
+constexpr GroupId kGroupId     = 0x0100;
+
+// Scene ids and group ids that differ by the bucket count share a bucket of the index.
+constexpr uint8_t kBucketCount  = 16;
+constexpr GroupId kOtherGroupId = kGroupId + kBucketCount;
+
+// The responses start with the status, after the ZCL header.
+constexpr uint16_t kStatusOffset     = EMBER_AF_ZCL_OVERHEAD;
+constexpr uint16_t kSceneCountOffset = EMBER_AF_ZCL_OVERHEAD + 4;
+
+void Init(nlTestSuite * inSuite)
+{
+    EmberBindingTableEntry entry;
+
+    for (uint16_t i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    {
+        emberDeleteBinding(i);
+    }
+
+    // The endpoint is a member of the groups it has multicast bindings for.
+    memset(&entry, 0, sizeof(entry));
+    entry.type    = EMBER_MULTICAST_BINDING;
+    entry.local   = kEndpoint;
+    entry.groupId = kGroupId;
+    NL_TEST_ASSERT(inSuite, emberSetBinding(0, &entry) == EMBER_SUCCESS);
+    entry.groupId = kOtherGroupId;
+    NL_TEST_ASSERT(inSuite, emberSetBinding(1, &entry) == EMBER_SUCCESS);
+
+    Test::ClearAttributes();
+    emberAfScenesClusterServerInitCallback(kEndpoint);
+}
+
+void SetLevel(uint8_t level)
+{
+    emberAfWriteServerAttribute(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, &level,
+                                ZCL_INT8U_ATTRIBUTE_TYPE);
+}
+
+uint8_t GetLevel()
+{
+    uint8_t level = 0;
+    emberAfReadServerAttribute(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, &level, sizeof(level));
+    return level;
+}
+
+uint8_t GetSceneCount()
+{
+    uint8_t count = 0;
+    emberAfReadServerAttribute(kEndpoint, ZCL_SCENES_CLUSTER_ID, ZCL_SCENE_COUNT_ATTRIBUTE_ID, &count, sizeof(count));
+    return count;
+}
+
+uint8_t GetResponseStatus()
+{
+    uint16_t length;
+    const uint8_t * response = Test::GetResponse(length);
+
+    return (response != nullptr && length > kStatusOffset) ? response[kStatusOffset] : EMBER_ZCL_STATUS_FAILURE;
+}
+
+uint8_t StoreScene(GroupId groupId, uint8_t sceneId, uint8_t level)
+{
+    SetLevel(level);
+    Test::SetCurrentCommand(kEndpoint);
+    emberAfScenesClusterStoreSceneCallback(groupId, sceneId);
+    return GetResponseStatus();
+}
+
+EmberAfStatus RecallScene(GroupId groupId, uint8_t sceneId)
+{
+    Test::SetCurrentCommand(kEndpoint);
+    emberAfScenesClusterRecallSceneCallback(groupId, sceneId, 0);
+    return Test::GetDefaultResponseStatus();
+}
+
+uint8_t RemoveScene(GroupId groupId, uint8_t sceneId)
+{
+    Test::SetCurrentCommand(kEndpoint);
+    emberAfScenesClusterRemoveSceneCallback(groupId, sceneId);
+    return GetResponseStatus();
+}
+
+// Checks the Get Scene Membership response for the group lists exactly the given scenes, in any order.
+void CheckMembership(nlTestSuite * inSuite, GroupId groupId, const uint8_t * sceneIds, uint8_t sceneCount)
+{
+    uint16_t length;
+    const uint8_t * response;
+
+    Test::SetCurrentCommand(kEndpoint);
+    emberAfScenesClusterGetSceneMembershipCallback(groupId);
+    response = Test::GetResponse(length);
+
+    NL_TEST_ASSERT(inSuite, response != nullptr && length == kSceneCountOffset + 1 + sceneCount);
+    if (response == nullptr || length != kSceneCountOffset + 1 + sceneCount)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, response[kStatusOffset] == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfGetInt16u(response, kStatusOffset + 2, length) == groupId);
+    NL_TEST_ASSERT(inSuite, response[kSceneCountOffset] == sceneCount);
+    for (uint8_t i = 0; i < sceneCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, memchr(&response[kSceneCountOffset + 1], sceneIds[i], sceneCount) != nullptr);
+    }
+}
+
+void CheckSceneChain(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t sceneIds[] = { 3, 3 + kBucketCount, 3 + 2 * kBucketCount };
+
+    Init(inSuite);
+
+    // Each scene of the chain keeps its own level.
+    for (uint8_t i = 0; i < sizeof(sceneIds); i++)
+    {
+        NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, sceneIds[i], static_cast<uint8_t>(10 + i)) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+    NL_TEST_ASSERT(inSuite, GetSceneCount() == sizeof(sceneIds));
+    for (uint8_t i = 0; i < sizeof(sceneIds); i++)
+    {
+        NL_TEST_ASSERT(inSuite, RecallScene(kGroupId, sceneIds[i]) == EMBER_ZCL_STATUS_SUCCESS);
+        NL_TEST_ASSERT(inSuite, GetLevel() == 10 + i);
+    }
+
+    // Storing a scene again updates it in place.
+    NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, sceneIds[0], 20) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, GetSceneCount() == sizeof(sceneIds));
+
+    // Removing the middle of the chain leaves the scenes around it.
+    NL_TEST_ASSERT(inSuite, RemoveScene(kGroupId, sceneIds[1]) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, RemoveScene(kGroupId, sceneIds[1]) == EMBER_ZCL_STATUS_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, RecallScene(kGroupId, sceneIds[1]) == EMBER_ZCL_STATUS_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, RecallScene(kGroupId, sceneIds[0]) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, GetLevel() == 20);
+    NL_TEST_ASSERT(inSuite, RecallScene(kGroupId, sceneIds[2]) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, GetLevel() == 12);
+    NL_TEST_ASSERT(inSuite, GetSceneCount() == sizeof(sceneIds) - 1);
+
+    // The same scene id in a group sharing the bucket is a different scene.
+    NL_TEST_ASSERT(inSuite, RecallScene(kOtherGroupId, sceneIds[0]) == EMBER_ZCL_STATUS_NOT_FOUND);
+}
+
+void CheckGroupMembership(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t sceneIds[]      = { 1, 2, 1 + kBucketCount };
+    const uint8_t otherSceneIds[] = { 1, 5 };
+
+    Init(inSuite);
+
+    for (uint8_t i = 0; i < sizeof(sceneIds); i++)
+    {
+        NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, sceneIds[i], i) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+    for (uint8_t i = 0; i < sizeof(otherSceneIds); i++)
+    {
+        NL_TEST_ASSERT(inSuite, StoreScene(kOtherGroupId, otherSceneIds[i], i) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+
+    // Each group lists only its own scenes, though both share a membership list.
+    CheckMembership(inSuite, kGroupId, sceneIds, sizeof(sceneIds));
+    CheckMembership(inSuite, kOtherGroupId, otherSceneIds, sizeof(otherSceneIds));
+
+    // Remove All Scenes only removes the scenes of its group.
+    Test::SetCurrentCommand(kEndpoint);
+    emberAfScenesClusterRemoveAllScenesCallback(kOtherGroupId);
+    NL_TEST_ASSERT(inSuite, GetResponseStatus() == EMBER_ZCL_STATUS_SUCCESS);
+    CheckMembership(inSuite, kOtherGroupId, nullptr, 0);
+    CheckMembership(inSuite, kGroupId, sceneIds, sizeof(sceneIds));
+    NL_TEST_ASSERT(inSuite, GetSceneCount() == sizeof(sceneIds));
+
+    // So does removing a group.
+    NL_TEST_ASSERT(inSuite, StoreScene(kOtherGroupId, otherSceneIds[0], 0) == EMBER_ZCL_STATUS_SUCCESS);
+    emberAfScenesClusterRemoveScenesInGroupCallback(kEndpoint, kGroupId);
+    CheckMembership(inSuite, kGroupId, nullptr, 0);
+    CheckMembership(inSuite, kOtherGroupId, otherSceneIds, 1);
+    NL_TEST_ASSERT(inSuite, GetSceneCount() == 1);
+    NL_TEST_ASSERT(inSuite, RecallScene(kOtherGroupId, otherSceneIds[0]) == EMBER_ZCL_STATUS_SUCCESS);
+}
+
+void CheckFullTable(nlTestSuite * inSuite, void * inContext)
+{
+    Init(inSuite);
+
+    for (uint16_t i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    {
+        GroupId groupId = (i & 1) ? kOtherGroupId : kGroupId;
+        NL_TEST_ASSERT(inSuite, StoreScene(groupId, static_cast<uint8_t>(i), static_cast<uint8_t>(i)) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+    NL_TEST_ASSERT(inSuite, GetSceneCount() == EMBER_AF_PLUGIN_SCENES_TABLE_SIZE);
+
+    // A full table refuses new scenes, but still updates existing ones.
+    NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, 1, 0) == EMBER_ZCL_STATUS_INSUFFICIENT_SPACE);
+    NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, 0, 0) == EMBER_ZCL_STATUS_SUCCESS);
+
+    // A removed scene frees its slot for the next one.
+    NL_TEST_ASSERT(inSuite, RemoveScene(kGroupId, 100) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, 1, 0xAA) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, StoreScene(kGroupId, 3, 0) == EMBER_ZCL_STATUS_INSUFFICIENT_SPACE);
+
+    for (uint16_t i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i += 25)
+    {
+        GroupId groupId = (i & 1) ? kOtherGroupId : kGroupId;
+        EmberAfStatus expected = (i == 100) ? EMBER_ZCL_STATUS_NOT_FOUND : EMBER_ZCL_STATUS_SUCCESS;
+        NL_TEST_ASSERT(inSuite, RecallScene(groupId, static_cast<uint8_t>(i)) == expected);
+    }
+    NL_TEST_ASSERT(inSuite, RecallScene(kGroupId, 1) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, GetLevel() == 0xAA);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Scene Chain",      CheckSceneChain),
+    NL_TEST_DEF("Group Membership", CheckGroupMembership),
+    NL_TEST_DEF("Full Table",       CheckFullTable),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestScenes(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DataModel-Scenes",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestScenes)
@@ -0,0 +1,288 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the shared transition tick
+ *      scheduler: fixed-point interpolation, scheduling and cancelling ticks,
+ *      and level control transitions driven by it, including transitions
+ *      without duration, which complete before the command returns.
+ *
+ */
+
+#include "DataModelTestHelpers.h"
+#include "TestDataModel.h"
+
+#include <stdint.h>
+
+#include <app/util/af-transition.h>
+#include <app/util/af.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 1;
+
+uint8_t sTickCounts[2];
+uint8_t sRescheduleCount;
+
+void CountingTick(EndpointId endpoint)
+{
+    sTickCounts[endpoint - 1]++;
+}
+
+void ReschedulingTick(EndpointId endpoint)
+{
+    sTickCounts[endpoint - 1]++;
+    if (sRescheduleCount > 0)
+    {
+        sRescheduleCount--;
+        emberAfTransitionSchedule(endpoint, ReschedulingTick);
+    }
+}
+
+uint8_t GetLevel()
+{
+    uint8_t level = 0;
+    emberAfReadServerAttribute(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, &level, sizeof(level));
+    return level;
+}
+
+void SetLevel(uint8_t level)
+{
+    Test::ClearAttributes();
+    emberAfWriteServerAttribute(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, &level,
+                                ZCL_INT8U_ATTRIBUTE_TYPE);
+}
+
+bool IsTransitioning()
+{
+    return emberAfTransitionIsScheduled(kEndpoint, emberAfLevelControlClusterServerTickCallback);
+}
+
+void CheckInterpolate(nlTestSuite * inSuite, void * inContext)
+{
+    // The ends of the transition.
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(10, 200, 0, 1000) == 10);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(10, 200, 1000, 1000) == 200);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(10, 200, 5000, 1000) == 200);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(10, 200, 0, 0) == 200);
+
+    // Values in between are rounded to the nearest, in either direction.
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(0, 255, 500, 1000) == 128);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(255, 0, 500, 1000) == 127);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(0, 2, 200, 1000) == 0);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(0, 2, 300, 1000) == 1);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(100, 100, 300, 1000) == 100);
+
+    // The full 16-bit range over the longest transition time does not overflow.
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(0, UINT16_MAX, 0xFFFEu * 100, 0xFFFFu * 100) == 0xFFFE);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionInterpolate(UINT16_MAX, 0, 1, 3) == 0xAAAA);
+
+    // Every step of a transition moves the same way.
+    for (uint32_t elapsed = 100, previous = 1000; elapsed <= 6000; elapsed += 100)
+    {
+        uint16_t value = emberAfTransitionInterpolate(1000, 40000, elapsed, 6000);
+        NL_TEST_ASSERT(inSuite, value > previous);
+        previous = value;
+    }
+}
+
+void CheckSchedule(nlTestSuite * inSuite, void * inContext)
+{
+    sTickCounts[0] = sTickCounts[1] = 0;
+
+    // Scheduling a tick twice runs it once.
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(1, CountingTick) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(1, CountingTick) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(2, CountingTick) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionIsScheduled(1, CountingTick));
+    NL_TEST_ASSERT(inSuite, !emberAfTransitionIsScheduled(1, ReschedulingTick));
+    NL_TEST_ASSERT(inSuite, sTickCounts[0] == 0);
+
+    emAfTransitionTick();
+    NL_TEST_ASSERT(inSuite, sTickCounts[0] == 1 && sTickCounts[1] == 1);
+    NL_TEST_ASSERT(inSuite, !emberAfTransitionIsScheduled(1, CountingTick));
+
+    // A tick that is not scheduled again does not run again.
+    emAfTransitionTick();
+    NL_TEST_ASSERT(inSuite, sTickCounts[0] == 1 && sTickCounts[1] == 1);
+
+    // A tick that schedules itself runs once per transition tick.
+    sRescheduleCount = 3;
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(1, ReschedulingTick) == EMBER_SUCCESS);
+    for (uint8_t i = 1; i <= 5; i++)
+    {
+        emAfTransitionTick();
+        NL_TEST_ASSERT(inSuite, sTickCounts[0] == 1 + (i < 4 ? i : 4));
+    }
+    NL_TEST_ASSERT(inSuite, !emberAfTransitionIsScheduled(1, ReschedulingTick));
+
+    // A cancelled tick does not run.
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(2, CountingTick) == EMBER_SUCCESS);
+    emberAfTransitionCancel(2, CountingTick);
+    NL_TEST_ASSERT(inSuite, !emberAfTransitionIsScheduled(2, CountingTick));
+    emAfTransitionTick();
+    NL_TEST_ASSERT(inSuite, sTickCounts[1] == 1);
+}
+
+void CheckTableFull(nlTestSuite * inSuite, void * inContext)
+{
+    static const EmberAfTickFunction ticks[] = { CountingTick, ReschedulingTick };
+    uint16_t scheduled                       = 0;
+
+    sTickCounts[0] = sTickCounts[1] = 0;
+
+    // The table is filled with distinct (endpoint, tick function) pairs.
+    for (uint16_t i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        if (emberAfTransitionSchedule(static_cast<EndpointId>(i / 2 + 1), ticks[i % 2]) == EMBER_SUCCESS)
+        {
+            scheduled++;
+        }
+    }
+    NL_TEST_ASSERT(inSuite, scheduled == EMBER_AF_TRANSITION_TABLE_SIZE);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(kEndpoint, emberAfLevelControlClusterServerTickCallback) == EMBER_TABLE_FULL);
+
+    // Rescheduling a tick already in the table still succeeds, and a completed
+    // tick frees its slot.
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(1, CountingTick) == EMBER_SUCCESS);
+    emberAfTransitionCancel(1, CountingTick);
+    NL_TEST_ASSERT(inSuite, emberAfTransitionSchedule(kEndpoint, emberAfLevelControlClusterServerTickCallback) == EMBER_SUCCESS);
+    emberAfTransitionCancel(kEndpoint, emberAfLevelControlClusterServerTickCallback);
+
+    // Cancelled ticks free their slots without running.
+    for (uint16_t i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        emberAfTransitionCancel(static_cast<EndpointId>(i / 2 + 1), ticks[i % 2]);
+    }
+    emAfTransitionTick();
+    NL_TEST_ASSERT(inSuite, sTickCounts[0] == 0 && sTickCounts[1] == 0);
+}
+
+void CheckLevelTransition(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t writes;
+
+    SetLevel(0);
+
+    // Move from 0 to 200 over one second.
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterMoveToLevelCallback(200, 10, 0, 0);
+    NL_TEST_ASSERT(inSuite, Test::GetDefaultResponseStatus() == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, IsTransitioning());
+    NL_TEST_ASSERT(inSuite, GetLevel() == 0);
+
+    for (uint32_t elapsed = EMBER_AF_TRANSITION_TICK_MS; elapsed <= 1000; elapsed += EMBER_AF_TRANSITION_TICK_MS)
+    {
+        emAfTransitionTick();
+        NL_TEST_ASSERT(inSuite, GetLevel() == emberAfTransitionInterpolate(0, 200, elapsed, 1000));
+    }
+    NL_TEST_ASSERT(inSuite, GetLevel() == 200);
+    NL_TEST_ASSERT(inSuite, !IsTransitioning());
+
+    // A slow transition writes nothing on the ticks that leave the level unchanged.
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterMoveToLevelCallback(202, 10, 0, 0);
+    writes = Test::GetAttributeWriteCount();
+    emAfTransitionTick();
+    NL_TEST_ASSERT(inSuite, GetLevel() == 200);
+    NL_TEST_ASSERT(inSuite, Test::GetAttributeWriteCount() == writes);
+    while (IsTransitioning())
+    {
+        emAfTransitionTick();
+    }
+    NL_TEST_ASSERT(inSuite, GetLevel() == 202);
+
+    // A new command replaces the transition in progress.
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterMoveToLevelCallback(100, 20, 0, 0);
+    emAfTransitionTick();
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterStopCallback(0, 0);
+    NL_TEST_ASSERT(inSuite, !IsTransitioning());
+    NL_TEST_ASSERT(inSuite, GetLevel() == emberAfTransitionInterpolate(202, 100, EMBER_AF_TRANSITION_TICK_MS, 2000));
+}
+
+void CheckZeroTimeTransition(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t onOff = 1;
+
+    SetLevel(10);
+
+    // A transition time of 0 sets the level before the command returns.
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterMoveToLevelCallback(150, 0, 0, 0);
+    NL_TEST_ASSERT(inSuite, Test::GetDefaultResponseStatus() == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, GetLevel() == 150);
+    NL_TEST_ASSERT(inSuite, !IsTransitioning());
+
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterStepCallback(EMBER_ZCL_STEP_MODE_DOWN, 50, 0, 0, 0);
+    NL_TEST_ASSERT(inSuite, GetLevel() == 100);
+    NL_TEST_ASSERT(inSuite, !IsTransitioning());
+
+    // So does moving to the minimum level with On/Off, which also turns the light off.
+    Test::SetCurrentCommand(kEndpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+    emberAfLevelControlClusterMoveToLevelWithOnOffCallback(0, 0);
+    NL_TEST_ASSERT(inSuite, GetLevel() == 0);
+    NL_TEST_ASSERT(inSuite, !IsTransitioning());
+    emberAfReadServerAttribute(kEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &onOff, sizeof(onOff));
+    NL_TEST_ASSERT(inSuite, onOff == 0);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Interpolate",          CheckInterpolate),
+    NL_TEST_DEF("Schedule",             CheckSchedule),
+    NL_TEST_DEF("Table Full",           CheckTableFull),
+    NL_TEST_DEF("Level Transition",     CheckLevelTransition),
+    NL_TEST_DEF("Zero Time Transition", CheckZeroTimeTransition),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestTransition(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DataModel-Transition",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestTransition)
@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the shared transition tick
+ *      scheduler. It runs a given number of concurrent transitions: a Move To
+ *      Level on every level control endpoint, and past those, 16-bit color
+ *      temperature transitions ticked the way the color control server ticks
+ *      them. It reports the time each transition tick takes and the attribute
+ *      writes it makes.
+ *
+ *      Usage: TransitionBenchmark [<transitions> [<transition time in tenths of a second>]]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app/util/af-transition.h>
+#include <app/util/af.h>
+#include <support/CHIPMem.h>
+#include <system/SystemClock.h>
+
+#include "DataModelTestHelpers.h"
+
+using namespace chip;
+
+namespace {
+
+constexpr uint32_t kDefaultTransitions        = 500;
+constexpr uint16_t kDefaultTransitionTimeDs   = 10;
+constexpr uint32_t kRounds                    = 20;
+constexpr uint32_t kLevelTransitions          = EMBER_AF_LEVEL_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT;
+constexpr uint32_t kMaxTransitions            = EMBER_AF_TRANSITION_TABLE_SIZE;
+constexpr uint32_t kMaxTemperatureTransitions = kMaxTransitions - kLevelTransitions;
+
+static_assert(kMaxTemperatureTransitions <= kLevelTransitions, "Temperature transitions share the level control endpoints");
+
+struct TemperatureTransition
+{
+    uint16_t from;
+    uint16_t to;
+    uint16_t current;
+    uint32_t elapsedMs;
+    uint32_t durationMs;
+};
+
+TemperatureTransition sTemperatureTransitions[kMaxTemperatureTransitions];
+
+uint64_t GetTimeUs()
+{
+    return System::Platform::Layer::GetClock_MonotonicHiRes();
+}
+
+void TemperatureTick(EndpointId endpoint)
+{
+    TemperatureTransition & transition = sTemperatureTransitions[endpoint - 1];
+    uint16_t value;
+
+    transition.elapsedMs += EMBER_AF_TRANSITION_TICK_MS;
+    value = emberAfTransitionInterpolate(transition.from, transition.to, transition.elapsedMs, transition.durationMs);
+    if (value != transition.current)
+    {
+        transition.current = value;
+        emberAfWriteServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
+                                    reinterpret_cast<uint8_t *>(&value), ZCL_INT16U_ATTRIBUTE_TYPE);
+    }
+    if (transition.elapsedMs < transition.durationMs)
+    {
+        emberAfTransitionSchedule(endpoint, TemperatureTick);
+    }
+}
+
+// Starts every transition of a round, each towards the opposite end of its range from the last round.
+bool StartTransitions(uint32_t transitions, uint16_t transitionTimeDs, uint32_t round)
+{
+    bool up = (round % 2 == 0);
+
+    for (uint32_t i = 0; i < transitions; i++)
+    {
+        EndpointId endpoint = static_cast<EndpointId>(i % kLevelTransitions + 1);
+
+        if (i < kLevelTransitions)
+        {
+            Test::SetCurrentCommand(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID);
+            emberAfLevelControlClusterMoveToLevelCallback(up ? 254 : 1, transitionTimeDs, 0, 0);
+            if (Test::GetDefaultResponseStatus() != EMBER_ZCL_STATUS_SUCCESS)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            TemperatureTransition & transition = sTemperatureTransitions[endpoint - 1];
+
+            transition.from       = up ? 153 : 500;
+            transition.to         = up ? 500 : 153;
+            transition.current    = transition.from;
+            transition.elapsedMs  = 0;
+            transition.durationMs = static_cast<uint32_t>(transitionTimeDs) * 100;
+            if (emberAfTransitionSchedule(endpoint, TemperatureTick) != EMBER_SUCCESS)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool AnyScheduled(uint32_t transitions)
+{
+    for (uint32_t i = 0; i < transitions; i++)
+    {
+        EndpointId endpoint = static_cast<EndpointId>(i % kLevelTransitions + 1);
+        if (emberAfTransitionIsScheduled(endpoint, i < kLevelTransitions ? emberAfLevelControlClusterServerTickCallback
+                                                                         : TemperatureTick))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int Run(uint32_t transitions, uint16_t transitionTimeDs)
+{
+    uint64_t totalUs = 0, maxUs = 0;
+    uint32_t ticks   = 0, writes;
+    uint8_t level    = 1;
+
+    for (EndpointId endpoint = 1; endpoint <= kLevelTransitions; endpoint++)
+    {
+        emberAfWriteServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, &level,
+                                    ZCL_INT8U_ATTRIBUTE_TYPE);
+    }
+
+    printf("%" PRIu32 " concurrent transitions (%" PRIu32 " level, %" PRIu32 " color temperature) over %u ms, %" PRIu32
+           " rounds\n",
+           transitions, transitions < kLevelTransitions ? transitions : kLevelTransitions,
+           transitions < kLevelTransitions ? 0 : transitions - kLevelTransitions, transitionTimeDs * 100u, kRounds);
+
+    writes = Test::GetAttributeWriteCount();
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        if (!StartTransitions(transitions, transitionTimeDs, round))
+        {
+            fprintf(stderr, "Failed to start the transitions\n");
+            return EXIT_FAILURE;
+        }
+
+        while (AnyScheduled(transitions))
+        {
+            uint64_t start = GetTimeUs();
+            emAfTransitionTick();
+            uint64_t elapsedUs = GetTimeUs() - start;
+
+            totalUs += elapsedUs;
+            maxUs = elapsedUs > maxUs ? elapsedUs : maxUs;
+            ticks++;
+        }
+    }
+    writes = Test::GetAttributeWriteCount() - writes;
+
+    printf("%" PRIu32 " ticks, %.1f us per tick (max %" PRIu64 " us), %.1f attribute writes per tick\n", ticks,
+           static_cast<double>(totalUs) / ticks, maxUs, static_cast<double>(writes) / ticks);
+    printf("tick time is %.2f%% of the %u ms tick interval\n",
+           static_cast<double>(totalUs) / ticks / (EMBER_AF_TRANSITION_TICK_MS * 10.0), EMBER_AF_TRANSITION_TICK_MS);
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    uint32_t transitions      = kDefaultTransitions;
+    uint32_t transitionTimeDs = kDefaultTransitionTimeDs;
+    int result;
+
+    if (argc > 1)
+    {
+        transitions = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        transitionTimeDs = static_cast<uint32_t>(strtoul(argv[2], nullptr, 10));
+    }
+
+    if (argc > 3 || transitions == 0 || transitions > kMaxTransitions || transitionTimeDs == 0 || transitionTimeDs >= 0xFFFF)
+    {
+        fprintf(stderr, "Usage: %s [<transitions> [<transition time in tenths of a second>]]\n", argv[0]);
+        fprintf(stderr, "At most %" PRIu32 " transitions, and a transition time from 1 to 65534.\n", kMaxTransitions);
+        return EXIT_FAILURE;
+    }
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize memory\n");
+        return EXIT_FAILURE;
+    }
+
+    result = Run(transitions, static_cast<uint16_t>(transitionTimeDs));
+
+    Platform::MemoryShutdown();
+
+    return result;
+}
@@ -0,0 +1,48 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      The application configuration the data model unit tests build the
+ *      cluster code with, in place of the one an application generates.
+ *      The binding table holds thousands of entries, far more than uint8_t
+ *      indexes can address, and the scene table is as large as uint8_t
+ *      indexes allow. Scenes store the current level of the Level Control
+ *      server, which runs on as many endpoints as a uint8_t index can count,
+ *      and the transition table has room for 500 concurrent transitions.
+ *      Batch responses are kept small, so that a few records fill one.
+ */
+
+#pragma once
+
+#define EMBER_BINDING_TABLE_SIZE 4000
+
+#define EMBER_AF_PLUGIN_GROUPS_SERVER
+
+#define EMBER_AF_PLUGIN_SCENES
+#define EMBER_AF_PLUGIN_SCENES_TABLE_SIZE 250
+
+#define ZCL_USING_LEVEL_CONTROL_CLUSTER_SERVER
+
+#define EMBER_AF_LEVEL_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT (250)
+#define EMBER_AF_PLUGIN_LEVEL_CONTROL_MAXIMUM_LEVEL 255
+#define EMBER_AF_PLUGIN_LEVEL_CONTROL_MINIMUM_LEVEL 0
+#define EMBER_AF_PLUGIN_LEVEL_CONTROL_RATE 0
+
+#define EMBER_AF_TRANSITION_TABLE_SIZE 500
+
+#define EMBER_AF_BATCH_RESPONSE_BUFFER_LEN 64
@@ -406,7 +406,7 @@ EmberStatus emberAfSendMulticast(EmberMulticastId multicastId, EmberApsFrame * a
 EmberStatus emberAfSendMulticastToBindings(EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message)
 {
     EmberStatus status = EMBER_INVALID_BINDING_INDEX;
-    uint8_t i;
+    uint16_t i;
     EmberBindingTableEntry binding;
     uint16_t groupDest;
 
@@ -481,7 +481,7 @@ EmberStatus emberAfSendUnicastWithCallback(EmberOutgoingMessageType type, uint64
         EmberBindingTableEntry binding;
         // TODO: This cast should go away once
         // https://github.com/project-chip/connectedhomeip/issues/3584 is fixed.
-        EmberStatus status = emberGetBinding(static_cast<uint8_t>(indexOrDestination), &binding);
+        EmberStatus status = emberGetBinding(static_cast<uint16_t>(indexOrDestination), &binding);
         if (status != EMBER_SUCCESS)
         {
             return status;
@@ -506,7 +506,7 @@ EmberStatus emberAfSendUnicastToBindingsWithCallback(EmberApsFrame * apsFrame, u
                                                      EmberAfMessageSentFunction callback)
 {
     EmberStatus status = EMBER_INVALID_BINDING_INDEX;
-    uint8_t i;
+    uint16_t i;
 
     for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
     {
@@ -682,7 +682,7 @@ EmberStatus emAfSend(EmberOutgoingMessageType type, uint64_t indexOrDestination,
         EmberBindingTableEntry binding;
         // TODO: This cast should go away once
         // https://github.com/project-chip/connectedhomeip/issues/3584 is fixed.
-        status = emberGetBinding(static_cast<uint8_t>(indexOrDestination), &binding);
+        status = emberGetBinding(static_cast<uint16_t>(indexOrDestination), &binding);
         if (status != EMBER_SUCCESS)
         {
             break;
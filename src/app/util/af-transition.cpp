@@ -0,0 +1,232 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   This file implements the shared tick scheduler for cluster transitions.
+ */
+
+#include "af-transition.h"
+
+#include "af.h"
+
+#ifdef EMBER_AF_PLUGIN_REPORTING
+#include <app/reporting/reporting.h>
+#endif
+
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemTimer.h>
+
+using namespace chip;
+
+// Maximum number of (endpoint, tick function) pairs that can be scheduled at
+// the same time.  By default there is a slot for every transition the
+// generated configuration can run at once, so scheduling never fails: one per
+// level control server endpoint, and one per kind of color transition
+// (hue/saturation, xy, temperature) per color control server endpoint.
+#ifndef EMBER_AF_TRANSITION_TABLE_SIZE
+#ifdef EMBER_AF_LEVEL_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT
+#define LEVEL_CONTROL_TRANSITION_COUNT EMBER_AF_LEVEL_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT
+#else
+#define LEVEL_CONTROL_TRANSITION_COUNT 0
+#endif
+#ifdef EMBER_AF_COLOR_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT
+#define COLOR_CONTROL_TRANSITION_COUNT (3 * EMBER_AF_COLOR_CONTROL_CLUSTER_SERVER_ENDPOINT_COUNT)
+#else
+#define COLOR_CONTROL_TRANSITION_COUNT 0
+#endif
+#define EMBER_AF_TRANSITION_TABLE_SIZE (LEVEL_CONTROL_TRANSITION_COUNT + COLOR_CONTROL_TRANSITION_COUNT)
+#endif
+
+#if EMBER_AF_TRANSITION_TABLE_SIZE == 0
+#error "Transitions are built without any level control or color control server endpoint"
+#endif
+
+typedef struct
+{
+    // NULL if the slot is unused.
+    EmberAfTickFunction tick;
+    EndpointId endpoint;
+    // Set when the tick should run at the next transition tick.
+    bool pending;
+    // Set for the slots that run during the current transition tick.
+    bool due;
+} TransitionSlot;
+
+static TransitionSlot transitionTable[EMBER_AF_TRANSITION_TABLE_SIZE];
+static bool timerRunning = false;
+
+static void transitionTimerHandler(System::Layer * systemLayer, void * appState, System::Error error);
+
+static TransitionSlot * findSlot(EndpointId endpoint, EmberAfTickFunction tick)
+{
+    uint16_t i;
+    for (i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        if (transitionTable[i].tick == tick && transitionTable[i].endpoint == endpoint)
+        {
+            return &transitionTable[i];
+        }
+    }
+    return NULL;
+}
+
+static TransitionSlot * findFreeSlot(void)
+{
+    uint16_t i;
+    for (i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        if (transitionTable[i].tick == NULL)
+        {
+            return &transitionTable[i];
+        }
+    }
+    return NULL;
+}
+
+static void startTimer(void)
+{
+    // If the timer cannot be started, the next emberAfTransitionSchedule tries again.
+    if (!timerRunning)
+    {
+        System::Error err = DeviceLayer::SystemLayer.StartTimer(EMBER_AF_TRANSITION_TICK_MS, transitionTimerHandler, NULL);
+        timerRunning      = (err == CHIP_SYSTEM_NO_ERROR);
+    }
+}
+
+static void transitionTimerHandler(System::Layer * systemLayer, void * appState, System::Error error)
+{
+    emAfTransitionTick();
+}
+
+void emAfTransitionTick(void)
+{
+    uint16_t i;
+    bool anyPending = false;
+
+    timerRunning = false;
+
+    // Only the ticks that were pending when the timer fired run now.  Ticks
+    // scheduled from within a tick function run at the next transition tick.
+    for (i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        transitionTable[i].due     = transitionTable[i].pending;
+        transitionTable[i].pending = false;
+    }
+
+#ifdef EMBER_AF_PLUGIN_REPORTING
+    // Every tick function may write several attributes.  Reschedule reporting
+    // once, after all of them have run.
+    emAfPluginReportingDeferTickScheduling();
+#endif
+
+    for (i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        TransitionSlot * slot = &transitionTable[i];
+        if (slot->tick != NULL && slot->due)
+        {
+            slot->due = false;
+            (*slot->tick)(slot->endpoint);
+        }
+    }
+
+#ifdef EMBER_AF_PLUGIN_REPORTING
+    emAfPluginReportingResumeTickScheduling();
+#endif
+
+    // Release the slots of the transitions that did not schedule themselves
+    // again, i.e. the ones that completed.
+    for (i = 0; i < EMBER_AF_TRANSITION_TABLE_SIZE; i++)
+    {
+        if (transitionTable[i].pending)
+        {
+            anyPending = true;
+        }
+        else
+        {
+            transitionTable[i].tick = NULL;
+        }
+    }
+
+    if (anyPending)
+    {
+        startTimer();
+    }
+}
+
+EmberStatus emberAfTransitionSchedule(EndpointId endpoint, EmberAfTickFunction tick)
+{
+    TransitionSlot * slot = findSlot(endpoint, tick);
+    if (slot == NULL)
+    {
+        slot = findFreeSlot();
+        if (slot == NULL)
+        {
+            return EMBER_TABLE_FULL;
+        }
+        slot->tick     = tick;
+        slot->endpoint = endpoint;
+        slot->due      = false;
+    }
+
+    slot->pending = true;
+    startTimer();
+    return EMBER_SUCCESS;
+}
+
+void emberAfTransitionCancel(EndpointId endpoint, EmberAfTickFunction tick)
+{
+    TransitionSlot * slot = findSlot(endpoint, tick);
+    if (slot != NULL)
+    {
+        slot->tick    = NULL;
+        slot->pending = false;
+        slot->due     = false;
+    }
+    // The shared timer is left running; it stops on its own at the next tick if
+    // nothing is pending anymore.
+}
+
+bool emberAfTransitionIsScheduled(EndpointId endpoint, EmberAfTickFunction tick)
+{
+    TransitionSlot * slot = findSlot(endpoint, tick);
+    return (slot != NULL && slot->pending);
+}
+
+uint16_t emberAfTransitionInterpolate(uint16_t from, uint16_t to, uint32_t elapsedMs, uint32_t durationMs)
+{
+    uint32_t fraction, distance;
+
+    if (elapsedMs >= durationMs)
+    {
+        return to;
+    }
+
+    // Fraction of the transition that has elapsed, in 16.16 fixed point and
+    // rounded so that 16-bit values land on the nearest integer.  It is at most
+    // 1.0, so the products below fit in 32 bits.
+    fraction = static_cast<uint32_t>(((static_cast<uint64_t>(elapsedMs) << 16) + durationMs / 2) / durationMs);
+
+    if (to >= from)
+    {
+        distance = (static_cast<uint32_t>(to - from) * fraction + 0x8000) >> 16;
+        return static_cast<uint16_t>(from + distance);
+    }
+
+    distance = (static_cast<uint32_t>(from - to) * fraction + 0x8000) >> 16;
+    return static_cast<uint16_t>(from - distance);
+}
@@ -0,0 +1,91 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file Shared tick scheduler for cluster transitions.
+ *
+ * Clusters that move an attribute over time (level control, color control)
+ * register a tick function per endpoint instead of arming their own event
+ * control.  All registered transitions are advanced from a single timer that
+ * fires every EMBER_AF_TRANSITION_TICK_MS, and reporting is rescheduled once
+ * per tick rather than once per attribute write.
+ */
+
+#ifndef AF_TRANSITION_H
+#define AF_TRANSITION_H
+
+#include <app/util/af-types.h>
+
+// Interval between two transition ticks.
+#ifndef EMBER_AF_TRANSITION_TICK_MS
+#define EMBER_AF_TRANSITION_TICK_MS 100
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**
+ * @brief Runs tick on the given endpoint at the next transition tick.
+ *
+ * Like an event control, a scheduled tick runs once; the tick function must
+ * schedule itself again to keep the transition going.  Scheduling a tick that
+ * is already scheduled has no effect.
+ *
+ * @return EMBER_SUCCESS, or EMBER_TABLE_FULL if
+ *         EMBER_AF_TRANSITION_TABLE_SIZE transitions are already scheduled.
+ *         The default table size has room for every transition the generated
+ *         configuration can run at once.
+ */
+EmberStatus emberAfTransitionSchedule(CHIPEndpointId endpoint, EmberAfTickFunction tick);
+
+/**
+ * @brief Cancels a tick scheduled with emberAfTransitionSchedule.
+ */
+void emberAfTransitionCancel(CHIPEndpointId endpoint, EmberAfTickFunction tick);
+
+/**
+ * @brief Returns true if tick is scheduled to run on the given endpoint.
+ */
+bool emberAfTransitionIsScheduled(CHIPEndpointId endpoint, EmberAfTickFunction tick);
+
+/**
+ * @brief Linear interpolation between two values in 16.16 fixed point.
+ *
+ * @param from Value at the start of the transition.
+ * @param to Value at the end of the transition.
+ * @param elapsedMs Time elapsed since the start of the transition.
+ * @param durationMs Total duration of the transition.
+ *
+ * @return The value at elapsedMs, rounded to the nearest integer.  Returns to
+ *         once elapsedMs reaches durationMs, or if durationMs is 0.
+ */
+uint16_t emberAfTransitionInterpolate(uint16_t from, uint16_t to, uint32_t elapsedMs, uint32_t durationMs);
+
+/**
+ * @brief Runs one transition tick: every scheduled tick function runs once.
+ *
+ * The transition timer calls this every EMBER_AF_TRANSITION_TICK_MS while
+ * ticks are scheduled.
+ */
+void emAfTransitionTick(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // AF_TRANSITION_H
@@ -22,9 +22,135 @@
 #include "binding-table.h"
 #include "gen/gen_config.h"
 
+static_assert(EMBER_BINDING_TABLE_SIZE < EMBER_NULL_BINDING, "Binding table indexes must fit in a uint16_t");
+static_assert((EMBER_BINDING_TABLE_BUCKET_COUNT & (EMBER_BINDING_TABLE_BUCKET_COUNT - 1)) == 0,
+              "EMBER_BINDING_TABLE_BUCKET_COUNT must be a power of two");
+
+enum
+{
+    ITERATE_CLUSTER,
+    ITERATE_DESTINATION,
+};
+
 static EmberBindingTableEntry bindingTable[EMBER_BINDING_TABLE_SIZE];
 
-extern "C" EmberStatus emberGetBinding(uint8_t index, EmberBindingTableEntry * result)
+// Hash chains of the (local endpoint, cluster id) index and of the destination
+// index.  Each bucket holds the index of the first entry of its chain, and
+// each entry the index of the next entry of the same chain.  Unused entries
+// are not linked into either index.
+static uint16_t clusterBuckets[EMBER_BINDING_TABLE_BUCKET_COUNT];
+static uint16_t clusterNext[EMBER_BINDING_TABLE_SIZE];
+static uint16_t destinationBuckets[EMBER_BINDING_TABLE_BUCKET_COUNT];
+static uint16_t destinationNext[EMBER_BINDING_TABLE_SIZE];
+static bool indexesInitialized = false;
+
+static EmberBindingTableChangedHandler changedHandler = NULL;
+
+static uint16_t clusterHash(CHIPEndpointId local, CHIPClusterId clusterId)
+{
+    return static_cast<uint16_t>((clusterId * 31u + local) & (EMBER_BINDING_TABLE_BUCKET_COUNT - 1));
+}
+
+static uint16_t nodeHash(ChipNodeId nodeId)
+{
+    uint32_t folded = static_cast<uint32_t>(nodeId ^ (nodeId >> 32));
+    return static_cast<uint16_t>((folded ^ (folded >> 16) ^ (folded >> 8)) & (EMBER_BINDING_TABLE_BUCKET_COUNT - 1));
+}
+
+static uint16_t groupHash(CHIPGroupId groupId)
+{
+    return static_cast<uint16_t>((groupId ^ (groupId >> 8)) & (EMBER_BINDING_TABLE_BUCKET_COUNT - 1));
+}
+
+static bool hasDestination(const EmberBindingTableEntry * entry)
+{
+    return entry->type == EMBER_UNICAST_BINDING || entry->type == EMBER_MULTICAST_BINDING;
+}
+
+static uint16_t destinationHash(const EmberBindingTableEntry * entry)
+{
+    return (entry->type == EMBER_MULTICAST_BINDING ? groupHash(entry->groupId) : nodeHash(entry->nodeId));
+}
+
+static void initIndexes(void)
+{
+    if (!indexesInitialized)
+    {
+        for (uint16_t bucket = 0; bucket < EMBER_BINDING_TABLE_BUCKET_COUNT; bucket++)
+        {
+            clusterBuckets[bucket]     = EMBER_NULL_BINDING;
+            destinationBuckets[bucket] = EMBER_NULL_BINDING;
+        }
+        indexesInitialized = true;
+    }
+}
+
+static void unlinkFromChain(uint16_t * head, uint16_t * next, uint16_t index)
+{
+    while (*head != EMBER_NULL_BINDING)
+    {
+        if (*head == index)
+        {
+            *head = next[index];
+            return;
+        }
+        head = &next[*head];
+    }
+}
+
+static void addToIndexes(uint16_t index)
+{
+    const EmberBindingTableEntry * entry = &bindingTable[index];
+    uint16_t bucket;
+
+    if (entry->type == EMBER_UNUSED_BINDING)
+    {
+        return;
+    }
+
+    bucket                 = clusterHash(entry->local, entry->clusterId);
+    clusterNext[index]     = clusterBuckets[bucket];
+    clusterBuckets[bucket] = index;
+
+    if (hasDestination(entry))
+    {
+        bucket                     = destinationHash(entry);
+        destinationNext[index]     = destinationBuckets[bucket];
+        destinationBuckets[bucket] = index;
+    }
+}
+
+static void removeFromIndexes(uint16_t index)
+{
+    const EmberBindingTableEntry * entry = &bindingTable[index];
+
+    if (entry->type == EMBER_UNUSED_BINDING)
+    {
+        return;
+    }
+
+    unlinkFromChain(&clusterBuckets[clusterHash(entry->local, entry->clusterId)], clusterNext, index);
+
+    if (hasDestination(entry))
+    {
+        unlinkFromChain(&destinationBuckets[destinationHash(entry)], destinationNext, index);
+    }
+}
+
+static bool iteratorMatches(const EmberBindingTableIterator * iterator, const EmberBindingTableEntry * entry)
+{
+    if (iterator->kind == ITERATE_CLUSTER)
+    {
+        return entry->local == iterator->local && entry->clusterId == iterator->clusterId;
+    }
+    if (entry->type != iterator->type)
+    {
+        return false;
+    }
+    return (entry->type == EMBER_MULTICAST_BINDING ? entry->groupId == iterator->groupId : entry->nodeId == iterator->nodeId);
+}
+
+extern "C" EmberStatus emberGetBinding(uint16_t index, EmberBindingTableEntry * result)
 {
     if (index >= EMBER_BINDING_TABLE_SIZE)
     {
@@ -35,24 +161,106 @@ extern "C" EmberStatus emberGetBinding(uint8_t index, EmberBindingTableEntry * r
     return EMBER_SUCCESS;
 }
 
-extern "C" EmberStatus emberSetBinding(uint8_t index, EmberBindingTableEntry * result)
+extern "C" EmberStatus emberSetBinding(uint16_t index, EmberBindingTableEntry * result)
 {
     if (index >= EMBER_BINDING_TABLE_SIZE)
     {
         return EMBER_BAD_ARGUMENT;
     }
 
+    initIndexes();
+    removeFromIndexes(index);
     bindingTable[index] = *result;
+    addToIndexes(index);
+
+    if (changedHandler != NULL)
+    {
+        changedHandler(index, &bindingTable[index]);
+    }
     return EMBER_SUCCESS;
 }
 
-extern "C" EmberStatus emberDeleteBinding(uint8_t index)
+extern "C" EmberStatus emberDeleteBinding(uint16_t index)
 {
     if (index >= EMBER_BINDING_TABLE_SIZE)
     {
         return EMBER_BAD_ARGUMENT;
     }
 
+    initIndexes();
+    removeFromIndexes(index);
     bindingTable[index].type = EMBER_UNUSED_BINDING;
+
+    if (changedHandler != NULL)
+    {
+        changedHandler(index, &bindingTable[index]);
+    }
     return EMBER_SUCCESS;
 }
+
+extern "C" void emberSetBindingTableChangedHandler(EmberBindingTableChangedHandler handler)
+{
+    changedHandler = handler;
+}
+
+extern "C" void emberBindingTableIterateCluster(EmberBindingTableIterator * iterator, CHIPEndpointId local,
+                                                CHIPClusterId clusterId)
+{
+    initIndexes();
+    iterator->kind      = ITERATE_CLUSTER;
+    iterator->local     = local;
+    iterator->clusterId = clusterId;
+    iterator->next      = clusterBuckets[clusterHash(local, clusterId)];
+}
+
+extern "C" void emberBindingTableIterateNode(EmberBindingTableIterator * iterator, ChipNodeId nodeId)
+{
+    initIndexes();
+    iterator->kind   = ITERATE_DESTINATION;
+    iterator->type   = EMBER_UNICAST_BINDING;
+    iterator->nodeId = nodeId;
+    iterator->next   = destinationBuckets[nodeHash(nodeId)];
+}
+
+extern "C" void emberBindingTableIterateGroup(EmberBindingTableIterator * iterator, CHIPGroupId groupId)
+{
+    initIndexes();
+    iterator->kind    = ITERATE_DESTINATION;
+    iterator->type    = EMBER_MULTICAST_BINDING;
+    iterator->groupId = groupId;
+    iterator->next    = destinationBuckets[groupHash(groupId)];
+}
+
+extern "C" bool emberBindingTableIteratorNext(EmberBindingTableIterator * iterator, uint16_t * index,
+                                              EmberBindingTableEntry * entry)
+{
+    while (iterator->next != EMBER_NULL_BINDING)
+    {
+        uint16_t current = iterator->next;
+        iterator->next   = (iterator->kind == ITERATE_CLUSTER ? clusterNext[current] : destinationNext[current]);
+
+        if (iteratorMatches(iterator, &bindingTable[current]))
+        {
+            *index = current;
+            if (entry != NULL)
+            {
+                *entry = bindingTable[current];
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+extern "C" uint16_t emberBindingTableFindUnusedIndex(void)
+{
+    uint16_t i;
+    for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    {
+        if (bindingTable[i].type == EMBER_UNUSED_BINDING)
+        {
+            return i;
+        }
+    }
+    return EMBER_NULL_BINDING;
+}
@@ -27,15 +27,93 @@
 // Should this be configurable by the app somehow?
 #define BINDING_TABLE_SIZE 10
 
+// Index used to signal that no binding table entry was found.  Binding table
+// indexes are uint16_t, so the table holds at most 0xFFFE entries.
+#define EMBER_NULL_BINDING 0xFFFF
+
+// Number of hash buckets of each binding table index.  Must be a power of two.
+#ifndef EMBER_BINDING_TABLE_BUCKET_COUNT
+#define EMBER_BINDING_TABLE_BUCKET_COUNT 16
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
 
-EmberStatus emberGetBinding(uint8_t index, EmberBindingTableEntry * result);
+EmberStatus emberGetBinding(uint16_t index, EmberBindingTableEntry * result);
+
+EmberStatus emberSetBinding(uint16_t index, EmberBindingTableEntry * result);
+
+EmberStatus emberDeleteBinding(uint16_t index);
+
+/**
+ * @brief Called with the index of a binding table entry every time that entry
+ * is set or deleted, so that the application can persist only the entries
+ * that changed.
+ */
+typedef void (*EmberBindingTableChangedHandler)(uint16_t index, const EmberBindingTableEntry * entry);
+
+/**
+ * @brief Sets the handler called on every binding table change.  Pass NULL to
+ * stop receiving changes.
+ */
+void emberSetBindingTableChangedHandler(EmberBindingTableChangedHandler handler);
+
+/**
+ * @brief Iterator over the binding table entries matching a key.
+ *
+ * The binding table keeps two hash indexes: one by (local endpoint, cluster
+ * id), and one by destination (node id for unicast bindings, group id for
+ * multicast bindings).  An iterator walks one hash chain of one of those
+ * indexes, so it only visits the entries that hash like the key.
+ *
+ * The entry last returned by emberBindingTableIteratorNext can be deleted
+ * without disturbing the iteration.
+ */
+typedef struct
+{
+    uint16_t next;
+    uint8_t kind;
+    EmberBindingType type;
+    CHIPEndpointId local;
+    CHIPClusterId clusterId;
+    ChipNodeId nodeId;
+    CHIPGroupId groupId;
+} EmberBindingTableIterator;
+
+/**
+ * @brief Starts iterating over the bindings of the given local endpoint and
+ * cluster, whatever their type.
+ */
+void emberBindingTableIterateCluster(EmberBindingTableIterator * iterator, CHIPEndpointId local, CHIPClusterId clusterId);
+
+/**
+ * @brief Starts iterating over the unicast bindings to the given node.
+ */
+void emberBindingTableIterateNode(EmberBindingTableIterator * iterator, ChipNodeId nodeId);
 
-EmberStatus emberSetBinding(uint8_t index, EmberBindingTableEntry * result);
+/**
+ * @brief Starts iterating over the multicast bindings for the given group.
+ */
+void emberBindingTableIterateGroup(EmberBindingTableIterator * iterator, CHIPGroupId groupId);
 
-EmberStatus emberDeleteBinding(uint8_t index);
+/**
+ * @brief Gets the next binding matching the iterator's key.
+ *
+ * @param iterator An iterator started with one of the
+ *                 emberBindingTableIterate* functions.
+ * @param index Set to the index of the binding.
+ * @param entry If not NULL, set to the binding.
+ *
+ * @return false once there are no more matching bindings.
+ */
+bool emberBindingTableIteratorNext(EmberBindingTableIterator * iterator, uint16_t * index, EmberBindingTableEntry * entry);
+
+/**
+ * @brief Returns the index of an unused binding table entry, or
+ * EMBER_NULL_BINDING if the table is full.
+ */
+uint16_t emberBindingTableFindUnusedIndex(void);
 
 #ifdef __cplusplus
 } // extern "C"
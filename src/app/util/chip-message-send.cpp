@@ -86,4 +86,24 @@ EmberStatus chipSendUnicast(NodeId destination, EmberApsFrame * apsFrame, uint16
     return EMBER_SUCCESS;
 }
 
+EmberStatus chipSendUnicastBatch(NodeId destination, uint16_t messageLength, uint8_t * message)
+{
+    auto * buffer = System::PacketBuffer::NewWithAvailableSize(messageLength);
+    if (!buffer)
+    {
+        return EMBER_MESSAGE_TOO_LONG;
+    }
+
+    memcpy(buffer->Start(), message, messageLength);
+    buffer->SetDataLength(messageLength);
+
+    CHIP_ERROR err = SessionManager().SendMessage(destination, buffer);
+    if (err != CHIP_NO_ERROR)
+    {
+        return EMBER_DELIVERY_FAILED;
+    }
+
+    return EMBER_SUCCESS;
+}
+
 } // extern "C"
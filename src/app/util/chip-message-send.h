@@ -44,6 +44,17 @@ extern "C" {
 
 EmberStatus chipSendUnicast(ChipNodeId destination, EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message);
 
+/**
+ * @brief
+ *    Called to send a batch message, which already carries the APS frame of
+ *    each of its records.  See CHIP_ZCL_BATCH_FRAME_CONTROL.
+ *
+ * @param[in] destination The destination node id to send the message to.
+ * @param[in] messageLength The length of the batch message.
+ * @param[in] message The batch message to send.
+ */
+EmberStatus chipSendUnicastBatch(ChipNodeId destination, uint16_t messageLength, uint8_t * message);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
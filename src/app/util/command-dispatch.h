@@ -0,0 +1,247 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file Table-driven dispatch of cluster-specific commands.
+ *
+ * The generated call-command-handler.c describes the commands an application
+ * handles as two constant tables, one per direction, keyed by cluster ID and
+ * command ID.  Each table is an open-addressing hash table laid out by the
+ * generator: an entry sits at emberAfCommandDispatchSlot() of its key, or in
+ * the first free slot after it, so that a lookup is a hash and a short probe.
+ *
+ * Each table entry points at the handler of one command, which decodes the
+ * command arguments with an EmberAfCommandDecoder and calls the command
+ * callback.  The decoder reads the arguments in place, checks every read
+ * against the end of the message and only reports the message as malformed
+ * once all arguments have been read.
+ */
+
+#ifndef COMMAND_DISPATCH_H
+#define COMMAND_DISPATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "af-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**
+ * @brief Handler of one cluster-specific command.  Decodes the command
+ * arguments out of cmd and calls the matching command callback.
+ */
+typedef EmberAfStatus (*EmberAfCommandHandler)(EmberAfClusterCommand * cmd);
+
+/**
+ * @brief One slot of a command dispatch table.  A NULL handler marks a free
+ * slot.
+ */
+typedef struct
+{
+    EmberAfClusterId clusterId;
+    uint8_t commandId;
+    EmberAfCommandHandler handler;
+} EmberAfCommandDispatchEntry;
+
+/**
+ * @brief The commands handled in one direction.
+ */
+typedef struct
+{
+    /** The slots of the table, at least one of which is free. */
+    const EmberAfCommandDispatchEntry * entries;
+    /** The number of slots, a power of two. */
+    uint16_t size;
+} EmberAfCommandDispatchTable;
+
+/**
+ * @brief Returns the slot at which the lookup of a command starts in a table
+ * of tableSize slots.
+ */
+static inline uint16_t emberAfCommandDispatchSlot(EmberAfClusterId clusterId, uint8_t commandId, uint16_t tableSize)
+{
+    return (uint16_t)((clusterId * 31u + commandId) & (tableSize - 1u));
+}
+
+/**
+ * @brief Finds the handler of a command.
+ *
+ * @return The handler, or NULL if the table has none for the command.
+ */
+static inline EmberAfCommandHandler emberAfFindCommandHandler(const EmberAfCommandDispatchTable * table,
+                                                              EmberAfClusterId clusterId, uint8_t commandId)
+{
+    uint16_t slot = emberAfCommandDispatchSlot(clusterId, commandId, table->size);
+
+    // The table always has a free slot, which ends the probe of a missing command.
+    while (table->entries[slot].handler != NULL)
+    {
+        if (table->entries[slot].clusterId == clusterId && table->entries[slot].commandId == commandId)
+        {
+            return table->entries[slot].handler;
+        }
+        slot = (uint16_t)((slot + 1u) & (table->size - 1u));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Reads the arguments of a command out of the message buffer.
+ *
+ * A read past the end of the message marks the decoder as malformed and
+ * yields zero, or an empty string or array; the handler checks the decoder
+ * once before calling the command callback.
+ */
+typedef struct
+{
+    uint8_t * buffer;
+    uint16_t length;
+    uint16_t offset;
+    bool malformed;
+} EmberAfCommandDecoder;
+
+static inline void emberAfCommandDecoderInit(EmberAfCommandDecoder * decoder, const EmberAfClusterCommand * cmd)
+{
+    decoder->buffer    = cmd->buffer;
+    decoder->length    = cmd->bufLen;
+    decoder->offset    = cmd->payloadStartIndex;
+    decoder->malformed = false;
+}
+
+/**
+ * @brief Returns the number of bytes left to decode.
+ */
+static inline uint16_t emberAfCommandDecoderRemaining(const EmberAfCommandDecoder * decoder)
+{
+    return (decoder->offset < decoder->length) ? (uint16_t)(decoder->length - decoder->offset) : 0;
+}
+
+/**
+ * @brief Returns the length of the characters of the string at the decoder
+ * position; 0xFF marks an invalid string, which has none.
+ */
+static inline uint8_t emberAfCommandDecoderStringLength(const EmberAfCommandDecoder * decoder)
+{
+    uint8_t length = decoder->buffer[decoder->offset];
+    return (length == 0xFF) ? 0 : length;
+}
+
+/**
+ * @brief Returns whether the rest of the message starts with a complete string.
+ */
+static inline bool emberAfCommandDecoderHasString(const EmberAfCommandDecoder * decoder)
+{
+    uint16_t remaining = emberAfCommandDecoderRemaining(decoder);
+    return remaining > 0 && emberAfCommandDecoderStringLength(decoder) < remaining;
+}
+
+/**
+ * @brief Claims size bytes of the message, and returns where they start, or
+ * NULL if the message is too short.
+ */
+static inline const uint8_t * emberAfCommandDecoderClaim(EmberAfCommandDecoder * decoder, uint16_t size)
+{
+    const uint8_t * data = NULL;
+
+    if (emberAfCommandDecoderRemaining(decoder) < size)
+    {
+        decoder->malformed = true;
+    }
+    else
+    {
+        data            = decoder->buffer + decoder->offset;
+        decoder->offset = (uint16_t)(decoder->offset + size);
+    }
+
+    return data;
+}
+
+static inline uint8_t emberAfDecodeInt8u(EmberAfCommandDecoder * decoder)
+{
+    const uint8_t * data = emberAfCommandDecoderClaim(decoder, 1);
+    return (data == NULL) ? 0 : data[0];
+}
+
+static inline uint16_t emberAfDecodeInt16u(EmberAfCommandDecoder * decoder)
+{
+    const uint8_t * data = emberAfCommandDecoderClaim(decoder, 2);
+
+    if (data == NULL)
+    {
+        return 0;
+    }
+
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static inline uint32_t emberAfDecodeInt32u(EmberAfCommandDecoder * decoder)
+{
+    const uint8_t * data = emberAfCommandDecoderClaim(decoder, 4);
+
+    if (data == NULL)
+    {
+        return 0;
+    }
+
+    return (uint32_t) data[0] | (uint32_t) data[1] << 8 | (uint32_t) data[2] << 16 | (uint32_t) data[3] << 24;
+}
+
+/**
+ * @brief Decodes a string, and returns it in place, starting with its length
+ * byte.
+ */
+static inline uint8_t * emberAfDecodeString(EmberAfCommandDecoder * decoder)
+{
+    static uint8_t emptyString = 0;
+    uint8_t * string           = NULL;
+
+    if (!emberAfCommandDecoderHasString(decoder))
+    {
+        decoder->malformed = true;
+        return &emptyString;
+    }
+
+    string          = decoder->buffer + decoder->offset;
+    decoder->offset = (uint16_t)(decoder->offset + emberAfCommandDecoderStringLength(decoder) + 1u);
+    return string;
+}
+
+/**
+ * @brief Decodes an array that extends to the end of the message, and returns
+ * it in place.  The array may be empty.
+ */
+static inline uint8_t * emberAfDecodeArray(EmberAfCommandDecoder * decoder)
+{
+    uint8_t * array = decoder->buffer + decoder->offset;
+
+    if (decoder->offset < decoder->length)
+    {
+        decoder->offset = decoder->length;
+    }
+
+    return array;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // COMMAND_DISPATCH_H
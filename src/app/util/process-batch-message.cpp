@@ -0,0 +1,208 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   This file implements the processing of batch messages.  A batch message
+ *   carries several read/write attribute commands, possibly for different
+ *   clusters and endpoints (see CHIP_ZCL_BATCH_FRAME_CONTROL).  While a batch
+ *   is being processed, the responses to its commands are collected into
+ *   batch responses instead of being sent one by one.
+ */
+
+#include "af.h"
+#include "chip-message-send.h"
+#include "common.h"
+
+#include <app/chip-zcl-zpro-codec.h>
+
+using namespace chip;
+
+#ifndef EMBER_AF_BATCH_RESPONSE_BUFFER_LEN
+#define EMBER_AF_BATCH_RESPONSE_BUFFER_LEN 1024
+#endif
+
+static uint8_t batchResponseData[EMBER_AF_BATCH_RESPONSE_BUFFER_LEN];
+static uint16_t batchResponseLength;
+static bool batchResponseActive = false;
+static ChipNodeId batchResponseDestination;
+
+static EmberStatus flushBatchResponse(void)
+{
+    EmberStatus status = EMBER_SUCCESS;
+
+    // Nothing to send if no record was added since the last flush.
+    if (batchResponseLength > CHIP_ZCL_BATCH_HEADER_LENGTH)
+    {
+        status = chipSendUnicastBatch(batchResponseDestination, batchResponseLength, batchResponseData);
+        emberAfDebugPrintln("TX batch response: %d records, len %d, status 0x%x", batchResponseData[1], batchResponseLength,
+                            status);
+    }
+
+    batchResponseLength = encodeBatchHeader(batchResponseData, sizeof(batchResponseData));
+    return status;
+}
+
+static bool isBatchableGlobalCommand(const uint8_t * message, uint16_t msgLen)
+{
+    uint8_t commandIndex;
+
+    if (msgLen < EMBER_AF_ZCL_OVERHEAD || (message[0] & ZCL_FRAME_CONTROL_FRAME_TYPE_MASK) != 0)
+    {
+        return false;
+    }
+
+    commandIndex = (message[0] & ZCL_MANUFACTURER_SPECIFIC_MASK) ? EMBER_AF_ZCL_MANUFACTURER_SPECIFIC_OVERHEAD - 1
+                                                                  : EMBER_AF_ZCL_OVERHEAD - 1;
+    if (msgLen <= commandIndex)
+    {
+        return false;
+    }
+
+    switch (message[commandIndex])
+    {
+    case ZCL_READ_ATTRIBUTES_COMMAND_ID:
+    case ZCL_WRITE_ATTRIBUTES_COMMAND_ID:
+    case ZCL_WRITE_ATTRIBUTES_UNDIVIDED_COMMAND_ID:
+    case ZCL_WRITE_ATTRIBUTES_NO_RESPONSE_COMMAND_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static EmberStatus appendBatchRecord(EmberApsFrame * apsFrame, uint16_t messageLength, const uint8_t * message)
+{
+    uint16_t newLength =
+        encodeBatchMessage(batchResponseData, sizeof(batchResponseData), batchResponseLength, apsFrame, message, messageLength);
+
+    if (newLength == 0)
+    {
+        // The batch is full: send it, and start the next one with this response.
+        EmberStatus status = flushBatchResponse();
+        if (status != EMBER_SUCCESS)
+        {
+            return status;
+        }
+
+        newLength = encodeBatchMessage(batchResponseData, sizeof(batchResponseData), batchResponseLength, apsFrame, message,
+                                       messageLength);
+        if (newLength == 0)
+        {
+            return EMBER_MESSAGE_TOO_LONG;
+        }
+    }
+
+    batchResponseLength = newLength;
+    return EMBER_SUCCESS;
+}
+
+// A response too large for any batch is replaced by a Default Response with
+// the INSUFFICIENT_SPACE status, so that every record of the batch is still
+// answered in the batch framing the requester expects.
+static EmberStatus appendInsufficientSpaceResponse(EmberApsFrame * apsFrame, uint16_t messageLength, const uint8_t * message)
+{
+    uint8_t response[EMBER_AF_ZCL_MANUFACTURER_SPECIFIC_OVERHEAD + 2];
+    uint8_t headerLength = (message[0] & ZCL_MANUFACTURER_SPECIFIC_MASK) ? EMBER_AF_ZCL_MANUFACTURER_SPECIFIC_OVERHEAD
+                                                                          : EMBER_AF_ZCL_OVERHEAD;
+    EmberAfClusterCommand * cmd = emberAfCurrentCommand();
+
+    if (messageLength < headerLength || cmd == NULL)
+    {
+        return EMBER_MESSAGE_TOO_LONG;
+    }
+
+    emberAfDebugPrintln("Batch response for clus 0x%2x too long (%d bytes)", apsFrame->clusterId, messageLength);
+
+    // Keep the frame control, manufacturer code and sequence number of the response.
+    memcpy(response, message, headerLength - 1u);
+    response[headerLength - 1] = ZCL_DEFAULT_RESPONSE_COMMAND_ID;
+    response[headerLength]     = cmd->commandId;
+    response[headerLength + 1] = EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
+
+    return appendBatchRecord(apsFrame, static_cast<uint16_t>(headerLength + 2u), response);
+}
+
+bool emAfBatchResponseActive(void)
+{
+    return batchResponseActive;
+}
+
+EmberStatus emAfAppendBatchResponse(ChipNodeId destination, EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message)
+{
+    uint16_t frameSize    = encodeApsFrame(nullptr, 0, apsFrame);
+    uint32_t recordLength = uint32_t(frameSize) + uint32_t(messageLength);
+
+    if (frameSize == 0 || recordLength + CHIP_ZCL_BATCH_HEADER_LENGTH + CHIP_ZCL_BATCH_RECORD_OVERHEAD > sizeof(batchResponseData))
+    {
+        return appendInsufficientSpaceResponse(apsFrame, messageLength, message);
+    }
+
+    return appendBatchRecord(apsFrame, messageLength, message);
+}
+
+bool emberAfProcessBatchMessage(uint8_t * message, uint16_t msgLen, ChipNodeId source)
+{
+    uint16_t offset   = CHIP_ZCL_BATCH_HEADER_LENGTH;
+    bool anyProcessed = false;
+
+    if (!isBatchMessage(message, msgLen))
+    {
+        return false;
+    }
+
+    batchResponseActive      = true;
+    batchResponseDestination = source;
+    batchResponseLength      = encodeBatchHeader(batchResponseData, sizeof(batchResponseData));
+
+    while (offset < msgLen)
+    {
+        EmberApsFrame frame;
+        uint8_t * zclMessage;
+        uint16_t recordOffset     = offset;
+        uint16_t zclMessageLength = extractBatchMessage(message, msgLen, &offset, &frame, &zclMessage);
+
+        // A record that cannot be delimited leaves the offset where it was, and ends the batch.
+        if (offset == recordOffset)
+        {
+            break;
+        }
+
+        if (zclMessageLength == 0)
+        {
+            continue;
+        }
+
+        if (!isBatchableGlobalCommand(zclMessage, zclMessageLength))
+        {
+            emberAfDebugPrintln("Drop batch record for clus 0x%2x: not a read/write attributes command", frame.clusterId);
+            continue;
+        }
+
+        if (emberAfProcessMessage(&frame,
+                                  0, // type
+                                  zclMessage, zclMessageLength, source, NULL))
+        {
+            anyProcessed = true;
+        }
+    }
+
+    flushBatchResponse();
+    batchResponseActive = false;
+
+    return anyProcessed;
+}
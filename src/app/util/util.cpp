@@ -757,9 +757,17 @@ EmberStatus emberAfSendResponseWithCallback(EmberAfMessageSentFunction callback)
     }
     else if (!isBroadcastDestination(emberAfResponseDestination))
     {
-        label  = 'U';
-        status = emberAfSendUnicastWithCallback(EMBER_OUTGOING_DIRECT, emberAfResponseDestination, &emberAfResponseApsFrame,
-                                                appResponseLength, appResponseData, callback);
+        label = 'U';
+        if (emAfBatchResponseActive() && callback == NULL)
+        {
+            status = emAfAppendBatchResponse(emberAfResponseDestination, &emberAfResponseApsFrame, appResponseLength,
+                                             appResponseData);
+        }
+        else
+        {
+            status = emberAfSendUnicastWithCallback(EMBER_OUTGOING_DIRECT, emberAfResponseDestination, &emberAfResponseApsFrame,
+                                                    appResponseLength, appResponseData, callback);
+        }
     }
     else
     {
@@ -164,6 +164,21 @@ void emberAfDecodeAndPrintClusterWithMfgCode(CHIPClusterId cluster, uint16_t mfg
 bool emberAfProcessMessage(EmberApsFrame * apsFrame, EmberIncomingMessageType type, uint8_t * message, uint16_t msgLen,
                            ChipNodeId source, InterPanHeader * interPanHeader);
 
+/**
+ * Processes a batch message (see CHIP_ZCL_BATCH_FRAME_CONTROL) holding read
+ * and write attributes commands for any number of clusters and endpoints.
+ * The responses to all the commands are sent back to source as one batch
+ * message, or as few as the response buffer allows.
+ *
+ * Returns true if at least one command of the batch was handled.
+ */
+bool emberAfProcessBatchMessage(uint8_t * message, uint16_t msgLen, ChipNodeId source);
+
+// Used by emberAfSendResponse to collect responses while a batch message is
+// being processed.
+bool emAfBatchResponseActive(void);
+EmberStatus emAfAppendBatchResponse(ChipNodeId destination, EmberApsFrame * apsFrame, uint16_t messageLength, uint8_t * message);
+
 bool emberAfProcessMessageIntoZclCmd(EmberApsFrame * apsFrame, EmberIncomingMessageType type, uint8_t * message,
                                      uint16_t messageLength, ChipNodeId source, InterPanHeader * interPanHeader,
                                      EmberAfClusterCommand * returnCmd);
@@ -140,7 +140,7 @@ BLE_ERROR BLEEndPoint::StartConnect()
     SuccessOrExit(err);
 
     // Send BLE transport capabilities request to peripheral via GATT write.
-    if (!SendWrite(buf))
+    if (!SendWrite(buf, kGattOperation_Capabilities))
     {
         err = BLE_ERROR_GATT_WRITE_FAILED;
         ExitNow();
@@ -226,7 +226,7 @@ void BLEEndPoint::HandleSubscribeReceived()
 #if CHIP_ENABLE_CHIPOBLE_TEST
     VerifyOrExit(mBtpEngine.PopPacketTag(mSendQueue) == kType_Data, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
 #endif
-    if (!SendIndication(mSendQueue))
+    if (!SendIndication(mSendQueue, kGattOperation_Capabilities))
     {
         // Ensure transmit queue is empty and set to NULL.
         QueueTxLock();
@@ -274,7 +274,10 @@ exit:
 void BLEEndPoint::HandleSubscribeComplete()
 {
     ChipLogProgress(Ble, "subscribe complete, ep = %p", this);
-    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, false);
+    if (OldestGattOperation() == kGattOperation_Subscribe)
+    {
+        PopGattOperation();
+    }
 
     BLE_ERROR err = DriveSending();
 
@@ -286,7 +289,7 @@ void BLEEndPoint::HandleSubscribeComplete()
 
 void BLEEndPoint::HandleUnsubscribeComplete()
 {
-    // Don't bother to clear GattOperationInFlight, we're about to free the end point anyway.
+    // Don't bother to update mGattOperationsInFlight, we're about to free the end point anyway.
     Free();
 }
 
@@ -428,7 +431,7 @@ void BLEEndPoint::FinalizeClose(uint8_t oldState, uint8_t flags, BLE_ERROR err)
                 }
 
                 // Mark unsubscribe GATT operation in progress.
-                SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
+                PushGattOperation(kGattOperation_Unsubscribe);
             }
         }
         else // mRole == kBleRole_Peripheral, OR GetFlag(mTimerStateFlags, kConnState_DidBeginSubscribe) == false...
@@ -590,6 +593,8 @@ BLE_ERROR BLEEndPoint::Init(BleLayer * bleLayer, BLE_CONNECTION_OBJECT connObj,
     mLocalReceiveWindowSize  = 0;
     mRemoteReceiveWindowSize = 0;
     mReceiveWindowMaxSize    = 0;
+    mGattOperationsHead      = 0;
+    mGattOperationsInFlight  = 0;
     mSendQueue               = nullptr;
     mAckToSend               = nullptr;
 
@@ -604,11 +609,28 @@ exit:
 
 BLE_ERROR BLEEndPoint::SendCharacteristic(PacketBuffer * buf)
 {
-    BLE_ERROR err = BLE_NO_ERROR;
+    BLE_ERROR err          = BLE_NO_ERROR;
+    const GattOperation op = (buf == mAckToSend) ? kGattOperation_StandAloneAck : kGattOperation_Fragment;
+
+#if BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT > 1
+    // The fragmenter builds each fragment in place, writing its header over the tail of the previous fragment. Since
+    // the platform may still hold the previous fragment when the next one is built, hand it a copy of its own.
+    PacketBuffer * fragment = nullptr;
+
+    if (buf == mBtpEngine.TxPacket())
+    {
+        fragment = PacketBuffer::NewWithAvailableSize(CHIP_CONFIG_BLE_PKT_RESERVED_SIZE, buf->DataLength());
+        VerifyOrExit(fragment != nullptr, err = BLE_ERROR_NO_MEMORY);
+
+        memcpy(fragment->Start(), buf->Start(), buf->DataLength());
+        fragment->SetDataLength(buf->DataLength());
+        buf = fragment;
+    }
+#endif
 
     if (mRole == kBleRole_Central)
     {
-        if (!SendWrite(buf))
+        if (!SendWrite(buf, op))
         {
             err = BLE_ERROR_GATT_WRITE_FAILED;
         }
@@ -621,7 +643,7 @@ BLE_ERROR BLEEndPoint::SendCharacteristic(PacketBuffer * buf)
     }
     else // (mRole == kBleRole_Peripheral), verified on Init
     {
-        if (!SendIndication(buf))
+        if (!SendIndication(buf, op))
         {
             err = BLE_ERROR_GATT_INDICATE_FAILED;
         }
@@ -633,6 +655,15 @@ BLE_ERROR BLEEndPoint::SendCharacteristic(PacketBuffer * buf)
         }
     }
 
+#if BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT > 1
+exit:
+    if (fragment != nullptr)
+    {
+        // The platform holds its own reference to the copy for the duration of the GATT operation.
+        PacketBuffer::Free(fragment);
+    }
+#endif
+
     return err;
 }
 
@@ -848,14 +879,19 @@ BLE_ERROR BLEEndPoint::HandleHandshakeConfirmationReceived()
     {
         // Subscribe to characteristic which peripheral will use to send indications. Prompts peripheral to send
         // BLE transport capabilities indication.
-        VerifyOrExit(mBle->mPlatformDelegate->SubscribeCharacteristic(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_2_ID),
-                     err = BLE_ERROR_GATT_SUBSCRIBE_FAILED);
+        // Mark GATT operation in progress for subscribe request before making it, in case the platform completes it in
+        // the downcall.
+        PushGattOperation(kGattOperation_Subscribe);
+
+        if (!mBle->mPlatformDelegate->SubscribeCharacteristic(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_2_ID))
+        {
+            CancelGattOperation();
+            err = BLE_ERROR_GATT_SUBSCRIBE_FAILED;
+            ExitNow();
+        }
 
         // We just sent a GATT subscribe request, so make sure to attempt unsubscribe on close.
         SetFlag(mConnStateFlags, kConnState_DidBeginSubscribe, true);
-
-        // Mark GATT operation in progress for subscribe request.
-        SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
     }
     else // (mRole == kBleRole_Peripheral), verified on Init
     {
@@ -897,7 +933,7 @@ exit:
     return err;
 }
 
-BLE_ERROR BLEEndPoint::HandleFragmentConfirmationReceived()
+BLE_ERROR BLEEndPoint::HandleFragmentConfirmationReceived(bool standAloneAckConfirmed)
 {
     BLE_ERROR err = BLE_NO_ERROR;
 
@@ -916,7 +952,7 @@ BLE_ERROR BLEEndPoint::HandleFragmentConfirmationReceived()
     // TODO PacketBuffer high water mark optimization: if ack pending, but fragmenter state == complete, free fragmenter's
     // tx buf before sending ack.
 
-    if (GetFlag(mConnStateFlags, kConnState_StandAloneAckInFlight))
+    if (standAloneAckConfirmed)
     {
         // If confirmation was received for stand-alone ack, free its tx buffer.
         PacketBuffer::Free(mAckToSend);
@@ -956,18 +992,29 @@ BLE_ERROR BLEEndPoint::HandleGattSendConfirmationReceived()
 {
     ChipLogDebugBleEndPoint(Ble, "entered HandleGattSendConfirmationReceived");
 
-    // Mark outstanding GATT operation as finished.
-    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, false);
+    // The confirmation is for the oldest outstanding GATT write or indication, so mark it as finished.
+    const GattOperation op = OldestGattOperation();
 
-    // If confirmation was for outbound portion of BTP connect handshake...
-    if (!GetFlag(mConnStateFlags, kConnState_CapabilitiesConfReceived))
+    switch (op)
     {
+    case kGattOperation_Capabilities:
+        PopGattOperation();
+
+        // Confirmation was for outbound portion of BTP connect handshake.
         SetFlag(mConnStateFlags, kConnState_CapabilitiesConfReceived, true);
 
         return HandleHandshakeConfirmationReceived();
-    }
 
-    return HandleFragmentConfirmationReceived();
+    case kGattOperation_Fragment:
+    case kGattOperation_StandAloneAck:
+        PopGattOperation();
+
+        return HandleFragmentConfirmationReceived(op == kGattOperation_StandAloneAck);
+
+    default:
+        ChipLogError(Ble, "unexpected GATT send conf, oldest op = %d", op);
+        return BLE_ERROR_INCORRECT_STATE;
+    }
 }
 
 BLE_ERROR BLEEndPoint::DriveStandAloneAck()
@@ -1017,19 +1064,22 @@ exit:
 
 BLE_ERROR BLEEndPoint::DriveSending()
 {
-    BLE_ERROR err = BLE_NO_ERROR;
+    BLE_ERROR err                  = BLE_NO_ERROR;
+    const uint8_t inFlightOnEntry  = mGattOperationsInFlight;
+    const bool standAloneAckToSend = (mAckToSend != nullptr && !GetFlag(mConnStateFlags, kConnState_StandAloneAckInFlight));
 
     ChipLogDebugBleEndPoint(Ble, "entered DriveSending");
 
     // If receiver's window is almost closed and we don't have an ack to send, OR we do have an ack to send but
-    // receiver's window is completely empty, OR another GATT operation is in flight, awaiting confirmation...
+    // receiver's window is completely empty, OR the platform can't take another GATT operation until one in flight
+    // is confirmed...
     if ((mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
-         !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && mAckToSend == nullptr) ||
-        (mRemoteReceiveWindowSize == 0) || (GetFlag(mConnStateFlags, kConnState_GattOperationInFlight)))
+         !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && !standAloneAckToSend) ||
+        (mRemoteReceiveWindowSize == 0) || (mGattOperationsInFlight >= BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT))
     {
 #ifdef CHIP_BLE_END_POINT_DEBUG_LOGGING_ENABLED
         if (mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
-            !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && mAckToSend == NULL)
+            !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && !standAloneAckToSend)
         {
             ChipLogDebugBleEndPoint(Ble, "NO SEND: receive window almost closed, and no ack to send");
         }
@@ -1039,7 +1089,7 @@ BLE_ERROR BLEEndPoint::DriveSending()
             ChipLogDebugBleEndPoint(Ble, "NO SEND: remote receive window closed");
         }
 
-        if (GetFlag(mConnStateFlags, kConnState_GattOperationInFlight))
+        if (mGattOperationsInFlight >= BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT)
         {
             ChipLogDebugBleEndPoint(Ble, "NO SEND: Gatt op in flight");
         }
@@ -1051,7 +1101,7 @@ BLE_ERROR BLEEndPoint::DriveSending()
 
     // Otherwise, let's see what we can send.
 
-    if (mAckToSend != nullptr) // If immediate, stand-alone ack is pending, send it.
+    if (standAloneAckToSend) // If immediate, stand-alone ack is pending, send it.
     {
         err = DoSendStandAloneAck();
         SuccessOrExit(err);
@@ -1107,6 +1157,16 @@ BLE_ERROR BLEEndPoint::DriveSending()
     }
 
 exit:
+#if BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT > 1
+    // Keep the pipeline full: if something was sent, send more while the remote window and the platform allow it.
+    if (err == BLE_NO_ERROR && mGattOperationsInFlight > inFlightOnEntry)
+    {
+        err = DriveSending();
+    }
+#else
+    IgnoreUnusedVariable(inFlightOnEntry);
+#endif
+
     return err;
 }
 
@@ -1142,8 +1202,7 @@ BLE_ERROR BLEEndPoint::HandleCapabilitiesRequestReceived(PacketBuffer * data)
     // Select fragment size for connection based on ATT MTU.
     if (mtu > 0) // If one or both device knows connection's MTU...
     {
-        resp.mFragmentSize =
-            chip::min(static_cast<uint16_t>(mtu - 3), BtpEngine::sMaxFragmentSize); // Reserve 3 bytes of MTU for ATT header.
+        resp.mFragmentSize = BtpEngine::FragmentSizeForMtu(mtu);
     }
     else // Else, if neither device knows MTU...
     {
@@ -1446,14 +1505,31 @@ BLE_ERROR BLEEndPoint::Receive(PacketBuffer * data)
     //
     // If any GATT operation is in flight that is NOT a stand-alone ack, the window size will be checked against
     // this threshold again when the GATT operation is confirmed.
+    //
+    // If an outbound fragment is waiting only because the remote window is almost closed, the ack is coalesced with
+    // that fragment instead: marking the ack pending lets DriveSending() send the fragment with the ack piggybacked,
+    // which reopens both windows with a single GATT operation.
     if (mBtpEngine.HasUnackedData())
     {
         if (mLocalReceiveWindowSize <= BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD &&
-            !GetFlag(mConnStateFlags, kConnState_GattOperationInFlight))
+            mGattOperationsInFlight < BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT)
         {
-            ChipLogDebugBleEndPoint(Ble, "sending immediate ack");
-            err = DriveStandAloneAck();
-            SuccessOrExit(err);
+            if (mRemoteReceiveWindowSize > 0 &&
+                (mSendQueue != nullptr || mBtpEngine.TxState() == BtpEngine::kState_InProgress))
+            {
+                ChipLogDebugBleEndPoint(Ble, "piggybacking immediate ack");
+                err = StartSendAckTimer();
+                SuccessOrExit(err);
+
+                err = DriveSending();
+                SuccessOrExit(err);
+            }
+            else
+            {
+                ChipLogDebugBleEndPoint(Ble, "sending immediate ack");
+                err = DriveStandAloneAck();
+                SuccessOrExit(err);
+            }
         }
         else
         {
@@ -1513,7 +1589,7 @@ exit:
     return err;
 }
 
-bool BLEEndPoint::SendWrite(PacketBuffer * buf)
+bool BLEEndPoint::SendWrite(PacketBuffer * buf, GattOperation op)
 {
     // Add reference to message fragment for duration of platform's GATT write attempt. CHIP retains partial
     // ownership of message fragment's PacketBuffer, since this is the same buffer as that of the whole message, just
@@ -1521,12 +1597,18 @@ bool BLEEndPoint::SendWrite(PacketBuffer * buf)
     // platform when BLE GATT operation completes.
     buf->AddRef();
 
-    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
+    PushGattOperation(op);
+
+    if (!mBle->mPlatformDelegate->SendWriteRequest(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_1_ID, buf))
+    {
+        CancelGattOperation();
+        return false;
+    }
 
-    return mBle->mPlatformDelegate->SendWriteRequest(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_1_ID, buf);
+    return true;
 }
 
-bool BLEEndPoint::SendIndication(PacketBuffer * buf)
+bool BLEEndPoint::SendIndication(PacketBuffer * buf, GattOperation op)
 {
     // Add reference to message fragment for duration of platform's GATT indication attempt. CHIP retains partial
     // ownership of message fragment's PacketBuffer, since this is the same buffer as that of the whole message, just
@@ -1534,9 +1616,45 @@ bool BLEEndPoint::SendIndication(PacketBuffer * buf)
     // platform when BLE GATT operation completes.
     buf->AddRef();
 
-    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
+    PushGattOperation(op);
 
-    return mBle->mPlatformDelegate->SendIndication(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_2_ID, buf);
+    if (!mBle->mPlatformDelegate->SendIndication(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_2_ID, buf))
+    {
+        CancelGattOperation();
+        return false;
+    }
+
+    return true;
+}
+
+void BLEEndPoint::PushGattOperation(GattOperation op)
+{
+    VerifyOrDie(mGattOperationsInFlight < ArraySize(mGattOperations));
+
+    mGattOperations[(mGattOperationsHead + mGattOperationsInFlight) % ArraySize(mGattOperations)] = op;
+    mGattOperationsInFlight++;
+}
+
+void BLEEndPoint::CancelGattOperation()
+{
+    if (mGattOperationsInFlight > 0)
+    {
+        mGattOperationsInFlight--;
+    }
+}
+
+void BLEEndPoint::PopGattOperation()
+{
+    if (mGattOperationsInFlight > 0)
+    {
+        mGattOperationsHead = static_cast<uint8_t>((mGattOperationsHead + 1) % ArraySize(mGattOperations));
+        mGattOperationsInFlight--;
+    }
+}
+
+BLEEndPoint::GattOperation BLEEndPoint::OldestGattOperation() const
+{
+    return (mGattOperationsInFlight > 0) ? mGattOperations[mGattOperationsHead] : kGattOperation_None;
 }
 
 BLE_ERROR BLEEndPoint::StartConnectTimer()
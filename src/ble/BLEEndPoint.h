@@ -112,9 +112,7 @@ private:
         kConnState_CapabilitiesConfReceived = 0x02, // GATT confirmation received for sent capabilities req/resp.
         kConnState_CapabilitiesMsgReceived  = 0x04, // Capabilities request or response message received.
         kConnState_DidBeginSubscribe        = 0x08, // GATT subscribe request sent; must unsubscribe on close.
-        kConnState_StandAloneAckInFlight    = 0x10, // Stand-alone ack in flight, awaiting GATT confirmation.
-        kConnState_GattOperationInFlight    = 0x20  // GATT write, indication, subscribe, or unsubscribe in flight,
-                                                    // awaiting GATT confirmation.
+        kConnState_StandAloneAckInFlight    = 0x10  // Stand-alone ack in flight, awaiting GATT confirmation.
     };
 
     enum TimerStateFlags
@@ -129,6 +127,18 @@ private:
 #endif
     };
 
+    // Kinds of GATT operation an end point awaits the completion of. The platform confirms GATT writes and indications
+    // in the order they were sent, so the oldest operation in flight tells what a confirmation is for.
+    enum GattOperation : uint8_t
+    {
+        kGattOperation_None          = 0,
+        kGattOperation_Capabilities  = 1, // Write or indication of the capabilities request or response.
+        kGattOperation_Fragment      = 2, // Write or indication of a message fragment.
+        kGattOperation_StandAloneAck = 3, // Write or indication of a stand-alone ack.
+        kGattOperation_Subscribe     = 4, // Subscribe request.
+        kGattOperation_Unsubscribe   = 5  // Unsubscribe request.
+    };
+
     // BLE connection to which an end point is uniquely bound. Type BLE_CONNECTION_OBJECT is defined by the platform or
     // void* by default. This object is passed back to the platform delegate with each call to send traffic over or
     // modify the state of the underlying BLE connection.
@@ -151,6 +161,11 @@ private:
     SequenceNumber_t mLocalReceiveWindowSize;
     SequenceNumber_t mRemoteReceiveWindowSize;
     SequenceNumber_t mReceiveWindowMaxSize;
+    // GATT writes, indications, subscribes, or unsubscribes awaiting completion, oldest first. An unsubscribe may be
+    // requested on close while the maximum number of writes or indications are in flight.
+    GattOperation mGattOperations[BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT + 1];
+    uint8_t mGattOperationsHead;     // Index of the oldest GATT operation in flight.
+    uint8_t mGattOperationsInFlight; // Number of GATT operations in flight.
 #if CHIP_ENABLE_CHIPOBLE_TEST
     chip::System::Mutex mTxQueueMutex; // For MT-safe Tx queuing
 #endif
@@ -171,8 +186,12 @@ private:
     BLE_ERROR ContinueMessageSend();
     BLE_ERROR DoSendStandAloneAck();
     BLE_ERROR SendCharacteristic(PacketBuffer * buf);
-    bool SendIndication(PacketBuffer * buf);
-    bool SendWrite(PacketBuffer * buf);
+    bool SendIndication(PacketBuffer * buf, GattOperation op);
+    bool SendWrite(PacketBuffer * buf, GattOperation op);
+    void PushGattOperation(GattOperation op); // Add newest GATT operation in flight.
+    void CancelGattOperation();               // Remove newest GATT operation, which the platform failed to start.
+    void PopGattOperation();                  // Remove oldest GATT operation, which has completed.
+    GattOperation OldestGattOperation() const;
 
     // Receive path:
     BLE_ERROR HandleConnectComplete();
@@ -182,7 +201,7 @@ private:
     void HandleUnsubscribeComplete();
     BLE_ERROR HandleGattSendConfirmationReceived();
     BLE_ERROR HandleHandshakeConfirmationReceived();
-    BLE_ERROR HandleFragmentConfirmationReceived();
+    BLE_ERROR HandleFragmentConfirmationReceived(bool standAloneAckConfirmed);
     BLE_ERROR HandleCapabilitiesRequestReceived(PacketBuffer * data);
     BLE_ERROR HandleCapabilitiesResponseReceived(PacketBuffer * data);
     SequenceNumber_t AdjustRemoteReceiveWindow(SequenceNumber_t lastReceivedAck, SequenceNumber_t maxRemoteWindowSize,
@@ -172,6 +172,26 @@
 #error "BLE_MAX_RECEIVE_WINDOW_SIZE must be greater than 2 for BLE transport protocol stability."
 #endif
 
+/**
+ *  @def BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT
+ *
+ *  @brief
+ *    This is the number of GATT writes or indications a BLE end point may hand to the platform before the first of
+ *    them is confirmed. ATT allows only one outstanding write request or indication per bearer, so the default of 1
+ *    waits for each confirmation. Platforms whose BLE stack queues GATT operations internally may raise this value to
+ *    pipeline several fragments within the peer's receive window; each fragment is then handed to the platform in a
+ *    buffer of its own. The peer's receive window still bounds the fragments in flight, so a value at or above
+ *    BLE_MAX_RECEIVE_WINDOW_SIZE simply lets the window alone pace sending.
+ *
+ */
+#ifndef BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT
+#define BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT               1
+#endif
+
+#if (BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT < 1 || BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT > 127)
+#error "BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT must be between 1 and 127."
+#endif
+
 /**
  *  @def BLE_CONFIG_ERROR_TYPE
  *
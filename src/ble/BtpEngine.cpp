@@ -90,7 +90,19 @@ static void PrintBufDebug(PacketBuffer * buf)
 }
 
 const uint16_t BtpEngine::sDefaultFragmentSize = 20;  // 23-byte minimum ATT_MTU - 3 bytes for ATT operation header
-const uint16_t BtpEngine::sMaxFragmentSize     = 128; // Size of write and indication characteristics
+const uint16_t BtpEngine::sMaxFragmentSize     = 244; // 251-byte LE data length - 4 bytes L2CAP header - 3 bytes ATT header
+
+// Returns the fragment size for a connection with the given ATT MTU: the whole ATT payload, up to one LE data channel
+// PDU. An MTU below the 23-byte minimum means the MTU is unknown, and yields the default fragment size.
+uint16_t BtpEngine::FragmentSizeForMtu(uint16_t mtu)
+{
+    if (mtu < sDefaultFragmentSize + 3) // Reserve 3 bytes of MTU for ATT header.
+    {
+        return sDefaultFragmentSize;
+    }
+
+    return chip::min(static_cast<uint16_t>(mtu - 3), sMaxFragmentSize);
+}
 
 BLE_ERROR BtpEngine::Init(void * an_app_state, bool expect_first_ack)
 {
@@ -327,13 +339,22 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
 
         data->SetStart(&(characteristic[cursor]));
 
-        // Create a new buffer for use as the Rx re-assembly area.
-        mRxBuf = PacketBuffer::New();
+        if (data->AllocSize() >= mRxLength)
+        {
+            // The fragment's own buffer can hold the whole message once compacted, so adopt it as the Rx re-assembly area
+            // rather than copying its payload. A message that fits in one fragment is never copied.
+            mRxBuf = data;
+        }
+        else
+        {
+            // Create a new buffer for use as the Rx re-assembly area.
+            mRxBuf = PacketBuffer::New();
 
-        VerifyOrExit(mRxBuf != nullptr, err = BLE_ERROR_NO_MEMORY);
+            VerifyOrExit(mRxBuf != nullptr, err = BLE_ERROR_NO_MEMORY);
 
-        mRxBuf->AddToEnd(data);
-        mRxBuf->CompactHead(); // will free 'data' and adjust rx buf's end/length
+            mRxBuf->AddToEnd(data);
+            mRxBuf->CompactHead(); // will free 'data' and adjust rx buf's end/length
+        }
         data = nullptr;
     }
     else if (mRxState == kState_InProgress)
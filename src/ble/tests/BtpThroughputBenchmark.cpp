@@ -0,0 +1,357 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a throughput simulation of the BLE transfer
+ *      protocol (BTP). Two BTP engines stream messages from central to
+ *      peripheral over a simulated link with a 7.5 ms connection interval,
+ *      with window and ack handling as in BLEEndPoint, and the simulation
+ *      reports KB/s across ATT MTUs, receive windows and the number of GATT
+ *      operations the platform lets a side keep in flight.
+ *
+ *      Usage: BtpThroughputBenchmark [<messages per run>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ble/BtpEngine.h>
+#include <support/CHIPMem.h>
+#include <system/SystemPacketBuffer.h>
+
+using namespace chip;
+using namespace chip::Ble;
+using namespace chip::System;
+
+namespace {
+
+constexpr uint16_t kMessageSize          = 1000;
+constexpr uint32_t kDefaultMessages      = 50;
+constexpr uint32_t kConnectionIntervalUs = 7500;
+
+void FillMessage(PacketBuffer * buf, uint16_t length, uint8_t seed)
+{
+    uint8_t * p = buf->Start();
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        p[i] = static_cast<uint8_t>(seed + i);
+    }
+    buf->SetDataLength(length);
+}
+
+bool CheckMessage(const PacketBuffer * buf, uint16_t length, uint8_t seed)
+{
+    const uint8_t * p = buf->Start();
+
+    if (buf->DataLength() != length || buf->Next() != nullptr)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        if (p[i] != static_cast<uint8_t>(seed + i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  One side of a simulated BTP connection. Window and ack handling follow BLEEndPoint: data goes out only while the
+ *  peer's window is open, keeping its last slot for fragments that carry an ack, and a receiver whose window falls to
+ *  the immediate ack threshold acks everything received so far in one stand-alone ack.
+ */
+struct SimulatedPeer
+{
+    static constexpr uint8_t kMaxInFlight           = 8;
+    static constexpr uint8_t kImmediateAckThreshold = 1; // BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD
+    static constexpr uint8_t kNoAckSendThreshold    = 1; // BTP_WINDOW_NO_ACK_SEND_THRESHOLD
+
+    BtpEngine engine;
+    uint8_t maxWindow;
+    uint8_t localWindow;
+    uint8_t remoteWindow;
+    bool ackDue;
+    PacketBuffer * arriving[kMaxInFlight];
+    uint8_t arrivingCount;
+
+    void Init(bool isCentral, uint8_t window)
+    {
+        engine.Init(nullptr, !isCentral);
+        maxWindow     = window;
+        localWindow   = window;
+        remoteWindow  = window;
+        ackDue        = false;
+        arrivingCount = 0;
+    }
+
+    // Sends a GATT operation's worth of data to the peer, to arrive at the end of the current connection interval.
+    bool Transmit(SimulatedPeer & peer, const PacketBuffer * fragment)
+    {
+        PacketBuffer * buf = PacketBuffer::New();
+
+        if (buf == nullptr)
+        {
+            return false;
+        }
+
+        memcpy(buf->Start(), fragment->Start(), fragment->DataLength());
+        buf->SetDataLength(fragment->DataLength());
+        peer.arriving[peer.arrivingCount++] = buf;
+        remoteWindow--;
+        return true;
+    }
+
+    bool CanSendData(bool piggybackAck) const
+    {
+        return remoteWindow > kNoAckSendThreshold || (remoteWindow > 0 && piggybackAck);
+    }
+
+    // Processes fragments that arrived this interval; returns the number of bytes of whole messages reassembled,
+    // or -1 on error.
+    int32_t Receive()
+    {
+        int32_t received = 0;
+
+        for (uint8_t i = 0; i < arrivingCount; i++)
+        {
+            SequenceNumber_t ack;
+            bool didReceiveAck;
+
+            if (engine.HandleCharacteristicReceived(arriving[i], ack, didReceiveAck) != BLE_NO_ERROR)
+            {
+                received = -1;
+                continue;
+            }
+            localWindow--;
+
+            if (didReceiveAck)
+            {
+                remoteWindow = static_cast<uint8_t>(ack + maxWindow - engine.GetNewestUnackedSentSequenceNumber());
+            }
+            if (engine.HasUnackedData() && localWindow <= kImmediateAckThreshold)
+            {
+                ackDue = true;
+            }
+
+            if (engine.RxState() == BtpEngine::kState_Complete)
+            {
+                PacketBuffer * msg = engine.RxPacket();
+
+                engine.ClearRxPacket();
+                if (received >= 0)
+                {
+                    received = CheckMessage(msg, kMessageSize, static_cast<uint8_t>(kMessageSize)) ? received + msg->DataLength()
+                                                                                                 : -1;
+                }
+                PacketBuffer::Free(msg);
+            }
+        }
+        arrivingCount = 0;
+
+        return received;
+    }
+
+    void Shutdown()
+    {
+        for (uint8_t i = 0; i < arrivingCount; i++)
+        {
+            PacketBuffer::Free(arriving[i]);
+        }
+        if (engine.RxPacket() != nullptr)
+        {
+            PacketBuffer::Free(engine.RxPacket());
+        }
+        if (engine.TxPacket() != nullptr)
+        {
+            PacketBuffer::Free(engine.TxPacket());
+        }
+    }
+};
+
+constexpr uint8_t SimulatedPeer::kMaxInFlight;
+constexpr uint8_t SimulatedPeer::kImmediateAckThreshold;
+constexpr uint8_t SimulatedPeer::kNoAckSendThreshold;
+
+/**
+ *  Streams messages from central to peripheral and returns the number of connection intervals it took, or 0 on error.
+ *  In each interval either side may start up to inFlight GATT operations, which reach the other side at its end.
+ */
+uint32_t SimulateTransfer(uint16_t mtu, uint8_t window, uint8_t inFlight, uint32_t messages)
+{
+    SimulatedPeer central;
+    SimulatedPeer peripheral;
+    uint32_t sent      = 0;
+    uint64_t received  = 0;
+    uint32_t intervals = 0;
+    bool failed        = false;
+
+    central.Init(true, window);
+    peripheral.Init(false, window);
+    central.engine.SetTxFragmentSize(BtpEngine::FragmentSizeForMtu(mtu));
+    peripheral.engine.SetRxFragmentSize(BtpEngine::FragmentSizeForMtu(mtu));
+
+    while (received < static_cast<uint64_t>(messages) * kMessageSize && !failed && intervals < messages * 1000)
+    {
+        intervals++;
+
+        // Central pipelines data fragments, piggybacking acks for the peripheral's stand-alone acks.
+        for (uint8_t op = 0; op < inFlight; op++)
+        {
+            const bool piggybackAck = central.engine.HasUnackedData();
+            PacketBuffer * msg      = nullptr;
+
+            if (!central.CanSendData(piggybackAck))
+            {
+                break;
+            }
+            if (central.engine.TxState() == BtpEngine::kState_Idle)
+            {
+                if (sent == messages)
+                {
+                    break;
+                }
+                msg = PacketBuffer::New();
+                if (msg == nullptr)
+                {
+                    failed = true;
+                    break;
+                }
+                FillMessage(msg, kMessageSize, static_cast<uint8_t>(kMessageSize));
+                sent++;
+            }
+            if (!central.engine.HandleCharacteristicSend(msg, piggybackAck))
+            {
+                PacketBuffer::Free(msg);
+                failed = true;
+                break;
+            }
+            if (piggybackAck)
+            {
+                central.localWindow = central.maxWindow;
+            }
+            failed = !central.Transmit(peripheral, central.engine.TxPacket());
+
+            if (central.engine.TxState() == BtpEngine::kState_Complete)
+            {
+                PacketBuffer::Free(central.engine.TxPacket());
+                central.engine.ClearTxPacket();
+            }
+            if (failed)
+            {
+                break;
+            }
+        }
+
+        // Peripheral has no data of its own, so it acks with a single coalesced stand-alone ack.
+        if (!failed && peripheral.ackDue && peripheral.remoteWindow > 0)
+        {
+            PacketBuffer * ack = PacketBuffer::New();
+
+            failed = (ack == nullptr || peripheral.engine.EncodeStandAloneAck(ack) != BLE_NO_ERROR ||
+                      !peripheral.Transmit(central, ack));
+            PacketBuffer::Free(ack);
+            peripheral.localWindow = peripheral.maxWindow;
+            peripheral.ackDue      = false;
+        }
+
+        const int32_t bytes = peripheral.Receive();
+
+        failed = failed || bytes < 0 || central.Receive() < 0;
+        received += static_cast<uint32_t>(bytes > 0 ? bytes : 0);
+    }
+
+    central.Shutdown();
+    peripheral.Shutdown();
+
+    return failed || received != static_cast<uint64_t>(messages) * kMessageSize ? 0 : intervals;
+}
+
+int Run(uint32_t messages)
+{
+    static const uint16_t kMtus[]   = { 23, 131, 185, 247, 517 };
+    static const uint8_t kWindows[] = { 3, 5, 8 };
+    int result                      = EXIT_SUCCESS;
+
+    printf("BTP throughput, %" PRIu32 " messages of %u bytes, %" PRIu32 " us connection interval\n", messages, kMessageSize,
+           kConnectionIntervalUs);
+
+    for (uint16_t mtu : kMtus)
+    {
+        for (uint8_t window : kWindows)
+        {
+            const uint8_t inFlightOptions[] = { 1, static_cast<uint8_t>(window - 1) };
+
+            for (uint8_t inFlight : inFlightOptions)
+            {
+                const uint32_t intervals = SimulateTransfer(mtu, window, inFlight, messages);
+
+                if (intervals == 0)
+                {
+                    fprintf(stderr, "Transfer failed: mtu %u, window %u, %u in flight\n", mtu, window, inFlight);
+                    result = EXIT_FAILURE;
+                    continue;
+                }
+
+                const uint64_t elapsedUs  = static_cast<uint64_t>(intervals) * kConnectionIntervalUs;
+                const uint64_t tenthsKBps = static_cast<uint64_t>(messages) * kMessageSize * 10000000 / elapsedUs / 1024;
+
+                printf("  mtu %3u (%3u byte fragments), window %u, %u in flight: %" PRIu64 ".%" PRIu64 " KB/s\n", mtu,
+                       BtpEngine::FragmentSizeForMtu(mtu), window, inFlight, tenthsKBps / 10, tenthsKBps % 10);
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    uint32_t messages = kDefaultMessages;
+    int result;
+
+    if (argc > 1)
+    {
+        messages = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || messages == 0)
+    {
+        fprintf(stderr, "Usage: %s [<messages per run>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize memory\n");
+        return EXIT_FAILURE;
+    }
+
+    result = Run(messages);
+
+    Platform::MemoryShutdown();
+
+    return result;
+}
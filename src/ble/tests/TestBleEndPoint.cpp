@@ -0,0 +1,628 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the BLE end point.  A
+ *      peripheral end point runs in a real BleLayer over a fake platform
+ *      delegate that holds on to each indication until the test confirms
+ *      it, while the test plays the central with a BTP engine of its own.
+ *
+ */
+
+#include "TestBleLayer.h"
+
+#include <ble/BLEEndPoint.h>
+#include <ble/BleLayer.h>
+#include <ble/BtpEngine.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Ble;
+using namespace chip::System;
+
+namespace {
+
+constexpr uint16_t kMtu        = 23; // Yields 20 byte fragments.
+constexpr uint8_t kWindowSize  = 3;
+constexpr uint8_t kMaxPending  = 8;
+constexpr uint32_t kMaxSteps   = 100;
+constexpr uint8_t kAckFlagOnly = BtpEngine::kHeaderFlag_FragmentAck; // Header flags of a stand-alone ack.
+
+// The central acks once its receive window is down to one slot, as BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD has it.
+constexpr uint8_t kPeerAckThreshold = kWindowSize - 1;
+
+BLE_CONNECTION_OBJECT const kConnection = (BLE_CONNECTION_OBJECT) 1;
+
+// The characteristics the central writes to and the peripheral indicates on, as a platform knows them.
+const ChipBleUUID kCharacteristicRx = { { 0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C, 0x42, 0x9F, 0x9D,
+                                          0x11 } };
+const ChipBleUUID kCharacteristicTx = { { 0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C, 0x42, 0x9F, 0x9D,
+                                          0x12 } };
+
+void FillMessage(PacketBuffer * buf, uint16_t length, uint8_t seed)
+{
+    uint8_t * p = buf->Start();
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        p[i] = static_cast<uint8_t>(seed + i);
+    }
+    buf->SetDataLength(length);
+}
+
+bool CheckMessage(const PacketBuffer * buf, uint16_t length, uint8_t seed)
+{
+    if (buf == nullptr || buf->DataLength() != length || buf->Next() != nullptr)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        if (buf->Start()[i] != static_cast<uint8_t>(seed + i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+PacketBuffer * CopyCharacteristic(const PacketBuffer * characteristic)
+{
+    PacketBuffer * buf = PacketBuffer::New();
+
+    if (buf != nullptr)
+    {
+        memcpy(buf->Start(), characteristic->Start(), characteristic->DataLength());
+        buf->SetDataLength(characteristic->DataLength());
+    }
+    return buf;
+}
+
+/**
+ *  Stands in for the platform: keeps each indication, and the reference the end point handed over with it, until the
+ *  test takes it to confirm it.
+ */
+class FakePlatformDelegate : public BlePlatformDelegate
+{
+public:
+    void Init() { mPendingCount = mPendingHead = 0; }
+
+    void Shutdown()
+    {
+        while (mPendingCount > 0)
+        {
+            PacketBuffer::Free(TakeOldest());
+        }
+    }
+
+    uint8_t PendingCount() const { return mPendingCount; }
+
+    const PacketBuffer * Oldest() const { return (mPendingCount > 0) ? mPending[mPendingHead] : nullptr; }
+
+    PacketBuffer * TakeOldest()
+    {
+        PacketBuffer * buf = mPending[mPendingHead];
+
+        mPendingHead = static_cast<uint8_t>((mPendingHead + 1) % kMaxPending);
+        mPendingCount--;
+        return buf;
+    }
+
+    bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId) override
+    {
+        return true;
+    }
+
+    bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId) override
+    {
+        return true;
+    }
+
+    bool CloseConnection(BLE_CONNECTION_OBJECT connObj) override { return true; }
+
+    uint16_t GetMTU(BLE_CONNECTION_OBJECT connObj) const override { return kMtu; }
+
+    bool SendIndication(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                        PacketBuffer * pBuf) override
+    {
+        if (mPendingCount == kMaxPending)
+        {
+            PacketBuffer::Free(pBuf);
+            return false;
+        }
+
+        mPending[(mPendingHead + mPendingCount) % kMaxPending] = pBuf;
+        mPendingCount++;
+        return true;
+    }
+
+    bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                          PacketBuffer * pBuf) override
+    {
+        // A peripheral never writes.
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                         PacketBuffer * pBuf) override
+    {
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    bool SendReadResponse(BLE_CONNECTION_OBJECT connObj, BLE_READ_REQUEST_CONTEXT requestContext, const ChipBleUUID * svcId,
+                          const ChipBleUUID * charId) override
+    {
+        return false;
+    }
+
+private:
+    PacketBuffer * mPending[kMaxPending];
+    uint8_t mPendingHead;
+    uint8_t mPendingCount;
+};
+
+class FakeApplicationDelegate : public BleApplicationDelegate
+{
+public:
+    void NotifyChipConnectionClosed(BLE_CONNECTION_OBJECT connObj) override {}
+};
+
+/**
+ *  A peripheral end point and the central it is connected to.
+ */
+struct TestContext
+{
+    System::Layer systemLayer;
+    BleLayer bleLayer;
+    FakePlatformDelegate platformDelegate;
+    FakeApplicationDelegate applicationDelegate;
+    BtpEngine peer;           // The central's BTP engine.
+    uint8_t peerUnacked;      // Characteristics the central received and has not acked yet.
+    BLEEndPoint * endPoint;   // The peripheral end point, once it accepted the connection.
+    PacketBuffer * received;  // Last message the end point received.
+    PacketBuffer * delivered; // Last message the central received.
+    bool closed;              // Whether the end point closed on its own.
+
+    static void HandleConnectionReceived(BLEEndPoint * endPoint)
+    {
+        TestContext * ctx = static_cast<TestContext *>(endPoint->mAppState);
+
+        ctx->endPoint                = endPoint;
+        endPoint->OnMessageReceived  = HandleMessageReceived;
+        endPoint->OnConnectionClosed = HandleConnectionClosed;
+    }
+
+    static void HandleMessageReceived(BLEEndPoint * endPoint, PacketBuffer * msg)
+    {
+        TestContext * ctx = static_cast<TestContext *>(endPoint->mAppState);
+
+        if (ctx->received != nullptr)
+        {
+            PacketBuffer::Free(ctx->received);
+        }
+        ctx->received = msg;
+    }
+
+    static void HandleConnectionClosed(BLEEndPoint * endPoint, BLE_ERROR err)
+    {
+        static_cast<TestContext *>(endPoint->mAppState)->closed = true;
+    }
+
+    /**
+     *  Connects the central to the peripheral end point: writes the capabilities request, subscribes, and confirms the
+     *  capabilities response.
+     */
+    bool Connect()
+    {
+        BleTransportCapabilitiesRequestMessage request;
+        BleTransportCapabilitiesResponseMessage response;
+        PacketBuffer * buf = PacketBuffer::New();
+
+        endPoint    = nullptr;
+        received    = nullptr;
+        delivered   = nullptr;
+        closed      = false;
+        peerUnacked = 0;
+        platformDelegate.Init();
+
+        if (buf == nullptr || systemLayer.Init(nullptr) != CHIP_SYSTEM_NO_ERROR ||
+            bleLayer.Init(&platformDelegate, &applicationDelegate, &systemLayer) != BLE_NO_ERROR)
+        {
+            PacketBuffer::Free(buf);
+            return false;
+        }
+
+        bleLayer.mAppState                = this;
+        bleLayer.OnChipBleConnectReceived = HandleConnectionReceived;
+
+        memset(&request, 0, sizeof(request));
+        request.mMtu        = kMtu;
+        request.mWindowSize = kWindowSize;
+        request.SetSupportedProtocolVersion(0, CHIP_BLE_TRANSPORT_PROTOCOL_MAX_SUPPORTED_VERSION);
+        if (request.Encode(buf) != BLE_NO_ERROR)
+        {
+            PacketBuffer::Free(buf);
+            return false;
+        }
+
+        bleLayer.HandleWriteReceived(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicRx, buf);
+        bleLayer.HandleSubscribeReceived(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicTx);
+
+        // The end point accepts the connection as soon as it indicates the capabilities response.
+        if (endPoint == nullptr || platformDelegate.PendingCount() != 1 ||
+            BleTransportCapabilitiesResponseMessage::Decode(*platformDelegate.Oldest(), response) != BLE_NO_ERROR ||
+            response.mWindowSize != kWindowSize)
+        {
+            return false;
+        }
+
+        PacketBuffer::Free(platformDelegate.TakeOldest());
+        bleLayer.HandleIndicationConfirmation(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicTx);
+
+        // The capabilities response takes sequence number 0, which the central has yet to ack.
+        peer.Init(nullptr, false);
+        peer.SetTxFragmentSize(response.mFragmentSize);
+        peer.SetRxFragmentSize(response.mFragmentSize);
+        peerUnacked = 1;
+
+        return !closed;
+    }
+
+    void Disconnect()
+    {
+        bleLayer.Shutdown();
+        platformDelegate.Shutdown();
+        if (peer.RxPacket() != nullptr)
+        {
+            PacketBuffer::Free(peer.RxPacket());
+        }
+        if (peer.TxPacket() != nullptr)
+        {
+            PacketBuffer::Free(peer.TxPacket());
+        }
+        if (received != nullptr)
+        {
+            PacketBuffer::Free(received);
+        }
+        if (delivered != nullptr)
+        {
+            PacketBuffer::Free(delivered);
+        }
+        systemLayer.Shutdown();
+    }
+
+    /**
+     *  Hands the oldest indication to the central, then confirms it to the end point. Returns the header flags of the
+     *  indication, and the ack it carried if any, or false if the central rejected it.
+     */
+    bool DeliverIndication(uint8_t & flags, bool & didReceiveAck, SequenceNumber_t & ack)
+    {
+        PacketBuffer * indication = platformDelegate.TakeOldest();
+        PacketBuffer * copy       = CopyCharacteristic(indication);
+
+        flags = indication->Start()[0];
+        PacketBuffer::Free(indication);
+
+        if (copy == nullptr || peer.HandleCharacteristicReceived(copy, ack, didReceiveAck) != BLE_NO_ERROR)
+        {
+            return false;
+        }
+        peerUnacked++;
+
+        if (peer.RxState() == BtpEngine::kState_Complete)
+        {
+            if (delivered != nullptr)
+            {
+                PacketBuffer::Free(delivered);
+            }
+            delivered = peer.RxPacket();
+            peer.ClearRxPacket();
+        }
+
+        bleLayer.HandleIndicationConfirmation(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicTx);
+        return true;
+    }
+
+    bool DeliverIndication()
+    {
+        uint8_t flags;
+        bool didReceiveAck;
+        SequenceNumber_t ack;
+
+        return DeliverIndication(flags, didReceiveAck, ack);
+    }
+
+    // Writes a stand-alone ack from the central.
+    bool WriteAck()
+    {
+        PacketBuffer * ack = PacketBuffer::New();
+
+        if (ack == nullptr || peer.EncodeStandAloneAck(ack) != BLE_NO_ERROR)
+        {
+            PacketBuffer::Free(ack);
+            return false;
+        }
+
+        peerUnacked = 0;
+        bleLayer.HandleWriteReceived(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicRx, ack);
+        return true;
+    }
+
+    /**
+     *  Writes the next fragment of msg from the central, or of the message it is sending if msg is nullptr, piggybacking
+     *  an ack if asked to. Takes ownership of msg.
+     */
+    bool WriteFragment(PacketBuffer * msg, bool sendAck)
+    {
+        if (!peer.HandleCharacteristicSend(msg, sendAck))
+        {
+            PacketBuffer::Free(msg);
+            return false;
+        }
+
+        PacketBuffer * fragment = CopyCharacteristic(peer.TxPacket());
+
+        if (peer.TxState() == BtpEngine::kState_Complete)
+        {
+            PacketBuffer::Free(peer.TxPacket());
+            peer.ClearTxPacket();
+        }
+        if (fragment == nullptr)
+        {
+            return false;
+        }
+
+        if (sendAck)
+        {
+            peerUnacked = 0;
+        }
+        bleLayer.HandleWriteReceived(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicRx, fragment);
+        return true;
+    }
+
+    /**
+     *  Delivers and confirms indications until the end point has none left in flight, acking them like an end point
+     *  would.
+     */
+    bool Flush()
+    {
+        for (uint32_t step = 0; platformDelegate.PendingCount() > 0; step++)
+        {
+            if (step == kMaxSteps || !DeliverIndication())
+            {
+                return false;
+            }
+            if (peerUnacked >= kPeerAckThreshold && !WriteAck())
+            {
+                return false;
+            }
+        }
+        return !closed;
+    }
+};
+
+void CheckMessageExchange(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    PacketBuffer * msg;
+
+    NL_TEST_ASSERT(inSuite, ctx.Connect());
+
+    // Peripheral to central: the end point fragments the message and paces it by the central's acks.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 200, 1);
+    NL_TEST_ASSERT(inSuite, ctx.endPoint != nullptr && ctx.endPoint->Send(msg) == BLE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.Flush());
+    NL_TEST_ASSERT(inSuite, ctx.delivered != nullptr && CheckMessage(ctx.delivered, 200, 1));
+
+    // Central to peripheral: the end point acks the fragments it receives.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 200, 2);
+
+    for (uint32_t step = 0; step < kMaxSteps && (step == 0 || ctx.peer.TxState() == BtpEngine::kState_InProgress); step++)
+    {
+        NL_TEST_ASSERT(inSuite, ctx.WriteFragment(step == 0 ? msg : nullptr, ctx.peer.HasUnackedData()));
+        NL_TEST_ASSERT(inSuite, ctx.Flush());
+    }
+    NL_TEST_ASSERT(inSuite, ctx.received != nullptr && CheckMessage(ctx.received, 200, 2));
+
+    NL_TEST_ASSERT(inSuite, !ctx.closed);
+    ctx.Disconnect();
+}
+
+/**
+ *  Each confirmation settles the oldest GATT operation in flight: confirming a message fragment leaves a stand-alone ack
+ *  sent after it in flight, so the end point holds off on the next stand-alone ack until the first one is confirmed.
+ */
+void CheckConfirmationsFollowOperations(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    PacketBuffer * msg;
+    uint8_t flags;
+    bool didReceiveAck;
+    SequenceNumber_t ack;
+
+    NL_TEST_ASSERT(inSuite, ctx.Connect());
+
+    // A confirmation for nothing in flight is ignored.
+    ctx.bleLayer.HandleIndicationConfirmation(kConnection, &CHIP_BLE_SVC_ID, &kCharacteristicTx);
+    NL_TEST_ASSERT(inSuite, !ctx.closed && ctx.platformDelegate.PendingCount() == 0);
+
+    // The central acks the capabilities response, opening the peripheral's window all the way.
+    NL_TEST_ASSERT(inSuite, ctx.WriteAck());
+
+    // The peripheral sends a single fragment message.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 10, 5);
+    NL_TEST_ASSERT(inSuite, ctx.endPoint->Send(msg) == BLE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 1);
+
+    // The central sends a message that closes the peripheral's receive window down to the immediate ack threshold.
+    // The stand-alone ack goes out once the platform can take it, next to the fragment or after its confirmation.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 30, 6);
+    NL_TEST_ASSERT(inSuite, ctx.WriteFragment(msg, false));
+    NL_TEST_ASSERT(inSuite, ctx.WriteFragment(nullptr, false));
+    NL_TEST_ASSERT(inSuite, ctx.received != nullptr && CheckMessage(ctx.received, 30, 6));
+
+    NL_TEST_ASSERT(inSuite, ctx.DeliverIndication(flags, didReceiveAck, ack));
+    NL_TEST_ASSERT(inSuite, flags != kAckFlagOnly);
+    NL_TEST_ASSERT(inSuite, ctx.delivered != nullptr && CheckMessage(ctx.delivered, 10, 5));
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 1);
+
+    // With the stand-alone ack still in flight, the central closes the peripheral's window once more. The next
+    // stand-alone ack waits for the confirmation of the first.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 30, 7);
+    NL_TEST_ASSERT(inSuite, ctx.WriteFragment(msg, false));
+    NL_TEST_ASSERT(inSuite, ctx.WriteFragment(nullptr, false));
+    NL_TEST_ASSERT(inSuite, ctx.received != nullptr && CheckMessage(ctx.received, 30, 7));
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 1);
+
+    NL_TEST_ASSERT(inSuite, ctx.DeliverIndication(flags, didReceiveAck, ack));
+    NL_TEST_ASSERT(inSuite, flags == kAckFlagOnly && didReceiveAck && ack == 2);
+
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 1);
+    NL_TEST_ASSERT(inSuite, ctx.DeliverIndication(flags, didReceiveAck, ack));
+    NL_TEST_ASSERT(inSuite, flags == kAckFlagOnly && didReceiveAck && ack == 4);
+
+    NL_TEST_ASSERT(inSuite, ctx.WriteAck());
+    NL_TEST_ASSERT(inSuite, ctx.Flush());
+
+    NL_TEST_ASSERT(inSuite, !ctx.closed);
+    ctx.Disconnect();
+}
+
+/**
+ *  When the peripheral's receive window falls to the immediate ack threshold while a message waits only on the
+ *  central's window, the ack rides on the next fragment of that message instead of costing a stand-alone ack.
+ */
+void CheckPiggybackedAck(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    PacketBuffer * msg;
+    uint8_t flags;
+    bool didReceiveAck;
+    SequenceNumber_t ack;
+
+    NL_TEST_ASSERT(inSuite, ctx.Connect());
+
+    // The peripheral sends the first fragment of a long message, which leaves the central's window with one slot, too
+    // few to send the next fragment without an ack.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 100, 3);
+    NL_TEST_ASSERT(inSuite, ctx.endPoint->Send(msg) == BLE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.DeliverIndication(flags, didReceiveAck, ack));
+    NL_TEST_ASSERT(inSuite, (flags & BtpEngine::kHeaderFlag_StartMessage) != 0);
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 0);
+
+    // The central sends a message of its own without acking.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 30, 4);
+    NL_TEST_ASSERT(inSuite, ctx.WriteFragment(msg, false));
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 0);
+    NL_TEST_ASSERT(inSuite, ctx.WriteFragment(nullptr, false));
+    NL_TEST_ASSERT(inSuite, ctx.received != nullptr && CheckMessage(ctx.received, 30, 4));
+
+    // The peripheral's window is at the threshold now: its next fragment carries the ack for the central's message.
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 1);
+    NL_TEST_ASSERT(inSuite, ctx.DeliverIndication(flags, didReceiveAck, ack));
+    NL_TEST_ASSERT(inSuite, (flags & BtpEngine::kHeaderFlag_ContinueMessage) != 0);
+    NL_TEST_ASSERT(inSuite, didReceiveAck && ack == 1);
+
+    // No stand-alone ack follows, and the rest of the message goes through.
+    NL_TEST_ASSERT(inSuite,
+                   ctx.platformDelegate.PendingCount() == 0 || ctx.platformDelegate.Oldest()->Start()[0] != kAckFlagOnly);
+    NL_TEST_ASSERT(inSuite, ctx.WriteAck());
+    NL_TEST_ASSERT(inSuite, ctx.Flush());
+    NL_TEST_ASSERT(inSuite, ctx.delivered != nullptr && CheckMessage(ctx.delivered, 100, 3));
+
+    NL_TEST_ASSERT(inSuite, !ctx.closed);
+    ctx.Disconnect();
+}
+
+/**
+ *  The end point hands the platform as many fragments as the central's window and
+ *  BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT allow before the first is confirmed, keeping the last window slot for a
+ *  fragment that carries an ack.
+ */
+void CheckPipelinedFragments(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint8_t kExpectedInFlight =
+        (BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT < kWindowSize - 1) ? BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT : kWindowSize - 1;
+    TestContext ctx;
+    PacketBuffer * msg;
+
+    NL_TEST_ASSERT(inSuite, ctx.Connect());
+    NL_TEST_ASSERT(inSuite, ctx.WriteAck());
+
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    FillMessage(msg, 100, 8);
+    NL_TEST_ASSERT(inSuite, ctx.endPoint->Send(msg) == BLE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == kExpectedInFlight);
+
+    // The second fragment is in flight once the first is confirmed, whether it went out with the first or after it.
+    NL_TEST_ASSERT(inSuite, ctx.DeliverIndication());
+    NL_TEST_ASSERT(inSuite, ctx.platformDelegate.PendingCount() == 1);
+
+    NL_TEST_ASSERT(inSuite, ctx.Flush());
+    NL_TEST_ASSERT(inSuite, ctx.delivered != nullptr && CheckMessage(ctx.delivered, 100, 8));
+
+    NL_TEST_ASSERT(inSuite, !ctx.closed);
+    ctx.Disconnect();
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("CheckMessageExchange", CheckMessageExchange),
+    NL_TEST_DEF("CheckConfirmationsFollowOperations", CheckConfirmationsFollowOperations),
+    NL_TEST_DEF("CheckPiggybackedAck", CheckPiggybackedAck),
+    NL_TEST_DEF("CheckPipelinedFragments", CheckPipelinedFragments),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestBleEndPoint()
+{
+    nlTestSuite theSuite = { "BleEndPoint", &sTests[0], NULL, NULL };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBleEndPoint)
@@ -24,5 +24,7 @@
 
 #pragma once
 
+int TestBleEndPoint();
 int TestBleErrorStr();
 int TestBleUUID();
+int TestBtpEngine();
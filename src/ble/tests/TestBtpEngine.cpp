@@ -0,0 +1,307 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests and a reassembly benchmark for the
+ *      BLE transfer protocol (BTP) engine.  Fragments travel between two
+ *      engines over a loopback link that, like a platform delegate, hands
+ *      each characteristic to the receiver in its own PacketBuffer.
+ *
+ */
+
+#include "TestBleLayer.h"
+
+#include <ble/BtpEngine.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Ble;
+using namespace chip::System;
+
+namespace {
+
+constexpr uint16_t kMessageSize = 1000;
+
+void FillMessage(PacketBuffer * buf, uint16_t length, uint8_t seed)
+{
+    uint8_t * p = buf->Start();
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        p[i] = static_cast<uint8_t>(seed + i);
+    }
+    buf->SetDataLength(length);
+}
+
+bool CheckMessage(const PacketBuffer * buf, uint16_t length, uint8_t seed)
+{
+    const uint8_t * p = buf->Start();
+
+    if (buf->DataLength() != length || buf->Next() != nullptr)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        if (p[i] != static_cast<uint8_t>(seed + i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  Stands in for the platform delegate and the radio: each fragment the sender produces is copied into a fresh
+ *  PacketBuffer, as BlueZ does when it reads a characteristic write, and handed to the receiver.
+ */
+class LoopbackLink
+{
+public:
+    void Init(uint8_t fragmentSize)
+    {
+        mSender.Init(nullptr, false);
+        mReceiver.Init(nullptr, true);
+        mSender.SetTxFragmentSize(fragmentSize);
+        mReceiver.SetRxFragmentSize(fragmentSize);
+        mFragments = 0;
+    }
+
+    void Shutdown()
+    {
+        if (mReceiver.RxPacket() != nullptr)
+        {
+            PacketBuffer::Free(mReceiver.RxPacket());
+        }
+    }
+
+    // Sends msg and returns the reassembled message, or nullptr on error. Takes ownership of msg.
+    PacketBuffer * Transfer(PacketBuffer * msg)
+    {
+        PacketBuffer * received = nullptr;
+
+        VerifyOrExit(mSender.HandleCharacteristicSend(msg, false), PacketBuffer::Free(msg));
+
+        while (true)
+        {
+            VerifyOrExit(Deliver(mSender.TxPacket()), received = nullptr);
+
+            if (mSender.TxState() == BtpEngine::kState_Complete)
+            {
+                break;
+            }
+            VerifyOrExit(mSender.HandleCharacteristicSend(nullptr, false), received = nullptr);
+        }
+
+        VerifyOrExit(mReceiver.RxState() == BtpEngine::kState_Complete, received = nullptr);
+        received = mReceiver.RxPacket();
+        mReceiver.ClearRxPacket();
+
+    exit:
+        if (mSender.TxPacket() != nullptr)
+        {
+            PacketBuffer::Free(mSender.TxPacket());
+            mSender.ClearTxPacket();
+        }
+        return received;
+    }
+
+    // Like Transfer, but the sender's single fragment is handed to the receiver as is; returns that buffer.
+    PacketBuffer * TransferInPlace(PacketBuffer * msg)
+    {
+        SequenceNumber_t ack;
+        bool didReceiveAck;
+
+        if (!mSender.HandleCharacteristicSend(msg, false) || mSender.TxState() != BtpEngine::kState_Complete)
+        {
+            PacketBuffer::Free(msg);
+            return nullptr;
+        }
+        mSender.ClearTxPacket();
+
+        if (mReceiver.HandleCharacteristicReceived(msg, ack, didReceiveAck) != BLE_NO_ERROR ||
+            mReceiver.RxState() != BtpEngine::kState_Complete)
+        {
+            return nullptr;
+        }
+
+        PacketBuffer * received = mReceiver.RxPacket();
+        mReceiver.ClearRxPacket();
+        return received;
+    }
+
+    uint32_t Fragments() const { return mFragments; }
+
+private:
+    bool Deliver(const PacketBuffer * fragment)
+    {
+        SequenceNumber_t ack;
+        bool didReceiveAck;
+        PacketBuffer * buf = PacketBuffer::New();
+
+        if (buf == nullptr)
+        {
+            return false;
+        }
+        memcpy(buf->Start(), fragment->Start(), fragment->DataLength());
+        buf->SetDataLength(fragment->DataLength());
+        mFragments++;
+
+        return mReceiver.HandleCharacteristicReceived(buf, ack, didReceiveAck) == BLE_NO_ERROR;
+    }
+
+    BtpEngine mSender;
+    BtpEngine mReceiver;
+    uint32_t mFragments;
+};
+
+void CheckSingleFragmentIsAdopted(nlTestSuite * inSuite, void * inContext)
+{
+    LoopbackLink link;
+    PacketBuffer * msg = PacketBuffer::New();
+
+    NL_TEST_ASSERT(inSuite, msg != nullptr);
+    link.Init(244);
+
+    FillMessage(msg, 200, 7);
+    PacketBuffer * received = link.TransferInPlace(msg);
+
+    // The characteristic buffer itself becomes the reassembled message; its payload is never copied.
+    NL_TEST_ASSERT(inSuite, received == msg);
+    NL_TEST_ASSERT(inSuite, received != nullptr && CheckMessage(received, 200, 7));
+
+    if (received != nullptr)
+    {
+        PacketBuffer::Free(received);
+    }
+    link.Shutdown();
+}
+
+void CheckMultiFragmentReassembly(nlTestSuite * inSuite, void * inContext)
+{
+    static const uint8_t kFragmentSizes[] = { 20, 23, 64, 128, 185, 244 };
+    static const uint16_t kLengths[]      = { 1, 15, 16, 17, 100, 500, kMessageSize };
+
+    for (uint8_t fragmentSize : kFragmentSizes)
+    {
+        LoopbackLink link;
+
+        link.Init(fragmentSize);
+
+        for (uint16_t length : kLengths)
+        {
+            PacketBuffer * msg = PacketBuffer::New();
+
+            NL_TEST_ASSERT(inSuite, msg != nullptr);
+            FillMessage(msg, length, static_cast<uint8_t>(length));
+
+            PacketBuffer * received = link.Transfer(msg);
+
+            NL_TEST_ASSERT(inSuite, received != nullptr && CheckMessage(received, length, static_cast<uint8_t>(length)));
+            if (received != nullptr)
+            {
+                PacketBuffer::Free(received);
+            }
+        }
+
+        link.Shutdown();
+    }
+}
+
+/**
+ *  Reassembles messages over the loopback link at fragment sizes from the 20 byte default up to the 244 bytes a
+ *  251 byte LE data length allows. Only correctness is asserted; the rates are informative.
+ */
+void CheckReassemblyThroughput(nlTestSuite * inSuite, void * inContext)
+{
+    static const uint8_t kFragmentSizes[] = { 20, 64, 128, 185, 244 };
+    constexpr uint32_t kMessages          = 2000;
+
+    for (uint8_t fragmentSize : kFragmentSizes)
+    {
+        LoopbackLink link;
+        uint32_t failures = 0;
+
+        link.Init(fragmentSize);
+
+        const uint64_t start = System::Platform::Layer::GetClock_MonotonicHiRes();
+
+        for (uint32_t i = 0; i < kMessages; i++)
+        {
+            PacketBuffer * msg = PacketBuffer::New();
+
+            if (msg == nullptr)
+            {
+                failures++;
+                continue;
+            }
+            FillMessage(msg, kMessageSize, static_cast<uint8_t>(i));
+
+            PacketBuffer * received = link.Transfer(msg);
+
+            if (received == nullptr || !CheckMessage(received, kMessageSize, static_cast<uint8_t>(i)))
+            {
+                failures++;
+            }
+            if (received != nullptr)
+            {
+                PacketBuffer::Free(received);
+            }
+        }
+
+        const uint64_t elapsedUs = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+        NL_TEST_ASSERT(inSuite, failures == 0);
+        link.Shutdown();
+
+        printf("BTP reassembly, %3u byte fragments: %" PRIu32 " fragments, %" PRIu64 " ns/fragment, %" PRIu64 " KB/s\n",
+               fragmentSize, link.Fragments(), elapsedUs * 1000 / (link.Fragments() ? link.Fragments() : 1),
+               static_cast<uint64_t>(kMessages) * kMessageSize * 1000000 / (elapsedUs ? elapsedUs : 1) / 1024);
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("CheckSingleFragmentIsAdopted", CheckSingleFragmentIsAdopted),
+    NL_TEST_DEF("CheckMultiFragmentReassembly", CheckMultiFragmentReassembly),
+    NL_TEST_DEF("CheckReassemblyThroughput", CheckReassemblyThroughput),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestBtpEngine()
+{
+    nlTestSuite theSuite = { "BtpEngine", &sTests[0], NULL, NULL };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBtpEngine)
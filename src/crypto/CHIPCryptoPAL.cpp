@@ -21,12 +21,205 @@
  */
 
 #include "CHIPCryptoPAL.h"
+#include <core/CHIPConfig.h>
 #include <string.h>
 #include <support/CodeUtils.h>
+#include <support/RandUtils.h>
+#include <system/SystemConfig.h>
+
+#if CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+#if !CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#error "CHIP_CONFIG_RANDOM_POOL_SIZE requires CHIP_SYSTEM_CONFIG_POSIX_LOCKING"
+#endif
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_CONFIG_RANDOM_POOL_SIZE > 0
 
 namespace chip {
+
+#if CHIP_CONFIG_RAND_UTILS_DRBG
+bool GetRandBytesFromDRBG(uint8_t * buf, size_t len)
+{
+    return Crypto::DRBG_get_pooled_bytes(buf, len) == CHIP_NO_ERROR;
+}
+#endif // CHIP_CONFIG_RAND_UTILS_DRBG
+
 namespace Crypto {
 
+// Implemented by the crypto backend.  DRBG_get_bytes() and DRBG_reseed() wrap them so that, when the pool is
+// enabled, every call into the DRBG holds the same lock.
+CHIP_ERROR DRBG_get_bytes_impl(uint8_t * out_buffer, size_t out_length);
+CHIP_ERROR DRBG_reseed_impl();
+
+#if CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+
+namespace {
+
+struct RandomPool
+{
+    uint8_t mBytes[CHIP_CONFIG_RANDOM_POOL_SIZE];
+    size_t mAvailable;    // The unused bytes are the first mAvailable bytes of mBytes.
+    uint32_t mGeneration; // Value of sForkGeneration when the pool was filled.
+};
+
+thread_local RandomPool sPool;
+
+// Serializes calls into the DRBG, which not every backend makes thread-safe.
+pthread_mutex_t sDRBGLock        = PTHREAD_MUTEX_INITIALIZER;
+pthread_once_t sAtForkRegistered = PTHREAD_ONCE_INIT;
+uint32_t sRefillsSinceReseed     = 0;
+std::atomic<uint32_t> sForkGeneration(0);
+
+void LockDRBGForFork()
+{
+    pthread_mutex_lock(&sDRBGLock);
+}
+
+void UnlockDRBGInParent()
+{
+    pthread_mutex_unlock(&sDRBGLock);
+}
+
+void UnlockDRBGInChild()
+{
+    // The child must not hand out bytes the parent may also hand out: drop the pools and reseed the
+    // DRBG before its next use.
+    sForkGeneration.fetch_add(1, std::memory_order_relaxed);
+    sRefillsSinceReseed = CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL;
+    pthread_mutex_unlock(&sDRBGLock);
+}
+
+void RegisterAtForkHandlers()
+{
+    pthread_atfork(LockDRBGForFork, UnlockDRBGInParent, UnlockDRBGInChild);
+}
+
+CHIP_ERROR DrawFromDRBG(uint8_t * out_buffer, size_t out_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    pthread_once(&sAtForkRegistered, RegisterAtForkHandlers);
+    pthread_mutex_lock(&sDRBGLock);
+
+    if (sRefillsSinceReseed >= CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL)
+    {
+        error = DRBG_reseed_impl();
+        SuccessOrExit(error);
+        sRefillsSinceReseed = 0;
+    }
+    sRefillsSinceReseed++;
+
+    error = DRBG_get_bytes_impl(out_buffer, out_length);
+
+exit:
+    pthread_mutex_unlock(&sDRBGLock);
+    return error;
+}
+
+} // namespace
+
+CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, size_t out_length)
+{
+    return DrawFromDRBG(out_buffer, out_length);
+}
+
+CHIP_ERROR DRBG_reseed()
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    pthread_once(&sAtForkRegistered, RegisterAtForkHandlers);
+    pthread_mutex_lock(&sDRBGLock);
+
+    error = DRBG_reseed_impl();
+    if (error == CHIP_NO_ERROR)
+    {
+        sRefillsSinceReseed = 0;
+    }
+
+    pthread_mutex_unlock(&sDRBGLock);
+    return error;
+}
+
+CHIP_ERROR DRBG_get_pooled_bytes(uint8_t * out_buffer, size_t out_length)
+{
+    CHIP_ERROR error    = CHIP_NO_ERROR;
+    RandomPool & pool   = sPool;
+    uint32_t generation = 0;
+
+    VerifyOrExit(out_buffer != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(out_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    pthread_once(&sAtForkRegistered, RegisterAtForkHandlers);
+
+    generation = sForkGeneration.load(std::memory_order_relaxed);
+    if (pool.mGeneration != generation)
+    {
+        ClearSecretData(pool.mBytes, sizeof(pool.mBytes));
+        pool.mAvailable  = 0;
+        pool.mGeneration = generation;
+    }
+
+    // Requests that would drain most of the pool are not worth buffering.
+    if (out_length > sizeof(pool.mBytes) / 2)
+    {
+        ExitNow(error = DrawFromDRBG(out_buffer, out_length));
+    }
+
+    if (out_length > pool.mAvailable)
+    {
+        error = DrawFromDRBG(pool.mBytes, sizeof(pool.mBytes));
+        SuccessOrExit(error);
+        pool.mAvailable = sizeof(pool.mBytes);
+    }
+
+    pool.mAvailable -= out_length;
+    memcpy(out_buffer, &pool.mBytes[pool.mAvailable], out_length);
+    ClearSecretData(&pool.mBytes[pool.mAvailable], static_cast<uint32_t>(out_length));
+
+exit:
+    return error;
+}
+
+#else // CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+
+CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, size_t out_length)
+{
+    return DRBG_get_bytes_impl(out_buffer, out_length);
+}
+
+CHIP_ERROR DRBG_reseed()
+{
+    return DRBG_reseed_impl();
+}
+
+CHIP_ERROR DRBG_get_pooled_bytes(uint8_t * out_buffer, size_t out_length)
+{
+    return DRBG_get_bytes_impl(out_buffer, out_length);
+}
+
+#endif // CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+
+CHIP_ERROR ECDSA_validate_msg_signatures(const P256ECDSASignedMessage * messages, size_t count, size_t & out_failed_index)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    size_t i         = 0;
+
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (i = 0; i < count; i++)
+    {
+        const P256ECDSASignedMessage & message = messages[i];
+
+        VerifyOrExit(message.mPublicKey != nullptr && message.mSignature != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        error = message.mPublicKey->ECDSA_validate_msg_signature(message.mMsg, message.mMsgLength, *message.mSignature);
+        SuccessOrExit(error);
+    }
+
+exit:
+    out_failed_index = i;
+    return error;
+}
+
 CHIP_ERROR Spake2p::InternalHash(const uint8_t * in, size_t in_len)
 {
     CHIP_ERROR error = CHIP_ERROR_INTERNAL;
@@ -204,7 +397,7 @@ CHIP_ERROR Spake2p::ComputeRoundOne(uint8_t * out, size_t * out_len)
     VerifyOrExit(MN != nullptr, error = CHIP_ERROR_INTERNAL);
     VerifyOrExit(XY != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    error = PointAddMul(XY, G, xy, MN, w0);
+    error = PointAddMulMN(XY, G, xy, MN, w0, false);
     VerifyOrExit(error == CHIP_NO_ERROR, error = CHIP_ERROR_INTERNAL);
 
     error = PointWrite(XY, out, *out_len);
@@ -270,10 +463,7 @@ CHIP_ERROR Spake2p::ComputeRoundTwo(const uint8_t * in, size_t in_len, uint8_t *
     error = FEMul(tempbn, xy, w0);
     VerifyOrExit(error == CHIP_NO_ERROR, error = CHIP_ERROR_INTERNAL);
 
-    error = PointInvert(MN);
-    VerifyOrExit(error == CHIP_NO_ERROR, error = CHIP_ERROR_INTERNAL);
-
-    error = PointAddMul(Z, XY, xy, MN, tempbn);
+    error = PointAddMulMN(Z, XY, xy, MN, tempbn, true);
     VerifyOrExit(error == CHIP_NO_ERROR, error = CHIP_ERROR_INTERNAL);
 
     error = PointCofactorMul(Z);
@@ -283,7 +473,7 @@ CHIP_ERROR Spake2p::ComputeRoundTwo(const uint8_t * in, size_t in_len, uint8_t *
     {
         error = FEMul(tempbn, w1, w0);
         VerifyOrExit(error == CHIP_NO_ERROR, error = CHIP_ERROR_INTERNAL);
-        error = PointAddMul(V, XY, w1, MN, tempbn);
+        error = PointAddMulMN(V, XY, w1, MN, tempbn, true);
         VerifyOrExit(error == CHIP_NO_ERROR, error = CHIP_ERROR_INTERNAL);
     }
     else if (role == CHIP_SPAKE2P_ROLE::VERIFIER)
@@ -54,9 +54,10 @@ const size_t kP256_PublicKey_Length  = 65;
  * in a public interface file. The validity of these sizes is verified by static_assert in
  * the implementation files.
  */
-const size_t kMAX_Spake2p_Context_Size     = 1024;
-const size_t kMAX_Hash_SHA256_Context_Size = 256;
-const size_t kMAX_P256Keypair_Context_Size = 512;
+const size_t kMAX_Spake2p_Context_Size       = 1536;
+const size_t kMAX_Hash_SHA256_Context_Size   = 256;
+const size_t kMAX_P256Keypair_Context_Size   = 512;
+const size_t kMAX_P256PublicKey_Context_Size = 160;
 
 /**
  * Spake2+ parameters for P256
@@ -160,9 +161,31 @@ typedef CapacityBoundBuffer<kMax_ECDSA_Signature_Length> P256ECDSASignature;
 
 typedef CapacityBoundBuffer<kMax_ECDH_Secret_Length> P256ECDHDerivedSecret;
 
+struct P256PublicKeyContext
+{
+    uint8_t mBytes[kMAX_P256PublicKey_Context_Size];
+};
+
+/**
+ * A P-256 public key in uncompressed form.
+ *
+ * A key that validates many signatures can be parsed once with ParseKey(); validations then
+ * reuse the parsed form until the key bytes change.  Validation never modifies the key, so a
+ * parsed key may validate from several threads at once, but not while ParseKey() runs.
+ */
 class P256PublicKey : public ECPKey<P256ECDSASignature>
 {
 public:
+    P256PublicKey() {}
+    P256PublicKey(const P256PublicKey & other) { memcpy(bytes, other.bytes, sizeof(bytes)); }
+    ~P256PublicKey();
+
+    P256PublicKey & operator=(const P256PublicKey & other)
+    {
+        memmove(bytes, other.bytes, sizeof(bytes));
+        return *this;
+    }
+
     SupportedECPKeyTypes Type() const override { return SupportedECPKeyTypes::ECP256R1; }
     size_t Length() const override { return kP256_PublicKey_Length; }
     operator uint8_t *() override { return bytes; }
@@ -173,10 +196,47 @@ public:
     CHIP_ERROR ECDSA_validate_hash_signature(const uint8_t * hash, size_t hash_length,
                                              const P256ECDSASignature & signature) const override;
 
+    /** @brief Parse and check the key bytes, unless the parsed form of the current ones is already kept.
+     * Validating with a key that was not parsed, or whose bytes changed since, parses it for that call only.
+     * @return Returns a CHIP_ERROR if the bytes are not a valid key, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR ParseKey();
+
 private:
+    /** @brief Returns true if mContext holds the parsed form of the current key bytes.
+     **/
+    bool IsParsed() const;
+
+    P256PublicKeyContext mContext;
     uint8_t bytes[kP256_PublicKey_Length];
+    bool mContextInitialized = false;
 };
 
+/**
+ * A message signature to be checked by ECDSA_validate_msg_signatures().
+ */
+struct P256ECDSASignedMessage
+{
+    const P256PublicKey * mPublicKey;
+    const uint8_t * mMsg;
+    size_t mMsgLength;
+    const P256ECDSASignature * mSignature;
+};
+
+/**
+ * @brief Validate a batch of ECDSA message signatures.
+ *
+ * The messages may be signed by different keys.  Keys that were parsed with P256PublicKey::ParseKey()
+ * beforehand are not parsed again for each message.
+ *
+ * @param messages Signed messages to validate
+ * @param count Number of entries in messages
+ * @param out_failed_index Set to the index of the first message that failed validation, or to count if none did
+ * @return Returns CHIP_NO_ERROR if every signature is valid, otherwise the error for the first
+ * message that failed
+ **/
+CHIP_ERROR ECDSA_validate_msg_signatures(const P256ECDSASignedMessage * messages, size_t count, size_t & out_failed_index);
+
 template <typename PK, typename Secret, typename Sig>
 class ECPKeypair
 {
@@ -335,6 +395,73 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const uint8_t * key, size_t key_length, const uint8_t * iv,
                            size_t iv_length, uint8_t * plaintext);
 
+/**
+ * One message of an AES_CCM_encrypt_batch() call.  The fields have the meaning of the
+ * corresponding AES_CCM_encrypt() arguments.
+ */
+struct AES_CCM_EncryptMessage
+{
+    const uint8_t * mPlaintext;
+    size_t mPlaintextLength;
+    const uint8_t * mAAD;
+    size_t mAADLength;
+    const uint8_t * mIV;
+    size_t mIVLength;
+    uint8_t * mCiphertext;
+    uint8_t * mTag;
+};
+
+/**
+ * One message of an AES_CCM_decrypt_batch() call.  The fields have the meaning of the
+ * corresponding AES_CCM_decrypt() arguments.
+ */
+struct AES_CCM_DecryptMessage
+{
+    const uint8_t * mCiphertext;
+    size_t mCiphertextLength;
+    const uint8_t * mAAD;
+    size_t mAADLength;
+    const uint8_t * mTag;
+    const uint8_t * mIV;
+    size_t mIVLength;
+    uint8_t * mPlaintext;
+};
+
+/**
+ * @brief Encrypt a batch of messages under the same key using AES-CCM
+ *
+ * Equivalent to calling AES_CCM_encrypt() for each message, except that the cipher context and
+ * key schedule are set up once for the whole batch.
+ *
+ * @param messages Messages to encrypt
+ * @param count Number of entries in messages
+ * @param key Encryption key
+ * @param key_length Length of encryption key (in bytes)
+ * @param tag_length Length of the tag written for each message
+ * @param out_failed_index Set to the index of the first message that could not be encrypted, or to count if none
+ * @return Returns CHIP_NO_ERROR if every message was encrypted, otherwise the error for the first one that was not
+ * */
+CHIP_ERROR AES_CCM_encrypt_batch(const AES_CCM_EncryptMessage * messages, size_t count, const uint8_t * key, size_t key_length,
+                                 size_t tag_length, size_t & out_failed_index);
+
+/**
+ * @brief Decrypt a batch of messages under the same key using AES-CCM
+ *
+ * Equivalent to calling AES_CCM_decrypt() for each message, except that the cipher context and
+ * key schedule are set up once for the whole batch.  Processing stops at the first message that
+ * fails, so the caller may resume after it.
+ *
+ * @param messages Messages to decrypt
+ * @param count Number of entries in messages
+ * @param key Decryption key
+ * @param key_length Length of decryption key (in bytes)
+ * @param tag_length Length of the tag of each message
+ * @param out_failed_index Set to the index of the first message that could not be decrypted, or to count if none
+ * @return Returns CHIP_NO_ERROR if every message was decrypted, otherwise the error for the first one that was not
+ * */
+CHIP_ERROR AES_CCM_decrypt_batch(const AES_CCM_DecryptMessage * messages, size_t count, const uint8_t * key, size_t key_length,
+                                 size_t tag_length, size_t & out_failed_index);
+
 /**
  * @brief A function that implements SHA-256 hash
  * @param data The data to hash
@@ -393,6 +520,27 @@ CHIP_ERROR HKDF_SHA256(const uint8_t * secret, size_t secret_length, const uint8
  **/
 CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, size_t out_length);
 
+/**
+ * @brief Fills a buffer with random bytes from a per-thread pool of DRBG output
+ *
+ * Small requests are served from a buffer of CHIP_CONFIG_RANDOM_POOL_SIZE bytes that is refilled from
+ * DRBG_get_bytes() when it runs out, so frequent callers on different threads rarely reach the DRBG. Bytes are
+ * erased from the pool as they are handed out. Pools are discarded in the child after a fork, and the DRBG is
+ * reseeded then and every CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL refills. When the pool is disabled this is
+ * the same as DRBG_get_bytes().
+ *
+ * @param out_buffer Buffer to write random bytes into
+ * @param out_length Number of random bytes to generate
+ * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+ **/
+CHIP_ERROR DRBG_get_pooled_bytes(uint8_t * out_buffer, size_t out_length);
+
+/**
+ * @brief Reseeds the DRBG from its entropy sources
+ * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+ **/
+CHIP_ERROR DRBG_reseed();
+
 /** @brief Entropy callback function
  * @param data Callback-specific data pointer
  * @param output Output data to fill
@@ -634,6 +782,25 @@ public:
      **/
     virtual CHIP_ERROR PointAddMul(void * R, const void * P1, const void * fe1, const void * P2, const void * fe2) = 0;
 
+    /**
+     * @brief Scalar multiplication with addition by one of the fixed points, R = fe1 * P1 + fe2 * MN,
+     *        or R = fe1 * P1 - fe2 * MN when negate is set.
+     *
+     * @details MN must be the M or N point of this object, and neither it nor G is modified. Implementations
+     *          may use precomputed tables for the multiplications by G, M and N.
+     *
+     * @param R       Resultant point
+     * @param P1      Input point, which may be G
+     * @param fe1     Input field element.
+     * @param MN      The M or N point
+     * @param fe2     Input field element.
+     * @param negate  Subtract fe2 * MN instead of adding it
+     *
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    virtual CHIP_ERROR PointAddMulMN(void * R, const void * P1, const void * fe1, const void * MN, const void * fe2,
+                                     bool negate) = 0;
+
     /**
      * @brief Point inversion.
      *
@@ -819,6 +986,7 @@ public:
     CHIP_ERROR PointWrite(const void * R, uint8_t * out, size_t out_len) override;
     CHIP_ERROR PointMul(void * R, const void * P1, const void * fe1) override;
     CHIP_ERROR PointAddMul(void * R, const void * P1, const void * fe1, const void * P2, const void * fe2) override;
+    CHIP_ERROR PointAddMulMN(void * R, const void * P1, const void * fe1, const void * MN, const void * fe2, bool negate) override;
     CHIP_ERROR PointInvert(void * R) override;
     CHIP_ERROR PointCofactorMul(void * R) override;
     CHIP_ERROR PointIsValid(void * R) override;
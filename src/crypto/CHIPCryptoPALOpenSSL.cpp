@@ -278,6 +278,192 @@ exit:
     return error;
 }
 
+CHIP_ERROR AES_CCM_encrypt_batch(const AES_CCM_EncryptMessage * messages, size_t count, const uint8_t * key, size_t key_length,
+                                 size_t tag_length, size_t & out_failed_index)
+{
+    EVP_CIPHER_CTX * context = nullptr;
+    int bytesWritten         = 0;
+    size_t ciphertext_length = 0;
+    CHIP_ERROR error         = CHIP_NO_ERROR;
+    int result               = 1;
+    size_t i                 = 0;
+    size_t iv_length         = 0;
+
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(key != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    context = EVP_CIPHER_CTX_new();
+    VerifyOrExit(context != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in cipher
+    // 16 bytes key for AES-CCM-128
+    result = EVP_EncryptInit_ex(context, (key_length == 16) ? EVP_aes_128_ccm() : EVP_aes_256_ccm(), nullptr, nullptr, nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in tag length. Cast is safe because we checked _isValidTagLength.
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    for (i = 0; i < count; i++)
+    {
+        const AES_CCM_EncryptMessage & message = messages[i];
+
+        VerifyOrExit(message.mPlaintext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mPlaintextLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(CanCastTo<int>(message.mPlaintextLength), error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIV != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIVLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(CanCastTo<int>(message.mIVLength), error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mTag != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+        // Pass in key + iv for the first message, and again whenever the IV length changes since
+        // OpenSSL fixes it when the key is set.  Other messages only pass in a new iv.
+        if (message.mIVLength != iv_length)
+        {
+            // Cast is safe because we checked with CanCastTo.
+            result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(message.mIVLength), nullptr);
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+            result = EVP_EncryptInit_ex(context, nullptr, nullptr, Uint8::to_const_uchar(key), Uint8::to_const_uchar(message.mIV));
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+            iv_length = message.mIVLength;
+        }
+        else
+        {
+            result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(message.mIV));
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        }
+
+        // Pass in plain text length
+        result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, nullptr, static_cast<int>(message.mPlaintextLength));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in AAD
+        if (message.mAADLength > 0 && message.mAAD != nullptr)
+        {
+            VerifyOrExit(CanCastTo<int>(message.mAADLength), error = CHIP_ERROR_INVALID_ARGUMENT);
+            result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, Uint8::to_const_uchar(message.mAAD),
+                                       static_cast<int>(message.mAADLength));
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        }
+
+        // Encrypt
+        result = EVP_EncryptUpdate(context, Uint8::to_uchar(message.mCiphertext), &bytesWritten,
+                                   Uint8::to_const_uchar(message.mPlaintext), static_cast<int>(message.mPlaintextLength));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        VerifyOrExit(bytesWritten >= 0, error = CHIP_ERROR_INTERNAL);
+        ciphertext_length = static_cast<unsigned int>(bytesWritten);
+
+        // Finalize encryption
+        result = EVP_EncryptFinal_ex(context, message.mCiphertext + ciphertext_length, &bytesWritten);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Get tag
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_GET_TAG, static_cast<int>(tag_length), Uint8::to_uchar(message.mTag));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+exit:
+    if (context != nullptr)
+    {
+        EVP_CIPHER_CTX_free(context);
+        context = nullptr;
+    }
+
+    out_failed_index = i;
+    return error;
+}
+
+CHIP_ERROR AES_CCM_decrypt_batch(const AES_CCM_DecryptMessage * messages, size_t count, const uint8_t * key, size_t key_length,
+                                 size_t tag_length, size_t & out_failed_index)
+{
+    EVP_CIPHER_CTX * context = nullptr;
+    CHIP_ERROR error         = CHIP_NO_ERROR;
+    int bytesOutput          = 0;
+    int result               = 1;
+    size_t i                 = 0;
+    size_t iv_length         = 0;
+
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(key != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    context = EVP_CIPHER_CTX_new();
+    VerifyOrExit(context != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in cipher
+    // 16 bytes key for AES-CCM-128
+    result = EVP_DecryptInit_ex(context, (key_length == 16) ? EVP_aes_128_ccm() : EVP_aes_256_ccm(), nullptr, nullptr, nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    for (i = 0; i < count; i++)
+    {
+        const AES_CCM_DecryptMessage & message = messages[i];
+
+        VerifyOrExit(message.mCiphertext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mCiphertextLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(CanCastTo<int>(message.mCiphertextLength), error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mTag != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIV != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIVLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(CanCastTo<int>(message.mIVLength), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+        // Pass in expected tag
+        // Removing "const" from |tag| here should hopefully be safe as
+        // we're writing the tag, not reading.
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                     const_cast<void *>(static_cast<const void *>(message.mTag)));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in key + iv, or only iv when the IV length is unchanged; see AES_CCM_encrypt_batch().
+        if (message.mIVLength != iv_length)
+        {
+            result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(message.mIVLength), nullptr);
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+            result = EVP_DecryptInit_ex(context, nullptr, nullptr, Uint8::to_const_uchar(key), Uint8::to_const_uchar(message.mIV));
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+            iv_length = message.mIVLength;
+        }
+        else
+        {
+            result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(message.mIV));
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        }
+
+        // Pass in cipher text length
+        result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(message.mCiphertextLength));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in aad
+        if (message.mAADLength > 0 && message.mAAD != nullptr)
+        {
+            VerifyOrExit(CanCastTo<int>(message.mAADLength), error = CHIP_ERROR_INVALID_ARGUMENT);
+            result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, Uint8::to_const_uchar(message.mAAD),
+                                       static_cast<int>(message.mAADLength));
+            VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        }
+
+        // Pass in ciphertext. We wont get anything if validation fails.
+        result = EVP_DecryptUpdate(context, Uint8::to_uchar(message.mPlaintext), &bytesOutput,
+                                   Uint8::to_const_uchar(message.mCiphertext), static_cast<int>(message.mCiphertextLength));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+exit:
+    if (context != nullptr)
+    {
+        EVP_CIPHER_CTX_free(context);
+        context = nullptr;
+    }
+
+    out_failed_index = i;
+    return error;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
@@ -450,7 +636,7 @@ CHIP_ERROR add_entropy_source(entropy_source fn_source, void * p_source, size_t
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length)
+CHIP_ERROR DRBG_get_bytes_impl(uint8_t * out_buffer, const size_t out_length)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 0;
@@ -466,6 +652,11 @@ exit:
     return error;
 }
 
+CHIP_ERROR DRBG_reseed_impl()
+{
+    return (RAND_poll() == 1) ? CHIP_NO_ERROR : CHIP_ERROR_INTERNAL;
+}
+
 ECName MapECName(SupportedECPKeyTypes keyType)
 {
     switch (keyType)
@@ -477,22 +668,65 @@ ECName MapECName(SupportedECPKeyTypes keyType)
     }
 }
 
-static inline void from_EC_KEY(EC_KEY * key, P256KeypairContext * context)
+// The keypair keeps its EC_KEY together with an EVP_PKEY wrapping it, so that signing does not
+// have to build the EVP_PKEY again for every signature.
+struct OpenSSLP256Keypair
+{
+    EC_KEY * mECKey;
+    EVP_PKEY * mEVPKey;
+};
+
+static inline OpenSSLP256Keypair * to_keypair(P256KeypairContext * context)
 {
-    nlSTATIC_ASSERT_PRINT(sizeof(P256KeypairContext) >= sizeof(key), "Need more memory for EC_KEY");
-    *reinterpret_cast<EC_KEY **>(context->mBytes) = key;
+    nlSTATIC_ASSERT_PRINT(sizeof(P256KeypairContext) >= sizeof(OpenSSLP256Keypair), "Need more memory for OpenSSLP256Keypair");
+    return reinterpret_cast<OpenSSLP256Keypair *>(context->mBytes);
+}
+
+static inline const OpenSSLP256Keypair * to_const_keypair(const P256KeypairContext * context)
+{
+    nlSTATIC_ASSERT_PRINT(sizeof(P256KeypairContext) >= sizeof(OpenSSLP256Keypair), "Need more memory for OpenSSLP256Keypair");
+    return reinterpret_cast<const OpenSSLP256Keypair *>(context->mBytes);
+}
+
+// On success the context takes over the caller's reference to key.
+static CHIP_ERROR from_EC_KEY(EC_KEY * key, P256KeypairContext * context)
+{
+    CHIP_ERROR error    = CHIP_ERROR_INTERNAL;
+    EVP_PKEY * evp_pkey = EVP_PKEY_new();
+    int result          = 0;
+
+    VerifyOrExit(evp_pkey != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_PKEY_set1_EC_KEY(evp_pkey, key);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    to_keypair(context)->mECKey  = key;
+    to_keypair(context)->mEVPKey = evp_pkey;
+    evp_pkey                     = nullptr;
+    error                        = CHIP_NO_ERROR;
+
+exit:
+    if (evp_pkey != nullptr)
+    {
+        EVP_PKEY_free(evp_pkey);
+        evp_pkey = nullptr;
+    }
+    return error;
 }
 
 static inline EC_KEY * to_EC_KEY(P256KeypairContext * context)
 {
-    nlSTATIC_ASSERT_PRINT(sizeof(P256KeypairContext) >= sizeof(EC_KEY *), "Need more memory for EC_KEY");
-    return *reinterpret_cast<EC_KEY **>(context->mBytes);
+    return to_keypair(context)->mECKey;
 }
 
 static inline const EC_KEY * to_const_EC_KEY(const P256KeypairContext * context)
 {
-    nlSTATIC_ASSERT_PRINT(sizeof(P256KeypairContext) >= sizeof(EC_KEY *), "Need more memory for EC_KEY");
-    return *reinterpret_cast<const EC_KEY * const *>(context->mBytes);
+    return to_const_keypair(context)->mECKey;
+}
+
+static inline EVP_PKEY * to_EVP_PKEY(const P256KeypairContext * context)
+{
+    return to_const_keypair(context)->mEVPKey;
 }
 
 CHIP_ERROR P256Keypair::ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, P256ECDSASignature & out_signature)
@@ -503,7 +737,6 @@ CHIP_ERROR P256Keypair::ECDSA_sign_msg(const uint8_t * msg, const size_t msg_len
     int result             = 0;
     EVP_MD_CTX * context   = nullptr;
     int nid                = NID_undef;
-    EC_KEY * ec_key        = nullptr;
     EVP_PKEY * signing_key = nullptr;
     const EVP_MD * md      = nullptr;
     DigestType digest      = DigestType::SHA256;
@@ -517,15 +750,9 @@ CHIP_ERROR P256Keypair::ECDSA_sign_msg(const uint8_t * msg, const size_t msg_len
     md = _digestForType(digest);
     VerifyOrExit(md != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    ec_key = to_EC_KEY(&mKeypair);
-    VerifyOrExit(ec_key != nullptr, error = CHIP_ERROR_INTERNAL);
-
-    signing_key = EVP_PKEY_new();
+    signing_key = to_EVP_PKEY(&mKeypair);
     VerifyOrExit(signing_key != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    result = EVP_PKEY_set1_EC_KEY(signing_key, ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
     context = EVP_MD_CTX_create();
     VerifyOrExit(context != nullptr, error = CHIP_ERROR_INTERNAL);
 
@@ -547,18 +774,13 @@ CHIP_ERROR P256Keypair::ECDSA_sign_msg(const uint8_t * msg, const size_t msg_len
     SuccessOrExit(out_signature.SetLength(out_length));
 
 exit:
-    ec_key = nullptr;
+    signing_key = nullptr;
 
     if (context != nullptr)
     {
         EVP_MD_CTX_destroy(context);
         context = nullptr;
     }
-    if (signing_key != nullptr)
-    {
-        EVP_PKEY_free(signing_key);
-        signing_key = nullptr;
-    }
 
     if (error != CHIP_NO_ERROR)
     {
@@ -601,153 +823,211 @@ exit:
     return error;
 }
 
-CHIP_ERROR P256PublicKey::ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length,
-                                                       const P256ECDSASignature & signature) const
+// The parsed public key, along with the key bytes it was parsed from so that changes to them are noticed.
+struct OpenSSLP256PublicKey
 {
-    ERR_clear_error();
-    CHIP_ERROR error            = CHIP_ERROR_INTERNAL;
-    int nid                     = NID_undef;
-    const EVP_MD * md           = nullptr;
-    EC_KEY * ec_key             = nullptr;
-    EVP_PKEY * verification_key = nullptr;
-    EC_POINT * key_point        = nullptr;
-    EC_GROUP * ec_group         = nullptr;
-    int result                  = 0;
-    EVP_MD_CTX * md_context     = nullptr;
-    DigestType digest           = DigestType::SHA256;
+    uint8_t mEncoded[kP256_PublicKey_Length];
+    EC_KEY * mECKey;
+    EVP_PKEY * mEVPKey;
+};
 
-    VerifyOrExit(msg != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    nid = _nidForCurve(MapECName(Type()));
+static inline OpenSSLP256PublicKey * to_public_key(P256PublicKeyContext * context)
+{
+    nlSTATIC_ASSERT_PRINT(sizeof(P256PublicKeyContext) >= sizeof(OpenSSLP256PublicKey), "Need more memory for public key");
+    return reinterpret_cast<OpenSSLP256PublicKey *>(context->mBytes);
+}
+
+static inline const OpenSSLP256PublicKey * to_const_public_key(const P256PublicKeyContext * context)
+{
+    nlSTATIC_ASSERT_PRINT(sizeof(P256PublicKeyContext) >= sizeof(OpenSSLP256PublicKey), "Need more memory for public key");
+    return reinterpret_cast<const OpenSSLP256PublicKey *>(context->mBytes);
+}
+
+static void FreePublicKey(OpenSSLP256PublicKey * public_key)
+{
+    if (public_key->mEVPKey != nullptr)
+    {
+        EVP_PKEY_free(public_key->mEVPKey);
+        public_key->mEVPKey = nullptr;
+    }
+    if (public_key->mECKey != nullptr)
+    {
+        EC_KEY_free(public_key->mECKey);
+        public_key->mECKey = nullptr;
+    }
+}
+
+P256PublicKey::~P256PublicKey()
+{
+    if (mContextInitialized)
+    {
+        FreePublicKey(to_public_key(&mContext));
+    }
+}
+
+// Builds the EC_KEY and EVP_PKEY for the key bytes; on failure, the caller frees whatever was built.
+static CHIP_ERROR ReadPublicKey(const P256PublicKey & key, OpenSSLP256PublicKey * public_key)
+{
+    CHIP_ERROR error          = CHIP_ERROR_INTERNAL;
+    int nid                   = NID_undef;
+    int result                = 0;
+    EC_POINT * key_point      = nullptr;
+    const EC_GROUP * ec_group = nullptr;
+
+    nid = _nidForCurve(MapECName(key.Type()));
     VerifyOrExit(nid != NID_undef, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    md = _digestForType(digest);
-    VerifyOrExit(md != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    public_key->mECKey = EC_KEY_new_by_curve_name(nid);
+    VerifyOrExit(public_key->mECKey != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    ec_group = EC_GROUP_new_by_curve_name(nid);
+    ec_group = EC_KEY_get0_group(public_key->mECKey);
     VerifyOrExit(ec_group != nullptr, error = CHIP_ERROR_INTERNAL);
 
     key_point = EC_POINT_new(ec_group);
     VerifyOrExit(key_point != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    result = EC_POINT_oct2point(ec_group, key_point, Uint8::to_const_uchar(*this), Length(), nullptr);
+    result = EC_POINT_oct2point(ec_group, key_point, Uint8::to_const_uchar(key), key.Length(), nullptr);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    ec_key = EC_KEY_new_by_curve_name(nid);
-    VerifyOrExit(ec_key != nullptr, error = CHIP_ERROR_INTERNAL);
-
-    result = EC_KEY_set_public_key(ec_key, key_point);
+    result = EC_KEY_set_public_key(public_key->mECKey, key_point);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    result = EC_KEY_check_key(ec_key);
+    result = EC_KEY_check_key(public_key->mECKey);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    verification_key = EVP_PKEY_new();
-    VerifyOrExit(verification_key != nullptr, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_PKEY_set1_EC_KEY(verification_key, ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    md_context = EVP_MD_CTX_create();
-    VerifyOrExit(md_context != nullptr, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_DigestVerifyInit(md_context, nullptr, md, nullptr, verification_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    public_key->mEVPKey = EVP_PKEY_new();
+    VerifyOrExit(public_key->mEVPKey != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    result = EVP_DigestVerifyUpdate(md_context, Uint8::to_const_uchar(msg), msg_length);
+    result = EVP_PKEY_set1_EC_KEY(public_key->mEVPKey, public_key->mECKey);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    result = EVP_DigestVerifyFinal(md_context, Uint8::to_const_uchar(signature), signature.Length());
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INVALID_SIGNATURE);
     error = CHIP_NO_ERROR;
 
 exit:
-    _logSSLError();
-    if (ec_group != nullptr)
-    {
-        EC_GROUP_free(ec_group);
-        ec_group = nullptr;
-    }
     if (key_point != nullptr)
     {
         EC_POINT_clear_free(key_point);
         key_point = nullptr;
     }
-    if (md_context)
+    return error;
+}
+
+bool P256PublicKey::IsParsed() const
+{
+    const OpenSSLP256PublicKey * public_key = to_const_public_key(&mContext);
+
+    return mContextInitialized && public_key->mEVPKey != nullptr && memcmp(public_key->mEncoded, bytes, sizeof(bytes)) == 0;
+}
+
+CHIP_ERROR P256PublicKey::ParseKey()
+{
+    CHIP_ERROR error                  = CHIP_NO_ERROR;
+    OpenSSLP256PublicKey * public_key = to_public_key(&mContext);
+
+    VerifyOrExit(!IsParsed(), );
+
+    if (mContextInitialized)
     {
-        EVP_MD_CTX_destroy(md_context);
-        md_context = nullptr;
+        FreePublicKey(public_key);
     }
-    if (ec_key != nullptr)
+    else
     {
-        EC_KEY_free(ec_key);
-        ec_key = nullptr;
+        public_key->mECKey  = nullptr;
+        public_key->mEVPKey = nullptr;
+        mContextInitialized = true;
     }
-    if (verification_key != nullptr)
+
+    error = ReadPublicKey(*this, public_key);
+    SuccessOrExit(error);
+
+    memcpy(public_key->mEncoded, bytes, sizeof(bytes));
+
+exit:
+    if (error != CHIP_NO_ERROR)
     {
-        EVP_PKEY_free(verification_key);
-        verification_key = nullptr;
+        FreePublicKey(public_key);
     }
     return error;
 }
 
-CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, const size_t hash_length,
-                                                        const P256ECDSASignature & signature) const
+CHIP_ERROR P256PublicKey::ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length,
+                                                       const P256ECDSASignature & signature) const
 {
     ERR_clear_error();
-    CHIP_ERROR error     = CHIP_ERROR_INTERNAL;
-    int nid              = NID_undef;
-    EC_KEY * ec_key      = nullptr;
-    EC_POINT * key_point = nullptr;
-    EC_GROUP * ec_group  = nullptr;
-    int result           = 0;
+    CHIP_ERROR error        = CHIP_ERROR_INTERNAL;
+    const EVP_MD * md       = nullptr;
+    int result              = 0;
+    EVP_MD_CTX * md_context = nullptr;
+    DigestType digest       = DigestType::SHA256;
 
-    VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(hash_length == kSHA256_Hash_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
-    nid = _nidForCurve(MapECName(Type()));
-    VerifyOrExit(nid != NID_undef, error = CHIP_ERROR_INVALID_ARGUMENT);
+    OpenSSLP256PublicKey unparsed_key       = {};
+    const OpenSSLP256PublicKey * public_key = to_const_public_key(&mContext);
 
-    ec_group = EC_GROUP_new_by_curve_name(nid);
-    VerifyOrExit(ec_group != nullptr, error = CHIP_ERROR_INTERNAL);
+    VerifyOrExit(msg != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    key_point = EC_POINT_new(ec_group);
-    VerifyOrExit(key_point != nullptr, error = CHIP_ERROR_INTERNAL);
+    md = _digestForType(digest);
+    VerifyOrExit(md != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = EC_POINT_oct2point(ec_group, key_point, Uint8::to_const_uchar(*this), Length(), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    if (!IsParsed())
+    {
+        SuccessOrExit(error = ReadPublicKey(*this, &unparsed_key));
+        public_key = &unparsed_key;
+    }
+    error = CHIP_ERROR_INTERNAL;
 
-    ec_key = EC_KEY_new_by_curve_name(nid);
-    VerifyOrExit(ec_key != nullptr, error = CHIP_ERROR_INTERNAL);
+    md_context = EVP_MD_CTX_create();
+    VerifyOrExit(md_context != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    result = EC_KEY_set_public_key(ec_key, key_point);
+    result = EVP_DigestVerifyInit(md_context, nullptr, md, nullptr, public_key->mEVPKey);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    result = EC_KEY_check_key(ec_key);
+    result = EVP_DigestVerifyUpdate(md_context, Uint8::to_const_uchar(msg), msg_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // The cast for length arguments is safe because values are small enough to fit.
-    result = ECDSA_verify(0, hash, static_cast<int>(hash_length), Uint8::to_const_uchar(signature),
-                          static_cast<int>(signature.Length()), ec_key);
+    result = EVP_DigestVerifyFinal(md_context, Uint8::to_const_uchar(signature), signature.Length());
     VerifyOrExit(result == 1, error = CHIP_ERROR_INVALID_SIGNATURE);
     error = CHIP_NO_ERROR;
 
 exit:
     _logSSLError();
-    if (ec_group != nullptr)
-    {
-        EC_GROUP_free(ec_group);
-        ec_group = nullptr;
-    }
-    if (key_point != nullptr)
+    if (md_context)
     {
-        EC_POINT_clear_free(key_point);
-        key_point = nullptr;
+        EVP_MD_CTX_destroy(md_context);
+        md_context = nullptr;
     }
-    if (ec_key != nullptr)
+    FreePublicKey(&unparsed_key);
+    return error;
+}
+
+CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, const size_t hash_length,
+                                                        const P256ECDSASignature & signature) const
+{
+    ERR_clear_error();
+    CHIP_ERROR error = CHIP_ERROR_INTERNAL;
+    int result       = 0;
+
+    OpenSSLP256PublicKey unparsed_key       = {};
+    const OpenSSLP256PublicKey * public_key = to_const_public_key(&mContext);
+
+    VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(hash_length == kSHA256_Hash_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (!IsParsed())
     {
-        EC_KEY_free(ec_key);
-        ec_key = nullptr;
+        SuccessOrExit(error = ReadPublicKey(*this, &unparsed_key));
+        public_key = &unparsed_key;
     }
+
+    // The cast for length arguments is safe because values are small enough to fit.
+    result = ECDSA_verify(0, hash, static_cast<int>(hash_length), Uint8::to_const_uchar(signature),
+                          static_cast<int>(signature.Length()), public_key->mECKey);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INVALID_SIGNATURE);
+    error = CHIP_NO_ERROR;
+
+exit:
+    _logSSLError();
+    FreePublicKey(&unparsed_key);
     return error;
 }
 
@@ -828,17 +1108,11 @@ CHIP_ERROR P256Keypair::ECDH_derive_secret(const P256PublicKey & remote_public_k
     EVP_PKEY_CTX * context = nullptr;
     size_t out_buf_length  = 0;
 
-    EC_KEY * ec_key = EC_KEY_dup(to_const_EC_KEY(&mKeypair));
-    VerifyOrExit(ec_key != nullptr, error = CHIP_ERROR_INTERNAL);
-
     VerifyOrExit(mInitialized, error = CHIP_ERROR_INCORRECT_STATE);
 
-    local_key = EVP_PKEY_new();
+    local_key = to_EVP_PKEY(&mKeypair);
     VerifyOrExit(local_key != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    result = EVP_PKEY_set1_EC_KEY(local_key, ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
     error = _create_evp_key_from_binary_p256_key(remote_public_key, &remote_key);
     SuccessOrExit(error);
 
@@ -857,17 +1131,7 @@ CHIP_ERROR P256Keypair::ECDH_derive_secret(const P256PublicKey & remote_public_k
     SuccessOrExit(out_secret.SetLength(out_buf_length));
 
 exit:
-    if (ec_key != nullptr)
-    {
-        EC_KEY_free(ec_key);
-        ec_key = nullptr;
-    }
-
-    if (local_key != nullptr)
-    {
-        EVP_PKEY_free(local_key);
-        local_key = nullptr;
-    }
+    local_key = nullptr;
 
     if (remote_key != nullptr)
     {
@@ -926,7 +1190,8 @@ CHIP_ERROR P256Keypair::Initialize()
         VerifyOrExit(pubkey_size == mPublicKey.Length(), error = CHIP_ERROR_INTERNAL);
     }
 
-    from_EC_KEY(ec_key, &mKeypair);
+    error = from_EC_KEY(ec_key, &mKeypair);
+    SuccessOrExit(error);
     mInitialized = true;
     ec_key       = nullptr;
 
@@ -1025,7 +1290,8 @@ CHIP_ERROR P256Keypair::Deserialize(P256SerializedKeypair & input)
     result = EC_KEY_set_private_key(ec_key, pvt_key);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    from_EC_KEY(ec_key, &mKeypair);
+    error = from_EC_KEY(ec_key, &mKeypair);
+    SuccessOrExit(error);
     mInitialized = true;
     ec_key       = nullptr;
 
@@ -1062,8 +1328,9 @@ P256Keypair::~P256Keypair()
 {
     if (mInitialized)
     {
-        EC_KEY * ec_key = to_EC_KEY(&mKeypair);
-        EC_KEY_free(ec_key);
+        OpenSSLP256Keypair * keypair = to_keypair(&mKeypair);
+        EVP_PKEY_free(keypair->mEVPKey);
+        EC_KEY_free(keypair->mECKey);
     }
 }
 
@@ -1074,7 +1341,7 @@ CHIP_ERROR P256Keypair::NewCertificateSigningRequest(uint8_t * out_csr, size_t &
     int result       = 0;
 
     X509_REQ * x509_req = X509_REQ_new();
-    EVP_PKEY * evp_pkey = nullptr;
+    EVP_PKEY * evp_pkey = to_EVP_PKEY(&mKeypair);
 
     EC_KEY * ec_key = to_EC_KEY(&mKeypair);
 
@@ -1089,12 +1356,6 @@ CHIP_ERROR P256Keypair::NewCertificateSigningRequest(uint8_t * out_csr, size_t &
     result = EC_KEY_check_key(ec_key);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    evp_pkey = EVP_PKEY_new();
-    VerifyOrExit(evp_pkey != nullptr, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_PKEY_set1_EC_KEY(evp_pkey, ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
     result = X509_REQ_set_pubkey(x509_req, evp_pkey);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
@@ -1119,13 +1380,8 @@ CHIP_ERROR P256Keypair::NewCertificateSigningRequest(uint8_t * out_csr, size_t &
     BIO_read(bioMem, out_csr, static_cast<int>(bptr->length));
 
 exit:
-    ec_key = nullptr;
-
-    if (evp_pkey != nullptr)
-    {
-        EVP_PKEY_free(evp_pkey);
-        evp_pkey = nullptr;
-    }
+    ec_key   = nullptr;
+    evp_pkey = nullptr;
 
     if (bioMem != nullptr)
     {
@@ -1139,17 +1395,25 @@ exit:
     return error;
 }
 
+// Points and field elements are kept when a context is initialized again, so that a
+// Spake2p object can be reused for several sessions without reallocating them.
 #define init_point(_point_)                                                                                                        \
     do                                                                                                                             \
     {                                                                                                                              \
-        _point_ = EC_POINT_new(context->curve);                                                                                    \
+        if (_point_ == nullptr)                                                                                                    \
+        {                                                                                                                          \
+            _point_ = EC_POINT_new(context->curve);                                                                                \
+        }                                                                                                                          \
         VerifyOrExit(_point_ != nullptr, error = CHIP_ERROR_INTERNAL);                                                             \
     } while (0)
 
 #define init_bn(_bn_)                                                                                                              \
     do                                                                                                                             \
     {                                                                                                                              \
-        _bn_ = BN_new();                                                                                                           \
+        if (_bn_ == nullptr)                                                                                                       \
+        {                                                                                                                          \
+            _bn_ = BN_new();                                                                                                       \
+        }                                                                                                                          \
         VerifyOrExit(_bn_ != nullptr, error = CHIP_ERROR_INTERNAL);                                                                \
     } while (0)
 
@@ -1173,7 +1437,7 @@ exit:
 
 typedef struct Spake2p_Context
 {
-    EC_GROUP * curve;
+    const EC_GROUP * curve;
     BN_CTX * bn_ctx;
     const EVP_MD * md_info;
 } Spake2p_Context;
@@ -1184,6 +1448,84 @@ static inline Spake2p_Context * to_inner_spake2p_context(Spake2pOpaqueContext *
     return reinterpret_cast<Spake2p_Context *>(context->mOpaque);
 }
 
+// Builds a P-256 group whose generator is the given point, or the standard generator when
+// none is given, with the table for fixed-base multiplication by that generator precomputed.
+static EC_GROUP * NewFixedBaseCurve(const uint8_t * generator, size_t generator_len)
+{
+    CHIP_ERROR error  = CHIP_ERROR_INTERNAL;
+    int error_openssl = 0;
+    EC_GROUP * curve  = nullptr;
+    EC_POINT * base   = nullptr;
+    BIGNUM * order    = nullptr;
+    BN_CTX * bn_ctx   = nullptr;
+
+    curve = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    VerifyOrExit(curve != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    bn_ctx = BN_CTX_new();
+    VerifyOrExit(bn_ctx != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    if (generator != nullptr)
+    {
+        base = EC_POINT_new(curve);
+        VerifyOrExit(base != nullptr, error = CHIP_ERROR_INTERNAL);
+
+        order = BN_new();
+        VerifyOrExit(order != nullptr, error = CHIP_ERROR_INTERNAL);
+
+        error_openssl = EC_POINT_oct2point(curve, base, Uint8::to_const_uchar(generator), generator_len, bn_ctx);
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+
+        error_openssl = EC_GROUP_get_order(curve, order, bn_ctx);
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+
+        error_openssl = EC_GROUP_set_generator(curve, base, order, BN_value_one());
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    // Builds with a hard-coded table for the standard generator already have one.
+    if (!EC_GROUP_have_precompute_mult(curve))
+    {
+        error_openssl = EC_GROUP_precompute_mult(curve, bn_ctx);
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    error = CHIP_NO_ERROR;
+exit:
+    EC_POINT_free(base);
+    BN_free(order);
+    BN_CTX_free(bn_ctx);
+
+    if (error != CHIP_NO_ERROR)
+    {
+        EC_GROUP_free(curve);
+        curve = nullptr;
+    }
+
+    return curve;
+}
+
+// A group and its precomputed tables are only read once built, so all SPAKE2+ contexts share
+// them instead of constructing the curve for every session. The groups for M and N use those
+// points as generators, so multiplying them by a scalar is a fixed-base multiplication too.
+static const EC_GROUP * GetSpake2pCurve()
+{
+    static const EC_GROUP * const sCurve = NewFixedBaseCurve(nullptr, 0);
+    return sCurve;
+}
+
+static const EC_GROUP * GetSpake2pMCurve()
+{
+    static const EC_GROUP * const sCurve = NewFixedBaseCurve(spake2p_M_p256, sizeof(spake2p_M_p256));
+    return sCurve;
+}
+
+static const EC_GROUP * GetSpake2pNCurve()
+{
+    static const EC_GROUP * const sCurve = NewFixedBaseCurve(spake2p_N_p256, sizeof(spake2p_N_p256));
+    return sCurve;
+}
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal()
 {
     CHIP_ERROR error  = CHIP_ERROR_INTERNAL;
@@ -1191,17 +1533,17 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal()
 
     Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
 
-    context->curve   = nullptr;
-    context->bn_ctx  = nullptr;
+    context->curve   = GetSpake2pCurve();
     context->md_info = nullptr;
-
-    context->curve = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
     VerifyOrExit(context->curve != nullptr, error = CHIP_ERROR_INTERNAL);
 
     G = EC_GROUP_get0_generator(context->curve);
     VerifyOrExit(G != nullptr, error = CHIP_ERROR_INTERNAL);
 
-    context->bn_ctx = BN_CTX_secure_new();
+    if (context->bn_ctx == nullptr)
+    {
+        context->bn_ctx = BN_CTX_secure_new();
+    }
     VerifyOrExit(context->bn_ctx != nullptr, error = CHIP_ERROR_INTERNAL);
 
     context->md_info = EVP_sha256();
@@ -1232,11 +1574,6 @@ void Spake2p_P256_SHA256_HKDF_HMAC::FreeImpl()
 {
     Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
 
-    if (context->curve != nullptr)
-    {
-        EC_GROUP_clear_free(context->curve);
-    }
-
     if (context->bn_ctx != nullptr)
     {
         BN_CTX_free(context->bn_ctx);
@@ -1437,6 +1774,54 @@ exit:
     return error;
 }
 
+CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointAddMulMN(void * R, const void * P1, const void * fe1, const void * MN,
+                                                        const void * fe2, bool negate)
+{
+    CHIP_ERROR error          = CHIP_ERROR_INTERNAL;
+    int error_openssl         = 0;
+    EC_POINT * scratch        = nullptr;
+    const EC_GROUP * mn_curve = nullptr;
+
+    Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
+
+    VerifyOrExit(MN == M || MN == N, error = CHIP_ERROR_INVALID_ARGUMENT);
+    mn_curve = (MN == M) ? GetSpake2pMCurve() : GetSpake2pNCurve();
+    VerifyOrExit(mn_curve != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    scratch = EC_POINT_new(context->curve);
+    VerifyOrExit(scratch != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    error_openssl = EC_POINT_mul(mn_curve, scratch, static_cast<const BIGNUM *>(fe2), nullptr, nullptr, context->bn_ctx);
+    VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+
+    if (negate)
+    {
+        error_openssl = EC_POINT_invert(context->curve, scratch, context->bn_ctx);
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    if (P1 == G)
+    {
+        error_openssl = EC_POINT_mul(context->curve, static_cast<EC_POINT *>(R), static_cast<const BIGNUM *>(fe1), nullptr,
+                                     nullptr, context->bn_ctx);
+    }
+    else
+    {
+        error_openssl = EC_POINT_mul(context->curve, static_cast<EC_POINT *>(R), nullptr, static_cast<const EC_POINT *>(P1),
+                                     static_cast<const BIGNUM *>(fe1), context->bn_ctx);
+    }
+    VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+
+    error_openssl = EC_POINT_add(context->curve, static_cast<EC_POINT *>(R), static_cast<EC_POINT *>(R),
+                                 static_cast<const EC_POINT *>(scratch), context->bn_ctx);
+    VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+
+    error = CHIP_NO_ERROR;
+exit:
+    EC_POINT_clear_free(scratch);
+    return error;
+}
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointInvert(void * R)
 {
     CHIP_ERROR error  = CHIP_ERROR_INTERNAL;
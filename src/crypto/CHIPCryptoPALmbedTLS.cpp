@@ -22,6 +22,7 @@
 
 #include "CHIPCryptoPAL.h"
 
+#include <mbedtls/asn1.h>
 #include <mbedtls/bignum.h>
 #include <mbedtls/ccm.h>
 #include <mbedtls/ctr_drbg.h>
@@ -170,6 +171,104 @@ exit:
     return error;
 }
 
+CHIP_ERROR AES_CCM_encrypt_batch(const AES_CCM_EncryptMessage * messages, size_t count, const uint8_t * key, size_t key_length,
+                                 size_t tag_length, size_t & out_failed_index)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+    size_t i         = 0;
+
+    mbedtls_ccm_context context;
+    mbedtls_ccm_init(&context);
+
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(key != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The key schedule is computed once for the whole batch.
+    // Cast is safe because we called _isValidKeyLength above.
+    result =
+        mbedtls_ccm_setkey(&context, MBEDTLS_CIPHER_ID_AES, Uint8::to_const_uchar(key), static_cast<unsigned int>(key_length * 8));
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    for (i = 0; i < count; i++)
+    {
+        const AES_CCM_EncryptMessage & message = messages[i];
+
+        VerifyOrExit(message.mPlaintext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mPlaintextLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIV != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIVLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mTag != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        if (message.mAADLength > 0)
+        {
+            VerifyOrExit(message.mAAD != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        }
+
+        result = mbedtls_ccm_encrypt_and_tag(&context, message.mPlaintextLength, Uint8::to_const_uchar(message.mIV),
+                                             message.mIVLength, Uint8::to_const_uchar(message.mAAD), message.mAADLength,
+                                             Uint8::to_const_uchar(message.mPlaintext), Uint8::to_uchar(message.mCiphertext),
+                                             Uint8::to_uchar(message.mTag), tag_length);
+        _log_mbedTLS_error(result);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+    }
+
+exit:
+    mbedtls_ccm_free(&context);
+    out_failed_index = i;
+    return error;
+}
+
+CHIP_ERROR AES_CCM_decrypt_batch(const AES_CCM_DecryptMessage * messages, size_t count, const uint8_t * key, size_t key_length,
+                                 size_t tag_length, size_t & out_failed_index)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+    size_t i         = 0;
+
+    mbedtls_ccm_context context;
+    mbedtls_ccm_init(&context);
+
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(key != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The key schedule is computed once for the whole batch.
+    // Cast is safe because we called _isValidKeyLength above.
+    result =
+        mbedtls_ccm_setkey(&context, MBEDTLS_CIPHER_ID_AES, Uint8::to_const_uchar(key), static_cast<unsigned int>(key_length * 8));
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    for (i = 0; i < count; i++)
+    {
+        const AES_CCM_DecryptMessage & message = messages[i];
+
+        VerifyOrExit(message.mCiphertext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mCiphertextLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mTag != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIV != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(message.mIVLength > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        if (message.mAADLength > 0)
+        {
+            VerifyOrExit(message.mAAD != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        }
+
+        result = mbedtls_ccm_auth_decrypt(&context, message.mCiphertextLength, Uint8::to_const_uchar(message.mIV),
+                                          message.mIVLength, Uint8::to_const_uchar(message.mAAD), message.mAADLength,
+                                          Uint8::to_const_uchar(message.mCiphertext), Uint8::to_uchar(message.mPlaintext),
+                                          Uint8::to_const_uchar(message.mTag), tag_length);
+        _log_mbedTLS_error(result);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+    }
+
+exit:
+    mbedtls_ccm_free(&context);
+    out_failed_index = i;
+    return error;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
@@ -369,7 +468,7 @@ exit:
     return error;
 }
 
-CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length)
+CHIP_ERROR DRBG_get_bytes_impl(uint8_t * out_buffer, const size_t out_length)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 0;
@@ -389,9 +488,24 @@ exit:
     return error;
 }
 
+CHIP_ERROR DRBG_reseed_impl()
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 0;
+
+    mbedtls_ctr_drbg_context * drbg_ctxt = get_drbg_context();
+    VerifyOrExit(drbg_ctxt != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    result = mbedtls_ctr_drbg_reseed(drbg_ctxt, nullptr, 0);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
 static int CryptoRNG(void * ctxt, uint8_t * out_buffer, size_t out_length)
 {
-    return (chip::Crypto::DRBG_get_bytes(out_buffer, out_length) == CHIP_NO_ERROR) ? 0 : 1;
+    return (chip::Crypto::DRBG_get_pooled_bytes(out_buffer, out_length) == CHIP_NO_ERROR) ? 0 : 1;
 }
 
 mbedtls_ecp_group_id MapECPGroupId(SupportedECPKeyTypes keyType)
@@ -424,29 +538,24 @@ CHIP_ERROR P256Keypair::ECDSA_sign_msg(const uint8_t * msg, const size_t msg_len
     uint8_t hash[NUM_BYTES_IN_SHA256_HASH];
     size_t siglen = out_signature.Capacity();
 
-    const mbedtls_ecp_keypair * keypair = to_const_keypair(&mKeypair);
-
-    mbedtls_ecdsa_context ecdsa_ctxt;
-    mbedtls_ecdsa_init(&ecdsa_ctxt);
+    // An ECDSA context is an mbedtls_ecp_keypair, so the keypair signs directly and the comb
+    // table mbedTLS builds for the generator stays in its group for the next signature.
+    mbedtls_ecdsa_context * ecdsa_ctxt = to_keypair(&mKeypair);
 
     VerifyOrExit(mInitialized, error = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(msg != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecdsa_from_keypair(&ecdsa_ctxt, keypair);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
-
     result = mbedtls_sha256_ret(Uint8::to_const_uchar(msg), msg_length, hash, 0);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
-    result = mbedtls_ecdsa_write_signature(&ecdsa_ctxt, MBEDTLS_MD_SHA256, hash, sizeof(hash), Uint8::to_uchar(out_signature),
+    result = mbedtls_ecdsa_write_signature(ecdsa_ctxt, MBEDTLS_MD_SHA256, hash, sizeof(hash), Uint8::to_uchar(out_signature),
                                            &siglen, CryptoRNG, nullptr);
     SuccessOrExit(out_signature.SetLength(siglen));
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
 exit:
-    keypair = nullptr;
-    mbedtls_ecdsa_free(&ecdsa_ctxt);
+    ecdsa_ctxt = nullptr;
     _log_mbedTLS_error(result);
     return error;
 }
@@ -457,26 +566,98 @@ CHIP_ERROR P256Keypair::ECDSA_sign_hash(const uint8_t * hash, const size_t hash_
     int result       = 0;
     size_t siglen    = out_signature.Capacity();
 
-    const mbedtls_ecp_keypair * keypair = to_const_keypair(&mKeypair);
-
-    mbedtls_ecdsa_context ecdsa_ctxt;
-    mbedtls_ecdsa_init(&ecdsa_ctxt);
+    mbedtls_ecdsa_context * ecdsa_ctxt = to_keypair(&mKeypair);
 
     VerifyOrExit(mInitialized, error = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(hash_length == NUM_BYTES_IN_SHA256_HASH, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecdsa_from_keypair(&ecdsa_ctxt, keypair);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
-
-    result = mbedtls_ecdsa_write_signature(&ecdsa_ctxt, MBEDTLS_MD_SHA256, hash, hash_length, Uint8::to_uchar(out_signature),
+    result = mbedtls_ecdsa_write_signature(ecdsa_ctxt, MBEDTLS_MD_SHA256, hash, hash_length, Uint8::to_uchar(out_signature),
                                            &siglen, CryptoRNG, nullptr);
     SuccessOrExit(out_signature.SetLength(siglen));
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
 exit:
-    keypair = nullptr;
-    mbedtls_ecdsa_free(&ecdsa_ctxt);
+    ecdsa_ctxt = nullptr;
+    _log_mbedTLS_error(result);
+    return error;
+}
+
+// The parsed public key, along with the key bytes it was parsed from so that changes to them are noticed.
+struct mbedTLSP256PublicKey
+{
+    uint8_t mEncoded[kP256_PublicKey_Length];
+    bool mValid;
+    mbedtls_ecp_point mQ;
+};
+
+static inline mbedTLSP256PublicKey * to_public_key(P256PublicKeyContext * context)
+{
+    nlSTATIC_ASSERT_PRINT(sizeof(P256PublicKeyContext) >= sizeof(mbedTLSP256PublicKey), "Need more memory for public key");
+    return reinterpret_cast<mbedTLSP256PublicKey *>(context->mBytes);
+}
+
+static inline const mbedTLSP256PublicKey * to_const_public_key(const P256PublicKeyContext * context)
+{
+    nlSTATIC_ASSERT_PRINT(sizeof(P256PublicKeyContext) >= sizeof(mbedTLSP256PublicKey), "Need more memory for public key");
+    return reinterpret_cast<const mbedTLSP256PublicKey *>(context->mBytes);
+}
+
+// Reads the key point and checks that it is on the curve of group.
+static int ReadPublicKey(const mbedtls_ecp_group * group, const P256PublicKey & key, mbedtls_ecp_point * point)
+{
+    int result = mbedtls_ecp_point_read_binary(group, point, Uint8::to_const_uchar(key), key.Length());
+    if (result == 0)
+    {
+        result = mbedtls_ecp_check_pubkey(group, point);
+    }
+    return result;
+}
+
+P256PublicKey::~P256PublicKey()
+{
+    if (mContextInitialized)
+    {
+        mbedtls_ecp_point_free(&to_public_key(&mContext)->mQ);
+    }
+}
+
+bool P256PublicKey::IsParsed() const
+{
+    const mbedTLSP256PublicKey * public_key = to_const_public_key(&mContext);
+
+    return mContextInitialized && public_key->mValid && memcmp(public_key->mEncoded, bytes, sizeof(bytes)) == 0;
+}
+
+CHIP_ERROR P256PublicKey::ParseKey()
+{
+    CHIP_ERROR error                  = CHIP_NO_ERROR;
+    int result                        = 0;
+    mbedTLSP256PublicKey * public_key = to_public_key(&mContext);
+
+    mbedtls_ecp_group group;
+    mbedtls_ecp_group_init(&group);
+
+    VerifyOrExit(!IsParsed(), );
+
+    if (!mContextInitialized)
+    {
+        mbedtls_ecp_point_init(&public_key->mQ);
+        mContextInitialized = true;
+    }
+    public_key->mValid = false;
+
+    result = mbedtls_ecp_group_load(&group, MapECPGroupId(Type()));
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    result = ReadPublicKey(&group, *this, &public_key->mQ);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    memcpy(public_key->mEncoded, bytes, sizeof(bytes));
+    public_key->mValid = true;
+
+exit:
+    mbedtls_ecp_group_free(&group);
     _log_mbedTLS_error(result);
     return error;
 }
@@ -488,33 +669,15 @@ CHIP_ERROR P256PublicKey::ECDSA_validate_msg_signature(const uint8_t * msg, cons
     int result       = 0;
     uint8_t hash[NUM_BYTES_IN_SHA256_HASH];
 
-    mbedtls_ecp_keypair keypair;
-    mbedtls_ecp_keypair_init(&keypair);
-
-    mbedtls_ecdsa_context ecdsa_ctxt;
-    mbedtls_ecdsa_init(&ecdsa_ctxt);
-
     VerifyOrExit(msg != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecp_group_load(&keypair.grp, MapECPGroupId(Type()));
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result = mbedtls_ecp_point_read_binary(&keypair.grp, &keypair.Q, Uint8::to_const_uchar(*this), Length());
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result = mbedtls_ecdsa_from_keypair(&ecdsa_ctxt, &keypair);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
-
     result = mbedtls_sha256_ret(Uint8::to_const_uchar(msg), msg_length, hash, 0);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
-    result = mbedtls_ecdsa_read_signature(&ecdsa_ctxt, hash, sizeof(hash), Uint8::to_const_uchar(signature), signature.Length());
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_SIGNATURE);
+    error = ECDSA_validate_hash_signature(hash, sizeof(hash), signature);
 
 exit:
-    mbedtls_ecp_keypair_free(&keypair);
-    mbedtls_ecdsa_free(&ecdsa_ctxt);
     _log_mbedTLS_error(result);
     return error;
 }
@@ -524,31 +687,57 @@ CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, co
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 0;
+    size_t len       = 0;
+
+    unsigned char * p         = const_cast<unsigned char *>(Uint8::to_const_uchar(signature));
+    const unsigned char * end = p + signature.Length();
+
+    mbedtls_mpi r;
+    mbedtls_mpi_init(&r);
+
+    mbedtls_mpi s;
+    mbedtls_mpi_init(&s);
 
-    mbedtls_ecp_keypair keypair;
-    mbedtls_ecp_keypair_init(&keypair);
+    // mbedtls_ecdsa_verify() may store a comb table in the group it is given, so every call loads its own.  The
+    // built-in P-256 group comes with a static table for the generator, which makes loading it cheap.
+    mbedtls_ecp_group group;
+    mbedtls_ecp_group_init(&group);
 
-    mbedtls_ecdsa_context ecdsa_ctxt;
-    mbedtls_ecdsa_init(&ecdsa_ctxt);
+    mbedtls_ecp_point point;
+    mbedtls_ecp_point_init(&point);
+    const mbedtls_ecp_point * key_point = &to_const_public_key(&mContext)->mQ;
 
     VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(hash_length == NUM_BYTES_IN_SHA256_HASH, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecp_group_load(&keypair.grp, MapECPGroupId(Type()));
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    result = mbedtls_ecp_group_load(&group, MapECPGroupId(Type()));
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
-    result = mbedtls_ecp_point_read_binary(&keypair.grp, &keypair.Q, Uint8::to_const_uchar(*this), Length());
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    if (!IsParsed())
+    {
+        result = ReadPublicKey(&group, *this, &point);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        key_point = &point;
+    }
 
-    result = mbedtls_ecdsa_from_keypair(&ecdsa_ctxt, &keypair);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+    // This is mbedtls_ecdsa_read_signature() without copying the key into an ECDSA context first.
+    result = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE);
+    VerifyOrExit(result == 0 && p + len == end, error = CHIP_ERROR_INVALID_SIGNATURE);
+
+    result = mbedtls_asn1_get_mpi(&p, end, &r);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_SIGNATURE);
+
+    result = mbedtls_asn1_get_mpi(&p, end, &s);
+    VerifyOrExit(result == 0 && p == end, error = CHIP_ERROR_INVALID_SIGNATURE);
 
-    result = mbedtls_ecdsa_read_signature(&ecdsa_ctxt, hash, hash_length, Uint8::to_const_uchar(signature), signature.Length());
+    result = mbedtls_ecdsa_verify(&group, hash, hash_length, key_point, &r, &s);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_SIGNATURE);
 
 exit:
-    mbedtls_ecp_keypair_free(&keypair);
-    mbedtls_ecdsa_free(&ecdsa_ctxt);
+    mbedtls_ecp_point_free(&point);
+    mbedtls_ecp_group_free(&group);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
     _log_mbedTLS_error(result);
     return error;
 }
@@ -747,6 +936,8 @@ exit:
 typedef struct Spake2p_Context
 {
     mbedtls_ecp_group curve;
+    mbedtls_ecp_group curve_M;
+    mbedtls_ecp_group curve_N;
     const mbedtls_md_info_t * md_info;
     mbedtls_ecp_point M;
     mbedtls_ecp_point N;
@@ -768,6 +959,41 @@ static inline Spake2p_Context * to_inner_spake2p_context(Spake2pOpaqueContext *
     return reinterpret_cast<Spake2p_Context *>(context->mOpaque);
 }
 
+// Loads a P-256 group whose generator is the given point, so that mbedTLS builds and keeps a
+// fixed-base comb table for that point in the group the first time it multiplies it.
+static int LoadFixedBaseCurve(mbedtls_ecp_group * curve, const uint8_t * generator, size_t generator_len)
+{
+    int result = 0;
+    mbedtls_ecp_point point;
+
+    mbedtls_ecp_point_init(&point);
+    mbedtls_ecp_group_init(curve);
+    result = mbedtls_ecp_group_load(curve, MBEDTLS_ECP_DP_SECP256R1);
+    VerifyOrExit(result == 0, );
+
+    result = mbedtls_ecp_point_read_binary(curve, &point, Uint8::to_const_uchar(generator), generator_len);
+    VerifyOrExit(result == 0, );
+
+    // The generator loaded with the group points at mbedTLS's static limbs, which must be neither written nor freed:
+    // the group takes the heap limbs just read instead, and FreeImpl releases them.
+    curve->G = point;
+    mbedtls_ecp_point_init(&point);
+
+    // A table loaded along with the group is for the standard generator; it is static, so it is not freed here.
+    curve->T      = nullptr;
+    curve->T_size = 0;
+
+exit:
+    mbedtls_ecp_point_free(&point);
+    if (result != 0)
+    {
+        // Leaves the group empty rather than with the static generator, which FreeImpl must not free.
+        mbedtls_ecp_group_free(curve);
+        mbedtls_ecp_group_init(curve);
+    }
+    return result;
+}
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal(void)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
@@ -775,11 +1001,24 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal(void)
 
     Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
 
+    // The groups, and the comb tables mbedTLS caches in them, are kept when the object is
+    // initialized again for another session.
+    if (context->curve.id != MBEDTLS_ECP_DP_NONE)
+    {
+        return CHIP_NO_ERROR;
+    }
+
     memset(context, 0, sizeof(Spake2p_Context));
     mbedtls_ecp_group_init(&context->curve);
     result = mbedtls_ecp_group_load(&context->curve, MBEDTLS_ECP_DP_SECP256R1);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
+    result = LoadFixedBaseCurve(&context->curve_M, spake2p_M_p256, sizeof(spake2p_M_p256));
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    result = LoadFixedBaseCurve(&context->curve_N, spake2p_N_p256, sizeof(spake2p_N_p256));
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
     context->md_info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
     VerifyOrExit(context->md_info != nullptr, error = CHIP_ERROR_INTERNAL);
 
@@ -836,7 +1075,14 @@ void Spake2p_P256_SHA256_HKDF_HMAC::FreeImpl(void)
     mbedtls_mpi_free(&context->xy);
     mbedtls_mpi_free(&context->tempbn);
 
+    // Groups loaded from mbedTLS's built-in curves never free their generator.  LoadFixedBaseCurve gave these their own,
+    // or left them empty if it failed, and InitInternal zeroes them before loading them.
+    mbedtls_ecp_point_free(&context->curve_M.G);
+    mbedtls_ecp_point_free(&context->curve_N.G);
+
     mbedtls_ecp_group_free(&context->curve);
+    mbedtls_ecp_group_free(&context->curve_M);
+    mbedtls_ecp_group_free(&context->curve_N);
 }
 
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::Mac(const uint8_t * key, size_t key_len, const uint8_t * in, size_t in_len, uint8_t * out)
@@ -1020,6 +1266,42 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointAddMul(void * R, const void * P1,
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointAddMulMN(void * R, const void * P1, const void * fe1, const void * MN,
+                                                        const void * fe2, bool negate)
+{
+    CHIP_ERROR error             = CHIP_NO_ERROR;
+    int result                   = 0;
+    mbedtls_ecp_group * mn_curve = nullptr;
+    mbedtls_ecp_point scratch;
+    mbedtls_mpi sign;
+
+    Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
+
+    mbedtls_ecp_point_init(&scratch);
+    mbedtls_mpi_init(&sign);
+
+    VerifyOrExit(MN == M || MN == N, error = CHIP_ERROR_INVALID_ARGUMENT);
+    mn_curve = (MN == M) ? &context->curve_M : &context->curve_N;
+
+    result = mbedtls_ecp_mul(mn_curve, &scratch, (const mbedtls_mpi *) fe2, &mn_curve->G, CryptoRNG, nullptr);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    // Multiplications by 1 and -1 are shortcuts in mbedtls_ecp_muladd, and the one by G uses the
+    // table kept in the curve.
+    result = mbedtls_mpi_lset(&sign, negate ? -1 : 1);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    result = mbedtls_ecp_muladd(&context->curve, (mbedtls_ecp_point *) R, (const mbedtls_mpi *) fe1,
+                                (const mbedtls_ecp_point *) P1, &sign, &scratch);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    _log_mbedTLS_error(result);
+    mbedtls_ecp_point_free(&scratch);
+    mbedtls_mpi_free(&sign);
+    return error;
+}
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointInvert(void * R)
 {
     mbedtls_ecp_point * Rp    = (mbedtls_ecp_point *) R;
@@ -35,18 +35,29 @@
 
 #include <crypto/CHIPCryptoPAL.h>
 
+#include <core/CHIPConfig.h>
 #include <core/CHIPError.h>
 #include <nlunit-test.h>
 #include <support/CodeUtils.h>
+#include <support/RandUtils.h>
 #include <support/ScopedBuffer.h>
 #include <support/TestUtils.h>
+#include <system/SystemClock.h>
 
+#include <inttypes.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+#include <atomic>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
 using namespace chip;
 using namespace chip::Crypto;
 
@@ -554,6 +565,188 @@ static void TestAES_CCM_128DecryptInvalidIVLen(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+static void TestAES_CCM_128BatchTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    // Each vector is run as a batch of several copies, so that every copy after the first
+    // exercises a cipher context that has already processed a message.
+    const size_t kCopies = 3;
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            out_ct.Alloc(vector->ct_len * kCopies);
+            NL_TEST_ASSERT(inSuite, out_ct);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            out_tag.Alloc(vector->tag_len * kCopies);
+            NL_TEST_ASSERT(inSuite, out_tag);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            out_pt.Alloc(vector->pt_len * kCopies);
+            NL_TEST_ASSERT(inSuite, out_pt);
+
+            AES_CCM_EncryptMessage encrypt[kCopies];
+            AES_CCM_DecryptMessage decrypt[kCopies];
+            size_t failed_index = 0;
+
+            for (size_t i = 0; i < kCopies; i++)
+            {
+                encrypt[i] = { vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                               out_ct.Get() + i * vector->ct_len, out_tag.Get() + i * vector->tag_len };
+                decrypt[i] = { vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->iv, vector->iv_len,
+                               out_pt.Get() + i * vector->pt_len };
+            }
+
+            CHIP_ERROR err = AES_CCM_encrypt_batch(encrypt, kCopies, vector->key, vector->key_len, vector->tag_len, failed_index);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, failed_index == kCopies);
+
+            err = AES_CCM_decrypt_batch(decrypt, kCopies, vector->key, vector->key_len, vector->tag_len, failed_index);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, failed_index == kCopies);
+
+            for (size_t i = 0; i < kCopies; i++)
+            {
+                NL_TEST_ASSERT(inSuite, memcmp(encrypt[i].mCiphertext, vector->ct, vector->ct_len) == 0);
+                NL_TEST_ASSERT(inSuite, memcmp(encrypt[i].mTag, vector->tag, vector->tag_len) == 0);
+                NL_TEST_ASSERT(inSuite, memcmp(decrypt[i].mPlaintext, vector->pt, vector->pt_len) == 0);
+            }
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+static void TestAES_CCM_BatchMatchesSingleMessages(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kMessages = 12;
+    const size_t kTagLen   = 16;
+    uint8_t key[16];
+    uint8_t pt[kMessages][48];
+    uint8_t aad[kMessages][8];
+    uint8_t iv[kMessages][13];
+    uint8_t ct[kMessages][48];
+    uint8_t tag[kMessages][kTagLen];
+    uint8_t expected_ct[48];
+    uint8_t expected_tag[kTagLen];
+    uint8_t out_pt[kMessages][48];
+    AES_CCM_EncryptMessage encrypt[kMessages];
+    AES_CCM_DecryptMessage decrypt[kMessages];
+    size_t failed_index = 0;
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(key, sizeof(key)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(&pt[0][0], sizeof(pt)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(&aad[0][0], sizeof(aad)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(&iv[0][0], sizeof(iv)) == CHIP_NO_ERROR);
+
+    // Vary the message, AAD and IV lengths from one message to the next.
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        size_t pt_len  = 1 + (i * 7) % sizeof(pt[i]);
+        size_t aad_len = i % (sizeof(aad[i]) + 1);
+        size_t iv_len  = 7 + i % 7;
+
+        encrypt[i] = { pt[i], pt_len, aad[i], aad_len, iv[i], iv_len, ct[i], tag[i] };
+        decrypt[i] = { ct[i], pt_len, aad[i], aad_len, tag[i], iv[i], iv_len, out_pt[i] };
+    }
+
+    NL_TEST_ASSERT(inSuite, AES_CCM_encrypt_batch(encrypt, kMessages, key, sizeof(key), kTagLen, failed_index) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == kMessages);
+
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        const AES_CCM_EncryptMessage & m = encrypt[i];
+        NL_TEST_ASSERT(inSuite,
+                       AES_CCM_encrypt(m.mPlaintext, m.mPlaintextLength, m.mAAD, m.mAADLength, key, sizeof(key), m.mIV, m.mIVLength,
+                                       expected_ct, expected_tag, kTagLen) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(ct[i], expected_ct, m.mPlaintextLength) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(tag[i], expected_tag, kTagLen) == 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, AES_CCM_decrypt_batch(decrypt, kMessages, key, sizeof(key), kTagLen, failed_index) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == kMessages);
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        NL_TEST_ASSERT(inSuite, memcmp(out_pt[i], pt[i], decrypt[i].mCiphertextLength) == 0);
+    }
+
+    // A message that fails authentication stops the batch there.
+    tag[3][0] ^= 1;
+    NL_TEST_ASSERT(inSuite, AES_CCM_decrypt_batch(decrypt, kMessages, key, sizeof(key), kTagLen, failed_index) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == 3);
+    NL_TEST_ASSERT(inSuite,
+                   AES_CCM_decrypt_batch(&decrypt[4], kMessages - 4, key, sizeof(key), kTagLen, failed_index) == CHIP_NO_ERROR);
+
+    // Invalid arguments
+    CHIP_ERROR err = AES_CCM_encrypt_batch(encrypt, kMessages, nullptr, 0, kTagLen, failed_index);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, failed_index == 0);
+    encrypt[5].mIVLength = 0;
+    err                  = AES_CCM_encrypt_batch(encrypt, kMessages, key, sizeof(key), kTagLen, failed_index);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, failed_index == 5);
+    NL_TEST_ASSERT(inSuite, AES_CCM_encrypt_batch(nullptr, 0, key, sizeof(key), kTagLen, failed_index) == CHIP_NO_ERROR);
+}
+
+/**
+ * Encrypts a stream of small messages under one key, one message per call and in batches of
+ * 8 and 32, and reports the number of messages per second.  Only correctness is asserted;
+ * the rates are informative.
+ */
+static void TestAES_CCM_BatchBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kMessages     = 3200;
+    const size_t kBatchSizes[] = { 1, 8, 32 };
+    const size_t kMaxBatchSize = 32;
+    const size_t kTagLen       = 16;
+    CHIP_ERROR error           = CHIP_NO_ERROR;
+    uint8_t key[16];
+    uint8_t pt[64];
+    uint8_t aad[16];
+    uint8_t iv[kMaxBatchSize][13];
+    uint8_t ct[kMaxBatchSize][sizeof(pt)];
+    uint8_t tag[kMaxBatchSize][kTagLen];
+    AES_CCM_EncryptMessage messages[kMaxBatchSize];
+    size_t failed_index = 0;
+    uint64_t start, elapsed;
+
+    memset(key, 0x11, sizeof(key));
+    memset(pt, 0x22, sizeof(pt));
+    memset(aad, 0x33, sizeof(aad));
+    memset(iv, 0x44, sizeof(iv));
+    for (size_t i = 0; i < kMaxBatchSize; i++)
+    {
+        iv[i][0]    = static_cast<uint8_t>(i);
+        messages[i] = { pt, sizeof(pt), aad, sizeof(aad), iv[i], sizeof(iv[i]), ct[i], tag[i] };
+    }
+
+    for (size_t batchSize : kBatchSizes)
+    {
+        start = System::Platform::Layer::GetClock_MonotonicHiRes();
+        for (size_t i = 0; i < kMessages; i += batchSize)
+        {
+            if (batchSize == 1)
+            {
+                SuccessOrExit(error = AES_CCM_encrypt(pt, sizeof(pt), aad, sizeof(aad), key, sizeof(key), iv[0], sizeof(iv[0]),
+                                                      ct[0], tag[0], kTagLen));
+            }
+            else
+            {
+                SuccessOrExit(error = AES_CCM_encrypt_batch(messages, batchSize, key, sizeof(key), kTagLen, failed_index));
+            }
+        }
+        elapsed = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+        printf("AES-CCM-128, %zu byte messages in batches of %zu: %" PRIu64 " messages per second\n", sizeof(pt), batchSize,
+               elapsed ? static_cast<uint64_t>(kMessages) * 1000000 / elapsed : 0);
+    }
+
+exit:
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+}
+
 static void TestHash_SHA256(nlTestSuite * inSuite, void * inContext)
 {
     int numOfTestCases     = ArraySize(hash_sha256_test_vectors);
@@ -655,6 +848,117 @@ static void TestDRBG_Output(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, memcmp(out_buf, orig_buf, sizeof(out_buf)) != 0);
 }
 
+static void TestDRBG_PooledOutput(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kLengths[] = { 1, 7, 16, 32, 200, 300 };
+    uint8_t out_buf[300];
+    uint8_t other_buf[16];
+    uint8_t zero_buf[sizeof(out_buf)] = { 0 };
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(nullptr, 10) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(out_buf, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Exercise both requests served from the pool and requests passed through to the DRBG
+    for (size_t length : kLengths)
+    {
+        memset(out_buf, 0, sizeof(out_buf));
+        NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(out_buf, length) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, length < 8 || memcmp(out_buf, zero_buf, length) != 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(out_buf, sizeof(other_buf)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(other_buf, sizeof(other_buf)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(out_buf, other_buf, sizeof(other_buf)) != 0);
+
+    NL_TEST_ASSERT(inSuite, DRBG_reseed() == CHIP_NO_ERROR);
+
+#if CHIP_CONFIG_RAND_UTILS_DRBG
+    // chip::GetRandU*() draw from the pool
+    NL_TEST_ASSERT(inSuite, GetRandBytesFromDRBG(out_buf, sizeof(other_buf)));
+#endif // CHIP_CONFIG_RAND_UTILS_DRBG
+}
+
+#if CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+static void TestDRBG_PoolForkSafety(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t parent_buf[16];
+    uint8_t child_buf[16];
+    int fds[2];
+    int status = 0;
+    pid_t pid;
+
+    // Leave bytes in this thread's pool, which the child inherits
+    NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(parent_buf, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pipe(fds) == 0);
+
+    pid = fork();
+    NL_TEST_ASSERT(inSuite, pid >= 0);
+    if (pid == 0)
+    {
+        bool ok = DRBG_get_pooled_bytes(child_buf, sizeof(child_buf)) == CHIP_NO_ERROR &&
+            write(fds[1], child_buf, sizeof(child_buf)) == static_cast<ssize_t>(sizeof(child_buf));
+        _exit(ok ? 0 : 1);
+    }
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_pooled_bytes(parent_buf, sizeof(parent_buf)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, read(fds[0], child_buf, sizeof(child_buf)) == static_cast<ssize_t>(sizeof(child_buf)));
+    NL_TEST_ASSERT(inSuite, waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(parent_buf, child_buf, sizeof(parent_buf)) != 0);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * Draws 4-byte values on 1, 2 and 4 threads, straight from the DRBG and through the
+ * per-thread pools, and reports the aggregate number of requests per second.  Only
+ * correctness is asserted; the rates are informative.
+ */
+static void TestDRBG_PoolBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kRequestsPerThread = 100000;
+    const size_t kThreadCounts[]    = { 1, 2, 4 };
+    const size_t kMaxThreads        = 4;
+    uint64_t start, elapsed;
+
+    for (int pooled = 0; pooled < 2; pooled++)
+    {
+        for (size_t threadCount : kThreadCounts)
+        {
+            std::thread threads[kMaxThreads];
+            std::atomic<size_t> failures(0);
+
+            start = System::Platform::Layer::GetClock_MonotonicHiRes();
+            for (size_t t = 0; t < threadCount; t++)
+            {
+                threads[t] = std::thread([&failures, pooled]() {
+                    uint8_t value[4];
+                    for (size_t i = 0; i < kRequestsPerThread; i++)
+                    {
+                        CHIP_ERROR err =
+                            pooled ? DRBG_get_pooled_bytes(value, sizeof(value)) : DRBG_get_bytes(value, sizeof(value));
+                        if (err != CHIP_NO_ERROR)
+                        {
+                            failures++;
+                        }
+                    }
+                });
+            }
+            for (size_t t = 0; t < threadCount; t++)
+            {
+                threads[t].join();
+            }
+            elapsed = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+            NL_TEST_ASSERT(inSuite, failures == 0);
+            printf("DRBG%s, %zu byte requests on %zu threads: %" PRIu64 " requests per second\n", pooled ? " pool" : "",
+                   sizeof(uint32_t), threadCount,
+                   elapsed ? static_cast<uint64_t>(kRequestsPerThread * threadCount) * 1000000 / elapsed : 0);
+        }
+    }
+}
+#endif // CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+
 static void TestECDSA_Signing_SHA256_Msg(nlTestSuite * inSuite, void * inContext)
 {
     const char * msg  = "Hello World!";
@@ -845,6 +1149,119 @@ static void TestECDSA_ValidationHashInvalidParam(nlTestSuite * inSuite, void * i
     signing_error = CHIP_NO_ERROR;
 }
 
+static void TestECDSA_ValidateMsgSignatures(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kKeys           = 3;
+    const size_t kMessagesPerKey = 4;
+    const size_t kMessages       = kKeys * kMessagesPerKey;
+
+    P256Keypair keypairs[kKeys];
+    P256PublicKey public_keys[kKeys];
+    uint8_t msgs[kMessages][16];
+    P256ECDSASignature signatures[kMessages];
+    P256ECDSASignedMessage batch[kMessages];
+    size_t failed_index = 0;
+
+    for (size_t i = 0; i < kKeys; i++)
+    {
+        NL_TEST_ASSERT(inSuite, keypairs[i].Initialize() == CHIP_NO_ERROR);
+        public_keys[i] = keypairs[i].Pubkey();
+    }
+
+    // Keys that were not parsed beforehand are parsed for each message.
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        memset(msgs[i], static_cast<int>(i), sizeof(msgs[i]));
+        NL_TEST_ASSERT(inSuite, keypairs[i % kKeys].ECDSA_sign_msg(msgs[i], sizeof(msgs[i]), signatures[i]) == CHIP_NO_ERROR);
+        batch[i] = { &public_keys[i % kKeys], msgs[i], sizeof(msgs[i]), &signatures[i] };
+    }
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == kMessages);
+
+    for (size_t i = 0; i < kKeys; i++)
+    {
+        NL_TEST_ASSERT(inSuite, public_keys[i].ParseKey() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, public_keys[i].ParseKey() == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == kMessages);
+
+    msgs[5][0] ^= 1;
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) == CHIP_ERROR_INVALID_SIGNATURE);
+    NL_TEST_ASSERT(inSuite, failed_index == 5);
+    msgs[5][0] ^= 1;
+
+    // A key whose bytes change after it has been used must not validate with the old key.
+    public_keys[0] = keypairs[1].Pubkey();
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) == CHIP_ERROR_INVALID_SIGNATURE);
+    NL_TEST_ASSERT(inSuite, failed_index == 0);
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(&batch[1], 1, failed_index) == CHIP_NO_ERROR);
+
+    public_keys[0] = keypairs[0].Pubkey();
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) == CHIP_NO_ERROR);
+
+    // Bytes that are not a point on the curve are rejected, whether parsed up front or not.
+    memset(Uint8::to_uchar(public_keys[1]) + 1, 0xff, public_keys[1].Length() - 1);
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == 1);
+    NL_TEST_ASSERT(inSuite, public_keys[1].ParseKey() != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(batch, kMessages, failed_index) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == 1);
+
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(nullptr, 0, failed_index) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failed_index == 0);
+}
+
+/**
+ * Validates signatures with one parsed key from several threads at once, which is safe
+ * because validation does not modify the key.
+ */
+static void TestECDSA_ValidateConcurrently(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kThreads           = 4;
+    const size_t kMessagesPerThread = 8;
+
+    P256Keypair keypair;
+    P256PublicKey public_key;
+    uint8_t msgs[kThreads][16];
+    P256ECDSASignature signatures[kThreads];
+    std::thread threads[kThreads];
+    std::atomic<size_t> failures(0);
+
+    NL_TEST_ASSERT(inSuite, keypair.Initialize() == CHIP_NO_ERROR);
+    public_key = keypair.Pubkey();
+    NL_TEST_ASSERT(inSuite, public_key.ParseKey() == CHIP_NO_ERROR);
+
+    for (size_t t = 0; t < kThreads; t++)
+    {
+        memset(msgs[t], static_cast<int>(t), sizeof(msgs[t]));
+        NL_TEST_ASSERT(inSuite, keypair.ECDSA_sign_msg(msgs[t], sizeof(msgs[t]), signatures[t]) == CHIP_NO_ERROR);
+    }
+
+    for (size_t t = 0; t < kThreads; t++)
+    {
+        threads[t] = std::thread([&, t]() {
+            for (size_t i = 0; i < kMessagesPerThread; i++)
+            {
+                // Every other message is checked against another thread's signature, which must fail.
+                const P256ECDSASignature & signature = signatures[(i % 2) ? (t + 1) % kThreads : t];
+                CHIP_ERROR err = public_key.ECDSA_validate_msg_signature(msgs[t], sizeof(msgs[t]), signature);
+                if ((err == CHIP_NO_ERROR) != ((i % 2) == 0))
+                {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (size_t t = 0; t < kThreads; t++)
+    {
+        threads[t].join();
+    }
+
+    NL_TEST_ASSERT(inSuite, failures == 0);
+}
+
 static void TestECDH_EstablishSecret(nlTestSuite * inSuite, void * inContext)
 {
     P256Keypair keypair1;
@@ -978,6 +1395,52 @@ static void TestKeypair_Serialize(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, keypair.Pubkey().ECDSA_validate_msg_signature(test_msg, msglen, test_sig) == CHIP_NO_ERROR);
 }
 
+/**
+ * Signs and validates a stream of messages with the same keys and reports the
+ * number of operations per second.  Only correctness is asserted; the rates are
+ * informative.
+ */
+static void TestECDSA_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kIterations = 500;
+    CHIP_ERROR error           = CHIP_NO_ERROR;
+    uint8_t msg[64];
+    uint64_t start, elapsed;
+
+    P256Keypair keypair;
+    P256PublicKey public_key;
+    P256ECDSASignature signature;
+
+    memset(msg, 0x5a, sizeof(msg));
+    NL_TEST_ASSERT(inSuite, keypair.Initialize() == CHIP_NO_ERROR);
+    public_key = keypair.Pubkey();
+    NL_TEST_ASSERT(inSuite, public_key.ParseKey() == CHIP_NO_ERROR);
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        msg[0] = static_cast<uint8_t>(i);
+        SuccessOrExit(error = keypair.ECDSA_sign_msg(msg, sizeof(msg), signature));
+    }
+    elapsed = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    printf("ECDSA P-256: %" PRIu64 " message signatures per second\n",
+           elapsed ? static_cast<uint64_t>(kIterations) * 1000000 / elapsed : 0);
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        SuccessOrExit(error = public_key.ECDSA_validate_msg_signature(msg, sizeof(msg), signature));
+    }
+    elapsed = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    printf("ECDSA P-256: %" PRIu64 " message signature validations per second\n",
+           elapsed ? static_cast<uint64_t>(kIterations) * 1000000 / elapsed : 0);
+
+exit:
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+}
+
 static void TestSPAKE2P_spake2p_FEMul(nlTestSuite * inSuite, void * inContext)
 {
     uint8_t fe_out[kMAX_FE_Length];
@@ -1144,6 +1607,56 @@ static void TestSPAKE2P_spake2p_PointMulAdd(nlTestSuite * inSuite, void * inCont
     NL_TEST_ASSERT(inSuite, numOfTestsRan == numOfTestVectors);
 }
 
+static void TestSPAKE2P_spake2p_PointAddMulMN(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t expected[kMAX_Point_Length];
+    uint8_t output[kMAX_Point_Length];
+
+    Spake2p_P256_SHA256_HKDF_HMAC spake2p;
+    CHIP_ERROR err = spake2p.Init(nullptr, 0);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (int i = 0; i < 8; i++)
+    {
+        void * MN          = (i % 2 == 0) ? spake2p.M : spake2p.N;
+        bool negate        = (i % 4) >= 2;
+        const void * point = (i < 4) ? spake2p.G : spake2p.Y;
+
+        err = spake2p.FEGenerate(spake2p.w0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.FEGenerate(spake2p.w1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointMul(spake2p.Y, spake2p.G, spake2p.w1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        // Compute the expected point with the generic operations on a copy of M or N
+        err = spake2p.PointWrite(MN, output, sizeof(output));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointLoad(output, sizeof(output), spake2p.X);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        if (negate)
+        {
+            err = spake2p.PointInvert(spake2p.X);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+        err = spake2p.PointAddMul(spake2p.Z, point, spake2p.w0, spake2p.X, spake2p.w1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointWrite(spake2p.Z, expected, sizeof(expected));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointAddMulMN(spake2p.V, point, spake2p.w0, MN, spake2p.w1, negate);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointWrite(spake2p.V, output, sizeof(output));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, memcmp(output, expected, sizeof(output)) == 0);
+    }
+
+    // Only M and N have fixed-base tables
+    err = spake2p.PointAddMulMN(spake2p.V, spake2p.G, spake2p.w0, spake2p.X, spake2p.w1, false);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+}
+
 static void TestSPAKE2P_spake2p_PointLoadWrite(nlTestSuite * inSuite, void * inContext)
 {
     uint8_t output[kMAX_Point_Length];
@@ -1355,6 +1868,63 @@ static void TestSPAKE2P_RFC(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, numOfTestsRan == numOfTestVectors);
 }
 
+/**
+ * Runs complete prover/verifier exchanges between the same two objects and
+ * reports the number of exchanges per second.  Only correctness is asserted;
+ * the rate is informative.
+ */
+static void TestSPAKE2P_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kIterations           = 200;
+    const struct spake2p_rfc_tv * vector = rfc_tvs[0];
+    CHIP_ERROR error                     = CHIP_NO_ERROR;
+    uint8_t L[kMAX_Point_Length];
+    size_t L_len = sizeof(L);
+    uint8_t X[kMAX_Point_Length];
+    uint8_t Y[kMAX_Point_Length];
+    uint8_t Pverifier[kMAX_Hash_Length];
+    uint8_t Vverifier[kMAX_Hash_Length];
+    size_t len;
+    uint64_t start, elapsed;
+
+    Spake2p_P256_SHA256_HKDF_HMAC Verifier;
+    Spake2p_P256_SHA256_HKDF_HMAC Prover;
+
+    error = Verifier.Init(vector->context, vector->context_len);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    error = Verifier.ComputeL(L, &L_len, vector->w1, vector->w1_len);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        SuccessOrExit(error = Prover.Init(vector->context, vector->context_len));
+        SuccessOrExit(error = Prover.BeginProver(nullptr, 0, nullptr, 0, vector->w0, vector->w0_len, vector->w1, vector->w1_len));
+        len = sizeof(X);
+        SuccessOrExit(error = Prover.ComputeRoundOne(X, &len));
+
+        SuccessOrExit(error = Verifier.Init(vector->context, vector->context_len));
+        SuccessOrExit(error = Verifier.BeginVerifier(nullptr, 0, nullptr, 0, vector->w0, vector->w0_len, L, L_len));
+        len = sizeof(Y);
+        SuccessOrExit(error = Verifier.ComputeRoundOne(Y, &len));
+        len = sizeof(Vverifier);
+        SuccessOrExit(error = Verifier.ComputeRoundTwo(X, sizeof(X), Vverifier, &len));
+
+        len = sizeof(Pverifier);
+        SuccessOrExit(error = Prover.ComputeRoundTwo(Y, sizeof(Y), Pverifier, &len));
+
+        SuccessOrExit(error = Prover.KeyConfirm(Vverifier, sizeof(Vverifier)));
+        SuccessOrExit(error = Verifier.KeyConfirm(Pverifier, sizeof(Pverifier)));
+    }
+    elapsed = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    printf("SPAKE2+ P-256: %" PRIu64 " prover/verifier exchanges per second\n",
+           elapsed ? static_cast<uint64_t>(kIterations) * 1000000 / elapsed : 0);
+
+exit:
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+}
+
 namespace chip {
 namespace Logging {
 void __attribute__((weak)) LogV(uint8_t module, uint8_t category, const char * format, va_list argptr)
@@ -1390,6 +1960,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid key", TestAES_CCM_256DecryptInvalidKey),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid IV", TestAES_CCM_256DecryptInvalidIVLen),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid vectors", TestAES_CCM_256DecryptInvalidTestVectors),
+    NL_TEST_DEF("Test AES-CCM-128 batches of test vectors", TestAES_CCM_128BatchTestVectors),
+    NL_TEST_DEF("Test AES-CCM batches against single messages", TestAES_CCM_BatchMatchesSingleMessages),
+    NL_TEST_DEF("Test AES-CCM batch benchmark", TestAES_CCM_BatchBenchmark),
     NL_TEST_DEF("Test ECDSA signing and validation message using SHA256", TestECDSA_Signing_SHA256_Msg),
     NL_TEST_DEF("Test ECDSA signing and validation SHA256 Hash", TestECDSA_Signing_SHA256_Hash),
     NL_TEST_DEF("Test ECDSA signature validation fail - Different msg", TestECDSA_ValidationFailsDifferentMessage),
@@ -1400,25 +1973,35 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test ECDSA sign hash invalid parameters", TestECDSA_SigningHashInvalidParams),
     NL_TEST_DEF("Test ECDSA msg signature validation invalid parameters", TestECDSA_ValidationMsgInvalidParam),
     NL_TEST_DEF("Test ECDSA hash signature validation invalid parameters", TestECDSA_ValidationHashInvalidParam),
+    NL_TEST_DEF("Test ECDSA batch msg signature validation", TestECDSA_ValidateMsgSignatures),
+    NL_TEST_DEF("Test ECDSA concurrent signature validation", TestECDSA_ValidateConcurrently),
     NL_TEST_DEF("Test Hash SHA 256", TestHash_SHA256),
     NL_TEST_DEF("Test Hash SHA 256 Stream", TestHash_SHA256_Stream),
     NL_TEST_DEF("Test HKDF SHA 256", TestHKDF_SHA256),
     NL_TEST_DEF("Test DRBG invalid inputs", TestDRBG_InvalidInputs),
     NL_TEST_DEF("Test DRBG output", TestDRBG_Output),
+    NL_TEST_DEF("Test DRBG pooled output", TestDRBG_PooledOutput),
+#if CHIP_CONFIG_RANDOM_POOL_SIZE > 0
+    NL_TEST_DEF("Test DRBG pool fork safety", TestDRBG_PoolForkSafety),
+    NL_TEST_DEF("Test DRBG pool benchmark", TestDRBG_PoolBenchmark),
+#endif
     NL_TEST_DEF("Test ECDH derive shared secret", TestECDH_EstablishSecret),
     NL_TEST_DEF("Test adding entropy sources", TestAddEntropySources),
     NL_TEST_DEF("Test PBKDF2 SHA256", TestPBKDF2_SHA256_TestVectors),
     NL_TEST_DEF("Test P256 Keygen", TestP256_Keygen),
     NL_TEST_DEF("Test CSR Generation", TestCSR_Gen),
     NL_TEST_DEF("Test Keypair Serialize", TestKeypair_Serialize),
+    NL_TEST_DEF("Test ECDSA benchmark", TestECDSA_Benchmark),
     NL_TEST_DEF("Test Spake2p_spake2p FEMul", TestSPAKE2P_spake2p_FEMul),
     NL_TEST_DEF("Test Spake2p_spake2p FELoad/FEWrite", TestSPAKE2P_spake2p_FELoadWrite),
     NL_TEST_DEF("Test Spake2p_spake2p Mac", TestSPAKE2P_spake2p_Mac),
     NL_TEST_DEF("Test Spake2p_spake2p PointMul", TestSPAKE2P_spake2p_PointMul),
     NL_TEST_DEF("Test Spake2p_spake2p PointMulAdd", TestSPAKE2P_spake2p_PointMulAdd),
+    NL_TEST_DEF("Test Spake2p_spake2p PointAddMulMN", TestSPAKE2P_spake2p_PointAddMulMN),
     NL_TEST_DEF("Test Spake2p_spake2p PointLoad/PointWrite", TestSPAKE2P_spake2p_PointLoadWrite),
     NL_TEST_DEF("Test Spake2p_spake2p PointIsValid", TestSPAKE2P_spake2p_PointIsValid),
     NL_TEST_DEF("Test Spake2+ against RFC test vectors", TestSPAKE2P_RFC),
+    NL_TEST_DEF("Test Spake2+ benchmark", TestSPAKE2P_Benchmark),
     NL_TEST_SENTINEL()
 };
 
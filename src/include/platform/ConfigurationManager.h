@@ -110,6 +110,10 @@ public:
     CHIP_ERROR StoreServiceConfig(const uint8_t * serviceConfig, size_t serviceConfigLen);
     CHIP_ERROR StorePairedAccountId(const char * accountId, size_t accountIdLen);
 
+    // Writes between BeginWriteBatch() and CommitWriteBatch() are committed to storage at once.
+    CHIP_ERROR BeginWriteBatch();
+    CHIP_ERROR CommitWriteBatch();
+
     CHIP_ERROR GetQRCodeString(char * buf, size_t bufSize);
 
     CHIP_ERROR GetWiFiAPSSID(char * buf, size_t bufSize);
@@ -433,6 +437,16 @@ inline CHIP_ERROR ConfigurationManager::StorePairedAccountId(const char * accoun
     return static_cast<ImplClass *>(this)->_StorePairedAccountId(accountId, accountIdLen);
 }
 
+inline CHIP_ERROR ConfigurationManager::BeginWriteBatch()
+{
+    return static_cast<ImplClass *>(this)->_BeginWriteBatch();
+}
+
+inline CHIP_ERROR ConfigurationManager::CommitWriteBatch()
+{
+    return static_cast<ImplClass *>(this)->_CommitWriteBatch();
+}
+
 inline CHIP_ERROR ConfigurationManager::ReadPersistedStorageValue(::chip::Platform::PersistedStorage::Key key, uint32_t & value)
 {
     return static_cast<ImplClass *>(this)->_ReadPersistedStorageValue(key, value);
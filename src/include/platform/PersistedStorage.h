@@ -87,6 +87,35 @@ CHIP_ERROR Read(Key aKey, uint32_t & aValue);
  */
 CHIP_ERROR Write(Key aKey, uint32_t aValue);
 
+/**
+ *  @brief
+ *    Start a write batch.  Until the matching CommitWriteBatch(), the
+ *    platform may keep written values in memory instead of committing each
+ *    of them to storage, and then commits them all at once.  Batches can be
+ *    nested; only the outermost CommitWriteBatch() commits.
+ *
+ *    Values written in a batch are read back at once, but are lost if the
+ *    device restarts before the batch is committed: a counter that reaches
+ *    a new epoch in a batch must not be relied upon until then.
+ *
+ *    On platforms with threads, a batch covers the writes of the thread
+ *    that opened it, which must also be the one to commit it.
+ *
+ *  @return CHIP_NO_ERROR, or a platform error if the batch cannot be started.
+ */
+CHIP_ERROR BeginWriteBatch();
+
+/**
+ *  @brief
+ *    End a write batch started by BeginWriteBatch(), committing the values
+ *    written in it if it is the outermost one.
+ *
+ *  @return CHIP_ERROR_INCORRECT_STATE if no batch is open, on platforms that batch writes
+ *          Any error returned by the commit to persistent storage.
+ *          CHIP_NO_ERROR otherwise
+ */
+CHIP_ERROR CommitWriteBatch();
+
 } // namespace PersistedStorage
 } // namespace Platform
 } // namespace chip
@@ -518,11 +518,18 @@ CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreDevicePrivateKey(co
 template <class ImplClass>
 CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_ClearOperationalDeviceCredentials(void)
 {
+    bool batchOpen = (Impl()->_BeginWriteBatch() == CHIP_NO_ERROR);
+
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDeviceId);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDeviceCert);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDeviceICACerts);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDevicePrivateKey);
 
+    if (batchOpen)
+    {
+        Impl()->_CommitWriteBatch();
+    }
+
     ClearFlag(mFlags, kFlag_OperationalDeviceCredentialsProvisioned);
 
     return CHIP_NO_ERROR;
@@ -689,6 +696,12 @@ CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreServiceProvisioning
                                                                                      const char * accountId, size_t accountIdLen)
 {
     CHIP_ERROR err;
+    bool batchOpen = false;
+
+    // The provisioning data is committed to storage at once.
+    err = Impl()->_BeginWriteBatch();
+    SuccessOrExit(err);
+    batchOpen = true;
 
     err = Impl()->WriteConfigValue(ImplClass::kConfigKey_ServiceId, serviceId);
     SuccessOrExit(err);
@@ -699,6 +712,10 @@ CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreServiceProvisioning
     err = _StorePairedAccountId(accountId, accountIdLen);
     SuccessOrExit(err);
 
+    batchOpen = false;
+    err       = Impl()->_CommitWriteBatch();
+    SuccessOrExit(err);
+
     SetFlag(mFlags, kFlag_IsServiceProvisioned);
     SetFlag(mFlags, kFlag_IsPairedToAccount, (accountId != nullptr && accountIdLen != 0));
 
@@ -711,16 +728,27 @@ exit:
         ClearFlag(mFlags, kFlag_IsServiceProvisioned);
         ClearFlag(mFlags, kFlag_IsPairedToAccount);
     }
+    if (batchOpen)
+    {
+        Impl()->_CommitWriteBatch();
+    }
     return err;
 }
 
 template <class ImplClass>
 CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_ClearServiceProvisioningData()
 {
+    bool batchOpen = (Impl()->_BeginWriteBatch() == CHIP_NO_ERROR);
+
     Impl()->ClearConfigValue(ImplClass::kConfigKey_ServiceId);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_ServiceConfig);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_PairedAccountId);
 
+    if (batchOpen)
+    {
+        Impl()->_CommitWriteBatch();
+    }
+
     // TODO: Move these behaviors out of configuration manager.
 
     // If necessary, post an event alerting other subsystems to the change in
@@ -762,6 +790,19 @@ CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_SetFailSafeArmed(bool va
     return Impl()->WriteConfigValue(ImplClass::kConfigKey_FailSafeArmed, val);
 }
 
+// By default, every write is committed by itself, so there is nothing to batch.
+template <class ImplClass>
+CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_BeginWriteBatch()
+{
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_CommitWriteBatch()
+{
+    return CHIP_NO_ERROR;
+}
+
 template <class ImplClass>
 CHIP_ERROR GenericConfigurationManagerImpl<ImplClass>::_GetQRCodeString(char * buf, size_t bufSize)
 {
@@ -96,6 +96,8 @@ public:
     CHIP_ERROR _StoreServiceProvisioningData(uint64_t serviceId, const uint8_t * serviceConfig, size_t serviceConfigLen,
                                              const char * accountId, size_t accountIdLen);
     CHIP_ERROR _ClearServiceProvisioningData();
+    CHIP_ERROR _BeginWriteBatch();
+    CHIP_ERROR _CommitWriteBatch();
     CHIP_ERROR _GetFailSafeArmed(bool & val);
     CHIP_ERROR _SetFailSafeArmed(bool val);
     CHIP_ERROR _GetQRCodeString(char * buf, size_t bufSize);
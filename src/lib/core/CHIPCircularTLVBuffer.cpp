@@ -72,6 +72,37 @@ CHIPCircularTLVBuffer::CHIPCircularTLVBuffer(uint8_t * inBuffer, uint32_t inBuff
     mImplicitProfileId = kCommonProfileId;
 }
 
+/**
+ * @brief
+ *   CHIPCircularTLVBuffer constructor for a backing store that already
+ *   holds TLV elements, e.g. one that persists across restarts.
+ *
+ * @param[in] inBuffer       A pointer to the backing store for the queue
+ *
+ * @param[in] inBufferLength Length, in bytes, of the backing store
+ *
+ * @param[in] inHead         Position of the oldest element in the queue.  The @a inHead pointer must fall within the backing
+ * store for the circular buffer, i.e. within @a inBuffer and &(@a inBuffer[@a inBufferLength])
+ *
+ * @param[in] inDataLength   Length, in bytes, of the elements already in the queue, starting at @a inHead.  It must not
+ * exceed @a inBufferLength.
+ */
+CHIPCircularTLVBuffer::CHIPCircularTLVBuffer(uint8_t * inBuffer, uint32_t inBufferLength, uint8_t * inHead, uint32_t inDataLength)
+{
+    mQueue       = inBuffer;
+    mQueueSize   = inBufferLength;
+    mQueueLength = inDataLength;
+    mQueueHead   = inHead;
+
+    mProcessEvictedElement = nullptr;
+    mAppData               = nullptr;
+
+    // use common as opposed to unspecified, s.t. the reader that
+    // skips over the elements does not complain about implicit
+    // profile tags.
+    mImplicitProfileId = kCommonProfileId;
+}
+
 /**
  * @brief
  *   CHIPCircularTLVBuffer constructor
@@ -59,6 +59,7 @@ class DLL_EXPORT CHIPCircularTLVBuffer
 public:
     CHIPCircularTLVBuffer(uint8_t * inBuffer, uint32_t inBufferLength);
     CHIPCircularTLVBuffer(uint8_t * inBuffer, uint32_t inBufferLength, uint8_t * inHead);
+    CHIPCircularTLVBuffer(uint8_t * inBuffer, uint32_t inBufferLength, uint8_t * inHead, uint32_t inDataLength);
 
     CHIP_ERROR GetNewBuffer(TLVWriter & ioWriter, uint8_t *& outBufStart, uint32_t & outBufLen);
     CHIP_ERROR FinalizeBuffer(TLVWriter & ioWriter, uint8_t * inBufStart, uint32_t inBufLen);
@@ -711,6 +711,37 @@
 #define CHIP_CONFIG_DEV_RANDOM_DEVICE_NAME                 "/dev/urandom"
 #endif // CHIP_CONFIG_DEV_RANDOM_DEVICE_NAME
 
+/**
+ *  @def CHIP_CONFIG_RANDOM_POOL_SIZE
+ *
+ *  @brief
+ *    Size, in bytes, of the per-thread buffer of DRBG output from
+ *    which chip::Crypto::DRBG_get_pooled_bytes() serves small
+ *    requests.  Zero disables the pool, and every request then goes
+ *    to the DRBG directly.
+ *
+ *  @note A non-zero value requires #CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+ *        and compiler support for thread-local storage.
+ *
+ */
+#ifndef CHIP_CONFIG_RANDOM_POOL_SIZE
+#define CHIP_CONFIG_RANDOM_POOL_SIZE                       0
+#endif // CHIP_CONFIG_RANDOM_POOL_SIZE
+
+/**
+ *  @def CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL
+ *
+ *  @brief
+ *    Number of refills of the random pools after which the DRBG is
+ *    reseeded from its entropy sources.
+ *
+ *  @note Only meaningful when #CHIP_CONFIG_RANDOM_POOL_SIZE is non-zero.
+ *
+ */
+#ifndef CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL
+#define CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL            4096
+#endif // CHIP_CONFIG_RANDOM_POOL_RESEED_INTERVAL
+
 
 
 /**
@@ -2272,6 +2303,44 @@
 #define CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS      5000
 #endif // CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS
 
+/**
+ * @def CHIP_CONFIG_MDNS_CACHE_SIZE
+ *
+ * @brief Number of mDNS records the native mDNS server keeps in its cache.
+ */
+#ifndef CHIP_CONFIG_MDNS_CACHE_SIZE
+#define CHIP_CONFIG_MDNS_CACHE_SIZE                          16
+#endif // CHIP_CONFIG_MDNS_CACHE_SIZE
+
+/**
+ * @def CHIP_CONFIG_MDNS_MAX_SERVICES
+ *
+ * @brief Number of services the native mDNS server can publish at once.
+ */
+#ifndef CHIP_CONFIG_MDNS_MAX_SERVICES
+#define CHIP_CONFIG_MDNS_MAX_SERVICES                        2
+#endif // CHIP_CONFIG_MDNS_MAX_SERVICES
+
+/**
+ * @def CHIP_CONFIG_MDNS_MAX_QUERIES
+ *
+ * @brief Number of browse and resolve operations the native mDNS server can
+ * run at once.
+ */
+#ifndef CHIP_CONFIG_MDNS_MAX_QUERIES
+#define CHIP_CONFIG_MDNS_MAX_QUERIES                         4
+#endif // CHIP_CONFIG_MDNS_MAX_QUERIES
+
+/**
+ * @def CHIP_CONFIG_MDNS_NODE_ADDRESS_CACHE_SIZE
+ *
+ * @brief Number of operational node addresses the mDNS node address cache
+ * keeps.  The least recently used address is dropped to make room.
+ */
+#ifndef CHIP_CONFIG_MDNS_NODE_ADDRESS_CACHE_SIZE
+#define CHIP_CONFIG_MDNS_NODE_ADDRESS_CACHE_SIZE             8
+#endif // CHIP_CONFIG_MDNS_NODE_ADDRESS_CACHE_SIZE
+
 /**
    *  @def CHIP_CONFIG_MAX_BINDINGS
    *
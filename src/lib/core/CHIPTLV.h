@@ -152,6 +152,7 @@ public:
     uintptr_t GetBufHandle() const { return mBufHandle; }
 
     CHIP_ERROR Skip();
+    CHIP_ERROR JumpToMember(const TLVReader & containerReader, uint32_t memberOffset);
 
     uint32_t ImplicitProfileId;
     void * AppData;
@@ -218,6 +219,8 @@ public:
     void Init(uint8_t * buf, uint32_t maxLen);
     void Init(PacketBuffer * buf, uint32_t maxLen = 0xFFFFFFFFUL);
     void Init(PacketBuffer * buf, uint32_t maxLen, bool allowDiscontiguousBuffers);
+    void Init(PacketBuffer * buf, uint32_t maxLen, bool allowDiscontiguousBuffers, uint16_t reservedSize,
+              uint16_t reservedTailSize);
 
     CHIP_ERROR Finalize();
 
@@ -282,6 +285,7 @@ protected:
     uint32_t mRemainingLen;
     uint32_t mLenWritten;
     uint32_t mMaxLen;
+    uint16_t mReservedTailSize;
     TLVType mContainerType;
 
 private:
@@ -37,7 +37,61 @@ namespace TLV {
 
 using namespace chip::Encoding;
 
-static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+constexpr uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
+namespace {
+
+/**
+ * The shape of an element head, as implied by its control byte.
+ */
+struct ControlByteInfo
+{
+    uint8_t mHeadLength;     // Control byte, tag, and length or value field. 0 if the element type is invalid.
+    uint8_t mTagLength;      // Number of bytes in the tag field.
+    uint8_t mLenOrValLength; // Number of bytes in the length or value field.
+};
+
+constexpr uint8_t LenOrValLength(uint8_t elementType)
+{
+    // Integers, floating point numbers and the length of strings take 1, 2, 4 or 8 bytes, as given by the low
+    // two bits of the type.  Booleans, nulls and containers have no length or value field.
+    return (elementType <= static_cast<uint8_t>(TLVElementType::UInt64) ||
+            (elementType >= static_cast<uint8_t>(TLVElementType::FloatingPointNumber32) &&
+             elementType <= static_cast<uint8_t>(TLVElementType::ByteString_8ByteLength)))
+        ? static_cast<uint8_t>(1 << (elementType & kTLVTypeSizeMask))
+        : 0;
+}
+
+/**
+ * Element head shapes for all 256 control bytes, computed at compile time.
+ */
+class ControlByteTable
+{
+public:
+    constexpr ControlByteTable() : mEntries()
+    {
+        for (uint16_t controlByte = 0; controlByte <= UINT8_MAX; controlByte++)
+        {
+            const uint8_t elementType = static_cast<uint8_t>(controlByte & kTLVTypeMask);
+            const uint8_t tagLength   = sTagSizes[controlByte >> kTLVTagControlShift];
+            const uint8_t valLength   = LenOrValLength(elementType);
+
+            const bool valid          = (elementType <= static_cast<uint8_t>(TLVElementType::EndOfContainer));
+
+            mEntries[controlByte] = ControlByteInfo{ static_cast<uint8_t>(valid ? 1 + tagLength + valLength : 0), tagLength,
+                                                     valLength };
+        }
+    }
+
+    const ControlByteInfo & operator[](uint8_t controlByte) const { return mEntries[controlByte]; }
+
+private:
+    ControlByteInfo mEntries[UINT8_MAX + 1];
+};
+
+constexpr ControlByteTable sControlByteTable;
+
+} // namespace
 
 /**
  * @fn uint32_t TLVReader::GetLengthRead() const
@@ -1198,6 +1252,63 @@ CHIP_ERROR TLVReader::Skip()
     return CHIP_NO_ERROR;
 }
 
+/**
+ * Positions the TLVReader object on a member of a container, given the offset of the member.
+ *
+ * After the call, the reader is in the same state as if it had been initialized from @p containerReader,
+ * entered the container with EnterContainer() and advanced with Next() until it reached the member
+ * whose control byte is at @p memberOffset.  Subsequent calls to Next() continue with the following
+ * members of the container.
+ *
+ * Member offsets are counted from the start of the encoding read by @p containerReader, as reported
+ * by GetLengthRead() immediately before the member.  They are typically produced by
+ * chip::TLV::Utilities::Index().  Within a single buffer the jump costs no parsing; if the reader reads
+ * from a chain of buffers, the bytes in between are skipped without being decoded.
+ *
+ * @param[in] containerReader           A reader positioned on the container element.
+ * @param[in] memberOffset              The offset of the control byte of the member.
+ *
+ * @retval #CHIP_NO_ERROR              If the reader was successfully positioned on the member.
+ * @retval #CHIP_END_OF_TLV            If @p memberOffset is the offset of the end of the container.
+ * @retval #CHIP_ERROR_INCORRECT_STATE If @p containerReader is not positioned on a container element.
+ * @retval #CHIP_ERROR_INVALID_ARGUMENT
+ *                                      If @p memberOffset lies before the first member of the container.
+ * @retval #CHIP_ERROR_TLV_UNDERRUN    If @p memberOffset lies beyond the end of the encoding.
+ * @retval #CHIP_ERROR_INVALID_TLV_ELEMENT
+ *                                      If there is no valid TLV element at @p memberOffset.
+ * @retval other                        Other CHIP or platform error codes returned by the configured
+ *                                      GetNextBuffer() function. Only possible when GetNextBuffer is
+ *                                      non-NULL.
+ *
+ */
+CHIP_ERROR TLVReader::JumpToMember(const TLVReader & containerReader, uint32_t memberOffset)
+{
+    CHIP_ERROR err;
+    TLVType outerContainerType;
+
+    if (memberOffset < containerReader.mLenRead)
+        return CHIP_ERROR_INVALID_ARGUMENT;
+
+    Init(containerReader);
+
+    err = EnterContainer(outerContainerType);
+    if (err != CHIP_NO_ERROR)
+        return err;
+
+    err = ReadData(nullptr, memberOffset - mLenRead);
+    if (err != CHIP_NO_ERROR)
+        return err;
+
+    err = ReadElement();
+    if (err != CHIP_NO_ERROR)
+        return err;
+
+    if (ElementType() == TLVElementType::EndOfContainer)
+        return CHIP_END_OF_TLV;
+
+    return CHIP_NO_ERROR;
+}
+
 /**
  * Clear the state of the TLVReader.
  * This method is used to position the reader before the first TLV,
@@ -1281,42 +1392,30 @@ CHIP_ERROR TLVReader::ReadElement()
     CHIP_ERROR err;
     uint8_t stagingBuf[17]; // 17 = 1 control byte + 8 tag bytes + 8 length/value bytes
     const uint8_t * p;
-    TLVElementType elemType;
 
     // Make sure we have input data. Return CHIP_END_OF_TLV if no more data is available.
-    err = EnsureData(CHIP_END_OF_TLV);
-    if (err != CHIP_NO_ERROR)
-        return err;
+    if (mReadPoint == mBufEnd)
+    {
+        err = EnsureData(CHIP_END_OF_TLV);
+        if (err != CHIP_NO_ERROR)
+            return err;
+    }
 
     // Get the element's control byte.
     mControlByte = *mReadPoint;
 
-    // Extract the element type from the control byte. Fail if it's invalid.
-    elemType = ElementType();
-    if (!IsValidTLVType(elemType))
+    // Look up the shape of the element's 'head'. This includes: the control byte, the tag bytes (if present), the length
+    // bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes. Fail if the element
+    // type is invalid.
+    const ControlByteInfo & info = sControlByteTable[static_cast<uint8_t>(mControlByte)];
+    if (info.mHeadLength == 0)
         return CHIP_ERROR_INVALID_TLV_ELEMENT;
 
-    // Extract the tag control from the control byte.
-    TLVTagControl tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
-
-    // Determine the number of bytes in the element's tag, if any.
-    uint8_t tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
-
-    // Extract the size of length/value field from the control byte.
-    TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
-
-    // Determine the number of bytes in the length/value field.
-    uint8_t valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
-
-    // Determine the number of bytes in the element's 'head'. This includes: the control byte, the tag bytes (if present), the
-    // length bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes.
-    uint8_t elemHeadBytes = static_cast<uint8_t>(1 + tagBytes + valOrLenBytes);
-
     // If the head of the element overlaps the end of the input buffer, read the bytes into the staging buffer
     // and arrange to parse them from there. Otherwise read them directly from the input buffer.
-    if (elemHeadBytes > (mBufEnd - mReadPoint))
+    if (info.mHeadLength > (mBufEnd - mReadPoint))
     {
-        err = ReadData(stagingBuf, elemHeadBytes);
+        err = ReadData(stagingBuf, info.mHeadLength);
         if (err != CHIP_NO_ERROR)
             return err;
         p = stagingBuf;
@@ -1324,32 +1423,36 @@ CHIP_ERROR TLVReader::ReadElement()
     else
     {
         p = mReadPoint;
-        mReadPoint += elemHeadBytes;
-        mLenRead += elemHeadBytes;
+        mReadPoint += info.mHeadLength;
+        mLenRead += info.mHeadLength;
     }
 
     // Skip over the control byte.
     p++;
 
-    // Read the tag field, if present.
-    mElemTag = ReadTag(tagControl, p);
+    // Read the tag field, if present. Context tags are by far the most common, so decode them inline.
+    TLVTagControl tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
+    if (tagControl == TLVTagControl::ContextSpecific)
+        mElemTag = ContextTag(Read8(p));
+    else
+        mElemTag = ReadTag(tagControl, p);
 
     // Read the length/value field, if present.
-    switch (lenOrValFieldSize)
+    switch (info.mLenOrValLength)
     {
-    case kTLVFieldSize_0Byte:
+    case 0:
         mElemLenOrVal = 0;
         break;
-    case kTLVFieldSize_1Byte:
+    case 1:
         mElemLenOrVal = Read8(p);
         break;
-    case kTLVFieldSize_2Byte:
+    case 2:
         mElemLenOrVal = LittleEndian::Read16(p);
         break;
-    case kTLVFieldSize_4Byte:
+    case 4:
         mElemLenOrVal = LittleEndian::Read32(p);
         break;
-    case kTLVFieldSize_8Byte:
+    case 8:
         mElemLenOrVal = LittleEndian::Read64(p);
         break;
     }
@@ -0,0 +1,556 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines templates that generate CHIP TLV encoders and
+ *      decoders for C++ structs from a compile-time description of their
+ *      fields.
+ *
+ *      A schema lists the fields of a struct as (context tag, member)
+ *      pairs; the TLV type of each field follows from the C++ type of the
+ *      member:
+ *
+ *      @code
+ *      struct Credentials
+ *      {
+ *          uint16_t vendorId;
+ *          uint64_t nodeId;
+ *          bool commissioned;
+ *          char label[33];
+ *      };
+ *
+ *      using CredentialsSchema = chip::TLV::Schema::StructSchema<Credentials,
+ *          CHIP_TLV_SCHEMA_FIELD(Credentials, 1, vendorId),
+ *          CHIP_TLV_SCHEMA_FIELD(Credentials, 2, nodeId),
+ *          CHIP_TLV_SCHEMA_FIELD(Credentials, 3, commissioned),
+ *          CHIP_TLV_SCHEMA_FIELD(Credentials, 4, label)>;
+ *
+ *      uint8_t buf[CredentialsSchema::kMaxEncodedSize];
+ *      writer.Init(buf, sizeof(buf));
+ *      err = CredentialsSchema::Encode(writer, AnonymousTag, credentials);
+ *      @endcode
+ *
+ *      Integers are always encoded at the full width of their member, so
+ *      the encoded size of a struct without strings is a compile-time
+ *      constant and kMaxEncodedSize is exact.
+ *
+ *      Decoding walks the fields in schema order and only compares the tag
+ *      of each element with the tag the schema expects next.  Encodings
+ *      whose elements are out of order, or which contain unknown elements,
+ *      are still accepted; the remaining elements are then looked up in a
+ *      table of the schema's tags.
+ *
+ *      A schema only fits a structure whose fields are known at compile
+ *      time.  Encodings with elements chosen at run time, such as the
+ *      optional vendor data of a QR code, or with arrays of structures, such
+ *      as the fabric keys of a fabric configuration, are still read and
+ *      written with TLVReader and TLVWriter directly.  So are encodings that
+ *      must keep the minimal integer widths chosen by TLVWriter::Put.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+#include <core/CHIPTLV.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+
+namespace chip {
+namespace TLV {
+
+/**
+ *   @namespace chip::TLV::Schema
+ *
+ *   @brief
+ *     This namespace includes templates that generate CHIP TLV encoders and
+ *     decoders from a compile-time description of a struct.
+ *
+ */
+namespace Schema {
+
+/**
+ * Number of bytes taken by the tag of a context-tagged element.
+ */
+constexpr uint32_t kContextTagLength = 1;
+
+/**
+ * Number of bytes used by CHIP TLV to encode the length of a string of the
+ * given length.
+ */
+constexpr uint32_t StringLengthFieldSize(uint64_t len)
+{
+    return (len <= UINT8_MAX) ? 1 : ((len <= UINT16_MAX) ? 2 : 4);
+}
+
+namespace Internal {
+
+template <size_t Size, bool Signed>
+struct WireInteger;
+
+template <>
+struct WireInteger<1, true>
+{
+    typedef int8_t Type;
+};
+template <>
+struct WireInteger<2, true>
+{
+    typedef int16_t Type;
+};
+template <>
+struct WireInteger<4, true>
+{
+    typedef int32_t Type;
+};
+template <>
+struct WireInteger<8, true>
+{
+    typedef int64_t Type;
+};
+template <>
+struct WireInteger<1, false>
+{
+    typedef uint8_t Type;
+};
+template <>
+struct WireInteger<2, false>
+{
+    typedef uint16_t Type;
+};
+template <>
+struct WireInteger<4, false>
+{
+    typedef uint32_t Type;
+};
+template <>
+struct WireInteger<8, false>
+{
+    typedef uint64_t Type;
+};
+
+template <typename T, bool IsEnum = std::is_enum<T>::value>
+struct IntegerOf
+{
+    typedef T Type;
+};
+
+template <typename T>
+struct IntegerOf<T, true>
+{
+    typedef typename std::underlying_type<T>::type Type;
+};
+
+} // namespace Internal
+
+/**
+ * Encodes and decodes a value of type T as a single TLV element.
+ *
+ * Every specialization provides:
+ *  - kMaxEncodedSize: the largest encoding of an anonymous element.
+ *  - kIsFixedSize: true if every value encodes to kMaxEncodedSize bytes.
+ *  - EncodedSize(v): the exact encoding of v as an anonymous element.
+ *  - Encode(writer, tag, v) and Decode(reader, v), the latter with the reader
+ *    positioned on the element.
+ *
+ * StructSchema follows the same interface, so a schema can be used as the
+ * codec of a nested struct.
+ */
+template <typename T, typename Enable = void>
+struct FieldCodec;
+
+/**
+ * Integers and enums are encoded at the full width of their type.
+ */
+template <typename T>
+struct FieldCodec<T, typename std::enable_if<(std::is_integral<T>::value || std::is_enum<T>::value) && !std::is_same<T, bool>::value>::type>
+{
+    typedef typename Internal::IntegerOf<T>::Type IntegerType;
+    typedef typename Internal::WireInteger<sizeof(IntegerType), std::is_signed<IntegerType>::value>::Type WireType;
+
+    static constexpr uint32_t kMaxEncodedSize = 1 + sizeof(WireType);
+    static constexpr bool kIsFixedSize        = true;
+
+    static uint32_t EncodedSize(const T & v) { return kMaxEncodedSize; }
+
+    static CHIP_ERROR Encode(TLVWriter & writer, uint64_t tag, const T & v)
+    {
+        return writer.Put(tag, static_cast<WireType>(v), true);
+    }
+
+    static CHIP_ERROR Decode(TLVReader & reader, T & v)
+    {
+        WireType value = 0;
+        CHIP_ERROR err = reader.Get(value);
+        v              = static_cast<T>(value);
+        return err;
+    }
+};
+
+template <>
+struct FieldCodec<bool>
+{
+    static constexpr uint32_t kMaxEncodedSize = 1;
+    static constexpr bool kIsFixedSize        = true;
+
+    static uint32_t EncodedSize(const bool & v) { return kMaxEncodedSize; }
+    static CHIP_ERROR Encode(TLVWriter & writer, uint64_t tag, const bool & v) { return writer.PutBoolean(tag, v); }
+    static CHIP_ERROR Decode(TLVReader & reader, bool & v) { return reader.Get(v); }
+};
+
+template <>
+struct FieldCodec<float>
+{
+    static constexpr uint32_t kMaxEncodedSize = 1 + sizeof(float);
+    static constexpr bool kIsFixedSize        = true;
+
+    static uint32_t EncodedSize(const float & v) { return kMaxEncodedSize; }
+    static CHIP_ERROR Encode(TLVWriter & writer, uint64_t tag, const float & v) { return writer.Put(tag, v); }
+    static CHIP_ERROR Decode(TLVReader & reader, float & v) { return reader.Get(v); }
+};
+
+template <>
+struct FieldCodec<double>
+{
+    static constexpr uint32_t kMaxEncodedSize = 1 + sizeof(double);
+    static constexpr bool kIsFixedSize        = true;
+
+    static uint32_t EncodedSize(const double & v) { return kMaxEncodedSize; }
+    static CHIP_ERROR Encode(TLVWriter & writer, uint64_t tag, const double & v) { return writer.Put(tag, v); }
+    static CHIP_ERROR Decode(TLVReader & reader, double & v) { return reader.Get(v); }
+};
+
+/**
+ * A char array holds a NUL-terminated UTF-8 string of at most N - 1 bytes.
+ */
+template <size_t N>
+struct FieldCodec<char[N]>
+{
+    static_assert(N > 0, "A string field needs room for its terminator");
+
+    static constexpr uint32_t kMaxEncodedSize = static_cast<uint32_t>(1 + StringLengthFieldSize(N - 1) + (N - 1));
+    static constexpr bool kIsFixedSize        = false;
+
+    static uint32_t EncodedSize(const char (&v)[N])
+    {
+        uint32_t len = static_cast<uint32_t>(strnlen(v, N - 1));
+        return 1 + StringLengthFieldSize(len) + len;
+    }
+
+    static CHIP_ERROR Encode(TLVWriter & writer, uint64_t tag, const char (&v)[N])
+    {
+        return writer.PutString(tag, v, static_cast<uint32_t>(strnlen(v, N - 1)));
+    }
+
+    static CHIP_ERROR Decode(TLVReader & reader, char (&v)[N]) { return reader.GetString(v, N); }
+};
+
+/**
+ * A struct member encoded with a context tag.
+ *
+ * Use CHIP_TLV_SCHEMA_FIELD() or CHIP_TLV_SCHEMA_STRUCT_FIELD() rather than
+ * spelling out the template arguments.
+ */
+template <uint8_t TagNum, typename Struct, typename T, T Struct::*Member, typename Codec = FieldCodec<T>>
+struct Field
+{
+    typedef Struct StructType;
+
+    static constexpr uint8_t kTagNum          = TagNum;
+    static constexpr uint32_t kMaxEncodedSize = kContextTagLength + Codec::kMaxEncodedSize;
+    static constexpr bool kIsFixedSize        = Codec::kIsFixedSize;
+
+    static uint32_t EncodedSize(const Struct & s) { return kContextTagLength + Codec::EncodedSize(s.*Member); }
+    static CHIP_ERROR Encode(TLVWriter & writer, const Struct & s) { return Codec::Encode(writer, ContextTag(TagNum), s.*Member); }
+    static CHIP_ERROR Decode(TLVReader & reader, Struct & s) { return Codec::Decode(reader, s.*Member); }
+};
+
+/**
+ * A byte string held in a fixed-size array, with its length in a separate
+ * member.
+ */
+template <uint8_t TagNum, typename Struct, size_t N, uint8_t (Struct::*Data)[N], typename L, L Struct::*Length>
+struct ByteStringField
+{
+    typedef Struct StructType;
+
+    static constexpr uint8_t kTagNum          = TagNum;
+    static constexpr uint32_t kMaxEncodedSize = static_cast<uint32_t>(kContextTagLength + 1 + StringLengthFieldSize(N) + N);
+    static constexpr bool kIsFixedSize        = false;
+
+    static uint32_t EncodedSize(const Struct & s)
+    {
+        uint32_t len = static_cast<uint32_t>(s.*Length);
+        return kContextTagLength + 1 + StringLengthFieldSize(len) + len;
+    }
+
+    static CHIP_ERROR Encode(TLVWriter & writer, const Struct & s)
+    {
+        if (static_cast<size_t>(s.*Length) > N)
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        return writer.PutBytes(ContextTag(TagNum), s.*Data, static_cast<uint32_t>(s.*Length));
+    }
+
+    static CHIP_ERROR Decode(TLVReader & reader, Struct & s)
+    {
+        uint32_t len   = reader.GetLength();
+        CHIP_ERROR err = reader.GetBytes(s.*Data, N);
+        if (err == CHIP_NO_ERROR)
+        {
+            s.*Length = static_cast<L>(len);
+        }
+        return err;
+    }
+};
+
+namespace Internal {
+
+template <typename Struct, typename... Fields>
+struct FieldList;
+
+template <typename Struct>
+struct FieldList<Struct>
+{
+    static constexpr uint32_t kMaxEncodedSize = 0;
+    static constexpr bool kIsFixedSize        = true;
+
+    static uint32_t EncodedSize(const Struct & s) { return 0; }
+    static CHIP_ERROR Encode(TLVWriter & writer, const Struct & s) { return CHIP_NO_ERROR; }
+
+    template <uint32_t Index>
+    static CHIP_ERROR DecodeInOrder(TLVReader & reader, Struct & s, uint32_t & decoded)
+    {
+        return CHIP_NO_ERROR;
+    }
+};
+
+template <typename Struct, typename First, typename... Rest>
+struct FieldList<Struct, First, Rest...>
+{
+    static_assert(std::is_same<typename First::StructType, Struct>::value, "Schema field belongs to another struct");
+
+    typedef FieldList<Struct, Rest...> Next;
+
+    static constexpr uint32_t kMaxEncodedSize = First::kMaxEncodedSize + Next::kMaxEncodedSize;
+    static constexpr bool kIsFixedSize        = First::kIsFixedSize && Next::kIsFixedSize;
+
+    static uint32_t EncodedSize(const Struct & s) { return First::EncodedSize(s) + Next::EncodedSize(s); }
+
+    static CHIP_ERROR Encode(TLVWriter & writer, const Struct & s)
+    {
+        CHIP_ERROR err = First::Encode(writer, s);
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+        return Next::Encode(writer, s);
+    }
+
+    /**
+     * Decodes the fields for as long as the encoding matches the schema order.
+     *
+     * The reader is positioned on the element to decode.  Returns with the
+     * reader positioned on the first element that was not decoded, or with
+     * CHIP_END_OF_TLV once the container has been read.
+     */
+    template <uint32_t Index>
+    static CHIP_ERROR DecodeInOrder(TLVReader & reader, Struct & s, uint32_t & decoded)
+    {
+        if (reader.GetTag() != ContextTag(First::kTagNum))
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        CHIP_ERROR err = First::Decode(reader, s);
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+        decoded |= (1U << Index);
+
+        err = reader.Next();
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+        return Next::template DecodeInOrder<Index + 1>(reader, s, decoded);
+    }
+};
+
+} // namespace Internal
+
+/**
+ * Encodes a struct as a TLV structure whose members are the given fields.
+ *
+ * All fields are required when decoding; elements with context tags that are
+ * not part of the schema are skipped.
+ */
+template <typename Struct, typename... Fields>
+class StructSchema
+{
+public:
+    typedef Internal::FieldList<Struct, Fields...> FieldList;
+
+    static constexpr uint32_t kFieldCount = sizeof...(Fields);
+
+    static_assert(kFieldCount <= 32, "Struct schemas are limited to 32 fields");
+
+    /**
+     * Largest encoding of the struct as an anonymous element: the structure
+     * control byte, the fields, and the end of container marker.  For a
+     * context-tagged struct add kContextTagLength.
+     */
+    static constexpr uint32_t kMaxEncodedSize = 1 + FieldList::kMaxEncodedSize + 1;
+
+    /**
+     * True if every value of the struct encodes to kMaxEncodedSize bytes.
+     */
+    static constexpr bool kIsFixedSize = FieldList::kIsFixedSize;
+
+    /**
+     * Exact size of the encoding of s as an anonymous element.
+     */
+    static uint32_t EncodedSize(const Struct & s) { return 1 + FieldList::EncodedSize(s) + 1; }
+
+    /**
+     * Writes s as a TLV structure with the given tag.
+     */
+    static CHIP_ERROR Encode(TLVWriter & writer, uint64_t tag, const Struct & s)
+    {
+        TLVType outerContainerType;
+        CHIP_ERROR err = writer.StartContainer(tag, kTLVType_Structure, outerContainerType);
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+
+        err = FieldList::Encode(writer, s);
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+
+        return writer.EndContainer(outerContainerType);
+    }
+
+    /**
+     * Reads s from the TLV structure the reader is positioned on.  The reader
+     * is left positioned on that structure.
+     */
+    static CHIP_ERROR Decode(TLVReader & reader, Struct & s)
+    {
+        TLVType outerContainerType;
+        uint32_t decoded = 0;
+        CHIP_ERROR err;
+
+        if (reader.GetType() != kTLVType_Structure)
+        {
+            return CHIP_ERROR_WRONG_TLV_TYPE;
+        }
+
+        err = reader.EnterContainer(outerContainerType);
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+
+        err = reader.Next();
+        if (err == CHIP_NO_ERROR)
+        {
+            err = FieldList::template DecodeInOrder<0>(reader, s, decoded);
+        }
+
+        // Anything left did not follow the schema order.
+        while (err == CHIP_NO_ERROR)
+        {
+            err = DecodeOutOfOrder(reader, s, decoded);
+            if (err == CHIP_NO_ERROR)
+            {
+                err = reader.Next();
+            }
+        }
+
+        if (err != CHIP_END_OF_TLV)
+        {
+            return err;
+        }
+
+        err = reader.ExitContainer(outerContainerType);
+        if (err != CHIP_NO_ERROR)
+        {
+            return err;
+        }
+
+        return (decoded == kAllFields) ? CHIP_NO_ERROR : CHIP_ERROR_MISSING_TLV_ELEMENT;
+    }
+
+private:
+    typedef CHIP_ERROR (*DecodeFunct)(TLVReader & reader, Struct & s);
+
+    static constexpr uint32_t kAllFields = static_cast<uint32_t>((1ULL << kFieldCount) - 1);
+
+    static CHIP_ERROR DecodeOutOfOrder(TLVReader & reader, Struct & s, uint32_t & decoded)
+    {
+        static const uint8_t sTagNums[]      = { Fields::kTagNum..., 0 };
+        static const DecodeFunct sDecoders[] = { &Fields::Decode..., nullptr };
+        const uint64_t tag                   = reader.GetTag();
+
+        if (!IsContextTag(tag))
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        for (uint32_t i = 0; i < kFieldCount; i++)
+        {
+            if (TagNumFromTag(tag) == sTagNums[i])
+            {
+                decoded |= (1U << i);
+                return sDecoders[i](reader, s);
+            }
+        }
+
+        return CHIP_NO_ERROR;
+    }
+};
+
+} // namespace Schema
+} // namespace TLV
+} // namespace chip
+
+/**
+ * Describes a member of a struct encoded with the given context tag number.
+ */
+#define CHIP_TLV_SCHEMA_FIELD(STRUCT, TAG_NUM, MEMBER)                                                                            \
+    ::chip::TLV::Schema::Field<TAG_NUM, STRUCT, decltype(STRUCT::MEMBER), &STRUCT::MEMBER>
+
+/**
+ * Describes a nested struct member encoded with the given schema.
+ */
+#define CHIP_TLV_SCHEMA_STRUCT_FIELD(STRUCT, TAG_NUM, MEMBER, SCHEMA)                                                             \
+    ::chip::TLV::Schema::Field<TAG_NUM, STRUCT, decltype(STRUCT::MEMBER), &STRUCT::MEMBER, SCHEMA>
+
+/**
+ * Describes a byte string member whose length is held in LENGTH_MEMBER.
+ */
+#define CHIP_TLV_SCHEMA_BYTES_FIELD(STRUCT, TAG_NUM, MEMBER, LENGTH_MEMBER)                                                       \
+    ::chip::TLV::Schema::ByteStringField<TAG_NUM, STRUCT, sizeof(STRUCT::MEMBER), &STRUCT::MEMBER,                                \
+                                         decltype(STRUCT::LENGTH_MEMBER), &STRUCT::LENGTH_MEMBER>
@@ -439,6 +439,118 @@ CHIP_ERROR Find(const TLVReader & aReader, IterateHandler aPredicate, void * aCo
     return retval;
 }
 
+/**
+ *  Record the tag, type, offset and length of each member of a TLV container
+ *  in a single pass over the container.
+ *
+ *  Members of nested containers are not indexed; a nested container gets a
+ *  single entry that spans all of its members.  The entries can then be used
+ *  with Find() or TLVReader::JumpToMember() to read a member without parsing
+ *  the ones before it.
+ *
+ *  @param[in]   aReader        A read-only reference to a TLV reader
+ *                              positioned on the container to index.
+ *  @param[out]  aEntries       Storage for the entries, in encoding order.
+ *  @param[in]   aMaxEntries    The number of entries that fit in @a aEntries.
+ *  @param[out]  aCount         The number of entries recorded.
+ *
+ *  @retval  #CHIP_NO_ERROR                 On success.
+ *
+ *  @retval  #CHIP_ERROR_WRONG_TLV_TYPE     If @a aReader is not positioned
+ *                                          on a container.
+ *
+ *  @retval  #CHIP_ERROR_BUFFER_TOO_SMALL   If the container has more than
+ *                                          @a aMaxEntries members.  The
+ *                                          first @a aMaxEntries members are
+ *                                          indexed.
+ *
+ *  @retval  other                          Errors returned while reading the
+ *                                          container.
+ *
+ */
+CHIP_ERROR Index(const TLVReader & aReader, IndexEntry * aEntries, size_t aMaxEntries, size_t & aCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVReader reader;
+    TLVType containerType;
+    uint32_t offset;
+
+    aCount = 0;
+
+    VerifyOrExit(TLVTypeIsContainer(aReader.GetType()), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    reader.Init(aReader);
+
+    err = reader.EnterContainer(containerType);
+    SuccessOrExit(err);
+
+    while (true)
+    {
+        // Skip() leaves the reader right after the previous member, i.e. on
+        // the control byte of the next one.
+        err = reader.Skip();
+        SuccessOrExit(err);
+
+        offset = reader.GetLengthRead();
+
+        if (aCount > 0)
+        {
+            aEntries[aCount - 1].mLength = offset - aEntries[aCount - 1].mOffset;
+        }
+
+        err = reader.Next();
+        if (err == CHIP_END_OF_TLV)
+        {
+            ExitNow(err = CHIP_NO_ERROR);
+        }
+        SuccessOrExit(err);
+
+        VerifyOrExit(aCount < aMaxEntries, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        aEntries[aCount].mTag    = reader.GetTag();
+        aEntries[aCount].mType   = reader.GetType();
+        aEntries[aCount].mOffset = offset;
+        aEntries[aCount].mLength = 0;
+        aCount++;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ *  Search for the specified tag among the members of a container indexed
+ *  with Index(), and position a TLV reader on it.
+ *
+ *  @param[in]   aReader        A read-only reference to the TLV reader that
+ *                              was passed to Index().
+ *  @param[in]   aEntries       The entries recorded by Index().
+ *  @param[in]   aCount         The number of entries recorded by Index().
+ *  @param[in]   aTag           A read-only reference to the TLV tag to find.
+ *  @param[out]  aResult        A reference to storage to a TLV reader which
+ *                              will be positioned at the specified tag
+ *                              on success.
+ *
+ *  @retval  #CHIP_NO_ERROR                    On success.
+ *
+ *  @retval  #CHIP_ERROR_TLV_TAG_NOT_FOUND     If the specified tag @a aTag was not found.
+ *
+ *  @retval  other                             Errors returned by TLVReader::JumpToMember().
+ *
+ */
+CHIP_ERROR Find(const TLVReader & aReader, const IndexEntry * aEntries, size_t aCount, const uint64_t & aTag, TLVReader & aResult)
+{
+    for (size_t i = 0; i < aCount; i++)
+    {
+        if (aEntries[i].mTag == aTag)
+        {
+            return aResult.JumpToMember(aReader, aEntries[i].mOffset);
+        }
+    }
+
+    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+}
+
 } // namespace Utilities
 
 } // namespace TLV
@@ -48,6 +48,21 @@ namespace Utilities {
 
 typedef CHIP_ERROR (*IterateHandler)(const TLVReader & aReader, size_t aDepth, void * aContext);
 
+/**
+ *   @struct IndexEntry
+ *
+ *   @brief
+ *     The location of one member of a TLV container, as recorded by Index().
+ *
+ */
+struct IndexEntry
+{
+    uint64_t mTag;    //!< The tag of the member.
+    TLVType mType;    //!< The type of the member.
+    uint32_t mOffset; //!< The offset of the member's control byte, counted from the start of the encoding.
+    uint32_t mLength; //!< The encoded length of the member, including the members of a nested container.
+};
+
 extern CHIP_ERROR Iterate(const TLVReader & aReader, IterateHandler aHandler, void * aContext);
 extern CHIP_ERROR Iterate(const TLVReader & aReader, IterateHandler aHandler, void * aContext, bool aRecurse);
 
@@ -59,6 +74,10 @@ extern CHIP_ERROR Find(const TLVReader & aReader, const uint64_t & aTag, TLVRead
 
 extern CHIP_ERROR Find(const TLVReader & aReader, IterateHandler aHandler, void * aContext, TLVReader & aResult);
 extern CHIP_ERROR Find(const TLVReader & aReader, IterateHandler aHandler, void * aContext, TLVReader & aResult, bool aRecurse);
+
+extern CHIP_ERROR Index(const TLVReader & aReader, IndexEntry * aEntries, size_t aMaxEntries, size_t & aCount);
+extern CHIP_ERROR Find(const TLVReader & aReader, const IndexEntry * aEntries, size_t aCount, const uint64_t & aTag,
+                       TLVReader & aResult);
 } // namespace Utilities
 
 } // namespace TLV
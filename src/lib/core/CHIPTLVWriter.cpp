@@ -176,6 +176,7 @@ NO_INLINE void TLVWriter::Init(uint8_t * buf, uint32_t maxLen)
     mRemainingLen           = maxLen;
     mLenWritten             = 0;
     mMaxLen                 = maxLen;
+    mReservedTailSize       = 0;
     mContainerType          = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
@@ -205,9 +206,10 @@ void TLVWriter::Init(PacketBuffer * buf, uint32_t maxLen)
     mRemainingLen           = buf->AvailableDataLength();
     if (mRemainingLen > maxLen)
         mRemainingLen = maxLen;
-    mLenWritten    = 0;
-    mMaxLen        = maxLen;
-    mContainerType = kTLVType_NotSpecified;
+    mLenWritten       = 0;
+    mMaxLen           = maxLen;
+    mReservedTailSize = 0;
+    mContainerType    = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
 
@@ -251,6 +253,51 @@ void TLVWriter::Init(PacketBuffer * buf, uint32_t maxLen, bool allowDiscontiguou
     }
 }
 
+/**
+ * Initializes a TLVWriter object to write into one or more PacketBuffers laid out for a protocol
+ * that later prepends headers to, and appends a trailer after, the encoded data.
+ *
+ * If the supplied buffer is empty, its start is first moved so that @p reservedSize bytes are
+ * available in front of it.  No data needs to be moved at this point, so the headers can later be
+ * prepended with PacketBuffer::EnsureReservedSize() without relocating the encoded data.  In every
+ * buffer written to, @p reservedTailSize bytes are left free after the encoded data, so that
+ * whichever buffer ends up last in the chain has room for the trailer (e.g. a message
+ * authentication tag).
+ *
+ * Otherwise this method behaves like Init(PacketBuffer *, uint32_t, bool).
+ *
+ * @note If the supplied buffer is too small for @p reservedSize, its start is left unchanged.
+ *
+ * @param[in]   buf     A pointer to an PacketBuffer into which TLV data should be written.
+ * @param[in]   maxLen  The maximum number of bytes that should be written to the output buffer(s).
+ * @param[in]   allowDiscontiguousBuffers
+ *                      If true, write data to a chain of PacketBuffers, allocating new buffers as
+ *                      needed to store the data written.
+ * @param[in]   reservedSize
+ *                      The number of bytes to reserve in front of the data in an empty buffer.
+ * @param[in]   reservedTailSize
+ *                      The number of bytes to leave free at the end of each buffer.
+ *
+ */
+void TLVWriter::Init(PacketBuffer * buf, uint32_t maxLen, bool allowDiscontiguousBuffers, uint16_t reservedSize,
+                     uint16_t reservedTailSize)
+{
+    if (buf->DataLength() == 0)
+    {
+        buf->EnsureReservedSize(reservedSize);
+    }
+
+    Init(buf, maxLen, allowDiscontiguousBuffers);
+
+    mReservedTailSize = reservedTailSize;
+
+    const uint16_t availableLen = buf->AvailableDataLength();
+    mRemainingLen               = (availableLen > reservedTailSize) ? static_cast<uint32_t>(availableLen - reservedTailSize) : 0;
+
+    if (mRemainingLen > maxLen)
+        mRemainingLen = maxLen;
+}
+
 /**
  * Returns the total number of bytes written since the writer was initialized.
  *
@@ -1202,13 +1249,14 @@ CHIP_ERROR TLVWriter::OpenContainer(uint64_t tag, TLVType containerType, TLVWrit
         ExitNow();
     }
 
-    containerWriter.mBufHandle     = mBufHandle;
-    containerWriter.mBufStart      = mBufStart;
-    containerWriter.mWritePoint    = mWritePoint;
-    containerWriter.mRemainingLen  = mRemainingLen;
-    containerWriter.mLenWritten    = 0;
-    containerWriter.mMaxLen        = mMaxLen - mLenWritten;
-    containerWriter.mContainerType = containerType;
+    containerWriter.mBufHandle        = mBufHandle;
+    containerWriter.mBufStart         = mBufStart;
+    containerWriter.mWritePoint       = mWritePoint;
+    containerWriter.mRemainingLen     = mRemainingLen;
+    containerWriter.mLenWritten       = 0;
+    containerWriter.mMaxLen           = mMaxLen - mLenWritten;
+    containerWriter.mReservedTailSize = mReservedTailSize;
+    containerWriter.mContainerType    = containerType;
     containerWriter.SetContainerOpen(false);
     containerWriter.SetCloseContainerReserved(IsCloseContainerReserved());
     containerWriter.ImplicitProfileId = ImplicitProfileId;
@@ -1861,6 +1909,12 @@ CHIP_ERROR TLVWriter::GetNewPacketBuffer(TLVWriter & writer, uintptr_t & bufHand
         bufHandle = reinterpret_cast<uintptr_t>(newBuf);
         bufStart  = newBuf->Start();
         bufLen    = newBuf->MaxDataLength();
+
+        // Leave room for the trailer requested by Init(), in case this is the last buffer.
+        if (bufLen > writer.mReservedTailSize)
+            bufLen -= writer.mReservedTailSize;
+        else
+            bufLen = 0;
     }
     else
     {
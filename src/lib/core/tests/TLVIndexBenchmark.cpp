@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the CHIP TLV container index. It
+ *      looks up every member of a 4KB structure, through an index built once
+ *      with Utilities::Index() and with Utilities::Find(), and reports the
+ *      time a lookup takes with each.
+ *
+ *      Usage: TLVIndexBenchmark [<rounds>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVUtilities.hpp>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::TLV;
+
+namespace {
+
+constexpr uint8_t kMemberCount    = 150;
+constexpr uint32_t kDefaultRounds = 1000;
+
+uint8_t sBuffer[4096];
+uint32_t sLength;
+
+CHIP_ERROR EncodeStructure()
+{
+    uint8_t value[24];
+    TLVWriter writer;
+    TLVType outerContainerType;
+    CHIP_ERROR err;
+
+    memset(value, 0xA5, sizeof(value));
+
+    writer.Init(sBuffer, sizeof(sBuffer));
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    SuccessOrExit(err);
+    for (uint8_t i = 0; i < kMemberCount; i++)
+    {
+        err = writer.PutBytes(ContextTag(i), value, sizeof(value));
+        SuccessOrExit(err);
+    }
+    err = writer.EndContainer(outerContainerType);
+    SuccessOrExit(err);
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    sLength = writer.GetLengthWritten();
+
+exit:
+    return err;
+}
+
+void Report(const char * lookup, uint32_t lookups, uint64_t elapsedUs)
+{
+    printf("%-8s %8" PRIu32 " lookups %10" PRIu64 " us %8.1f ns/lookup\n", lookup, lookups, elapsedUs,
+           static_cast<double>(elapsedUs) * 1000 / lookups);
+}
+
+CHIP_ERROR Run(uint32_t rounds)
+{
+    Utilities::IndexEntry entries[kMemberCount];
+    size_t count;
+    TLVReader reader, tagReader;
+    uint64_t start;
+    CHIP_ERROR err;
+
+    err = EncodeStructure();
+    SuccessOrExit(err);
+
+    reader.Init(sBuffer, sLength);
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    printf("%u members in a %" PRIu32 " byte structure\n", static_cast<unsigned>(kMemberCount), sLength);
+
+    // The index is built once and covers every lookup.
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    err   = Utilities::Index(reader, entries, kMemberCount, count);
+    for (uint32_t round = 0; round < rounds && err == CHIP_NO_ERROR; round++)
+    {
+        for (uint8_t i = 0; i < kMemberCount && err == CHIP_NO_ERROR; i++)
+        {
+            err = Utilities::Find(reader, entries, count, ContextTag(i), tagReader);
+        }
+    }
+    SuccessOrExit(err);
+    VerifyOrExit(tagReader.GetTag() == ContextTag(kMemberCount - 1), err = CHIP_ERROR_INTERNAL);
+    Report("index", rounds * kMemberCount, System::Platform::Layer::GetClock_MonotonicHiRes() - start);
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t round = 0; round < rounds && err == CHIP_NO_ERROR; round++)
+    {
+        for (uint8_t i = 0; i < kMemberCount && err == CHIP_NO_ERROR; i++)
+        {
+            err = Utilities::Find(reader, ContextTag(i), tagReader);
+        }
+    }
+    SuccessOrExit(err);
+    VerifyOrExit(tagReader.GetTag() == ContextTag(kMemberCount - 1), err = CHIP_ERROR_INTERNAL);
+    Report("Find()", rounds * kMemberCount, System::Platform::Layer::GetClock_MonotonicHiRes() - start);
+
+exit:
+    return err;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    uint32_t rounds = kDefaultRounds;
+    CHIP_ERROR err;
+
+    if (argc > 1)
+    {
+        rounds = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || rounds == 0)
+    {
+        fprintf(stderr, "Usage: %s [<rounds>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    err = Run(rounds);
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Lookup failed: %s\n", ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the CHIP TLV schema codec. It
+ *      encodes and decodes the same struct with the schema codec and with an
+ *      equivalent hand-written codec, and reports the time a round trip
+ *      takes with each.
+ *
+ *      Usage: TLVSchemaBenchmark [<round trips>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <core/CHIPTLV.h>
+#include <support/ErrorStr.h>
+#include <system/SystemClock.h>
+
+#include "TLVSchemaTestPayload.h"
+
+using namespace chip;
+using namespace chip::TLV;
+using namespace chip::Test;
+
+namespace {
+
+constexpr uint32_t kDefaultRoundTrips = 100000;
+
+CHIP_ERROR EncodeWithSchema(TLVWriter & writer, const Payload & payload)
+{
+    return PayloadSchema::Encode(writer, AnonymousTag, payload);
+}
+
+CHIP_ERROR DecodeWithSchema(TLVReader & reader, Payload & payload)
+{
+    return PayloadSchema::Decode(reader, payload);
+}
+
+/**
+ * Encodes and decodes kPayload the given number of times with one codec.
+ * Returns false if a round trip fails or does not give back kPayload.
+ */
+bool TimeRoundTrips(const char * codec, CHIP_ERROR (*encode)(TLVWriter &, const Payload &),
+                    CHIP_ERROR (*decode)(TLVReader &, Payload &), uint32_t roundTrips)
+{
+    uint8_t buf[PayloadSchema::kMaxEncodedSize];
+    TLVWriter writer;
+    TLVReader reader;
+    Payload decoded;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    uint64_t start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    uint64_t elapsedUs;
+
+    for (uint32_t i = 0; i < roundTrips && err == CHIP_NO_ERROR; i++)
+    {
+        writer.Init(buf, sizeof(buf));
+        err = encode(writer, kPayload);
+        reader.Init(buf, sizeof(buf));
+        if (err == CHIP_NO_ERROR)
+            err = reader.Next();
+        if (err == CHIP_NO_ERROR)
+            err = decode(reader, decoded);
+    }
+
+    elapsedUs = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    if (err != CHIP_NO_ERROR || !(decoded == kPayload))
+    {
+        fprintf(stderr, "%s codec round trip failed: %s\n", codec, ErrorStr(err));
+        return false;
+    }
+
+    printf("%-12s %8" PRIu32 " round trips %10" PRIu64 " us %8.1f ns/round trip\n", codec, roundTrips, elapsedUs,
+           static_cast<double>(elapsedUs) * 1000 / roundTrips);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    uint32_t roundTrips = kDefaultRoundTrips;
+
+    if (argc > 1)
+    {
+        roundTrips = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || roundTrips == 0)
+    {
+        fprintf(stderr, "Usage: %s [<round trips>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!TimeRoundTrips("schema", EncodeWithSchema, DecodeWithSchema, roundTrips) ||
+        !TimeRoundTrips("hand-written", EncodePayloadByHand, DecodePayloadByHand, roundTrips))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the reference value and the hand-written codec
+ *      of the struct shared by the TLV schema tests and benchmark.
+ *
+ */
+
+#include "TLVSchemaTestPayload.h"
+
+#include <support/CodeUtils.h>
+
+namespace chip {
+namespace Test {
+
+using namespace chip::TLV;
+
+const Payload kPayload = { 1, 0x235A, 0x4E1F, 20202021, 0x0102030405060708ULL, -42, true, Role::kDevice };
+
+bool operator==(const Payload & a, const Payload & b)
+{
+    return a.version == b.version && a.vendorId == b.vendorId && a.productId == b.productId && a.setupPinCode == b.setupPinCode &&
+        a.nodeId == b.nodeId && a.offset == b.offset && a.commissioned == b.commissioned && a.role == b.role;
+}
+
+CHIP_ERROR EncodePayloadByHand(TLVWriter & writer, const Payload & payload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVType outerContainerType;
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(1), payload.version, true);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(2), payload.vendorId, true);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(3), payload.productId, true);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(4), payload.setupPinCode, true);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(5), payload.nodeId, true);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(6), payload.offset, true);
+    SuccessOrExit(err);
+    err = writer.PutBoolean(ContextTag(7), payload.commissioned);
+    SuccessOrExit(err);
+    err = writer.Put(ContextTag(8), static_cast<uint8_t>(payload.role), true);
+    SuccessOrExit(err);
+    err = writer.EndContainer(outerContainerType);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR DecodePayloadByHand(TLVReader & reader, Payload & payload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVType outerContainerType;
+    uint8_t role;
+
+    err = reader.EnterContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        uint64_t tag = reader.GetTag();
+        if (!IsContextTag(tag))
+        {
+            continue;
+        }
+
+        switch (TagNumFromTag(tag))
+        {
+        case 1:
+            err = reader.Get(payload.version);
+            break;
+        case 2:
+            err = reader.Get(payload.vendorId);
+            break;
+        case 3:
+            err = reader.Get(payload.productId);
+            break;
+        case 4:
+            err = reader.Get(payload.setupPinCode);
+            break;
+        case 5:
+            err = reader.Get(payload.nodeId);
+            break;
+        case 6:
+            err = reader.Get(payload.offset);
+            break;
+        case 7:
+            err = reader.Get(payload.commissioned);
+            break;
+        case 8:
+            err = reader.Get(role);
+            payload.role = static_cast<Role>(role);
+            break;
+        default:
+            break;
+        }
+        SuccessOrExit(err);
+    }
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = reader.ExitContainer(outerContainerType);
+    }
+
+exit:
+    return err;
+}
+
+} // namespace Test
+} // namespace chip
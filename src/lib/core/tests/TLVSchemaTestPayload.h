@@ -0,0 +1,76 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares a fixed size struct with both a TLV schema codec
+ *      and an equivalent hand-written codec, shared by the TLV schema tests
+ *      and benchmark.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <core/CHIPError.h>
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVSchema.h>
+
+namespace chip {
+namespace Test {
+
+enum class Role : uint8_t
+{
+    kController = 1,
+    kDevice     = 2,
+};
+
+struct Payload
+{
+    uint8_t version;
+    uint16_t vendorId;
+    uint16_t productId;
+    uint32_t setupPinCode;
+    uint64_t nodeId;
+    int32_t offset;
+    bool commissioned;
+    Role role;
+};
+
+using PayloadSchema = TLV::Schema::StructSchema<Payload,                                      //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 1, version),      //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 2, vendorId),     //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 3, productId),    //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 4, setupPinCode), //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 5, nodeId),       //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 6, offset),       //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 7, commissioned), //
+                                                CHIP_TLV_SCHEMA_FIELD(Payload, 8, role)>;
+
+extern const Payload kPayload;
+
+bool operator==(const Payload & a, const Payload & b);
+
+/*
+ * Hand-written codec for Payload, in the style of the existing TLV parsers.
+ */
+CHIP_ERROR EncodePayloadByHand(TLV::TLVWriter & writer, const Payload & payload);
+CHIP_ERROR DecodePayloadByHand(TLV::TLVReader & reader, Payload & payload);
+
+} // namespace Test
+} // namespace chip
@@ -40,7 +40,10 @@
 #include <support/RandUtils.h>
 #include <support/ScopedBuffer.h>
 #include <support/TestUtils.h>
+#include <system/SystemClock.h>
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
 using namespace chip;
@@ -1593,6 +1596,149 @@ void CheckCHIPTLVEmptyFind(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+/**
+ *  Test CHIP TLV Index
+ */
+void CheckCHIPTLVIndex(nlTestSuite * inSuite, void * inContext)
+{
+    Utilities::IndexEntry entries[8];
+    size_t count;
+    TLVReader reader, memberReader, tagReader;
+    TLVType outerContainerType;
+    CHIP_ERROR err;
+
+    reader.Init(Encoding1, sizeof(Encoding1));
+    reader.ImplicitProfileId = TestProfile_2;
+
+    // Index() needs a container.
+    err = Utilities::Index(reader, entries, 8, count);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_WRONG_TLV_TYPE);
+
+    TestNext<TLVReader>(inSuite, reader);
+
+    err = Utilities::Index(reader, entries, 8, count);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, count == 6);
+
+    // The members and the container head and end cover the whole encoding.
+    NL_TEST_ASSERT(inSuite, entries[0].mOffset == reader.GetLengthRead());
+    NL_TEST_ASSERT(inSuite, entries[count - 1].mOffset + entries[count - 1].mLength + 1 == sizeof(Encoding1));
+
+    // Every member found through the index matches the one reached with Next().
+    memberReader.Init(reader);
+    err = memberReader.EnterContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        TestNext<TLVReader>(inSuite, memberReader);
+
+        NL_TEST_ASSERT(inSuite, entries[i].mTag == memberReader.GetTag());
+        NL_TEST_ASSERT(inSuite, entries[i].mType == memberReader.GetType());
+
+        err = Utilities::Find(reader, entries, count, entries[i].mTag, tagReader);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, tagReader.GetTag() == memberReader.GetTag());
+        NL_TEST_ASSERT(inSuite, tagReader.GetType() == memberReader.GetType());
+        NL_TEST_ASSERT(inSuite, tagReader.GetLength() == memberReader.GetLength());
+        NL_TEST_ASSERT(inSuite, tagReader.GetLengthRead() == memberReader.GetLengthRead());
+    }
+
+    // A reader positioned through the index carries on with the following members.
+    err = Utilities::Find(reader, entries, count, ProfileTag(TestProfile_1, 5), tagReader);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    TestString(inSuite, tagReader, ProfileTag(TestProfile_1, 5), "This is a test");
+    TestNext<TLVReader>(inSuite, tagReader);
+    TestGet<TLVReader, double>(inSuite, tagReader, kTLVType_FloatingPointNumber, ProfileTag(TestProfile_2, 65535),
+                               static_cast<float>(17.9));
+    TestNext<TLVReader>(inSuite, tagReader);
+    TestGet<TLVReader, double>(inSuite, tagReader, kTLVType_FloatingPointNumber, ProfileTag(TestProfile_2, 65536), 17.9);
+    TestEnd<TLVReader>(inSuite, tagReader);
+
+    // So does a nested container.
+    err = Utilities::Find(reader, entries, count, ContextTag(0), tagReader);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    TestAndEnterContainer<TLVReader>(inSuite, tagReader, kTLVType_Array, ContextTag(0), outerContainerType);
+    TestNext<TLVReader>(inSuite, tagReader);
+    TestGet<TLVReader, int8_t>(inSuite, tagReader, kTLVType_SignedInteger, AnonymousTag, 42);
+
+    err = Utilities::Find(reader, entries, count, ProfileTag(TestProfile_2, 1024), tagReader);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TLV_TAG_NOT_FOUND);
+
+    // An index that is too small holds the first members.
+    err = Utilities::Index(reader, entries, 2, count);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, count == 2);
+    NL_TEST_ASSERT(inSuite, entries[1].mTag == ProfileTag(TestProfile_2, 2));
+}
+
+/**
+ *  Measure how fast the reader walks a typical encoding: a structure of
+ *  context-tagged integers, booleans and strings, plus profile-tagged members.
+ *  Only correctness is asserted; the throughput is informative.
+ */
+void CheckCHIPTLVParseThroughput(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kRounds = 2000;
+    uint8_t buf[2048];
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    uint64_t start, elapsed, value;
+    uint32_t elementCount = 0;
+    CHIP_ERROR err;
+
+    writer.Init(buf, sizeof(buf));
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    for (uint8_t i = 0; i < 40; i++)
+    {
+        err = writer.Put(ContextTag(static_cast<uint8_t>(4 * i)), static_cast<uint8_t>(i));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.Put(ContextTag(static_cast<uint8_t>(4 * i + 1)), static_cast<uint32_t>(i * 100000u));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.PutBoolean(ContextTag(static_cast<uint8_t>(4 * i + 2)), (i & 1) != 0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.PutString(ContextTag(static_cast<uint8_t>(4 * i + 3)), "name");
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        err = writer.Put(ProfileTag(TestProfile_1, i), static_cast<uint64_t>(i) << 40);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    start = chip::System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        reader.Init(buf, writer.GetLengthWritten());
+        err = reader.Next();
+        if (err == CHIP_NO_ERROR)
+            err = reader.EnterContainer(outerContainerType);
+        while (err == CHIP_NO_ERROR && (err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            if (reader.GetType() == kTLVType_UnsignedInteger)
+                err = reader.Get(value);
+            elementCount++;
+        }
+        if (err == CHIP_END_OF_TLV)
+            err = reader.ExitContainer(outerContainerType);
+        if (err != CHIP_NO_ERROR)
+            break;
+    }
+    elapsed = chip::System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, elementCount == kRounds * 170);
+
+    printf("Parsed %" PRIu32 " TLV elements (%" PRIu32 " bytes) in %" PRIu64 " us\n", elementCount,
+           kRounds * writer.GetLengthWritten(), elapsed);
+}
+
 // clang-format off
 uint8_t Encoding2[] =
 {
@@ -3802,6 +3948,8 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV Utilities",                  CheckCHIPTLVUtilities),
     NL_TEST_DEF("CHIP TLV Updater",                    CheckCHIPUpdater),
     NL_TEST_DEF("CHIP TLV Empty Find",                 CheckCHIPTLVEmptyFind),
+    NL_TEST_DEF("CHIP TLV Index",                      CheckCHIPTLVIndex),
+    NL_TEST_DEF("CHIP TLV Parse Throughput",           CheckCHIPTLVParseThroughput),
     NL_TEST_DEF("CHIP Circular TLV buffer, simple",    CheckCircularTLVBufferSimple),
     NL_TEST_DEF("CHIP Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("CHIP Circular TLV buffer, straddle",  CheckCircularTLVBufferEvictStraddlingEvent),
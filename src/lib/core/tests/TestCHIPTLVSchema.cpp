@@ -0,0 +1,217 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the CHIP TLV schema codec.
+ *
+ */
+
+#include "TLVSchemaTestPayload.h"
+#include "TestCore.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <core/CHIPTLVSchema.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::TLV;
+using namespace chip::Test;
+
+namespace {
+
+struct Version
+{
+    uint16_t major;
+    uint16_t minor;
+};
+
+struct Description
+{
+    char label[33];
+    uint8_t key[16];
+    uint8_t keyLen;
+    Version firmware;
+};
+
+using VersionSchema = Schema::StructSchema<Version,                               //
+                                           CHIP_TLV_SCHEMA_FIELD(Version, 1, major), //
+                                           CHIP_TLV_SCHEMA_FIELD(Version, 2, minor)>;
+
+using DescriptionSchema = Schema::StructSchema<Description,                                          //
+                                               CHIP_TLV_SCHEMA_FIELD(Description, 1, label),         //
+                                               CHIP_TLV_SCHEMA_BYTES_FIELD(Description, 2, key, keyLen), //
+                                               CHIP_TLV_SCHEMA_STRUCT_FIELD(Description, 3, firmware, VersionSchema)>;
+
+// Control byte, 8 tagged fields and the end of container marker.
+static_assert(PayloadSchema::kMaxEncodedSize == 1 + (2 + 1) + (2 + 2) + (2 + 2) + (2 + 4) + (2 + 8) + (2 + 4) + 2 + (2 + 1) + 1,
+              "Unexpected encoded size");
+static_assert(PayloadSchema::kIsFixedSize, "Payload has no variable size field");
+static_assert(!DescriptionSchema::kIsFixedSize, "Description has strings");
+
+void TestFixedSizeRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[PayloadSchema::kMaxEncodedSize];
+    uint8_t handBuf[PayloadSchema::kMaxEncodedSize];
+    TLVWriter writer;
+    TLVReader reader;
+    Payload decoded;
+
+    writer.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, PayloadSchema::Encode(writer, AnonymousTag, kPayload) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == PayloadSchema::kMaxEncodedSize);
+    NL_TEST_ASSERT(inSuite, PayloadSchema::EncodedSize(kPayload) == PayloadSchema::kMaxEncodedSize);
+
+    // The schema produces the same bytes as the hand-written encoder.
+    writer.Init(handBuf, sizeof(handBuf));
+    NL_TEST_ASSERT(inSuite, EncodePayloadByHand(writer, kPayload) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(buf, handBuf, sizeof(buf)) == 0);
+
+    memset(&decoded, 0, sizeof(decoded));
+    reader.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Structure, AnonymousTag) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PayloadSchema::Decode(reader, decoded) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decoded == kPayload);
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+}
+
+void TestVariableSizeRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[DescriptionSchema::kMaxEncodedSize];
+    TLVWriter writer;
+    TLVReader reader;
+    Description description;
+    Description decoded;
+
+    memset(&description, 0, sizeof(description));
+    strcpy(description.label, "kitchen light");
+    memcpy(description.key, "\x01\x02\x03\x04\x05", 5);
+    description.keyLen         = 5;
+    description.firmware.major = 3;
+    description.firmware.minor = 14;
+
+    writer.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, DescriptionSchema::Encode(writer, AnonymousTag, description) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == DescriptionSchema::EncodedSize(description));
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() < DescriptionSchema::kMaxEncodedSize);
+
+    memset(&decoded, 0xFF, sizeof(decoded));
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Structure, AnonymousTag) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DescriptionSchema::Decode(reader, decoded) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(decoded.label, description.label) == 0);
+    NL_TEST_ASSERT(inSuite, decoded.keyLen == description.keyLen);
+    NL_TEST_ASSERT(inSuite, memcmp(decoded.key, description.key, description.keyLen) == 0);
+    NL_TEST_ASSERT(inSuite, decoded.firmware.major == 3);
+    NL_TEST_ASSERT(inSuite, decoded.firmware.minor == 14);
+
+    // A byte string longer than its array cannot be encoded.
+    description.keyLen = sizeof(description.key) + 1;
+    writer.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, DescriptionSchema::Encode(writer, AnonymousTag, description) == CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+void TestOutOfOrderDecode(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[64];
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    Version decoded = { 0, 0 };
+
+    // Fields in reverse order, with an unknown element in between.
+    writer.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Put(ContextTag(2), static_cast<uint8_t>(7)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.PutString(ContextTag(9), "ignored") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Put(ContextTag(1), static_cast<uint8_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.EndContainer(outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Structure, AnonymousTag) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, VersionSchema::Decode(reader, decoded) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decoded.major == 2);
+    NL_TEST_ASSERT(inSuite, decoded.minor == 7);
+
+    // A missing field is reported.
+    writer.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Put(ContextTag(1), static_cast<uint8_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.EndContainer(outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Structure, AnonymousTag) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, VersionSchema::Decode(reader, decoded) == CHIP_ERROR_MISSING_TLV_ELEMENT);
+
+    // So is a field of the wrong type.
+    writer.Init(buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Put(ContextTag(1), static_cast<uint8_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.PutBoolean(ContextTag(2), true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.EndContainer(outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Structure, AnonymousTag) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, VersionSchema::Decode(reader, decoded) == CHIP_ERROR_WRONG_TLV_TYPE);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Fixed size round trip",    TestFixedSizeRoundTrip),
+    NL_TEST_DEF("Variable size round trip", TestVariableSizeRoundTrip),
+    NL_TEST_DEF("Out of order decode",      TestOutOfOrderDecode),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestCHIPTLVSchema(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-tlv-schema",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCHIPTLVSchema)
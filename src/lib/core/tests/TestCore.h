@@ -31,6 +31,7 @@ extern "C" {
 int TestCHIPCallback(void);
 int TestCHIPErrorStr(void);
 int TestCHIPTLV(void);
+int TestCHIPTLVSchema(void);
 int TestReferenceCounted(void);
 
 #ifdef __cplusplus
@@ -0,0 +1,532 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "DnsMessage.h"
+
+#include <string.h>
+
+#include "core/CHIPEncoding.h"
+#include "support/CodeUtils.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+namespace {
+
+constexpr uint8_t kCompressionMask     = 0xC0;
+constexpr uint16_t kClassInternet      = 1;
+constexpr uint16_t kClassMask          = 0x7FFF;
+constexpr uint16_t kCacheFlushBit      = 0x8000;
+constexpr uint16_t kUnicastResponseBit = 0x8000;
+constexpr size_t kSrvFixedLength       = 6; // Priority, weight and port
+constexpr size_t kIPv4Length           = 4;
+constexpr size_t kIPv6Length           = 16;
+
+inline uint8_t ToLower(uint8_t c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c - 'A' + 'a') : c;
+}
+
+} // namespace
+
+CHIP_ERROR DnsName::AppendLabel(const char * label, size_t labelLength)
+{
+    if (labelLength == 0 || labelLength > kMaxLabelLength || mLength + 1 + labelLength > kMaxLength)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    mData[mLength - 1] = static_cast<uint8_t>(labelLength);
+    memcpy(&mData[mLength], label, labelLength);
+    mLength            = static_cast<uint8_t>(mLength + labelLength + 1);
+    mData[mLength - 1] = 0;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsName::AppendLabels(const char * name)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    while (*name != '\0')
+    {
+        const char * dot = strchr(name, '.');
+        size_t length    = (dot != nullptr) ? static_cast<size_t>(dot - name) : strlen(name);
+
+        SuccessOrExit(err = AppendLabel(name, length));
+        name += length;
+        if (*name == '.')
+        {
+            name++;
+        }
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR DnsName::Append(const DnsName & suffix)
+{
+    if (mLength + suffix.mLength - 1u > kMaxLength)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    memcpy(&mData[mLength - 1], suffix.mData, suffix.mLength);
+    mLength = static_cast<uint8_t>(mLength + suffix.mLength - 1);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsName::GetFirstLabel(char * buf, size_t bufSize) const
+{
+    size_t labelLength = mData[0];
+
+    if (labelLength == 0 || labelLength >= bufSize)
+    {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(buf, &mData[1], labelLength);
+    buf[labelLength] = '\0';
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsName::SetParent(const DnsName & name)
+{
+    size_t labelLength = name.mData[0];
+
+    if (labelLength == 0)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    mLength = static_cast<uint8_t>(name.mLength - labelLength - 1);
+    memmove(mData, &name.mData[labelLength + 1], mLength);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsName::SetWireFormat(const uint8_t * data, size_t dataLength)
+{
+    size_t offset = 0;
+
+    while (offset < dataLength && data[offset] != 0)
+    {
+        if (data[offset] > kMaxLabelLength)
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        offset += data[offset] + 1u;
+    }
+
+    if (offset >= dataLength || offset + 1 > kMaxLength)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    mLength = static_cast<uint8_t>(offset + 1);
+    memmove(mData, data, mLength);
+
+    return CHIP_NO_ERROR;
+}
+
+bool DnsName::operator==(const DnsName & other) const
+{
+    if (mLength != other.mLength)
+    {
+        return false;
+    }
+
+    // Label lengths are below 64, so they are not affected by ToLower().
+    for (size_t i = 0; i < mLength; i++)
+    {
+        if (ToLower(mData[i]) != ToLower(other.mData[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DnsRecord::IsSameAs(const DnsRecord & other) const
+{
+    return mType == other.mType && mName == other.mName && mDataLength == other.mDataLength &&
+        memcmp(mData, other.mData, mDataLength) == 0;
+}
+
+CHIP_ERROR DnsRecord::SetPtr(const DnsName & target)
+{
+    mType       = DnsRecordType::kPtr;
+    mDataLength = static_cast<uint16_t>(target.Length());
+    memcpy(mData, target.Data(), target.Length());
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsRecord::SetSrv(uint16_t port, const DnsName & target)
+{
+    mType = DnsRecordType::kSrv;
+    memset(mData, 0, kSrvFixedLength);
+    Encoding::BigEndian::Put16(&mData[4], port);
+    memcpy(&mData[kSrvFixedLength], target.Data(), target.Length());
+    mDataLength = static_cast<uint16_t>(kSrvFixedLength + target.Length());
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsRecord::SetAddress(const Inet::IPAddress & address)
+{
+    // IPAddress words are in network byte order, and IPv4 addresses are held in the last word.
+    if (address.IsIPv4())
+    {
+        mType       = DnsRecordType::kA;
+        mDataLength = kIPv4Length;
+        memcpy(mData, &address.Addr[3], kIPv4Length);
+    }
+    else
+    {
+        mType       = DnsRecordType::kAaaa;
+        mDataLength = kIPv6Length;
+        memcpy(mData, address.Addr, kIPv6Length);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsRecord::AppendTxt(const char * key, const uint8_t * value, size_t valueLength)
+{
+    size_t keyLength   = strlen(key);
+    size_t entryLength = keyLength + 1 + valueLength;
+
+    if (entryLength > UINT8_MAX || mDataLength + 1 + entryLength > kMaxDataLength)
+    {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    mData[mDataLength++] = static_cast<uint8_t>(entryLength);
+    memcpy(&mData[mDataLength], key, keyLength);
+    mData[mDataLength + keyLength] = '=';
+    memcpy(&mData[mDataLength + keyLength + 1], value, valueLength);
+    mDataLength = static_cast<uint16_t>(mDataLength + entryLength);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsRecord::GetPtr(DnsName & target) const
+{
+    if (mType != DnsRecordType::kPtr)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    return target.SetWireFormat(mData, mDataLength);
+}
+
+CHIP_ERROR DnsRecord::GetSrv(uint16_t & port, DnsName & target) const
+{
+    if (mType != DnsRecordType::kSrv || mDataLength <= kSrvFixedLength)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    port = Encoding::BigEndian::Get16(&mData[4]);
+
+    return target.SetWireFormat(&mData[kSrvFixedLength], mDataLength - kSrvFixedLength);
+}
+
+CHIP_ERROR DnsRecord::GetAddress(Inet::IPAddress & address) const
+{
+    if (mType == DnsRecordType::kA && mDataLength == kIPv4Length)
+    {
+        address.Addr[0] = 0;
+        address.Addr[1] = 0;
+        address.Addr[2] = Encoding::BigEndian::HostSwap32(0xFFFF);
+        memcpy(&address.Addr[3], mData, kIPv4Length);
+    }
+    else if (mType == DnsRecordType::kAaaa && mDataLength == kIPv6Length)
+    {
+        memcpy(address.Addr, mData, kIPv6Length);
+    }
+    else
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsReader::ReadHeader(DnsHeader & header)
+{
+    if (mEnd - mPosition < 12)
+    {
+        return CHIP_ERROR_INVALID_MESSAGE_LENGTH;
+    }
+
+    header.mId              = Encoding::BigEndian::Read16(mPosition);
+    header.mFlags           = Encoding::BigEndian::Read16(mPosition);
+    header.mQuestionCount   = Encoding::BigEndian::Read16(mPosition);
+    header.mAnswerCount     = Encoding::BigEndian::Read16(mPosition);
+    header.mAuthorityCount  = Encoding::BigEndian::Read16(mPosition);
+    header.mAdditionalCount = Encoding::BigEndian::Read16(mPosition);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsReader::ReadQuestion(DnsQuestion & question)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    uint16_t qclass;
+
+    SuccessOrExit(err = ReadName(mPosition, question.mName));
+    VerifyOrExit(mEnd - mPosition >= 4, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    question.mType            = static_cast<DnsRecordType>(Encoding::BigEndian::Read16(mPosition));
+    qclass                    = Encoding::BigEndian::Read16(mPosition);
+    question.mUnicastResponse = (qclass & kUnicastResponseBit) != 0;
+
+exit:
+    return err;
+}
+
+CHIP_ERROR DnsReader::ReadRecord(DnsRecord & record)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    const uint8_t * data;
+    const uint8_t * dataEnd;
+    uint16_t rrclass;
+    uint16_t dataLength;
+    size_t outLength;
+
+    SuccessOrExit(err = ReadName(mPosition, record.mName));
+    VerifyOrExit(mEnd - mPosition >= 10, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    record.mType       = static_cast<DnsRecordType>(Encoding::BigEndian::Read16(mPosition));
+    rrclass            = Encoding::BigEndian::Read16(mPosition);
+    record.mCacheFlush = (rrclass & kCacheFlushBit) != 0;
+    record.mTtl        = Encoding::BigEndian::Read32(mPosition);
+    dataLength         = Encoding::BigEndian::Read16(mPosition);
+    VerifyOrExit(mEnd - mPosition >= dataLength, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    data      = mPosition;
+    dataEnd   = mPosition + dataLength;
+    mPosition = dataEnd;
+
+    VerifyOrExit((rrclass & kClassMask) == kClassInternet, err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+
+    // Names within PTR and SRV data may point anywhere in the message, so they are expanded.
+    switch (record.mType)
+    {
+    case DnsRecordType::kPtr:
+        SuccessOrExit(err = ReadName(data, record.mData, sizeof(record.mData), outLength));
+        VerifyOrExit(data == dataEnd, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+        record.mDataLength = static_cast<uint16_t>(outLength);
+        break;
+
+    case DnsRecordType::kSrv:
+        VerifyOrExit(dataLength > kSrvFixedLength, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+        memcpy(record.mData, data, kSrvFixedLength);
+        data += kSrvFixedLength;
+        SuccessOrExit(err = ReadName(data, &record.mData[kSrvFixedLength], sizeof(record.mData) - kSrvFixedLength, outLength));
+        VerifyOrExit(data == dataEnd, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+        record.mDataLength = static_cast<uint16_t>(kSrvFixedLength + outLength);
+        break;
+
+    default:
+        VerifyOrExit(dataLength <= sizeof(record.mData), err = CHIP_ERROR_BUFFER_TOO_SMALL);
+        memcpy(record.mData, data, dataLength);
+        record.mDataLength = dataLength;
+        break;
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR DnsReader::ReadName(const uint8_t *& position, DnsName & name) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    uint8_t buf[DnsName::kMaxLength];
+    size_t length;
+
+    SuccessOrExit(err = ReadName(position, buf, sizeof(buf), length));
+    err = name.SetWireFormat(buf, length);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR DnsReader::ReadName(const uint8_t *& position, uint8_t * out, size_t outSize, size_t & outLength) const
+{
+    const uint8_t * label = position;
+    const uint8_t * next  = nullptr;  // Where the name ends in the message, once a pointer has been followed
+    const uint8_t * limit = position; // Pointers must go before this, so that every name can only be read once
+    size_t length         = 0;
+
+    while (true)
+    {
+        if (label >= mEnd)
+        {
+            return CHIP_ERROR_INVALID_MESSAGE_LENGTH;
+        }
+
+        uint8_t labelLength = *label;
+
+        if ((labelLength & kCompressionMask) == kCompressionMask)
+        {
+            if (mEnd - label < 2)
+            {
+                return CHIP_ERROR_INVALID_MESSAGE_LENGTH;
+            }
+
+            const uint8_t * target = mStart + (((labelLength & ~kCompressionMask) << 8) | label[1]);
+
+            // Only following pointers to data before that of the previous pointer guarantees that decoding ends.
+            if (target >= limit)
+            {
+                return CHIP_ERROR_INVALID_MESSAGE_LENGTH;
+            }
+            limit = target;
+            if (next == nullptr)
+            {
+                next = label + 2;
+            }
+            label = target;
+            continue;
+        }
+
+        if (labelLength > DnsName::kMaxLabelLength || mEnd - label <= labelLength || length + labelLength + 1 > outSize)
+        {
+            return CHIP_ERROR_INVALID_MESSAGE_LENGTH;
+        }
+
+        memcpy(&out[length], label, labelLength + 1u);
+        length += labelLength + 1u;
+        label += labelLength + 1;
+
+        if (labelLength == 0)
+        {
+            break;
+        }
+    }
+
+    position  = (next != nullptr) ? next : label;
+    outLength = length;
+
+    return CHIP_NO_ERROR;
+}
+
+DnsWriter::DnsWriter(uint8_t * buffer, size_t bufferSize) : mBuffer(buffer), mBufferSize(bufferSize), mLength(kHeaderSize)
+{
+    memset(&mHeader, 0, sizeof(mHeader));
+}
+
+CHIP_ERROR DnsWriter::AddQuestion(const DnsName & name, DnsRecordType type, bool unicastResponse)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t start   = mLength;
+
+    VerifyOrExit(mHeader.mAnswerCount == 0 && mHeader.mAdditionalCount == 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    SuccessOrExit(err = Put(name.Data(), name.Length()));
+    SuccessOrExit(err = Put16(static_cast<uint16_t>(type)));
+    SuccessOrExit(err = Put16(unicastResponse ? (kClassInternet | kUnicastResponseBit) : kClassInternet));
+    mHeader.mQuestionCount++;
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        mLength = start;
+    }
+    return err;
+}
+
+CHIP_ERROR DnsWriter::AddRecord(const DnsRecord & record, uint32_t ttl, uint16_t & count)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t start   = mLength;
+
+    VerifyOrExit(&count != &mHeader.mAnswerCount || mHeader.mAdditionalCount == 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    SuccessOrExit(err = Put(record.mName.Data(), record.mName.Length()));
+    SuccessOrExit(err = Put16(static_cast<uint16_t>(record.mType)));
+    SuccessOrExit(err = Put16(record.mCacheFlush ? (kClassInternet | kCacheFlushBit) : kClassInternet));
+    SuccessOrExit(err = Put32(ttl));
+    SuccessOrExit(err = Put16(record.mDataLength));
+    SuccessOrExit(err = Put(record.mData, record.mDataLength));
+    count++;
+
+exit:
+    // A record that does not fit is left out entirely, so the message stays well-formed.
+    if (err != CHIP_NO_ERROR)
+    {
+        mLength = start;
+    }
+    return err;
+}
+
+size_t DnsWriter::Finish(uint16_t id, uint16_t flags)
+{
+    uint8_t * p = mBuffer;
+
+    Encoding::BigEndian::Write16(p, id);
+    Encoding::BigEndian::Write16(p, flags);
+    Encoding::BigEndian::Write16(p, mHeader.mQuestionCount);
+    Encoding::BigEndian::Write16(p, mHeader.mAnswerCount);
+    Encoding::BigEndian::Write16(p, mHeader.mAuthorityCount);
+    Encoding::BigEndian::Write16(p, mHeader.mAdditionalCount);
+
+    return mLength;
+}
+
+CHIP_ERROR DnsWriter::Put(const uint8_t * data, size_t length)
+{
+    if (mLength > mBufferSize || mBufferSize - mLength < length)
+    {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(&mBuffer[mLength], data, length);
+    mLength += length;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DnsWriter::Put16(uint16_t value)
+{
+    uint8_t buf[2];
+
+    Encoding::BigEndian::Put16(buf, value);
+
+    return Put(buf, sizeof(buf));
+}
+
+CHIP_ERROR DnsWriter::Put32(uint32_t value)
+{
+    uint8_t buf[4];
+
+    Encoding::BigEndian::Put32(buf, value);
+
+    return Put(buf, sizeof(buf));
+}
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
@@ -0,0 +1,234 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the DNS message reader and writer used by the
+ *      native mDNS server.
+ *
+ *      Both work in place on caller-provided buffers.  Names are kept in
+ *      their uncompressed wire format, as a sequence of length-prefixed
+ *      labels, so that instance names may contain dots.  The reader
+ *      follows compression pointers, including within PTR and SRV data;
+ *      the writer does not compress names.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/CHIPError.h"
+#include "inet/IPAddress.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+enum class DnsRecordType : uint16_t
+{
+    kA    = 1,
+    kPtr  = 12,
+    kTxt  = 16,
+    kAaaa = 28,
+    kSrv  = 33,
+    kAny  = 255,
+};
+
+/**
+ * A domain name, in uncompressed wire format.
+ */
+class DnsName
+{
+public:
+    static constexpr size_t kMaxLength      = 255;
+    static constexpr size_t kMaxLabelLength = 63;
+
+    DnsName() : mLength(1) { mData[0] = 0; }
+
+    /**
+     * Appends a single label, which may contain dots.
+     */
+    CHIP_ERROR AppendLabel(const char * label, size_t labelLength);
+
+    /**
+     * Appends the dot-separated labels of @p name.
+     */
+    CHIP_ERROR AppendLabels(const char * name);
+
+    /**
+     * Appends the labels of @p suffix.
+     */
+    CHIP_ERROR Append(const DnsName & suffix);
+
+    /**
+     * Copies the first label into @p buf, NUL-terminated.
+     */
+    CHIP_ERROR GetFirstLabel(char * buf, size_t bufSize) const;
+
+    /**
+     * Sets this name to @p name without its first label.
+     */
+    CHIP_ERROR SetParent(const DnsName & name);
+
+    /**
+     * Sets this name from wire format data, which must not be compressed.
+     */
+    CHIP_ERROR SetWireFormat(const uint8_t * data, size_t dataLength);
+
+    const uint8_t * Data() const { return mData; }
+    size_t Length() const { return mLength; }
+    bool IsEmpty() const { return mLength == 1; }
+
+    /**
+     * Compares names ignoring the case of ASCII letters, as DNS does.
+     */
+    bool operator==(const DnsName & other) const;
+    bool operator!=(const DnsName & other) const { return !(*this == other); }
+
+private:
+    uint8_t mData[kMaxLength];
+    uint8_t mLength; // Including the terminating root label
+};
+
+struct DnsHeader
+{
+    static constexpr uint16_t kFlagResponse      = 0x8000;
+    static constexpr uint16_t kFlagAuthoritative = 0x0400;
+    static constexpr uint16_t kFlagTruncated     = 0x0200;
+
+    uint16_t mId;
+    uint16_t mFlags;
+    uint16_t mQuestionCount;
+    uint16_t mAnswerCount;
+    uint16_t mAuthorityCount;
+    uint16_t mAdditionalCount;
+
+    bool IsResponse() const { return (mFlags & kFlagResponse) != 0; }
+};
+
+struct DnsQuestion
+{
+    DnsName mName;
+    DnsRecordType mType;
+    bool mUnicastResponse; // The QU bit of mDNS questions
+};
+
+struct DnsRecord
+{
+    /**
+     * Longest record data the server keeps.  Names within PTR and SRV data are stored uncompressed.
+     */
+    static constexpr size_t kMaxDataLength = 320;
+
+    DnsName mName;
+    DnsRecordType mType;
+    bool mCacheFlush; // The cache-flush bit of mDNS records
+    uint32_t mTtl;
+    uint16_t mDataLength;
+    uint8_t mData[kMaxDataLength];
+
+    /**
+     * Whether both records hold the same name, type and data.
+     */
+    bool IsSameAs(const DnsRecord & other) const;
+
+    CHIP_ERROR SetPtr(const DnsName & target);
+    CHIP_ERROR SetSrv(uint16_t port, const DnsName & target);
+    CHIP_ERROR SetAddress(const Inet::IPAddress & address);
+
+    /**
+     * Appends a "key=value" string to the data of a TXT record.
+     */
+    CHIP_ERROR AppendTxt(const char * key, const uint8_t * value, size_t valueLength);
+
+    CHIP_ERROR GetPtr(DnsName & target) const;
+    CHIP_ERROR GetSrv(uint16_t & port, DnsName & target) const;
+    CHIP_ERROR GetAddress(Inet::IPAddress & address) const;
+};
+
+/**
+ * Reads a DNS message in place.  The header, questions and records must be read in order.
+ */
+class DnsReader
+{
+public:
+    DnsReader(const uint8_t * message, size_t messageLength) :
+        mStart(message), mEnd(message + messageLength), mPosition(message)
+    {}
+
+    CHIP_ERROR ReadHeader(DnsHeader & header);
+    CHIP_ERROR ReadQuestion(DnsQuestion & question);
+
+    /**
+     * Reads a record from the answer, authority or additional section.  A record whose data is too long for
+     * DnsRecord, or whose class is not IN, is skipped with CHIP_ERROR_BUFFER_TOO_SMALL or
+     * CHIP_ERROR_INVALID_MESSAGE_TYPE respectively, after which the next record can still be read.  Any other
+     * error means the rest of the message cannot be read.
+     */
+    CHIP_ERROR ReadRecord(DnsRecord & record);
+
+private:
+    CHIP_ERROR ReadName(const uint8_t *& position, DnsName & name) const;
+    CHIP_ERROR ReadName(const uint8_t *& position, uint8_t * out, size_t outSize, size_t & outLength) const;
+
+    const uint8_t * mStart;
+    const uint8_t * mEnd;
+    const uint8_t * mPosition;
+};
+
+/**
+ * Writes a DNS message in place.  Questions must be added before answers, and answers before additional records.
+ */
+class DnsWriter
+{
+public:
+    DnsWriter(uint8_t * buffer, size_t bufferSize);
+
+    CHIP_ERROR AddQuestion(const DnsName & name, DnsRecordType type, bool unicastResponse);
+    CHIP_ERROR AddAnswer(const DnsRecord & record) { return AddRecord(record, record.mTtl, mHeader.mAnswerCount); }
+    CHIP_ERROR AddAdditional(const DnsRecord & record) { return AddRecord(record, record.mTtl, mHeader.mAdditionalCount); }
+
+    /**
+     * Adds a record to the answer section with a different TTL, such as a known answer with its remaining TTL.
+     */
+    CHIP_ERROR AddAnswer(const DnsRecord & record, uint32_t ttl) { return AddRecord(record, ttl, mHeader.mAnswerCount); }
+
+    /**
+     * Writes the header and returns the length of the message.
+     */
+    size_t Finish(uint16_t id, uint16_t flags);
+
+    bool IsEmpty() const { return mHeader.mQuestionCount == 0 && mHeader.mAnswerCount == 0 && mHeader.mAdditionalCount == 0; }
+
+private:
+    static constexpr size_t kHeaderSize = 12;
+
+    CHIP_ERROR AddRecord(const DnsRecord & record, uint32_t ttl, uint16_t & count);
+    CHIP_ERROR Put(const uint8_t * data, size_t length);
+    CHIP_ERROR Put16(uint16_t value);
+    CHIP_ERROR Put32(uint32_t value);
+
+    uint8_t * mBuffer;
+    size_t mBufferSize;
+    size_t mLength;
+    DnsHeader mHeader;
+};
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
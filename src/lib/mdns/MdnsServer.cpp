@@ -0,0 +1,920 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "MdnsServer.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "support/CodeUtils.h"
+#include "support/RandUtils.h"
+#include "support/logging/CHIPLogging.h"
+#include "system/SystemClock.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+namespace {
+
+constexpr uint16_t kResponseFlags = DnsHeader::kFlagResponse | DnsHeader::kFlagAuthoritative;
+
+const char kGroupAddressIPv6[] = "ff02::fb";
+const char kGroupAddressIPv4[] = "224.0.0.251";
+
+/**
+ * Splits the "key=value" strings of a TXT record into text entries, NUL-terminating keys and values in @p buf, which
+ * must hold DnsRecord::kMaxDataLength bytes.
+ */
+size_t ParseTxt(const DnsRecord & txt, TextEntry * entries, size_t maxEntries, char * buf)
+{
+    size_t count  = 0;
+    size_t offset = 0;
+    size_t used   = 0;
+
+    while (offset < txt.mDataLength && count < maxEntries)
+    {
+        size_t length = txt.mData[offset++];
+
+        if (length > txt.mDataLength - offset)
+        {
+            break;
+        }
+        if (length == 0)
+        {
+            continue;
+        }
+
+        // Each string loses its length byte and gains a NUL, so it takes as much room in buf as in the record.
+        char * key = &buf[used];
+        memcpy(key, &txt.mData[offset], length);
+        key[length] = '\0';
+        offset += length;
+        used += length + 1;
+
+        char * separator    = static_cast<char *>(memchr(key, '=', length));
+        entries[count].mKey = key;
+        if (separator != nullptr)
+        {
+            *separator                = '\0';
+            entries[count].mData     = reinterpret_cast<const uint8_t *>(separator + 1);
+            entries[count].mDataSize = static_cast<size_t>(key + length - (separator + 1));
+        }
+        else
+        {
+            entries[count].mData     = nullptr;
+            entries[count].mDataSize = 0;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+} // namespace
+
+CHIP_ERROR MdnsServer::Init(Inet::InetLayer & inetLayer, Inet::InterfaceId interface, uint16_t port)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mInetLayer == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    mInetLayer = &inetLayer;
+    mInterface = interface;
+    mPort      = port;
+
+    if (mHostName.IsEmpty())
+    {
+        char hostname[16];
+
+        snprintf(hostname, sizeof(hostname), "CHIP-%08" PRIX32, GetRandU32());
+        SuccessOrExit(err = SetHostname(hostname));
+    }
+
+    err = OpenEndPoint(Inet::kIPAddressType_IPv6, mEndPointIPv6);
+#if INET_CONFIG_ENABLE_IPV4
+    if (OpenEndPoint(Inet::kIPAddressType_IPv4, mEndPointIPv4) == CHIP_NO_ERROR)
+    {
+        err = CHIP_NO_ERROR;
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "mDNS server failed to start: %d", err);
+        mInetLayer = nullptr;
+    }
+    return err;
+}
+
+void MdnsServer::Shutdown()
+{
+    if (mInetLayer == nullptr)
+    {
+        return;
+    }
+
+    StopPublish();
+    mInetLayer->SystemLayer()->CancelTimer(HandleTimer, this);
+    CloseEndPoint(mEndPointIPv6);
+    CloseEndPoint(mEndPointIPv4);
+
+    for (Query & query : mQueries)
+    {
+        query.mName = DnsName();
+    }
+    mCache.Clear();
+    mInetLayer = nullptr;
+}
+
+CHIP_ERROR MdnsServer::SetHostname(const char * hostname)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    DnsName name;
+
+    SuccessOrExit(err = name.AppendLabel(hostname, strlen(hostname)));
+    SuccessOrExit(err = name.AppendLabels("local"));
+    mHostName = name;
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MdnsServer::PublishService(const MdnsService & service)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t index   = kMaxServices;
+    DnsName typeName;
+    DnsName instanceName;
+    DnsRecord txt;
+
+    VerifyOrExit(mInetLayer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    SuccessOrExit(err = MakeTypeName(service.mType, service.mProtocol, typeName));
+    SuccessOrExit(err = instanceName.AppendLabel(service.mName, strlen(service.mName)));
+    SuccessOrExit(err = instanceName.Append(typeName));
+
+    txt.mDataLength = 0;
+    for (size_t i = 0; i < service.mTextEntrySize; i++)
+    {
+        const TextEntry & entry = service.mTextEntryies[i];
+        SuccessOrExit(err = txt.AppendTxt(entry.mKey, entry.mData, entry.mDataSize));
+    }
+    if (txt.mDataLength == 0)
+    {
+        // A TXT record holds at least one string, even if empty (RFC 6763 section 6.1).
+        txt.mData[0]    = 0;
+        txt.mDataLength = 1;
+    }
+
+    for (size_t i = 0; i < kMaxServices; i++)
+    {
+        if (mServices[i].mInstanceName == instanceName)
+        {
+            index = i;
+            break;
+        }
+        if (mServices[i].mInstanceName.IsEmpty() && index == kMaxServices)
+        {
+            index = i;
+        }
+    }
+    VerifyOrExit(index != kMaxServices, err = CHIP_ERROR_NO_MEMORY);
+
+    mServices[index].mInstanceName = instanceName;
+    mServices[index].mTypeName     = typeName;
+    mServices[index].mPort         = service.mPort;
+    mServices[index].mTxtLength    = txt.mDataLength;
+    memcpy(mServices[index].mTxt, txt.mData, txt.mDataLength);
+
+    err = Announce(index, kServiceTtl);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MdnsServer::StopPublish()
+{
+    for (size_t i = 0; i < kMaxServices; i++)
+    {
+        if (!mServices[i].mInstanceName.IsEmpty())
+        {
+            Announce(i, 0);
+            mServices[i].mInstanceName = DnsName();
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MdnsServer::Browse(const char * type, MdnsServiceProtocol protocol, MdnsBrowseCallback callback, void * context)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    Query * query  = nullptr;
+    DnsName typeName;
+
+    VerifyOrExit(mInetLayer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(callback != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(type != nullptr && strlen(type) <= kMdnsTypeMaxSize, err = CHIP_ERROR_INVALID_ARGUMENT);
+    SuccessOrExit(err = MakeTypeName(type, protocol, typeName));
+
+    query = AllocateQuery(System::Platform::Layer::GetClock_MonotonicMS(), kBrowseDuration);
+    VerifyOrExit(query != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    query->mName           = typeName;
+    query->mProtocol       = protocol;
+    query->mBrowseCallback = callback;
+    query->mContext        = context;
+
+    ProcessQueries();
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MdnsServer::Resolve(const char * name, const char * type, MdnsServiceProtocol protocol, MdnsResolveCallback callback,
+                               void * context)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    Query * query  = nullptr;
+    DnsName typeName;
+    DnsName instanceName;
+
+    VerifyOrExit(mInetLayer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(callback != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(name != nullptr && strlen(name) <= kMdnsNameMaxSize, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(type != nullptr && strlen(type) <= kMdnsTypeMaxSize, err = CHIP_ERROR_INVALID_ARGUMENT);
+    SuccessOrExit(err = MakeTypeName(type, protocol, typeName));
+    SuccessOrExit(err = instanceName.AppendLabel(name, strlen(name)));
+    SuccessOrExit(err = instanceName.Append(typeName));
+
+    query = AllocateQuery(System::Platform::Layer::GetClock_MonotonicMS(), kResolveTimeout);
+    VerifyOrExit(query != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    query->mName            = instanceName;
+    query->mProtocol        = protocol;
+    query->mResolveCallback = callback;
+    query->mContext         = context;
+
+    // Completes the query at once if the cache already holds the answers.
+    ProcessQueries();
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MdnsServer::MakeTypeName(const char * type, MdnsServiceProtocol protocol, DnsName & name)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(protocol != MdnsServiceProtocol::kMdnsProtocolUnknown, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    name = DnsName();
+    SuccessOrExit(err = name.AppendLabel(type, strlen(type)));
+    SuccessOrExit(err = name.AppendLabels(protocol == MdnsServiceProtocol::kMdnsProtocolUdp ? "_udp.local" : "_tcp.local"));
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MdnsServer::OpenEndPoint(Inet::IPAddressType addressType, Inet::UDPEndPoint *& endPoint)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    bool joined    = false;
+
+    SuccessOrExit(err = mInetLayer->NewUDPEndPoint(&endPoint));
+    SuccessOrExit(err = endPoint->Bind(addressType, Inet::IPAddress::Any, mPort, mInterface));
+    SuccessOrExit(err = endPoint->Listen());
+
+    endPoint->AppState          = this;
+    endPoint->OnMessageReceived = HandleMessageReceived;
+
+    if (mInterface != INET_NULL_INTERFACEID)
+    {
+        err    = endPoint->JoinMulticastGroup(mInterface, GetGroupAddress(endPoint));
+        joined = (err == INET_NO_ERROR);
+    }
+    else
+    {
+        err = INET_ERROR_UNKNOWN_INTERFACE;
+        for (Inet::InterfaceIterator it; it.HasCurrent(); it.Next())
+        {
+            if (it.IsUp() && it.SupportsMulticast() &&
+                endPoint->JoinMulticastGroup(it.GetInterfaceId(), GetGroupAddress(endPoint)) == INET_NO_ERROR)
+            {
+                joined = true;
+            }
+        }
+    }
+    VerifyOrExit(joined, );
+    err = CHIP_NO_ERROR;
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        CloseEndPoint(endPoint);
+    }
+    return err;
+}
+
+void MdnsServer::CloseEndPoint(Inet::UDPEndPoint *& endPoint)
+{
+    if (endPoint != nullptr)
+    {
+        endPoint->Free();
+        endPoint = nullptr;
+    }
+}
+
+Inet::IPAddress MdnsServer::GetGroupAddress(const Inet::UDPEndPoint * endPoint) const
+{
+    Inet::IPAddress address = Inet::IPAddress::Any;
+
+    Inet::IPAddress::FromString((endPoint == mEndPointIPv4) ? kGroupAddressIPv4 : kGroupAddressIPv6, address);
+    return address;
+}
+
+void MdnsServer::HandleMessageReceived(Inet::IPEndPointBasis * endPoint, System::PacketBuffer * msg,
+                                       const Inet::IPPacketInfo * pktInfo)
+{
+    MdnsServer * server = static_cast<MdnsServer *>(endPoint->AppState);
+    DnsReader reader(msg->Start(), msg->DataLength());
+    DnsHeader header;
+
+    if (pktInfo != nullptr && reader.ReadHeader(header) == CHIP_NO_ERROR)
+    {
+        if (!header.IsResponse())
+        {
+            server->HandleQuery(reader, header, static_cast<Inet::UDPEndPoint *>(endPoint), *pktInfo);
+        }
+        else if (pktInfo->SrcPort == server->mPort)
+        {
+            // Responses from any other port are not mDNS responses (RFC 6762 section 6).
+            server->HandleResponse(reader, header);
+        }
+    }
+
+    System::PacketBuffer::Free(msg);
+}
+
+void MdnsServer::HandleQuery(DnsReader & reader, const DnsHeader & header, Inet::UDPEndPoint * endPoint,
+                             const Inet::IPPacketInfo & pktInfo)
+{
+    uint8_t answers[kMaxServices]    = {};
+    uint8_t additional[kMaxServices] = {};
+    bool answerAddresses             = false;
+    bool additionalAddresses         = false;
+    bool legacy                      = (pktInfo.SrcPort != mPort);
+    bool unicast                     = legacy;
+    uint8_t message[kMaxMessageSize];
+    DnsWriter writer(message, sizeof(message));
+    DnsQuestion question;
+    DnsRecord record;
+    DnsRecord ours;
+
+    for (uint16_t i = 0; i < header.mQuestionCount; i++)
+    {
+        if (reader.ReadQuestion(question) != CHIP_NO_ERROR)
+        {
+            return;
+        }
+
+        const bool any = (question.mType == DnsRecordType::kAny);
+
+        unicast = unicast || question.mUnicastResponse;
+        for (size_t s = 0; s < kMaxServices; s++)
+        {
+            const Service & service = mServices[s];
+
+            if (service.mInstanceName.IsEmpty())
+            {
+                continue;
+            }
+            if ((any || question.mType == DnsRecordType::kPtr) && question.mName == service.mTypeName)
+            {
+                answers[s] |= kServiceRecord_Ptr;
+            }
+            if (question.mName == service.mInstanceName)
+            {
+                answers[s] |= (any || question.mType == DnsRecordType::kSrv) ? kServiceRecord_Srv : 0;
+                answers[s] |= (any || question.mType == DnsRecordType::kTxt) ? kServiceRecord_Txt : 0;
+            }
+        }
+        if ((any || question.mType == DnsRecordType::kA || question.mType == DnsRecordType::kAaaa) &&
+            question.mName == mHostName)
+        {
+            answerAddresses = true;
+        }
+    }
+
+    // Known-answer suppression (RFC 6762 section 7.1): leave out the answers the querier already holds with at least
+    // half of their TTL left.  Addresses are always sent, they are small and cheap to repeat.
+    for (uint16_t i = 0; i < header.mAnswerCount; i++)
+    {
+        CHIP_ERROR err = reader.ReadRecord(record);
+
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_INVALID_MESSAGE_TYPE)
+        {
+            continue;
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            break;
+        }
+
+        for (size_t s = 0; s < kMaxServices; s++)
+        {
+            for (unsigned kind = kServiceRecord_Ptr; kind <= kServiceRecord_Txt; kind <<= 1)
+            {
+                if ((answers[s] & kind) == 0)
+                {
+                    continue;
+                }
+                BuildServiceRecord(mServices[s], static_cast<ServiceRecord>(kind), kServiceTtl, ours);
+                if (record.IsSameAs(ours) && record.mTtl >= ours.mTtl / 2)
+                {
+                    answers[s] = static_cast<uint8_t>(answers[s] & ~kind);
+                }
+            }
+        }
+    }
+
+    // Along with a PTR answer, send the records the querier will need to resolve the instance.
+    for (size_t s = 0; s < kMaxServices; s++)
+    {
+        if (answers[s] & kServiceRecord_Ptr)
+        {
+            additional[s] = static_cast<uint8_t>((kServiceRecord_Srv | kServiceRecord_Txt) & ~answers[s]);
+        }
+        if ((answers[s] | additional[s]) & kServiceRecord_Srv)
+        {
+            additionalAddresses = !answerAddresses;
+        }
+    }
+
+    if (AddServiceRecords(writer, answers, true, kServiceTtl) == CHIP_NO_ERROR &&
+        (!answerAddresses || AddAddressRecords(writer, pktInfo.Interface, true) == CHIP_NO_ERROR))
+    {
+        // Additional records that do not fit are left out; the querier can still ask for them.
+        if (AddServiceRecords(writer, additional, false, kServiceTtl) == CHIP_NO_ERROR && additionalAddresses)
+        {
+            AddAddressRecords(writer, pktInfo.Interface, false);
+        }
+    }
+
+    if (writer.IsEmpty())
+    {
+        return;
+    }
+
+    // Legacy queriers, which do not send from the mDNS port, expect the ID of their query in the response.
+    const size_t length = writer.Finish(legacy ? header.mId : 0, kResponseFlags);
+
+    if (unicast)
+    {
+        SendMessage(endPoint, pktInfo.SrcAddress, pktInfo.SrcPort, pktInfo.Interface, message, length);
+    }
+    else
+    {
+        SendMulticast(endPoint, pktInfo.Interface, message, length);
+    }
+}
+
+void MdnsServer::HandleResponse(DnsReader & reader, const DnsHeader & header)
+{
+    const uint64_t now     = System::Platform::Layer::GetClock_MonotonicMS();
+    const size_t numRecord = static_cast<size_t>(header.mAnswerCount + header.mAuthorityCount + header.mAdditionalCount);
+    DnsQuestion question;
+    DnsRecord record;
+
+    for (uint16_t i = 0; i < header.mQuestionCount; i++)
+    {
+        if (reader.ReadQuestion(question) != CHIP_NO_ERROR)
+        {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < numRecord; i++)
+    {
+        CHIP_ERROR err = reader.ReadRecord(record);
+
+        if (err == CHIP_NO_ERROR)
+        {
+            mCache.Add(record, now);
+        }
+        else if (err != CHIP_ERROR_BUFFER_TOO_SMALL && err != CHIP_ERROR_INVALID_MESSAGE_TYPE)
+        {
+            break;
+        }
+    }
+
+    ProcessQueries();
+}
+
+void MdnsServer::BuildServiceRecord(const Service & service, ServiceRecord kind, uint32_t ttl, DnsRecord & record) const
+{
+    // Names always fit in the record data, so the setters cannot fail.
+    record.mTtl        = ttl;
+    record.mCacheFlush = (kind != kServiceRecord_Ptr); // PTR records are shared by all the instances of a type
+
+    switch (kind)
+    {
+    case kServiceRecord_Ptr:
+        record.mName = service.mTypeName;
+        record.SetPtr(service.mInstanceName);
+        break;
+    case kServiceRecord_Srv:
+        record.mName = service.mInstanceName;
+        record.SetSrv(service.mPort, mHostName);
+        break;
+    case kServiceRecord_Txt:
+        record.mName       = service.mInstanceName;
+        record.mType       = DnsRecordType::kTxt;
+        record.mDataLength = service.mTxtLength;
+        memcpy(record.mData, service.mTxt, service.mTxtLength);
+        break;
+    }
+}
+
+CHIP_ERROR MdnsServer::AddServiceRecords(DnsWriter & writer, const uint8_t * kinds, bool asAnswers, uint32_t ttl) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    DnsRecord record;
+
+    for (size_t s = 0; s < kMaxServices && err == CHIP_NO_ERROR; s++)
+    {
+        for (unsigned kind = kServiceRecord_Ptr; kind <= kServiceRecord_Txt && err == CHIP_NO_ERROR; kind <<= 1)
+        {
+            if (kinds[s] & kind)
+            {
+                BuildServiceRecord(mServices[s], static_cast<ServiceRecord>(kind), ttl, record);
+                err = asAnswers ? writer.AddAnswer(record) : writer.AddAdditional(record);
+            }
+        }
+    }
+
+    return err;
+}
+
+CHIP_ERROR MdnsServer::AddAddressRecords(DnsWriter & writer, Inet::InterfaceId interface, bool asAnswers) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    Inet::IPAddress addresses[kMaxAddresses];
+    const size_t count = GetHostAddresses(interface, addresses, kMaxAddresses);
+    DnsRecord record;
+
+    record.mName       = mHostName;
+    record.mTtl        = kHostTtl;
+    record.mCacheFlush = true;
+
+    for (size_t i = 0; i < count && err == CHIP_NO_ERROR; i++)
+    {
+        SuccessOrExit(err = record.SetAddress(addresses[i]));
+        err = asAnswers ? writer.AddAnswer(record) : writer.AddAdditional(record);
+    }
+
+exit:
+    return err;
+}
+
+size_t MdnsServer::GetHostAddresses(Inet::InterfaceId interface, Inet::IPAddress * addresses, size_t maxAddresses) const
+{
+    size_t count = 0;
+
+    for (Inet::InterfaceAddressIterator it; it.HasCurrent() && count < maxAddresses; it.Next())
+    {
+        const bool onInterface = (interface != INET_NULL_INTERFACEID) ? (it.GetInterfaceId() == interface) : it.SupportsMulticast();
+
+        if (it.IsUp() && onInterface)
+        {
+            addresses[count++] = it.GetAddress();
+        }
+    }
+
+    return count;
+}
+
+CHIP_ERROR MdnsServer::Announce(size_t serviceIndex, uint32_t ttl)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    uint8_t kinds[kMaxServices] = {};
+    uint8_t message[kMaxMessageSize];
+    DnsWriter writer(message, sizeof(message));
+
+    kinds[serviceIndex] = kServiceRecord_Ptr | kServiceRecord_Srv | kServiceRecord_Txt;
+
+    SuccessOrExit(err = AddServiceRecords(writer, kinds, true, ttl));
+    if (ttl != 0)
+    {
+        // The host keeps its addresses when a service goes away, so goodbyes do not withdraw them.
+        SuccessOrExit(err = AddAddressRecords(writer, mInterface, false));
+    }
+
+    err = SendMulticast(nullptr, mInterface, message, writer.Finish(0, kResponseFlags));
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "mDNS announcement failed: %d", err);
+    }
+    return err;
+}
+
+CHIP_ERROR MdnsServer::SendQuery(Query & query, uint64_t now)
+{
+    CHIP_ERROR err          = CHIP_NO_ERROR;
+    const DnsRecord * known = nullptr;
+    uint8_t message[kMaxMessageSize];
+    DnsWriter writer(message, sizeof(message));
+
+    if (query.mBrowseCallback != nullptr)
+    {
+        SuccessOrExit(err = writer.AddQuestion(query.mName, DnsRecordType::kPtr, false));
+
+        // Known answers that do not fit are left out; their responders will just answer again.
+        while ((known = mCache.Find(query.mName, DnsRecordType::kPtr, now, known)) != nullptr)
+        {
+            if (!mCache.IsPastHalfLife(*known, now) &&
+                writer.AddAnswer(*known, mCache.GetRemainingTtl(*known, now)) != CHIP_NO_ERROR)
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        // No known answers here: suppressing SRV would also suppress the address records that come along with it.
+        SuccessOrExit(err = writer.AddQuestion(query.mName, DnsRecordType::kSrv, false));
+        SuccessOrExit(err = writer.AddQuestion(query.mName, DnsRecordType::kTxt, false));
+    }
+
+    err = SendMulticast(nullptr, mInterface, message, writer.Finish(0, 0));
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MdnsServer::SendMulticast(Inet::UDPEndPoint * endPoint, Inet::InterfaceId interface, const uint8_t * message,
+                                     size_t length)
+{
+    CHIP_ERROR err = INET_ERROR_UNKNOWN_INTERFACE;
+
+    if (endPoint == nullptr)
+    {
+        Inet::UDPEndPoint * endPoints[] = { mEndPointIPv6, mEndPointIPv4 };
+
+        err = CHIP_ERROR_INCORRECT_STATE;
+        for (Inet::UDPEndPoint * each : endPoints)
+        {
+            if (each != nullptr && SendMulticast(each, interface, message, length) == CHIP_NO_ERROR)
+            {
+                err = CHIP_NO_ERROR;
+            }
+        }
+    }
+    else if (interface != INET_NULL_INTERFACEID)
+    {
+        err = SendMessage(endPoint, GetGroupAddress(endPoint), mPort, interface, message, length);
+    }
+    else
+    {
+        for (Inet::InterfaceIterator it; it.HasCurrent(); it.Next())
+        {
+            if (it.IsUp() && it.SupportsMulticast() &&
+                SendMessage(endPoint, GetGroupAddress(endPoint), mPort, it.GetInterfaceId(), message, length) == CHIP_NO_ERROR)
+            {
+                err = CHIP_NO_ERROR;
+            }
+        }
+    }
+
+    return err;
+}
+
+CHIP_ERROR MdnsServer::SendMessage(Inet::UDPEndPoint * endPoint, const Inet::IPAddress & address, uint16_t port,
+                                   Inet::InterfaceId interface, const uint8_t * message, size_t length)
+{
+    CHIP_ERROR err                = CHIP_NO_ERROR;
+    System::PacketBuffer * buffer = System::PacketBuffer::NewWithAvailableSize(static_cast<uint16_t>(length));
+
+    VerifyOrExit(buffer != nullptr, err = CHIP_ERROR_NO_MEMORY);
+    VerifyOrExit(buffer->AvailableDataLength() >= length, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    memcpy(buffer->Start(), message, length);
+    buffer->SetDataLength(static_cast<uint16_t>(length));
+
+    // SendTo() takes the buffer, even when it fails.
+    err    = endPoint->SendTo(address, port, interface, buffer);
+    buffer = nullptr;
+
+exit:
+    if (buffer != nullptr)
+    {
+        System::PacketBuffer::Free(buffer);
+    }
+    return err;
+}
+
+MdnsServer::Query * MdnsServer::AllocateQuery(uint64_t now, uint32_t timeout)
+{
+    for (Query & query : mQueries)
+    {
+        if (query.mName.IsEmpty())
+        {
+            query.mBrowseCallback  = nullptr;
+            query.mResolveCallback = nullptr;
+            query.mContext         = nullptr;
+            query.mDeadline        = now + timeout;
+            query.mNextSend        = now;
+            query.mRetryInterval   = kQueryRetryInterval;
+            return &query;
+        }
+    }
+
+    return nullptr;
+}
+
+bool MdnsServer::CompleteResolve(Query & query, uint64_t now)
+{
+    const DnsRecord * srv     = mCache.Find(query.mName, DnsRecordType::kSrv, now);
+    const DnsRecord * txt     = mCache.Find(query.mName, DnsRecordType::kTxt, now);
+    const DnsRecord * address = nullptr;
+    MdnsResolveCallback callback;
+    void * context;
+    MdnsService service;
+    TextEntry entries[kMaxTextEntries];
+    char text[DnsRecord::kMaxDataLength];
+    DnsName target;
+    DnsName typeName;
+    Inet::IPAddress ip;
+    uint16_t port;
+    CHIP_ERROR err;
+
+    if (srv == nullptr || txt == nullptr || srv->GetSrv(port, target) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    address = mCache.Find(target, DnsRecordType::kAaaa, now);
+    if (address == nullptr)
+    {
+        address = mCache.Find(target, DnsRecordType::kA, now);
+    }
+    if (address == nullptr || address->GetAddress(ip) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    // Free the query first: the callback may well start another one.
+    callback = query.mResolveCallback;
+    context  = query.mContext;
+
+    // Resolve() only builds queries whose labels fit, but a failure must not hand out a service with a truncated name.
+    if ((err = query.mName.GetFirstLabel(service.mName, sizeof(service.mName))) != CHIP_NO_ERROR ||
+        (err = typeName.SetParent(query.mName)) != CHIP_NO_ERROR ||
+        (err = typeName.GetFirstLabel(service.mType, sizeof(service.mType))) != CHIP_NO_ERROR)
+    {
+        query.mName = DnsName();
+        callback(context, nullptr, err);
+        return true;
+    }
+
+    service.mProtocol      = query.mProtocol;
+    service.mPort          = port;
+    service.interface      = mInterface;
+    service.mTextEntryies  = entries;
+    service.mTextEntrySize = ParseTxt(*txt, entries, kMaxTextEntries, text);
+    service.mAddress.SetValue(ip);
+
+    query.mName = DnsName();
+    callback(context, &service, CHIP_NO_ERROR);
+
+    return true;
+}
+
+void MdnsServer::CompleteBrowse(Query & query, uint64_t now)
+{
+    MdnsService services[kMaxBrowseResults];
+    size_t count                = 0;
+    const DnsRecord * ptr       = nullptr;
+    MdnsBrowseCallback callback = query.mBrowseCallback;
+    void * context              = query.mContext;
+    char type[kMdnsTypeMaxSize + 1];
+    DnsName instance;
+    CHIP_ERROR err = query.mName.GetFirstLabel(type, sizeof(type));
+
+    if (err != CHIP_NO_ERROR)
+    {
+        query.mName = DnsName();
+        callback(context, nullptr, 0, err);
+        return;
+    }
+
+    while (count < kMaxBrowseResults && (ptr = mCache.Find(query.mName, DnsRecordType::kPtr, now, ptr)) != nullptr)
+    {
+        MdnsService & service = services[count];
+
+        if (ptr->GetPtr(instance) != CHIP_NO_ERROR ||
+            instance.GetFirstLabel(service.mName, sizeof(service.mName)) != CHIP_NO_ERROR)
+        {
+            continue;
+        }
+        strcpy(service.mType, type);
+        service.mProtocol      = query.mProtocol;
+        service.mPort          = 0;
+        service.interface      = mInterface;
+        service.mTextEntryies  = nullptr;
+        service.mTextEntrySize = 0;
+        count++;
+    }
+
+    query.mName = DnsName();
+    callback(context, services, count, CHIP_NO_ERROR);
+}
+
+void MdnsServer::ProcessQueries()
+{
+    const uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+
+    for (Query & query : mQueries)
+    {
+        if (query.mName.IsEmpty() || (query.mResolveCallback != nullptr && CompleteResolve(query, now)))
+        {
+            continue;
+        }
+
+        if (now >= query.mDeadline)
+        {
+            if (query.mBrowseCallback != nullptr)
+            {
+                CompleteBrowse(query, now);
+            }
+            else
+            {
+                MdnsResolveCallback callback = query.mResolveCallback;
+
+                query.mName = DnsName();
+                callback(query.mContext, nullptr, CHIP_ERROR_TIMEOUT);
+            }
+        }
+        else if (now >= query.mNextSend)
+        {
+            // A query that could not be sent is tried again at the next retransmission.
+            SendQuery(query, now);
+            query.mNextSend = now + query.mRetryInterval;
+            query.mRetryInterval *= 2;
+        }
+    }
+
+    // A query callback may have shut the server down.
+    if (mInetLayer != nullptr)
+    {
+        ScheduleTimer();
+    }
+}
+
+void MdnsServer::ScheduleTimer()
+{
+    const uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+    uint64_t next      = UINT64_MAX;
+
+    for (const Query & query : mQueries)
+    {
+        if (!query.mName.IsEmpty())
+        {
+            next = (query.mDeadline < next) ? query.mDeadline : next;
+            next = (query.mNextSend < next) ? query.mNextSend : next;
+        }
+    }
+
+    mInetLayer->SystemLayer()->CancelTimer(HandleTimer, this);
+    if (next != UINT64_MAX)
+    {
+        mInetLayer->SystemLayer()->StartTimer(static_cast<uint32_t>((next > now) ? next - now : 0), HandleTimer, this);
+    }
+}
+
+void MdnsServer::HandleTimer(System::Layer * systemLayer, void * appState, System::Error error)
+{
+    static_cast<MdnsServer *>(appState)->ProcessQueries();
+}
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
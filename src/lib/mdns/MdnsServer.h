@@ -0,0 +1,192 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a native mDNS responder and querier, which runs
+ *      directly on InetLayer UDP endpoints instead of a system mDNS
+ *      service.
+ *
+ *      The server answers queries for the services it publishes, with
+ *      known-answer suppression, and resolves services published by
+ *      other hosts through a TTL-aware record cache, which every
+ *      received response feeds.  Messages are parsed and built in fixed
+ *      buffers; nothing is allocated besides the packet buffers.
+ *
+ *      Probing and conflict resolution are not implemented: published
+ *      names are assumed to be unique, as CHIP instance names are.
+ */
+
+#pragma once
+
+#include "DnsMessage.h"
+#include "RecordCache.h"
+
+#include "core/CHIPConfig.h"
+#include "inet/InetLayer.h"
+#include "lib/mdns/platform/Mdns.h"
+#include "system/SystemLayer.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+class MdnsServer
+{
+public:
+    static constexpr uint16_t kMdnsPort = 5353;
+
+    static constexpr uint32_t kHostTtl    = 120;  // Seconds, for address records
+    static constexpr uint32_t kServiceTtl = 4500; // Seconds, for the other records
+
+    /**
+     * How long, in milliseconds, Browse() collects answers before reporting them.
+     */
+    static constexpr uint32_t kBrowseDuration = 500;
+
+    /**
+     * How long, in milliseconds, Resolve() waits for answers before failing with CHIP_ERROR_TIMEOUT.
+     */
+    static constexpr uint32_t kResolveTimeout = 3000;
+
+    /**
+     * Delay, in milliseconds, before a query that was not answered is sent again.  The delay doubles after each
+     * retransmission.
+     */
+    static constexpr uint32_t kQueryRetryInterval = 1000;
+
+    static constexpr size_t kMaxBrowseResults = 8;
+    static constexpr size_t kMaxTextEntries   = 8;
+    static constexpr size_t kMaxAddresses     = 4;
+
+    MdnsServer() = default;
+
+    /**
+     * Opens the IPv6 and IPv4 endpoints and joins the mDNS multicast groups.  Failing to set up one of the two
+     * address families is not an error.
+     *
+     * @param interface  The interface to run on, or INET_NULL_INTERFACEID for all multicast-capable interfaces.
+     * @param port       The port to run on, which is only meant to be changed by tests.
+     */
+    CHIP_ERROR Init(Inet::InetLayer & inetLayer, Inet::InterfaceId interface = INET_NULL_INTERFACEID,
+                    uint16_t port = kMdnsPort);
+    void Shutdown();
+
+    CHIP_ERROR SetHostname(const char * hostname);
+
+    /**
+     * Publishes a service, or updates its port and text entries if already published, and announces it.
+     */
+    CHIP_ERROR PublishService(const MdnsService & service);
+
+    /**
+     * Withdraws all the published services, sending goodbye records for them.
+     */
+    CHIP_ERROR StopPublish();
+
+    /**
+     * Looks for instances of a service type, and reports those found after kBrowseDuration.
+     */
+    CHIP_ERROR Browse(const char * type, MdnsServiceProtocol protocol, MdnsBrowseCallback callback, void * context);
+
+    /**
+     * Resolves the port, address and text entries of a service instance.  When the cache already holds them, the
+     * callback is called before Resolve() returns.
+     */
+    CHIP_ERROR Resolve(const char * name, const char * type, MdnsServiceProtocol protocol, MdnsResolveCallback callback,
+                       void * context);
+
+    const RecordCache & GetCache() const { return mCache; }
+
+private:
+    enum ServiceRecord : uint8_t
+    {
+        kServiceRecord_Ptr = 0x01,
+        kServiceRecord_Srv = 0x02,
+        kServiceRecord_Txt = 0x04,
+    };
+
+    struct Service
+    {
+        DnsName mInstanceName; // Empty when the slot is free
+        DnsName mTypeName;
+        uint16_t mPort;
+        uint16_t mTxtLength;
+        uint8_t mTxt[DnsRecord::kMaxDataLength];
+    };
+
+    struct Query
+    {
+        DnsName mName; // Service type for a browse, instance for a resolve; empty when the slot is free
+        MdnsServiceProtocol mProtocol;
+        MdnsBrowseCallback mBrowseCallback;
+        MdnsResolveCallback mResolveCallback;
+        void * mContext;
+        uint64_t mDeadline;
+        uint64_t mNextSend;
+        uint32_t mRetryInterval;
+    };
+
+    static constexpr size_t kMaxServices    = CHIP_CONFIG_MDNS_MAX_SERVICES;
+    static constexpr size_t kMaxQueries     = CHIP_CONFIG_MDNS_MAX_QUERIES;
+    static constexpr size_t kMaxMessageSize = 1232; // Fits in the IPv6 minimum MTU
+
+    static CHIP_ERROR MakeTypeName(const char * type, MdnsServiceProtocol protocol, DnsName & name);
+    static void HandleMessageReceived(Inet::IPEndPointBasis * endPoint, System::PacketBuffer * msg,
+                                      const Inet::IPPacketInfo * pktInfo);
+    static void HandleTimer(System::Layer * systemLayer, void * appState, System::Error error);
+
+    CHIP_ERROR OpenEndPoint(Inet::IPAddressType addressType, Inet::UDPEndPoint *& endPoint);
+    void CloseEndPoint(Inet::UDPEndPoint *& endPoint);
+    Inet::IPAddress GetGroupAddress(const Inet::UDPEndPoint * endPoint) const;
+
+    void HandleQuery(DnsReader & reader, const DnsHeader & header, Inet::UDPEndPoint * endPoint,
+                     const Inet::IPPacketInfo & pktInfo);
+    void HandleResponse(DnsReader & reader, const DnsHeader & header);
+
+    void BuildServiceRecord(const Service & service, ServiceRecord kind, uint32_t ttl, DnsRecord & record) const;
+    CHIP_ERROR AddServiceRecords(DnsWriter & writer, const uint8_t * kinds, bool asAnswers, uint32_t ttl) const;
+    CHIP_ERROR AddAddressRecords(DnsWriter & writer, Inet::InterfaceId interface, bool asAnswers) const;
+    size_t GetHostAddresses(Inet::InterfaceId interface, Inet::IPAddress * addresses, size_t maxAddresses) const;
+
+    CHIP_ERROR Announce(size_t serviceIndex, uint32_t ttl);
+    CHIP_ERROR SendQuery(Query & query, uint64_t now);
+    // Sends on both endpoints when endPoint is null, and on all multicast-capable interfaces when interface is null.
+    CHIP_ERROR SendMulticast(Inet::UDPEndPoint * endPoint, Inet::InterfaceId interface, const uint8_t * message, size_t length);
+    CHIP_ERROR SendMessage(Inet::UDPEndPoint * endPoint, const Inet::IPAddress & address, uint16_t port,
+                           Inet::InterfaceId interface, const uint8_t * message, size_t length);
+
+    Query * AllocateQuery(uint64_t now, uint32_t timeout);
+    bool CompleteResolve(Query & query, uint64_t now);
+    void CompleteBrowse(Query & query, uint64_t now);
+    void ProcessQueries();
+    void ScheduleTimer();
+
+    Inet::InetLayer * mInetLayer      = nullptr;
+    Inet::UDPEndPoint * mEndPointIPv6 = nullptr;
+    Inet::UDPEndPoint * mEndPointIPv4 = nullptr;
+    Inet::InterfaceId mInterface      = INET_NULL_INTERFACEID;
+    uint16_t mPort                    = kMdnsPort;
+    DnsName mHostName;
+    Service mServices[kMaxServices];
+    Query mQueries[kMaxQueries];
+    RecordCache mCache;
+};
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
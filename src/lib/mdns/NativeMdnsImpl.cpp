@@ -0,0 +1,92 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the platform mDNS API on the native mDNS
+ *      server, running on the InetLayer of the device layer.  It replaces
+ *      the platform implementation when chip_mdns_native is set.
+ */
+
+#include "lib/mdns/platform/Mdns.h"
+
+#include "MdnsServer.h"
+
+#include "platform/CHIPDeviceLayer.h"
+#include "support/CodeUtils.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+namespace {
+
+MdnsServer sMdnsServer;
+
+} // namespace
+
+CHIP_ERROR ChipMdnsInit(MdnsAsnycReturnCallback initCallback, MdnsAsnycReturnCallback errorCallback, void * context)
+{
+    CHIP_ERROR error = sMdnsServer.Init(DeviceLayer::InetLayer);
+
+    initCallback(context, error);
+
+    return error;
+}
+
+CHIP_ERROR ChipMdnsSetHostname(const char * hostname)
+{
+    return sMdnsServer.SetHostname(hostname);
+}
+
+CHIP_ERROR ChipMdnsPublishService(const MdnsService * service)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(service != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    error = sMdnsServer.PublishService(*service);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR ChipMdnsStopPublish()
+{
+    return sMdnsServer.StopPublish();
+}
+
+CHIP_ERROR ChipMdnsBrowse(const char * type, MdnsServiceProtocol protocol, chip::Inet::InterfaceId /*interface*/,
+                          MdnsBrowseCallback callback, void * context)
+{
+    return sMdnsServer.Browse(type, protocol, callback, context);
+}
+
+CHIP_ERROR ChipMdnsResolve(MdnsService * browseResult, chip::Inet::InterfaceId /*interface*/, MdnsResolveCallback callback,
+                           void * context)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(browseResult != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    error = sMdnsServer.Resolve(browseResult->mName, browseResult->mType, browseResult->mProtocol, callback, context);
+
+exit:
+    return error;
+}
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
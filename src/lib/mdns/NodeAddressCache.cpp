@@ -0,0 +1,342 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "NodeAddressCache.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "support/CodeUtils.h"
+#include "support/logging/CHIPLogging.h"
+#include "system/SystemClock.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+namespace {
+
+// Matches the operational instance name published by the nodes, see Publisher.
+void MakeInstanceName(NodeId nodeId, uint64_t fabricId, char (&name)[kMdnsNameMaxSize + 1])
+{
+    snprintf(name, sizeof(name), "%" PRIX64 "-%" PRIX64, nodeId, fabricId);
+}
+
+} // namespace
+
+CHIP_ERROR NodeAddressCache::Init(System::Layer & systemLayer, uint64_t fabricId, ResolveFunct resolve, uint32_t ttl,
+                                  uint32_t negativeTtl)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(mSystemLayer == nullptr, error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(resolve != nullptr && ttl > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer = &systemLayer;
+    mResolve     = resolve;
+    mFabricId    = fabricId;
+    mTtl         = ttl;
+    mNegativeTtl = negativeTtl;
+
+    for (Entry & entry : mEntries)
+    {
+        entry.mCache = this;
+        entry.mState = EntryState::kFree;
+    }
+
+exit:
+    return error;
+}
+
+void NodeAddressCache::Shutdown()
+{
+    if (mSystemLayer == nullptr)
+    {
+        return;
+    }
+
+    mSystemLayer->CancelTimer(HandleTimer, this);
+    mSystemLayer = nullptr;
+
+    for (Entry & entry : mEntries)
+    {
+        entry.mState = EntryState::kFree;
+    }
+}
+
+CHIP_ERROR NodeAddressCache::LookupPeerAddress(NodeId peerNodeId, Transport::PeerAddress & address)
+{
+    CHIP_ERROR error   = CHIP_NO_ERROR;
+    const uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+    Entry * entry      = nullptr;
+
+    VerifyOrExit(mSystemLayer != nullptr, error = CHIP_ERROR_INCORRECT_STATE);
+
+    entry = FindEntry(peerNodeId);
+    if (entry != nullptr && entry->mState != EntryState::kResolving && now >= entry->mExpiry)
+    {
+        if (entry->mRefreshing)
+        {
+            // The refresh did not come back in time; wait for it like for a first resolve
+            entry->mState      = EntryState::kResolving;
+            entry->mRefreshing = false;
+        }
+        else
+        {
+            entry->mState = EntryState::kFree;
+            entry         = nullptr;
+        }
+    }
+
+    if (entry == nullptr)
+    {
+        entry = AllocateEntry(peerNodeId);
+        VerifyOrExit(entry != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        SuccessOrExit(error = StartResolve(*entry));
+    }
+
+    entry->mLastUsed = now;
+
+    switch (entry->mState)
+    {
+    case EntryState::kResolved:
+        address = entry->mAddress;
+        if (!entry->mUsed)
+        {
+            entry->mUsed = true;
+            ScheduleTimer();
+        }
+        break;
+    case EntryState::kFailed:
+        error = entry->mError;
+        break;
+    default:
+        error = CHIP_ERROR_NOT_CONNECTED;
+        break;
+    }
+
+exit:
+    return error;
+}
+
+void NodeAddressCache::Invalidate(NodeId peerNodeId)
+{
+    Entry * entry = FindEntry(peerNodeId);
+
+    if (entry == nullptr || entry->mState == EntryState::kResolving)
+    {
+        return;
+    }
+
+    if (entry->mRefreshing)
+    {
+        entry->mState      = EntryState::kResolving;
+        entry->mRefreshing = false;
+    }
+    else
+    {
+        entry->mState = EntryState::kFree;
+    }
+}
+
+NodeAddressCache::Entry * NodeAddressCache::FindEntry(NodeId nodeId)
+{
+    for (Entry & entry : mEntries)
+    {
+        if (entry.mState != EntryState::kFree && entry.mNodeId == nodeId)
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+NodeAddressCache::Entry * NodeAddressCache::AllocateEntry(NodeId nodeId)
+{
+    Entry * victim = nullptr;
+
+    for (Entry & entry : mEntries)
+    {
+        if (entry.mState == EntryState::kFree)
+        {
+            victim = &entry;
+            break;
+        }
+
+        // Entries waiting for a resolve are kept, as the resolve callback refers to them
+        if (entry.mState != EntryState::kResolving && !entry.mRefreshing &&
+            (victim == nullptr || entry.mLastUsed < victim->mLastUsed))
+        {
+            victim = &entry;
+        }
+    }
+
+    if (victim != nullptr)
+    {
+        victim->mNodeId     = nodeId;
+        victim->mState      = EntryState::kResolving;
+        victim->mRefreshing = false;
+        victim->mUsed       = false;
+        victim->mError      = CHIP_NO_ERROR;
+        victim->mExpiry     = 0;
+        victim->mLastUsed   = 0;
+    }
+
+    return victim;
+}
+
+CHIP_ERROR NodeAddressCache::StartResolve(Entry & entry)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    MdnsService service;
+
+    MakeInstanceName(entry.mNodeId, mFabricId, service.mName);
+    strncpy(service.mType, "_chip", sizeof(service.mType));
+    service.mProtocol      = MdnsServiceProtocol::kMdnsProtocolTcp;
+    service.mPort          = 0;
+    service.interface      = INET_NULL_INTERFACEID;
+    service.mTextEntryies  = nullptr;
+    service.mTextEntrySize = 0;
+
+    // The resolver may answer from its own cache before returning
+    error = mResolve(&service, INET_NULL_INTERFACEID, HandleResolve, &entry);
+    if (error != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to resolve node %s: %d", service.mName, error);
+        if (entry.mState == EntryState::kResolving)
+        {
+            entry.mState = EntryState::kFree;
+        }
+        entry.mRefreshing = false;
+    }
+
+    return error;
+}
+
+void NodeAddressCache::HandleResolve(void * context, MdnsService * result, CHIP_ERROR error)
+{
+    Entry * entry = static_cast<Entry *>(context);
+
+    entry->mCache->CompleteResolve(*entry, result, error);
+}
+
+void NodeAddressCache::CompleteResolve(Entry & entry, const MdnsService * result, CHIP_ERROR error)
+{
+    const uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+    char name[kMdnsNameMaxSize + 1];
+
+    // Drop results for entries that were dropped, or for nodes the entry no longer holds
+    if (mSystemLayer == nullptr || !(entry.mState == EntryState::kResolving || entry.mRefreshing))
+    {
+        return;
+    }
+
+    MakeInstanceName(entry.mNodeId, mFabricId, name);
+    if (error == CHIP_NO_ERROR)
+    {
+        if (result == nullptr || strcmp(result->mName, name) != 0)
+        {
+            return;
+        }
+        if (!result->mAddress.HasValue())
+        {
+            error = CHIP_ERROR_INVALID_ADDRESS;
+        }
+    }
+
+    if (error == CHIP_NO_ERROR)
+    {
+        entry.mAddress = Transport::PeerAddress::UDP(result->mAddress.Value(), result->mPort, result->interface);
+        entry.mState   = EntryState::kResolved;
+        entry.mExpiry  = now + mTtl;
+    }
+    else if (entry.mState == EntryState::kResolved)
+    {
+        // A failed refresh leaves the known address in place until it expires
+        ChipLogError(Discovery, "Failed to refresh address of node %s: %d", name, error);
+    }
+    else
+    {
+        ChipLogError(Discovery, "Failed to resolve node %s: %d", name, error);
+        entry.mState  = EntryState::kFailed;
+        entry.mError  = error;
+        entry.mExpiry = now + mNegativeTtl;
+    }
+    entry.mRefreshing = false;
+    entry.mUsed       = false;
+
+    ScheduleTimer();
+}
+
+uint64_t NodeAddressCache::RefreshTime(const Entry & entry) const
+{
+    return entry.mExpiry - mTtl + static_cast<uint64_t>(mTtl) * kRefreshPercent / 100;
+}
+
+void NodeAddressCache::RefreshEntries()
+{
+    const uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+
+    for (Entry & entry : mEntries)
+    {
+        if (entry.mState == EntryState::kResolved && entry.mUsed && !entry.mRefreshing && RefreshTime(entry) <= now)
+        {
+            // Only an address looked up again after this refresh is refreshed again
+            entry.mRefreshing = true;
+            entry.mUsed       = false;
+            StartResolve(entry);
+        }
+    }
+
+    ScheduleTimer();
+}
+
+void NodeAddressCache::ScheduleTimer()
+{
+    const uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+    uint64_t next      = UINT64_MAX;
+
+    if (mSystemLayer == nullptr)
+    {
+        return;
+    }
+
+    for (const Entry & entry : mEntries)
+    {
+        if (entry.mState == EntryState::kResolved && entry.mUsed && !entry.mRefreshing)
+        {
+            next = (RefreshTime(entry) < next) ? RefreshTime(entry) : next;
+        }
+    }
+
+    mSystemLayer->CancelTimer(HandleTimer, this);
+    if (next != UINT64_MAX)
+    {
+        mSystemLayer->StartTimer(static_cast<uint32_t>((next > now) ? next - now : 0), HandleTimer, this);
+    }
+}
+
+void NodeAddressCache::HandleTimer(System::Layer * systemLayer, void * appState, System::Error error)
+{
+    static_cast<NodeAddressCache *>(appState)->RefreshEntries();
+}
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
@@ -0,0 +1,138 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a cache of operational node addresses, filled by
+ *      resolving the operational mDNS service of each node.
+ *
+ *      Addresses are kept for a fixed time to live, since the platform
+ *      resolve API does not report record TTLs.  Addresses still in use
+ *      are resolved again in the background shortly before they expire,
+ *      so that a peer that keeps talking never takes a miss, and failed
+ *      resolves are cached for a short while so that sending to an
+ *      unreachable node does not flood the network with queries.
+ */
+
+#pragma once
+
+#include "core/CHIPConfig.h"
+#include "core/CHIPError.h"
+#include "lib/mdns/platform/Mdns.h"
+#include "system/SystemLayer.h"
+#include "transport/PeerAddressResolver.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+class NodeAddressCache : public Transport::PeerAddressResolver
+{
+public:
+    using ResolveFunct = CHIP_ERROR (*)(MdnsService * service, Inet::InterfaceId interface, MdnsResolveCallback callback,
+                                        void * context);
+
+    /**
+     * How long, in milliseconds, a resolved address is used: the TTL RFC 6762 recommends for address records.
+     */
+    static constexpr uint32_t kDefaultTtl = 120 * 1000;
+
+    /**
+     * How long, in milliseconds, a failed resolve is reported without resolving again.
+     */
+    static constexpr uint32_t kDefaultNegativeTtl = 5000;
+
+    /**
+     * Share of the time to live, in percent, after which an address that was looked up is resolved again.
+     */
+    static constexpr uint32_t kRefreshPercent = 80;
+
+    NodeAddressCache() = default;
+
+    /**
+     * @param systemLayer    The layer running the refresh timer.
+     * @param fabricId       The fabric of the nodes, which is part of their operational instance names.
+     * @param resolve        The function resolving instance names, which tests replace.
+     * @param ttl            Lifetime of a resolved address in milliseconds, which is only meant to be changed by tests.
+     * @param negativeTtl    Lifetime of a failed resolve in milliseconds, which is only meant to be changed by tests.
+     */
+    CHIP_ERROR Init(System::Layer & systemLayer, uint64_t fabricId, ResolveFunct resolve = ChipMdnsResolve,
+                    uint32_t ttl = kDefaultTtl, uint32_t negativeTtl = kDefaultNegativeTtl);
+
+    /**
+     * Forgets all addresses.  Resolves in progress are not cancelled; their results are dropped.
+     */
+    void Shutdown();
+
+    /**
+     * Returns the address of a node.  On a miss, a resolve is started and CHIP_ERROR_NOT_CONNECTED is returned,
+     * unless the resolver answers before returning.  A node whose resolve failed less than the negative time to
+     * live ago gets the error of that resolve.
+     */
+    CHIP_ERROR LookupPeerAddress(NodeId peerNodeId, Transport::PeerAddress & address) override;
+
+    /**
+     * Drops the address of a node, e.g. after the node stopped answering on it.
+     */
+    void Invalidate(NodeId peerNodeId);
+
+private:
+    enum class EntryState : uint8_t
+    {
+        kFree,
+        kResolving, // No address yet
+        kResolved,
+        kFailed,
+    };
+
+    struct Entry
+    {
+        NodeAddressCache * mCache;
+        NodeId mNodeId;
+        EntryState mState;
+        bool mRefreshing; // A resolved entry being resolved again
+        bool mUsed;       // Looked up since last resolved, which makes it worth refreshing
+        CHIP_ERROR mError;
+        uint64_t mExpiry;
+        uint64_t mLastUsed;
+        Transport::PeerAddress mAddress;
+    };
+
+    static constexpr size_t kCacheSize = CHIP_CONFIG_MDNS_NODE_ADDRESS_CACHE_SIZE;
+
+    static void HandleResolve(void * context, MdnsService * result, CHIP_ERROR error);
+    static void HandleTimer(System::Layer * systemLayer, void * appState, System::Error error);
+
+    Entry * FindEntry(NodeId nodeId);
+    Entry * AllocateEntry(NodeId nodeId);
+    CHIP_ERROR StartResolve(Entry & entry);
+    void CompleteResolve(Entry & entry, const MdnsService * result, CHIP_ERROR error);
+    uint64_t RefreshTime(const Entry & entry) const;
+    void RefreshEntries();
+    void ScheduleTimer();
+
+    System::Layer * mSystemLayer = nullptr;
+    ResolveFunct mResolve        = nullptr;
+    uint64_t mFabricId           = 0;
+    uint32_t mTtl                = kDefaultTtl;
+    uint32_t mNegativeTtl        = kDefaultNegativeTtl;
+    Entry mEntries[kCacheSize];
+};
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
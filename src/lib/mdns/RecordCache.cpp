@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RecordCache.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+void RecordCache::Add(const DnsRecord & record, uint64_t now)
+{
+    size_t slot = kSize;
+
+    for (size_t i = 0; i < kSize; i++)
+    {
+        if (mExpiry[i] <= now)
+        {
+            mExpiry[i] = 0;
+        }
+        else if (mRecords[i].mType == record.mType && mRecords[i].mName == record.mName)
+        {
+            if (mRecords[i].IsSameAs(record))
+            {
+                slot = i;
+            }
+            else if (record.mCacheFlush && mReceived[i] + kCacheFlushGracePeriod < now)
+            {
+                mExpiry[i] = 0;
+            }
+        }
+    }
+
+    if (record.mTtl == 0)
+    {
+        // The record stays for one second, in case another host still holds it and answers right away.
+        if (slot != kSize && mExpiry[slot] > now + kGoodbyeDelay)
+        {
+            mRecords[slot].mTtl = 1;
+            mExpiry[slot]       = now + kGoodbyeDelay;
+        }
+        return;
+    }
+
+    if (slot == kSize)
+    {
+        // Take a free entry, or else the one closest to expiry.
+        slot = 0;
+        for (size_t i = 0; i < kSize && mExpiry[slot] != 0; i++)
+        {
+            if (mExpiry[i] < mExpiry[slot])
+            {
+                slot = i;
+            }
+        }
+        mRecords[slot] = record;
+    }
+
+    mRecords[slot].mTtl = record.mTtl;
+    mReceived[slot]     = now;
+    mExpiry[slot]       = now + record.mTtl * 1000ull;
+}
+
+const DnsRecord * RecordCache::Find(const DnsName & name, DnsRecordType type, uint64_t now, const DnsRecord * previous) const
+{
+    for (size_t i = (previous != nullptr) ? IndexOf(*previous) + 1 : 0; i < kSize; i++)
+    {
+        if (mExpiry[i] > now && (type == DnsRecordType::kAny || mRecords[i].mType == type) && mRecords[i].mName == name)
+        {
+            return &mRecords[i];
+        }
+    }
+
+    return nullptr;
+}
+
+uint32_t RecordCache::GetRemainingTtl(const DnsRecord & record, uint64_t now) const
+{
+    uint64_t expiry = mExpiry[IndexOf(record)];
+
+    return (expiry > now) ? static_cast<uint32_t>((expiry - now) / 1000) : 0;
+}
+
+bool RecordCache::IsPastHalfLife(const DnsRecord & record, uint64_t now) const
+{
+    return (now - mReceived[IndexOf(record)]) * 2 > record.mTtl * 1000ull;
+}
+
+void RecordCache::Clear()
+{
+    for (uint64_t & expiry : mExpiry)
+    {
+        expiry = 0;
+    }
+}
+
+size_t RecordCache::Count(uint64_t now) const
+{
+    size_t count = 0;
+
+    for (uint64_t expiry : mExpiry)
+    {
+        if (expiry > now)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the cache of mDNS records received by the native
+ *      mDNS server.
+ *
+ *      Records expire after their TTL.  A record received with a TTL of 0
+ *      (a "goodbye") expires one second later, as RFC 6762 section 10.1
+ *      describes, and a record received with the cache-flush bit set
+ *      replaces the records of the same name and type received more than a
+ *      second earlier, as RFC 6762 section 10.2 describes.  When the cache is full, the record closest to expiry
+ *      makes room for the new one.
+ */
+
+#pragma once
+
+#include "DnsMessage.h"
+
+#include "core/CHIPConfig.h"
+
+namespace chip {
+namespace Protocols {
+namespace Mdns {
+
+class RecordCache
+{
+public:
+    static constexpr size_t kSize = CHIP_CONFIG_MDNS_CACHE_SIZE;
+
+    RecordCache() { Clear(); }
+
+    /**
+     * Adds a received record, or refreshes its TTL if already cached.
+     *
+     * @param now  Current monotonic time, in milliseconds.
+     */
+    void Add(const DnsRecord & record, uint64_t now);
+
+    /**
+     * Finds the next unexpired record of @p name and @p type, after @p previous if it is not null.
+     *
+     * @param type  The type of the records to find, or DnsRecordType::kAny for all types.
+     */
+    const DnsRecord * Find(const DnsName & name, DnsRecordType type, uint64_t now, const DnsRecord * previous = nullptr) const;
+
+    /**
+     * Returns the remaining TTL of a record returned by Find(), in seconds.
+     */
+    uint32_t GetRemainingTtl(const DnsRecord & record, uint64_t now) const;
+
+    /**
+     * Whether a record returned by Find() has less than half of its TTL left, in which case it should not be sent as
+     * a known answer, as RFC 6762 section 7.1 describes.
+     */
+    bool IsPastHalfLife(const DnsRecord & record, uint64_t now) const;
+
+    void Clear();
+
+    size_t Count(uint64_t now) const;
+
+private:
+    static constexpr uint64_t kCacheFlushGracePeriod = 1000; // Milliseconds
+    static constexpr uint64_t kGoodbyeDelay          = 1000; // Milliseconds
+
+    size_t IndexOf(const DnsRecord & record) const { return static_cast<size_t>(&record - mRecords); }
+
+    DnsRecord mRecords[kSize];
+    uint64_t mReceived[kSize]; // Milliseconds
+    uint64_t mExpiry[kSize];   // Milliseconds, or 0 for an unused entry
+};
+
+} // namespace Mdns
+} // namespace Protocols
+} // namespace chip
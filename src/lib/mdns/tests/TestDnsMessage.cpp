@@ -0,0 +1,362 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the DNS message reader and
+ *      writer and the record cache of the native mDNS server.
+ *
+ */
+
+#include "TestMdns.h"
+
+#include <string.h>
+
+#include <lib/mdns/DnsMessage.h>
+#include <lib/mdns/RecordCache.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Protocols::Mdns;
+
+namespace {
+
+DnsName MakeName(const char * name)
+{
+    DnsName result;
+    result.AppendLabels(name);
+    return result;
+}
+
+DnsRecord MakePtr(const char * name, const char * target, uint32_t ttl)
+{
+    DnsRecord record;
+    record.mName       = MakeName(name);
+    record.mTtl        = ttl;
+    record.mCacheFlush = false;
+    record.SetPtr(MakeName(target));
+    return record;
+}
+
+void CheckNames(nlTestSuite * inSuite, void * inContext)
+{
+    DnsName name = MakeName("_chip._tcp.local");
+    DnsName parent;
+    DnsName instance;
+    char label[16];
+    char longLabel[DnsName::kMaxLabelLength + 2];
+
+    NL_TEST_ASSERT(inSuite, name.Length() == 18);
+    NL_TEST_ASSERT(inSuite, name == MakeName("_CHIP._TCP.Local"));
+    NL_TEST_ASSERT(inSuite, name != MakeName("_chip._udp.local"));
+    NL_TEST_ASSERT(inSuite, name != MakeName("_chip._tcp"));
+
+    // Instance names are single labels, which may hold dots.
+    NL_TEST_ASSERT(inSuite, instance.AppendLabel("node.1", 6) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, instance.Append(name) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, instance.GetFirstLabel(label, sizeof(label)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(label, "node.1") == 0);
+    NL_TEST_ASSERT(inSuite, instance.GetFirstLabel(label, 6) != CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, parent.SetParent(instance) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, parent == name);
+
+    memset(longLabel, 'a', sizeof(longLabel) - 1);
+    longLabel[sizeof(longLabel) - 1] = '\0';
+    NL_TEST_ASSERT(inSuite, instance.AppendLabel(longLabel, strlen(longLabel)) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, instance.AppendLabel(longLabel, strlen(longLabel) - 1) == CHIP_NO_ERROR);
+}
+
+void CheckRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t message[512];
+    DnsWriter writer(message, sizeof(message));
+    DnsHeader header;
+    DnsQuestion question;
+    DnsRecord ptr = MakePtr("_chip._tcp.local", "node._chip._tcp.local", 4500);
+    DnsRecord srv;
+    DnsRecord txt;
+    DnsRecord aaaa;
+    DnsRecord record;
+    DnsName target;
+    Inet::IPAddress address;
+    Inet::IPAddress readAddress;
+    uint16_t port;
+    size_t length;
+
+    srv.mName       = MakeName("node._chip._tcp.local");
+    srv.mTtl        = 4500;
+    srv.mCacheFlush = true;
+    NL_TEST_ASSERT(inSuite, srv.SetSrv(5540, MakeName("host.local")) == CHIP_NO_ERROR);
+
+    txt.mName       = srv.mName;
+    txt.mType       = DnsRecordType::kTxt;
+    txt.mTtl        = 4500;
+    txt.mCacheFlush = true;
+    txt.mDataLength = 0;
+    NL_TEST_ASSERT(inSuite, txt.AppendTxt("CRI", reinterpret_cast<const uint8_t *>("300"), 3) == CHIP_NO_ERROR);
+
+    Inet::IPAddress::FromString("fe80::1", address);
+    aaaa.mName       = MakeName("host.local");
+    aaaa.mTtl        = 120;
+    aaaa.mCacheFlush = true;
+    NL_TEST_ASSERT(inSuite, aaaa.SetAddress(address) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, writer.IsEmpty());
+    NL_TEST_ASSERT(inSuite, writer.AddQuestion(ptr.mName, DnsRecordType::kPtr, true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.AddAnswer(ptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.AddAnswer(srv, 10) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.AddAdditional(txt) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.AddAdditional(aaaa) == CHIP_NO_ERROR);
+    // Sections must be written in order.
+    NL_TEST_ASSERT(inSuite, writer.AddQuestion(ptr.mName, DnsRecordType::kPtr, false) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, writer.AddAnswer(ptr) == CHIP_ERROR_INCORRECT_STATE);
+    length = writer.Finish(0x1234, DnsHeader::kFlagResponse);
+
+    DnsReader reader(message, length);
+    NL_TEST_ASSERT(inSuite, reader.ReadHeader(header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, header.mId == 0x1234 && header.IsResponse());
+    NL_TEST_ASSERT(inSuite, header.mQuestionCount == 1 && header.mAnswerCount == 2 && header.mAdditionalCount == 2);
+
+    NL_TEST_ASSERT(inSuite, reader.ReadQuestion(question) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, question.mName == ptr.mName && question.mType == DnsRecordType::kPtr && question.mUnicastResponse);
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.IsSameAs(ptr) && record.mTtl == 4500 && !record.mCacheFlush);
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.IsSameAs(srv) && record.mTtl == 10 && record.mCacheFlush);
+    NL_TEST_ASSERT(inSuite, record.GetSrv(port, target) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, port == 5540 && target == MakeName("host.local"));
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.IsSameAs(txt) && record.mDataLength == 8);
+    NL_TEST_ASSERT(inSuite, memcmp(record.mData, "\x07" "CRI=300", 8) == 0);
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.GetAddress(readAddress) == CHIP_NO_ERROR && readAddress == address);
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) != CHIP_NO_ERROR);
+
+    // A record that does not fit is left out entirely.
+    DnsWriter small(message, 70);
+    NL_TEST_ASSERT(inSuite, small.AddAnswer(ptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, small.AddAnswer(srv) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    length = small.Finish(0, DnsHeader::kFlagResponse);
+    NL_TEST_ASSERT(inSuite, length == 12 + 18 + 10 + 23);
+}
+
+void CheckCompression(nlTestSuite * inSuite, void * inContext)
+{
+    // clang-format off
+    const uint8_t message[] =
+    {
+        0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+        // _chip._tcp.local PTR, target "node" + pointer to the record name
+        5, '_', 'c', 'h', 'i', 'p', 4, '_', 't', 'c', 'p', 5, 'l', 'o', 'c', 'a', 'l', 0,
+        0x00, 0x0C, 0x00, 0x01, 0x00, 0x00, 0x11, 0x94, 0x00, 0x07,
+        4, 'n', 'o', 'd', 'e', 0xC0, 12,
+        // node._chip._tcp.local SRV, named by a pointer to the PTR data; target "host" + pointer to "local"
+        0xC0, 40,
+        0x00, 0x21, 0x80, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x0D,
+        0x00, 0x00, 0x00, 0x00, 0x15, 0xA4, 4, 'h', 'o', 's', 't', 0xC0, 23,
+    };
+    // clang-format on
+    DnsReader reader(message, sizeof(message));
+    DnsHeader header;
+    DnsRecord record;
+    DnsName target;
+    uint16_t port;
+
+    NL_TEST_ASSERT(inSuite, reader.ReadHeader(header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, header.IsResponse() && header.mAnswerCount == 2);
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.mName == MakeName("_chip._tcp.local") && record.mTtl == 4500);
+    NL_TEST_ASSERT(inSuite, record.GetPtr(target) == CHIP_NO_ERROR && target == MakeName("node._chip._tcp.local"));
+
+    NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.mName == MakeName("node._chip._tcp.local") && record.mCacheFlush);
+    NL_TEST_ASSERT(inSuite, record.GetSrv(port, target) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, port == 5540 && target == MakeName("host.local"));
+}
+
+void CheckMalformed(nlTestSuite * inSuite, void * inContext)
+{
+    // clang-format off
+    const uint8_t loop[] =
+    {
+        0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        4, 'l', 'o', 'o', 'p', 0xC0, 12,
+    };
+    const uint8_t forward[] =
+    {
+        0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0xC0, 14, 0,
+    };
+    const uint8_t overrun[] =
+    {
+        0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        1, 'a', 0, 0x00, 0x10, 0x00, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x20, 'x',
+    };
+    const uint8_t otherClass[] =
+    {
+        0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+        1, 'a', 0, 0x00, 0x10, 0x00, 0x03, 0x00, 0x00, 0x00, 0x78, 0x00, 0x01, 0,
+        1, 'b', 0, 0x00, 0x10, 0x00, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x01, 0,
+    };
+    // clang-format on
+    DnsHeader header;
+    DnsRecord record;
+
+    DnsReader loopReader(loop, sizeof(loop));
+    NL_TEST_ASSERT(inSuite, loopReader.ReadHeader(header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, loopReader.ReadRecord(record) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    DnsReader forwardReader(forward, sizeof(forward));
+    NL_TEST_ASSERT(inSuite, forwardReader.ReadHeader(header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, forwardReader.ReadRecord(record) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    DnsReader overrunReader(overrun, sizeof(overrun));
+    NL_TEST_ASSERT(inSuite, overrunReader.ReadHeader(header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, overrunReader.ReadRecord(record) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    // A record of another class is skipped, and the next one can still be read.
+    DnsReader classReader(otherClass, sizeof(otherClass));
+    NL_TEST_ASSERT(inSuite, classReader.ReadHeader(header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, classReader.ReadRecord(record) == CHIP_ERROR_INVALID_MESSAGE_TYPE);
+    NL_TEST_ASSERT(inSuite, classReader.ReadRecord(record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.mName == MakeName("b"));
+
+    // No truncation of a valid message may be read past its end.
+    for (size_t length = 0; length < sizeof(otherClass); length++)
+    {
+        DnsReader reader(otherClass, length);
+        if (reader.ReadHeader(header) == CHIP_NO_ERROR)
+        {
+            reader.ReadRecord(record);
+            NL_TEST_ASSERT(inSuite, reader.ReadRecord(record) != CHIP_NO_ERROR);
+        }
+    }
+}
+
+void CheckCache(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache * cache = new RecordCache();
+    DnsName type        = MakeName("_chip._tcp.local");
+    DnsRecord a         = MakePtr("_chip._tcp.local", "a._chip._tcp.local", 10);
+    DnsRecord b         = MakePtr("_chip._tcp.local", "b._chip._tcp.local", 100);
+    const DnsRecord * found;
+
+    cache->Add(a, 1000);
+    cache->Add(b, 1000);
+    NL_TEST_ASSERT(inSuite, cache->Count(1000) == 2);
+
+    found = cache->Find(type, DnsRecordType::kPtr, 1000);
+    NL_TEST_ASSERT(inSuite, found != nullptr && found->IsSameAs(a));
+    NL_TEST_ASSERT(inSuite, cache->GetRemainingTtl(*found, 1000) == 10);
+    NL_TEST_ASSERT(inSuite, !cache->IsPastHalfLife(*found, 5000));
+    NL_TEST_ASSERT(inSuite, cache->IsPastHalfLife(*found, 7000));
+    found = cache->Find(type, DnsRecordType::kPtr, 1000, found);
+    NL_TEST_ASSERT(inSuite, found != nullptr && found->IsSameAs(b));
+    NL_TEST_ASSERT(inSuite, cache->Find(type, DnsRecordType::kPtr, 1000, found) == nullptr);
+    NL_TEST_ASSERT(inSuite, cache->Find(type, DnsRecordType::kAny, 1000) != nullptr);
+    NL_TEST_ASSERT(inSuite, cache->Find(type, DnsRecordType::kSrv, 1000) == nullptr);
+
+    // Records expire after their TTL, and are refreshed when received again.
+    NL_TEST_ASSERT(inSuite, cache->Count(11000) == 1);
+    cache->Add(a, 10000);
+    NL_TEST_ASSERT(inSuite, cache->Count(11000) == 2);
+
+    // A goodbye leaves the record one more second.
+    b.mTtl = 0;
+    cache->Add(b, 12000);
+    NL_TEST_ASSERT(inSuite, cache->Count(12000) == 2);
+    found = cache->Find(type, DnsRecordType::kPtr, 12000);
+    found = cache->Find(type, DnsRecordType::kPtr, 12000, found);
+    NL_TEST_ASSERT(inSuite, found != nullptr && found->IsSameAs(b));
+    NL_TEST_ASSERT(inSuite, cache->GetRemainingTtl(*found, 12000) == 1);
+    NL_TEST_ASSERT(inSuite, cache->Count(12999) == 2);
+    NL_TEST_ASSERT(inSuite, cache->Count(13000) == 1);
+
+    // A cache-flush record replaces the records of the same name and type received more than a second earlier.
+    DnsRecord first  = MakePtr("host.local", "x.local", 100);
+    DnsRecord second = MakePtr("host.local", "y.local", 100);
+    DnsRecord third  = MakePtr("host.local", "z.local", 100);
+    second.mCacheFlush = true;
+    third.mCacheFlush  = true;
+    cache->Add(first, 12500);
+    cache->Add(second, 13000);
+    NL_TEST_ASSERT(inSuite, cache->Count(13000) == 3);
+    cache->Add(third, 14500);
+    NL_TEST_ASSERT(inSuite, cache->Count(14500) == 2);
+    NL_TEST_ASSERT(inSuite, cache->Find(MakeName("host.local"), DnsRecordType::kPtr, 14500)->IsSameAs(third));
+
+    // A full cache makes room by dropping the record closest to expiry.
+    cache->Clear();
+    for (size_t i = 0; i < RecordCache::kSize; i++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "n%u.local", static_cast<unsigned>(i));
+        cache->Add(MakePtr(name, "t.local", static_cast<uint32_t>(100 + i)), 0);
+    }
+    NL_TEST_ASSERT(inSuite, cache->Count(0) == RecordCache::kSize);
+    cache->Add(MakePtr("new.local", "t.local", 50), 0);
+    NL_TEST_ASSERT(inSuite, cache->Count(0) == RecordCache::kSize);
+    NL_TEST_ASSERT(inSuite, cache->Find(MakeName("n0.local"), DnsRecordType::kPtr, 0) == nullptr);
+    NL_TEST_ASSERT(inSuite, cache->Find(MakeName("n1.local"), DnsRecordType::kPtr, 0) != nullptr);
+    NL_TEST_ASSERT(inSuite, cache->Find(MakeName("new.local"), DnsRecordType::kPtr, 0) != nullptr);
+
+    delete cache;
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Names",       CheckNames),
+    NL_TEST_DEF("Round Trip",  CheckRoundTrip),
+    NL_TEST_DEF("Compression", CheckCompression),
+    NL_TEST_DEF("Malformed",   CheckMalformed),
+    NL_TEST_DEF("Cache",       CheckCache),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestDnsMessage()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "DnsMessage",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDnsMessage)
@@ -0,0 +1,525 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the native mDNS server, which
+ *      run several server instances against each other over the IPv4
+ *      loopback interface, on a port other than that of the system mDNS
+ *      responder.
+ *
+ *      The resolve test also measures how long a resolve takes over the
+ *      network and from the cache.  Only correctness is asserted; the
+ *      rates are informative.
+ */
+
+#include "TestMdns.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <core/CHIPCore.h>
+#include <lib/mdns/MdnsServer.h>
+#include <support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Inet;
+using namespace chip::Protocols::Mdns;
+
+static int Initialize(void * aContext);
+static int Finalize(void * aContext);
+
+namespace {
+
+using TestContext = chip::Test::IOContext;
+TestContext sContext;
+
+constexpr uint16_t kTestPort    = 15353;
+constexpr size_t kNumServers    = 2; // Each takes two of the four UDP endpoints of a Linux InetLayer
+constexpr uint16_t kServicePort = 11097;
+
+constexpr MdnsServiceProtocol kProtocol = MdnsServiceProtocol::kMdnsProtocolTcp;
+
+MdnsServer sServers[kNumServers];
+
+struct ResolveResult
+{
+    bool mDone;
+    CHIP_ERROR mError;
+    char mName[kMdnsNameMaxSize + 1];
+    uint16_t mPort;
+    bool mHasAddress;
+    char mTxt[kMdnsTextMaxSize];
+};
+
+struct BrowseResult
+{
+    bool mDone;
+    size_t mCount;
+    char mNames[MdnsServer::kMaxBrowseResults][kMdnsNameMaxSize + 1];
+};
+
+ResolveResult sResolveResult;
+BrowseResult sBrowseResult;
+
+void HandleResolve(void * context, MdnsService * result, CHIP_ERROR error)
+{
+    ResolveResult & out = *static_cast<ResolveResult *>(context);
+
+    memset(&out, 0, sizeof(out));
+    out.mDone  = true;
+    out.mError = error;
+    if (result != nullptr)
+    {
+        strcpy(out.mName, result->mName);
+        out.mPort       = result->mPort;
+        out.mHasAddress = result->mAddress.HasValue();
+        for (size_t i = 0; i < result->mTextEntrySize; i++)
+        {
+            const TextEntry & entry = result->mTextEntryies[i];
+            if (strcmp(entry.mKey, "CRI") == 0 && entry.mDataSize < sizeof(out.mTxt))
+            {
+                memcpy(out.mTxt, entry.mData, entry.mDataSize);
+            }
+        }
+    }
+}
+
+void HandleBrowse(void * context, MdnsService * services, size_t servicesSize, CHIP_ERROR error)
+{
+    BrowseResult & out = *static_cast<BrowseResult *>(context);
+
+    out.mDone  = true;
+    out.mCount = servicesSize;
+    for (size_t i = 0; i < servicesSize; i++)
+    {
+        strcpy(out.mNames[i], services[i].mName);
+    }
+}
+
+bool HasBrowseResult(const char * name)
+{
+    for (size_t i = 0; i < sBrowseResult.mCount; i++)
+    {
+        if (strcmp(sBrowseResult.mNames[i], name) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+InterfaceId GetLoopbackInterface()
+{
+    IPAddress loopback;
+
+    IPAddress::FromString("127.0.0.1", loopback);
+    for (InterfaceAddressIterator it; it.HasCurrent(); it.Next())
+    {
+        if (it.GetAddress() == loopback)
+        {
+            return it.GetInterfaceId();
+        }
+    }
+
+    return INET_NULL_INTERFACEID;
+}
+
+CHIP_ERROR PublishNode(MdnsServer & server, const char * name)
+{
+    TextEntry entry = { "CRI", reinterpret_cast<const uint8_t *>("300"), 3 };
+    MdnsService service;
+
+    strcpy(service.mName, name);
+    strcpy(service.mType, "_chip");
+    service.mProtocol      = kProtocol;
+    service.mPort          = kServicePort;
+    service.interface      = INET_NULL_INTERFACEID;
+    service.mTextEntryies  = &entry;
+    service.mTextEntrySize = 1;
+
+    return server.PublishService(service);
+}
+
+DnsName GetTypeName()
+{
+    DnsName name;
+    name.AppendLabels("_chip._tcp.local");
+    return name;
+}
+
+void Wait(TestContext & ctx, unsigned ms)
+{
+    ctx.DriveIOUntil(ms, []() { return false; });
+}
+
+/**
+ * Starts servers @p first to @p last, on the loopback interface.  Returns false, for the test to return early, when
+ * the loopback interface has no IPv4 address.
+ */
+bool StartServers(nlTestSuite * inSuite, TestContext & ctx, size_t first, size_t last)
+{
+    InterfaceId loopback = GetLoopbackInterface();
+
+    if (loopback == INET_NULL_INTERFACEID)
+    {
+        printf("%s:%u: No IPv4 loopback interface.\n", __FILE__, __LINE__);
+        return false;
+    }
+
+    for (size_t i = first; i <= last; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sServers[i].Init(ctx.GetInetLayer(), loopback, kTestPort) == CHIP_NO_ERROR);
+    }
+
+    return true;
+}
+
+void StopServers()
+{
+    for (MdnsServer & server : sServers)
+    {
+        server.Shutdown();
+    }
+}
+
+} // namespace
+
+/////////////////////////// Resolve test
+
+void CheckResolve(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    uint64_t start;
+    uint64_t networkTime;
+    uint64_t cacheTime;
+
+    if (!StartServers(inSuite, ctx, 0, 0))
+    {
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, PublishNode(sServers[0], "node-1") == CHIP_NO_ERROR);
+
+    // Start the resolver once the announcement has gone by, so that it has to send a query.
+    Wait(ctx, 100);
+    StartServers(inSuite, ctx, 1, 1);
+
+    memset(&sResolveResult, 0, sizeof(sResolveResult));
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    NL_TEST_ASSERT(inSuite, sServers[1].Resolve("node-1", "_chip", kProtocol, HandleResolve, &sResolveResult) == CHIP_NO_ERROR);
+    ctx.DriveIOUntil(MdnsServer::kResolveTimeout + 1000, []() { return sResolveResult.mDone; });
+    networkTime = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    NL_TEST_ASSERT(inSuite, sResolveResult.mDone && sResolveResult.mError == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(sResolveResult.mName, "node-1") == 0);
+    NL_TEST_ASSERT(inSuite, sResolveResult.mPort == kServicePort);
+    NL_TEST_ASSERT(inSuite, sResolveResult.mHasAddress);
+    NL_TEST_ASSERT(inSuite, strcmp(sResolveResult.mTxt, "300") == 0);
+
+    // The answers are now cached, so the callback comes before Resolve() returns.
+    memset(&sResolveResult, 0, sizeof(sResolveResult));
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    NL_TEST_ASSERT(inSuite, sServers[1].Resolve("node-1", "_chip", kProtocol, HandleResolve, &sResolveResult) == CHIP_NO_ERROR);
+    cacheTime = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    NL_TEST_ASSERT(inSuite, sResolveResult.mDone && sResolveResult.mError == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sResolveResult.mPort == kServicePort);
+
+    printf("Resolve: %" PRIu64 " us over the network, %" PRIu64 " us from the cache\n", networkTime, cacheTime);
+
+    StopServers();
+}
+
+void CheckResolveTimeout(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    if (!StartServers(inSuite, ctx, 0, 1))
+    {
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, PublishNode(sServers[0], "node-1") == CHIP_NO_ERROR);
+
+    memset(&sResolveResult, 0, sizeof(sResolveResult));
+    NL_TEST_ASSERT(inSuite, sServers[1].Resolve("node-2", "_chip", kProtocol, HandleResolve, &sResolveResult) == CHIP_NO_ERROR);
+    ctx.DriveIOUntil(MdnsServer::kResolveTimeout + 1000, []() { return sResolveResult.mDone; });
+
+    NL_TEST_ASSERT(inSuite, sResolveResult.mDone && sResolveResult.mError == CHIP_ERROR_TIMEOUT);
+
+    StopServers();
+}
+
+void HandleResolveAndShutdown(void * context, MdnsService * result, CHIP_ERROR error)
+{
+    HandleResolve(context, result, error);
+    sServers[1].Shutdown();
+}
+
+void CheckShutdownFromCallback(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    if (!StartServers(inSuite, ctx, 1, 1))
+    {
+        return;
+    }
+
+    // The server must not rearm its timer once the callback has shut it down.
+    memset(&sResolveResult, 0, sizeof(sResolveResult));
+    NL_TEST_ASSERT(inSuite,
+                   sServers[1].Resolve("node-2", "_chip", kProtocol, HandleResolveAndShutdown, &sResolveResult) == CHIP_NO_ERROR);
+    ctx.DriveIOUntil(MdnsServer::kResolveTimeout + 1000, []() { return sResolveResult.mDone; });
+    Wait(ctx, 100);
+
+    NL_TEST_ASSERT(inSuite, sResolveResult.mDone && sResolveResult.mError == CHIP_ERROR_TIMEOUT);
+
+    StopServers();
+}
+
+void CheckOverlongNames(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    char name[kMdnsNameMaxSize + 2];
+    char type[kMdnsTypeMaxSize + 2];
+
+    if (!StartServers(inSuite, ctx, 0, 1))
+    {
+        return;
+    }
+
+    memset(name, 'n', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    memset(type, 't', sizeof(type) - 1);
+    type[0]                = '_';
+    type[sizeof(type) - 1] = '\0';
+
+    // One character over the limit is refused before any query goes out.
+    memset(&sResolveResult, 0, sizeof(sResolveResult));
+    NL_TEST_ASSERT(inSuite,
+                   sServers[1].Resolve(name, "_chip", kProtocol, HandleResolve, &sResolveResult) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite,
+                   sServers[1].Resolve("node-1", type, kProtocol, HandleResolve, &sResolveResult) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, sServers[1].Browse(type, kProtocol, HandleBrowse, &sBrowseResult) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, !sResolveResult.mDone);
+
+    // Names right at the limit are accepted.
+    name[kMdnsNameMaxSize] = '\0';
+    type[kMdnsTypeMaxSize] = '\0';
+    NL_TEST_ASSERT(inSuite, sServers[1].Resolve(name, type, kProtocol, HandleResolve, &sResolveResult) == CHIP_NO_ERROR);
+    ctx.DriveIOUntil(MdnsServer::kResolveTimeout + 1000, []() { return sResolveResult.mDone; });
+    NL_TEST_ASSERT(inSuite, sResolveResult.mDone && sResolveResult.mError == CHIP_ERROR_TIMEOUT);
+
+    StopServers();
+}
+
+/////////////////////////// Browse test
+
+void CheckBrowse(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    if (!StartServers(inSuite, ctx, 0, 1))
+    {
+        return;
+    }
+
+    // Both servers answer the query, the browsing one included.
+    NL_TEST_ASSERT(inSuite, PublishNode(sServers[0], "node-1") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PublishNode(sServers[1], "node-2") == CHIP_NO_ERROR);
+
+    memset(&sBrowseResult, 0, sizeof(sBrowseResult));
+    NL_TEST_ASSERT(inSuite, sServers[1].Browse("_chip", kProtocol, HandleBrowse, &sBrowseResult) == CHIP_NO_ERROR);
+    ctx.DriveIOUntil(MdnsServer::kBrowseDuration + 1000, []() { return sBrowseResult.mDone; });
+
+    NL_TEST_ASSERT(inSuite, sBrowseResult.mDone && sBrowseResult.mCount == 2);
+    NL_TEST_ASSERT(inSuite, HasBrowseResult("node-1") && HasBrowseResult("node-2"));
+
+    // Goodbyes withdraw the instance from the caches of the other servers a second later.
+    NL_TEST_ASSERT(inSuite, sServers[0].StopPublish() == CHIP_NO_ERROR);
+    Wait(ctx, 1100);
+
+    memset(&sBrowseResult, 0, sizeof(sBrowseResult));
+    NL_TEST_ASSERT(inSuite, sServers[1].Browse("_chip", kProtocol, HandleBrowse, &sBrowseResult) == CHIP_NO_ERROR);
+    ctx.DriveIOUntil(MdnsServer::kBrowseDuration + 1000, []() { return sBrowseResult.mDone; });
+
+    NL_TEST_ASSERT(inSuite, sBrowseResult.mDone && sBrowseResult.mCount == 1);
+    NL_TEST_ASSERT(inSuite, HasBrowseResult("node-2"));
+
+    StopServers();
+}
+
+/////////////////////////// Known-answer suppression test
+
+namespace {
+
+size_t sPtrAnswers;
+
+void HandleSnoopedMessage(IPEndPointBasis * endPoint, System::PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    DnsReader reader(msg->Start(), msg->DataLength());
+    DnsHeader header;
+    DnsRecord record;
+
+    if (reader.ReadHeader(header) == CHIP_NO_ERROR && header.IsResponse() && header.mQuestionCount == 0)
+    {
+        for (uint16_t i = 0; i < header.mAnswerCount && reader.ReadRecord(record) == CHIP_NO_ERROR; i++)
+        {
+            if (record.mType == DnsRecordType::kPtr && record.mName == GetTypeName())
+            {
+                sPtrAnswers++;
+            }
+        }
+    }
+
+    System::PacketBuffer::Free(msg);
+}
+
+/**
+ * Sends a PTR query for the test service type from the mDNS port, with a known answer for node-1 if @p knownTtl is
+ * not 0, and returns how many PTR answers came back.
+ */
+size_t Query(TestContext & ctx, UDPEndPoint * endPoint, InterfaceId interface, uint32_t knownTtl)
+{
+    uint8_t message[512];
+    DnsWriter writer(message, sizeof(message));
+    DnsRecord known;
+    DnsName instance;
+    IPAddress group;
+    System::PacketBuffer * buffer = System::PacketBuffer::New();
+    size_t length;
+
+    instance.AppendLabel("node-1", 6);
+    instance.Append(GetTypeName());
+    known.mName       = GetTypeName();
+    known.mCacheFlush = false;
+    known.SetPtr(instance);
+
+    writer.AddQuestion(GetTypeName(), DnsRecordType::kPtr, false);
+    if (knownTtl != 0)
+    {
+        writer.AddAnswer(known, knownTtl);
+    }
+    length = writer.Finish(0, 0);
+
+    memcpy(buffer->Start(), message, length);
+    buffer->SetDataLength(static_cast<uint16_t>(length));
+    IPAddress::FromString("224.0.0.251", group);
+
+    sPtrAnswers = 0;
+    endPoint->SendTo(group, kTestPort, interface, buffer);
+    Wait(ctx, 300);
+
+    return sPtrAnswers;
+}
+
+} // namespace
+
+void CheckKnownAnswerSuppression(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx    = *reinterpret_cast<TestContext *>(inContext);
+    UDPEndPoint * snoop  = nullptr;
+    InterfaceId loopback = GetLoopbackInterface();
+    IPAddress group;
+
+    if (!StartServers(inSuite, ctx, 0, 0))
+    {
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, PublishNode(sServers[0], "node-1") == CHIP_NO_ERROR);
+    Wait(ctx, 100);
+
+    IPAddress::FromString("224.0.0.251", group);
+    NL_TEST_ASSERT(inSuite, ctx.GetInetLayer().NewUDPEndPoint(&snoop) == INET_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, snoop->Bind(kIPAddressType_IPv4, IPAddress::Any, kTestPort, loopback) == INET_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, snoop->Listen() == INET_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, snoop->JoinMulticastGroup(loopback, group) == INET_NO_ERROR);
+    snoop->OnMessageReceived = HandleSnoopedMessage;
+
+    NL_TEST_ASSERT(inSuite, Query(ctx, snoop, loopback, 0) == 1);
+
+    // A known answer with at least half of the TTL left suppresses the answer, one with less does not.
+    NL_TEST_ASSERT(inSuite, Query(ctx, snoop, loopback, MdnsServer::kServiceTtl) == 0);
+    NL_TEST_ASSERT(inSuite, Query(ctx, snoop, loopback, MdnsServer::kServiceTtl / 2 - 1) == 1);
+
+    snoop->Free();
+    StopServers();
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+#if INET_CONFIG_ENABLE_IPV4
+    NL_TEST_DEF("Resolve",                  CheckResolve),
+    NL_TEST_DEF("Resolve Timeout",          CheckResolveTimeout),
+    NL_TEST_DEF("Shutdown From Callback",   CheckShutdownFromCallback),
+    NL_TEST_DEF("Overlong Names",           CheckOverlongNames),
+    NL_TEST_DEF("Browse",                   CheckBrowse),
+    NL_TEST_DEF("Known-Answer Suppression", CheckKnownAnswerSuppression),
+#endif
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+static nlTestSuite sSuite =
+{
+    "Test-CHIP-MdnsServer",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+/**
+ *  Initialize the test suite.
+ */
+static int Initialize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Init(&sSuite);
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Finalize the test suite.
+ */
+static int Finalize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Main
+ */
+int TestMdnsServer()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
@@ -0,0 +1,439 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the operational node address
+ *      cache, against a resolver that answers either at once or when the
+ *      test delivers its pending answers, like a network would.
+ *
+ *      The resolve-on-send test looks nodes up the way SecureSessionMgr
+ *      does before each message and reports the hit rate and the lookup
+ *      latency.  Only correctness is asserted; the rates are informative.
+ */
+
+#include "TestMdns.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/CHIPCore.h>
+#include <lib/mdns/NodeAddressCache.h>
+#include <support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Inet;
+using namespace chip::Protocols::Mdns;
+
+static int Initialize(void * aContext);
+static int Finalize(void * aContext);
+
+namespace {
+
+using TestContext = chip::Test::IOContext;
+TestContext sContext;
+
+constexpr uint64_t kFabricId    = 0x5AB1E;
+constexpr uint16_t kServicePort = 11097;
+constexpr size_t kCacheSize     = CHIP_CONFIG_MDNS_NODE_ADDRESS_CACHE_SIZE;
+constexpr size_t kNumNodes      = kCacheSize + 1;
+constexpr size_t kMaxPending    = kNumNodes;
+
+struct Node
+{
+    IPAddress mAddress;
+    bool mReachable;
+};
+
+struct PendingResolve
+{
+    char mName[kMdnsNameMaxSize + 1];
+    MdnsResolveCallback mCallback;
+    void * mContext;
+};
+
+// Node IDs are 1 to kNumNodes.
+Node sNodes[kNumNodes];
+bool sDeferAnswers;
+PendingResolve sPending[kMaxPending];
+size_t sNumPending;
+size_t sNumResolves;
+
+NodeAddressCache sCache;
+
+IPAddress MakeAddress(uint8_t host, uint8_t generation)
+{
+    IPAddress address;
+    char text[32];
+
+    snprintf(text, sizeof(text), "fd00::%u:%u", generation, host);
+    IPAddress::FromString(text, address);
+    return address;
+}
+
+void ResetNodes()
+{
+    for (size_t i = 0; i < kNumNodes; i++)
+    {
+        sNodes[i].mAddress   = MakeAddress(static_cast<uint8_t>(i + 1), 0);
+        sNodes[i].mReachable = true;
+    }
+    sDeferAnswers = false;
+    sNumPending   = 0;
+    sNumResolves  = 0;
+}
+
+void Answer(const char * name, MdnsResolveCallback callback, void * context)
+{
+    // Instance names are "<node>-<fabric>" in hexadecimal
+    const unsigned long long nodeId = strtoull(name, nullptr, 16);
+    MdnsService result = {};
+
+    if (nodeId == 0 || nodeId > kNumNodes || !sNodes[nodeId - 1].mReachable)
+    {
+        callback(context, nullptr, CHIP_ERROR_TIMEOUT);
+        return;
+    }
+
+    strncpy(result.mName, name, sizeof(result.mName) - 1);
+    strncpy(result.mType, "_chip", sizeof(result.mType) - 1);
+    result.mProtocol = MdnsServiceProtocol::kMdnsProtocolTcp;
+    result.mPort     = kServicePort;
+    result.interface = INET_NULL_INTERFACEID;
+    result.mAddress.SetValue(sNodes[nodeId - 1].mAddress);
+    callback(context, &result, CHIP_NO_ERROR);
+}
+
+CHIP_ERROR FakeResolve(MdnsService * service, InterfaceId interface, MdnsResolveCallback callback, void * context)
+{
+    sNumResolves++;
+
+    if (!sDeferAnswers)
+    {
+        Answer(service->mName, callback, context);
+        return CHIP_NO_ERROR;
+    }
+
+    if (sNumPending == kMaxPending)
+    {
+        return CHIP_ERROR_NO_MEMORY;
+    }
+    strncpy(sPending[sNumPending].mName, service->mName, sizeof(sPending[sNumPending].mName));
+    sPending[sNumPending].mCallback = callback;
+    sPending[sNumPending].mContext  = context;
+    sNumPending++;
+    return CHIP_NO_ERROR;
+}
+
+void DeliverPending()
+{
+    PendingResolve pending[kMaxPending];
+    const size_t count = sNumPending;
+
+    // Answering may start new resolves
+    memcpy(pending, sPending, sizeof(pending));
+    sNumPending = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        Answer(pending[i].mName, pending[i].mCallback, pending[i].mContext);
+    }
+}
+
+void Wait(TestContext & ctx, unsigned ms)
+{
+    ctx.DriveIOUntil(ms, []() { return false; });
+}
+
+bool HasAddress(const Transport::PeerAddress & address, NodeId nodeId)
+{
+    return address.GetIPAddress() == sNodes[nodeId - 1].mAddress && address.GetPort() == kServicePort;
+}
+
+void StartCache(nlTestSuite * inSuite, TestContext & ctx, uint32_t ttl = NodeAddressCache::kDefaultTtl,
+                uint32_t negativeTtl = NodeAddressCache::kDefaultNegativeTtl)
+{
+    ResetNodes();
+    NL_TEST_ASSERT(inSuite, sCache.Init(ctx.GetSystemLayer(), kFabricId, FakeResolve, ttl, negativeTtl) == CHIP_NO_ERROR);
+}
+
+} // namespace
+
+/////////////////////////// Lookup tests
+
+void CheckMissThenHit(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    Transport::PeerAddress address;
+
+    StartCache(inSuite, ctx);
+    sDeferAnswers = true;
+
+    // Lookups while the resolve is pending do not start another one.
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_ERROR_NOT_CONNECTED);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_ERROR_NOT_CONNECTED);
+    NL_TEST_ASSERT(inSuite, sNumResolves == 1 && sNumPending == 1);
+
+    DeliverPending();
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasAddress(address, 1));
+    NL_TEST_ASSERT(inSuite, sNumResolves == 1);
+
+    // A resolver answering at once gives the address on the first lookup.
+    sDeferAnswers = false;
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasAddress(address, 2));
+    NL_TEST_ASSERT(inSuite, sNumResolves == 2);
+
+    // An invalidated address is resolved again.
+    sCache.Invalidate(2);
+    sNodes[1].mAddress = MakeAddress(2, 1);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasAddress(address, 2));
+    NL_TEST_ASSERT(inSuite, sNumResolves == 3);
+
+    sCache.Shutdown();
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+void CheckNegativeCaching(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    Transport::PeerAddress address;
+
+    StartCache(inSuite, ctx, NodeAddressCache::kDefaultTtl, 100);
+    sNodes[0].mReachable = false;
+
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_ERROR_TIMEOUT);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_ERROR_TIMEOUT);
+    NL_TEST_ASSERT(inSuite, sNumResolves == 1);
+
+    // Once the failure expires, the node is resolved again.
+    sNodes[0].mReachable = true;
+    Wait(ctx, 150);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasAddress(address, 1));
+    NL_TEST_ASSERT(inSuite, sNumResolves == 2);
+
+    sCache.Shutdown();
+}
+
+void CheckRefresh(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    Transport::PeerAddress address;
+
+    StartCache(inSuite, ctx, 200);
+
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sNumResolves == 2);
+
+    // Both nodes move; node 1 keeps being looked up and is refreshed before its address expires.
+    sNodes[0].mAddress = MakeAddress(1, 1);
+    sNodes[1].mAddress = MakeAddress(2, 1);
+    Wait(ctx, 100);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_NO_ERROR);
+    Wait(ctx, 100);
+    NL_TEST_ASSERT(inSuite, sNumResolves == 4);
+
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasAddress(address, 1));
+
+    // Node 1 is refreshed once more, as it was looked up after its first refresh; node 2 was not and expires.
+    Wait(ctx, 300);
+    NL_TEST_ASSERT(inSuite, sNumResolves == 5);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasAddress(address, 2));
+    NL_TEST_ASSERT(inSuite, sNumResolves == 6);
+
+    // A refresh still pending when the address expires is waited for, without starting another resolve.
+    sDeferAnswers = true;
+    Wait(ctx, 250);
+    NL_TEST_ASSERT(inSuite, sNumPending == 1);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_ERROR_NOT_CONNECTED);
+    NL_TEST_ASSERT(inSuite, sNumResolves == 7);
+    DeliverPending();
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_NO_ERROR);
+
+    sCache.Shutdown();
+}
+
+void CheckEviction(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    Transport::PeerAddress address;
+
+    StartCache(inSuite, ctx);
+
+    for (NodeId node = 1; node <= kCacheSize; node++)
+    {
+        NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(node, address) == CHIP_NO_ERROR);
+    }
+
+    // Node 1 is the least recently used once the others are looked up again.
+    Wait(ctx, 5);
+    for (NodeId node = 2; node <= kCacheSize; node++)
+    {
+        NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(node, address) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sNumResolves == kCacheSize);
+
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(kNumNodes, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(2, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sNumResolves == kCacheSize + 1);
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(1, address) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sNumResolves == kCacheSize + 2);
+    sCache.Shutdown();
+
+    // Entries waiting for an answer are not evicted.
+    StartCache(inSuite, ctx);
+    sDeferAnswers = true;
+    for (NodeId node = 1; node <= kCacheSize; node++)
+    {
+        NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(node, address) == CHIP_ERROR_NOT_CONNECTED);
+    }
+    NL_TEST_ASSERT(inSuite, sCache.LookupPeerAddress(kNumNodes, address) == CHIP_ERROR_NO_MEMORY);
+    sCache.Shutdown();
+}
+
+/////////////////////////// Resolve-on-send test
+
+void CheckResolveOnSend(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kNumPeers      = 6;
+    constexpr size_t kRoundsPerPoll = 100;
+    constexpr uint32_t kTtl         = 100;
+    constexpr uint32_t kRunTime     = 1000;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    Transport::PeerAddress address;
+    size_t hits         = 0;
+    size_t misses       = 0;
+    size_t wrongAddress = 0;
+    uint64_t hitTime    = 0;
+    uint64_t missTime   = 0;
+    uint64_t end;
+
+    // Answers arrive between rounds of sends, and the addresses live for a fraction of the run, so that only
+    // the proactive refresh avoids a miss per peer and TTL.
+    StartCache(inSuite, ctx, kTtl);
+    sDeferAnswers = true;
+    end           = System::Platform::Layer::GetClock_MonotonicMS() + kRunTime;
+
+    while (System::Platform::Layer::GetClock_MonotonicMS() < end)
+    {
+        for (size_t round = 0; round < kRoundsPerPoll; round++)
+        {
+            for (NodeId node = 1; node <= kNumPeers; node++)
+            {
+                const uint64_t start = System::Platform::Layer::GetClock_MonotonicHiRes();
+                const CHIP_ERROR err = sCache.LookupPeerAddress(node, address);
+                const uint64_t time  = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+                if (err == CHIP_NO_ERROR)
+                {
+                    hits++;
+                    hitTime += time;
+                    wrongAddress += HasAddress(address, node) ? 0 : 1;
+                }
+                else
+                {
+                    misses++;
+                    missTime += time;
+                }
+            }
+
+            DeliverPending();
+        }
+
+        // Runs the refresh timer
+        ctx.DriveIO();
+    }
+
+    NL_TEST_ASSERT(inSuite, misses == kNumPeers);
+    NL_TEST_ASSERT(inSuite, wrongAddress == 0);
+    NL_TEST_ASSERT(inSuite, sNumResolves > kNumPeers * (kRunTime / kTtl) / 2);
+
+    printf("Resolve on send: %zu lookups, %zu resolves, hit rate %.2f%%, hit %" PRIu64 " ns, miss %" PRIu64 " ns\n",
+           hits + misses, sNumResolves, 100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses),
+           (hits > 0) ? hitTime * 1000 / hits : 0, (misses > 0) ? missTime * 1000 / misses : 0);
+
+    sCache.Shutdown();
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Miss Then Hit",     CheckMissThenHit),
+    NL_TEST_DEF("Negative Caching",  CheckNegativeCaching),
+    NL_TEST_DEF("Refresh",           CheckRefresh),
+    NL_TEST_DEF("Eviction",          CheckEviction),
+    NL_TEST_DEF("Resolve On Send",   CheckResolveOnSend),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+static nlTestSuite sSuite =
+{
+    "Test-CHIP-NodeAddressCache",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+/**
+ *  Initialize the test suite.
+ */
+static int Initialize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Init(&sSuite);
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Finalize the test suite.
+ */
+static int Finalize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Main
+ */
+int TestNodeAddressCache()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
@@ -52,6 +52,11 @@ namespace chip {
  *   - Output: 200, 201, 202, ...., 299, 300, 301, 302 <reboot/reinit>
  *   - Output: 400, 401 ...
  *
+ * Counters initialized together, e.g. at bootup, can share a single write to
+ * persistent storage by being initialized within a write batch
+ * (chip::Platform::PersistedStorage::BeginWriteBatch()).  Their values must
+ * not be used until the batch is committed.
+ *
  */
 class PersistedCounter : public MonotonicallyIncreasingCounter
 {
@@ -20,9 +20,10 @@
  *    @file
  *      This file implements utility functions for deriving random integers.
  *
- *  @note These utility functions do not generate cryptographically strong
- *        random number. To get cryptographically strong random data use
- *        chip::Platform::Security::GetSecureRandomData().
+ *  @note These utility functions draw from the DRBG of the crypto library
+ *        when CHIP_CONFIG_RAND_UTILS_DRBG is set, and otherwise use rand(). They are
+ *        therefore not guaranteed to be cryptographically strong; to get
+ *        cryptographically strong random data use chip::Crypto::DRBG_get_bytes().
  *
  */
 
@@ -60,8 +61,23 @@ namespace chip {
 #error "RAND_MAX value is too small. RandUtils functions assume that RAND_MAX is greater or equal to UINT8_MAX."
 #endif
 
+#if !CHIP_CONFIG_RAND_UTILS_DRBG
+// Without the crypto library's DRBG, every function below uses rand().
+static bool GetRandBytesFromDRBG(uint8_t *, size_t)
+{
+    return false;
+}
+#endif // !CHIP_CONFIG_RAND_UTILS_DRBG
+
 uint64_t GetRandU64()
 {
+    uint64_t value;
+
+    if (GetRandBytesFromDRBG(reinterpret_cast<uint8_t *>(&value), sizeof(value)))
+    {
+        return value;
+    }
+
     // rand() returns int, which is always smaller than the size of uint64_t
     // and rand() cannot be used directly to generate random uint64_t number.
     return static_cast<uint64_t>(GetRandU32()) ^ (static_cast<uint64_t>(GetRandU32()) << (sizeof(uint32_t) * CHAR_BIT));
@@ -69,6 +85,13 @@ uint64_t GetRandU64()
 
 uint32_t GetRandU32()
 {
+    uint32_t value;
+
+    if (GetRandBytesFromDRBG(reinterpret_cast<uint8_t *>(&value), sizeof(value)))
+    {
+        return value;
+    }
+
     // Check if (RAND_MAX == UINT32_MAX) but it is unlikely because rand() returns signed int,
     // which maximum possible value is 0x7FFFFFFF (smaller that UINT32_MAX = 0xFFFFFFFF).
 #if RAND_MAX == UINT32_MAX
@@ -80,6 +103,13 @@ uint32_t GetRandU32()
 
 uint16_t GetRandU16()
 {
+    uint16_t value;
+
+    if (GetRandBytesFromDRBG(reinterpret_cast<uint8_t *>(&value), sizeof(value)))
+    {
+        return value;
+    }
+
 #if RAND_MAX >= UINT16_MAX
 #if (RAND_MAX == INT_MAX) || (RAND_MAX == NORMALIZED_RAND_RANGE(UINT16_MAX))
     // rand() random output range normalization is not needed.
@@ -100,6 +130,13 @@ uint16_t GetRandU16()
 
 uint8_t GetRandU8()
 {
+    uint8_t value;
+
+    if (GetRandBytesFromDRBG(reinterpret_cast<uint8_t *>(&value), sizeof(value)))
+    {
+        return value;
+    }
+
 #if (RAND_MAX == INT_MAX) || (RAND_MAX == NORMALIZED_RAND_RANGE(UINT8_MAX))
     // rand() random output range normalization is not needed.
     return static_cast<uint8_t>(rand());
@@ -20,18 +20,34 @@
  *    @file
  *      This file defines utility functions for deriving random integers.
  *
- *  @note These utility functions do not generate cryptographically strong
- *        random number. To get cryptographically strong random data use
- *        chip::Platform::Security::GetSecureRandomData().
+ *  @note These utility functions draw from the DRBG of the crypto library
+ *        when CHIP_CONFIG_RAND_UTILS_DRBG is set, and otherwise use rand(). They are
+ *        therefore not guaranteed to be cryptographically strong; to get
+ *        cryptographically strong random data use chip::Crypto::DRBG_get_bytes().
  *
  */
 
 #pragma once
 
+#include <core/CHIPConfig.h>
+
+#include <stddef.h>
 #include <stdint.h>
 
 namespace chip {
 
+#if CHIP_CONFIG_RAND_UTILS_DRBG
+/**
+ * Fills @p buf with @p len bytes from the crypto library's DRBG.
+ *
+ * It is defined by the crypto library, backed by chip::Crypto::DRBG_get_pooled_bytes(), when
+ * CHIP_CONFIG_RAND_UTILS_DRBG is set.  If it fails, the functions below fall back to rand().
+ *
+ * @return true if @p buf was filled
+ */
+extern bool GetRandBytesFromDRBG(uint8_t * buf, size_t len);
+#endif // CHIP_CONFIG_RAND_UTILS_DRBG
+
 /**
  *  This function generates 64-bit unsigned random number.
  *
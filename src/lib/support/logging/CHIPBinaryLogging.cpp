@@ -0,0 +1,584 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements helpers for deferred formatting of log messages.
+ *
+ */
+
+#include "CHIPBinaryLogging.h"
+
+#include <core/CHIPEncoding.h>
+#include <support/BufBound.h>
+#include <support/CodeUtils.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace chip {
+namespace Logging {
+
+namespace {
+
+enum class LengthModifier : uint8_t
+{
+    kNone,
+    kChar,
+    kShort,
+    kLong,
+    kLongLong,
+    kIntMax,
+    kSize,
+    kPtrDiff,
+    kLongDouble,
+};
+
+struct ConversionSpec
+{
+    const char * mFlags;
+    size_t mFlagsLength;
+    bool mWidthFromArg;
+    const char * mWidth;
+    size_t mWidthLength;
+    bool mHasPrecision;
+    bool mPrecisionFromArg;
+    const char * mPrecision;
+    size_t mPrecisionLength;
+    LengthModifier mLength;
+    char mConversion;
+    const char * mEnd;
+};
+
+size_t SpanOf(const char * p, const char * accept)
+{
+    return strspn(p, accept);
+}
+
+// Parses the conversion specification following the '%' at p[-1].  Returns false for conversions
+// that cannot be captured.
+bool ParseConversion(const char * p, ConversionSpec & spec)
+{
+    spec.mFlags       = p;
+    spec.mFlagsLength = SpanOf(p, "-+ #0");
+    p += spec.mFlagsLength;
+
+    spec.mWidthFromArg = (*p == '*');
+    spec.mWidth        = p;
+    spec.mWidthLength  = spec.mWidthFromArg ? 1 : SpanOf(p, "0123456789");
+    p += spec.mWidthLength;
+
+    spec.mHasPrecision     = (*p == '.');
+    spec.mPrecisionFromArg = false;
+    spec.mPrecision        = p;
+    spec.mPrecisionLength  = 0;
+    if (spec.mHasPrecision)
+    {
+        p++;
+        spec.mPrecisionFromArg = (*p == '*');
+        spec.mPrecision        = p;
+        spec.mPrecisionLength  = spec.mPrecisionFromArg ? 1 : SpanOf(p, "0123456789");
+        p += spec.mPrecisionLength;
+    }
+
+    spec.mLength = LengthModifier::kNone;
+    switch (*p)
+    {
+    case 'h':
+        spec.mLength = (p[1] == 'h') ? LengthModifier::kChar : LengthModifier::kShort;
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        spec.mLength = (p[1] == 'l') ? LengthModifier::kLongLong : LengthModifier::kLong;
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'j':
+        spec.mLength = LengthModifier::kIntMax;
+        p++;
+        break;
+    case 'z':
+        spec.mLength = LengthModifier::kSize;
+        p++;
+        break;
+    case 't':
+        spec.mLength = LengthModifier::kPtrDiff;
+        p++;
+        break;
+    case 'L':
+        spec.mLength = LengthModifier::kLongDouble;
+        p++;
+        break;
+    default:
+        break;
+    }
+
+    spec.mConversion = *p;
+    spec.mEnd        = p + 1;
+
+    switch (spec.mConversion)
+    {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        return spec.mLength != LengthModifier::kLongDouble;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        return spec.mLength == LengthModifier::kNone || spec.mLength == LengthModifier::kLong ||
+            spec.mLength == LengthModifier::kLongDouble;
+    case 'c':
+    case 's':
+    case 'p':
+    case 'n':
+        // Wide characters and strings are not supported.
+        return spec.mLength == LengthModifier::kNone || spec.mConversion == 'n';
+    default:
+        return false;
+    }
+}
+
+int64_t ReadSignedArg(va_list & v, LengthModifier length)
+{
+    switch (length)
+    {
+    case LengthModifier::kChar:
+        return static_cast<signed char>(va_arg(v, int));
+    case LengthModifier::kShort:
+        return static_cast<short>(va_arg(v, int));
+    case LengthModifier::kLong:
+        return va_arg(v, long);
+    case LengthModifier::kLongLong:
+        return va_arg(v, long long);
+    case LengthModifier::kIntMax:
+        return va_arg(v, intmax_t);
+    case LengthModifier::kSize:
+        return static_cast<int64_t>(va_arg(v, size_t));
+    case LengthModifier::kPtrDiff:
+        return va_arg(v, ptrdiff_t);
+    default:
+        return va_arg(v, int);
+    }
+}
+
+uint64_t ReadUnsignedArg(va_list & v, LengthModifier length)
+{
+    switch (length)
+    {
+    case LengthModifier::kChar:
+        return static_cast<unsigned char>(va_arg(v, unsigned int));
+    case LengthModifier::kShort:
+        return static_cast<unsigned short>(va_arg(v, unsigned int));
+    case LengthModifier::kLong:
+        return va_arg(v, unsigned long);
+    case LengthModifier::kLongLong:
+        return va_arg(v, unsigned long long);
+    case LengthModifier::kIntMax:
+        return va_arg(v, uintmax_t);
+    case LengthModifier::kSize:
+        return va_arg(v, size_t);
+    case LengthModifier::kPtrDiff:
+        return static_cast<uint64_t>(va_arg(v, ptrdiff_t));
+    default:
+        return va_arg(v, unsigned int);
+    }
+}
+
+// Parses the digits of a width or precision, which ParseConversion() limited to [0-9]*.
+int ParseDigits(const char * p, size_t length)
+{
+    int value = 0;
+
+    for (size_t i = 0; i < length && value < 100000; i++)
+    {
+        value = value * 10 + (p[i] - '0');
+    }
+
+    return value;
+}
+
+class ArgReader
+{
+public:
+    ArgReader(const uint8_t * args, size_t length) : mCursor(args), mEnd(args + length) {}
+
+    bool Read(uint64_t & value)
+    {
+        if (mEnd - mCursor < 8)
+        {
+            return false;
+        }
+        value = Encoding::LittleEndian::Get64(mCursor);
+        mCursor += 8;
+        return true;
+    }
+
+    bool ReadString(const char *& str, uint16_t & length)
+    {
+        if (mEnd - mCursor < 2)
+        {
+            return false;
+        }
+        length = Encoding::LittleEndian::Get16(mCursor);
+        if (static_cast<size_t>(mEnd - mCursor - 2) < length)
+        {
+            return false;
+        }
+        str = reinterpret_cast<const char *>(mCursor + 2);
+        mCursor += 2 + length;
+        return true;
+    }
+
+private:
+    const uint8_t * mCursor;
+    const uint8_t * mEnd;
+};
+
+} // namespace
+
+bool CaptureLogArgs(const char * format, va_list args, uint8_t * buf, size_t bufSize, size_t & outLength)
+{
+    BufBound out(buf, bufSize);
+    ConversionSpec spec;
+    bool captured = true;
+    va_list v;
+
+    va_copy(v, args);
+
+    for (const char * p = strchr(format, '%'); p != nullptr; p = strchr(p, '%'))
+    {
+        int precision = -1;
+
+        if (p[1] == '%')
+        {
+            p += 2;
+            continue;
+        }
+
+        if (!ParseConversion(p + 1, spec))
+        {
+            captured = false;
+            break;
+        }
+
+        if (spec.mWidthFromArg)
+        {
+            out.PutLE64(static_cast<uint64_t>(static_cast<int64_t>(va_arg(v, int))));
+        }
+        if (spec.mPrecisionFromArg)
+        {
+            precision = va_arg(v, int);
+            out.PutLE64(static_cast<uint64_t>(static_cast<int64_t>(precision)));
+        }
+        else if (spec.mHasPrecision)
+        {
+            precision = ParseDigits(spec.mPrecision, spec.mPrecisionLength);
+        }
+
+        switch (spec.mConversion)
+        {
+        case 'd':
+        case 'i':
+            out.PutLE64(static_cast<uint64_t>(ReadSignedArg(v, spec.mLength)));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            out.PutLE64(ReadUnsignedArg(v, spec.mLength));
+            break;
+        case 'c':
+            out.PutLE64(static_cast<uint64_t>(static_cast<int64_t>(va_arg(v, int))));
+            break;
+        case 's': {
+            const char * str = va_arg(v, const char *);
+            size_t length    = 0;
+
+            if (str == nullptr)
+            {
+                str = "(null)";
+            }
+
+            // The precision bounds strings that are not NUL-terminated.
+            length = (precision >= 0) ? strnlen(str, static_cast<size_t>(precision)) : strlen(str);
+            if (length > UINT16_MAX)
+            {
+                captured = false;
+                break;
+            }
+
+            out.PutLE16(static_cast<uint16_t>(length));
+            out.Put(str, length);
+            break;
+        }
+        case 'p':
+            out.PutLE64(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(va_arg(v, void *))));
+            break;
+        case 'n':
+            (void) va_arg(v, void *);
+            break;
+        default: {
+            double value = (spec.mLength == LengthModifier::kLongDouble) ? static_cast<double>(va_arg(v, long double))
+                                                                         : va_arg(v, double);
+            uint64_t bits;
+
+            memcpy(&bits, &value, sizeof(bits));
+            out.PutLE64(bits);
+            break;
+        }
+        }
+
+        if (!captured || !out.Fit())
+        {
+            break;
+        }
+
+        p = spec.mEnd;
+    }
+
+    va_end(v);
+
+    captured  = captured && out.Fit();
+    outLength = captured ? out.Written() : 0;
+    return captured;
+}
+
+void FormatCapturedLogArgs(const char * format, const uint8_t * args, size_t argsLength, char * out, size_t outSize)
+{
+    ArgReader reader(args, argsLength);
+    ConversionSpec spec;
+    size_t pos = 0;
+
+    if (outSize == 0)
+    {
+        return;
+    }
+
+    for (const char * p = format; *p != '\0' && pos < outSize - 1;)
+    {
+        const char * percent = strchr(p, '%');
+        size_t literal       = (percent != nullptr) ? static_cast<size_t>(percent - p) : strlen(p);
+        char subformat[48];
+        char number[24];
+        BufBound sub(reinterpret_cast<uint8_t *>(subformat), sizeof(subformat));
+        uint64_t value = 0;
+        int written    = 0;
+
+        literal = (literal < outSize - 1 - pos) ? literal : outSize - 1 - pos;
+        memcpy(&out[pos], p, literal);
+        pos += literal;
+
+        VerifyOrExit(percent != nullptr && pos < outSize - 1, );
+
+        if (percent[1] == '%')
+        {
+            out[pos++] = '%';
+            p          = percent + 2;
+            continue;
+        }
+
+        VerifyOrExit(ParseConversion(percent + 1, spec), );
+
+        // Rebuild the conversion with the width and precision stored in the arguments, and with the
+        // length modifier of the stored value.
+        sub.Put('%');
+        sub.Put(spec.mFlags, spec.mFlagsLength);
+        if (spec.mWidthFromArg)
+        {
+            VerifyOrExit(reader.Read(value), );
+            snprintf(number, sizeof(number), "%" PRId64, static_cast<int64_t>(value));
+            sub.Put(number);
+        }
+        else
+        {
+            sub.Put(spec.mWidth, spec.mWidthLength);
+        }
+        if (spec.mPrecisionFromArg)
+        {
+            VerifyOrExit(reader.Read(value), );
+            // A negative precision is taken as if it were omitted.
+            if (static_cast<int64_t>(value) >= 0 && spec.mConversion != 's')
+            {
+                snprintf(number, sizeof(number), ".%" PRId64, static_cast<int64_t>(value));
+                sub.Put(number);
+            }
+        }
+        else if (spec.mHasPrecision && spec.mConversion != 's')
+        {
+            sub.Put('.');
+            sub.Put(spec.mPrecision, spec.mPrecisionLength);
+        }
+
+        switch (spec.mConversion)
+        {
+        case 'd':
+        case 'i':
+            sub.Put("ll");
+            sub.Put(static_cast<uint8_t>(spec.mConversion));
+            sub.Put(static_cast<uint8_t>('\0'));
+            VerifyOrExit(sub.Fit() && reader.Read(value), );
+            written = snprintf(&out[pos], outSize - pos, subformat, static_cast<long long>(value));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            sub.Put("ll");
+            sub.Put(static_cast<uint8_t>(spec.mConversion));
+            sub.Put(static_cast<uint8_t>('\0'));
+            VerifyOrExit(sub.Fit() && reader.Read(value), );
+            written = snprintf(&out[pos], outSize - pos, subformat, static_cast<unsigned long long>(value));
+            break;
+        case 'c':
+            sub.Put("c");
+            sub.Put(static_cast<uint8_t>('\0'));
+            VerifyOrExit(sub.Fit() && reader.Read(value), );
+            written = snprintf(&out[pos], outSize - pos, subformat, static_cast<int>(value));
+            break;
+        case 's': {
+            const char * str = nullptr;
+            uint16_t length  = 0;
+
+            // The stored string is already cut to the precision and is not NUL-terminated, so its
+            // length becomes the precision.
+            sub.Put(".*s");
+            sub.Put(static_cast<uint8_t>('\0'));
+            VerifyOrExit(sub.Fit() && reader.ReadString(str, length), );
+            written = snprintf(&out[pos], outSize - pos, subformat, static_cast<int>(length), str);
+            break;
+        }
+        case 'p':
+            sub.Put("p");
+            sub.Put(static_cast<uint8_t>('\0'));
+            VerifyOrExit(sub.Fit() && reader.Read(value), );
+            written = snprintf(&out[pos], outSize - pos, subformat, reinterpret_cast<void *>(static_cast<uintptr_t>(value)));
+            break;
+        case 'n':
+            break;
+        default: {
+            double d;
+
+            sub.Put(static_cast<uint8_t>(spec.mConversion));
+            sub.Put(static_cast<uint8_t>('\0'));
+            VerifyOrExit(sub.Fit() && reader.Read(value), );
+            memcpy(&d, &value, sizeof(d));
+            written = snprintf(&out[pos], outSize - pos, subformat, d);
+            break;
+        }
+        }
+
+        if (written > 0)
+        {
+            pos += (static_cast<size_t>(written) < outSize - 1 - pos) ? static_cast<size_t>(written) : outSize - 1 - pos;
+        }
+
+        p = spec.mEnd;
+    }
+
+exit:
+    out[pos] = '\0';
+}
+
+size_t EncodeBinaryLogRecord(const BinaryLogRecord & record, uint8_t * buf, size_t bufSize)
+{
+    BufBound out(buf, bufSize);
+
+    out.Put(static_cast<uint8_t>(record.mType));
+
+    switch (record.mType)
+    {
+    case BinaryLogRecordType::kFormat:
+        out.PutLE32(record.mFormatId);
+        out.PutLE16(record.mFormatLength);
+        out.Put(record.mFormat, record.mFormatLength);
+        break;
+    case BinaryLogRecordType::kMessage:
+        out.PutLE64(record.mTimestamp);
+        out.PutLE32(record.mThreadId);
+        out.PutLE32(record.mFormatId);
+        out.Put(record.mModule);
+        out.Put(record.mCategory);
+        out.PutLE16(record.mArgsLength);
+        out.Put(record.mArgs, record.mArgsLength);
+        break;
+    case BinaryLogRecordType::kDropped:
+        out.PutLE32(record.mThreadId);
+        out.PutLE32(record.mDroppedCount);
+        break;
+    }
+
+    return out.Fit() ? out.Written() : 0;
+}
+
+CHIP_ERROR DecodeBinaryLogRecord(const uint8_t * buf, size_t bufLength, BinaryLogRecord & outRecord, size_t & outLength)
+{
+    using namespace Encoding::LittleEndian;
+
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    const uint8_t * p = buf + 1;
+
+    VerifyOrExit(bufLength >= 1, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+
+    memset(&outRecord, 0, sizeof(outRecord));
+    outRecord.mType = static_cast<BinaryLogRecordType>(buf[0]);
+
+    switch (outRecord.mType)
+    {
+    case BinaryLogRecordType::kFormat:
+        VerifyOrExit(bufLength >= 7, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+        outRecord.mFormatId     = Read32(p);
+        outRecord.mFormatLength = Read16(p);
+        outRecord.mFormat       = reinterpret_cast<const char *>(p);
+        outLength               = 7u + outRecord.mFormatLength;
+        break;
+    case BinaryLogRecordType::kMessage:
+        VerifyOrExit(bufLength >= 21, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+        outRecord.mTimestamp  = Read64(p);
+        outRecord.mThreadId   = Read32(p);
+        outRecord.mFormatId   = Read32(p);
+        outRecord.mModule     = *p++;
+        outRecord.mCategory   = *p++;
+        outRecord.mArgsLength = Read16(p);
+        outRecord.mArgs       = p;
+        outLength             = 21u + outRecord.mArgsLength;
+        break;
+    case BinaryLogRecordType::kDropped:
+        VerifyOrExit(bufLength >= 9, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+        outRecord.mThreadId     = Read32(p);
+        outRecord.mDroppedCount = Read32(p);
+        outLength               = 9;
+        break;
+    default:
+        ExitNow(err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+    }
+
+    VerifyOrExit(bufLength >= outLength, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+
+exit:
+    return err;
+}
+
+} // namespace Logging
+} // namespace chip
@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines helpers for deferred formatting of log messages.
+ *
+ *      A message is captured as its printf-style format string plus the
+ *      raw values of its arguments, and is only rendered to text later,
+ *      on another thread or offline from a binary log file.
+ *
+ *      A binary log file starts with the 4-byte kBinaryLogMagic followed
+ *      by a sequence of records.  Every record starts with a one-byte
+ *      BinaryLogRecordType and all integers are little-endian:
+ *
+ *        Format:  type, format id (4), length (2), format string (length bytes, no NUL)
+ *        Message: type, timestamp in microseconds (8), thread id (4), format id (4),
+ *                 module (1), category (1), args length (2), args
+ *        Dropped: type, thread id (4), number of messages dropped (4)
+ *
+ *      The Format record for an id precedes the first Message record that
+ *      refers to it, and the args are those stored by CaptureLogArgs().
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Logging {
+
+/**
+ * Stores the arguments that @p format consumes from @p args in @p buf, so that FormatCapturedLogArgs() can render
+ * the message without the original arguments.  Strings are copied; every other argument takes 8 bytes.
+ *
+ * @param[in]  format     The printf-style format string of the message
+ * @param[in]  args       The arguments of the message
+ * @param[out] buf        Buffer to store the arguments in
+ * @param[in]  bufSize    Size of buf
+ * @param[out] outLength  Number of bytes of buf used
+ *
+ * @return true if every argument fit in @p buf and @p format only used conversions that can be captured
+ */
+bool CaptureLogArgs(const char * format, va_list args, uint8_t * buf, size_t bufSize, size_t & outLength);
+
+/**
+ * Renders @p format with arguments stored by CaptureLogArgs().  The output is always NUL-terminated and is cut off
+ * at @p outSize, or at the first argument missing from @p args.
+ */
+void FormatCapturedLogArgs(const char * format, const uint8_t * args, size_t argsLength, char * out, size_t outSize);
+
+constexpr uint32_t kBinaryLogMagic = 0x474c4843; // "CHLG"
+
+enum class BinaryLogRecordType : uint8_t
+{
+    kFormat  = 1,
+    kMessage = 2,
+    kDropped = 3,
+};
+
+struct BinaryLogRecord
+{
+    BinaryLogRecordType mType;
+
+    // Format and Message records
+    uint32_t mFormatId;
+
+    // Format records
+    const char * mFormat;
+    uint16_t mFormatLength;
+
+    // Message and Dropped records
+    uint32_t mThreadId;
+
+    // Message records
+    uint64_t mTimestamp;
+    uint8_t mModule;
+    uint8_t mCategory;
+    const uint8_t * mArgs;
+    uint16_t mArgsLength;
+
+    // Dropped records
+    uint32_t mDroppedCount;
+};
+
+/**
+ * Encodes @p record into @p buf.
+ *
+ * @return The length of the encoded record, or 0 if it does not fit in @p bufSize bytes
+ */
+size_t EncodeBinaryLogRecord(const BinaryLogRecord & record, uint8_t * buf, size_t bufSize);
+
+/**
+ * Decodes the record at the start of @p buf.  The pointers of @p outRecord point into @p buf.
+ *
+ * @retval CHIP_NO_ERROR                    On success; outLength is the length of the record
+ * @retval CHIP_ERROR_MESSAGE_INCOMPLETE    If @p buf ends before the record does
+ * @retval CHIP_ERROR_INVALID_MESSAGE_TYPE  If the record type is unknown
+ */
+CHIP_ERROR DecodeBinaryLogRecord(const uint8_t * buf, size_t bufLength, BinaryLogRecord & outRecord, size_t & outLength);
+
+} // namespace Logging
+} // namespace chip
@@ -176,6 +176,11 @@ DLL_EXPORT void Log(uint8_t module, uint8_t category, const char * msg, ...)
 {
     va_list v;
 
+    if (!IsModuleCategoryEnabled(module, category))
+    {
+        return;
+    }
+
     va_start(v, msg);
 
     LogV(module, category, msg, v);
@@ -185,6 +190,32 @@ DLL_EXPORT void Log(uint8_t module, uint8_t category, const char * msg, ...)
 
 #if CHIP_LOG_FILTERING
 uint8_t gLogFilter = kLogCategory_Max;
+
+namespace {
+
+constexpr ModuleLogFilters AllCategories()
+{
+    ModuleLogFilters filters = {};
+
+    for (uint8_t module = 0; module < kLogModule_Max; module++)
+    {
+        filters.mCategory[module] = kLogCategory_Max;
+    }
+
+    return filters;
+}
+
+ModuleLogFilters sModuleLogFilters = AllCategories();
+
+void UpdateEffectiveLogFilter(uint8_t module)
+{
+    gEffectiveLogFilters.mCategory[module] = min(gLogFilter, sModuleLogFilters.mCategory[module]);
+}
+
+} // namespace
+
+ModuleLogFilters gEffectiveLogFilters = AllCategories();
+
 DLL_EXPORT bool IsCategoryEnabled(uint8_t category)
 {
     return (category <= gLogFilter);
@@ -198,6 +229,30 @@ DLL_EXPORT uint8_t GetLogFilter()
 DLL_EXPORT void SetLogFilter(uint8_t category)
 {
     gLogFilter = category;
+
+    for (uint8_t module = 0; module < kLogModule_Max; module++)
+    {
+        UpdateEffectiveLogFilter(module);
+    }
+}
+
+DLL_EXPORT uint8_t GetModuleLogFilter(uint8_t module)
+{
+    if (module >= kLogModule_Max)
+    {
+        return kLogCategory_Max;
+    }
+
+    return sModuleLogFilters.mCategory[module];
+}
+
+DLL_EXPORT void SetModuleLogFilter(uint8_t module, uint8_t category)
+{
+    if (module < kLogModule_Max)
+    {
+        sModuleLogFilters.mCategory[module] = category;
+        UpdateEffectiveLogFilter(module);
+    }
 }
 
 #else  // CHIP_LOG_FILTERING
@@ -217,6 +272,18 @@ DLL_EXPORT void SetLogFilter(uint8_t category)
 {
     (void) category;
 }
+
+DLL_EXPORT uint8_t GetModuleLogFilter(uint8_t module)
+{
+    (void) module;
+    return kLogCategory_Max;
+}
+
+DLL_EXPORT void SetModuleLogFilter(uint8_t module, uint8_t category)
+{
+    (void) module;
+    (void) category;
+}
 #endif // CHIP_LOG_FILTERING
 
 #endif /* _CHIP_USE_LOGGING */
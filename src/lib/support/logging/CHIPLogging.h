@@ -71,7 +71,8 @@ namespace Logging {
  *    messages.
  *
  *  @note If you add modules or rearrange this list you must update the
- *        ModuleNames tables in ChipLogging.cpp.
+ *        ModuleNames tables in ChipLogging.cpp, and add a
+ *        CHIP_LOG_LEVEL_<module> default below.
  *
  */
 enum LogModule
@@ -193,15 +194,183 @@ extern void LogV(uint8_t module, uint8_t category, const char * msg, va_list arg
 extern void Log(uint8_t module, uint8_t category, const char * msg, ...);
 extern uint8_t GetLogFilter();
 extern void SetLogFilter(uint8_t category);
-
-#ifndef CHIP_ERROR_LOGGING
-#define CHIP_ERROR_LOGGING 1
-#endif
+extern uint8_t GetModuleLogFilter(uint8_t module);
+extern void SetModuleLogFilter(uint8_t module, uint8_t category);
+extern bool IsCategoryEnabled(uint8_t CAT);
 
 #ifndef CHIP_LOG_FILTERING
 #define CHIP_LOG_FILTERING 1
 #endif
 
+#if CHIP_LOG_FILTERING
+
+/*
+ * The most verbose category logged for each module, combining SetLogFilter() and SetModuleLogFilter(), so that
+ * IsModuleCategoryEnabled() can be inlined at every call site.
+ */
+struct ModuleLogFilters
+{
+    uint8_t mCategory[kLogModule_Max];
+};
+
+extern ModuleLogFilters gEffectiveLogFilters;
+
+inline bool IsModuleCategoryEnabled(uint8_t module, uint8_t category)
+{
+    return (module < kLogModule_Max) ? (category <= gEffectiveLogFilters.mCategory[module]) : IsCategoryEnabled(category);
+}
+
+#else // CHIP_LOG_FILTERING
+
+inline bool IsModuleCategoryEnabled(uint8_t module, uint8_t category)
+{
+    (void) module;
+    (void) category;
+    return true;
+}
+
+#endif // CHIP_LOG_FILTERING
+
+/**
+ * @def CHIP_LOG_LEVEL_DEFAULT
+ *
+ * @brief
+ *   The most verbose LogCategory compiled in for modules without a
+ *   CHIP_LOG_LEVEL_<module> of their own.
+ *
+ *   Messages for a module in a category above CHIP_LOG_LEVEL_<module>,
+ *   e.g. CHIP_LOG_LEVEL_Inet, are compiled out of the ChipLog* macros,
+ *   arguments included.  Within the compiled-in categories,
+ *   SetLogFilter() and SetModuleLogFilter() choose at runtime which
+ *   messages are logged; the arguments of messages filtered out are not
+ *   evaluated.
+ *
+ */
+#ifndef CHIP_LOG_LEVEL_DEFAULT
+#define CHIP_LOG_LEVEL_DEFAULT chip::Logging::kLogCategory_Max
+#endif
+
+#ifndef CHIP_LOG_LEVEL_NotSpecified
+#define CHIP_LOG_LEVEL_NotSpecified CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Inet
+#define CHIP_LOG_LEVEL_Inet CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Ble
+#define CHIP_LOG_LEVEL_Ble CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_MessageLayer
+#define CHIP_LOG_LEVEL_MessageLayer CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_SecurityManager
+#define CHIP_LOG_LEVEL_SecurityManager CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_ExchangeManager
+#define CHIP_LOG_LEVEL_ExchangeManager CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_TLV
+#define CHIP_LOG_LEVEL_TLV CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_ASN1
+#define CHIP_LOG_LEVEL_ASN1 CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Crypto
+#define CHIP_LOG_LEVEL_Crypto CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Controller
+#define CHIP_LOG_LEVEL_Controller CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Alarm
+#define CHIP_LOG_LEVEL_Alarm CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_BDX
+#define CHIP_LOG_LEVEL_BDX CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_DataManagement
+#define CHIP_LOG_LEVEL_DataManagement CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_DeviceControl
+#define CHIP_LOG_LEVEL_DeviceControl CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_DeviceDescription
+#define CHIP_LOG_LEVEL_DeviceDescription CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Echo
+#define CHIP_LOG_LEVEL_Echo CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_FabricProvisioning
+#define CHIP_LOG_LEVEL_FabricProvisioning CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_NetworkProvisioning
+#define CHIP_LOG_LEVEL_NetworkProvisioning CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_ServiceDirectory
+#define CHIP_LOG_LEVEL_ServiceDirectory CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_ServiceProvisioning
+#define CHIP_LOG_LEVEL_ServiceProvisioning CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_SoftwareUpdate
+#define CHIP_LOG_LEVEL_SoftwareUpdate CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_TokenPairing
+#define CHIP_LOG_LEVEL_TokenPairing CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_TimeService
+#define CHIP_LOG_LEVEL_TimeService CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Heartbeat
+#define CHIP_LOG_LEVEL_Heartbeat CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_chipSystemLayer
+#define CHIP_LOG_LEVEL_chipSystemLayer CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_EventLogging
+#define CHIP_LOG_LEVEL_EventLogging CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Support
+#define CHIP_LOG_LEVEL_Support CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_chipTool
+#define CHIP_LOG_LEVEL_chipTool CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Zcl
+#define CHIP_LOG_LEVEL_Zcl CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Shell
+#define CHIP_LOG_LEVEL_Shell CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_DeviceLayer
+#define CHIP_LOG_LEVEL_DeviceLayer CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_SetupPayload
+#define CHIP_LOG_LEVEL_SetupPayload CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_AppServer
+#define CHIP_LOG_LEVEL_AppServer CHIP_LOG_LEVEL_DEFAULT
+#endif
+#ifndef CHIP_LOG_LEVEL_Discovery
+#define CHIP_LOG_LEVEL_Discovery CHIP_LOG_LEVEL_DEFAULT
+#endif
+
+/**
+ * @def _CHIP_LOG(MOD, CAT, MSG, ...)
+ *
+ * @brief
+ *   Log a chip message for the specified module in the specified
+ *   category, unless the category is compiled out or filtered out for
+ *   the module.  Expands to an expression.
+ *
+ */
+#define _CHIP_LOG(MOD, CAT, MSG, ...)                                                                                              \
+    (((CHIP_LOG_LEVEL_##MOD) >= (CAT) && chip::Logging::IsModuleCategoryEnabled(chip::Logging::kLogModule_##MOD, CAT))            \
+         ? chip::Logging::Log(chip::Logging::kLogModule_##MOD, CAT, MSG, ##__VA_ARGS__)                                           \
+         : (void) 0)
+
+#ifndef CHIP_ERROR_LOGGING
+#define CHIP_ERROR_LOGGING 1
+#endif
+
 #if CHIP_ERROR_LOGGING
 /**
  * @def ChipLogError(MOD, MSG, ...)
@@ -213,7 +382,7 @@ extern void SetLogFilter(uint8_t category);
  */
 #ifndef ChipLogError
 #define ChipLogError(MOD, MSG, ...)                                                                                                \
-    chip::Logging::Log(chip::Logging::kLogModule_##MOD, chip::Logging::kLogCategory_Error, MSG, ##__VA_ARGS__)
+    _CHIP_LOG(MOD, chip::Logging::kLogCategory_Error, MSG, ##__VA_ARGS__)
 #endif
 #else
 #define ChipLogError(MOD, MSG, ...)
@@ -234,7 +403,7 @@ extern void SetLogFilter(uint8_t category);
  */
 #ifndef ChipLogProgress
 #define ChipLogProgress(MOD, MSG, ...)                                                                                             \
-    chip::Logging::Log(chip::Logging::kLogModule_##MOD, chip::Logging::kLogCategory_Progress, MSG, ##__VA_ARGS__)
+    _CHIP_LOG(MOD, chip::Logging::kLogCategory_Progress, MSG, ##__VA_ARGS__)
 #endif
 #else
 #define ChipLogProgress(MOD, MSG, ...)
@@ -255,7 +424,7 @@ extern void SetLogFilter(uint8_t category);
  */
 #ifndef ChipLogDetail
 #define ChipLogDetail(MOD, MSG, ...)                                                                                               \
-    chip::Logging::Log(chip::Logging::kLogModule_##MOD, chip::Logging::kLogCategory_Detail, MSG, ##__VA_ARGS__)
+    _CHIP_LOG(MOD, chip::Logging::kLogCategory_Detail, MSG, ##__VA_ARGS__)
 #endif
 #else
 #define ChipLogDetail(MOD, MSG, ...)
@@ -278,7 +447,7 @@ extern void SetLogFilter(uint8_t category);
  */
 #ifndef ChipLogRetain
 #define ChipLogRetain(MOD, MSG, ...)                                                                                               \
-    chip::Logging::Log(chip::Logging::kLogModule_##MOD, chip::Logging::kLogCategory_Retain, MSG, ##__VA_ARGS__)
+    _CHIP_LOG(MOD, chip::Logging::kLogCategory_Retain, MSG, ##__VA_ARGS__)
 #endif
 
 #else // #if CHIP_RETAIN_LOGGING
@@ -323,8 +492,6 @@ static inline void GetModuleName(char * buf, uint8_t module)
 
 #endif // _CHIP_USE_LOGGING
 
-extern bool IsCategoryEnabled(uint8_t CAT);
-
 /**
  *  @def ChipLogIfFalse(aCondition)
  *
@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for deferred formatting of
+ *      log messages.
+ *
+ */
+
+#include "TestSupport.h"
+
+#include <support/TestUtils.h>
+#include <support/logging/CHIPBinaryLogging.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Logging;
+
+namespace {
+
+// Captures the arguments, renders them and checks the result against vsnprintf.
+bool CheckRoundTrip(const char * format, ...)
+{
+    uint8_t args[256];
+    char expected[256];
+    char actual[256];
+    size_t argsLength = 0;
+    bool captured;
+    va_list v;
+
+    va_start(v, format);
+    captured = CaptureLogArgs(format, v, args, sizeof(args), argsLength);
+    va_end(v);
+
+    va_start(v, format);
+    vsnprintf(expected, sizeof(expected), format, v);
+    va_end(v);
+
+    FormatCapturedLogArgs(format, args, argsLength, actual, sizeof(actual));
+
+    if (!captured || strcmp(expected, actual) != 0)
+    {
+        printf("format \"%s\": expected \"%s\", got \"%s\"\n", format, expected, actual);
+        return false;
+    }
+
+    return true;
+}
+
+bool Capture(const char * format, uint8_t * buf, size_t bufSize, size_t & outLength, ...)
+{
+    bool captured;
+    va_list v;
+
+    va_start(v, outLength);
+    captured = CaptureLogArgs(format, v, buf, bufSize, outLength);
+    va_end(v);
+
+    return captured;
+}
+
+} // namespace
+
+static void TestCaptureIntegers(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("no arguments"));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%d %i %u", -42, 7, 4000000000u));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%hhd %hhu %hd %hu", -1, 255, -300, 65535));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%ld %lu %lld %llu", -5L, 5UL, -9000000000LL, 18000000000ULL));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%zu %jd %td", sizeof(int), static_cast<intmax_t>(-3), static_cast<ptrdiff_t>(-4)));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("0x%08" PRIx32 " 0x%016" PRIX64 " %o", 0xbeefu, static_cast<uint64_t>(0xABCD), 8));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("[%-6d] [%+d] [% d] [%#x] [%05d]", 12, 3, 4, 255, -7));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("[%*d] [%-*d] [%.*d] [%*.*d]", 6, 1, 4, 2, 3, 5, 8, 4, 9));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("100%% %c%c", 'o', 'k'));
+}
+
+static void TestCaptureOther(nlTestSuite * inSuite, void * inContext)
+{
+    const char unterminated[] = { 'a', 'b', 'c', 'd' };
+    int value                 = 0;
+
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%s and %s", "first", ""));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("[%8s] [%-8s] [%.2s]", "right", "left", "cut"));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("[%.*s] [%*.*s]", 3, unterminated, 6, 2, unterminated));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%f %.3e %g %.1f", 1.5, 12345.678, 0.25, -2.25));
+    NL_TEST_ASSERT(inSuite, CheckRoundTrip("%p %p", &value, nullptr));
+}
+
+static void TestCaptureLimits(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t args[16];
+    char out[32];
+    size_t argsLength = 0;
+
+    // Arguments that do not fit
+    NL_TEST_ASSERT(inSuite, !Capture("%d %d %d", args, sizeof(args), argsLength, 1, 2, 3));
+    NL_TEST_ASSERT(inSuite, !Capture("%s", args, sizeof(args), argsLength, "a string longer than the buffer"));
+
+    // Unsupported conversions
+    NL_TEST_ASSERT(inSuite, !Capture("%ls", args, sizeof(args), argsLength, L"wide"));
+    NL_TEST_ASSERT(inSuite, !Capture("%k", args, sizeof(args), argsLength, 1));
+
+    // Rendering stops at the first missing argument, and at the end of the output
+    NL_TEST_ASSERT(inSuite, Capture("%d", args, sizeof(args), argsLength, 5));
+    FormatCapturedLogArgs("a %d b %d c", args, argsLength, out, sizeof(out));
+    NL_TEST_ASSERT(inSuite, strcmp(out, "a 5 b ") == 0);
+
+    FormatCapturedLogArgs("0123456789", args, 0, out, 5);
+    NL_TEST_ASSERT(inSuite, strcmp(out, "0123") == 0);
+    FormatCapturedLogArgs("x%d", args, argsLength, out, 2);
+    NL_TEST_ASSERT(inSuite, strcmp(out, "x") == 0);
+}
+
+static void TestBinaryLogRecords(nlTestSuite * inSuite, void * inContext)
+{
+    const char * format  = "value %d";
+    const uint8_t args[] = { 1, 2, 3 };
+    uint8_t buf[64];
+    size_t length        = 0;
+    size_t decodedLength = 0;
+    BinaryLogRecord record;
+    BinaryLogRecord decoded;
+
+    memset(&record, 0, sizeof(record));
+    record.mType         = BinaryLogRecordType::kFormat;
+    record.mFormatId     = 7;
+    record.mFormat       = format;
+    record.mFormatLength = static_cast<uint16_t>(strlen(format));
+    length               = EncodeBinaryLogRecord(record, buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, length == 7 + strlen(format));
+    NL_TEST_ASSERT(inSuite, DecodeBinaryLogRecord(buf, length, decoded, decodedLength) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decodedLength == length);
+    NL_TEST_ASSERT(inSuite, decoded.mType == BinaryLogRecordType::kFormat && decoded.mFormatId == 7);
+    NL_TEST_ASSERT(inSuite, decoded.mFormatLength == strlen(format) && memcmp(decoded.mFormat, format, strlen(format)) == 0);
+
+    memset(&record, 0, sizeof(record));
+    record.mType       = BinaryLogRecordType::kMessage;
+    record.mTimestamp  = 0x0102030405060708;
+    record.mThreadId   = 99;
+    record.mFormatId   = 7;
+    record.mModule     = 3;
+    record.mCategory   = 2;
+    record.mArgs       = args;
+    record.mArgsLength = sizeof(args);
+    length             = EncodeBinaryLogRecord(record, buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, length == 21 + sizeof(args));
+    NL_TEST_ASSERT(inSuite, DecodeBinaryLogRecord(buf, length, decoded, decodedLength) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decodedLength == length);
+    NL_TEST_ASSERT(inSuite, decoded.mType == BinaryLogRecordType::kMessage && decoded.mTimestamp == record.mTimestamp);
+    NL_TEST_ASSERT(inSuite, decoded.mThreadId == 99 && decoded.mFormatId == 7 && decoded.mModule == 3 && decoded.mCategory == 2);
+    NL_TEST_ASSERT(inSuite, decoded.mArgsLength == sizeof(args) && memcmp(decoded.mArgs, args, sizeof(args)) == 0);
+
+    // Truncated and unknown records
+    NL_TEST_ASSERT(inSuite, DecodeBinaryLogRecord(buf, length - 1, decoded, decodedLength) == CHIP_ERROR_MESSAGE_INCOMPLETE);
+    NL_TEST_ASSERT(inSuite, DecodeBinaryLogRecord(buf, 5, decoded, decodedLength) == CHIP_ERROR_MESSAGE_INCOMPLETE);
+    NL_TEST_ASSERT(inSuite, EncodeBinaryLogRecord(record, buf, length - 1) == 0);
+    buf[0] = 0xff;
+    NL_TEST_ASSERT(inSuite, DecodeBinaryLogRecord(buf, length, decoded, decodedLength) == CHIP_ERROR_INVALID_MESSAGE_TYPE);
+
+    memset(&record, 0, sizeof(record));
+    record.mType         = BinaryLogRecordType::kDropped;
+    record.mThreadId     = 5;
+    record.mDroppedCount = 12;
+    length               = EncodeBinaryLogRecord(record, buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, DecodeBinaryLogRecord(buf, length, decoded, decodedLength) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decoded.mType == BinaryLogRecordType::kDropped && decoded.mThreadId == 5);
+    NL_TEST_ASSERT(inSuite, decoded.mDroppedCount == 12);
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestCaptureIntegers), NL_TEST_DEF_FN(TestCaptureOther),
+                                 NL_TEST_DEF_FN(TestCaptureLimits), NL_TEST_DEF_FN(TestBinaryLogRecords), NL_TEST_SENTINEL() };
+
+int TestBinaryLogging(void)
+{
+    nlTestSuite theSuite = { "CHIP binary logging tests", &sTests[0], nullptr, nullptr };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBinaryLogging)
@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the compile-time and
+ *      runtime filtering of log messages.
+ *
+ */
+
+// Compile everything above the Error category out of the Echo module.
+#define CHIP_LOG_LEVEL_Echo chip::Logging::kLogCategory_Error
+
+#include "TestSupport.h"
+
+#include <support/ErrorStr.h>
+#include <support/TestUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+using namespace chip;
+using namespace chip::Logging;
+
+namespace {
+
+int sEvaluated;
+
+int Evaluate()
+{
+    return ++sEvaluated;
+}
+
+#if CHIP_LOG_FILTERING
+
+void RestoreFilters()
+{
+    SetLogFilter(kLogCategory_Max);
+    for (uint8_t module = 0; module < kLogModule_Max; module++)
+    {
+        SetModuleLogFilter(module, kLogCategory_Max);
+    }
+}
+
+void TestGlobalFilter(nlTestSuite * inSuite, void * inContext)
+{
+    sEvaluated = 0;
+    SetLogFilter(kLogCategory_Error);
+
+    ChipLogProgress(Support, "filtered %d", Evaluate());
+    ChipLogDetail(Support, "filtered %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 0);
+
+    ChipLogError(Support, "logged %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 1);
+
+    SetLogFilter(kLogCategory_None);
+    ChipLogError(Support, "filtered %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 1);
+
+    RestoreFilters();
+}
+
+void TestModuleFilter(nlTestSuite * inSuite, void * inContext)
+{
+    sEvaluated = 0;
+
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Support) == kLogCategory_Max);
+    SetModuleLogFilter(kLogModule_Support, kLogCategory_Error);
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Support) == kLogCategory_Error);
+
+    ChipLogDetail(Support, "filtered %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 0);
+    NL_TEST_ASSERT(inSuite, !IsModuleCategoryEnabled(kLogModule_Support, kLogCategory_Progress));
+    NL_TEST_ASSERT(inSuite, IsModuleCategoryEnabled(kLogModule_Support, kLogCategory_Error));
+
+    // Other modules are not affected.
+    ChipLogDetail(Inet, "logged %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 1);
+    NL_TEST_ASSERT(inSuite, IsModuleCategoryEnabled(kLogModule_Inet, kLogCategory_Detail));
+
+    // The global filter still applies on top of the module filter.
+    SetModuleLogFilter(kLogModule_Inet, kLogCategory_Detail);
+    SetLogFilter(kLogCategory_Progress);
+    NL_TEST_ASSERT(inSuite, !IsModuleCategoryEnabled(kLogModule_Inet, kLogCategory_Detail));
+    NL_TEST_ASSERT(inSuite, IsModuleCategoryEnabled(kLogModule_Inet, kLogCategory_Progress));
+
+    SetModuleLogFilter(kLogModule_Support, kLogCategory_None);
+    ChipLogError(Support, "filtered %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 1);
+
+    // Unknown modules only follow the global filter.
+    SetModuleLogFilter(kLogModule_Max, kLogCategory_None);
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Max) == kLogCategory_Max);
+    NL_TEST_ASSERT(inSuite, IsModuleCategoryEnabled(kLogModule_Max, kLogCategory_Progress));
+
+    RestoreFilters();
+}
+
+#endif // CHIP_LOG_FILTERING
+
+void TestCompileTimeLevel(nlTestSuite * inSuite, void * inContext)
+{
+    int value  = 0;
+    sEvaluated = 0;
+
+    static_assert(CHIP_LOG_LEVEL_Echo == kLogCategory_Error, "Echo level not overridden");
+    static_assert(CHIP_LOG_LEVEL_Support == CHIP_LOG_LEVEL_DEFAULT, "Support level not defaulted");
+
+    ChipLogProgress(Echo, "compiled out %d", Evaluate());
+    ChipLogDetail(Echo, "compiled out %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 0);
+
+    ChipLogError(Echo, "logged %d", Evaluate());
+    NL_TEST_ASSERT(inSuite, sEvaluated == 1);
+
+    // The macros remain expressions.
+    (ChipLogProgress(Echo, "compiled out %d", Evaluate()), value = 1);
+    NL_TEST_ASSERT(inSuite, value == 1 && sEvaluated == 1);
+}
+
+#if CHIP_LOG_FILTERING
+
+/**
+ * Measures the cost of a detail message whose category is filtered out, with an ErrorStr() argument as in
+ * SecureSessionMgr, when the arguments are evaluated before filtering (as calling Log() directly does) and with
+ * the ChipLogDetail() macro.  Only correctness is asserted; the rates are informative.
+ */
+void TestFilteredBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kMessages = 200000;
+    const CHIP_ERROR err     = CHIP_ERROR_INVALID_ARGUMENT;
+    uint64_t start, evaluatedTime, filteredTime;
+
+    SetModuleLogFilter(kLogModule_Inet, kLogCategory_Progress);
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < kMessages; i++)
+    {
+        Log(kLogModule_Inet, kLogCategory_Detail, "Secure transport failed: %s", ErrorStr(err));
+    }
+    evaluatedTime = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    sEvaluated = 0;
+    start      = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < kMessages; i++)
+    {
+        ChipLogDetail(Inet, "Secure transport failed: %s %d", ErrorStr(err), Evaluate());
+    }
+    filteredTime = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+    NL_TEST_ASSERT(inSuite, sEvaluated == 0);
+
+    printf("Filtered detail message with ErrorStr(): arguments evaluated %" PRIu64 " ns/message, ChipLogDetail %" PRIu64
+           " ns/message\n",
+           evaluatedTime * 1000 / kMessages, filteredTime * 1000 / kMessages);
+
+    RestoreFilters();
+}
+
+#endif // CHIP_LOG_FILTERING
+
+} // namespace
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+#if CHIP_LOG_FILTERING
+    NL_TEST_DEF_FN(TestGlobalFilter),
+    NL_TEST_DEF_FN(TestModuleFilter),
+#endif
+    NL_TEST_DEF_FN(TestCompileTimeLevel),
+#if CHIP_LOG_FILTERING
+    NL_TEST_DEF_FN(TestFilteredBenchmark),
+#endif
+    NL_TEST_SENTINEL()
+};
+
+int TestCHIPLogging(void)
+{
+    nlTestSuite theSuite = { "CHIP logging filter tests", &sTests[0], nullptr, nullptr };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCHIPLogging)
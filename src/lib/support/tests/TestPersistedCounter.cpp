@@ -170,6 +170,67 @@ static void CheckWriteNextCounterStart(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, value == 0x20000);
 }
 
+static void CheckWriteBatch(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistedCounterContext * context = static_cast<TestPersistedCounterContext *>(inContext);
+    CHIP_ERROR err                        = CHIP_NO_ERROR;
+    const char * testKeys[]               = { "msg-counter", "event-crit", "event-prod", "event-info", "event-debug" };
+    const size_t kCounters                = sizeof(testKeys) / sizeof(testKeys[0]);
+    chip::PersistedCounter counters[kCounters], rebootCounters[kCounters], batchCounters[kCounters];
+    uint32_t writes;
+
+    InitializePersistedStorage(context);
+
+    // Out of the box, without a batch: every counter writes its next
+    // starting value on its own.
+    writes = sPersistentStoreWriteCount;
+    for (size_t i = 0; i < kCounters; i++)
+    {
+        err = counters[i].Init(testKeys[i], 0x100);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sPersistentStoreWriteCount - writes == kCounters);
+
+    // Reboot, initializing the counters in a batch: the store is written
+    // once, when the batch is committed.
+    writes = sPersistentStoreWriteCount;
+    err    = chip::Platform::PersistedStorage::BeginWriteBatch();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    for (size_t i = 0; i < kCounters; i++)
+    {
+        err = rebootCounters[i].Init(testKeys[i], 0x100);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, rebootCounters[i].GetValue() == 0x100);
+    }
+
+    // Nested batches are committed by the outermost one.
+    err = chip::Platform::PersistedStorage::BeginWriteBatch();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < 0x100; i++)
+    {
+        err = rebootCounters[0].Advance();
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    err = chip::Platform::PersistedStorage::CommitWriteBatch();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPersistentStoreWriteCount == writes);
+
+    err = chip::Platform::PersistedStorage::CommitWriteBatch();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPersistentStoreWriteCount - writes == 1);
+
+    err = chip::Platform::PersistedStorage::CommitWriteBatch();
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INCORRECT_STATE);
+
+    // Reboot again: the batched starting values were all persisted.
+    for (size_t i = 0; i < kCounters; i++)
+    {
+        err = batchCounters[i].Init(testKeys[i], 0x100);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, batchCounters[i].GetValue() == (i == 0 ? 0x300u : 0x200u));
+    }
+}
+
 // Test Suite
 
 /**
@@ -177,6 +238,7 @@ static void CheckWriteNextCounterStart(nlTestSuite * inSuite, void * inContext)
  */
 static const nlTest sTests[] = { NL_TEST_DEF("Out of box Test", CheckOOB), NL_TEST_DEF("Reboot Test", CheckReboot),
                                  NL_TEST_DEF("Write Next Counter Start Test", CheckWriteNextCounterStart),
+                                 NL_TEST_DEF("Write Batch Test", CheckWriteBatch),
 
                                  NL_TEST_SENTINEL() };
 
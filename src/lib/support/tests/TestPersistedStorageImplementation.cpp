@@ -48,6 +48,12 @@ std::map<std::string, std::string> sPersistentStore;
 
 FILE * sPersistentStoreFile = nullptr;
 
+uint32_t sPersistentStoreWriteCount = 0;
+
+// Values written in the open write batch.
+static std::map<std::string, uint32_t> sPendingWrites;
+static uint32_t sWriteBatchDepth = 0;
+
 namespace chip {
 namespace Platform {
 namespace PersistedStorage {
@@ -145,7 +151,11 @@ CHIP_ERROR Read(const char * aKey, uint32_t & aValue)
     VerifyOrExit(aKey != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(strlen(aKey) <= CHIP_CONFIG_PERSISTED_STORAGE_MAX_KEY_LENGTH, err = CHIP_ERROR_INVALID_STRING_LENGTH);
 
-    if (sPersistentStoreFile)
+    if (sPendingWrites.find(aKey) != sPendingWrites.end())
+    {
+        aValue = sPendingWrites[aKey];
+    }
+    else if (sPersistentStoreFile)
     {
         err = GetCounterValueFromFile(aKey, aValue);
     }
@@ -163,13 +173,10 @@ exit:
     return err;
 }
 
-CHIP_ERROR Write(const char * aKey, uint32_t aValue)
+static CHIP_ERROR StoreValue(const char * aKey, uint32_t aValue)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    VerifyOrExit(aKey != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(strlen(aKey) <= CHIP_CONFIG_PERSISTED_STORAGE_MAX_KEY_LENGTH, err = CHIP_ERROR_INVALID_STRING_LENGTH);
-
     if (sPersistentStoreFile)
     {
         err = SaveCounterValueToFile(aKey, aValue);
@@ -184,7 +191,60 @@ CHIP_ERROR Write(const char * aKey, uint32_t aValue)
         sPersistentStore[aKey] = encodedValue;
     }
 
+    return err;
+}
+
+CHIP_ERROR Write(const char * aKey, uint32_t aValue)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(aKey != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(strlen(aKey) <= CHIP_CONFIG_PERSISTED_STORAGE_MAX_KEY_LENGTH, err = CHIP_ERROR_INVALID_STRING_LENGTH);
+
+    if (sWriteBatchDepth > 0)
+    {
+        sPendingWrites[aKey] = aValue;
+    }
+    else
+    {
+        err = StoreValue(aKey, aValue);
+        sPersistentStoreWriteCount++;
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR BeginWriteBatch()
+{
+    sWriteBatchDepth++;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CommitWriteBatch()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(sWriteBatchDepth > 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    sWriteBatchDepth--;
+
+    if (sWriteBatchDepth == 0 && !sPendingWrites.empty())
+    {
+        for (const auto & write : sPendingWrites)
+        {
+            err = StoreValue(write.first.c_str(), write.second);
+            SuccessOrExit(err);
+        }
+        sPersistentStoreWriteCount++;
+    }
+
 exit:
+    if (sWriteBatchDepth == 0)
+    {
+        sPendingWrites.clear();
+    }
     return err;
 }
 
@@ -23,3 +23,6 @@
 extern std::map<std::string, std::string> sPersistentStore;
 
 extern FILE * sPersistentStoreFile;
+
+// Number of times the store was written to, for a single value or a write batch.
+extern uint32_t sPersistentStoreWriteCount;
@@ -28,7 +28,9 @@
 extern "C" {
 #endif
 
+int TestBinaryLogging(void);
 int TestCHIPArgParser(void);
+int TestCHIPLogging(void);
 int TestErrorStr(void);
 int TestTimeUtils(void);
 int TestMemAlloc(void);
@@ -0,0 +1,169 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a tool that renders binary log files written
+ *      by the asynchronous log backend as text.
+ *
+ */
+
+#include <support/logging/CHIPBinaryLogging.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <core/CHIPEncoding.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Logging;
+
+namespace {
+
+constexpr size_t kMaxMessageSize = 1024;
+
+char CategoryLetter(uint8_t category)
+{
+    switch (category)
+    {
+    case kLogCategory_Error:
+        return 'E';
+    case kLogCategory_Progress:
+        return 'P';
+    case kLogCategory_Detail:
+        return 'D';
+    case kLogCategory_Retain:
+        return 'R';
+    default:
+        return '?';
+    }
+}
+
+bool ReadFile(const char * path, std::vector<uint8_t> & data)
+{
+    uint8_t chunk[4096];
+    size_t n;
+    FILE * file = fopen(path, "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+
+    fclose(file);
+    return true;
+}
+
+int Decode(const std::vector<uint8_t> & data)
+{
+    std::vector<std::string> formats;
+    size_t offset    = sizeof(kBinaryLogMagic);
+    uint64_t dropped = 0;
+
+    if (data.size() < sizeof(kBinaryLogMagic) || Encoding::LittleEndian::Get32(data.data()) != kBinaryLogMagic)
+    {
+        fprintf(stderr, "Not a CHIP binary log file\n");
+        return 1;
+    }
+
+    while (offset < data.size())
+    {
+        BinaryLogRecord record;
+        size_t length;
+        char moduleName[ChipLoggingModuleNameLen + 1];
+        char text[kMaxMessageSize];
+        CHIP_ERROR err = DecodeBinaryLogRecord(&data[offset], data.size() - offset, record, length);
+
+        if (err == CHIP_ERROR_MESSAGE_INCOMPLETE)
+        {
+            // The writer was stopped in the middle of a record.
+            fprintf(stderr, "Log truncated at offset %zu\n", offset);
+            break;
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            fprintf(stderr, "Invalid record at offset %zu\n", offset);
+            return 1;
+        }
+        offset += length;
+
+        switch (record.mType)
+        {
+        case BinaryLogRecordType::kFormat:
+            if (record.mFormatId != formats.size() + 1)
+            {
+                fprintf(stderr, "Unexpected format id %" PRIu32 "\n", record.mFormatId);
+                return 1;
+            }
+            formats.emplace_back(record.mFormat, record.mFormatLength);
+            break;
+
+        case BinaryLogRecordType::kMessage:
+            if (record.mFormatId == 0 || record.mFormatId > formats.size())
+            {
+                fprintf(stderr, "Unknown format id %" PRIu32 "\n", record.mFormatId);
+                return 1;
+            }
+            FormatCapturedLogArgs(formats[record.mFormatId - 1].c_str(), record.mArgs, record.mArgsLength, text, sizeof(text));
+            GetModuleName(moduleName, record.mModule);
+            printf("[%" PRIu64 ".%06" PRIu64 "][%" PRIu32 "] CHIP:%s: %c: %s\n", record.mTimestamp / 1000000,
+                   record.mTimestamp % 1000000, record.mThreadId, moduleName, CategoryLetter(record.mCategory), text);
+            break;
+
+        case BinaryLogRecordType::kDropped:
+            printf("[%" PRIu32 "] %" PRIu32 " messages dropped\n", record.mThreadId, record.mDroppedCount);
+            dropped += record.mDroppedCount;
+            break;
+        }
+    }
+
+    if (dropped > 0)
+    {
+        fprintf(stderr, "%" PRIu64 " messages dropped in total\n", dropped);
+    }
+
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    std::vector<uint8_t> data;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <binary log file>\n", argv[0]);
+        return 2;
+    }
+
+    if (!ReadFile(argv[1], data))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    return Decode(data);
+}
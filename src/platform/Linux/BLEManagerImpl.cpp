@@ -386,16 +386,8 @@ void BLEManagerImpl::HandleRXCharWrite(BLE_CONNECTION_OBJECT conId, const uint8_
     // Cast is safe, since we just verified that "len" fits in uint16_t.
     buf->SetDataLength(static_cast<uint16_t>(len));
 
-    // Post an event to the Chip queue to deliver the data into the Chip stack.
-    {
-        ChipDeviceEvent event;
-        event.Type = DeviceEventType::kCHIPoBLEWriteReceived;
-        ChipLogProgress(Ble, "Write request received debug %p", conId);
-        event.CHIPoBLEWriteReceived.ConId = conId;
-        event.CHIPoBLEWriteReceived.Data  = buf;
-        PlatformMgr().PostEvent(&event);
-        buf = nullptr;
-    }
+    HandleRXCharWrite(conId, buf);
+    buf = nullptr;
 
 exit:
     if (err != CHIP_NO_ERROR)
@@ -409,6 +401,18 @@ exit:
     }
 }
 
+// Takes ownership of buf, which BtpEngine adopts as its reassembly buffer without copying.
+void BLEManagerImpl::HandleRXCharWrite(BLE_CONNECTION_OBJECT conId, PacketBuffer * buf)
+{
+    // Post an event to the Chip queue to deliver the data into the Chip stack.
+    ChipDeviceEvent event;
+    event.Type = DeviceEventType::kCHIPoBLEWriteReceived;
+    ChipLogProgress(Ble, "Write request received debug %p", conId);
+    event.CHIPoBLEWriteReceived.ConId = conId;
+    event.CHIPoBLEWriteReceived.Data  = buf;
+    PlatformMgr().PostEvent(&event);
+}
+
 void BLEManagerImpl::CHIPoBluez_ConnectionClosed(BLE_CONNECTION_OBJECT conId)
 {
     ChipLogProgress(DeviceLayer, "Bluez notify CHIPoBluez connection disconnected");
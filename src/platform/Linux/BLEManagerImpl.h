@@ -96,6 +96,7 @@ public:
     // Driven by BlueZ IO
     static void CHIPoBluez_NewConnection(BLE_CONNECTION_OBJECT user_data);
     static void HandleRXCharWrite(BLE_CONNECTION_OBJECT user_data, const uint8_t * value, size_t len);
+    static void HandleRXCharWrite(BLE_CONNECTION_OBJECT user_data, System::PacketBuffer * buf);
     static void CHIPoBluez_ConnectionClosed(BLE_CONNECTION_OBJECT user_data);
     static void HandleTXCharCCCDWrite(BLE_CONNECTION_OBJECT user_data);
     static void HandleTXComplete(BLE_CONNECTION_OBJECT user_data);
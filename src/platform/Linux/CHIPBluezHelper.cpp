@@ -302,7 +302,6 @@ static gboolean BluezCharacteristicWriteValue(BluezGattCharacteristic1 * aChar,
                                               GVariant * aValue, GVariant * aOptions, gpointer apEndpoint)
 {
     const uint8_t * tmpBuf;
-    uint8_t * buf;
     size_t len;
     bool isSuccess         = false;
     BluezConnection * conn = NULL;
@@ -316,12 +315,11 @@ static gboolean BluezCharacteristicWriteValue(BluezGattCharacteristic1 * aChar,
     VerifyOrExit(conn != NULL,
                  g_dbus_method_invocation_return_dbus_error(aInvocation, "org.bluez.Error.Failed", "No CHIP Bluez connection"));
 
-    bluez_gatt_characteristic1_set_value(aChar, g_variant_ref(aValue));
+    // C1 is write-only, so the value is not mirrored into the characteristic property; the bytes are copied
+    // once, straight out of the GVariant into the PacketBuffer handed to the BLE layer.
+    tmpBuf = static_cast<const uint8_t *>(g_variant_get_fixed_array(aValue, &len, sizeof(uint8_t)));
 
-    tmpBuf = (uint8_t *) (g_variant_get_fixed_array(aValue, &len, sizeof(uint8_t)));
-    buf    = (uint8_t *) (g_memdup(tmpBuf, len));
-
-    BLEManagerImpl::HandleRXCharWrite(conn, buf, len);
+    BLEManagerImpl::HandleRXCharWrite(conn, tmpBuf, len);
     bluez_gatt_characteristic1_complete_write_value(aChar, aInvocation);
     isSuccess = true;
 
@@ -341,8 +339,7 @@ static gboolean BluezCharacteristicWriteValueError(BluezGattCharacteristic1 * aC
 
 static gboolean BluezCharacteristicWriteFD(GIOChannel * aChannel, GIOCondition aCond, gpointer apEndpoint)
 {
-    GVariant * newVal;
-    gchar * buf;
+    chip::System::PacketBuffer * buf = nullptr;
     ssize_t len;
     int fd;
     bool isSuccess = false;
@@ -357,21 +354,28 @@ static gboolean BluezCharacteristicWriteFD(GIOChannel * aChannel, GIOCondition a
 
     ChipLogDetail(DeviceLayer, "c1 %s mtu, %d", __func__, conn->mMtu);
 
-    buf = static_cast<gchar *>(g_malloc(conn->mMtu));
-    fd  = g_io_channel_unix_get_fd(aChannel);
+    // Read the fragment straight into the PacketBuffer that BtpEngine will reassemble into.
+    buf = chip::System::PacketBuffer::New();
+    VerifyOrExit(buf != nullptr, ChipLogError(DeviceLayer, "FAIL: no PacketBuffer in %s", __func__));
+    VerifyOrExit(buf->AvailableDataLength() >= conn->mMtu, ChipLogError(DeviceLayer, "FAIL: mtu too large in %s", __func__));
 
-    len = read(fd, buf, conn->mMtu);
+    fd  = g_io_channel_unix_get_fd(aChannel);
+    len = read(fd, buf->Start(), conn->mMtu);
 
     VerifyOrExit(len > 0, ChipLogError(DeviceLayer, "FAIL: short read in %s (%d)", __func__, len));
 
-    // Casting len to size_t is safe, since we ensured that it's not negative.
-    newVal = g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, buf, static_cast<size_t>(len), sizeof(uint8_t));
+    // Casting len to uint16_t is safe, since it is positive and no larger than the mtu.
+    buf->SetDataLength(static_cast<uint16_t>(len));
 
-    bluez_gatt_characteristic1_set_value(conn->mpC1, newVal);
-    BLEManagerImpl::HandleRXCharWrite(conn, reinterpret_cast<uint8_t *>(buf), static_cast<size_t>(len));
+    BLEManagerImpl::HandleRXCharWrite(conn, buf);
+    buf       = nullptr;
     isSuccess = true;
 
 exit:
+    if (buf != nullptr)
+    {
+        chip::System::PacketBuffer::Free(buf);
+    }
     return isSuccess ? TRUE : FALSE;
 }
 
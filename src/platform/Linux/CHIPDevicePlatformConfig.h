@@ -68,6 +68,67 @@
 #define CHIP_DEVICE_LAYER_BLE_CONN_CFG_TAG 1
 #endif // CHIP_DEVICE_LAYER_BLE_CONN_CFG_TAG
 
+/**
+ * @def CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+ *
+ * Enable the asynchronous log backend (ChipLinuxAsyncLog), which moves the
+ * formatting and output of log messages off the logging threads and onto a
+ * background thread.
+ */
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+#define CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING 0
+#endif // CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+
+/**
+ * @def CHIP_DEVICE_CONFIG_ASYNC_LOG_FILE
+ *
+ * When the asynchronous log backend is enabled and this is not empty, log
+ * messages are written unformatted to this binary file, to be rendered
+ * with logdecodetool, instead of being formatted to syslog.
+ */
+#ifndef CHIP_DEVICE_CONFIG_ASYNC_LOG_FILE
+#define CHIP_DEVICE_CONFIG_ASYNC_LOG_FILE ""
+#endif // CHIP_DEVICE_CONFIG_ASYNC_LOG_FILE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_ENABLE_STORAGE_LOG
+ *
+ * Store the config and counters partitions as append-only logs
+ * (ChipLinuxStorageLog), which only write the changed values on each
+ * commit, instead of rewriting whole INI files.  Existing INI files are
+ * imported on first use.
+ */
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_STORAGE_LOG
+#define CHIP_DEVICE_CONFIG_ENABLE_STORAGE_LOG 0
+#endif // CHIP_DEVICE_CONFIG_ENABLE_STORAGE_LOG
+
+/**
+ * @def CHIP_DEVICE_CONFIG_STORAGE_LOG_SYNC_INTERVAL
+ *
+ * Minimum time, in milliseconds, between two syncs of a storage log to
+ * disk.  Commits made in between are batched into the next sync, at the
+ * risk of losing them on a power failure.  0 syncs every commit.
+ */
+#ifndef CHIP_DEVICE_CONFIG_STORAGE_LOG_SYNC_INTERVAL
+#define CHIP_DEVICE_CONFIG_STORAGE_LOG_SYNC_INTERVAL 0
+#endif // CHIP_DEVICE_CONFIG_STORAGE_LOG_SYNC_INTERVAL
+
+/**
+ * @def CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY
+ *
+ * Maximum time, in milliseconds, by which the commit of a change to the
+ * config partition may be delayed so that it is committed along with the
+ * following changes.  Changes still waiting are committed at exit, but are
+ * lost if the process is killed.  0 commits every change immediately.
+ *
+ * Counters are never delayed by this setting, but like any other value they
+ * are only committed at the end of a write batch that is open when they are
+ * written.
+ */
+#ifndef CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY
+#define CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY 0
+#endif // CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
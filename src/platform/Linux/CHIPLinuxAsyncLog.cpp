@@ -0,0 +1,461 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements an asynchronous log backend for Linux platforms.
+ *
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <syslog.h>
+#include <unistd.h>
+
+#include <new>
+#include <vector>
+
+#include <core/CHIPEncoding.h>
+#include <platform/Linux/CHIPLinuxAsyncLog.h>
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPBinaryLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+using namespace chip::Logging;
+
+namespace {
+
+// Format of messages whose arguments could not be captured and were formatted on the logging thread instead.
+const char kTextFormat[] = "%s";
+
+// Longer format strings are cut off in the binary log file.
+constexpr size_t kMaxFormatLength = 512;
+
+// How long the background thread sleeps when there is nothing to write out.  A ring that fills up to half
+// wakes it sooner.
+constexpr std::chrono::milliseconds kIdleWait(20);
+
+bool CaptureText(uint8_t * buf, size_t bufSize, size_t & outLength, ...)
+{
+    va_list v;
+    bool retval;
+
+    va_start(v, outLength);
+    retval = CaptureLogArgs(kTextFormat, v, buf, bufSize, outLength);
+    va_end(v);
+
+    return retval;
+}
+
+void ShutdownAtExit()
+{
+    ChipLinuxAsyncLog::Instance().Shutdown();
+}
+
+} // namespace
+
+thread_local ChipLinuxAsyncLog::RingOwner ChipLinuxAsyncLog::sRingOwner;
+
+ChipLinuxAsyncLog::RingOwner::~RingOwner()
+{
+    // The ring may still hold messages; the background thread frees it once they are written out.
+    if (mRing != nullptr)
+    {
+        mRing->mOwnerExited.store(true, std::memory_order_release);
+        mRing = nullptr;
+    }
+}
+
+ChipLinuxAsyncLog & ChipLinuxAsyncLog::Instance()
+{
+    static ChipLinuxAsyncLog sInstance;
+    return sInstance;
+}
+
+CHIP_ERROR ChipLinuxAsyncLog::Init(const char * binaryLogFile)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    static bool sShutdownRegistered;
+
+    VerifyOrExit(!mRunning.load(), err = CHIP_ERROR_INCORRECT_STATE);
+
+    mFormatIds.clear();
+
+    if (binaryLogFile != nullptr && binaryLogFile[0] != '\0')
+    {
+        uint8_t magic[sizeof(kBinaryLogMagic)];
+
+        mBinaryLog = fopen(binaryLogFile, "wb");
+        VerifyOrExit(mBinaryLog != nullptr, err = System::MapErrorPOSIX(errno));
+
+        Encoding::LittleEndian::Put32(magic, kBinaryLogMagic);
+        WriteRecord(magic, sizeof(magic));
+    }
+
+    // The thread must be joined before the instance is destroyed during exit.
+    if (!sShutdownRegistered)
+    {
+        atexit(ShutdownAtExit);
+        sShutdownRegistered = true;
+    }
+
+    mStopping.store(false);
+    mThread = std::thread(&ChipLinuxAsyncLog::Run, this);
+    mRunning.store(true);
+
+exit:
+    return err;
+}
+
+void ChipLinuxAsyncLog::Shutdown()
+{
+    if (!mRunning.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mWakeupLock);
+        mStopping.store(true);
+        mWakeup.notify_one();
+        mFlushed.notify_all();
+    }
+
+    mThread.join();
+
+    if (mBinaryLog != nullptr)
+    {
+        fclose(mBinaryLog);
+        mBinaryLog = nullptr;
+    }
+}
+
+void ChipLinuxAsyncLog::Flush()
+{
+    std::unique_lock<std::mutex> lock(mWakeupLock);
+    uint64_t generation;
+
+    if (!mRunning.load())
+    {
+        return;
+    }
+
+    generation = ++mFlushRequested;
+    mWakeup.notify_one();
+    mFlushed.wait(lock, [&] { return mFlushCompleted >= generation || mStopping.load(); });
+}
+
+bool ChipLinuxAsyncLog::Log(uint8_t module, uint8_t category, const char * format, va_list v)
+{
+    Ring * ring;
+    Slot * slot;
+    uint32_t head;
+    uint32_t tail;
+    size_t argsLength;
+    va_list args;
+    bool captured;
+
+    if (!mRunning.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    ring = AcquireRing();
+    if (ring == nullptr)
+    {
+        return false;
+    }
+
+    head = ring->mHead.load(std::memory_order_relaxed);
+    tail = ring->mTail.load(std::memory_order_acquire);
+    if (head - tail >= kRingSize)
+    {
+        ring->mDropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    slot             = &ring->mSlots[head % kRingSize];
+    slot->mTimestamp = System::Platform::Layer::GetClock_MonotonicHiRes();
+    slot->mFormat    = format;
+    slot->mModule    = module;
+    slot->mCategory  = category;
+
+    va_copy(args, v);
+    captured = CaptureLogArgs(format, args, slot->mArgs, sizeof(slot->mArgs), argsLength);
+    va_end(args);
+
+    if (!captured)
+    {
+        // Leave room for the length prefix of the captured string.
+        char text[kMaxArgsLength - sizeof(uint16_t) + 1];
+
+        va_copy(args, v);
+        vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+
+        slot->mFormat = kTextFormat;
+        CaptureText(slot->mArgs, sizeof(slot->mArgs), argsLength, text);
+    }
+
+    slot->mArgsLength = static_cast<uint16_t>(argsLength);
+
+    ring->mHead.store(head + 1, std::memory_order_release);
+
+    if (head + 1 - tail == kRingSize / 2)
+    {
+        mWakeup.notify_one();
+    }
+
+    return true;
+}
+
+ChipLinuxAsyncLog::Ring * ChipLinuxAsyncLog::AcquireRing()
+{
+    Ring * ring = sRingOwner.mRing;
+
+    if (ring == nullptr)
+    {
+        ring = new (std::nothrow) Ring;
+        if (ring == nullptr)
+        {
+            return nullptr;
+        }
+
+        ring->mHead.store(0);
+        ring->mTail.store(0);
+        ring->mDropped.store(0);
+        ring->mOwnerExited.store(false);
+        ring->mThreadId = static_cast<uint32_t>(syscall(SYS_gettid));
+
+        {
+            std::lock_guard<std::mutex> lock(mRingsLock);
+            ring->mNext = mRings;
+            mRings      = ring;
+        }
+
+        sRingOwner.mRing = ring;
+    }
+
+    return ring;
+}
+
+void ChipLinuxAsyncLog::Run()
+{
+    for (;;)
+    {
+        uint64_t flushRequested;
+        bool stopping;
+        size_t written;
+
+        {
+            std::lock_guard<std::mutex> lock(mWakeupLock);
+            flushRequested = mFlushRequested;
+            stopping       = mStopping.load();
+        }
+
+        // Everything captured before the flush request or the shutdown was read above is written out here.
+        written = Drain();
+
+        if (mBinaryLog != nullptr && (written > 0 || stopping))
+        {
+            fflush(mBinaryLog);
+        }
+
+        std::unique_lock<std::mutex> lock(mWakeupLock);
+
+        if (mFlushCompleted != flushRequested)
+        {
+            mFlushCompleted = flushRequested;
+            mFlushed.notify_all();
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+
+        if (written == 0 && mFlushRequested == mFlushCompleted && !mStopping.load())
+        {
+            mWakeup.wait_for(lock, kIdleWait);
+        }
+    }
+}
+
+size_t ChipLinuxAsyncLog::Drain()
+{
+    struct Cursor
+    {
+        Ring * mRing;
+        uint32_t mTail;
+        uint32_t mHead;
+    };
+
+    std::vector<Cursor> cursors;
+    size_t written = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mRingsLock);
+        Ring ** link = &mRings;
+
+        while (*link != nullptr)
+        {
+            Ring * ring = *link;
+
+            // The exit flag is read before the head so that every message of an exited thread is seen.
+            bool exited   = ring->mOwnerExited.load(std::memory_order_acquire);
+            uint32_t head = ring->mHead.load(std::memory_order_acquire);
+            uint32_t tail = ring->mTail.load(std::memory_order_relaxed);
+            uint32_t dropped;
+
+            dropped = ring->mDropped.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0)
+            {
+                WriteDropped(*ring, dropped);
+            }
+
+            if (exited && head == tail)
+            {
+                *link = ring->mNext;
+                delete ring;
+                continue;
+            }
+
+            if (head != tail)
+            {
+                cursors.push_back(Cursor{ ring, tail, head });
+            }
+
+            link = &ring->mNext;
+        }
+    }
+
+    // Merge the rings by timestamp.  Each ring is already in order, and the number of threads that log is small.
+    for (;;)
+    {
+        Cursor * next = nullptr;
+
+        for (Cursor & cursor : cursors)
+        {
+            if (cursor.mTail != cursor.mHead &&
+                (next == nullptr ||
+                 cursor.mRing->mSlots[cursor.mTail % kRingSize].mTimestamp <
+                     next->mRing->mSlots[next->mTail % kRingSize].mTimestamp))
+            {
+                next = &cursor;
+            }
+        }
+
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        WriteSlot(*next->mRing, next->mRing->mSlots[next->mTail % kRingSize]);
+        next->mTail++;
+        next->mRing->mTail.store(next->mTail, std::memory_order_release);
+        written++;
+    }
+
+    return written;
+}
+
+void ChipLinuxAsyncLog::WriteSlot(const Ring & ring, const Slot & slot)
+{
+    if (mBinaryLog == nullptr)
+    {
+        char formattedMsg[CHIP_DEVICE_CONFIG_LOG_MESSAGE_MAX_SIZE];
+
+        FormatCapturedLogArgs(slot.mFormat, slot.mArgs, slot.mArgsLength, formattedMsg, sizeof(formattedMsg));
+        syslog(LOG_INFO, "%s", formattedMsg);
+        return;
+    }
+
+    uint8_t record[32 + kMaxFormatLength];
+    BinaryLogRecord binaryRecord;
+    size_t length;
+    auto formatId = mFormatIds.find(slot.mFormat);
+
+    if (formatId == mFormatIds.end())
+    {
+        size_t formatLength = strnlen(slot.mFormat, kMaxFormatLength);
+
+        formatId = mFormatIds.emplace(slot.mFormat, static_cast<uint32_t>(mFormatIds.size() + 1)).first;
+
+        binaryRecord               = BinaryLogRecord();
+        binaryRecord.mType         = BinaryLogRecordType::kFormat;
+        binaryRecord.mFormatId     = formatId->second;
+        binaryRecord.mFormat       = slot.mFormat;
+        binaryRecord.mFormatLength = static_cast<uint16_t>(formatLength);
+
+        length = EncodeBinaryLogRecord(binaryRecord, record, sizeof(record));
+        WriteRecord(record, length);
+    }
+
+    binaryRecord             = BinaryLogRecord();
+    binaryRecord.mType       = BinaryLogRecordType::kMessage;
+    binaryRecord.mFormatId   = formatId->second;
+    binaryRecord.mThreadId   = ring.mThreadId;
+    binaryRecord.mTimestamp  = slot.mTimestamp;
+    binaryRecord.mModule     = slot.mModule;
+    binaryRecord.mCategory   = slot.mCategory;
+    binaryRecord.mArgs       = slot.mArgs;
+    binaryRecord.mArgsLength = slot.mArgsLength;
+
+    length = EncodeBinaryLogRecord(binaryRecord, record, sizeof(record));
+    WriteRecord(record, length);
+}
+
+void ChipLinuxAsyncLog::WriteDropped(const Ring & ring, uint32_t dropped)
+{
+    if (mBinaryLog == nullptr)
+    {
+        syslog(LOG_INFO, "CHIP:DL: Dropped %u log messages from thread %u", static_cast<unsigned>(dropped),
+               static_cast<unsigned>(ring.mThreadId));
+        return;
+    }
+
+    uint8_t record[16];
+    BinaryLogRecord binaryRecord = BinaryLogRecord();
+    size_t length;
+
+    binaryRecord.mType         = BinaryLogRecordType::kDropped;
+    binaryRecord.mThreadId     = ring.mThreadId;
+    binaryRecord.mDroppedCount = dropped;
+
+    length = EncodeBinaryLogRecord(binaryRecord, record, sizeof(record));
+    WriteRecord(record, length);
+}
+
+void ChipLinuxAsyncLog::WriteRecord(const uint8_t * record, size_t length)
+{
+    if (mBinaryLog != nullptr && length > 0)
+    {
+        fwrite(record, 1, length, mBinaryLog);
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
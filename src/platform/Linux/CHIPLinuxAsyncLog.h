@@ -0,0 +1,151 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines an asynchronous log backend for Linux platforms.
+ *
+ *         Logging threads only capture the timestamp, module, category,
+ *         format string pointer and raw arguments of a message into a
+ *         per-thread, single-producer ring; a background thread formats
+ *         the messages in timestamp order and writes them to syslog, or to
+ *         a binary log file that logdecodetool renders offline.
+ *
+ *         A message that arrives while its thread's ring is full is
+ *         dropped and counted, so logging never blocks the caller.
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdarg.h>
+#include <stdio.h>
+#include <thread>
+#include <unordered_map>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxAsyncLog
+{
+public:
+    /**
+     * Number of messages each logging thread can have waiting to be written out.
+     */
+    static constexpr uint32_t kRingSize = 256;
+
+    /**
+     * Space for the captured arguments of a message.  Messages whose arguments do not fit are formatted on the
+     * logging thread and kept as text, cut to this length.
+     */
+    static constexpr size_t kMaxArgsLength = 232;
+
+    static ChipLinuxAsyncLog & Instance();
+
+    /**
+     * Starts the background thread.
+     *
+     * @param binaryLogFile When non-empty, messages are written as binary records to this file, which is truncated,
+     *                      instead of being formatted to syslog.
+     */
+    CHIP_ERROR Init(const char * binaryLogFile);
+
+    /**
+     * Writes out the waiting messages and stops the background thread.  Messages logged concurrently with
+     * Shutdown() may be lost.
+     */
+    void Shutdown();
+
+    /**
+     * Waits until every message captured before the call has been written out.
+     */
+    void Flush();
+
+    /**
+     * Captures a message into the calling thread's ring.
+     *
+     * @return false if the log is not running, in which case the caller should log the message itself.
+     *         @p v is left for the caller to use either way.
+     */
+    bool Log(uint8_t module, uint8_t category, const char * format, va_list v);
+
+private:
+    struct Slot
+    {
+        uint64_t mTimestamp;
+        const char * mFormat;
+        uint8_t mModule;
+        uint8_t mCategory;
+        uint16_t mArgsLength;
+        uint8_t mArgs[kMaxArgsLength];
+    };
+
+    struct Ring
+    {
+        Slot mSlots[kRingSize];
+        std::atomic<uint32_t> mHead;    // Written by the logging thread
+        std::atomic<uint32_t> mTail;    // Written by the background thread
+        std::atomic<uint32_t> mDropped; // Messages dropped since last reported
+        std::atomic<bool> mOwnerExited; // Set once the logging thread exits
+        uint32_t mThreadId;
+        Ring * mNext;
+    };
+
+    struct RingOwner
+    {
+        ~RingOwner();
+        Ring * mRing = nullptr;
+    };
+
+    ChipLinuxAsyncLog() = default;
+
+    Ring * AcquireRing();
+    void Run();
+    size_t Drain();
+    void WriteSlot(const Ring & ring, const Slot & slot);
+    void WriteDropped(const Ring & ring, uint32_t dropped);
+    void WriteRecord(const uint8_t * record, size_t length);
+
+    static thread_local RingOwner sRingOwner;
+
+    std::atomic<bool> mRunning{ false };
+    std::atomic<bool> mStopping{ false };
+    std::thread mThread;
+
+    // Protects the list of rings, which logging threads only take to add their own ring.
+    std::mutex mRingsLock;
+    Ring * mRings = nullptr;
+
+    std::mutex mWakeupLock;
+    std::condition_variable mWakeup;
+    std::condition_variable mFlushed;
+    uint64_t mFlushRequested = 0;
+    uint64_t mFlushCompleted = 0;
+
+    FILE * mBinaryLog = nullptr;
+    std::unordered_map<const char *, uint32_t> mFormatIds;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,637 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements a persistent event log for POSIX platforms.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <platform/Linux/CHIPLinuxEventStore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+using namespace chip::TLV;
+
+/**
+ * Header at the start of the log file.  The circular buffer holding the
+ * events follows it.
+ *
+ * mHeadOffset is the offset of the oldest event in the circular buffer, and
+ * mDataLength the number of bytes the buffer holds from there.  Both are
+ * updated once an event has been fully written, and when the oldest event is
+ * evicted: the head is moved past it before it gets overwritten.  As events
+ * are only evicted while a new one is being written, mDataLength then also
+ * counts the part of the new event written so far, so the log may end in a
+ * partial event; Recover() drops it when the log is opened.
+ */
+struct ChipLinuxEventStore::LogHeader
+{
+    uint32_t mMagic;
+    uint16_t mVersion;
+    uint16_t mHeaderSize;
+    uint32_t mLogSize;
+    uint32_t mHeadOffset;
+    uint32_t mDataLength;
+    uint32_t mReserved;
+    uint64_t mNextEventNumber;
+    uint64_t mLastTimestamp;
+};
+
+namespace {
+
+constexpr uint32_t kLogMagic      = 0x56454843; // "CHEV"
+constexpr uint16_t kLogVersion    = 1;
+constexpr uint16_t kLogHeaderSize = 64;
+
+} // namespace
+
+constexpr uint32_t ChipLinuxEventStore::kIndexGranularity;
+
+ChipLinuxEventStore::ChipLinuxEventStore() : mBuffer(nullptr, 0)
+{
+    mFd            = -1;
+    mMapping       = nullptr;
+    mMappingSize   = 0;
+    mHeader        = nullptr;
+    mIndex         = nullptr;
+    mIndexCapacity = 0;
+    mIndexHead     = 0;
+    mIndexCount    = 0;
+}
+
+ChipLinuxEventStore::~ChipLinuxEventStore()
+{
+    Shutdown();
+}
+
+/**
+ * Opens the event log stored in @p logFile, creating it if needed.
+ *
+ * An existing log is reused if it was created with the same @p logSize; its
+ * index is rebuilt and any partially written event at its end is dropped.
+ * Otherwise the file is reset to an empty log.
+ *
+ * @param[in] logFile   Path of the file backing the log.
+ * @param[in] logSize   Size, in bytes, of the event storage.  Every event must fit in it.
+ */
+CHIP_ERROR ChipLinuxEventStore::Init(const char * logFile, uint32_t logSize)
+{
+    static_assert(sizeof(LogHeader) <= kLogHeaderSize, "Event log header does not fit in its reserved space");
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    struct stat st;
+    bool reset;
+    void * mapping;
+    std::unique_lock<std::shared_timed_mutex> lock(mLock);
+
+    VerifyOrExit(mMapping == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(logFile != nullptr && logSize > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mMappingSize = kLogHeaderSize + static_cast<size_t>(logSize);
+
+    mFd = open(logFile, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    VerifyOrExit(mFd >= 0, err = System::MapErrorPOSIX(errno));
+
+    VerifyOrExit(fstat(mFd, &st) == 0, err = System::MapErrorPOSIX(errno));
+    reset = (static_cast<size_t>(st.st_size) != mMappingSize);
+    if (reset)
+    {
+        // Truncating to zero first discards the previous content.
+        VerifyOrExit(ftruncate(mFd, 0) == 0, err = System::MapErrorPOSIX(errno));
+        VerifyOrExit(ftruncate(mFd, static_cast<off_t>(mMappingSize)) == 0, err = System::MapErrorPOSIX(errno));
+    }
+
+    mapping = mmap(nullptr, mMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+    VerifyOrExit(mapping != MAP_FAILED, err = System::MapErrorPOSIX(errno));
+
+    mMapping = static_cast<uint8_t *>(mapping);
+    mHeader  = reinterpret_cast<LogHeader *>(mMapping);
+
+    if (!reset)
+    {
+        reset = (mHeader->mMagic != kLogMagic || mHeader->mVersion != kLogVersion || mHeader->mHeaderSize != kLogHeaderSize ||
+                 mHeader->mLogSize != logSize || mHeader->mHeadOffset >= logSize || mHeader->mDataLength > logSize);
+    }
+
+    if (reset)
+    {
+        memset(mHeader, 0, kLogHeaderSize);
+        mHeader->mMagic           = kLogMagic;
+        mHeader->mVersion         = kLogVersion;
+        mHeader->mHeaderSize      = kLogHeaderSize;
+        mHeader->mLogSize         = logSize;
+        mHeader->mNextEventNumber = 1;
+    }
+
+    // Index entries are at least kIndexGranularity bytes apart.
+    mIndexCapacity = logSize / kIndexGranularity + 2;
+    mIndex         = static_cast<IndexEntry *>(chip::Platform::MemoryCalloc(mIndexCapacity, sizeof(IndexEntry)));
+    VerifyOrExit(mIndex != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    ResetBuffer(mHeader->mHeadOffset, mHeader->mDataLength);
+    Recover();
+
+exit:
+    lock.unlock();
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to open event log %s: %s", logFile, ErrorStr(err));
+        Shutdown();
+    }
+
+    return err;
+}
+
+/**
+ * Writes the log back to its file and closes it.
+ */
+void ChipLinuxEventStore::Shutdown()
+{
+    std::unique_lock<std::shared_timed_mutex> lock(mLock);
+
+    if (mMapping != nullptr)
+    {
+        msync(mMapping, mMappingSize, MS_SYNC);
+        munmap(mMapping, mMappingSize);
+        mMapping = nullptr;
+        mHeader  = nullptr;
+    }
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+
+    if (mIndex != nullptr)
+    {
+        chip::Platform::MemoryFree(mIndex);
+        mIndex = nullptr;
+    }
+
+    mIndexCapacity = 0;
+    mIndexHead     = 0;
+    mIndexCount    = 0;
+    mBuffer        = CHIPCircularTLVBuffer(nullptr, 0);
+}
+
+/**
+ * Appends an event to the log, evicting the oldest events as needed.
+ *
+ * The event is stored as an anonymous structure holding the event number,
+ * the timestamp and the fields written by @p writeEvent.
+ *
+ * @param[in]  timestamp        Timestamp of the event.  Timestamps must not decrease from one event to the next.
+ * @param[in]  writeEvent       Function writing the fields of the event.
+ * @param[in]  appData          Context passed to @p writeEvent.
+ * @param[out] outEventNumber   Number assigned to the event.
+ *
+ * @retval #CHIP_ERROR_INVALID_ARGUMENT If @p timestamp is older than the timestamp of the previous event.
+ * @retval other                        If the event could not be written.  The log is left without it, but the
+ *                                      events evicted to make room for it are lost.  In particular, an event larger
+ *                                      than the log evicts every other event.
+ */
+CHIP_ERROR ChipLinuxEventStore::AppendEvent(uint64_t timestamp, EventWriterFunct writeEvent, void * appData,
+                                            uint64_t & outEventNumber)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CircularTLVWriter writer;
+    TLVType container;
+    uint64_t eventNumber;
+    uint32_t offset;
+    uint32_t headOffset;
+    uint32_t dataLength;
+    std::unique_lock<std::shared_timed_mutex> lock(mLock);
+
+    VerifyOrExit(mMapping != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    eventNumber = mHeader->mNextEventNumber;
+    offset      = TailOffset();
+    headOffset  = HeadOffset();
+    dataLength  = mBuffer.DataLength();
+
+    VerifyOrExit(timestamp >= mHeader->mLastTimestamp, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    writer.Init(&mBuffer);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, container);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(kTag_EventNumber), eventNumber);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(kTag_Timestamp), timestamp);
+    SuccessOrExit(err);
+
+    err = writeEvent(writer, appData);
+    SuccessOrExit(err);
+
+    err = writer.EndContainer(container);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    AddIndexEntry(eventNumber, timestamp, offset);
+
+    mHeader->mNextEventNumber = eventNumber + 1;
+    mHeader->mLastTimestamp   = timestamp;
+    mHeader->mHeadOffset      = HeadOffset();
+    mHeader->mDataLength      = mBuffer.DataLength();
+
+    outEventNumber = eventNumber;
+
+exit:
+    if (err != CHIP_NO_ERROR && mMapping != nullptr)
+    {
+        // Drop what was written of the event.  If older events were evicted
+        // to make room for it, the log now ends where it used to.
+        if (HeadOffset() != headOffset)
+        {
+            dataLength = (offset + mBuffer.GetQueueSize() - HeadOffset()) % mBuffer.GetQueueSize();
+        }
+
+        ResetBuffer(HeadOffset(), dataLength);
+        mHeader->mHeadOffset = HeadOffset();
+        mHeader->mDataLength = dataLength;
+    }
+
+    return err;
+}
+
+/**
+ * Copies events, oldest first, into @p outWriter.
+ *
+ * Copying starts at event @p ioEventNumber, or at the oldest event of the log
+ * if that event has been evicted already, and stops when @p outWriter is
+ * full.  Only whole events are copied.
+ *
+ * @param[in]     outWriter       Writer the events are copied to, as anonymous structures.
+ * @param[in,out] ioEventNumber   Number of the first event to copy.  On return, number of the first event not copied.
+ *
+ * @retval #CHIP_END_OF_TLV                 All events up to the newest one were copied.
+ * @retval #CHIP_ERROR_BUFFER_TOO_SMALL     @p outWriter is full; fetch the remaining events from @p ioEventNumber.
+ * @retval other                            Another error occurred.
+ */
+CHIP_ERROR ChipLinuxEventStore::FetchEventsSince(TLVWriter & outWriter, uint64_t & ioEventNumber)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CHIPCircularTLVBuffer view(nullptr, 0);
+    CircularTLVReader reader;
+    TLVWriter checkpoint;
+    uint64_t eventNumber;
+    uint64_t timestamp;
+    uint32_t entry;
+    std::shared_lock<std::shared_timed_mutex> lock(mLock);
+
+    VerifyOrExit(mMapping != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(ioEventNumber < mHeader->mNextEventNumber && mBuffer.DataLength() > 0, err = CHIP_END_OF_TLV);
+
+    entry = FindIndexEntry(ioEventNumber, false);
+    SeekEvent((entry < mIndexCount) ? IndexAt(entry).mOffset : HeadOffset(), view, reader);
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        err = ReadEventHeader(reader, eventNumber, timestamp);
+        SuccessOrExit(err);
+
+        if (eventNumber < ioEventNumber)
+            continue;
+
+        checkpoint = outWriter;
+
+        err = outWriter.CopyElement(AnonymousTag, reader);
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY)
+        {
+            outWriter = checkpoint;
+            err       = CHIP_ERROR_BUFFER_TOO_SMALL;
+        }
+        SuccessOrExit(err);
+
+        ioEventNumber = eventNumber + 1;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Finds the oldest event whose timestamp is not older than @p timestamp.
+ *
+ * @param[in]  timestamp        Timestamp to look for.
+ * @param[out] outEventNumber   Number of the event found, or GetNextEventNumber() if all events are older.
+ */
+CHIP_ERROR ChipLinuxEventStore::FindEventByTimestamp(uint64_t timestamp, uint64_t & outEventNumber)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CHIPCircularTLVBuffer view(nullptr, 0);
+    CircularTLVReader reader;
+    uint64_t eventNumber;
+    uint64_t eventTimestamp;
+    uint32_t entry;
+    std::shared_lock<std::shared_timed_mutex> lock(mLock);
+
+    VerifyOrExit(mMapping != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    outEventNumber = mHeader->mNextEventNumber;
+    VerifyOrExit(mBuffer.DataLength() > 0, err = CHIP_NO_ERROR);
+
+    entry = FindIndexEntry(timestamp, true);
+    SeekEvent((entry < mIndexCount) ? IndexAt(entry).mOffset : HeadOffset(), view, reader);
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        err = ReadEventHeader(reader, eventNumber, eventTimestamp);
+        SuccessOrExit(err);
+
+        if (eventTimestamp >= timestamp)
+        {
+            outEventNumber = eventNumber;
+            ExitNow();
+        }
+    }
+
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Writes the log back to its file, and waits for the write to complete.
+ */
+CHIP_ERROR ChipLinuxEventStore::Flush()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    std::shared_lock<std::shared_timed_mutex> lock(mLock);
+
+    VerifyOrExit(mMapping != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(msync(mMapping, mMappingSize, MS_SYNC) == 0, err = System::MapErrorPOSIX(errno));
+
+exit:
+    return err;
+}
+
+/**
+ * Returns the number of the oldest event in the log, or GetNextEventNumber() if the log is empty.
+ */
+uint64_t ChipLinuxEventStore::GetFirstEventNumber()
+{
+    CHIPCircularTLVBuffer view(nullptr, 0);
+    CircularTLVReader reader;
+    uint64_t eventNumber = 0;
+    uint64_t timestamp;
+    std::shared_lock<std::shared_timed_mutex> lock(mLock);
+
+    if (mMapping != nullptr)
+    {
+        eventNumber = mHeader->mNextEventNumber;
+
+        if (mBuffer.DataLength() > 0)
+        {
+            SeekEvent(HeadOffset(), view, reader);
+            if (reader.Next() != CHIP_NO_ERROR || ReadEventHeader(reader, eventNumber, timestamp) != CHIP_NO_ERROR)
+            {
+                eventNumber = mHeader->mNextEventNumber;
+            }
+        }
+    }
+
+    return eventNumber;
+}
+
+/**
+ * Returns the number the next appended event will get.
+ */
+uint64_t ChipLinuxEventStore::GetNextEventNumber()
+{
+    std::shared_lock<std::shared_timed_mutex> lock(mLock);
+
+    return (mMapping != nullptr) ? mHeader->mNextEventNumber : 0;
+}
+
+void ChipLinuxEventStore::ResetBuffer(uint32_t headOffset, uint32_t dataLength)
+{
+    uint8_t * queue = mMapping + kLogHeaderSize;
+
+    mBuffer                        = CHIPCircularTLVBuffer(queue, mHeader->mLogSize, queue + headOffset, dataLength);
+    mBuffer.mProcessEvictedElement = ProcessEvictedEvent;
+    mBuffer.mAppData               = this;
+}
+
+/**
+ * Rebuilds the index from the events in the log, and drops whatever follows
+ * the last valid event, e.g. an event that was being written when the
+ * process stopped.
+ */
+void ChipLinuxEventStore::Recover()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CHIPCircularTLVBuffer view(nullptr, 0);
+    CircularTLVReader reader;
+    uint64_t eventNumber;
+    uint64_t timestamp;
+    const uint32_t headOffset = HeadOffset();
+    const uint32_t logSize    = mBuffer.GetQueueSize();
+    uint32_t validLength      = 0;
+
+    mIndexHead  = 0;
+    mIndexCount = 0;
+
+    SeekEvent(headOffset, view, reader);
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        err = ReadEventHeader(reader, eventNumber, timestamp);
+        SuccessOrExit(err);
+
+        err = reader.Skip();
+        SuccessOrExit(err);
+
+        AddIndexEntry(eventNumber, timestamp, (headOffset + validLength) % logSize);
+        validLength = reader.GetLengthRead();
+
+        if (eventNumber >= mHeader->mNextEventNumber)
+        {
+            mHeader->mNextEventNumber = eventNumber + 1;
+        }
+        if (timestamp > mHeader->mLastTimestamp)
+        {
+            mHeader->mLastTimestamp = timestamp;
+        }
+    }
+
+exit:
+    if (validLength != mBuffer.DataLength())
+    {
+        ChipLogProgress(DeviceLayer, "Event log: dropping %" PRIu32 " bytes after the last valid event: %s",
+                        mBuffer.DataLength() - validLength, ErrorStr(err));
+
+        ResetBuffer(headOffset, validLength);
+        mHeader->mDataLength = validLength;
+    }
+}
+
+/**
+ * Initializes @p reader to read the events of the log from @p offset, which
+ * must be the position of an event.  @p view must outlive @p reader.
+ */
+void ChipLinuxEventStore::SeekEvent(uint32_t offset, CHIPCircularTLVBuffer & view, CircularTLVReader & reader) const
+{
+    uint8_t * queue        = mBuffer.GetQueue();
+    const uint32_t logSize = mBuffer.GetQueueSize();
+    const uint32_t skipped = (offset + logSize - HeadOffset()) % logSize;
+
+    view = CHIPCircularTLVBuffer(queue, logSize, queue + offset, mBuffer.DataLength() - skipped);
+    reader.Init(&view);
+}
+
+/**
+ * Returns the position in the index of the newest entry that is before @p key,
+ * i.e. whose event number is not larger than @p key, or whose timestamp is
+ * strictly older than @p key if @p byTimestamp is set.  Returns mIndexCount if
+ * there is no such entry.
+ */
+uint32_t ChipLinuxEventStore::FindIndexEntry(uint64_t key, bool byTimestamp) const
+{
+    uint32_t low  = 0;
+    uint32_t high = mIndexCount;
+
+    while (low < high)
+    {
+        const uint32_t mid      = low + (high - low) / 2;
+        const IndexEntry & item = IndexAt(mid);
+        const bool before       = byTimestamp ? (item.mTimestamp < key) : (item.mEventNumber <= key);
+
+        if (before)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return (low == 0) ? mIndexCount : low - 1;
+}
+
+void ChipLinuxEventStore::AddIndexEntry(uint64_t eventNumber, uint64_t timestamp, uint32_t offset)
+{
+    IndexEntry * item;
+
+    if (mIndexCount > 0)
+    {
+        const uint32_t logSize = mBuffer.GetQueueSize();
+        const uint32_t last    = IndexAt(mIndexCount - 1).mOffset;
+
+        if ((offset + logSize - last) % logSize < kIndexGranularity)
+            return;
+    }
+
+    if (mIndexCount == mIndexCapacity)
+    {
+        mIndexHead = (mIndexHead + 1) % mIndexCapacity;
+        mIndexCount--;
+    }
+
+    item               = &mIndex[(mIndexHead + mIndexCount) % mIndexCapacity];
+    item->mEventNumber = eventNumber;
+    item->mTimestamp   = timestamp;
+    item->mOffset      = offset;
+    mIndexCount++;
+}
+
+CHIP_ERROR ChipLinuxEventStore::ReadEventHeader(const TLVReader & reader, uint64_t & eventNumber, uint64_t & timestamp)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVReader event;
+    TLVType container;
+
+    event.Init(reader);
+    VerifyOrExit(event.GetType() == kTLVType_Structure, err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    err = event.EnterContainer(container);
+    SuccessOrExit(err);
+
+    err = event.Next(kTLVType_UnsignedInteger, ContextTag(kTag_EventNumber));
+    SuccessOrExit(err);
+
+    err = event.Get(eventNumber);
+    SuccessOrExit(err);
+
+    err = event.Next(kTLVType_UnsignedInteger, ContextTag(kTag_Timestamp));
+    SuccessOrExit(err);
+
+    err = event.Get(timestamp);
+
+exit:
+    return err;
+}
+
+/**
+ * Called by the circular buffer before it evicts the oldest event.  Moves the
+ * persisted head past the event before it gets overwritten, and drops the
+ * event from the index.
+ */
+CHIP_ERROR ChipLinuxEventStore::ProcessEvictedEvent(CHIPCircularTLVBuffer & buffer, void * appData, TLVReader & reader)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    ChipLinuxEventStore * store = static_cast<ChipLinuxEventStore *>(appData);
+    const uint32_t headOffset   = static_cast<uint32_t>(buffer.QueueHead() - buffer.GetQueue()) % buffer.GetQueueSize();
+    uint32_t evictedLength;
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = reader.Skip();
+    SuccessOrExit(err);
+
+    evictedLength = reader.GetLengthRead();
+
+    if (store->mIndexCount > 0 && store->IndexAt(0).mOffset == headOffset)
+    {
+        store->mIndexHead = (store->mIndexHead + 1) % store->mIndexCapacity;
+        store->mIndexCount--;
+    }
+
+    store->mHeader->mHeadOffset = (headOffset + evictedLength) % buffer.GetQueueSize();
+    store->mHeader->mDataLength = buffer.DataLength() - evictedLength;
+
+exit:
+    return err;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a persistent event log for POSIX platforms.
+ *
+ *         Events are stored as top-level TLV structures in a
+ *         CHIPCircularTLVBuffer whose backing store is a memory-mapped
+ *         file, so the log survives restarts.  The oldest events are
+ *         evicted as new ones are appended.
+ *
+ *         A sparse in-memory index, rebuilt when the log is opened, maps
+ *         event numbers and timestamps to positions in the log, so that
+ *         fetching from a given event takes a binary search followed by a
+ *         scan of at most kIndexGranularity bytes.
+ *
+ *         Appending takes the store lock exclusively; fetching takes it
+ *         shared, so any number of readers may fetch concurrently with
+ *         each other and in between appends from the event loop.
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPCircularTLVBuffer.h>
+#include <core/CHIPTLV.h>
+
+#include <mutex>
+#include <shared_mutex>
+
+#ifndef LOCALSTATEDIR
+#define LOCALSTATEDIR "/tmp"
+#endif
+
+#define CHIP_DEFAULT_EVENT_LOG_PATH                                                                                                \
+    LOCALSTATEDIR "/"                                                                                                              \
+                  "chip_events.log"
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxEventStore
+{
+public:
+    /**
+     * Context tags of the fields every stored event structure starts with.  The fields written by the
+     * EventWriterFunct follow them and must use other tags.
+     */
+    enum
+    {
+        kTag_EventNumber = 0,
+        kTag_Timestamp   = 1,
+    };
+
+    /**
+     * Minimum distance, in bytes, between two events of the index.
+     */
+    static constexpr uint32_t kIndexGranularity = 4096;
+
+    /**
+     * Writes the fields of an event into @p writer, which is positioned inside the event structure.
+     */
+    typedef CHIP_ERROR (*EventWriterFunct)(TLV::TLVWriter & writer, void * appData);
+
+    ChipLinuxEventStore();
+    ~ChipLinuxEventStore();
+
+    CHIP_ERROR Init(const char * logFile, uint32_t logSize);
+    void Shutdown();
+
+    CHIP_ERROR AppendEvent(uint64_t timestamp, EventWriterFunct writeEvent, void * appData, uint64_t & outEventNumber);
+    CHIP_ERROR FetchEventsSince(TLV::TLVWriter & outWriter, uint64_t & ioEventNumber);
+    CHIP_ERROR FindEventByTimestamp(uint64_t timestamp, uint64_t & outEventNumber);
+    CHIP_ERROR Flush();
+
+    uint64_t GetFirstEventNumber();
+    uint64_t GetNextEventNumber();
+
+private:
+    struct LogHeader;
+
+    struct IndexEntry
+    {
+        uint64_t mEventNumber;
+        uint64_t mTimestamp;
+        uint32_t mOffset;
+    };
+
+    // The head may point at the end of the storage once the last event before the wraparound is evicted.
+    uint32_t HeadOffset() const { return static_cast<uint32_t>(mBuffer.QueueHead() - mBuffer.GetQueue()) % mBuffer.GetQueueSize(); }
+    uint32_t TailOffset() const { return static_cast<uint32_t>(mBuffer.QueueTail() - mBuffer.GetQueue()); }
+
+    void ResetBuffer(uint32_t headOffset, uint32_t dataLength);
+    void Recover();
+    void SeekEvent(uint32_t offset, TLV::CHIPCircularTLVBuffer & view, TLV::CircularTLVReader & reader) const;
+    uint32_t FindIndexEntry(uint64_t key, bool byTimestamp) const;
+    void AddIndexEntry(uint64_t eventNumber, uint64_t timestamp, uint32_t offset);
+    const IndexEntry & IndexAt(uint32_t i) const { return mIndex[(mIndexHead + i) % mIndexCapacity]; }
+
+    static CHIP_ERROR ReadEventHeader(const TLV::TLVReader & reader, uint64_t & eventNumber, uint64_t & timestamp);
+    static CHIP_ERROR ProcessEvictedEvent(TLV::CHIPCircularTLVBuffer & buffer, void * appData, TLV::TLVReader & reader);
+
+    std::shared_timed_mutex mLock;
+    int mFd;
+    uint8_t * mMapping;
+    size_t mMappingSize;
+    LogHeader * mHeader;
+    TLV::CHIPCircularTLVBuffer mBuffer;
+
+    IndexEntry * mIndex;
+    uint32_t mIndexCapacity;
+    uint32_t mIndexHead;
+    uint32_t mIndexCount;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
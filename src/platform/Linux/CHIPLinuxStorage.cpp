@@ -44,7 +44,8 @@ namespace Internal {
 
 ChipLinuxStorage::ChipLinuxStorage()
 {
-    mDirty = false;
+    mDirty  = false;
+    mUseLog = false;
 }
 
 ChipLinuxStorage::~ChipLinuxStorage() {}
@@ -79,6 +80,63 @@ CHIP_ERROR ChipLinuxStorage::Init(const char * configFile)
     return retval;
 }
 
+/**
+ * Initializes the storage as an append-only log stored in @p logFile (see ChipLinuxStorageLog).
+ *
+ * If the log holds nothing yet and @p legacyConfigFile exists, the values
+ * of that INI file are imported into the log, and the INI file is removed.
+ */
+CHIP_ERROR ChipLinuxStorage::InitLog(const char * logFile, const char * legacyConfigFile)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    mUseLog = true;
+    mConfigPath.assign(logFile);
+    retval = mLogStore.Open(logFile, CHIP_DEVICE_CONFIG_STORAGE_LOG_SYNC_INTERVAL);
+
+    if (retval == CHIP_NO_ERROR && mLogStore.IsEmpty() && legacyConfigFile != nullptr && access(legacyConfigFile, F_OK) == 0)
+    {
+        std::map<std::string, std::string> section;
+
+        ChipLogProgress(DeviceLayer, "Importing settings from %s into %s", legacyConfigFile, logFile);
+
+        retval = ChipLinuxStorageIni::Init();
+
+        if (retval == CHIP_NO_ERROR)
+        {
+            retval = ChipLinuxStorageIni::AddConfig(legacyConfigFile);
+        }
+
+        // Binary values stay encoded in base64, which ReadValueBin() decodes.
+        if (retval == CHIP_NO_ERROR && ChipLinuxStorageIni::GetDefaultSection(section) == CHIP_NO_ERROR)
+        {
+            for (const auto & entry : section)
+            {
+                mLogStore.AddEntry(entry.first.c_str(), entry.second.c_str());
+            }
+        }
+
+        ChipLinuxStorageIni::RemoveAll();
+
+        if (retval == CHIP_NO_ERROR)
+        {
+            retval = mLogStore.Commit();
+        }
+
+        if (retval == CHIP_NO_ERROR)
+        {
+            retval = mLogStore.Sync();
+        }
+
+        if (retval == CHIP_NO_ERROR)
+        {
+            unlink(legacyConfigFile);
+        }
+    }
+
+    return retval;
+}
+
 CHIP_ERROR ChipLinuxStorage::ReadValue(const char * key, bool & val)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -86,7 +144,7 @@ CHIP_ERROR ChipLinuxStorage::ReadValue(const char * key, bool & val)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::GetUIntValue(key, result);
+    retval = mUseLog ? mLogStore.GetUIntValue(key, result) : ChipLinuxStorageIni::GetUIntValue(key, result);
     val    = (result != 0);
 
     mLock.unlock();
@@ -100,7 +158,7 @@ CHIP_ERROR ChipLinuxStorage::ReadValue(const char * key, uint32_t & val)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::GetUIntValue(key, val);
+    retval = mUseLog ? mLogStore.GetUIntValue(key, val) : ChipLinuxStorageIni::GetUIntValue(key, val);
 
     mLock.unlock();
 
@@ -113,7 +171,7 @@ CHIP_ERROR ChipLinuxStorage::ReadValue(const char * key, uint64_t & val)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::GetUInt64Value(key, val);
+    retval = mUseLog ? mLogStore.GetUInt64Value(key, val) : ChipLinuxStorageIni::GetUInt64Value(key, val);
 
     mLock.unlock();
 
@@ -126,7 +184,8 @@ CHIP_ERROR ChipLinuxStorage::ReadValueStr(const char * key, char * buf, size_t b
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::GetStringValue(key, buf, bufSize, outLen);
+    retval = mUseLog ? mLogStore.GetStringValue(key, buf, bufSize, outLen)
+                     : ChipLinuxStorageIni::GetStringValue(key, buf, bufSize, outLen);
 
     mLock.unlock();
 
@@ -139,7 +198,8 @@ CHIP_ERROR ChipLinuxStorage::ReadValueBin(const char * key, uint8_t * buf, size_
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::GetBinaryBlobValue(key, buf, bufSize, outLen);
+    retval = mUseLog ? mLogStore.GetBinaryBlobValue(key, buf, bufSize, outLen)
+                     : ChipLinuxStorageIni::GetBinaryBlobValue(key, buf, bufSize, outLen);
 
     mLock.unlock();
 
@@ -166,7 +226,7 @@ CHIP_ERROR ChipLinuxStorage::WriteValue(const char * key, uint32_t val)
 {
     char buf[32];
 
-    snprintf(buf, sizeof(buf), "%d", val);
+    snprintf(buf, sizeof(buf), "%" PRIu32, val);
 
     return WriteValueStr(key, buf);
 }
@@ -186,7 +246,7 @@ CHIP_ERROR ChipLinuxStorage::WriteValueStr(const char * key, const char * val)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::AddEntry(key, val);
+    retval = mUseLog ? mLogStore.AddEntry(key, val) : ChipLinuxStorageIni::AddEntry(key, val);
 
     mDirty = true;
 
@@ -210,6 +270,20 @@ CHIP_ERROR ChipLinuxStorage::WriteValueBin(const char * key, const uint8_t * dat
         retval = CHIP_ERROR_INVALID_ARGUMENT;
     }
 
+    // The log stores binary values as they are
+    if (retval == CHIP_NO_ERROR && mUseLog)
+    {
+        mLock.lock();
+
+        retval = mLogStore.AddBinaryEntry(key, data, dataLen);
+
+        mDirty = true;
+
+        mLock.unlock();
+
+        return retval;
+    }
+
     // Compute our expectedEncodedLen
     // Allocate just enough space for the encoded data, and the NULL terminator
     if (retval == CHIP_NO_ERROR)
@@ -244,7 +318,7 @@ CHIP_ERROR ChipLinuxStorage::ClearValue(const char * key)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::RemoveEntry(key);
+    retval = mUseLog ? mLogStore.RemoveEntry(key) : ChipLinuxStorageIni::RemoveEntry(key);
 
     if (retval == CHIP_NO_ERROR)
     {
@@ -266,7 +340,7 @@ CHIP_ERROR ChipLinuxStorage::ClearAll()
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::RemoveAll();
+    retval = mUseLog ? mLogStore.RemoveAll() : ChipLinuxStorageIni::RemoveAll();
 
     mLock.unlock();
 
@@ -289,7 +363,7 @@ bool ChipLinuxStorage::HasValue(const char * key)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::HasValue(key);
+    retval = mUseLog ? mLogStore.HasValue(key) : ChipLinuxStorageIni::HasValue(key);
 
     mLock.unlock();
 
@@ -304,7 +378,7 @@ CHIP_ERROR ChipLinuxStorage::Commit()
     {
         mLock.lock();
 
-        retval = ChipLinuxStorageIni::CommitConfig(mConfigPath);
+        retval = mUseLog ? mLogStore.Commit() : ChipLinuxStorageIni::CommitConfig(mConfigPath);
 
         mLock.unlock();
     }
@@ -27,7 +27,8 @@
  *
  *         The ephemeral partition should be erased during factory reset.
  *
- *         ChipLinuxStorage wraps the storage class ChipLinuxStorageIni with mutex.
+ *         ChipLinuxStorage wraps the storage class ChipLinuxStorageIni with mutex,
+ *         or ChipLinuxStorageLog when initialized with InitLog().
  *
  */
 
@@ -35,6 +36,7 @@
 
 #include <mutex>
 #include <platform/Linux/CHIPLinuxStorageIni.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
 
 #ifndef FATCONFDIR
 #define FATCONFDIR "/tmp"
@@ -57,6 +59,12 @@
 #define CHIP_DEFAULT_DATA_PATH                                                                                                     \
     LOCALSTATEDIR "/"                                                                                                              \
                   "chip_counters.ini"
+#define CHIP_DEFAULT_CONFIG_LOG_PATH                                                                                               \
+    SYSCONFDIR "/"                                                                                                                 \
+               "chip_config.kvlog"
+#define CHIP_DEFAULT_DATA_LOG_PATH                                                                                                 \
+    LOCALSTATEDIR "/"                                                                                                              \
+                  "chip_counters.kvlog"
 
 namespace chip {
 namespace DeviceLayer {
@@ -69,6 +77,7 @@ public:
     ~ChipLinuxStorage();
 
     CHIP_ERROR Init(const char * configFile);
+    CHIP_ERROR InitLog(const char * logFile, const char * legacyConfigFile);
     CHIP_ERROR ReadValue(const char * key, bool & val);
     CHIP_ERROR ReadValue(const char * key, uint32_t & val);
     CHIP_ERROR ReadValue(const char * key, uint64_t & val);
@@ -87,7 +96,9 @@ public:
 private:
     std::mutex mLock;
     bool mDirty;
+    bool mUseLog;
     std::string mConfigPath;
+    ChipLinuxStorageLog mLogStore;
 };
 
 } // namespace Internal
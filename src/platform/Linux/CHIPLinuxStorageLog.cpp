@@ -0,0 +1,858 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides an implementation of the Configuration key-value store object
+ *          as an append-only log on Linux platform.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <core/CHIPEncoding.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+#include <support/Base64.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+// Lookup table of the reflected CRC-32 polynomial used by Ethernet and zlib.
+struct Crc32Table
+{
+    Crc32Table()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+            }
+
+            mEntries[i] = crc;
+        }
+    }
+
+    uint32_t mEntries[256];
+};
+
+uint32_t Crc32(const uint8_t * data, size_t length)
+{
+    static const Crc32Table sTable;
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = sTable.mEntries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+void Append16(std::vector<uint8_t> & buf, uint16_t val)
+{
+    uint8_t bytes[2];
+
+    Encoding::LittleEndian::Put16(bytes, val);
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+void Append32(std::vector<uint8_t> & buf, uint32_t val)
+{
+    uint8_t bytes[4];
+
+    Encoding::LittleEndian::Put32(bytes, val);
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return System::MapErrorPOSIX(errno);
+        }
+
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadAll(int fd, uint8_t * data, size_t length)
+{
+    off_t offset = 0;
+
+    while (length > 0)
+    {
+        ssize_t got = pread(fd, data, length, offset);
+
+        if (got < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return System::MapErrorPOSIX(errno);
+        }
+        if (got == 0)
+        {
+            return CHIP_ERROR_READ_FAILED;
+        }
+
+        data += got;
+        offset += got;
+        length -= static_cast<size_t>(got);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+// Makes the creation or renaming of a file in the directory of @p path durable.
+CHIP_ERROR SyncDirectory(const std::string & path)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t slash   = path.find_last_of('/');
+    std::string dir;
+    int fd;
+
+    if (slash == std::string::npos)
+    {
+        dir = ".";
+    }
+    else
+    {
+        dir = path.substr(0, slash == 0 ? 1 : slash);
+    }
+
+    fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    VerifyOrExit(fd >= 0, err = System::MapErrorPOSIX(errno));
+    VerifyOrExit(fsync(fd) == 0, err = System::MapErrorPOSIX(errno));
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return err;
+}
+
+} // namespace
+
+constexpr uint32_t ChipLinuxStorageLog::kMagic;
+constexpr uint32_t ChipLinuxStorageLog::kVersion;
+constexpr size_t ChipLinuxStorageLog::kCompactionMinSize;
+constexpr size_t ChipLinuxStorageLog::kHeaderSize;
+constexpr size_t ChipLinuxStorageLog::kFrameHeaderSize;
+
+ChipLinuxStorageLog::ChipLinuxStorageLog()
+{
+    mFd                = -1;
+    mLogSize           = 0;
+    mLiveSize          = 0;
+    mSyncInterval      = 0;
+    mLastSync          = 0;
+    mUnsynced          = false;
+    mCleared           = false;
+    mCommittedLiveSize = 0;
+}
+
+ChipLinuxStorageLog::~ChipLinuxStorageLog()
+{
+    Close();
+}
+
+/**
+ * Opens the log stored in @p logFile, creating it if needed, and replays its frames.
+ *
+ * Replay stops at the first frame that is truncated, fails its checksum or
+ * cannot be decoded; the file is truncated there so that new frames are
+ * appended after the last valid one.
+ */
+CHIP_ERROR ChipLinuxStorageLog::Open(const char * logFile, uint32_t syncInterval)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    struct stat st;
+    std::vector<uint8_t> contents;
+    size_t offset;
+
+    VerifyOrExit(mFd < 0, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(logFile != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mPath.assign(logFile);
+    mSyncInterval = syncInterval;
+    mLastSync     = System::Platform::Layer::GetClock_MonotonicMS();
+
+    mFd = open(logFile, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    VerifyOrExit(mFd >= 0, err = System::MapErrorPOSIX(errno));
+    VerifyOrExit(fstat(mFd, &st) == 0, err = System::MapErrorPOSIX(errno));
+
+    // A new log, or one whose creation did not complete.
+    if (static_cast<size_t>(st.st_size) < kHeaderSize)
+    {
+        uint8_t header[kHeaderSize];
+
+        Encoding::LittleEndian::Put32(header, kMagic);
+        Encoding::LittleEndian::Put32(header + 4, kVersion);
+
+        VerifyOrExit(ftruncate(mFd, 0) == 0, err = System::MapErrorPOSIX(errno));
+        err = WriteAll(mFd, header, sizeof(header));
+        SuccessOrExit(err);
+        VerifyOrExit(fdatasync(mFd) == 0, err = System::MapErrorPOSIX(errno));
+        err = SyncDirectory(mPath);
+        SuccessOrExit(err);
+
+        mLogSize = kHeaderSize;
+        ExitNow();
+    }
+
+    contents.resize(static_cast<size_t>(st.st_size));
+    err = ReadAll(mFd, contents.data(), contents.size());
+    SuccessOrExit(err);
+
+    VerifyOrExit(Encoding::LittleEndian::Get32(contents.data()) == kMagic, err = CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+    VerifyOrExit(Encoding::LittleEndian::Get32(contents.data() + 4) == kVersion, err = CHIP_ERROR_VERSION_MISMATCH);
+
+    offset = kHeaderSize;
+    while (contents.size() - offset >= kFrameHeaderSize)
+    {
+        const uint8_t * frame = contents.data() + offset;
+        uint32_t crc          = Encoding::LittleEndian::Get32(frame);
+        uint32_t length       = Encoding::LittleEndian::Get32(frame + 4);
+        const uint8_t * ops   = frame + kFrameHeaderSize;
+
+        if (length > contents.size() - offset - kFrameHeaderSize || Crc32(ops, length) != crc || !ApplyFrame(ops, length, false))
+        {
+            break;
+        }
+
+        ApplyFrame(ops, length, true);
+        offset += kFrameHeaderSize + length;
+    }
+
+    if (offset < contents.size())
+    {
+        ChipLogError(DeviceLayer, "Discarding %u bytes of incomplete or corrupted changes at the end of %s",
+                     static_cast<unsigned>(contents.size() - offset), logFile);
+
+        VerifyOrExit(ftruncate(mFd, static_cast<off_t>(offset)) == 0, err = System::MapErrorPOSIX(errno));
+        VerifyOrExit(fdatasync(mFd) == 0, err = System::MapErrorPOSIX(errno));
+    }
+
+    mLogSize = offset;
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to open key-value log %s: %s", logFile, ErrorStr(err));
+        Close();
+    }
+    return err;
+}
+
+/**
+ * Closes the log, syncing the commits deferred by the sync interval.  Changes that were not committed are lost.
+ */
+void ChipLinuxStorageLog::Close()
+{
+    if (mFd >= 0)
+    {
+        Sync();
+        close(mFd);
+        mFd = -1;
+    }
+
+    mEntries.clear();
+    mPending.clear();
+    DropCommitted();
+    mLogSize  = 0;
+    mLiveSize = 0;
+    mUnsynced = false;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::GetEntry(const char * key, const Entry *& entry)
+{
+    auto it = mEntries.find(key);
+
+    if (it == mEntries.end())
+    {
+        return CHIP_ERROR_KEY_NOT_FOUND;
+    }
+
+    entry = &it->second;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ParseUInt(const char * key, uint64_t max, uint64_t & val)
+{
+    const Entry * entry;
+    CHIP_ERROR err = GetEntry(key, entry);
+    char buf[24];
+    char * end;
+    size_t len;
+
+    SuccessOrExit(err);
+
+    len = entry->mValue.size();
+    VerifyOrExit(entry->mType == ValueType::kString && len > 0 && len < sizeof(buf), err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    memcpy(buf, entry->mValue.data(), len);
+    buf[len] = '\0';
+    VerifyOrExit(buf[0] >= '0' && buf[0] <= '9', err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    errno = 0;
+    val   = strtoull(buf, &end, 10);
+    VerifyOrExit(errno == 0 && *end == '\0' && val <= max, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::GetUIntValue(const char * key, uint32_t & val)
+{
+    uint64_t result;
+    CHIP_ERROR err = ParseUInt(key, UINT32_MAX, result);
+
+    if (err == CHIP_NO_ERROR)
+    {
+        val = static_cast<uint32_t>(result);
+    }
+
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::GetUInt64Value(const char * key, uint64_t & val)
+{
+    return ParseUInt(key, UINT64_MAX, val);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::GetStringValue(const char * key, char * buf, size_t bufSize, size_t & outLen)
+{
+    const Entry * entry;
+    CHIP_ERROR err = GetEntry(key, entry);
+    size_t len;
+
+    SuccessOrExit(err);
+    VerifyOrExit(entry->mType == ValueType::kString, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    len = entry->mValue.size();
+    if (len > bufSize - 1)
+    {
+        outLen = len;
+        ExitNow(err = CHIP_ERROR_BUFFER_TOO_SMALL);
+    }
+
+    memcpy(buf, entry->mValue.data(), len);
+    buf[len] = '\0';
+    outLen   = len;
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::GetBinaryBlobValue(const char * key, uint8_t * decodedData, size_t bufSize,
+                                                   size_t & decodedDataLen)
+{
+    const Entry * entry;
+    CHIP_ERROR err = GetEntry(key, entry);
+    size_t len;
+
+    SuccessOrExit(err);
+
+    len = entry->mValue.size();
+
+    if (entry->mType == ValueType::kBinary)
+    {
+        decodedDataLen = len;
+        VerifyOrExit(len <= bufSize, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        memcpy(decodedData, entry->mValue.data(), len);
+    }
+    else
+    {
+        // A binary value imported from the INI backend, encoded in base64.
+        const char * encodedData     = reinterpret_cast<const char *>(entry->mValue.data());
+        size_t encodedDataPaddingLen = 0;
+        size_t expectedDecodedLen;
+        uint16_t decodedLen;
+
+        if (len > 0 && encodedData[len - 1] == '=')
+        {
+            encodedDataPaddingLen++;
+            if (len > 1 && encodedData[len - 2] == '=')
+                encodedDataPaddingLen++;
+        }
+
+        expectedDecodedLen = ((len - encodedDataPaddingLen) * 3) / 4;
+        if (expectedDecodedLen > bufSize)
+        {
+            decodedDataLen = expectedDecodedLen;
+            ExitNow(err = CHIP_ERROR_BUFFER_TOO_SMALL);
+        }
+        VerifyOrExit(len <= UINT16_MAX, err = CHIP_ERROR_DECODE_FAILED);
+
+        decodedLen = Base64Decode(encodedData, static_cast<uint16_t>(len), decodedData);
+        VerifyOrExit(decodedLen != UINT16_MAX && decodedLen <= expectedDecodedLen, err = CHIP_ERROR_DECODE_FAILED);
+
+        decodedDataLen = decodedLen;
+    }
+
+exit:
+    return err;
+}
+
+bool ChipLinuxStorageLog::HasValue(const char * key)
+{
+    return mEntries.find(key) != mEntries.end();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::AddEntry(const char * key, const char * value)
+{
+    return AddValue(key, ValueType::kString, reinterpret_cast<const uint8_t *>(value), strlen(value));
+}
+
+CHIP_ERROR ChipLinuxStorageLog::AddBinaryEntry(const char * key, const uint8_t * data, size_t dataLen)
+{
+    return AddValue(key, ValueType::kBinary, data, dataLen);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::AddValue(const char * key, ValueType type, const uint8_t * value, size_t valueLen)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    std::string keyStr;
+
+    VerifyOrExit(mFd >= 0, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(key != nullptr && (value != nullptr || valueLen == 0), err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    keyStr.assign(key);
+    VerifyOrExit(keyStr.size() <= UINT16_MAX && valueLen <= UINT32_MAX, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    SaveCommitted(keyStr);
+    SetEntry(keyStr, type, value, valueLen);
+    EncodeSetOp(mPending, keyStr, mEntries[keyStr]);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::RemoveEntry(const char * key)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    std::string keyStr;
+
+    VerifyOrExit(mFd >= 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    keyStr.assign(key);
+    VerifyOrExit(mEntries.find(keyStr) != mEntries.end(), err = CHIP_ERROR_KEY_NOT_FOUND);
+
+    SaveCommitted(keyStr);
+    EraseEntry(keyStr);
+
+    mPending.push_back(static_cast<uint8_t>(Op::kRemove));
+    Append16(mPending, static_cast<uint16_t>(keyStr.size()));
+    mPending.insert(mPending.end(), keyStr.begin(), keyStr.end());
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::RemoveAll()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mFd >= 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    SaveAllCommitted();
+    EraseAll();
+
+    // The earlier pending changes are superseded.
+    mPending.clear();
+    mPending.push_back(static_cast<uint8_t>(Op::kClear));
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Commit()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mFd >= 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    if (!mPending.empty())
+    {
+        err = WriteFrame(mFd, mPending);
+        if (err != CHIP_NO_ERROR)
+        {
+            // Drop what may have been written of the frame, so that later frames are not appended behind it.
+            if (ftruncate(mFd, static_cast<off_t>(mLogSize)) != 0)
+            {
+                ChipLogError(DeviceLayer, "Failed to truncate key-value log %s", mPath.c_str());
+            }
+            RestoreCommitted();
+            ExitNow();
+        }
+
+        mLogSize += kFrameHeaderSize + mPending.size();
+        mUnsynced = true;
+        mPending.clear();
+        DropCommitted();
+    }
+
+    // A failed compaction leaves the log as it was, so the commit still stands.
+    if (mLogSize > kCompactionMinSize && mLogSize > 2 * (kHeaderSize + kFrameHeaderSize + mLiveSize) && Compact() == CHIP_NO_ERROR)
+    {
+        ExitNow();
+    }
+
+    if (mUnsynced && System::Platform::Layer::GetClock_MonotonicMS() - mLastSync >= mSyncInterval)
+    {
+        err = Sync();
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Sync()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mFd >= 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    if (mUnsynced)
+    {
+        VerifyOrExit(fdatasync(mFd) == 0, err = System::MapErrorPOSIX(errno));
+
+        mUnsynced = false;
+        mLastSync = System::Platform::Layer::GetClock_MonotonicMS();
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    CHIP_ERROR err      = CHIP_NO_ERROR;
+    std::string tmpPath = mPath + ".tmp";
+    std::vector<uint8_t> ops;
+    uint8_t header[kHeaderSize];
+    int fd = -1;
+
+    VerifyOrExit(mFd >= 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    ops.reserve(mLiveSize);
+    for (const auto & entry : mEntries)
+    {
+        EncodeSetOp(ops, entry.first, entry.second);
+    }
+
+    Encoding::LittleEndian::Put32(header, kMagic);
+    Encoding::LittleEndian::Put32(header + 4, kVersion);
+
+    fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0600);
+    VerifyOrExit(fd >= 0, err = System::MapErrorPOSIX(errno));
+
+    err = WriteAll(fd, header, sizeof(header));
+    SuccessOrExit(err);
+    if (!ops.empty())
+    {
+        err = WriteFrame(fd, ops);
+        SuccessOrExit(err);
+    }
+    VerifyOrExit(fdatasync(fd) == 0, err = System::MapErrorPOSIX(errno));
+
+    VerifyOrExit(rename(tmpPath.c_str(), mPath.c_str()) == 0, err = System::MapErrorPOSIX(errno));
+    err = SyncDirectory(mPath);
+    SuccessOrExit(err);
+
+    close(mFd);
+    mFd = fd;
+    fd  = -1;
+
+    mLogSize  = kHeaderSize + (ops.empty() ? 0 : kFrameHeaderSize + ops.size());
+    mUnsynced = false;
+    mLastSync = System::Platform::Layer::GetClock_MonotonicMS();
+    mPending.clear();
+    DropCommitted();
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+        unlink(tmpPath.c_str());
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to compact key-value log %s: %s", mPath.c_str(), ErrorStr(err));
+    }
+    return err;
+}
+
+void ChipLinuxStorageLog::SetEntry(const std::string & key, ValueType type, const uint8_t * value, size_t valueLen)
+{
+    auto it = mEntries.find(key);
+
+    if (it != mEntries.end())
+    {
+        mLiveSize -= SetOpSize(it->first, it->second);
+    }
+    else
+    {
+        it = mEntries.emplace(key, Entry()).first;
+    }
+
+    it->second.mType = type;
+    it->second.mValue.assign(value, value + valueLen);
+    mLiveSize += SetOpSize(it->first, it->second);
+}
+
+void ChipLinuxStorageLog::EraseEntry(const std::string & key)
+{
+    auto it = mEntries.find(key);
+
+    if (it != mEntries.end())
+    {
+        mLiveSize -= SetOpSize(it->first, it->second);
+        mEntries.erase(it);
+    }
+}
+
+void ChipLinuxStorageLog::EraseAll()
+{
+    mEntries.clear();
+    mLiveSize = 0;
+}
+
+/**
+ * Saves the committed value of @p key, before the first change to it since the last commit.
+ */
+void ChipLinuxStorageLog::SaveCommitted(const std::string & key)
+{
+    if (mPending.empty())
+    {
+        mCommittedLiveSize = mLiveSize;
+    }
+
+    if (mCleared || mCommittedEntries.find(key) != mCommittedEntries.end())
+    {
+        return;
+    }
+
+    auto it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        mCommittedEntries.emplace(key, CommittedEntry{ true, it->second });
+    }
+    else
+    {
+        mCommittedEntries.emplace(key, CommittedEntry{ false, Entry() });
+    }
+}
+
+/**
+ * Saves all the committed entries, before RemoveAll() clears them.
+ */
+void ChipLinuxStorageLog::SaveAllCommitted()
+{
+    if (mCleared)
+    {
+        return;
+    }
+
+    // The entries as they were committed, which later changes no longer need to save.
+    if (mPending.empty())
+    {
+        mCommittedLiveSize = mLiveSize;
+    }
+    RestoreCommitted();
+    mClearedEntries.swap(mEntries);
+    mCleared = true;
+}
+
+/**
+ * Rolls the entries back to the last commit, dropping the pending changes.
+ */
+void ChipLinuxStorageLog::RestoreCommitted()
+{
+    if (mCleared)
+    {
+        mEntries.swap(mClearedEntries);
+    }
+    else
+    {
+        for (auto & committed : mCommittedEntries)
+        {
+            if (committed.second.mExists)
+            {
+                mEntries[committed.first] = std::move(committed.second.mEntry);
+            }
+            else
+            {
+                mEntries.erase(committed.first);
+            }
+        }
+    }
+
+    if (!mPending.empty())
+    {
+        mLiveSize = mCommittedLiveSize;
+    }
+    mPending.clear();
+    DropCommitted();
+}
+
+/**
+ * Forgets the saved committed entries, once the pending changes are committed or dropped.
+ */
+void ChipLinuxStorageLog::DropCommitted()
+{
+    mCommittedEntries.clear();
+    mClearedEntries.clear();
+    mCleared = false;
+}
+
+/**
+ * Checks that @p ops are well formed and, if @p apply is true, applies them.
+ */
+bool ChipLinuxStorageLog::ApplyFrame(const uint8_t * ops, size_t length, bool apply)
+{
+    const uint8_t * p   = ops;
+    const uint8_t * end = ops + length;
+
+    while (p < end)
+    {
+        Op op = static_cast<Op>(Encoding::Read8(p));
+        uint8_t type;
+        uint16_t keyLen;
+        uint32_t valueLen;
+
+        switch (op)
+        {
+        case Op::kSet:
+            if (end - p < 7)
+            {
+                return false;
+            }
+
+            type     = Encoding::Read8(p);
+            keyLen   = Encoding::LittleEndian::Read16(p);
+            valueLen = Encoding::LittleEndian::Read32(p);
+            if ((type != static_cast<uint8_t>(ValueType::kString) && type != static_cast<uint8_t>(ValueType::kBinary)) ||
+                static_cast<size_t>(end - p) < static_cast<size_t>(keyLen) + valueLen)
+            {
+                return false;
+            }
+
+            if (apply)
+            {
+                SetEntry(std::string(reinterpret_cast<const char *>(p), keyLen), static_cast<ValueType>(type), p + keyLen,
+                         valueLen);
+            }
+            p += keyLen + valueLen;
+            break;
+
+        case Op::kRemove:
+            if (end - p < 2)
+            {
+                return false;
+            }
+
+            keyLen = Encoding::LittleEndian::Read16(p);
+            if (end - p < keyLen)
+            {
+                return false;
+            }
+
+            if (apply)
+            {
+                EraseEntry(std::string(reinterpret_cast<const char *>(p), keyLen));
+            }
+            p += keyLen;
+            break;
+
+        case Op::kClear:
+            if (apply)
+            {
+                EraseAll();
+            }
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t ChipLinuxStorageLog::SetOpSize(const std::string & key, const Entry & entry)
+{
+    return 8 + key.size() + entry.mValue.size();
+}
+
+void ChipLinuxStorageLog::EncodeSetOp(std::vector<uint8_t> & ops, const std::string & key, const Entry & entry)
+{
+    ops.push_back(static_cast<uint8_t>(Op::kSet));
+    ops.push_back(static_cast<uint8_t>(entry.mType));
+    Append16(ops, static_cast<uint16_t>(key.size()));
+    Append32(ops, static_cast<uint32_t>(entry.mValue.size()));
+    ops.insert(ops.end(), key.begin(), key.end());
+    ops.insert(ops.end(), entry.mValue.begin(), entry.mValue.end());
+}
+
+CHIP_ERROR ChipLinuxStorageLog::WriteFrame(int fd, const std::vector<uint8_t> & ops)
+{
+    std::vector<uint8_t> frame;
+
+    frame.reserve(kFrameHeaderSize + ops.size());
+    Append32(frame, Crc32(ops.data(), ops.size()));
+    Append32(frame, static_cast<uint32_t>(ops.size()));
+    frame.insert(frame.end(), ops.begin(), ops.end());
+
+    // A single write, so that the frame is not interleaved with anything else.
+    return WriteAll(fd, frame.data(), frame.size());
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,185 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides an implementation of the Configuration key-value store interface
+ *          as an append-only log.
+ *
+ *          Changes are buffered until Commit(), which appends them to the log
+ *          file as a single checksummed frame, so the cost of a commit only
+ *          depends on the size of the changes.  When the log is opened, the
+ *          frames are replayed in order; a torn or corrupted frame at the
+ *          end of the log, left by a crash, is discarded along with
+ *          everything after it, so every commit is applied entirely or not
+ *          at all.
+ *
+ *          Once the log grows past both kCompactionMinSize and twice the
+ *          size of the live values, it is rewritten with only the live
+ *          values, atomically through a temporary file.
+ *
+ *          The file starts with an 8-byte header: the kMagic and kVersion
+ *          32-bit integers.  Each frame then holds a CRC-32 of the
+ *          operations, their length (4 bytes) and the operations:
+ *
+ *            Set:    op (1), value type (1), key length (2), value length (4), key, value
+ *            Remove: op (1), key length (2), key
+ *            Clear:  op (1)
+ *
+ *          All integers are little-endian.
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    static constexpr uint32_t kMagic   = 0x564b4843; // "CHKV"
+    static constexpr uint32_t kVersion = 1;
+
+    /**
+     * Size below which the log is never compacted.
+     */
+    static constexpr size_t kCompactionMinSize = 64 * 1024;
+
+    ChipLinuxStorageLog();
+    ~ChipLinuxStorageLog();
+
+    /**
+     * Opens the log at @p logFile, creating it if needed, and replays it.
+     *
+     * @param syncInterval  Minimum time, in milliseconds, between two syncs of the log to storage.  A commit
+     *                      made sooner after the previous sync is written but only synced by the next commit
+     *                      after the interval, Sync() or Close().  0 syncs every commit.
+     */
+    CHIP_ERROR Open(const char * logFile, uint32_t syncInterval);
+    void Close();
+
+    CHIP_ERROR GetUIntValue(const char * key, uint32_t & val);
+    CHIP_ERROR GetUInt64Value(const char * key, uint64_t & val);
+    CHIP_ERROR GetStringValue(const char * key, char * buf, size_t bufSize, size_t & outLen);
+    CHIP_ERROR GetBinaryBlobValue(const char * key, uint8_t * decodedData, size_t bufSize, size_t & decodedDataLen);
+    bool HasValue(const char * key);
+
+    CHIP_ERROR AddEntry(const char * key, const char * value);
+    CHIP_ERROR AddBinaryEntry(const char * key, const uint8_t * data, size_t dataLen);
+    CHIP_ERROR RemoveEntry(const char * key);
+    CHIP_ERROR RemoveAll();
+
+    /**
+     * Appends the changes made since the last commit to the log, and compacts it if needed.  If they cannot be
+     * appended, the changes are rolled back.
+     */
+    CHIP_ERROR Commit();
+
+    /**
+     * Syncs commits deferred by the sync interval to storage.
+     */
+    CHIP_ERROR Sync();
+
+    /**
+     * Rewrites the log with only the live values, including the changes not committed yet.
+     */
+    CHIP_ERROR Compact();
+
+    /**
+     * Whether the log holds no values nor any change to them.
+     */
+    bool IsEmpty() const { return mLogSize <= kHeaderSize; }
+
+    size_t GetLogSize() const { return mLogSize; }
+
+private:
+    enum class Op : uint8_t
+    {
+        kSet    = 1,
+        kRemove = 2,
+        kClear  = 3,
+    };
+
+    // Values are either strings, or binary values stored as they are.  String values written by the INI backend
+    // hold binary values in base64, which GetBinaryBlobValue() decodes.
+    enum class ValueType : uint8_t
+    {
+        kString = 1,
+        kBinary = 2,
+    };
+
+    struct Entry
+    {
+        ValueType mType;
+        std::vector<uint8_t> mValue;
+    };
+
+    // The committed value of an entry changed since the last commit, if it had one.
+    struct CommittedEntry
+    {
+        bool mExists;
+        Entry mEntry;
+    };
+
+    static constexpr size_t kHeaderSize      = 8;
+    static constexpr size_t kFrameHeaderSize = 8;
+
+    CHIP_ERROR AddValue(const char * key, ValueType type, const uint8_t * value, size_t valueLen);
+    void SetEntry(const std::string & key, ValueType type, const uint8_t * value, size_t valueLen);
+    void EraseEntry(const std::string & key);
+    void EraseAll();
+    void SaveCommitted(const std::string & key);
+    void SaveAllCommitted();
+    void RestoreCommitted();
+    void DropCommitted();
+    bool ApplyFrame(const uint8_t * ops, size_t length, bool apply);
+    CHIP_ERROR GetEntry(const char * key, const Entry *& entry);
+    CHIP_ERROR ParseUInt(const char * key, uint64_t max, uint64_t & val);
+    static size_t SetOpSize(const std::string & key, const Entry & entry);
+    static void EncodeSetOp(std::vector<uint8_t> & ops, const std::string & key, const Entry & entry);
+    static CHIP_ERROR WriteFrame(int fd, const std::vector<uint8_t> & ops);
+
+    std::map<std::string, Entry> mEntries;
+    std::vector<uint8_t> mPending;
+
+    // What the pending changes replaced, to roll them back if they cannot be committed: the entries changed
+    // since the last commit, or all the entries once RemoveAll() has cleared them.
+    std::map<std::string, CommittedEntry> mCommittedEntries;
+    std::map<std::string, Entry> mClearedEntries;
+    bool mCleared;
+    size_t mCommittedLiveSize;
+    std::string mPath;
+    int mFd;
+    size_t mLogSize;
+    size_t mLiveSize;
+    uint32_t mSyncInterval;
+    uint64_t mLastSync;
+    bool mUnsynced;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -87,8 +87,12 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT 6
 #endif // CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT
 
+#ifndef CHIP_CONFIG_RANDOM_POOL_SIZE
+#define CHIP_CONFIG_RANDOM_POOL_SIZE 256
+#endif // CHIP_CONFIG_RANDOM_POOL_SIZE
+
 #ifndef CHIP_LOG_FILTERING
-#define CHIP_LOG_FILTERING 0
+#define CHIP_LOG_FILTERING 1
 #endif // CHIP_LOG_FILTERING
 
 #ifndef CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
@@ -107,6 +107,16 @@ CHIP_ERROR ConfigurationManagerImpl::_WritePersistedStorageValue(::chip::Platfor
     return WriteConfigValue(configKey, value);
 }
 
+CHIP_ERROR ConfigurationManagerImpl::_BeginWriteBatch()
+{
+    return PosixConfig::BeginWriteBatch();
+}
+
+CHIP_ERROR ConfigurationManagerImpl::_CommitWriteBatch()
+{
+    return PosixConfig::CommitWriteBatch();
+}
+
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFI_STATION
 CHIP_ERROR ConfigurationManagerImpl::GetWiFiStationSecurityType(Profiles::NetworkProvisioning::WiFiSecurityType & secType)
 {
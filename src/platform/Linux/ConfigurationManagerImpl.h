@@ -56,6 +56,8 @@ private:
     void _InitiateFactoryReset();
     CHIP_ERROR _ReadPersistedStorageValue(::chip::Platform::PersistedStorage::Key key, uint32_t & value);
     CHIP_ERROR _WritePersistedStorageValue(::chip::Platform::PersistedStorage::Key key, uint32_t value);
+    CHIP_ERROR _BeginWriteBatch();
+    CHIP_ERROR _CommitWriteBatch();
 
     // NOTE: Other public interface methods are implemented by GenericConfigurationManagerImpl<>.
 
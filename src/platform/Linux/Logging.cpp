@@ -25,6 +25,10 @@
 #include <platform/internal/CHIPDeviceLayerInternal.h>
 #include <support/logging/CHIPLogging.h>
 
+#if CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+#include <platform/Linux/CHIPLinuxAsyncLog.h>
+#endif
+
 #include <assert.h>
 #include <stdarg.h>
 #include <syslog.h>
@@ -57,7 +61,16 @@ void LogV(uint8_t module, uint8_t category, const char * msg, va_list v)
 {
     if (IsCategoryEnabled(category))
     {
-        vsyslog(LOG_INFO, msg, v);
+        bool logged = false;
+
+#if CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+        logged = ChipLinuxAsyncLog::Instance().Log(module, category, msg, v);
+#endif
+
+        if (!logged)
+        {
+            vsyslog(LOG_INFO, msg, v);
+        }
 
         // Let the application know that a log message has been emitted.
         DeviceLayer::OnLogOutput();
@@ -20,21 +20,21 @@
 #include <algorithm>
 #include <sstream>
 #include <string.h>
-#include <time.h>
 #include <vector>
 
 #include <netinet/in.h>
 
+#include <avahi-common/timeval.h>
+
+#include "platform/CHIPDeviceLayer.h"
 #include "support/CHIPMem.h"
 #include "support/CodeUtils.h"
+#include "support/ErrorStr.h"
 
 using chip::Protocols::Mdns::kMdnsTypeMaxSize;
 using chip::Protocols::Mdns::MdnsServiceProtocol;
 using chip::Protocols::Mdns::TextEntry;
-using std::chrono::duration_cast;
-using std::chrono::microseconds;
-using std::chrono::seconds;
-using std::chrono::steady_clock;
+using chip::System::SocketWatch;
 
 namespace {
 
@@ -72,6 +72,26 @@ std::string GetFullType(const char * type, MdnsServiceProtocol protocol)
     return typeBuilder.str();
 }
 
+uint8_t ToSocketWatchEvents(AvahiWatchEvent events)
+{
+    uint8_t socketEvents = 0;
+
+    socketEvents |= (events & AVAHI_WATCH_IN) ? SocketWatch::kEvent_Read : 0;
+    socketEvents |= (events & AVAHI_WATCH_OUT) ? SocketWatch::kEvent_Write : 0;
+    socketEvents |= (events & (AVAHI_WATCH_ERR | AVAHI_WATCH_HUP)) ? SocketWatch::kEvent_Exception : 0;
+    return socketEvents;
+}
+
+int ToAvahiWatchEvents(uint8_t socketEvents)
+{
+    int events = 0;
+
+    events |= (socketEvents & SocketWatch::kEvent_Read) ? AVAHI_WATCH_IN : 0;
+    events |= (socketEvents & SocketWatch::kEvent_Write) ? AVAHI_WATCH_OUT : 0;
+    events |= (socketEvents & SocketWatch::kEvent_Exception) ? AVAHI_WATCH_ERR : 0;
+    return events;
+}
+
 } // namespace
 
 namespace chip {
@@ -80,8 +100,6 @@ namespace Mdns {
 
 MdnsAvahi MdnsAvahi::sInstance;
 
-constexpr uint64_t kUsPerSec = 1000 * 1000;
-
 Poller::Poller()
 {
     mAvahiPoller.userdata         = this;
@@ -103,16 +121,38 @@ AvahiWatch * Poller::WatchNew(const struct AvahiPoll * poller, int fd, AvahiWatc
 
 AvahiWatch * Poller::WatchNew(int fd, AvahiWatchEvent event, AvahiWatchCallback callback, void * context)
 {
-    VerifyOrDie(callback != nullptr && fd >= 0);
+    AvahiWatch * watch  = nullptr;
+    System::Error error = CHIP_SYSTEM_NO_ERROR;
+
+    VerifyOrDie(callback != nullptr && fd >= 0 && mSystemLayer != nullptr);
+
+    watch = chip::Platform::New<AvahiWatch>();
+    VerifyOrExit(watch != nullptr, error = CHIP_SYSTEM_ERROR_NO_MEMORY);
 
-    mWatches.emplace_back(new AvahiWatch{ fd, event, 0, callback, context, this });
+    watch->mHappenedEvents = 0;
+    watch->mCallback       = callback;
+    watch->mContext        = context;
+    watch->mPoller         = this;
+    watch->mSocketWatch.Init(fd, HandleWatchReady, watch);
 
-    return mWatches.back().get();
+    error = mSystemLayer->AddSocketWatch(watch->mSocketWatch, ToSocketWatchEvents(event));
+    if (error != CHIP_SYSTEM_NO_ERROR)
+    {
+        chip::Platform::Delete(watch);
+        watch = nullptr;
+    }
+
+exit:
+    if (watch == nullptr)
+    {
+        ChipLogError(DeviceLayer, "Failed to watch Avahi fd %d: %s", fd, ErrorStr(error));
+    }
+    return watch;
 }
 
 void Poller::WatchUpdate(AvahiWatch * watch, AvahiWatchEvent event)
 {
-    watch->mWatchEvents = event;
+    static_cast<Poller *>(watch->mPoller)->mSystemLayer->UpdateSocketWatch(watch->mSocketWatch, ToSocketWatchEvents(event));
 }
 
 AvahiWatchEvent Poller::WatchGetEvents(AvahiWatch * watch)
@@ -122,14 +162,17 @@ AvahiWatchEvent Poller::WatchGetEvents(AvahiWatch * watch)
 
 void Poller::WatchFree(AvahiWatch * watch)
 {
-    reinterpret_cast<Poller *>(watch->mPoller)->WatchFree(*watch);
+    static_cast<Poller *>(watch->mPoller)->mSystemLayer->RemoveSocketWatch(watch->mSocketWatch);
+    chip::Platform::Delete(watch);
 }
 
-void Poller::WatchFree(AvahiWatch & watch)
+void Poller::HandleWatchReady(SocketWatch & socketWatch, uint8_t events, void * context)
 {
-    mWatches.erase(std::remove_if(mWatches.begin(), mWatches.end(),
-                                  [&watch](const std::unique_ptr<AvahiWatch> & aValue) { return aValue.get() == &watch; }),
-                   mWatches.end());
+    AvahiWatch * watch = static_cast<AvahiWatch *>(context);
+
+    // The callback may free the watch.
+    watch->mHappenedEvents = ToAvahiWatchEvents(events);
+    watch->mCallback(watch, socketWatch.GetFD(), static_cast<AvahiWatchEvent>(watch->mHappenedEvents), watch->mContext);
 }
 
 AvahiTimeout * Poller::TimeoutNew(const AvahiPoll * poller, const struct timeval * timeout, AvahiTimeoutCallback callback,
@@ -140,151 +183,65 @@ AvahiTimeout * Poller::TimeoutNew(const AvahiPoll * poller, const struct timeval
     return static_cast<Poller *>(poller->userdata)->TimeoutNew(timeout, callback, context);
 }
 
-steady_clock::time_point GetAbsTimeout(const struct timeval * timeout)
+AvahiTimeout * Poller::TimeoutNew(const struct timeval * timeout, AvahiTimeoutCallback callback, void * context)
 {
-    steady_clock::time_point now        = steady_clock::now();
-    steady_clock::time_point absTimeout = now;
+    AvahiTimeout * timer = chip::Platform::New<AvahiTimeout>();
 
-    if (timeout != nullptr)
+    VerifyOrDie(mSystemLayer != nullptr);
+
+    if (timer == nullptr)
     {
-        absTimeout += seconds(timeout->tv_sec);
-        absTimeout += microseconds(timeout->tv_usec);
+        ChipLogError(DeviceLayer, "Failed to allocate Avahi timeout");
+        return nullptr;
     }
 
-    return absTimeout;
-}
-
-AvahiTimeout * Poller::TimeoutNew(const struct timeval * timeout, AvahiTimeoutCallback callback, void * context)
-{
+    timer->mCallback = callback;
+    timer->mContext  = context;
+    timer->mPoller   = this;
+    if (timeout != nullptr)
+    {
+        ScheduleTimeout(*timer, *timeout);
+    }
 
-    mTimers.emplace_back(new AvahiTimeout{ GetAbsTimeout(timeout), callback, timeout != nullptr, context, this });
-    return mTimers.back().get();
+    return timer;
 }
 
 void Poller::TimeoutUpdate(AvahiTimeout * timer, const struct timeval * timeout)
 {
-    if (timeout)
-    {
-        timer->mAbsTimeout = GetAbsTimeout(timeout);
-        timer->mEnabled    = true;
-    }
-    else
+    Poller * poller = static_cast<Poller *>(timer->mPoller);
+
+    poller->mSystemLayer->CancelTimer(HandleTimeout, timer);
+    if (timeout != nullptr)
     {
-        timer->mEnabled = false;
+        poller->ScheduleTimeout(*timer, *timeout);
     }
 }
 
 void Poller::TimeoutFree(AvahiTimeout * timer)
 {
-    static_cast<Poller *>(timer->mPoller)->TimeoutFree(*timer);
+    static_cast<Poller *>(timer->mPoller)->mSystemLayer->CancelTimer(HandleTimeout, timer);
+    chip::Platform::Delete(timer);
 }
 
-void Poller::TimeoutFree(AvahiTimeout & timer)
+void Poller::ScheduleTimeout(AvahiTimeout & timer, const struct timeval & timeout)
 {
-    mTimers.erase(std::remove_if(mTimers.begin(), mTimers.end(),
-                                 [&timer](const std::unique_ptr<AvahiTimeout> & aValue) { return aValue.get() == &timer; }),
-                  mTimers.end());
-}
-
-void Poller::UpdateFdSet(fd_set & readFdSet, fd_set & writeFdSet, fd_set & errorFdSet, int & aMaxFd, timeval & timeout)
-{
-    microseconds timeoutVal = seconds(timeout.tv_sec) + microseconds(timeout.tv_usec);
-
-    for (auto && watch : mWatches)
-    {
-        int fd                 = watch->mFd;
-        AvahiWatchEvent events = watch->mWatchEvents;
-
-        if (AVAHI_WATCH_IN & events)
-        {
-            FD_SET(fd, &readFdSet);
-        }
-
-        if (AVAHI_WATCH_OUT & events)
-        {
-            FD_SET(fd, &writeFdSet);
-        }
+    // Avahi timeouts are absolute gettimeofday() times; avahi_age() is negative for times in the future.
+    const AvahiUsec age       = avahi_age(&timeout);
+    const uint32_t delay      = (age >= 0) ? 0 : static_cast<uint32_t>((-age + 999) / 1000);
+    const System::Error error = mSystemLayer->StartTimer(delay, HandleTimeout, &timer);
 
-        if (AVAHI_WATCH_ERR & events)
-        {
-            FD_SET(fd, &errorFdSet);
-        }
-
-        if (aMaxFd < fd)
-        {
-            aMaxFd = fd;
-        }
-
-        watch->mHappenedEvents = 0;
-    }
-
-    for (auto && timer : mTimers)
+    if (error != CHIP_SYSTEM_NO_ERROR)
     {
-        steady_clock::time_point absTimeout = timer->mAbsTimeout;
-        steady_clock::time_point now        = steady_clock::now();
-
-        if (!timer->mEnabled)
-        {
-            continue;
-        }
-        if (absTimeout < now)
-        {
-            timeoutVal = microseconds(0);
-            break;
-        }
-        else
-        {
-            timeoutVal = std::min(timeoutVal, duration_cast<microseconds>(absTimeout - now));
-        }
+        ChipLogError(DeviceLayer, "Failed to start Avahi timeout: %s", ErrorStr(error));
     }
-
-    timeout.tv_sec  = static_cast<uint64_t>(timeoutVal.count()) / kUsPerSec;
-    timeout.tv_usec = static_cast<uint64_t>(timeoutVal.count()) % kUsPerSec;
 }
 
-void Poller::Process(const fd_set & readFdSet, const fd_set & writeFdSet, const fd_set & errorFdSet)
+void Poller::HandleTimeout(System::Layer * systemLayer, void * appState, System::Error error)
 {
-    steady_clock::time_point now = steady_clock::now();
-
-    for (auto && watch : mWatches)
-    {
-        int fd                 = watch->mFd;
-        AvahiWatchEvent events = watch->mWatchEvents;
-
-        watch->mHappenedEvents = 0;
-
-        if ((AVAHI_WATCH_IN & events) && FD_ISSET(fd, &readFdSet))
-        {
-            watch->mHappenedEvents |= AVAHI_WATCH_IN;
-        }
+    AvahiTimeout * timer = static_cast<AvahiTimeout *>(appState);
 
-        if ((AVAHI_WATCH_OUT & events) && FD_ISSET(fd, &writeFdSet))
-        {
-            watch->mHappenedEvents |= AVAHI_WATCH_OUT;
-        }
-
-        if ((AVAHI_WATCH_ERR & events) && FD_ISSET(fd, &errorFdSet))
-        {
-            watch->mHappenedEvents |= AVAHI_WATCH_ERR;
-        }
-
-        if (watch->mHappenedEvents)
-        {
-            watch->mCallback(watch.get(), watch->mFd, static_cast<AvahiWatchEvent>(watch->mHappenedEvents), watch->mContext);
-        }
-    }
-
-    for (auto && timer : mTimers)
-    {
-        if (!timer->mEnabled)
-        {
-            continue;
-        }
-        if (timer->mAbsTimeout <= now)
-        {
-            timer->mCallback(timer.get(), timer->mContext);
-        }
-    }
+    // Like the Avahi pollers, a timeout that fired stays disabled until updated.
+    timer->mCallback(timer, timer->mContext);
 }
 
 CHIP_ERROR MdnsAvahi::Init(MdnsAsnycReturnCallback initCallback, MdnsAsnycReturnCallback errorCallback, void * context)
@@ -295,6 +252,7 @@ CHIP_ERROR MdnsAvahi::Init(MdnsAsnycReturnCallback initCallback, MdnsAsnycReturn
     VerifyOrExit(initCallback != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(errorCallback != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(mClient == nullptr && mGroup == nullptr, error = CHIP_ERROR_INCORRECT_STATE);
+    mPoller.Init(DeviceLayer::SystemLayer);
     mInitCallback       = initCallback;
     mErrorCallback      = errorCallback;
     mAsyncReturnContext = context;
@@ -650,16 +608,6 @@ MdnsAvahi::~MdnsAvahi()
     }
 }
 
-void UpdateMdnsDataset(fd_set & readFdSet, fd_set & writeFdSet, fd_set & errorFdSet, int & maxFd, timeval & timeout)
-{
-    MdnsAvahi::GetInstance().GetPoller().UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
-}
-
-void ProcessMdns(fd_set & readFdSet, fd_set & writeFdSet, fd_set & errorFdSet)
-{
-    MdnsAvahi::GetInstance().GetPoller().Process(readFdSet, writeFdSet, errorFdSet);
-}
-
 CHIP_ERROR ChipMdnsInit(MdnsAsnycReturnCallback initCallback, MdnsAsnycReturnCallback errorCallback, void * context)
 {
     return MdnsAvahi::GetInstance().Init(initCallback, errorCallback, context);
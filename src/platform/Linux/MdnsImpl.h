@@ -17,10 +17,6 @@
 
 #pragma once
 
-#include <sys/select.h>
-#include <unistd.h>
-
-#include <chrono>
 #include <map>
 #include <memory>
 #include <set>
@@ -34,38 +30,41 @@
 #include <avahi-common/watch.h>
 
 #include "lib/mdns/platform/Mdns.h"
+#include "system/SystemLayer.h"
 
 struct AvahiWatch
 {
-    int mFd;                      ///< The file descriptor to watch.
-    AvahiWatchEvent mWatchEvents; ///< The interested events.
-    int mHappenedEvents;          ///< The events happened.
-    AvahiWatchCallback mCallback; ///< The function to be called when interested events happened on mFd.
-    void * mContext;              ///< A pointer to application-specific context.
-    void * mPoller;               ///< The poller created this watch.
+    chip::System::SocketWatch mSocketWatch; ///< The registration of the file descriptor with the system layer.
+    int mHappenedEvents;                    ///< The events happened.
+    AvahiWatchCallback mCallback;           ///< The function to be called when interested events happened on the fd.
+    void * mContext;                        ///< A pointer to application-specific context.
+    void * mPoller;                         ///< The poller created this watch.
 };
 
 struct AvahiTimeout
 {
-    std::chrono::steady_clock::time_point mAbsTimeout; ///< Absolute time when this timer timeout.
-    AvahiTimeoutCallback mCallback;                    ///< The function to be called when timeout.
-    bool mEnabled;                                     ///< Whether the timeout is enabled.
-    void * mContext;                                   ///< The pointer to application-specific context.
-    void * mPoller;                                    ///< The poller created this timer.
+    AvahiTimeoutCallback mCallback; ///< The function to be called when timeout.
+    void * mContext;                ///< The pointer to application-specific context.
+    void * mPoller;                 ///< The poller created this timer.
 };
 
 namespace chip {
 namespace Protocols {
 namespace Mdns {
 
+/**
+ * Runs the Avahi watches and timeouts on a System::Layer: watches are registered as socket watches of its select loop
+ * and timeouts are System timers, so the event loop does not go through them on every iteration.
+ */
 class Poller
 {
 public:
     Poller(void);
 
-    void UpdateFdSet(fd_set & readFdSet, fd_set & writeFdSet, fd_set & errorFdSet, int & maxFd, timeval & timeout);
-
-    void Process(const fd_set & readFdSet, const fd_set & writeFdSet, const fd_set & errorFdSet);
+    /**
+     * Sets the layer running the watches and timeouts, which must be done before the Avahi client is created.
+     */
+    void Init(System::Layer & systemLayer) { mSystemLayer = &systemLayer; }
 
     const AvahiPoll * GetAvahiPoll(void) const { return &mAvahiPoller; }
 
@@ -79,7 +78,8 @@ private:
     static AvahiWatchEvent WatchGetEvents(AvahiWatch * watch);
 
     static void WatchFree(AvahiWatch * watch);
-    void WatchFree(AvahiWatch & watch);
+
+    static void HandleWatchReady(System::SocketWatch & socketWatch, uint8_t events, void * context);
 
     static AvahiTimeout * TimeoutNew(const AvahiPoll * poller, const struct timeval * timeout, AvahiTimeoutCallback callback,
                                      void * context);
@@ -88,10 +88,12 @@ private:
     static void TimeoutUpdate(AvahiTimeout * timer, const struct timeval * timeout);
 
     static void TimeoutFree(AvahiTimeout * timer);
-    void TimeoutFree(AvahiTimeout & timer);
 
-    std::vector<std::unique_ptr<AvahiWatch>> mWatches;
-    std::vector<std::unique_ptr<AvahiTimeout>> mTimers;
+    void ScheduleTimeout(AvahiTimeout & timer, const struct timeval & timeout);
+
+    static void HandleTimeout(System::Layer * systemLayer, void * appState, System::Error error);
+
+    System::Layer * mSystemLayer = nullptr;
     AvahiPoll mAvahiPoller;
 };
 
@@ -159,10 +161,6 @@ private:
     Poller mPoller;
 };
 
-void UpdateMdnsDataset(fd_set & readFdSet, fd_set & writeFdSet, fd_set & errorFdSet, int & maxFd, timeval & timeout);
-
-void ProcessMdns(fd_set & readFdSet, fd_set & writeFdSet, fd_set & errorFdSet);
-
 } // namespace Mdns
 } // namespace Protocols
 } // namespace chip
@@ -30,7 +30,13 @@
 
 #include <thread>
 
+#if CHIP_ENABLE_MDNS && !CHIP_MDNS_NATIVE
 #include "MdnsImpl.h"
+#endif
+
+#if CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+#include <platform/Linux/CHIPLinuxAsyncLog.h>
+#endif
 
 namespace chip {
 namespace DeviceLayer {
@@ -60,6 +66,12 @@ CHIP_ERROR PlatformManagerImpl::_InitChipStack()
     gdbusThread.detach();
 #endif
 
+#if CHIP_DEVICE_CONFIG_ENABLE_ASYNC_LOGGING
+    // Move log formatting and output off the CHIP thread.
+    err = Internal::ChipLinuxAsyncLog::Instance().Init(CHIP_DEVICE_CONFIG_ASYNC_LOG_FILE);
+    SuccessOrExit(err);
+#endif
+
     // Initialize the configuration system.
     err = Internal::PosixConfig::Init();
     SuccessOrExit(err);
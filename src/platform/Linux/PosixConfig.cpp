@@ -27,10 +27,17 @@
 #include <platform/internal/CHIPDeviceLayerInternal.h>
 #include <platform/internal/testing/ConfigUnitTest.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdlib.h>
+#include <thread>
+
 #include <core/CHIPEncoding.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
 #include <platform/Linux/PosixConfig.h>
 #include <support/CodeUtils.h>
+#include <system/SystemClock.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -40,6 +47,29 @@ static ChipLinuxStorage gChipLinuxFactoryStorage;
 static ChipLinuxStorage gChipLinuxConfigStorage;
 static ChipLinuxStorage gChipLinuxCountersStorage;
 
+// Storages whose commit has been deferred.
+struct PendingCommits
+{
+    ChipLinuxStorage * mStorages[3];
+    size_t mCount;
+};
+
+// Serializes the commits made by all threads.
+static std::mutex gCommitLock;
+
+// Write batches belong to the thread that opens them: a batch defers the commits of that thread only, so
+// that the writes of other threads are never left waiting for a batch they cannot commit.
+static thread_local uint32_t gWriteBatchDepth;
+static thread_local PendingCommits gBatchCommits;
+
+#if CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY > 0
+static PendingCommits gDelayedCommits; // Guarded by gCommitLock
+static std::condition_variable gCommitWakeup;
+static std::thread gCommitThread;
+static bool gCommitThreadStopping;
+static uint64_t gCommitDeadline; // Monotonic time (ms) of the next delayed commit, 0 if none
+#endif
+
 // *** CAUTION ***: Changing the names or namespaces of these values will *break* existing devices.
 
 // NVS namespaces used to store device configuration information.
@@ -76,6 +106,116 @@ const PosixConfig::Key PosixConfig::kConfigKey_OperationalDevicePrivateKey = { k
 // Prefix used for NVS keys that contain Chip group encryption keys.
 const char PosixConfig::kGroupKeyNamePrefix[] = "gk-";
 
+// Must be called with gCommitLock held.
+static void DeferCommit(PendingCommits & pending, ChipLinuxStorage * storage)
+{
+    for (size_t i = 0; i < pending.mCount; i++)
+    {
+        if (pending.mStorages[i] == storage)
+        {
+            return;
+        }
+    }
+
+    pending.mStorages[pending.mCount++] = storage;
+}
+
+// Must be called with gCommitLock held.
+static CHIP_ERROR CommitPending(PendingCommits & pending)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    for (size_t i = 0; i < pending.mCount; i++)
+    {
+        CHIP_ERROR commitErr = pending.mStorages[i]->Commit();
+
+        if (commitErr != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "Storage Commit failed: %s", ErrorStr(commitErr));
+            err = (err == CHIP_NO_ERROR) ? commitErr : err;
+        }
+    }
+    pending.mCount = 0;
+
+    return err;
+}
+
+#if CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY > 0
+static void RunDelayedCommits()
+{
+    std::unique_lock<std::mutex> lock(gCommitLock);
+
+    while (!gCommitThreadStopping)
+    {
+        uint64_t now = System::Platform::Layer::GetClock_MonotonicMS();
+
+        if (gCommitDeadline == 0)
+        {
+            gCommitWakeup.wait(lock);
+        }
+        else if (now < gCommitDeadline)
+        {
+            gCommitWakeup.wait_for(lock, std::chrono::milliseconds(gCommitDeadline - now));
+        }
+        else
+        {
+            gCommitDeadline = 0;
+            CommitPending(gDelayedCommits);
+        }
+    }
+}
+
+static void StopDelayedCommits()
+{
+    {
+        std::lock_guard<std::mutex> lock(gCommitLock);
+
+        gCommitThreadStopping = true;
+        CommitPending(gDelayedCommits);
+    }
+
+    gCommitWakeup.notify_one();
+    gCommitThread.join();
+}
+#endif // CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY > 0
+
+// Commits the changes made to @p storage, unless the calling thread has a write batch open or the commit is delayed.
+static CHIP_ERROR CommitStorage(ChipLinuxStorage * storage)
+{
+    std::lock_guard<std::mutex> lock(gCommitLock);
+
+    if (gWriteBatchDepth > 0)
+    {
+        DeferCommit(gBatchCommits, storage);
+        return CHIP_NO_ERROR;
+    }
+
+#if CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY > 0
+    // Outside of a batch, counters must be durable before their values are used, so only configuration commits
+    // are delayed.
+    if (storage == &gChipLinuxConfigStorage && !gCommitThreadStopping)
+    {
+        if (!gCommitThread.joinable())
+        {
+            gCommitThread = std::thread(RunDelayedCommits);
+            atexit(StopDelayedCommits);
+        }
+
+        // The deadline is not pushed back by later changes, so that each change is committed within the delay.
+        if (gCommitDeadline == 0)
+        {
+            gCommitDeadline = System::Platform::Layer::GetClock_MonotonicMS() + CHIP_DEVICE_CONFIG_CONFIG_COMMIT_DELAY;
+            gCommitWakeup.notify_one();
+        }
+
+        DeferCommit(gDelayedCommits, storage);
+        return CHIP_NO_ERROR;
+    }
+#endif
+
+    return storage->Commit();
+}
+
 ChipLinuxStorage * PosixConfig::GetStorageForNamespace(Key key)
 {
     if (strcmp(key.Namespace, kConfigNamespace_ChipFactory) == 0)
@@ -232,7 +372,7 @@ CHIP_ERROR PosixConfig::WriteConfigValue(Key key, bool val)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = storage->Commit();
+    err = CommitStorage(storage);
     SuccessOrExit(err);
 
     ChipLogProgress(DeviceLayer, "NVS set: %s/%s = %s", key.Namespace, key.Name, val ? "true" : "false");
@@ -253,7 +393,7 @@ CHIP_ERROR PosixConfig::WriteConfigValue(Key key, uint32_t val)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = storage->Commit();
+    err = CommitStorage(storage);
     SuccessOrExit(err);
 
     ChipLogProgress(DeviceLayer, "NVS set: %s/%s = %" PRIu32 " (0x%" PRIX32 ")", key.Namespace, key.Name, val, val);
@@ -274,7 +414,7 @@ CHIP_ERROR PosixConfig::WriteConfigValue(Key key, uint64_t val)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = storage->Commit();
+    err = CommitStorage(storage);
     SuccessOrExit(err);
 
     ChipLogProgress(DeviceLayer, "NVS set: %s/%s = %" PRIu64 " (0x%" PRIX64 ")", key.Namespace, key.Name, val, val);
@@ -297,7 +437,7 @@ CHIP_ERROR PosixConfig::WriteConfigValueStr(Key key, const char * str)
         SuccessOrExit(err);
 
         // Commit the value to the persistent store.
-        err = storage->Commit();
+        err = CommitStorage(storage);
         SuccessOrExit(err);
 
         ChipLogProgress(DeviceLayer, "NVS set: %s/%s = \"%s\"", key.Namespace, key.Name, str);
@@ -352,7 +492,7 @@ CHIP_ERROR PosixConfig::WriteConfigValueBin(Key key, const uint8_t * data, size_
         SuccessOrExit(err);
 
         // Commit the value to the persistent store.
-        err = storage->Commit();
+        err = CommitStorage(storage);
         SuccessOrExit(err);
 
         ChipLogProgress(DeviceLayer, "NVS set: %s/%s = (blob length %" PRId32 ")", key.Namespace, key.Name, dataLen);
@@ -383,7 +523,7 @@ CHIP_ERROR PosixConfig::ClearConfigValue(Key key)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = storage->Commit();
+    err = CommitStorage(storage);
     SuccessOrExit(err);
 
     ChipLogProgress(DeviceLayer, "NVS erase: %s/%s", key.Namespace, key.Name);
@@ -416,12 +556,20 @@ CHIP_ERROR PosixConfig::EnsureNamespace(const char * ns)
     else if (strcmp(ns, kConfigNamespace_ChipConfig) == 0)
     {
         storage = &gChipLinuxConfigStorage;
-        err     = storage->Init(CHIP_DEFAULT_CONFIG_PATH);
+#if CHIP_DEVICE_CONFIG_ENABLE_STORAGE_LOG
+        err = storage->InitLog(CHIP_DEFAULT_CONFIG_LOG_PATH, CHIP_DEFAULT_CONFIG_PATH);
+#else
+        err = storage->Init(CHIP_DEFAULT_CONFIG_PATH);
+#endif
     }
     else if (strcmp(ns, kConfigNamespace_ChipCounters) == 0)
     {
         storage = &gChipLinuxCountersStorage;
-        err     = storage->Init(CHIP_DEFAULT_DATA_PATH);
+#if CHIP_DEVICE_CONFIG_ENABLE_STORAGE_LOG
+        err = storage->InitLog(CHIP_DEFAULT_DATA_LOG_PATH, CHIP_DEFAULT_DATA_PATH);
+#else
+        err = storage->Init(CHIP_DEFAULT_DATA_PATH);
+#endif
     }
 
     SuccessOrExit(err);
@@ -495,6 +643,42 @@ exit:
     return err;
 }
 
+CHIP_ERROR PosixConfig::BeginWriteBatch()
+{
+    gWriteBatchDepth++;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PosixConfig::CommitWriteBatch()
+{
+    std::lock_guard<std::mutex> lock(gCommitLock);
+
+    if (gWriteBatchDepth == 0)
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    if (--gWriteBatchDepth > 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    return CommitPending(gBatchCommits);
+}
+
+CHIP_ERROR PosixConfig::InitNamespace(const char * ns, const char * configFile)
+{
+    ChipLinuxStorage * storage = GetStorageForNamespace(Key{ ns, "" });
+
+    if (storage == nullptr)
+    {
+        return CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND;
+    }
+
+    return storage->Init(configFile);
+}
+
 void PosixConfig::RunConfigUnitTest()
 {
     // Run common unit test.
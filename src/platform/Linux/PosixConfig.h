@@ -97,6 +97,16 @@ public:
     static bool ConfigValueExists(Key key);
     static CHIP_ERROR FactoryResetConfig();
 
+    // Write batches: commits of the values written between BeginWriteBatch() and the matching
+    // CommitWriteBatch() are deferred to the latter.  Batches can be nested.  A batch belongs to
+    // the thread that opens it, and only defers the commits of that thread's writes.
+    static CHIP_ERROR BeginWriteBatch();
+    static CHIP_ERROR CommitWriteBatch();
+
+    // Stores the values of a namespace in the INI file at configFile rather than at its default
+    // path, for tests.
+    static CHIP_ERROR InitNamespace(const char * ns, const char * configFile);
+
     static void RunConfigUnitTest();
 
 protected:
@@ -42,6 +42,16 @@ CHIP_ERROR Write(Key key, uint32_t value)
     return ConfigurationMgr().WritePersistedStorageValue(key, value);
 }
 
+CHIP_ERROR BeginWriteBatch()
+{
+    return ConfigurationMgr().BeginWriteBatch();
+}
+
+CHIP_ERROR CommitWriteBatch()
+{
+    return ConfigurationMgr().CommitWriteBatch();
+}
+
 } // namespace PersistedStorage
 } // namespace Platform
 } // namespace chip
@@ -0,0 +1,195 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the persistent, memory-mapped event
+ *      store. It fills a log of the given size and a quarter more, so that
+ *      appends also evict, then fetches the whole log and fetches a few events
+ *      from random positions, and reports the time per event or per fetch.
+ *
+ *      Usage: EventStoreBenchmark [<log size in MB>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <platform/Linux/CHIPLinuxEventStore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::TLV;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr uint32_t kDefaultLogSizeMB = 64;
+constexpr uint32_t kMaxLogSizeMB     = 1024;
+constexpr uint32_t kEventDataLength  = 64;
+constexpr uint32_t kSeeks            = 10000;
+
+constexpr uint64_t kTag_Value = 2;
+constexpr uint64_t kTag_Data  = 3;
+
+CHIP_ERROR WriteEvent(TLVWriter & writer, void * appData)
+{
+    static const uint8_t sData[kEventDataLength] = { 0 };
+    CHIP_ERROR err;
+
+    err = writer.Put(ContextTag(kTag_Value), *static_cast<const uint32_t *>(appData));
+    SuccessOrExit(err);
+
+    err = writer.PutBytes(ContextTag(kTag_Data), sData, sizeof(sData));
+
+exit:
+    return err;
+}
+
+uint64_t Now()
+{
+    return System::Platform::Layer::GetClock_MonotonicHiRes();
+}
+
+int Run(const char * path, uint32_t logSize)
+{
+    ChipLinuxEventStore store;
+    uint8_t buf[2048];
+    uint64_t start, appendTime, fetchTime, seekTime;
+    uint64_t eventNumber, firstEventNumber, nextEventNumber;
+    uint32_t appended = 0;
+    uint32_t fetched  = 0;
+    CHIP_ERROR err;
+
+    err = store.Init(path, logSize);
+    SuccessOrExit(err);
+
+    start = Now();
+    while (appended < logSize / kEventDataLength + logSize / (4 * kEventDataLength))
+    {
+        appended++;
+        err = store.AppendEvent(appended, WriteEvent, &appended, eventNumber);
+        SuccessOrExit(err);
+    }
+    appendTime = Now() - start;
+
+    firstEventNumber = store.GetFirstEventNumber();
+    nextEventNumber  = store.GetNextEventNumber();
+
+    eventNumber = firstEventNumber;
+    start       = Now();
+    do
+    {
+        TLVWriter writer;
+        TLVReader reader;
+
+        writer.Init(buf, sizeof(buf));
+        err = store.FetchEventsSince(writer, eventNumber);
+        if (err != CHIP_END_OF_TLV && err != CHIP_ERROR_BUFFER_TOO_SMALL)
+        {
+            ExitNow();
+        }
+        writer.Finalize();
+
+        reader.Init(buf, writer.GetLengthWritten());
+        while (reader.Next() == CHIP_NO_ERROR)
+        {
+            fetched++;
+        }
+    } while (err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    fetchTime = Now() - start;
+
+    srand(1);
+    start = Now();
+    for (uint32_t i = 0; i < kSeeks; i++)
+    {
+        TLVWriter writer;
+
+        eventNumber = firstEventNumber + static_cast<uint64_t>(rand()) % (nextEventNumber - firstEventNumber);
+        writer.Init(buf, 256);
+        store.FetchEventsSince(writer, eventNumber);
+    }
+    seekTime = Now() - start;
+    err      = CHIP_NO_ERROR;
+
+    printf("Event store, %" PRIu32 " MB log, %" PRIu64 " events held\n", logSize / (1024 * 1024),
+           nextEventNumber - firstEventNumber);
+    printf("  append:       %" PRIu32 " events in %" PRIu64 " us, %" PRIu64 " ns per event\n", appended, appendTime,
+           appendTime * 1000 / appended);
+    printf("  fetch all:    %" PRIu32 " events in %" PRIu64 " us, %" PRIu64 " ns per event\n", fetched, fetchTime,
+           (fetched == 0) ? 0 : fetchTime * 1000 / fetched);
+    printf("  random fetch: %" PRIu32 " fetches in %" PRIu64 " us, %" PRIu64 " ns per fetch\n", kSeeks, seekTime,
+           seekTime * 1000 / kSeeks);
+
+exit:
+    store.Shutdown();
+
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Event store failed: %s\n", ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    char path[]        = "/tmp/chip_event_store_benchmark_XXXXXX";
+    uint32_t logSizeMB = kDefaultLogSizeMB;
+    int fd;
+    int result;
+
+    if (argc > 1)
+    {
+        logSizeMB = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || logSizeMB == 0 || logSizeMB > kMaxLogSizeMB)
+    {
+        fprintf(stderr, "Usage: %s [<log size in MB, at most %" PRIu32 ">]\n", argv[0], kMaxLogSizeMB);
+        return EXIT_FAILURE;
+    }
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize memory\n");
+        return EXIT_FAILURE;
+    }
+
+    fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("mkstemp");
+        Platform::MemoryShutdown();
+        return EXIT_FAILURE;
+    }
+    close(fd);
+
+    result = Run(path, logSizeMB * 1024 * 1024);
+
+    unlink(path);
+    Platform::MemoryShutdown();
+
+    return result;
+}
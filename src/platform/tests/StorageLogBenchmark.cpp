@@ -0,0 +1,245 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the Linux key-value storage. It
+ *      measures the time taken to update and commit one value of a
+ *      configuration holding a few certificates, as PersistedCounter and
+ *      ConfigurationManager do, with the INI backend, with the log, and with
+ *      the log synced once a second.
+ *
+ *      Usage: StorageLogBenchmark [<commits>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr uint32_t kDefaultCommits = 1000;
+
+struct Paths
+{
+    char mDir[sizeof("/tmp/chip_storage_benchmark_XXXXXX")];
+    char mLog[sizeof(mDir) + 32];
+    char mIni[sizeof(mDir) + 32];
+};
+
+uint64_t Now()
+{
+    return System::Platform::Layer::GetClock_MonotonicHiRes();
+}
+
+long GetFileSize(const char * path)
+{
+    FILE * file = fopen(path, "rb");
+    long size   = -1;
+
+    if (file != nullptr)
+    {
+        if (fseek(file, 0, SEEK_END) == 0)
+        {
+            size = ftell(file);
+        }
+        fclose(file);
+    }
+
+    return size;
+}
+
+void RemoveFiles(const Paths & paths)
+{
+    char path[sizeof(paths.mLog) + 4];
+
+    unlink(paths.mLog);
+    snprintf(path, sizeof(path), "%s.tmp", paths.mLog);
+    unlink(path);
+    unlink(paths.mIni);
+    snprintf(path, sizeof(path), "%s.tmp", paths.mIni);
+    unlink(path);
+}
+
+// Writes a set of values of the size of a commissioned device's configuration.
+CHIP_ERROR PopulateConfig(ChipLinuxStorage & storage)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    uint8_t cert[400];
+    char key[32];
+
+    memset(cert, 0xa5, sizeof(cert));
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        snprintf(key, sizeof(key), "cert-%" PRIu32, i);
+        err = storage.WriteValueBin(key, cert, sizeof(cert));
+        SuccessOrExit(err);
+    }
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        snprintf(key, sizeof(key), "value-%" PRIu32, i);
+        err = storage.WriteValue(key, static_cast<uint64_t>(i) << 40);
+        SuccessOrExit(err);
+    }
+    err = storage.Commit();
+
+exit:
+    return err;
+}
+
+// Commits a new value of one key of a populated configuration the given number of times.
+CHIP_ERROR TimeCommits(ChipLinuxStorage & storage, uint32_t commits, uint64_t & outTime)
+{
+    CHIP_ERROR err;
+    uint64_t start;
+
+    err = PopulateConfig(storage);
+    SuccessOrExit(err);
+
+    start = Now();
+    for (uint64_t i = 0; i < commits; i++)
+    {
+        err = storage.WriteValue("counter", i);
+        SuccessOrExit(err);
+        err = storage.Commit();
+        SuccessOrExit(err);
+    }
+    outTime = Now() - start;
+
+exit:
+    return err;
+}
+
+int Run(const Paths & paths, uint32_t commits)
+{
+    CHIP_ERROR err;
+    uint64_t iniTime, logTime, batchedTime;
+    long iniSize, logSize;
+
+    {
+        ChipLinuxStorage storage;
+
+        err = storage.Init(paths.mIni);
+        SuccessOrExit(err);
+        err = TimeCommits(storage, commits, iniTime);
+        SuccessOrExit(err);
+        iniSize = GetFileSize(paths.mIni);
+    }
+    RemoveFiles(paths);
+
+    {
+        ChipLinuxStorage storage;
+
+        err = storage.InitLog(paths.mLog, paths.mIni);
+        SuccessOrExit(err);
+        err = TimeCommits(storage, commits, logTime);
+        SuccessOrExit(err);
+        logSize = GetFileSize(paths.mLog);
+    }
+    RemoveFiles(paths);
+
+    {
+        ChipLinuxStorageLog log;
+        char value[32];
+        uint64_t start;
+
+        err = log.Open(paths.mLog, 1000);
+        SuccessOrExit(err);
+
+        start = Now();
+        for (uint64_t i = 0; i < commits; i++)
+        {
+            snprintf(value, sizeof(value), "%" PRIu64, i);
+            err = log.AddEntry("counter", value);
+            SuccessOrExit(err);
+            err = log.Commit();
+            SuccessOrExit(err);
+        }
+        err = log.Sync();
+        SuccessOrExit(err);
+        batchedTime = Now() - start;
+    }
+
+    printf("Storage, %" PRIu32 " commits of one value\n", commits);
+    printf("  INI rewrite:            %" PRIu64 " us per commit, %ld bytes\n", iniTime / commits, iniSize);
+    printf("  log:                    %" PRIu64 " us per commit, %ld bytes after\n", logTime / commits, logSize);
+    printf("  log synced every 1 s:   %" PRIu64 " us per commit\n", batchedTime / commits);
+
+exit:
+    RemoveFiles(paths);
+
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Storage failed: %s\n", ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    Paths paths      = { "/tmp/chip_storage_benchmark_XXXXXX", "", "" };
+    uint32_t commits = kDefaultCommits;
+    int result;
+
+    if (argc > 1)
+    {
+        commits = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || commits == 0)
+    {
+        fprintf(stderr, "Usage: %s [<commits>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize memory\n");
+        return EXIT_FAILURE;
+    }
+
+    if (mkdtemp(paths.mDir) == nullptr)
+    {
+        perror("mkdtemp");
+        Platform::MemoryShutdown();
+        return EXIT_FAILURE;
+    }
+    snprintf(paths.mLog, sizeof(paths.mLog), "%s/storage.kvlog", paths.mDir);
+    snprintf(paths.mIni, sizeof(paths.mIni), "%s/storage.ini", paths.mDir);
+
+    result = Run(paths, commits);
+
+    rmdir(paths.mDir);
+    Platform::MemoryShutdown();
+
+    return result;
+}
@@ -0,0 +1,423 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the asynchronous
+ *      log backend.
+ *
+ */
+
+#include "TestAsyncLog.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <syslog.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <core/CHIPEncoding.h>
+#include <nlunit-test.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxAsyncLog.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <support/logging/CHIPBinaryLogging.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::Logging;
+using namespace chip::DeviceLayer::Internal;
+
+#define TEST_ASYNC_LOG_PATH "/tmp/chip_test_async_log.bin"
+
+// =================================
+//      Helpers
+// =================================
+
+struct DecodedLog
+{
+    struct Message
+    {
+        uint64_t mTimestamp;
+        uint32_t mThreadId;
+        uint8_t mModule;
+        uint8_t mCategory;
+        std::string mText;
+    };
+
+    std::vector<Message> mMessages;
+    uint32_t mDropped = 0;
+};
+
+// Logs a message the way LogV() does when the asynchronous log is enabled.  Returns whether the asynchronous log
+// took the message.
+static bool TestLog(uint8_t module, uint8_t category, const char * format, ...)
+{
+    va_list v;
+    bool logged;
+
+    va_start(v, format);
+    logged = ChipLinuxAsyncLog::Instance().Log(module, category, format, v);
+    if (!logged)
+    {
+        vsyslog(LOG_INFO, format, v);
+    }
+    va_end(v);
+
+    return logged;
+}
+
+static void TestSyncLog(uint8_t module, uint8_t category, const char * format, ...)
+{
+    va_list v;
+
+    va_start(v, format);
+    vsyslog(LOG_INFO, format, v);
+    va_end(v);
+}
+
+static bool ReadBinaryLog(const char * path, DecodedLog & log)
+{
+    std::vector<uint8_t> data;
+    std::vector<std::string> formats;
+    uint8_t chunk[4096];
+    size_t offset = sizeof(kBinaryLogMagic);
+    size_t n;
+    FILE * file = fopen(path, "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(file);
+
+    if (data.size() < sizeof(kBinaryLogMagic) || Encoding::LittleEndian::Get32(data.data()) != kBinaryLogMagic)
+    {
+        return false;
+    }
+
+    while (offset < data.size())
+    {
+        BinaryLogRecord record;
+        size_t length;
+        char text[CHIP_DEVICE_CONFIG_LOG_MESSAGE_MAX_SIZE];
+
+        if (DecodeBinaryLogRecord(&data[offset], data.size() - offset, record, length) != CHIP_NO_ERROR)
+        {
+            return false;
+        }
+        offset += length;
+
+        switch (record.mType)
+        {
+        case BinaryLogRecordType::kFormat:
+            if (record.mFormatId != formats.size() + 1)
+            {
+                return false;
+            }
+            formats.emplace_back(record.mFormat, record.mFormatLength);
+            break;
+
+        case BinaryLogRecordType::kMessage:
+            if (record.mFormatId == 0 || record.mFormatId > formats.size())
+            {
+                return false;
+            }
+            FormatCapturedLogArgs(formats[record.mFormatId - 1].c_str(), record.mArgs, record.mArgsLength, text, sizeof(text));
+            log.mMessages.push_back(
+                DecodedLog::Message{ record.mTimestamp, record.mThreadId, record.mModule, record.mCategory, text });
+            break;
+
+        case BinaryLogRecordType::kDropped:
+            log.mDropped += record.mDroppedCount;
+            break;
+        }
+    }
+
+    return true;
+}
+
+// Stands in for the work of an event loop iteration.
+static void SpinFor(uint64_t usec)
+{
+    const uint64_t end = System::Platform::Layer::GetClock_MonotonicHiRes() + usec;
+
+    while (System::Platform::Layer::GetClock_MonotonicHiRes() < end)
+    {
+    }
+}
+
+// =================================
+//      Test cases
+// =================================
+
+static void TestAsyncLog_InitShutdown(nlTestSuite * inSuite, void * inContext)
+{
+    // Until the log is running, the caller logs messages itself.
+    NL_TEST_ASSERT(inSuite, !TestLog(kLogModule_DeviceLayer, kLogCategory_Detail, "not running"));
+    NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init("/nonexistent/dir/log.bin") != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !TestLog(kLogModule_DeviceLayer, kLogCategory_Detail, "not running"));
+    ChipLinuxAsyncLog::Instance().Flush();
+    ChipLinuxAsyncLog::Instance().Shutdown();
+
+    unlink(TEST_ASYNC_LOG_PATH);
+    NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init(TEST_ASYNC_LOG_PATH) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init(TEST_ASYNC_LOG_PATH) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, TestLog(kLogModule_DeviceLayer, kLogCategory_Detail, "running"));
+    ChipLinuxAsyncLog::Instance().Shutdown();
+    ChipLinuxAsyncLog::Instance().Shutdown();
+    NL_TEST_ASSERT(inSuite, !TestLog(kLogModule_DeviceLayer, kLogCategory_Detail, "not running"));
+
+    unlink(TEST_ASYNC_LOG_PATH);
+}
+
+static void TestAsyncLog_BinaryRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    const int kThreads             = 4;
+    const uint32_t kMessagesPerRun = 100;
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> received(kThreads);
+    std::vector<uint64_t> lastTimestamp(kThreads);
+    DecodedLog log;
+    char expected[CHIP_DEVICE_CONFIG_LOG_MESSAGE_MAX_SIZE];
+
+    unlink(TEST_ASYNC_LOG_PATH);
+    NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init(TEST_ASYNC_LOG_PATH) == CHIP_NO_ERROR);
+
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([t] {
+            for (uint32_t i = 0; i < kMessagesPerRun; i++)
+            {
+                TestLog(kLogModule_DeviceLayer, kLogCategory_Progress, "thread %d message %" PRIu32 " of %s, %08" PRIx64, t, i,
+                        "round trip", static_cast<uint64_t>(i) << 32);
+            }
+        });
+    }
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+
+    // Logged after its thread has gone, so the ring of that thread is freed in the meantime.
+    TestLog(kLogModule_Inet, kLogCategory_Error, "last message: %c%5.2f", 'x', 2.5);
+
+    ChipLinuxAsyncLog::Instance().Flush();
+    ChipLinuxAsyncLog::Instance().Shutdown();
+
+    NL_TEST_ASSERT(inSuite, ReadBinaryLog(TEST_ASYNC_LOG_PATH, log));
+    NL_TEST_ASSERT(inSuite, log.mMessages.size() + log.mDropped == kThreads * kMessagesPerRun + 1);
+    NL_TEST_ASSERT(inSuite, log.mDropped == 0);
+
+    for (const DecodedLog::Message & message : log.mMessages)
+    {
+        int t;
+        uint32_t i;
+
+        if (message.mModule == kLogModule_Inet)
+        {
+            NL_TEST_ASSERT(inSuite, message.mCategory == kLogCategory_Error);
+            NL_TEST_ASSERT(inSuite, message.mText == "last message: x 2.50");
+            continue;
+        }
+
+        NL_TEST_ASSERT(inSuite, message.mModule == kLogModule_DeviceLayer);
+        NL_TEST_ASSERT(inSuite, message.mCategory == kLogCategory_Progress);
+        NL_TEST_ASSERT(inSuite, sscanf(message.mText.c_str(), "thread %d message %" SCNu32, &t, &i) == 2);
+        if (t < 0 || t >= kThreads)
+        {
+            NL_TEST_ASSERT(inSuite, false);
+            continue;
+        }
+
+        // Each thread's messages arrive in order.
+        NL_TEST_ASSERT(inSuite, i == received[static_cast<size_t>(t)]);
+        NL_TEST_ASSERT(inSuite, message.mTimestamp >= lastTimestamp[static_cast<size_t>(t)]);
+        received[static_cast<size_t>(t)]++;
+        lastTimestamp[static_cast<size_t>(t)] = message.mTimestamp;
+
+        snprintf(expected, sizeof(expected), "thread %d message %" PRIu32 " of %s, %08" PRIx64, t, i, "round trip",
+                 static_cast<uint64_t>(i) << 32);
+        NL_TEST_ASSERT(inSuite, message.mText == expected);
+    }
+
+    for (int t = 0; t < kThreads; t++)
+    {
+        NL_TEST_ASSERT(inSuite, received[static_cast<size_t>(t)] == kMessagesPerRun);
+    }
+
+    unlink(TEST_ASYNC_LOG_PATH);
+}
+
+static void TestAsyncLog_Overflow(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kMessages = ChipLinuxAsyncLog::kRingSize * 8;
+    char longString[ChipLinuxAsyncLog::kMaxArgsLength * 2];
+    std::string expected;
+    DecodedLog log;
+
+    memset(longString, 'a', sizeof(longString) - 1);
+    longString[sizeof(longString) - 1] = '\0';
+
+    unlink(TEST_ASYNC_LOG_PATH);
+    NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init(TEST_ASYNC_LOG_PATH) == CHIP_NO_ERROR);
+
+    // Arguments that do not fit are formatted on the logging thread and cut off.
+    TestLog(kLogModule_DeviceLayer, kLogCategory_Detail, "long %d %s", 1, longString);
+
+    // Logging faster than the background thread wakes up drops messages rather than blocking.
+    for (uint32_t i = 0; i < kMessages; i++)
+    {
+        TestLog(kLogModule_DeviceLayer, kLogCategory_Detail, "burst %" PRIu32, i);
+    }
+
+    ChipLinuxAsyncLog::Instance().Flush();
+    ChipLinuxAsyncLog::Instance().Shutdown();
+
+    NL_TEST_ASSERT(inSuite, ReadBinaryLog(TEST_ASYNC_LOG_PATH, log));
+    NL_TEST_ASSERT(inSuite, log.mMessages.size() + log.mDropped == kMessages + 1);
+    NL_TEST_ASSERT(inSuite, log.mMessages.size() >= ChipLinuxAsyncLog::kRingSize);
+
+    expected = std::string("long 1 ") + longString;
+    expected.resize(ChipLinuxAsyncLog::kMaxArgsLength - sizeof(uint16_t));
+    NL_TEST_ASSERT(inSuite, !log.mMessages.empty() && log.mMessages[0].mText == expected);
+
+    unlink(TEST_ASYNC_LOG_PATH);
+}
+
+/**
+ * Measures the latency of an event loop iteration that logs three progress messages, logging them synchronously with
+ * vsyslog() as LogV() does by default, and through the asynchronous log to syslog and to a binary file.  Only correctness
+ * is asserted; the latencies are informative.
+ */
+static void TestAsyncLog_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kIterations = 2000;
+    const uint64_t kWorkUsec   = 20;
+    const char * const kModes[] = { "no logging", "vsyslog", "async to syslog", "async to file" };
+
+    for (size_t mode = 0; mode < ArraySize(kModes); mode++)
+    {
+        uint64_t total = 0;
+        uint64_t max   = 0;
+
+        if (mode == 2)
+        {
+            NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init("") == CHIP_NO_ERROR);
+        }
+        else if (mode == 3)
+        {
+            unlink(TEST_ASYNC_LOG_PATH);
+            NL_TEST_ASSERT(inSuite, ChipLinuxAsyncLog::Instance().Init(TEST_ASYNC_LOG_PATH) == CHIP_NO_ERROR);
+        }
+
+        for (uint32_t i = 0; i < kIterations; i++)
+        {
+            const uint64_t start = System::Platform::Layer::GetClock_MonotonicHiRes();
+            uint64_t elapsed;
+
+            SpinFor(kWorkUsec);
+            if (mode == 1)
+            {
+                TestSyncLog(kLogModule_ExchangeManager, kLogCategory_Progress, "Received message %" PRIu32 " on exchange %u", i,
+                            static_cast<unsigned>(i & 0xffff));
+                TestSyncLog(kLogModule_SecurityManager, kLogCategory_Progress, "Decrypted %u bytes from node %" PRIx64, 64u,
+                            static_cast<uint64_t>(i) * 7919);
+                TestSyncLog(kLogModule_DeviceLayer, kLogCategory_Progress, "Timer %s fired after %" PRIu64 " us", "retransmit",
+                            kWorkUsec);
+            }
+            else if (mode >= 2)
+            {
+                TestLog(kLogModule_ExchangeManager, kLogCategory_Progress, "Received message %" PRIu32 " on exchange %u", i,
+                        static_cast<unsigned>(i & 0xffff));
+                TestLog(kLogModule_SecurityManager, kLogCategory_Progress, "Decrypted %u bytes from node %" PRIx64, 64u,
+                        static_cast<uint64_t>(i) * 7919);
+                TestLog(kLogModule_DeviceLayer, kLogCategory_Progress, "Timer %s fired after %" PRIu64 " us", "retransmit",
+                        kWorkUsec);
+            }
+
+            elapsed = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+            total += elapsed;
+            max = (elapsed > max) ? elapsed : max;
+        }
+
+        if (mode >= 2)
+        {
+            ChipLinuxAsyncLog::Instance().Flush();
+            ChipLinuxAsyncLog::Instance().Shutdown();
+        }
+
+        printf("Event loop iteration with 3 progress messages, %s: mean %" PRIu64 " ns, max %" PRIu64 " us\n", kModes[mode],
+               total * 1000 / kIterations, max);
+
+        if (mode == 3)
+        {
+            DecodedLog log;
+
+            NL_TEST_ASSERT(inSuite, ReadBinaryLog(TEST_ASYNC_LOG_PATH, log));
+            NL_TEST_ASSERT(inSuite, log.mMessages.size() + log.mDropped == kIterations * 3);
+            printf("Async log to file: %zu messages written, %" PRIu32 " dropped\n", log.mMessages.size(), log.mDropped);
+            unlink(TEST_ASYNC_LOG_PATH);
+        }
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test ChipLinuxAsyncLog::InitShutdown", TestAsyncLog_InitShutdown),
+    NL_TEST_DEF("Test ChipLinuxAsyncLog::BinaryRoundTrip", TestAsyncLog_BinaryRoundTrip),
+    NL_TEST_DEF("Test ChipLinuxAsyncLog::Overflow", TestAsyncLog_Overflow),
+    NL_TEST_DEF("Test ChipLinuxAsyncLog::Benchmark", TestAsyncLog_Benchmark),
+
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void * inContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+static int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+int TestAsyncLog()
+{
+    nlTestSuite theSuite = { "CHIP asynchronous log tests", &sTests[0], TestSetup, TestTeardown };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAsyncLog)
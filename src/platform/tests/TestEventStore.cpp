@@ -0,0 +1,556 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the persistent,
+ *      memory-mapped event store.
+ *
+ */
+
+#include "TestEventStore.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+#include <platform/Linux/CHIPLinuxEventStore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+
+using namespace chip;
+using namespace chip::TLV;
+using namespace chip::DeviceLayer::Internal;
+
+#define TEST_EVENT_LOG_TEMPLATE "/tmp/chip_test_events_XXXXXX"
+
+// Offset of LogHeader::mDataLength in the log file.
+#define TEST_EVENT_LOG_DATA_LENGTH_OFFSET 16
+
+// =================================
+//      Helpers
+// =================================
+
+enum
+{
+    kTag_TestValue = 2,
+    kTag_TestData  = 3,
+};
+
+struct TestEvent
+{
+    uint32_t value;
+    uint32_t dataLen;
+};
+
+static CHIP_ERROR WriteTestEvent(TLVWriter & writer, void * appData)
+{
+    const TestEvent * event = static_cast<const TestEvent *>(appData);
+    static const uint8_t sData[256] = { 0 };
+    CHIP_ERROR err;
+
+    err = writer.Put(ContextTag(kTag_TestValue), event->value);
+    SuccessOrExit(err);
+
+    if (event->dataLen > 0)
+    {
+        err = writer.PutBytes(ContextTag(kTag_TestData), sData, event->dataLen);
+    }
+
+exit:
+    return err;
+}
+
+static CHIP_ERROR AppendTestEvent(ChipLinuxEventStore & store, uint64_t timestamp, uint32_t value, uint32_t dataLen = 0)
+{
+    TestEvent event = { value, dataLen };
+    uint64_t eventNumber;
+
+    return store.AppendEvent(timestamp, WriteTestEvent, &event, eventNumber);
+}
+
+// Creates an empty file, with a name of its own, to back a test log.
+static bool CreateTestLog(char (&path)[sizeof(TEST_EVENT_LOG_TEMPLATE)])
+{
+    int fd;
+
+    memcpy(path, TEST_EVENT_LOG_TEMPLATE, sizeof(TEST_EVENT_LOG_TEMPLATE));
+    fd = mkstemp(path);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    close(fd);
+    return true;
+}
+
+// Checks that buf holds consecutive events starting at firstEventNumber, whose
+// value is their event number plus valueBias.  Returns the number of events.
+static uint32_t CheckFetchedEvents(nlTestSuite * inSuite, const uint8_t * buf, uint32_t len, uint64_t firstEventNumber,
+                                   int64_t valueBias)
+{
+    TLVReader reader;
+    uint32_t count = 0;
+
+    reader.Init(buf, len);
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        TLVType container;
+        uint64_t eventNumber;
+        uint64_t timestamp;
+        uint32_t value;
+
+        NL_TEST_ASSERT(inSuite, reader.EnterContainer(container) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(ChipLinuxEventStore::kTag_EventNumber)) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(eventNumber) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(ChipLinuxEventStore::kTag_Timestamp)) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(timestamp) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_TestValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.ExitContainer(container) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, eventNumber == firstEventNumber + count);
+        NL_TEST_ASSERT(inSuite, static_cast<int64_t>(value) == static_cast<int64_t>(eventNumber) + valueBias);
+        count++;
+    }
+
+    return count;
+}
+
+static uint32_t FetchAll(nlTestSuite * inSuite, ChipLinuxEventStore & store, uint64_t & ioEventNumber, uint8_t * buf,
+                         uint32_t bufSize, int64_t valueBias)
+{
+    uint32_t count = 0;
+    CHIP_ERROR err;
+
+    do
+    {
+        TLVWriter writer;
+        uint64_t first = store.GetFirstEventNumber();
+
+        // Fetching from an evicted event starts at the oldest one.
+        if (first < ioEventNumber)
+            first = ioEventNumber;
+
+        writer.Init(buf, bufSize);
+        err = store.FetchEventsSince(writer, ioEventNumber);
+        NL_TEST_ASSERT(inSuite, err == CHIP_END_OF_TLV || err == CHIP_ERROR_BUFFER_TOO_SMALL);
+        NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+        count += CheckFetchedEvents(inSuite, buf, writer.GetLengthWritten(), first, valueBias);
+    } while (err == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    return count;
+}
+
+// =================================
+//      Unit tests
+// =================================
+
+static void TestEventStore_AppendFetch(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    uint8_t buf[64];
+    uint8_t bigBuf[1024];
+    uint64_t eventNumber = 0;
+    TLVWriter writer;
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, 4096) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.GetFirstEventNumber() == 1);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 1);
+
+    writer.Init(bigBuf, sizeof(bigBuf));
+    NL_TEST_ASSERT(inSuite, store.FetchEventsSince(writer, eventNumber) == CHIP_END_OF_TLV);
+
+    for (uint32_t i = 1; i <= 20; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, i, i + 100) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, store.GetFirstEventNumber() == 1);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 21);
+
+    // Timestamps must not go backwards.
+    NL_TEST_ASSERT(inSuite, AppendTestEvent(store, 10, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 21);
+
+    // Everything fits.
+    eventNumber = 1;
+    writer.Init(bigBuf, sizeof(bigBuf));
+    NL_TEST_ASSERT(inSuite, store.FetchEventsSince(writer, eventNumber) == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 21);
+    NL_TEST_ASSERT(inSuite, CheckFetchedEvents(inSuite, bigBuf, writer.GetLengthWritten(), 1, 100) == 20);
+
+    // From the middle of the log.
+    eventNumber = 15;
+    writer.Init(bigBuf, sizeof(bigBuf));
+    NL_TEST_ASSERT(inSuite, store.FetchEventsSince(writer, eventNumber) == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 21);
+    NL_TEST_ASSERT(inSuite, CheckFetchedEvents(inSuite, bigBuf, writer.GetLengthWritten(), 15, 100) == 6);
+
+    // In several rounds, through a small buffer.
+    eventNumber = 1;
+    NL_TEST_ASSERT(inSuite, FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 100) == 20);
+    NL_TEST_ASSERT(inSuite, eventNumber == 21);
+
+    store.Shutdown();
+    unlink(path);
+}
+
+static void TestEventStore_Restart(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    uint8_t buf[1024];
+    uint64_t eventNumber;
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, 4096) == CHIP_NO_ERROR);
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, i, i) == CHIP_NO_ERROR);
+    }
+    store.Shutdown();
+
+    // The events and the numbering survive a restart.
+    NL_TEST_ASSERT(inSuite, store.Init(path, 4096) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.GetFirstEventNumber() == 1);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 11);
+    NL_TEST_ASSERT(inSuite, AppendTestEvent(store, 5, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, AppendTestEvent(store, 11, 11) == CHIP_NO_ERROR);
+
+    eventNumber = 1;
+    NL_TEST_ASSERT(inSuite, FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 0) == 11);
+    store.Shutdown();
+
+    // A log of a different size starts over.
+    NL_TEST_ASSERT(inSuite, store.Init(path, 8192) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 1);
+    store.Shutdown();
+
+    unlink(path);
+}
+
+static void TestEventStore_Recover(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    uint8_t buf[1024];
+    uint64_t eventNumber;
+    uint32_t dataLength;
+    FILE * file;
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, 4096) == CHIP_NO_ERROR);
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, i, i) == CHIP_NO_ERROR);
+    }
+    store.Shutdown();
+
+    // Pretend the process stopped while writing an 11th event: the log
+    // length covers a few bytes that are not a valid event.
+    file = fopen(path, "r+b");
+    NL_TEST_ASSERT(inSuite, file != nullptr);
+    if (file != nullptr)
+    {
+        NL_TEST_ASSERT(inSuite, fseek(file, TEST_EVENT_LOG_DATA_LENGTH_OFFSET, SEEK_SET) == 0);
+        NL_TEST_ASSERT(inSuite, fread(&dataLength, sizeof(dataLength), 1, file) == 1);
+        dataLength += 7;
+        NL_TEST_ASSERT(inSuite, fseek(file, TEST_EVENT_LOG_DATA_LENGTH_OFFSET, SEEK_SET) == 0);
+        NL_TEST_ASSERT(inSuite, fwrite(&dataLength, sizeof(dataLength), 1, file) == 1);
+        fclose(file);
+    }
+
+    NL_TEST_ASSERT(inSuite, store.Init(path, 4096) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 11);
+    NL_TEST_ASSERT(inSuite, AppendTestEvent(store, 11, 11) == CHIP_NO_ERROR);
+
+    eventNumber = 1;
+    NL_TEST_ASSERT(inSuite, FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 0) == 11);
+    store.Shutdown();
+
+    unlink(path);
+}
+
+static void TestEventStore_Eviction(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    uint8_t buf[512];
+    uint64_t eventNumber;
+    uint64_t firstEventNumber;
+    uint32_t count;
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, 16 * 1024) == CHIP_NO_ERROR);
+
+    // Events of varying size, several times the size of the log, so that
+    // the index wraps around as well.
+    for (uint32_t i = 1; i <= 2000; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, i, i + 7, i % 97) == CHIP_NO_ERROR);
+    }
+
+    firstEventNumber = store.GetFirstEventNumber();
+    NL_TEST_ASSERT(inSuite, firstEventNumber > 1);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 2001);
+
+    // Fetching from an evicted event starts at the oldest one.
+    eventNumber = 1;
+    count       = FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 7);
+    NL_TEST_ASSERT(inSuite, eventNumber == 2001);
+    NL_TEST_ASSERT(inSuite, count == 2001 - firstEventNumber);
+
+    // Fetching from any event still in the log starts at that event.
+    for (uint64_t from = firstEventNumber; from < 2001; from += 37)
+    {
+        TLVWriter writer;
+        eventNumber = from;
+        writer.Init(buf, sizeof(buf));
+        NL_TEST_ASSERT(inSuite, store.FetchEventsSince(writer, eventNumber) != CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, CheckFetchedEvents(inSuite, buf, writer.GetLengthWritten(), from, 7) == eventNumber - from);
+    }
+
+    // The log survives a restart after wrapping around.
+    store.Shutdown();
+    NL_TEST_ASSERT(inSuite, store.Init(path, 16 * 1024) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.GetFirstEventNumber() == firstEventNumber);
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 2001);
+
+    eventNumber = 1;
+    NL_TEST_ASSERT(inSuite, FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 7) == count);
+
+    // An event larger than the log is rejected, and the log remains usable.
+    {
+        static uint8_t sHuge[20000];
+        struct Huge
+        {
+            static CHIP_ERROR Write(TLVWriter & writer, void * appData)
+            {
+                return writer.PutBytes(ContextTag(kTag_TestData), sHuge, sizeof(sHuge));
+            }
+        };
+        uint64_t unused;
+        NL_TEST_ASSERT(inSuite, store.AppendEvent(2001, Huge::Write, nullptr, unused) != CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, store.GetNextEventNumber() == 2001);
+    NL_TEST_ASSERT(inSuite, AppendTestEvent(store, 2001, 2001 + 7) == CHIP_NO_ERROR);
+
+    eventNumber = 1;
+    FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 7);
+    NL_TEST_ASSERT(inSuite, eventNumber == 2002);
+    store.Shutdown();
+
+    unlink(path);
+}
+
+static void TestEventStore_FindByTimestamp(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    uint64_t eventNumber;
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, 64 * 1024) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(0, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 1);
+
+    // Event n has timestamp 10 * ((n + 1) / 2): two events per timestamp.
+    for (uint32_t i = 1; i <= 1000; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, 10 * ((i + 1) / 2), i, 40) == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(0, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 1);
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(10, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 1);
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(11, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 3);
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(2500, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 499);
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(5000, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 999);
+    NL_TEST_ASSERT(inSuite, store.FindEventByTimestamp(5001, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, eventNumber == 1001);
+
+    store.Shutdown();
+    unlink(path);
+}
+
+static void TestEventStore_ConcurrentFetch(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> fetches(0);
+    std::atomic<uint32_t> badFetches(0);
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, 16 * 1024) == CHIP_NO_ERROR);
+
+    // The reader keeps fetching from where it stopped while events are
+    // appended and evicted; every fetch must see whole, consecutive events.
+    std::thread reader([&]() {
+        uint8_t buf[256];
+        uint64_t eventNumber = 1;
+
+        while (!done)
+        {
+            TLVWriter writer;
+            TLVReader events;
+            uint64_t expected = 0;
+
+            writer.Init(buf, sizeof(buf));
+            store.FetchEventsSince(writer, eventNumber);
+            writer.Finalize();
+            fetches++;
+
+            events.Init(buf, writer.GetLengthWritten());
+            while (events.Next() == CHIP_NO_ERROR)
+            {
+                TLVType container;
+                uint64_t number;
+                uint32_t value;
+
+                if (events.EnterContainer(container) != CHIP_NO_ERROR || events.Next() != CHIP_NO_ERROR ||
+                    events.Get(number) != CHIP_NO_ERROR || events.Next() != CHIP_NO_ERROR || events.Next() != CHIP_NO_ERROR ||
+                    events.Get(value) != CHIP_NO_ERROR || events.ExitContainer(container) != CHIP_NO_ERROR ||
+                    (expected != 0 && number != expected) || value != number)
+                {
+                    badFetches++;
+                    break;
+                }
+                expected = number + 1;
+            }
+        }
+    });
+
+    for (uint32_t i = 1; i <= 20000; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, i, i, i % 61) == CHIP_NO_ERROR);
+    }
+
+    done = true;
+    reader.join();
+
+    NL_TEST_ASSERT(inSuite, fetches > 0);
+    NL_TEST_ASSERT(inSuite, badFetches == 0);
+
+    store.Shutdown();
+    unlink(path);
+}
+
+static void TestEventStore_FillAndSeek(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kLogSize = 256 * 1024;
+    ChipLinuxEventStore store;
+    char path[sizeof(TEST_EVENT_LOG_TEMPLATE)];
+    uint8_t buf[2048];
+    uint64_t eventNumber;
+    uint64_t firstEventNumber, nextEventNumber;
+    uint32_t appended = 0;
+    uint32_t fetched;
+
+    NL_TEST_ASSERT(inSuite, CreateTestLog(path));
+    NL_TEST_ASSERT(inSuite, store.Init(path, kLogSize) == CHIP_NO_ERROR);
+
+    // Fill the log and a quarter more, so that appends also evict.
+    while (appended < kLogSize / 64 + kLogSize / 256)
+    {
+        appended++;
+        NL_TEST_ASSERT(inSuite, AppendTestEvent(store, appended, appended, 64) == CHIP_NO_ERROR);
+    }
+
+    firstEventNumber = store.GetFirstEventNumber();
+    nextEventNumber  = store.GetNextEventNumber();
+    NL_TEST_ASSERT(inSuite, firstEventNumber > 1);
+    NL_TEST_ASSERT(inSuite, nextEventNumber == appended + 1);
+
+    // Fetch the whole log.
+    eventNumber = firstEventNumber;
+    fetched     = FetchAll(inSuite, store, eventNumber, buf, sizeof(buf), 0);
+    NL_TEST_ASSERT(inSuite, fetched == nextEventNumber - firstEventNumber);
+
+    // Fetch a few events from random positions.
+    srand(1);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        TLVWriter writer;
+        const uint64_t from = firstEventNumber + static_cast<uint64_t>(rand()) % (nextEventNumber - firstEventNumber);
+
+        eventNumber = from;
+        writer.Init(buf, 256);
+        store.FetchEventsSince(writer, eventNumber);
+        NL_TEST_ASSERT(inSuite, eventNumber > from);
+    }
+
+    store.Shutdown();
+    unlink(path);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test ChipLinuxEventStore::AppendFetch", TestEventStore_AppendFetch),
+    NL_TEST_DEF("Test ChipLinuxEventStore::Restart", TestEventStore_Restart),
+    NL_TEST_DEF("Test ChipLinuxEventStore::Recover", TestEventStore_Recover),
+    NL_TEST_DEF("Test ChipLinuxEventStore::Eviction", TestEventStore_Eviction),
+    NL_TEST_DEF("Test ChipLinuxEventStore::FindByTimestamp", TestEventStore_FindByTimestamp),
+    NL_TEST_DEF("Test ChipLinuxEventStore::ConcurrentFetch", TestEventStore_ConcurrentFetch),
+    NL_TEST_DEF("Test ChipLinuxEventStore::FillAndSeek", TestEventStore_FillAndSeek),
+
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void * inContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+static int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+int TestEventStore()
+{
+    nlTestSuite theSuite = { "CHIP event store tests", &sTests[0], TestSetup, TestTeardown };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestEventStore)
@@ -0,0 +1,280 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the write batches of the
+ *      Linux PosixConfig, against INI files in a temporary directory.  It
+ *      also counts the writes of those files that provisioning takes.
+ *
+ */
+
+#include "TestPosixConfig.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <thread>
+
+#include <nlunit-test.h>
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+
+#include <platform/ConfigurationManager.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/PosixConfig.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+using namespace chip::DeviceLayer::Internal;
+
+// =================================
+//      Helpers
+// =================================
+
+static char sTestDir[]        = "/tmp/chip-test-posix-config-XXXXXX";
+static char sConfigPath[64]   = "";
+static char sCountersPath[64] = "";
+static int sWriteWatch        = -1;
+
+static const PosixConfig::Key kConfigKey_TestA   = { PosixConfig::kConfigNamespace_ChipConfig, "test-a" };
+static const PosixConfig::Key kConfigKey_TestB   = { PosixConfig::kConfigNamespace_ChipConfig, "test-b" };
+static const PosixConfig::Key kCountersKey_TestA = { PosixConfig::kConfigNamespace_ChipCounters, "test-a" };
+
+static void RemoveTestFiles()
+{
+    for (const char * path : { sConfigPath, sCountersPath })
+    {
+        char tmpPath[sizeof(sConfigPath) + 4];
+
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+        unlink(path);
+        unlink(tmpPath);
+    }
+}
+
+// Starts each test from empty INI files.
+static bool InitTestNamespaces()
+{
+    RemoveTestFiles();
+
+    return PosixConfig::InitNamespace(PosixConfig::kConfigNamespace_ChipConfig, sConfigPath) == CHIP_NO_ERROR &&
+        PosixConfig::InitNamespace(PosixConfig::kConfigNamespace_ChipCounters, sCountersPath) == CHIP_NO_ERROR;
+}
+
+// Returns whether the INI file at path holds key, that is whether a write of key has been committed.
+static bool IsCommitted(const char * path, const PosixConfig::Key & key)
+{
+    ChipLinuxStorage storage;
+
+    return storage.Init(path) == CHIP_NO_ERROR && storage.HasValue(key.Name);
+}
+
+// Returns the number of INI files written in the test directory since the last call.  Every
+// commit of a partition writes a temporary file and renames it over the INI file.  Both sides
+// of the renames are watched, as inotify merges identical events that follow each other.
+static uint32_t CountFileWrites()
+{
+    alignas(struct inotify_event) char events[1024];
+    uint32_t count = 0;
+    ssize_t length;
+
+    while ((length = read(sWriteWatch, events, sizeof(events))) > 0)
+    {
+        for (char * next = events; next < events + length;)
+        {
+            const struct inotify_event * event = reinterpret_cast<const struct inotify_event *>(next);
+
+            count += (event->mask & IN_MOVED_TO) ? 1 : 0;
+            next += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    return count;
+}
+
+// =================================
+//      Unit tests
+// =================================
+
+static void TestPosixConfig_CommitWithoutBatch(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, InitTestNamespaces());
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kCountersKey_TestA, static_cast<uint32_t>(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsCommitted(sCountersPath, kCountersKey_TestA));
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::CommitWriteBatch() == CHIP_ERROR_INCORRECT_STATE);
+}
+
+static void TestPosixConfig_Batch(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t value = 0;
+
+    NL_TEST_ASSERT(inSuite, InitTestNamespaces());
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::BeginWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kConfigKey_TestA, static_cast<uint32_t>(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kConfigKey_TestB, static_cast<uint32_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kCountersKey_TestA, static_cast<uint32_t>(3)) == CHIP_NO_ERROR);
+
+    // The values can be read back, but neither partition is committed yet.
+    NL_TEST_ASSERT(inSuite, PosixConfig::ReadConfigValue(kConfigKey_TestB, value) == CHIP_NO_ERROR && value == 2);
+    NL_TEST_ASSERT(inSuite, PosixConfig::ReadConfigValue(kCountersKey_TestA, value) == CHIP_NO_ERROR && value == 3);
+    NL_TEST_ASSERT(inSuite, !IsCommitted(sConfigPath, kConfigKey_TestA));
+    NL_TEST_ASSERT(inSuite, !IsCommitted(sCountersPath, kCountersKey_TestA));
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::CommitWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, kConfigKey_TestA));
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, kConfigKey_TestB));
+    NL_TEST_ASSERT(inSuite, IsCommitted(sCountersPath, kCountersKey_TestA));
+}
+
+static void TestPosixConfig_NestedBatch(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, InitTestNamespaces());
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::BeginWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kConfigKey_TestA, static_cast<uint32_t>(1)) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::BeginWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kCountersKey_TestA, static_cast<uint32_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::CommitWriteBatch() == CHIP_NO_ERROR);
+
+    // Only the outermost batch commits.
+    NL_TEST_ASSERT(inSuite, !IsCommitted(sConfigPath, kConfigKey_TestA));
+    NL_TEST_ASSERT(inSuite, !IsCommitted(sCountersPath, kCountersKey_TestA));
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::CommitWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, kConfigKey_TestA));
+    NL_TEST_ASSERT(inSuite, IsCommitted(sCountersPath, kCountersKey_TestA));
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::CommitWriteBatch() == CHIP_ERROR_INCORRECT_STATE);
+}
+
+static void TestPosixConfig_BatchPerThread(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR writeErr  = CHIP_ERROR_INTERNAL;
+    CHIP_ERROR commitErr = CHIP_NO_ERROR;
+
+    NL_TEST_ASSERT(inSuite, InitTestNamespaces());
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::BeginWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(kCountersKey_TestA, static_cast<uint32_t>(1)) == CHIP_NO_ERROR);
+
+    // The batch of this thread neither defers the writes of another thread, nor can be committed by it.
+    std::thread other([&writeErr, &commitErr]() {
+        writeErr  = PosixConfig::WriteConfigValue(kConfigKey_TestA, static_cast<uint32_t>(2));
+        commitErr = PosixConfig::CommitWriteBatch();
+    });
+    other.join();
+
+    NL_TEST_ASSERT(inSuite, writeErr == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, commitErr == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, kConfigKey_TestA));
+    NL_TEST_ASSERT(inSuite, !IsCommitted(sCountersPath, kCountersKey_TestA));
+
+    NL_TEST_ASSERT(inSuite, PosixConfig::CommitWriteBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsCommitted(sCountersPath, kCountersKey_TestA));
+}
+
+static void TestPosixConfig_ProvisioningWrites(nlTestSuite * inSuite, void * inContext)
+{
+    const uint64_t serviceId        = 0x18B4300200000001;
+    const uint8_t serviceConfig[64] = { 0x15, 0x36, 0x01, 0x18 };
+    const char * accountId          = "test-account";
+
+    NL_TEST_ASSERT(inSuite, InitTestNamespaces());
+    CountFileWrites();
+
+    // Stored one by one, each provisioning value is a write of the config file.
+    NL_TEST_ASSERT(inSuite, PosixConfig::WriteConfigValue(PosixConfig::kConfigKey_ServiceId, serviceId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ConfigurationMgr().StoreServiceConfig(serviceConfig, sizeof(serviceConfig)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ConfigurationMgr().StorePairedAccountId(accountId, strlen(accountId)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountFileWrites() == 3);
+
+    // The provisioning flow stores the same values with a single write, and clears them with another.
+    NL_TEST_ASSERT(inSuite,
+                   ConfigurationMgr().StoreServiceProvisioningData(serviceId, serviceConfig, sizeof(serviceConfig), accountId,
+                                                                   strlen(accountId)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountFileWrites() == 1);
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, PosixConfig::kConfigKey_ServiceId));
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, PosixConfig::kConfigKey_ServiceConfig));
+    NL_TEST_ASSERT(inSuite, IsCommitted(sConfigPath, PosixConfig::kConfigKey_PairedAccountId));
+
+    NL_TEST_ASSERT(inSuite, ConfigurationMgr().ClearServiceProvisioningData() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountFileWrites() == 1);
+    NL_TEST_ASSERT(inSuite, !IsCommitted(sConfigPath, PosixConfig::kConfigKey_ServiceId));
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test PosixConfig::CommitWithoutBatch", TestPosixConfig_CommitWithoutBatch),
+    NL_TEST_DEF("Test PosixConfig::Batch", TestPosixConfig_Batch),
+    NL_TEST_DEF("Test PosixConfig::NestedBatch", TestPosixConfig_NestedBatch),
+    NL_TEST_DEF("Test PosixConfig::BatchPerThread", TestPosixConfig_BatchPerThread),
+    NL_TEST_DEF("Test PosixConfig::ProvisioningWrites", TestPosixConfig_ProvisioningWrites),
+
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void * inContext)
+{
+    if (chip::Platform::MemoryInit() != CHIP_NO_ERROR || mkdtemp(sTestDir) == nullptr)
+    {
+        return FAILURE;
+    }
+
+    snprintf(sConfigPath, sizeof(sConfigPath), "%s/chip_config.ini", sTestDir);
+    snprintf(sCountersPath, sizeof(sCountersPath), "%s/chip_counters.ini", sTestDir);
+
+    sWriteWatch = inotify_init1(IN_NONBLOCK);
+    if (sWriteWatch < 0 || inotify_add_watch(sWriteWatch, sTestDir, IN_MOVED_FROM | IN_MOVED_TO) < 0)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+static int TestTeardown(void * inContext)
+{
+    close(sWriteWatch);
+    RemoveTestFiles();
+    rmdir(sTestDir);
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+int TestPosixConfig()
+{
+    nlTestSuite theSuite = { "CHIP PosixConfig tests", &sTests[0], TestSetup, TestTeardown };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPosixConfig)
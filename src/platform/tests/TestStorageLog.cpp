@@ -0,0 +1,431 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the append-only
+ *      key-value log backing ChipLinuxStorage.
+ *
+ */
+
+#include "TestStorageLog.h"
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+#define TEST_STORAGE_DIR_TEMPLATE "/tmp/chip_test_storage_XXXXXX"
+
+// =================================
+//      Helpers
+// =================================
+
+static const uint8_t sTestBlob[] = { 0x00, 0x01, 0xff, 0x00, 0x7f, 0x80, 0x0a, 0x0d, 0x3d, 0x5b, 0x5d, 0x00 };
+
+// The files of the tests live in a directory of their own, made when the suite
+// is set up, so that concurrent runs do not share them.
+static char sTestDir[sizeof(TEST_STORAGE_DIR_TEMPLATE)];
+static char sTestLogPath[sizeof(TEST_STORAGE_DIR_TEMPLATE) + 32];
+static char sTestIniPath[sizeof(TEST_STORAGE_DIR_TEMPLATE) + 32];
+
+static void RemoveTestFiles()
+{
+    char path[sizeof(sTestLogPath) + sizeof(".tmp")];
+
+    unlink(sTestLogPath);
+    snprintf(path, sizeof(path), "%s.tmp", sTestLogPath);
+    unlink(path);
+    unlink(sTestIniPath);
+    snprintf(path, sizeof(path), "%s.tmp", sTestIniPath);
+    unlink(path);
+}
+
+static long GetFileSize(const char * path)
+{
+    FILE * file = fopen(path, "rb");
+    long size   = -1;
+
+    if (file != nullptr)
+    {
+        if (fseek(file, 0, SEEK_END) == 0)
+        {
+            size = ftell(file);
+        }
+        fclose(file);
+    }
+
+    return size;
+}
+
+static bool FileContains(const char * path, const uint8_t * data, size_t dataLen)
+{
+    uint8_t buf[4096];
+    FILE * file = fopen(path, "rb");
+    size_t len;
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    len = fread(buf, 1, sizeof(buf), file);
+    fclose(file);
+
+    return memmem(buf, len, data, dataLen) != nullptr;
+}
+
+static bool HasStringValue(ChipLinuxStorageLog & log, const char * key, const char * expected)
+{
+    char buf[64];
+    size_t len;
+
+    return log.GetStringValue(key, buf, sizeof(buf), len) == CHIP_NO_ERROR && strcmp(buf, expected) == 0;
+}
+
+// =================================
+//      Unit tests
+// =================================
+
+static void TestStorageLog_RoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t blob[sizeof(sTestBlob)];
+    char str[32];
+    size_t len;
+    bool boolVal;
+    uint32_t u32Val;
+    uint64_t u64Val;
+
+    RemoveTestFiles();
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.InitLog(sTestLogPath, sTestIniPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("bool"));
+
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("bool", true) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("u32", static_cast<uint32_t>(0xfffffff0)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("u64", static_cast<uint64_t>(0xfedcba9876543210)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("str", "hello world") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueBin("bin", sTestBlob, sizeof(sTestBlob)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("removed", "soon") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, storage.ClearValue("removed") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.ClearValue("removed") == CHIP_ERROR_KEY_NOT_FOUND);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("str", "hello again") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    // Binary values are stored as they are, not in base64.
+    NL_TEST_ASSERT(inSuite, FileContains(sTestLogPath, sTestBlob, sizeof(sTestBlob)));
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.InitLog(sTestLogPath, sTestIniPath) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("bool", boolVal) == CHIP_NO_ERROR && boolVal);
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("u32", u32Val) == CHIP_NO_ERROR && u32Val == 0xfffffff0);
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("u64", u64Val) == CHIP_NO_ERROR && u64Val == 0xfedcba9876543210);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueStr("str", str, sizeof(str), len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, len == 11 && strcmp(str, "hello again") == 0);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueStr("str", str, 5, len) == CHIP_ERROR_BUFFER_TOO_SMALL && len == 11);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueBin("bin", blob, sizeof(blob), len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, len == sizeof(sTestBlob) && memcmp(blob, sTestBlob, len) == 0);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueBin("bin", blob, 4, len) == CHIP_ERROR_BUFFER_TOO_SMALL);
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("str", u32Val) == CHIP_ERROR_INVALID_ARGUMENT);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("removed"));
+
+        NL_TEST_ASSERT(inSuite, storage.ClearAll() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.InitLog(sTestLogPath, sTestIniPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("bool"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("bin"));
+    }
+
+    RemoveTestFiles();
+}
+
+static void TestStorageLog_Recover(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog log;
+    size_t firstCommitSize, secondCommitSize;
+    FILE * file;
+
+    RemoveTestFiles();
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.AddEntry("first", "1") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() == CHIP_NO_ERROR);
+    firstCommitSize = log.GetLogSize();
+    NL_TEST_ASSERT(inSuite, log.AddEntry("second", "2") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.RemoveEntry("first") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() == CHIP_NO_ERROR);
+    secondCommitSize = log.GetLogSize();
+    log.Close();
+
+    // Pretend the process stopped while writing the second commit: none of its changes are applied.
+    NL_TEST_ASSERT(inSuite, truncate(sTestLogPath, static_cast<off_t>(secondCommitSize - 3)) == 0);
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetLogSize() == firstCommitSize);
+    NL_TEST_ASSERT(inSuite, GetFileSize(sTestLogPath) == static_cast<long>(firstCommitSize));
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "first", "1"));
+    NL_TEST_ASSERT(inSuite, !log.HasValue("second"));
+
+    // New commits are appended after the last valid one.
+    NL_TEST_ASSERT(inSuite, log.AddEntry("third", "3") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() == CHIP_NO_ERROR);
+    secondCommitSize = log.GetLogSize();
+    log.Close();
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "first", "1"));
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "third", "3"));
+    log.Close();
+
+    // Corrupt the value of the last commit: its checksum no longer matches.
+    file = fopen(sTestLogPath, "r+b");
+    NL_TEST_ASSERT(inSuite, file != nullptr);
+    if (file != nullptr)
+    {
+        NL_TEST_ASSERT(inSuite, fseek(file, static_cast<long>(secondCommitSize - 1), SEEK_SET) == 0);
+        NL_TEST_ASSERT(inSuite, fputc('4', file) == '4');
+        fclose(file);
+    }
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetLogSize() == firstCommitSize);
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "first", "1"));
+    NL_TEST_ASSERT(inSuite, !log.HasValue("third"));
+    log.Close();
+
+    // Not a log at all.
+    file = fopen(sTestLogPath, "wb");
+    NL_TEST_ASSERT(inSuite, file != nullptr);
+    if (file != nullptr)
+    {
+        fputs("[DEFAULT]\nkey=value\n", file);
+        fclose(file);
+    }
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    RemoveTestFiles();
+}
+
+// Fails the writes that would grow a file past @p size, or lifts the limit with RLIM_INFINITY.
+static bool LimitFileSize(rlim_t size)
+{
+    struct rlimit limit;
+
+    if (getrlimit(RLIMIT_FSIZE, &limit) != 0)
+    {
+        return false;
+    }
+
+    limit.rlim_cur = (size == RLIM_INFINITY) ? limit.rlim_max : size;
+    return signal(SIGXFSZ, SIG_IGN) != SIG_ERR && setrlimit(RLIMIT_FSIZE, &limit) == 0;
+}
+
+static void TestStorageLog_CommitFailure(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog log;
+    size_t committedSize;
+
+    RemoveTestFiles();
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.AddEntry("kept", "1") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.AddEntry("removed", "2") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() == CHIP_NO_ERROR);
+    committedSize = log.GetLogSize();
+
+    // A failed commit rolls its changes back, so that the values match the log.
+    NL_TEST_ASSERT(inSuite, LimitFileSize(committedSize + 4));
+    NL_TEST_ASSERT(inSuite, log.AddEntry("kept", "changed") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.RemoveEntry("removed") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.AddEntry("added", "3") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "kept", "1"));
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "removed", "2"));
+    NL_TEST_ASSERT(inSuite, !log.HasValue("added"));
+
+    NL_TEST_ASSERT(inSuite, log.AddEntry("added", "3") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.RemoveAll() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.AddEntry("kept", "changed") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "kept", "1"));
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "removed", "2"));
+    NL_TEST_ASSERT(inSuite, !log.HasValue("added"));
+    NL_TEST_ASSERT(inSuite, log.GetLogSize() == committedSize);
+    NL_TEST_ASSERT(inSuite, GetFileSize(sTestLogPath) == static_cast<long>(committedSize));
+    NL_TEST_ASSERT(inSuite, LimitFileSize(RLIM_INFINITY));
+
+    // The log goes on from the last commit.
+    NL_TEST_ASSERT(inSuite, log.RemoveEntry("removed") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Commit() == CHIP_NO_ERROR);
+    log.Close();
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "kept", "1"));
+    NL_TEST_ASSERT(inSuite, !log.HasValue("removed"));
+    NL_TEST_ASSERT(inSuite, !log.HasValue("added"));
+    log.Close();
+
+    RemoveTestFiles();
+}
+
+static void TestStorageLog_Compaction(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kCommits = 20000;
+    ChipLinuxStorageLog log;
+    char value[32];
+    bool bounded = true;
+
+    RemoveTestFiles();
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, UINT32_MAX) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.AddEntry("constant", "unchanged") == CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < kCommits; i++)
+    {
+        snprintf(value, sizeof(value), "%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, log.AddEntry("counter", value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, log.Commit() == CHIP_NO_ERROR);
+        bounded = bounded && log.GetLogSize() <= ChipLinuxStorageLog::kCompactionMinSize + 64;
+    }
+    NL_TEST_ASSERT(inSuite, bounded);
+    NL_TEST_ASSERT(inSuite, GetFileSize(sTestLogPath) == static_cast<long>(log.GetLogSize()));
+
+    NL_TEST_ASSERT(inSuite, log.Compact() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetLogSize() < 64);
+    log.Close();
+
+    NL_TEST_ASSERT(inSuite, log.Open(sTestLogPath, 0) == CHIP_NO_ERROR);
+    snprintf(value, sizeof(value), "%" PRIu32, kCommits - 1);
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "counter", value));
+    NL_TEST_ASSERT(inSuite, HasStringValue(log, "constant", "unchanged"));
+    log.Close();
+
+    RemoveTestFiles();
+}
+
+static void TestStorageLog_LegacyImport(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t blob[sizeof(sTestBlob)];
+    char str[32];
+    size_t len;
+    uint32_t u32Val;
+
+    RemoveTestFiles();
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(sTestIniPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("u32", static_cast<uint32_t>(42)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("str", "legacy") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueBin("bin", sTestBlob, sizeof(sTestBlob)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.InitLog(sTestLogPath, sTestIniPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, access(sTestIniPath, F_OK) != 0);
+
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("u32", u32Val) == CHIP_NO_ERROR && u32Val == 42);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueStr("str", str, sizeof(str), len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, strcmp(str, "legacy") == 0);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueBin("bin", blob, sizeof(blob), len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, len == sizeof(sTestBlob) && memcmp(blob, sTestBlob, len) == 0);
+
+        // Rewritten values are stored natively.
+        NL_TEST_ASSERT(inSuite, storage.WriteValueBin("bin", sTestBlob, 4) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.ReadValueBin("bin", blob, sizeof(blob), len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, len == 4 && memcmp(blob, sTestBlob, len) == 0);
+    }
+
+    RemoveTestFiles();
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test ChipLinuxStorageLog::RoundTrip", TestStorageLog_RoundTrip),
+    NL_TEST_DEF("Test ChipLinuxStorageLog::Recover", TestStorageLog_Recover),
+    NL_TEST_DEF("Test ChipLinuxStorageLog::CommitFailure", TestStorageLog_CommitFailure),
+    NL_TEST_DEF("Test ChipLinuxStorageLog::Compaction", TestStorageLog_Compaction),
+    NL_TEST_DEF("Test ChipLinuxStorageLog::LegacyImport", TestStorageLog_LegacyImport),
+
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void * inContext)
+{
+    memcpy(sTestDir, TEST_STORAGE_DIR_TEMPLATE, sizeof(TEST_STORAGE_DIR_TEMPLATE));
+    if (mkdtemp(sTestDir) == nullptr)
+    {
+        return FAILURE;
+    }
+
+    snprintf(sTestLogPath, sizeof(sTestLogPath), "%s/storage.kvlog", sTestDir);
+    snprintf(sTestIniPath, sizeof(sTestIniPath), "%s/storage.ini", sTestDir);
+
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+static int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+
+    RemoveTestFiles();
+    rmdir(sTestDir);
+    return SUCCESS;
+}
+
+int TestStorageLog()
+{
+    nlTestSuite theSuite = { "CHIP storage log tests", &sTests[0], TestSetup, TestTeardown };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestStorageLog)
@@ -99,6 +99,8 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(nullptr), mPl
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+    this->mSocketWatches        = nullptr;
+    this->mNextReadySocketWatch = nullptr;
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -156,6 +158,11 @@ Error Layer::Shutdown()
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
     lReturn = mWakeEvent.Close();
     SuccessOrExit(lReturn);
+
+    while (this->mSocketWatches != nullptr)
+    {
+        this->RemoveSocketWatch(*this->mSocketWatches);
+    }
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
@@ -601,6 +608,22 @@ void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet,
     if (wakeEventFd + 1 > aSetSize)
         aSetSize = wakeEventFd + 1;
 
+    for (const SocketWatch * lWatch = this->mSocketWatches; lWatch != nullptr; lWatch = lWatch->mNext)
+    {
+        if (lWatch->mInterests == 0)
+            continue;
+
+        if (lWatch->mInterests & SocketWatch::kEvent_Read)
+            FD_SET(lWatch->mFD, aReadSet);
+        if (lWatch->mInterests & SocketWatch::kEvent_Write)
+            FD_SET(lWatch->mFD, aWriteSet);
+        if (lWatch->mInterests & SocketWatch::kEvent_Exception)
+            FD_SET(lWatch->mFD, aExceptionSet);
+
+        if (lWatch->mFD + 1 > aSetSize)
+            aSetSize = lWatch->mFD + 1;
+    }
+
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
     Timer::Epoch lAwakenEpoch =
         kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + static_cast<uint32_t>(aSleepTime.tv_usec) / 1000;
@@ -689,6 +712,35 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
     this->mHandleSelectThread = lThreadSelf;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
+    if (aSetSize > 0)
+    {
+        // As for endpoints, record the pending events of every watch before calling any of them back.
+        for (SocketWatch * lWatch = this->mSocketWatches; lWatch != nullptr; lWatch = lWatch->mNext)
+        {
+            lWatch->mPendingEvents = 0;
+            if ((lWatch->mInterests & SocketWatch::kEvent_Read) && FD_ISSET(lWatch->mFD, aReadSet))
+                lWatch->mPendingEvents |= SocketWatch::kEvent_Read;
+            if ((lWatch->mInterests & SocketWatch::kEvent_Write) && FD_ISSET(lWatch->mFD, aWriteSet))
+                lWatch->mPendingEvents |= SocketWatch::kEvent_Write;
+            if ((lWatch->mInterests & SocketWatch::kEvent_Exception) && FD_ISSET(lWatch->mFD, aExceptionSet))
+                lWatch->mPendingEvents |= SocketWatch::kEvent_Exception;
+        }
+
+        this->mNextReadySocketWatch = this->mSocketWatches;
+        while (this->mNextReadySocketWatch != nullptr)
+        {
+            SocketWatch * lWatch        = this->mNextReadySocketWatch;
+            const uint8_t lEvents       = lWatch->mPendingEvents;
+            this->mNextReadySocketWatch = lWatch->mNext;
+
+            lWatch->mPendingEvents = 0;
+            if (lEvents != 0)
+            {
+                lWatch->mReady(*lWatch, lEvents, lWatch->mAppState);
+            }
+        }
+    }
+
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer * lTimer = Timer::sPool.Get(*this, i);
@@ -738,6 +790,98 @@ void Layer::WakeSelect()
     }
 }
 
+/**
+ * Prepare a watch for registration with a Layer.
+ *
+ *  @param[in]  aFD         The file descriptor to watch.
+ *  @param[in]  aReady      The function to call when events of interest happen on the descriptor.
+ *  @param[in]  aAppState   The argument passed to @p aReady.
+ */
+void SocketWatch::Init(int aFD, ReadyFunct aReady, void * aAppState)
+{
+    this->mFD            = aFD;
+    this->mInterests     = 0;
+    this->mPendingEvents = 0;
+    this->mReady         = aReady;
+    this->mAppState      = aAppState;
+    this->mLayer         = nullptr;
+    this->mPrev          = nullptr;
+    this->mNext          = nullptr;
+}
+
+/**
+ * Start watching a file descriptor in the select loop, and wake the loop so that it picks up the new descriptor.
+ *
+ *  @param[in]  aWatch      A watch set up with SocketWatch::Init(), which must stay alive until removed.
+ *  @param[in]  aInterests  A combination of the SocketWatch::kEvent_* flags.
+ *
+ *  @retval #CHIP_SYSTEM_NO_ERROR                 On success.
+ *  @retval #CHIP_SYSTEM_ERROR_UNEXPECTED_STATE   If the layer is not initialized or the watch is already registered.
+ *  @retval #CHIP_SYSTEM_ERROR_BAD_ARGS           If the watch has no callback or its descriptor does not fit in an fd_set.
+ */
+Error Layer::AddSocketWatch(SocketWatch & aWatch, uint8_t aInterests)
+{
+    if (this->State() != kLayerState_Initialized || aWatch.mLayer != nullptr)
+        return CHIP_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    if (aWatch.mReady == nullptr || aWatch.mFD < 0 || aWatch.mFD >= FD_SETSIZE)
+        return CHIP_SYSTEM_ERROR_BAD_ARGS;
+
+    aWatch.mInterests     = aInterests;
+    aWatch.mPendingEvents = 0;
+    aWatch.mLayer         = this;
+    aWatch.mPrev          = nullptr;
+    aWatch.mNext          = this->mSocketWatches;
+    if (this->mSocketWatches != nullptr)
+        this->mSocketWatches->mPrev = &aWatch;
+    this->mSocketWatches = &aWatch;
+
+    this->WakeSelect();
+
+    return CHIP_SYSTEM_NO_ERROR;
+}
+
+/**
+ * Change the events a registered watch waits for.  Events that happened but were not yet reported and are no longer of
+ * interest are dropped.
+ */
+void Layer::UpdateSocketWatch(SocketWatch & aWatch, uint8_t aInterests)
+{
+    if (aWatch.mLayer != this || aWatch.mInterests == aInterests)
+        return;
+
+    aWatch.mInterests = aInterests;
+    aWatch.mPendingEvents &= aInterests;
+
+    this->WakeSelect();
+}
+
+/**
+ * Stop watching a file descriptor.  The watch is not called back anymore, even for events already reported by select(),
+ * and may be freed or registered again once this returns.
+ */
+void Layer::RemoveSocketWatch(SocketWatch & aWatch)
+{
+    if (aWatch.mLayer != this)
+        return;
+
+    if (this->mNextReadySocketWatch == &aWatch)
+        this->mNextReadySocketWatch = aWatch.mNext;
+
+    if (aWatch.mPrev != nullptr)
+        aWatch.mPrev->mNext = aWatch.mNext;
+    else
+        this->mSocketWatches = aWatch.mNext;
+    if (aWatch.mNext != nullptr)
+        aWatch.mNext->mPrev = aWatch.mPrev;
+
+    aWatch.mInterests     = 0;
+    aWatch.mPendingEvents = 0;
+    aWatch.mLayer         = nullptr;
+    aWatch.mPrev          = nullptr;
+    aWatch.mNext          = nullptr;
+}
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
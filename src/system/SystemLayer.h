@@ -111,6 +111,51 @@ private:
 };
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+/**
+ *  @class SocketWatch
+ *
+ *  @brief
+ *      A file descriptor that the select loop of a Layer watches on behalf of code outside of the Inet layer.
+ *
+ *      The owner allocates the watch and keeps it alive while it is registered with Layer::AddSocketWatch().  Registered
+ *      watches are kept in a list, so registering, updating and removing one takes constant time.
+ */
+class DLL_EXPORT SocketWatch
+{
+public:
+    enum
+    {
+        kEvent_Read      = 0x01, /**< The descriptor is readable. */
+        kEvent_Write     = 0x02, /**< The descriptor is writable. */
+        kEvent_Exception = 0x04  /**< The descriptor has an exceptional condition. */
+    };
+
+    /**
+     * Called from Layer::HandleSelectResult() with the events that happened among those of interest.
+     */
+    typedef void (*ReadyFunct)(SocketWatch & aWatch, uint8_t aEvents, void * aAppState);
+
+    void Init(int aFD, ReadyFunct aReady, void * aAppState);
+
+    int GetFD() const { return mFD; }
+    uint8_t GetInterests() const { return mInterests; }
+    bool IsActive() const { return mLayer != nullptr; }
+
+private:
+    friend class Layer;
+
+    int mFD;
+    uint8_t mInterests;
+    uint8_t mPendingEvents;
+    ReadyFunct mReady;
+    void * mAppState;
+    Layer * mLayer;
+    SocketWatch * mPrev;
+    SocketWatch * mNext;
+};
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+
 /**
  *  @class Layer
  *
@@ -151,6 +196,10 @@ public:
     void PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet, struct timeval & aSleepTime);
     void HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet);
     void WakeSelect();
+
+    Error AddSocketWatch(SocketWatch & aWatch, uint8_t aInterests);
+    void UpdateSocketWatch(SocketWatch & aWatch, uint8_t aInterests);
+    void RemoveSocketWatch(SocketWatch & aWatch);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -190,6 +239,8 @@ private:
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
     SystemWakeEvent mWakeEvent;
+    SocketWatch * mSocketWatches;
+    SocketWatch * mNextReadySocketWatch; // Dispatch cursor, advanced when the watch it points to is removed
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
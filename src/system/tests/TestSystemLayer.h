@@ -31,6 +31,7 @@ extern "C" {
 int TestSystemErrorStr(void);
 int TestSystemObject(void);
 int TestSystemPacketBuffer(void);
+int TestSystemSocketWatch(void);
 int TestSystemTimer(void);
 int TestSystemWakeEvent(void);
 int TestTimeSource(void);
@@ -0,0 +1,325 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::SocketWatch</tt>,
+ *      the file descriptors the select loop of a Layer watches for code
+ *      outside of the Inet layer, such as the Avahi mDNS client.
+ *
+ *      The loop overhead test runs as many watches and pending timers as
+ *      concurrent browse and resolve operations would hold, and reports
+ *      the cost of a loop iteration.  Only correctness is asserted; the
+ *      rates are informative.
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+// config
+#include <system/SystemConfig.h>
+
+// module header
+#include "TestSystemLayer.h"
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/TestUtils.h>
+#include <system/SystemError.h>
+#include <system/SystemLayer.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+using chip::ErrorStr;
+using namespace chip::System;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+namespace {
+
+constexpr size_t kMaxPipes = 64;
+
+struct Pipe
+{
+    int mFDs[2];
+    SocketWatch mWatch;
+    unsigned mCalls;
+    uint8_t mEvents;
+};
+
+struct TestContext
+{
+    Layer mLayer;
+    Pipe mPipes[kMaxPipes];
+    size_t mNumPipes;
+    nlTestSuite * mTestSuite;
+};
+
+void HandleReady(SocketWatch & aWatch, uint8_t aEvents, void * aAppState)
+{
+    Pipe & lPipe = *static_cast<Pipe *>(aAppState);
+
+    lPipe.mCalls++;
+    lPipe.mEvents = aEvents;
+}
+
+void HandleReadyRemoveOthers(SocketWatch & aWatch, uint8_t aEvents, void * aAppState)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aAppState);
+
+    for (size_t i = 0; i < lContext.mNumPipes; i++)
+    {
+        Pipe & lPipe = lContext.mPipes[i];
+
+        if (&lPipe.mWatch == &aWatch)
+            lPipe.mCalls++;
+        else
+            lContext.mLayer.RemoveSocketWatch(lPipe.mWatch);
+    }
+}
+
+void HandleTimer(Layer * aLayer, void * aAppState, Error aError) {}
+
+bool OpenPipes(TestContext & aContext, size_t aNumPipes)
+{
+    for (aContext.mNumPipes = 0; aContext.mNumPipes < aNumPipes; aContext.mNumPipes++)
+    {
+        Pipe & lPipe = aContext.mPipes[aContext.mNumPipes];
+
+        if (pipe(lPipe.mFDs) != 0)
+            return false;
+        lPipe.mWatch.Init(lPipe.mFDs[0], HandleReady, &lPipe);
+        lPipe.mCalls  = 0;
+        lPipe.mEvents = 0;
+    }
+
+    return true;
+}
+
+void ClosePipes(TestContext & aContext)
+{
+    for (size_t i = 0; i < aContext.mNumPipes; i++)
+    {
+        aContext.mLayer.RemoveSocketWatch(aContext.mPipes[i].mWatch);
+        close(aContext.mPipes[i].mFDs[0]);
+        close(aContext.mPipes[i].mFDs[1]);
+    }
+    aContext.mNumPipes = 0;
+}
+
+void MakeReadable(Pipe & aPipe)
+{
+    const uint8_t lByte = 0;
+    VerifyOrDie(write(aPipe.mFDs[1], &lByte, 1) == 1);
+}
+
+void Drain(Pipe & aPipe)
+{
+    uint8_t lByte;
+    VerifyOrDie(read(aPipe.mFDs[0], &lByte, 1) == 1);
+}
+
+// Runs one iteration of a select loop without sleeping.
+void ServiceEvents(Layer & aLayer)
+{
+    fd_set readFDs, writeFDs, exceptFDs;
+    timeval sleepTime = { 0, 0 };
+    int numFDs        = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+    sleepTime     = { 0, 0 };
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    if (selectRes < 0)
+    {
+        printf("select failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+void TestReadable(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Pipe & lPipe           = lContext.mPipes[0];
+
+    NL_TEST_ASSERT(inSuite, OpenPipes(lContext, 1));
+    NL_TEST_ASSERT(inSuite, lContext.mLayer.AddSocketWatch(lPipe.mWatch, SocketWatch::kEvent_Read) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, lContext.mLayer.AddSocketWatch(lPipe.mWatch, SocketWatch::kEvent_Read) != CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, lPipe.mWatch.IsActive());
+
+    ServiceEvents(lContext.mLayer);
+    NL_TEST_ASSERT(inSuite, lPipe.mCalls == 0);
+
+    MakeReadable(lPipe);
+    ServiceEvents(lContext.mLayer);
+    NL_TEST_ASSERT(inSuite, lPipe.mCalls == 1 && lPipe.mEvents == SocketWatch::kEvent_Read);
+
+    // No interest, no callback, even though the pipe is still readable.
+    lContext.mLayer.UpdateSocketWatch(lPipe.mWatch, 0);
+    ServiceEvents(lContext.mLayer);
+    NL_TEST_ASSERT(inSuite, lPipe.mCalls == 1);
+
+    lContext.mLayer.UpdateSocketWatch(lPipe.mWatch, SocketWatch::kEvent_Read | SocketWatch::kEvent_Write);
+    ServiceEvents(lContext.mLayer);
+    NL_TEST_ASSERT(inSuite, lPipe.mCalls == 2 && lPipe.mEvents == SocketWatch::kEvent_Read);
+
+    lContext.mLayer.RemoveSocketWatch(lPipe.mWatch);
+    NL_TEST_ASSERT(inSuite, !lPipe.mWatch.IsActive());
+    ServiceEvents(lContext.mLayer);
+    NL_TEST_ASSERT(inSuite, lPipe.mCalls == 2);
+
+    ClosePipes(lContext);
+}
+
+void TestRemoveWhileDispatching(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    unsigned lCalls        = 0;
+
+    NL_TEST_ASSERT(inSuite, OpenPipes(lContext, 3));
+    for (size_t i = 0; i < lContext.mNumPipes; i++)
+    {
+        Pipe & lPipe = lContext.mPipes[i];
+
+        lPipe.mWatch.Init(lPipe.mFDs[0], HandleReadyRemoveOthers, &lContext);
+        NL_TEST_ASSERT(inSuite, lContext.mLayer.AddSocketWatch(lPipe.mWatch, SocketWatch::kEvent_Read) == CHIP_SYSTEM_NO_ERROR);
+        MakeReadable(lPipe);
+    }
+
+    // Whichever watch comes first removes the others, which are then not called back although they were ready.
+    ServiceEvents(lContext.mLayer);
+    for (size_t i = 0; i < lContext.mNumPipes; i++)
+    {
+        lCalls += lContext.mPipes[i].mCalls;
+    }
+    NL_TEST_ASSERT(inSuite, lCalls == 1);
+
+    ClosePipes(lContext);
+}
+
+void TestLoopOverhead(nlTestSuite * inSuite, void * aContext)
+{
+    constexpr size_t kIterations      = 2000;
+    constexpr size_t kNumOperations[] = { 1, 8, kMaxPipes };
+    constexpr size_t kNumTimers       = 8;
+    TestContext & lContext            = *static_cast<TestContext *>(aContext);
+
+    // Pending timers stand for the timeouts of the operations.
+    for (size_t i = 0; i < kNumTimers; i++)
+    {
+        NL_TEST_ASSERT(inSuite, lContext.mLayer.StartTimer(60000, HandleTimer, &lContext.mPipes[i]) == CHIP_SYSTEM_NO_ERROR);
+    }
+
+    for (size_t lNumOperations : kNumOperations)
+    {
+        bool lAllCalled = true;
+        uint64_t lStart;
+        uint64_t lTime;
+
+        NL_TEST_ASSERT(inSuite, OpenPipes(lContext, lNumOperations));
+        for (size_t i = 0; i < lContext.mNumPipes; i++)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           lContext.mLayer.AddSocketWatch(lContext.mPipes[i].mWatch, SocketWatch::kEvent_Read) ==
+                               CHIP_SYSTEM_NO_ERROR);
+        }
+
+        // One operation gets an answer per iteration, in turn.
+        lStart = Layer::GetClock_MonotonicHiRes();
+        for (size_t i = 0; i < kIterations; i++)
+        {
+            Pipe & lPipe          = lContext.mPipes[i % lNumOperations];
+            const unsigned lCalls = lPipe.mCalls;
+
+            MakeReadable(lPipe);
+            ServiceEvents(lContext.mLayer);
+            Drain(lPipe);
+            lAllCalled = lAllCalled && (lPipe.mCalls == lCalls + 1);
+        }
+        lTime = Layer::GetClock_MonotonicHiRes() - lStart;
+
+        NL_TEST_ASSERT(inSuite, lAllCalled);
+        printf("%3zu watches, %zu timers: %" PRIu64 " ns per loop iteration\n", lNumOperations, kNumTimers,
+               lTime * 1000 / kIterations);
+
+        ClosePipes(lContext);
+    }
+
+    for (size_t i = 0; i < kNumTimers; i++)
+    {
+        lContext.mLayer.CancelTimer(HandleTimer, &lContext.mPipes[i]);
+    }
+}
+
+} // namespace
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("SocketWatch::TestReadable",                TestReadable),
+    NL_TEST_DEF("SocketWatch::TestRemoveWhileDispatching",  TestRemoveWhileDispatching),
+    NL_TEST_DEF("SocketWatch::TestLoopOverhead",            TestLoopOverhead),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+static nlTestSuite kTheSuite =
+{
+    "chip-system-socket-watch",
+    sTests
+};
+// clang-format on
+
+int TestSystemSocketWatch(void)
+{
+    TestContext context;
+
+    context.mNumPipes  = 0;
+    context.mTestSuite = &kTheSuite;
+    VerifyOrDie(context.mLayer.Init(nullptr) == CHIP_SYSTEM_NO_ERROR);
+
+    // Run test suit againt one lContext.
+    nlTestRunner(&kTheSuite, &context);
+
+    context.mLayer.Shutdown();
+
+    return nlTestRunnerStats(&kTheSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSystemSocketWatch)
+#else  // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+int TestSystemSocketWatch(void)
+{
+    return SUCCESS;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -87,6 +87,16 @@ public:
     CHIP_ERROR SendNetworkCredentials(const char * ssid, const char * passwd);
     CHIP_ERROR SendThreadCredentials(const DeviceLayer::Internal::DeviceNetworkInfo & threadData);
 
+    /**
+     * @brief
+     *  The device can use this function to send its IP address to
+     *  commissioner. This would generally be called during network
+     *  provisioning of the device, after the IP address assignment.
+     *
+     * @param addr The IP address of the device
+     */
+    CHIP_ERROR SendIPAddress(const Inet::IPAddress & addr);
+
     CHIP_ERROR HandleNetworkProvisioningMessage(uint8_t msgType, System::PacketBuffer * msgBuf);
 
     /**
@@ -103,16 +113,6 @@ private:
 
     Inet::IPAddress mDeviceAddress = Inet::IPAddress::Any;
 
-    /**
-     * @brief
-     *  The device can use this function to send its IP address to
-     *  commissioner. This would generally be called during network
-     *  provisioning of the device, after the IP address assignment.
-     *
-     * @param addr The IP address of the device
-     */
-    CHIP_ERROR SendIPAddress(const Inet::IPAddress & addr);
-
     CHIP_ERROR EncodeString(const char * str, BufBound & bbuf);
     CHIP_ERROR DecodeString(const uint8_t * input, size_t input_len, BufBound & bbuf, size_t & consumed);
 
@@ -0,0 +1,58 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   This file defines the interface SecureSessionMgrBase uses to find the
+ *   address of a peer whose connection state does not carry one.
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPCore.h>
+#include <support/DLLUtil.h>
+#include <transport/raw/MessageHeader.h>
+#include <transport/raw/PeerAddress.h>
+
+namespace chip {
+namespace Transport {
+
+class DLL_EXPORT PeerAddressResolver
+{
+public:
+    virtual ~PeerAddressResolver() {}
+
+    /**
+     * @brief
+     *   Look up the current address of a peer node.
+     *
+     * @details
+     *   Called on the send path, so implementations must not block: when the
+     *   address is not known yet they should start resolving it in the
+     *   background and fail the lookup.
+     *
+     * @param peerNodeId  The node the message is addressed to
+     * @param address     Set to the peer address on success
+     *
+     * @return CHIP_NO_ERROR if the address is known, an error that fails the send otherwise
+     */
+    virtual CHIP_ERROR LookupPeerAddress(NodeId peerNodeId, PeerAddress & address) = 0;
+};
+
+} // namespace Transport
+} // namespace chip
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <inet/InetLayer.h>
 #include <transport/raw/Base.h>
 
 #if CONFIG_NETWORK_LAYER_BLE
@@ -35,7 +36,7 @@ class RendezvousParameters
 public:
     RendezvousParameters() = default;
 
-    bool IsController() const { return HasDiscriminator() || HasConnectionObject(); }
+    bool IsController() const { return HasDiscriminator() || HasConnectionObject() || HasPeerAddress(); }
 
     bool HasSetupPINCode() const { return mSetupPINCode != 0; }
     uint32_t GetSetupPINCode() const { return mSetupPINCode; }
@@ -61,6 +62,39 @@ public:
         return *this;
     }
 
+    // When an InetLayer is set, the rendezvous runs over UDP instead of BLE. A commissioner sets the address of the
+    // device it pairs with; a device sets the address it is reachable at, which it reports once paired.
+    bool HasInetLayer() const { return mInetLayer != nullptr; }
+    Inet::InetLayer * GetInetLayer() const { return mInetLayer; }
+    RendezvousParameters & SetInetLayer(Inet::InetLayer * value)
+    {
+        mInetLayer = value;
+        return *this;
+    }
+
+    uint16_t GetListenPort() const { return mListenPort; }
+    RendezvousParameters & SetListenPort(uint16_t port)
+    {
+        mListenPort = port;
+        return *this;
+    }
+
+    bool HasPeerAddress() const { return mPeerAddress.IsInitialized(); }
+    const Transport::PeerAddress & GetPeerAddress() const { return mPeerAddress; }
+    RendezvousParameters & SetPeerAddress(const Transport::PeerAddress & peerAddress)
+    {
+        mPeerAddress = peerAddress;
+        return *this;
+    }
+
+    bool HasIPAddress() const { return mIPAddress != Inet::IPAddress::Any; }
+    const Inet::IPAddress & GetIPAddress() const { return mIPAddress; }
+    RendezvousParameters & SetIPAddress(const Inet::IPAddress & address)
+    {
+        mIPAddress = address;
+        return *this;
+    }
+
 #if CONFIG_NETWORK_LAYER_BLE
     bool HasBleLayer() const { return mBleLayer != nullptr; }
     Ble::BleLayer * GetBleLayer() const { return mBleLayer; }
@@ -86,6 +120,11 @@ private:
     uint32_t mSetupPINCode  = 0;          ///< the target peripheral setup PIN Code
     uint16_t mDiscriminator = UINT16_MAX; ///< the target peripheral discriminator
 
+    Inet::InetLayer * mInetLayer = nullptr;            ///< the InetLayer of a rendezvous over UDP
+    uint16_t mListenPort         = CHIP_PORT;          ///< the local UDP port of a rendezvous over UDP
+    Transport::PeerAddress mPeerAddress;               ///< the device address, for a commissioner over UDP
+    Inet::IPAddress mIPAddress = Inet::IPAddress::Any; ///< the device's own address, for a device over UDP
+
 #if CONFIG_NETWORK_LAYER_BLE
     Ble::BleLayer * mBleLayer               = nullptr;
     BLE_CONNECTION_OBJECT mConnectionObject = 0;
@@ -23,6 +23,7 @@
 #include <support/ErrorStr.h>
 #include <support/SafeInt.h>
 #include <transport/RendezvousSession.h>
+#include <transport/raw/UDP.h>
 
 #if CONFIG_NETWORK_LAYER_BLE
 #include <transport/BLE.h>
@@ -47,23 +48,79 @@ CHIP_ERROR RendezvousSession::Init(const RendezvousParameters & params)
     VerifyOrExit(mParams.HasSetupPINCode(), err = CHIP_ERROR_INVALID_ARGUMENT);
 
     err = CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
+    if (mParams.HasInetLayer())
+    {
+        err = InitUdpTransport();
+    }
 #if CONFIG_NETWORK_LAYER_BLE
+    else
     {
         Transport::BLE * transport = chip::Platform::New<Transport::BLE>();
         err                        = transport->Init(this, mParams);
         mTransport                 = transport;
+        mPeerAddress               = Transport::PeerAddress::BLE();
     }
 #endif // CONFIG_NETWORK_LAYER_BLE
     SuccessOrExit(err);
 
     if (!mParams.IsController())
     {
-        err = WaitForPairing(mParams.GetLocalNodeId(), mParams.GetSetupPINCode());
+        // The verifier only depends on the setup PIN code, so derive it once for all the pairing attempts.
+        err = SecurePairingSession::ComputePASEVerifier(mParams.GetSetupPINCode(), kSpake2p_Iteration_Count,
+                                                        reinterpret_cast<const unsigned char *>(kSpake2pKeyExchangeSalt),
+                                                        strlen(kSpake2pKeyExchangeSalt), mPASEVerifier);
+        SuccessOrExit(err);
+
+        err = WaitForPairing(mParams.GetLocalNodeId());
         SuccessOrExit(err);
     }
 
     mNetworkProvision.Init(this);
 
+    if (mParams.HasInetLayer() && mParams.IsController())
+    {
+        // UDP is connectionless: the commissioner starts pairing as soon as its endpoint is listening.
+        OnRendezvousConnectionOpened();
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR RendezvousSession::InitUdpTransport()
+{
+    CHIP_ERROR err                  = CHIP_NO_ERROR;
+    Inet::IPAddressType addressType = Inet::kIPAddressType_Unknown;
+    Transport::UDP * transport      = nullptr;
+
+    if (mParams.IsController())
+    {
+        VerifyOrExit(mParams.GetPeerAddress().GetTransportType() == Transport::Type::kUdp, err = CHIP_ERROR_INVALID_ARGUMENT);
+        addressType  = mParams.GetPeerAddress().GetIPAddress().Type();
+        mPeerAddress = mParams.GetPeerAddress();
+    }
+    else
+    {
+        // The device learns the commissioner address from the first pairing message it receives.
+        VerifyOrExit(mParams.HasIPAddress(), err = CHIP_ERROR_INVALID_ARGUMENT);
+        addressType  = mParams.GetIPAddress().Type();
+        mPeerAddress = Transport::PeerAddress::Uninitialized();
+    }
+
+    transport = chip::Platform::New<Transport::UDP>();
+    VerifyOrExit(transport != nullptr, err = CHIP_ERROR_NO_MEMORY);
+    mTransport = transport;
+
+    {
+        Transport::UdpListenParameters listenParams(mParams.GetInetLayer());
+        listenParams.SetAddressType(addressType).SetListenPort(mParams.GetListenPort());
+
+        err = transport->Init(listenParams);
+        SuccessOrExit(err);
+    }
+
+    transport->SetMessageReceiveHandler(HandleUdpMessageReceived, this);
+
 exit:
     return err;
 }
@@ -76,6 +133,8 @@ RendezvousSession::~RendezvousSession()
         mTransport = nullptr;
     }
 
+    Crypto::ClearSecretData(mPASEVerifier.mW0, sizeof(mPASEVerifier.mW0));
+
     mDelegate = nullptr;
 }
 
@@ -88,7 +147,8 @@ CHIP_ERROR RendezvousSession::SendPairingMessage(const PacketHeader & header, He
         return CHIP_ERROR_INCORRECT_STATE;
     }
 
-    return mTransport->SendMessage(header, payloadFlags, Transport::PeerAddress::BLE(), msgBuf);
+    // A device answering a commissioner it has not accepted yet replies to the sender of the message being handled.
+    return mTransport->SendMessage(header, payloadFlags, mPeerAddress.IsInitialized() ? mPeerAddress : mMessageSource, msgBuf);
 }
 
 CHIP_ERROR RendezvousSession::SendSecureMessage(Protocols::CHIPProtocolId protocol, uint8_t msgType, System::PacketBuffer * msgBuf)
@@ -134,7 +194,7 @@ CHIP_ERROR RendezvousSession::SendSecureMessage(Protocols::CHIPProtocolId protoc
     VerifyOrExit(CanCastTo<uint16_t>(totalLen + taglen), err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
     msgBuf->SetDataLength(static_cast<uint16_t>(totalLen + taglen));
 
-    err    = mTransport->SendMessage(packetHeader, payloadHeader.GetEncodePacketFlags(), Transport::PeerAddress::BLE(), msgBuf);
+    err    = mTransport->SendMessage(packetHeader, payloadHeader.GetEncodePacketFlags(), mPeerAddress, msgBuf);
     msgBuf = nullptr;
     SuccessOrExit(err);
 
@@ -158,6 +218,17 @@ void RendezvousSession::OnPairingComplete()
     VerifyOrExit(err == CHIP_NO_ERROR, ChipLogError(Ble, "Failed to initialize a secure session: %s", ErrorStr(err)));
 
     UpdateState(State::kNetworkProvisioning);
+
+    if (mParams.HasInetLayer() && !mParams.IsController())
+    {
+        // A device paired over UDP is already attached to the network the commissioner reached it on, so there are
+        // no credentials to wait for: report the device address, which completes network provisioning.
+        err = mNetworkProvision.SendIPAddress(mParams.GetIPAddress());
+        VerifyOrExit(err == CHIP_NO_ERROR, OnNetworkProvisioningError(err));
+
+        OnNetworkProvisioningComplete();
+    }
+
 exit:
     return;
 }
@@ -189,7 +260,7 @@ void RendezvousSession::OnRendezvousConnectionClosed()
     if (!mParams.IsController())
     {
         mSecureSession.Reset();
-        CHIP_ERROR err = WaitForPairing(mParams.GetLocalNodeId(), mParams.GetSetupPINCode());
+        CHIP_ERROR err = WaitForPairing(mParams.GetLocalNodeId());
         VerifyOrExit(err == CHIP_NO_ERROR, OnPairingError(err));
     }
 
@@ -213,7 +284,22 @@ void RendezvousSession::OnRendezvousError(CHIP_ERROR err)
         break;
     };
     mDelegate->OnRendezvousError(err);
-    UpdateState(State::kInit);
+
+    // Not UpdateState(), which would report the failed phase as a success.
+    mCurrentState = State::kInit;
+
+    if (mParams.HasInetLayer() && !mParams.IsController())
+    {
+        // A device listening on UDP stays available after a failed attempt: it forgets the peer and waits for the
+        // next commissioner.
+        mPeerAddress = Transport::PeerAddress::Uninitialized();
+        mSecureSession.Reset();
+        err = WaitForPairing(mParams.GetLocalNodeId());
+        VerifyOrExit(err == CHIP_NO_ERROR, ChipLogError(Ble, "Failed to wait for pairing again: %s", ErrorStr(err)));
+    }
+
+exit:
+    return;
 }
 
 void RendezvousSession::UpdateState(RendezvousSession::State newState)
@@ -243,22 +329,15 @@ void RendezvousSession::UpdateState(RendezvousSession::State newState)
 void RendezvousSession::OnRendezvousMessageReceived(PacketBuffer * msgBuf)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+    PacketHeader packetHeader;
+    uint16_t headerSize = 0;
 
-    switch (mCurrentState)
-    {
-    case State::kSecurePairing:
-        err = HandlePairingMessage(msgBuf);
-        break;
-
-    case State::kNetworkProvisioning:
-        err = HandleSecureMessage(msgBuf);
-        break;
+    err = packetHeader.Decode(msgBuf->Start(), msgBuf->DataLength(), &headerSize);
+    SuccessOrExit(err);
 
-    default:
-        err = CHIP_ERROR_INCORRECT_STATE;
-        break;
-    };
+    msgBuf->ConsumeHead(headerSize);
 
+    err = HandleRendezvousMessage(packetHeader, msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -268,28 +347,79 @@ exit:
     }
 }
 
-CHIP_ERROR RendezvousSession::HandlePairingMessage(PacketBuffer * msgBuf)
+void RendezvousSession::HandleUdpMessageReceived(const PacketHeader & header, const Transport::PeerAddress & source,
+                                                 System::PacketBuffer * msgBuf, RendezvousSession * session)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
-    PacketHeader packetHeader;
-    uint16_t headerSize = 0;
-
-    err = packetHeader.Decode(msgBuf->Start(), msgBuf->DataLength(), &headerSize);
-    SuccessOrExit(err);
+    State state    = session->mCurrentState;
 
-    msgBuf->ConsumeHead(headerSize);
+    if (session->mPeerAddress.IsInitialized())
+    {
+        // Only the peer the session is pairing with may drive it; anything else on the port is dropped.
+        VerifyOrExit(source == session->mPeerAddress, PacketBuffer::Free(msgBuf));
+    }
+    else
+    {
+        // The device does not know its commissioner until it accepts a pairing message from it, so any source may
+        // start pairing.
+        VerifyOrExit(state == State::kSecurePairing, PacketBuffer::Free(msgBuf));
+    }
 
-    err = mPairingSession.HandlePeerMessage(packetHeader, msgBuf);
+    session->mMessageSource = source;
+    err                     = session->HandleRendezvousMessage(header, msgBuf);
+    session->mMessageSource = Transport::PeerAddress::Uninitialized();
     SuccessOrExit(err);
 
+    if (!session->mPeerAddress.IsInitialized())
+    {
+        session->mPeerAddress = source;
+    }
+
 exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        if (state == State::kSecurePairing)
+        {
+            // The pairing session already reported the error through OnPairingError, but leaves the message to us.
+            PacketBuffer::Free(msgBuf);
+        }
+        else
+        {
+            session->OnRendezvousError(err);
+        }
+    }
+}
+
+CHIP_ERROR RendezvousSession::HandleRendezvousMessage(const PacketHeader & packetHeader, PacketBuffer * msgBuf)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    switch (mCurrentState)
+    {
+    case State::kSecurePairing:
+        err = HandlePairingMessage(packetHeader, msgBuf);
+        break;
+
+    case State::kNetworkProvisioning:
+        err = HandleSecureMessage(packetHeader, msgBuf);
+        break;
+
+    default:
+        err = CHIP_ERROR_INCORRECT_STATE;
+        break;
+    };
+
     return err;
 }
 
-CHIP_ERROR RendezvousSession::HandleSecureMessage(PacketBuffer * msgBuf)
+CHIP_ERROR RendezvousSession::HandlePairingMessage(const PacketHeader & packetHeader, PacketBuffer * msgBuf)
+{
+    return mPairingSession.HandlePeerMessage(packetHeader, msgBuf);
+}
+
+CHIP_ERROR RendezvousSession::HandleSecureMessage(const PacketHeader & packetHeader, PacketBuffer * msgBuf)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
-    PacketHeader packetHeader;
     PayloadHeader payloadHeader;
     MessageAuthenticationCode mac;
     uint16_t headerSize            = 0;
@@ -301,10 +431,6 @@ CHIP_ERROR RendezvousSession::HandleSecureMessage(PacketBuffer * msgBuf)
     uint16_t payloadlen            = 0;
     System::PacketBuffer * origMsg = nullptr;
 
-    err = packetHeader.Decode(msgBuf->Start(), msgBuf->DataLength(), &headerSize);
-    SuccessOrExit(err);
-    msgBuf->ConsumeHead(headerSize);
-
     headerSize = payloadHeader.EncodeSizeBytes();
     data       = msgBuf->Start();
     len        = msgBuf->TotalLength();
@@ -357,12 +483,10 @@ exit:
     return err;
 }
 
-CHIP_ERROR RendezvousSession::WaitForPairing(Optional<NodeId> nodeId, uint32_t setupPINCode)
+CHIP_ERROR RendezvousSession::WaitForPairing(Optional<NodeId> nodeId)
 {
     UpdateState(State::kSecurePairing);
-    return mPairingSession.WaitForPairing(setupPINCode, kSpake2p_Iteration_Count,
-                                          reinterpret_cast<const unsigned char *>(kSpake2pKeyExchangeSalt),
-                                          strlen(kSpake2pKeyExchangeSalt), nodeId, 0, this);
+    return mPairingSession.WaitForPairing(mPASEVerifier, nodeId, 0, this);
 }
 
 CHIP_ERROR RendezvousSession::Pair(Optional<NodeId> nodeId, uint32_t setupPINCode)
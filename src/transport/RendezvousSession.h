@@ -29,6 +29,7 @@
 #include <transport/RendezvousParameters.h>
 #include <transport/RendezvousSessionDelegate.h>
 #include <transport/SecurePairingSession.h>
+#include <transport/raw/PeerAddress.h>
 
 namespace chip {
 
@@ -122,16 +123,24 @@ public:
     const Inet::IPAddress & GetIPAddress() const { return mNetworkProvision.GetIPAddress(); }
 
 private:
-    CHIP_ERROR HandlePairingMessage(System::PacketBuffer * msgBug);
+    CHIP_ERROR InitUdpTransport();
+    static void HandleUdpMessageReceived(const PacketHeader & header, const Transport::PeerAddress & source,
+                                         System::PacketBuffer * msgBuf, RendezvousSession * session);
+
+    CHIP_ERROR HandleRendezvousMessage(const PacketHeader & packetHeader, System::PacketBuffer * msgBuf);
+    CHIP_ERROR HandlePairingMessage(const PacketHeader & packetHeader, System::PacketBuffer * msgBuf);
     CHIP_ERROR Pair(Optional<NodeId> nodeId, uint32_t setupPINCode);
-    CHIP_ERROR WaitForPairing(Optional<NodeId> nodeId, uint32_t setupPINCode);
+    CHIP_ERROR WaitForPairing(Optional<NodeId> nodeId);
 
-    CHIP_ERROR HandleSecureMessage(System::PacketBuffer * msgBuf);
+    CHIP_ERROR HandleSecureMessage(const PacketHeader & packetHeader, System::PacketBuffer * msgBuf);
     Transport::Base * mTransport          = nullptr; ///< Underlying transport
+    Transport::PeerAddress mPeerAddress;             ///< Address of the peer on the underlying transport
+    Transport::PeerAddress mMessageSource;           ///< Sender of the UDP message being handled, until it is the peer
     RendezvousSessionDelegate * mDelegate = nullptr; ///< Underlying transport events
     RendezvousParameters mParams;                    ///< Rendezvous configuration
 
     SecurePairingSession mPairingSession;
+    PASEVerifier mPASEVerifier;
     NetworkProvisioning mNetworkProvision;
     SecureSession mSecureSession;
     uint32_t mSecureMessageIndex = 0;
@@ -127,22 +127,15 @@ exit:
     return error;
 }
 
-CHIP_ERROR SecurePairingSession::Init(uint32_t setupCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
-                                      Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate)
+CHIP_ERROR SecurePairingSession::Init(Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    VerifyOrExit(salt != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(saltLen > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(delegate != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
 
     err = mSpake2p.Init(Uint8::from_const_char(kSpake2pContext), strlen(kSpake2pContext));
     SuccessOrExit(err);
 
-    err = pbkdf2_sha256(reinterpret_cast<const uint8_t *>(&setupCode), sizeof(setupCode), salt, saltLen, pbkdf2IterCount,
-                        sizeof(mWS), &mWS[0][0]);
-    SuccessOrExit(err);
-
     mDelegate    = delegate;
     mLocalNodeId = myNodeId;
     mLocalKeyId  = myKeyId;
@@ -151,18 +144,74 @@ exit:
     return err;
 }
 
+CHIP_ERROR SecurePairingSession::ComputeWS(uint32_t setupCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
+                                           uint8_t (&ws)[2][kSpake2p_WS_Length])
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(salt != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(saltLen > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    err = pbkdf2_sha256(reinterpret_cast<const uint8_t *>(&setupCode), sizeof(setupCode), salt, saltLen, pbkdf2IterCount,
+                        sizeof(ws), &ws[0][0]);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR SecurePairingSession::ComputePASEVerifier(uint32_t setUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt,
+                                                     size_t saltLen, PASEVerifier & verifier)
+{
+    Spake2p_P256_SHA256_HKDF_HMAC spake2p;
+    uint8_t ws[2][kSpake2p_WS_Length];
+    size_t sizeof_point = sizeof(verifier.mL);
+
+    CHIP_ERROR err = ComputeWS(setUpPINCode, pbkdf2IterCount, salt, saltLen, ws);
+    SuccessOrExit(err);
+
+    err = spake2p.Init(Uint8::from_const_char(kSpake2pContext), strlen(kSpake2pContext));
+    SuccessOrExit(err);
+
+    err = spake2p.ComputeL(verifier.mL, &sizeof_point, &ws[1][0], kSpake2p_WS_Length);
+    SuccessOrExit(err);
+
+    memcpy(verifier.mW0, &ws[0][0], sizeof(verifier.mW0));
+
+exit:
+    ClearSecretData(&ws[0][0], sizeof(ws));
+    return err;
+}
+
 CHIP_ERROR SecurePairingSession::WaitForPairing(uint32_t mySetUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt,
                                                 size_t saltLen, Optional<NodeId> myNodeId, uint16_t myKeyId,
                                                 SecurePairingSessionDelegate * delegate)
 {
-    size_t sizeof_point = sizeof(mPoint);
+    PASEVerifier verifier;
+
+    CHIP_ERROR err = ComputePASEVerifier(mySetUpPINCode, pbkdf2IterCount, salt, saltLen, verifier);
+    SuccessOrExit(err);
 
-    CHIP_ERROR err = Init(mySetUpPINCode, pbkdf2IterCount, salt, saltLen, myNodeId, myKeyId, delegate);
+    err = WaitForPairing(verifier, myNodeId, myKeyId, delegate);
     SuccessOrExit(err);
 
-    err = mSpake2p.ComputeL(mPoint, &sizeof_point, &mWS[1][0], kSpake2p_WS_Length);
+exit:
+    ClearSecretData(verifier.mW0, sizeof(verifier.mW0));
+    return err;
+}
+
+CHIP_ERROR SecurePairingSession::WaitForPairing(const PASEVerifier & verifier, Optional<NodeId> myNodeId, uint16_t myKeyId,
+                                                SecurePairingSessionDelegate * delegate)
+{
+    static_assert(sizeof(mPoint) >= sizeof(verifier.mL), "mPoint must be able to hold L");
+
+    CHIP_ERROR err = Init(myNodeId, myKeyId, delegate);
     SuccessOrExit(err);
 
+    // The accessory only needs w0 and L; w1 is never used on this side of the handshake.
+    memcpy(&mWS[0][0], verifier.mW0, sizeof(verifier.mW0));
+    memcpy(mPoint, verifier.mL, sizeof(verifier.mL));
+
     mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_pA;
     mPairingComplete = false;
 
@@ -210,7 +259,10 @@ CHIP_ERROR SecurePairingSession::Pair(uint32_t peerSetUpPINCode, uint32_t pbkdf2
 
     System::PacketBuffer * resp = nullptr;
 
-    CHIP_ERROR err = Init(peerSetUpPINCode, pbkdf2IterCount, salt, saltLen, myNodeId, myKeyId, delegate);
+    CHIP_ERROR err = Init(myNodeId, myKeyId, delegate);
+    SuccessOrExit(err);
+
+    err = ComputeWS(peerSetUpPINCode, pbkdf2IterCount, salt, saltLen, mWS);
     SuccessOrExit(err);
 
     err = mSpake2p.BeginProver(reinterpret_cast<const uint8_t *>(""), 0, reinterpret_cast<const uint8_t *>(""), 0, &mWS[0][0],
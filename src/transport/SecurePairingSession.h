@@ -74,6 +74,19 @@ public:
 
 struct SecurePairingSessionSerialized;
 
+constexpr size_t kSpake2p_WS_Length = kP256_FE_Length + 8;
+
+/**
+ * The SPAKE2+ verifier of a setup PIN code: the w0 field element and the L point an accessory
+ * needs to run the handshake. It can be computed once with ComputePASEVerifier and stored, so
+ * that the accessory does not run PBKDF2 for every pairing attempt.
+ */
+struct PASEVerifier
+{
+    uint8_t mW0[kSpake2p_WS_Length];
+    uint8_t mL[kP256_Point_Length];
+};
+
 class DLL_EXPORT SecurePairingSession
 {
 public:
@@ -102,6 +115,35 @@ public:
     CHIP_ERROR WaitForPairing(uint32_t mySetUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
                               Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate);
 
+    /**
+     * @brief
+     *   Initialize using a precomputed verifier of the setup PIN code and wait for pairing requests.
+     *
+     * @param verifier        Verifier of the setup PIN code of the local device
+     * @param myNodeId        Optional node id of local node
+     * @param myKeyId         Key ID to be assigned to the secure session on the peer node
+     * @param delegate        Callback object
+     *
+     * @return CHIP_ERROR     The result of initialization
+     */
+    CHIP_ERROR WaitForPairing(const PASEVerifier & verifier, Optional<NodeId> myNodeId, uint16_t myKeyId,
+                              SecurePairingSessionDelegate * delegate);
+
+    /**
+     * @brief
+     *   Compute the verifier of a setup PIN code, to be passed to WaitForPairing.
+     *
+     * @param setUpPINCode    Setup PIN code of the local device
+     * @param pbkdf2IterCount Iteration count for PBKDF2 function
+     * @param salt            Salt to be used for SPAKE2P opertation
+     * @param saltLen         Length of salt
+     * @param verifier        The computed verifier
+     *
+     * @return CHIP_ERROR     The result of the computation
+     */
+    static CHIP_ERROR ComputePASEVerifier(uint32_t setUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
+                                          PASEVerifier & verifier);
+
     /**
      * @brief
      *   Create a pairing request using peer's setup PIN code.
@@ -179,8 +221,10 @@ public:
     CHIP_ERROR Deserialize(SecurePairingSessionSerialized & input);
 
 private:
-    CHIP_ERROR Init(uint32_t setupCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen, Optional<NodeId> myNodeId,
-                    uint16_t myKeyId, SecurePairingSessionDelegate * delegate);
+    CHIP_ERROR Init(Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate);
+
+    static CHIP_ERROR ComputeWS(uint32_t setupCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
+                                uint8_t (&ws)[2][kSpake2p_WS_Length]);
 
     CHIP_ERROR HandleCompute_pA(const PacketHeader & header, System::PacketBuffer * msg);
     CHIP_ERROR HandleCompute_pB_cB(const PacketHeader & header, System::PacketBuffer * msg);
@@ -188,8 +232,6 @@ private:
 
     CHIP_ERROR AttachHeaderAndSend(uint8_t msgType, System::PacketBuffer * msgBuf);
 
-    static constexpr size_t kSpake2p_WS_Length = kP256_FE_Length + 8;
-
     enum Spake2pMsgType : uint8_t
     {
         kSpake2pCompute_pA    = 0,
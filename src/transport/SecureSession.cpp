@@ -37,6 +37,9 @@ namespace {
 constexpr size_t kAESCCMIVLen = 12;
 constexpr size_t kMaxAADLen   = 128;
 
+// Number of messages of a batch whose IV, AAD and tag are prepared on the stack at once.
+constexpr size_t kBatchChunkSize = 8;
+
 } // namespace
 
 using namespace Crypto;
@@ -201,4 +204,162 @@ exit:
     return error;
 }
 
+CHIP_ERROR SecureSession::EncryptBatch(const BatchMessage * messages, size_t count, size_t & outFailedIndex)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    uint8_t IV[kBatchChunkSize][kAESCCMIVLen];
+    uint8_t AAD[kBatchChunkSize][kMaxAADLen];
+    uint8_t tag[kBatchChunkSize][kMaxTagLen];
+    AES_CCM_EncryptMessage batch[kBatchChunkSize];
+    size_t start = 0;
+
+    constexpr Header::EncryptionType encType = Header::EncryptionType::kAESCCMTagLen16;
+
+    const size_t taglen = MessageAuthenticationCode::TagLenForEncryptionType(encType);
+    assert(taglen <= kMaxTagLen);
+
+    outFailedIndex = 0;
+
+    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    while (start < count)
+    {
+        CHIP_ERROR prepareError = CHIP_NO_ERROR;
+        size_t prepared         = 0;
+        size_t failedInChunk    = 0;
+
+        // Prepare as many messages as fit in the chunk, stopping at the first one that cannot be
+        // encrypted so the ones before it are still processed.
+        for (; prepared < kBatchChunkSize && start + prepared < count; prepared++)
+        {
+            const BatchMessage & message = messages[start + prepared];
+            uint16_t aadLen              = sizeof(AAD[prepared]);
+
+            if (message.mInput == nullptr || message.mInputLength == 0 || message.mOutput == nullptr ||
+                message.mHeader == nullptr || message.mMac == nullptr)
+            {
+                prepareError = CHIP_ERROR_INVALID_ARGUMENT;
+                break;
+            }
+
+            prepareError = GetIV(*message.mHeader, IV[prepared], sizeof(IV[prepared]));
+            if (prepareError == CHIP_NO_ERROR)
+            {
+                prepareError = GetAdditionalAuthData(*message.mHeader, message.mPayloadFlags, AAD[prepared], aadLen);
+            }
+            if (prepareError != CHIP_NO_ERROR)
+            {
+                break;
+            }
+
+            batch[prepared].mPlaintext       = message.mInput;
+            batch[prepared].mPlaintextLength = message.mInputLength;
+            batch[prepared].mAAD             = AAD[prepared];
+            batch[prepared].mAADLength       = aadLen;
+            batch[prepared].mIV              = IV[prepared];
+            batch[prepared].mIVLength        = sizeof(IV[prepared]);
+            batch[prepared].mCiphertext      = message.mOutput;
+            batch[prepared].mTag             = tag[prepared];
+        }
+
+        if (prepared > 0)
+        {
+            error = AES_CCM_encrypt_batch(batch, prepared, mKey, sizeof(mKey), taglen, failedInChunk);
+            for (size_t i = 0; i < failedInChunk; i++)
+            {
+                messages[start + i].mMac->SetTag(messages[start + i].mHeader, encType, tag[i], taglen);
+            }
+            start += failedInChunk;
+            SuccessOrExit(error);
+        }
+
+        error = prepareError;
+        SuccessOrExit(error);
+    }
+
+exit:
+    outFailedIndex = (error == CHIP_NO_ERROR) ? count : start;
+    return error;
+}
+
+CHIP_ERROR SecureSession::DecryptBatch(const BatchMessage * messages, size_t count, size_t & outFailedIndex)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    uint8_t IV[kBatchChunkSize][kAESCCMIVLen];
+    uint8_t AAD[kBatchChunkSize][kMaxAADLen];
+    AES_CCM_DecryptMessage batch[kBatchChunkSize];
+    size_t start = 0;
+
+    outFailedIndex = 0;
+
+    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    VerifyOrExit(messages != nullptr || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    while (start < count)
+    {
+        CHIP_ERROR prepareError = CHIP_NO_ERROR;
+        size_t prepared         = 0;
+        size_t failedInChunk    = 0;
+        size_t taglen           = 0;
+
+        // The tag length is a batch-wide parameter, so a chunk also ends where the encryption type changes.
+        for (; prepared < kBatchChunkSize && start + prepared < count; prepared++)
+        {
+            const BatchMessage & message = messages[start + prepared];
+            uint16_t aadLen              = sizeof(AAD[prepared]);
+
+            if (message.mInput == nullptr || message.mInputLength == 0 || message.mOutput == nullptr ||
+                message.mHeader == nullptr || message.mMac == nullptr)
+            {
+                prepareError = CHIP_ERROR_INVALID_ARGUMENT;
+                break;
+            }
+
+            const size_t messageTaglen = MessageAuthenticationCode::TagLenForEncryptionType(message.mHeader->GetEncryptionType());
+            if (prepared == 0)
+            {
+                taglen = messageTaglen;
+            }
+            else if (messageTaglen != taglen)
+            {
+                break;
+            }
+
+            prepareError = GetIV(*message.mHeader, IV[prepared], sizeof(IV[prepared]));
+            if (prepareError == CHIP_NO_ERROR)
+            {
+                prepareError = GetAdditionalAuthData(*message.mHeader, message.mPayloadFlags, AAD[prepared], aadLen);
+            }
+            if (prepareError != CHIP_NO_ERROR)
+            {
+                break;
+            }
+
+            batch[prepared].mCiphertext       = message.mInput;
+            batch[prepared].mCiphertextLength = message.mInputLength;
+            batch[prepared].mAAD              = AAD[prepared];
+            batch[prepared].mAADLength        = aadLen;
+            batch[prepared].mTag              = message.mMac->GetTag();
+            batch[prepared].mIV               = IV[prepared];
+            batch[prepared].mIVLength         = sizeof(IV[prepared]);
+            batch[prepared].mPlaintext        = message.mOutput;
+        }
+
+        if (prepared > 0)
+        {
+            error = AES_CCM_decrypt_batch(batch, prepared, mKey, sizeof(mKey), taglen, failedInChunk);
+            start += failedInChunk;
+            SuccessOrExit(error);
+        }
+
+        error = prepareError;
+        SuccessOrExit(error);
+    }
+
+exit:
+    outFailedIndex = (error == CHIP_NO_ERROR) ? count : start;
+    return error;
+}
+
 } // namespace chip
@@ -103,6 +103,52 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, const PacketHeader & header,
                        Header::Flags payloadFlags, const MessageAuthenticationCode & mac);
 
+    /**
+     * One message of an EncryptBatch() or DecryptBatch() call.  The fields have the meaning of the
+     * corresponding Encrypt() and Decrypt() arguments.
+     */
+    struct BatchMessage
+    {
+        const uint8_t * mInput;
+        size_t mInputLength;
+        uint8_t * mOutput;
+        PacketHeader * mHeader;
+        Header::Flags mPayloadFlags;
+        MessageAuthenticationCode * mMac;
+    };
+
+    /**
+     * @brief
+     *   Encrypt several messages using keys established in the secure channel.
+     *
+     *   Equivalent to calling Encrypt() for each message in turn, but the cipher is set up with
+     *   the session key once per group of messages rather than once per message.
+     *
+     * @param messages Messages to encrypt. The header and mac of each are updated as by Encrypt().
+     * @param count Number of entries in messages
+     * @param outFailedIndex Set to the index of the first message that could not be encrypted, or to
+     *                       count if none. All messages before it have been encrypted.
+     *
+     * @return CHIP_ERROR The result of encrypting the first message that failed, or CHIP_NO_ERROR
+     */
+    CHIP_ERROR EncryptBatch(const BatchMessage * messages, size_t count, size_t & outFailedIndex);
+
+    /**
+     * @brief
+     *   Decrypt several messages using keys established in the secure channel.
+     *
+     *   Equivalent to calling Decrypt() for each message in turn, but the cipher is set up with
+     *   the session key once per group of messages rather than once per message.
+     *
+     * @param messages Messages to decrypt
+     * @param count Number of entries in messages
+     * @param outFailedIndex Set to the index of the first message that could not be decrypted, or to
+     *                       count if none. All messages before it have been decrypted.
+     *
+     * @return CHIP_ERROR The result of decrypting the first message that failed, or CHIP_NO_ERROR
+     */
+    CHIP_ERROR DecryptBatch(const BatchMessage * messages, size_t count, size_t & outFailedIndex);
+
     /**
      * @brief
      *   Memory overhead of encrypting data. The overhead is indepedent of size of
@@ -46,6 +46,12 @@ using Transport::PeerConnectionState;
 // TODO: this should be checked within the transport message sending instead of the session management layer.
 static const size_t kMax_SecureSDU_Length = 1024;
 
+static_assert(SecureSessionMgrBase::kMessageReservedSize >= kMaxPacketHeaderSize + kMaxPayloadHeaderSize,
+              "Default packet buffer reservation is too small for the message headers");
+
+constexpr uint16_t SecureSessionMgrBase::kMessageReservedSize;
+constexpr uint16_t SecureSessionMgrBase::kMessageReservedTailSize;
+
 SecureSessionMgrBase::SecureSessionMgrBase() : mState(State::kNotReady) {}
 
 SecureSessionMgrBase::~SecureSessionMgrBase()
@@ -99,6 +105,7 @@ CHIP_ERROR SecureSessionMgrBase::SendMessage(PayloadHeader & payloadHeader, Node
     {
         uint8_t * data = nullptr;
         PacketHeader packetHeader;
+        Transport::PeerAddress peerAddress = state->GetPeerAddress();
         MessageAuthenticationCode mac;
 
         const uint16_t headerSize = payloadHeader.EncodeSizeBytes();
@@ -112,6 +119,13 @@ CHIP_ERROR SecureSessionMgrBase::SendMessage(PayloadHeader & payloadHeader, Node
         payloadLength = static_cast<uint32_t>(headerSize + msgBuf->TotalLength());
         VerifyOrExit(CanCastTo<uint16_t>(payloadLength), err = CHIP_ERROR_NO_MEMORY);
 
+        // Connections set up without an address are sent to wherever the resolver currently places the peer
+        if (!peerAddress.IsInitialized() && mPeerAddressResolver != nullptr)
+        {
+            err = mPeerAddressResolver->LookupPeerAddress(peerNodeId, peerAddress);
+            SuccessOrExit(err);
+        }
+
         packetHeader
             .SetSourceNodeId(mLocalNodeId)              //
             .SetDestinationNodeId(peerNodeId)           //
@@ -131,7 +145,7 @@ CHIP_ERROR SecureSessionMgrBase::SendMessage(PayloadHeader & payloadHeader, Node
         err = state->GetSecureSession().Encrypt(data, totalLen, data, packetHeader, payloadHeader.GetEncodePacketFlags(), mac);
         SuccessOrExit(err);
 
-        err = mac.Encode(packetHeader, &data[totalLen], kMaxTagLen, &taglen);
+        err = mac.Encode(packetHeader, &data[totalLen], msgBuf->AvailableDataLength(), &taglen);
         SuccessOrExit(err);
 
         VerifyOrExit(CanCastTo<uint16_t>(totalLen + taglen), err = CHIP_ERROR_INTERNAL);
@@ -139,7 +153,7 @@ CHIP_ERROR SecureSessionMgrBase::SendMessage(PayloadHeader & payloadHeader, Node
 
         ChipLogDetail(Inet, "Secure transport transmitting msg %u after encryption", state->GetSendMessageIndex());
 
-        err    = mTransport->SendMessage(packetHeader, payloadHeader.GetEncodePacketFlags(), state->GetPeerAddress(), msgBuf);
+        err    = mTransport->SendMessage(packetHeader, payloadHeader.GetEncodePacketFlags(), peerAddress, msgBuf);
         msgBuf = nullptr;
     }
     SuccessOrExit(err);
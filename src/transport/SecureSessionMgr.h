@@ -32,6 +32,7 @@
 #include <inet/IPEndPointBasis.h>
 #include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
+#include <transport/PeerAddressResolver.h>
 #include <transport/PeerConnections.h>
 #include <transport/SecurePairingSession.h>
 #include <transport/SecureSession.h>
@@ -93,6 +94,18 @@ public:
 class DLL_EXPORT SecureSessionMgrBase
 {
 public:
+    /**
+     * Number of bytes SendMessage() and the transports below it need in front of a message payload
+     * to prepend their headers without moving the payload.  Buffers returned by
+     * System::PacketBuffer::New() reserve this much by default.
+     */
+    static constexpr uint16_t kMessageReservedSize = CHIP_SYSTEM_CONFIG_HEADER_RESERVE_SIZE;
+
+    /**
+     * Number of bytes SendMessage() needs after a message payload for the message authentication tag.
+     */
+    static constexpr uint16_t kMessageReservedTailSize = kMaxTagLen;
+
     /**
      * @brief
      *   Send a message to a currently connected peer
@@ -115,6 +128,17 @@ public:
      */
     void SetDelegate(SecureSessionMgrDelegate * cb) { mCB = cb; }
 
+    /**
+     * @brief
+     *   Set the resolver consulted by SendMessage() for peers without an address.
+     *
+     * @details
+     *   The resolved address is used for the one message only and is not stored
+     *   in the connection state, so a peer that changes address is followed as
+     *   soon as the resolver learns about it.  Pass nullptr to disable lookups.
+     */
+    void SetPeerAddressResolver(Transport::PeerAddressResolver * resolver) { mPeerAddressResolver = resolver; }
+
     /**
      * @brief
      *   Establish a new pairing with a peer node
@@ -159,7 +183,8 @@ private:
     Transport::PeerConnections<CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE> mPeerConnections; // < Active connections to other peers
     State mState;                                                                       // < Initialization state of the object
 
-    SecureSessionMgrDelegate * mCB = nullptr;
+    SecureSessionMgrDelegate * mCB                        = nullptr;
+    Transport::PeerAddressResolver * mPeerAddressResolver = nullptr;
 
     /** Schedules a new oneshot timer for checking connection expiry. */
     void ScheduleExpiryTimer();
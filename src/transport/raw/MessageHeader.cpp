@@ -73,6 +73,11 @@ constexpr size_t kNodeIdSizeBytes = 8;
 /// size of a serialized vendor id inside a header
 constexpr size_t kVendorIdSizeBytes = 2;
 
+static_assert(kFixedUnencryptedHeaderSizeBytes + kNodeIdSizeBytes + kNodeIdSizeBytes == kMaxPacketHeaderSize,
+              "kMaxPacketHeaderSize does not match the packet header layout");
+static_assert(kEncryptedHeaderSizeBytes + kVendorIdSizeBytes == kMaxPayloadHeaderSize,
+              "kMaxPayloadHeaderSize does not match the payload header layout");
+
 /// Mask to extract just the version part from a 16bit header prefix.
 constexpr uint16_t kVersionMask = 0xF000;
 /// Shift to convert to/from a masked version 16bit value to a 4bit version.
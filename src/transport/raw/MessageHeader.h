@@ -39,6 +39,11 @@ static constexpr NodeId kUndefinedNodeId = 0ULL;
 static constexpr NodeId kAnyNodeId       = 0xFFFFFFFFFFFFFFFFULL;
 static constexpr size_t kMaxTagLen       = 16;
 
+/// Largest encoded size of a PacketHeader, i.e. with both node ids present.
+static constexpr uint16_t kMaxPacketHeaderSize = 26;
+/// Largest encoded size of a PayloadHeader, i.e. with the vendor id present.
+static constexpr uint16_t kMaxPayloadHeaderSize = 8;
+
 typedef int PacketHeaderFlags;
 
 namespace Header {
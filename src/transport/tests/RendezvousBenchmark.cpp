@@ -0,0 +1,447 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of RendezvousSession over UDP. It runs
+ *      commissioner and device sessions against each other over the IPv4
+ *      loopback interface, first one rendezvous at a time and then a given
+ *      number of them concurrently, and reports handshakes per second, the
+ *      latency of each PASE message and the CPU time spent in each phase.
+ *
+ *      Usage: RendezvousBenchmark [<concurrent sessions> [<handshakes>]]
+ *
+ *      Each rendezvous takes two UDP endpoints, so the concurrency is capped at
+ *      half of INET_CONFIG_NUM_UDP_ENDPOINTS, which the Linux platform keeps
+ *      small. Build with a larger pool to run more sessions at once, e.g.
+ *
+ *        gn gen out/bench --args='chip_inet_project_config_include="<transport/tests/RendezvousBenchmarkInetConfig.h>"'
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <core/CHIPCore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemClock.h>
+#include <transport/RendezvousSession.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+using namespace chip;
+using namespace chip::Inet;
+
+namespace {
+
+constexpr uint32_t kSetupPINCode        = 20202021;
+constexpr NodeId kControllerNodeId      = 112233;
+constexpr NodeId kDeviceNodeId          = 1;
+constexpr size_t kMaxRendezvous         = INET_CONFIG_NUM_UDP_ENDPOINTS / 2; // A commissioner and a device endpoint each
+constexpr size_t kDefaultHandshakes     = 32;
+constexpr uint64_t kRoundTimeoutUs      = 60 * 1000 * 1000;
+constexpr uint64_t kRendezvousTimeoutUs = 5 * 1000 * 1000;
+
+// The phases of a rendezvous. Each PASE phase covers the work that produces its message and the trip to the peer;
+// the cA phase ends when the device has verified cA, and network provisioning when the commissioner has the device
+// address.
+enum Phase : uint8_t
+{
+    kPhase_pA,
+    kPhase_pB_cB,
+    kPhase_cA,
+    kPhase_NetworkProvisioning,
+
+    kPhaseCount
+};
+
+const char * const kPhaseNames[kPhaseCount] = { "pA", "pB/cB", "cA", "network provisioning" };
+
+struct PhaseStats
+{
+    uint64_t mLatencyUs[kPhaseCount]    = {};
+    uint64_t mMaxLatencyUs[kPhaseCount] = {};
+    uint64_t mCpuUs[kPhaseCount]        = {};
+};
+
+// Thread CPU time at the last phase boundary of any rendezvous. Sessions only run from the IO loop, one message at a
+// time, so the CPU time spent since then belongs to the phase whose boundary comes next.
+uint64_t sLastCpuUs = 0;
+
+uint64_t GetThreadCpuTimeUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+uint64_t GetTimeUs()
+{
+    return System::Platform::Layer::GetClock_MonotonicHiRes();
+}
+
+/**
+ * Returns a UDP port that was free when probed, or 0 if none could be found.
+ */
+uint16_t GetFreePort(InetLayer & inet)
+{
+    UDPEndPoint * endPoint = nullptr;
+    uint16_t port          = 0;
+
+    VerifyOrExit(inet.NewUDPEndPoint(&endPoint) == INET_NO_ERROR, endPoint = nullptr);
+    VerifyOrExit(endPoint->Bind(kIPAddressType_IPv4, IPAddress::Any, 0) == INET_NO_ERROR, );
+    port = endPoint->GetBoundPort();
+
+exit:
+    if (endPoint != nullptr)
+    {
+        endPoint->Free();
+    }
+    return port;
+}
+
+class Rendezvous;
+class TimedSession;
+
+/**
+ * One end of a rendezvous: the delegate of its session, which maps the session events onto the rendezvous phases.
+ */
+class RendezvousSide : public RendezvousSessionDelegate
+{
+public:
+    RendezvousSide(Rendezvous & rendezvous, bool isController) : mRendezvous(rendezvous), mIsController(isController) {}
+
+    void Reset()
+    {
+        mPairingMessages = 0;
+        mComplete        = false;
+        mFailed          = false;
+    }
+
+    void OnPairingMessageSent();
+    void OnSecureMessageSent();
+
+    void OnRendezvousError(CHIP_ERROR err) override { mFailed = true; }
+    void OnRendezvousComplete() override;
+    void OnRendezvousStatusUpdate(Status status, CHIP_ERROR err) override;
+
+    TimedSession * mSession  = nullptr;
+    uint8_t mPairingMessages = 0;
+    bool mComplete           = false;
+    bool mFailed             = false;
+
+private:
+    Rendezvous & mRendezvous;
+    const bool mIsController;
+};
+
+/**
+ * A rendezvous session that reports the messages it hands to its transport.
+ */
+class TimedSession : public RendezvousSession
+{
+public:
+    TimedSession(RendezvousSide & side) : RendezvousSession(&side), mSide(side) {}
+
+    CHIP_ERROR SendPairingMessage(const PacketHeader & header, Header::Flags payloadFlags, System::PacketBuffer * msgBuf) override
+    {
+        CHIP_ERROR err = RendezvousSession::SendPairingMessage(header, payloadFlags, msgBuf);
+        mSide.OnPairingMessageSent();
+        return err;
+    }
+
+    CHIP_ERROR SendSecureMessage(Protocols::CHIPProtocolId protocol, uint8_t msgType, System::PacketBuffer * msgBuf) override
+    {
+        CHIP_ERROR err = RendezvousSession::SendSecureMessage(protocol, msgType, msgBuf);
+        mSide.OnSecureMessageSent();
+        return err;
+    }
+
+private:
+    RendezvousSide & mSide;
+};
+
+/**
+ * A commissioner and a device session pairing with each other over loopback UDP, on ports of their own.
+ */
+class Rendezvous
+{
+public:
+    CHIP_ERROR Start(InetLayer & inet, PhaseStats & stats)
+    {
+        CHIP_ERROR err            = CHIP_NO_ERROR;
+        const uint16_t devicePort = GetFreePort(inet);
+        IPAddress loopback;
+
+        IPAddress::FromString("127.0.0.1", loopback);
+
+        mController.Reset();
+        mDevice.Reset();
+        mStats   = &stats;
+        mActive  = true;
+        mStartUs = GetTimeUs();
+
+        VerifyOrExit(devicePort != 0, err = CHIP_ERROR_NO_ENDPOINT);
+
+        mDevice.mSession = chip::Platform::New<TimedSession>(mDevice);
+        VerifyOrExit(mDevice.mSession != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+        err = mDevice.mSession->Init(RendezvousParameters()
+                                         .SetSetupPINCode(kSetupPINCode)
+                                         .SetLocalNodeId(kDeviceNodeId)
+                                         .SetInetLayer(&inet)
+                                         .SetListenPort(devicePort)
+                                         .SetIPAddress(loopback));
+        SuccessOrExit(err);
+
+        mController.mSession = chip::Platform::New<TimedSession>(mController);
+        VerifyOrExit(mController.mSession != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+        // The device setup, which derives the PASE verifier, is not part of any phase.
+        sLastCpuUs    = GetThreadCpuTimeUs();
+        mPhaseStartUs = GetTimeUs();
+
+        err = mController.mSession->Init(RendezvousParameters()
+                                             .SetSetupPINCode(kSetupPINCode)
+                                             .SetLocalNodeId(kControllerNodeId)
+                                             .SetInetLayer(&inet)
+                                             .SetListenPort(GetFreePort(inet))
+                                             .SetPeerAddress(Transport::PeerAddress::UDP(loopback, devicePort)));
+        SuccessOrExit(err);
+
+    exit:
+        if (err != CHIP_NO_ERROR)
+        {
+            fprintf(stderr, "Failed to start a rendezvous: %s\n", ErrorStr(err));
+            mController.mFailed = true;
+        }
+        return err;
+    }
+
+    void Stop()
+    {
+        chip::Platform::Delete(mController.mSession);
+        chip::Platform::Delete(mDevice.mSession);
+        mController.mSession = nullptr;
+        mDevice.mSession     = nullptr;
+        mActive              = false;
+    }
+
+    bool IsActive() const { return mActive; }
+    bool IsComplete() const { return mController.mComplete && mDevice.mComplete; }
+    bool HasFailed() const
+    {
+        return mController.mFailed || mDevice.mFailed || (!IsComplete() && GetTimeUs() - mStartUs > kRendezvousTimeoutUs);
+    }
+
+    void Record(Phase phase, bool endsPhase)
+    {
+        const uint64_t cpuUs = GetThreadCpuTimeUs();
+
+        mStats->mCpuUs[phase] += cpuUs - sLastCpuUs;
+        sLastCpuUs = cpuUs;
+
+        if (endsPhase)
+        {
+            const uint64_t now       = GetTimeUs();
+            const uint64_t latencyUs = now - mPhaseStartUs;
+
+            mStats->mLatencyUs[phase] += latencyUs;
+            if (latencyUs > mStats->mMaxLatencyUs[phase])
+            {
+                mStats->mMaxLatencyUs[phase] = latencyUs;
+            }
+            mPhaseStartUs = now;
+        }
+    }
+
+    RendezvousSide mController{ *this, true };
+    RendezvousSide mDevice{ *this, false };
+
+private:
+    PhaseStats * mStats    = nullptr;
+    uint64_t mStartUs      = 0;
+    uint64_t mPhaseStartUs = 0;
+    bool mActive           = false;
+};
+
+void RendezvousSide::OnPairingMessageSent()
+{
+    if (!mIsController)
+    {
+        mRendezvous.Record(kPhase_pB_cB, true);
+    }
+    else if (mPairingMessages++ == 0)
+    {
+        mRendezvous.Record(kPhase_pA, true);
+    }
+    else
+    {
+        // The cA phase goes on until the device has verified cA.
+        mRendezvous.Record(kPhase_cA, false);
+    }
+}
+
+void RendezvousSide::OnSecureMessageSent()
+{
+    mRendezvous.Record(kPhase_NetworkProvisioning, false);
+}
+
+void RendezvousSide::OnRendezvousStatusUpdate(Status status, CHIP_ERROR err)
+{
+    switch (status)
+    {
+    case SecurePairingSuccess:
+        mRendezvous.Record(kPhase_cA, !mIsController);
+        break;
+
+    case NetworkProvisioningSuccess:
+        break;
+
+    default:
+        mFailed = true;
+        break;
+    }
+}
+
+void RendezvousSide::OnRendezvousComplete()
+{
+    mComplete = true;
+    mRendezvous.Record(kPhase_NetworkProvisioning, mIsController);
+}
+
+Rendezvous sRendezvous[kMaxRendezvous];
+
+/**
+ * Runs @p handshakes rendezvous, keeping @p concurrency of them in progress, and returns how many failed.
+ */
+size_t RunRendezvous(Test::IOContext & ctx, size_t concurrency, size_t handshakes, PhaseStats & stats, uint64_t & elapsedUs)
+{
+    const uint64_t start = GetTimeUs();
+    size_t started       = 0;
+    size_t finished      = 0;
+    size_t failed        = 0;
+
+    while (finished < handshakes && GetTimeUs() - start < kRoundTimeoutUs)
+    {
+        for (size_t i = 0; i < concurrency; i++)
+        {
+            Rendezvous & rendezvous = sRendezvous[i];
+
+            if (rendezvous.IsActive() && (rendezvous.IsComplete() || rendezvous.HasFailed()))
+            {
+                failed += rendezvous.HasFailed() ? 1 : 0;
+                finished++;
+                rendezvous.Stop();
+            }
+
+            if (!rendezvous.IsActive() && started < handshakes)
+            {
+                rendezvous.Start(ctx.GetInetLayer(), stats);
+                started++;
+            }
+        }
+
+        ctx.DriveIO();
+    }
+
+    for (Rendezvous & rendezvous : sRendezvous)
+    {
+        if (rendezvous.IsActive())
+        {
+            rendezvous.Stop();
+        }
+    }
+
+    elapsedUs = GetTimeUs() - start;
+    return failed + (handshakes - finished);
+}
+
+void Report(size_t concurrency, size_t handshakes, size_t failed, uint64_t elapsedUs, const PhaseStats & stats)
+{
+    const uint64_t rate = elapsedUs ? handshakes * 10000000 / elapsedUs : 0;
+
+    printf("Rendezvous over UDP, %u concurrent: %u handshakes (%u failed), %" PRIu64 ".%" PRIu64 " handshakes/s\n",
+           static_cast<unsigned>(concurrency), static_cast<unsigned>(handshakes), static_cast<unsigned>(failed), rate / 10,
+           rate % 10);
+
+    for (size_t phase = 0; phase < kPhaseCount; phase++)
+    {
+        printf("  %-20s latency %" PRIu64 " us (max %" PRIu64 " us), CPU %" PRIu64 " us\n", kPhaseNames[phase],
+               stats.mLatencyUs[phase] / handshakes, stats.mMaxLatencyUs[phase], stats.mCpuUs[phase] / handshakes);
+    }
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    Test::IOContext ctx;
+    size_t concurrency = kMaxRendezvous;
+    size_t handshakes  = kDefaultHandshakes;
+    size_t failed      = 0;
+
+    if (argc > 1)
+    {
+        concurrency = static_cast<size_t>(strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        handshakes = static_cast<size_t>(strtoul(argv[2], nullptr, 10));
+    }
+
+    if (concurrency == 0 || handshakes == 0)
+    {
+        fprintf(stderr, "Usage: %s [<concurrent sessions> [<handshakes>]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (concurrency > kMaxRendezvous)
+    {
+        fprintf(stderr, "%u UDP endpoints allow %u concurrent sessions at most\n",
+                static_cast<unsigned>(INET_CONFIG_NUM_UDP_ENDPOINTS), static_cast<unsigned>(kMaxRendezvous));
+        concurrency = kMaxRendezvous;
+    }
+
+    if (chip::Platform::MemoryInit() != CHIP_NO_ERROR || ctx.Init(nullptr) != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize\n");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t sessions : { static_cast<size_t>(1), concurrency })
+    {
+        PhaseStats stats;
+        uint64_t elapsedUs       = 0;
+        const size_t roundFailed = RunRendezvous(ctx, sessions, handshakes, stats, elapsedUs);
+
+        Report(sessions, handshakes, roundFailed, elapsedUs, stats);
+        failed += roundFailed;
+
+        if (concurrency == 1)
+        {
+            break;
+        }
+    }
+
+    ctx.Shutdown();
+    chip::Platform::MemoryShutdown();
+
+    return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,29 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Inet Layer project configuration for RendezvousBenchmark, selected
+ *          through the chip_inet_project_config_include build argument. It
+ *          enlarges the UDP endpoint pool so that the benchmark can run more
+ *          rendezvous concurrently than the platform default allows.
+ */
+
+#pragma once
+
+// Two endpoints per rendezvous, for 32 concurrent rendezvous.
+#define INET_CONFIG_NUM_UDP_ENDPOINTS 64
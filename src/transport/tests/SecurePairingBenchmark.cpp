@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the SPAKE2+ handshake of
+ *      SecurePairingSession. It runs full handshakes between the same two
+ *      sessions in memory, with the accessory deriving its verifier from the
+ *      PIN code every time and with a verifier computed once, and reports the
+ *      time a handshake takes with each.
+ *
+ *      Usage: SecurePairingBenchmark [<handshakes>]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <core/CHIPCore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemClock.h>
+#include <transport/SecurePairingSession.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr uint32_t kSetupPINCode      = 1234;
+constexpr uint32_t kPBKDFIterations   = 500;
+constexpr uint32_t kDefaultHandshakes = 100;
+
+const uint8_t kSalt[] = { 's', 'a', 'l', 't' };
+
+class BenchmarkPairingDelegate : public SecurePairingSessionDelegate
+{
+public:
+    CHIP_ERROR SendPairingMessage(const PacketHeader & header, Header::Flags payloadFlags, System::PacketBuffer * msgBuf) override
+    {
+        return mPeer->HandlePeerMessage(header, msgBuf);
+    }
+
+    void OnPairingError(CHIP_ERROR error) override { mError = error; }
+
+    void OnPairingComplete() override { mCompleted++; }
+
+    SecurePairingSession * mPeer = nullptr;
+    CHIP_ERROR mError            = CHIP_NO_ERROR;
+    uint32_t mCompleted          = 0;
+};
+
+SecurePairingSession * sCommissioner;
+SecurePairingSession * sAccessory;
+BenchmarkPairingDelegate sCommissionerDelegate;
+BenchmarkPairingDelegate sAccessoryDelegate;
+PASEVerifier sVerifier;
+
+CHIP_ERROR WaitWithPINCode()
+{
+    return sAccessory->WaitForPairing(kSetupPINCode, kPBKDFIterations, kSalt, sizeof(kSalt), Optional<NodeId>::Value(1), 0,
+                                      &sAccessoryDelegate);
+}
+
+CHIP_ERROR WaitWithVerifier()
+{
+    return sAccessory->WaitForPairing(sVerifier, Optional<NodeId>::Value(1), 0, &sAccessoryDelegate);
+}
+
+/**
+ * Runs the given number of handshakes, with the accessory waiting for each
+ * through waitForPairing.  Returns an error if one of them does not complete
+ * on both sides.
+ */
+CHIP_ERROR TimeHandshakes(const char * name, CHIP_ERROR (*waitForPairing)(), uint32_t handshakes)
+{
+    CHIP_ERROR err     = CHIP_NO_ERROR;
+    uint32_t completed = sCommissionerDelegate.mCompleted;
+    uint64_t start     = System::Platform::Layer::GetClock_MonotonicHiRes();
+    uint64_t elapsedUs;
+
+    for (uint32_t i = 0; i < handshakes; i++)
+    {
+        err = waitForPairing();
+        SuccessOrExit(err);
+        err = sCommissioner->Pair(kSetupPINCode, kPBKDFIterations, kSalt, sizeof(kSalt), Optional<NodeId>::Value(2), 0,
+                                  &sCommissionerDelegate);
+        SuccessOrExit(err);
+        SuccessOrExit(err = sAccessoryDelegate.mError);
+        SuccessOrExit(err = sCommissionerDelegate.mError);
+    }
+
+    elapsedUs = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+    VerifyOrExit(sCommissionerDelegate.mCompleted - completed == handshakes, err = CHIP_ERROR_INTERNAL);
+    VerifyOrExit(sAccessoryDelegate.mCompleted == sCommissionerDelegate.mCompleted, err = CHIP_ERROR_INTERNAL);
+
+    printf("%-10s %6" PRIu32 " handshakes %10" PRIu64 " us %8" PRIu64 " us/handshake\n", name, handshakes, elapsedUs,
+           elapsedUs / handshakes);
+
+exit:
+    return err;
+}
+
+CHIP_ERROR Run(uint32_t handshakes)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // The sessions are too large for the stack of some targets.
+    sCommissioner = Platform::New<SecurePairingSession>();
+    sAccessory    = Platform::New<SecurePairingSession>();
+    VerifyOrExit(sCommissioner != nullptr && sAccessory != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    sCommissionerDelegate.mPeer = sAccessory;
+    sAccessoryDelegate.mPeer    = sCommissioner;
+
+    err = TimeHandshakes("PIN code", WaitWithPINCode, handshakes);
+    SuccessOrExit(err);
+
+    err = SecurePairingSession::ComputePASEVerifier(kSetupPINCode, kPBKDFIterations, kSalt, sizeof(kSalt), sVerifier);
+    SuccessOrExit(err);
+
+    err = TimeHandshakes("verifier", WaitWithVerifier, handshakes);
+    SuccessOrExit(err);
+
+exit:
+    Platform::Delete(sCommissioner);
+    Platform::Delete(sAccessory);
+    return err;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    uint32_t handshakes = kDefaultHandshakes;
+    CHIP_ERROR err;
+
+    if (argc > 1)
+    {
+        handshakes = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2 || handshakes == 0)
+    {
+        fprintf(stderr, "Usage: %s [<handshakes>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    err = Platform::MemoryInit();
+    if (err == CHIP_NO_ERROR)
+    {
+        err = Run(handshakes);
+        Platform::MemoryShutdown();
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Pairing failed: %s\n", ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,306 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for RendezvousSession over UDP, which
+ *      run commissioner and device sessions against each other over the IPv4
+ *      loopback interface, through PASE and network provisioning.
+ */
+
+#include "TestTransportLayer.h"
+
+#include <string.h>
+
+#include <core/CHIPCore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <transport/RendezvousSession.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Inet;
+
+namespace {
+
+using TestContext = chip::Test::IOContext;
+TestContext sContext;
+
+constexpr uint32_t kSetupPINCode   = 20202021;
+constexpr NodeId kControllerNodeId = 112233;
+constexpr NodeId kDeviceNodeId     = 1;
+constexpr unsigned kTimeoutMs      = 5000;
+
+/**
+ * One end of a rendezvous: the delegate of its session, which records the session events.
+ */
+class RendezvousSide : public RendezvousSessionDelegate
+{
+public:
+    void OnRendezvousError(CHIP_ERROR err) override { mErrors++; }
+    void OnRendezvousComplete() override { mComplete = true; }
+    void OnRendezvousStatusUpdate(Status status, CHIP_ERROR err) override
+    {
+        mPaired      = mPaired || status == SecurePairingSuccess;
+        mProvisioned = mProvisioned || status == NetworkProvisioningSuccess;
+    }
+
+    uint8_t mErrors   = 0;
+    bool mPaired      = false;
+    bool mProvisioned = false;
+    bool mComplete    = false;
+};
+
+/**
+ * A rendezvous session that counts the pairing messages it hands to its transport.
+ */
+class CountingSession : public RendezvousSession
+{
+public:
+    CountingSession(RendezvousSide & side) : RendezvousSession(&side) {}
+
+    CHIP_ERROR SendPairingMessage(const PacketHeader & header, Header::Flags payloadFlags, System::PacketBuffer * msgBuf) override
+    {
+        mPairingMessages++;
+        return RendezvousSession::SendPairingMessage(header, payloadFlags, msgBuf);
+    }
+
+    uint8_t mPairingMessages = 0;
+};
+
+/**
+ * Returns an IPv4 UDP endpoint bound to a port the system picked, or nullptr.
+ */
+UDPEndPoint * NewBoundEndPoint(InetLayer & inet)
+{
+    UDPEndPoint * endPoint = nullptr;
+
+    VerifyOrExit(inet.NewUDPEndPoint(&endPoint) == INET_NO_ERROR, endPoint = nullptr);
+    if (endPoint->Bind(kIPAddressType_IPv4, IPAddress::Any, 0) != INET_NO_ERROR)
+    {
+        endPoint->Free();
+        endPoint = nullptr;
+    }
+
+exit:
+    return endPoint;
+}
+
+/**
+ * Returns a UDP port that was free when probed, so that the tests do not depend on a fixed port being available, or
+ * 0 if none could be found.
+ */
+uint16_t GetFreePort(InetLayer & inet)
+{
+    UDPEndPoint * endPoint = NewBoundEndPoint(inet);
+    uint16_t port          = 0;
+
+    if (endPoint != nullptr)
+    {
+        port = endPoint->GetBoundPort();
+        endPoint->Free();
+    }
+
+    return port;
+}
+
+CHIP_ERROR InitDevice(InetLayer & inet, uint16_t devicePort, RendezvousSession & device)
+{
+    IPAddress loopback;
+
+    IPAddress::FromString("127.0.0.1", loopback);
+
+    return device.Init(RendezvousParameters()
+                           .SetSetupPINCode(kSetupPINCode)
+                           .SetLocalNodeId(kDeviceNodeId)
+                           .SetInetLayer(&inet)
+                           .SetListenPort(devicePort)
+                           .SetIPAddress(loopback));
+}
+
+CHIP_ERROR InitController(InetLayer & inet, uint16_t devicePort, RendezvousSession & controller)
+{
+    IPAddress loopback;
+
+    IPAddress::FromString("127.0.0.1", loopback);
+
+    return controller.Init(RendezvousParameters()
+                               .SetSetupPINCode(kSetupPINCode)
+                               .SetLocalNodeId(kControllerNodeId)
+                               .SetInetLayer(&inet)
+                               .SetListenPort(GetFreePort(inet))
+                               .SetPeerAddress(Transport::PeerAddress::UDP(loopback, devicePort)));
+}
+
+void CheckRendezvous(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx         = *reinterpret_cast<TestContext *>(inContext);
+    const uint16_t devicePort = GetFreePort(ctx.GetInetLayer());
+    RendezvousSide controllerSide;
+    RendezvousSide deviceSide;
+    CountingSession controller(controllerSide);
+    CountingSession device(deviceSide);
+    IPAddress loopback;
+
+    IPAddress::FromString("127.0.0.1", loopback);
+
+    NL_TEST_ASSERT(inSuite, devicePort != 0);
+    NL_TEST_ASSERT(inSuite, InitDevice(ctx.GetInetLayer(), devicePort, device) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, InitController(ctx.GetInetLayer(), devicePort, controller) == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(kTimeoutMs, [&]() {
+        return (controllerSide.mComplete && deviceSide.mComplete) || controllerSide.mErrors != 0 || deviceSide.mErrors != 0;
+    });
+
+    NL_TEST_ASSERT(inSuite, controllerSide.mErrors == 0 && deviceSide.mErrors == 0);
+    NL_TEST_ASSERT(inSuite, controllerSide.mComplete && deviceSide.mComplete);
+    NL_TEST_ASSERT(inSuite, controllerSide.mPaired && deviceSide.mPaired);
+    NL_TEST_ASSERT(inSuite, controllerSide.mProvisioned && deviceSide.mProvisioned);
+    NL_TEST_ASSERT(inSuite, controller.mPairingMessages == 2);
+
+    // The commissioner learnt the address the device reported once paired.
+    NL_TEST_ASSERT(inSuite, controller.GetIPAddress() == loopback);
+}
+
+/**
+ * A datagram from a third endpoint reaches the device before the commissioner does. The device must not take its
+ * sender for its commissioner: it rejects the datagram, waits for pairing again, and the real commissioner pairs.
+ */
+void CheckRendezvousAfterJunk(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx           = *reinterpret_cast<TestContext *>(inContext);
+    const uint16_t devicePort   = GetFreePort(ctx.GetInetLayer());
+    UDPEndPoint * intruder      = NewBoundEndPoint(ctx.GetInetLayer());
+    System::PacketBuffer * junk = System::PacketBuffer::New();
+    RendezvousSide controllerSide;
+    RendezvousSide deviceSide;
+    CountingSession controller(controllerSide);
+    CountingSession device(deviceSide);
+    IPAddress loopback;
+    uint16_t headerSize = 0;
+
+    IPAddress::FromString("127.0.0.1", loopback);
+
+    NL_TEST_ASSERT(inSuite, devicePort != 0);
+    NL_TEST_ASSERT(inSuite, intruder != nullptr && junk != nullptr);
+    VerifyOrExit(intruder != nullptr && junk != nullptr, );
+
+    NL_TEST_ASSERT(inSuite, InitDevice(ctx.GetInetLayer(), devicePort, device) == CHIP_NO_ERROR);
+
+    // A well-formed packet header, so that the device transport hands the datagram to the session, followed by a
+    // payload that is no pairing message.
+    NL_TEST_ASSERT(inSuite,
+                   PacketHeader().SetSourceNodeId(kControllerNodeId).Encode(junk->Start(), junk->AvailableDataLength(), &headerSize,
+                                                                            Header::Flags()) == CHIP_NO_ERROR);
+    memset(junk->Start() + headerSize, 0xA5, 8);
+    junk->SetDataLength(static_cast<uint16_t>(headerSize + 8));
+
+    NL_TEST_ASSERT(inSuite, intruder->SendTo(loopback, devicePort, junk) == INET_NO_ERROR);
+    junk = nullptr;
+
+    ctx.DriveIOUntil(kTimeoutMs, [&deviceSide]() { return deviceSide.mErrors != 0; });
+
+    NL_TEST_ASSERT(inSuite, deviceSide.mErrors == 1);
+    NL_TEST_ASSERT(inSuite, !deviceSide.mPaired);
+
+    NL_TEST_ASSERT(inSuite, InitController(ctx.GetInetLayer(), devicePort, controller) == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(kTimeoutMs, [&]() {
+        return (controllerSide.mComplete && deviceSide.mComplete) || controllerSide.mErrors != 0 || deviceSide.mErrors > 1;
+    });
+
+    NL_TEST_ASSERT(inSuite, controllerSide.mErrors == 0 && deviceSide.mErrors == 1);
+    NL_TEST_ASSERT(inSuite, controllerSide.mComplete && deviceSide.mComplete);
+    NL_TEST_ASSERT(inSuite, controllerSide.mPaired && deviceSide.mPaired);
+    NL_TEST_ASSERT(inSuite, controller.mPairingMessages == 2);
+
+exit:
+    System::PacketBuffer::Free(junk);
+    if (intruder != nullptr)
+    {
+        intruder->Free();
+    }
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Rendezvous over UDP",              CheckRendezvous),
+    NL_TEST_DEF("Rendezvous over UDP after junk",   CheckRendezvousAfterJunk),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext);
+int Finalize(void * aContext);
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Test-CHIP-RendezvousSession",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+/**
+ *  Initialize the test suite.
+ */
+int Initialize(void * aContext)
+{
+    CHIP_ERROR err = chip::Platform::MemoryInit();
+    if (err == CHIP_NO_ERROR)
+    {
+        err = reinterpret_cast<TestContext *>(aContext)->Init(&sSuite);
+    }
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Finalize the test suite.
+ */
+int Finalize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    chip::Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+/**
+ *  Main
+ */
+int TestRendezvousSession()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRendezvousSession)
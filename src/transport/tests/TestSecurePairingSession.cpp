@@ -130,6 +130,48 @@ void SecurePairingHandshakeTest(nlTestSuite * inSuite, void * inContext)
     SecurePairingHandshakeTestCommon(inSuite, inContext, pairingCommissioner, delegateCommissioner);
 }
 
+void SecurePairingVerifierTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestSecurePairingDelegate delegateCommissioner;
+    TestSecurePairingDelegate delegateAccessory;
+    SecurePairingSession pairingCommissioner;
+    SecurePairingSession pairingAccessory;
+    PASEVerifier verifier;
+
+    delegateCommissioner.peer = &pairingAccessory;
+    delegateAccessory.peer    = &pairingCommissioner;
+
+    NL_TEST_ASSERT(inSuite,
+                   SecurePairingSession::ComputePASEVerifier(1234, 500, nullptr, 0, verifier) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite,
+                   SecurePairingSession::ComputePASEVerifier(1234, 500, (const uint8_t *) "salt", 4, verifier) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.WaitForPairing(verifier, Optional<NodeId>::Value(1), 0, nullptr) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The same verifier can be used for consecutive pairings
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       pairingAccessory.WaitForPairing(verifier, Optional<NodeId>::Value(1), 0, &delegateAccessory) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       pairingCommissioner.Pair(1234, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0,
+                                                &delegateCommissioner) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == i);
+        NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == i);
+    }
+
+    // A commissioner with the wrong PIN code must not complete pairing
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.WaitForPairing(verifier, Optional<NodeId>::Value(1), 0, &delegateAccessory) == CHIP_NO_ERROR);
+    pairingCommissioner.Pair(4321, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0, &delegateCommissioner);
+
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 2);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 2);
+}
+
 void SecurePairingDeserialize(nlTestSuite * inSuite, void * inContext, SecurePairingSession & pairingCommissioner,
                               SecurePairingSession & deserialized)
 {
@@ -198,6 +240,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("WaitInit",    SecurePairingWaitTest),
     NL_TEST_DEF("Start",       SecurePairingStartTest),
     NL_TEST_DEF("Handshake",   SecurePairingHandshakeTest),
+    NL_TEST_DEF("Verifier",    SecurePairingVerifierTest),
     NL_TEST_DEF("Serialize",   SecurePairingSerializeTest),
 
     NL_TEST_SENTINEL()
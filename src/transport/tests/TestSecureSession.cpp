@@ -156,6 +156,104 @@ void SecureChannelDecryptTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
 }
 
+void SecureChannelBatchTest(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageCount  = 12;
+    constexpr size_t kTamperedIndex = 5;
+
+    SecureSession channel;
+    SecureSession channel2;
+    uint8_t plain_text[kMessageCount][64];
+    uint8_t encrypted[kMessageCount][64];
+    uint8_t expected[kMessageCount][64];
+    uint8_t output[kMessageCount][64];
+    PacketHeader packetHeader[kMessageCount];
+    MessageAuthenticationCode mac[kMessageCount];
+    SecureSession::BatchMessage messages[kMessageCount];
+    size_t failedIndex = 0;
+
+    const char * info = "Test Info";
+    const char * salt = "Test Salt";
+
+    P256Keypair keypair;
+    NL_TEST_ASSERT(inSuite, keypair.Initialize() == CHIP_NO_ERROR);
+
+    P256Keypair keypair2;
+    NL_TEST_ASSERT(inSuite, keypair2.Initialize() == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        memset(plain_text[i], static_cast<int>(i), sizeof(plain_text[i]));
+        packetHeader[i].SetMessageId(static_cast<uint32_t>(100 + i)).SetSourceNodeId(static_cast<NodeId>(7));
+        messages[i] = { plain_text[i], 16 + 4 * i, encrypted[i], &packetHeader[i], Header::Flags(), &mac[i] };
+    }
+
+    // Uninitialized channel
+    NL_TEST_ASSERT(inSuite, channel.EncryptBatch(messages, kMessageCount, failedIndex) == CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    NL_TEST_ASSERT(inSuite,
+                   channel.Init(keypair, keypair2.Pubkey(), (const uint8_t *) salt, sizeof(salt), (const uint8_t *) info,
+                                sizeof(info)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   channel2.Init(keypair2, keypair.Pubkey(), (const uint8_t *) salt, sizeof(salt), (const uint8_t *) info,
+                                 sizeof(info)) == CHIP_NO_ERROR);
+
+    // The batch produces the same ciphertexts and tags as encrypting one message at a time
+    NL_TEST_ASSERT(inSuite, channel.EncryptBatch(messages, kMessageCount, failedIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failedIndex == kMessageCount);
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        PacketHeader header;
+        MessageAuthenticationCode singleMac;
+
+        header.SetMessageId(static_cast<uint32_t>(100 + i)).SetSourceNodeId(static_cast<NodeId>(7));
+        NL_TEST_ASSERT(inSuite,
+                       channel.Encrypt(plain_text[i], messages[i].mInputLength, expected[i], header, Header::Flags(), singleMac) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(expected[i], encrypted[i], messages[i].mInputLength) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(singleMac.GetTag(), mac[i].GetTag(), kMaxTagLen) == 0);
+        NL_TEST_ASSERT(inSuite, header.GetEncryptionType() == packetHeader[i].GetEncryptionType());
+    }
+
+    // Decrypt the batch on the peer
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        messages[i].mInput  = encrypted[i];
+        messages[i].mOutput = output[i];
+    }
+
+    NL_TEST_ASSERT(inSuite, channel2.DecryptBatch(messages, kMessageCount, failedIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failedIndex == kMessageCount);
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, memcmp(plain_text[i], output[i], messages[i].mInputLength) == 0);
+    }
+
+    // A tampered message stops the batch, and the messages before it are still decrypted
+    memset(output, 0, sizeof(output));
+    encrypted[kTamperedIndex][0] ^= 0x01;
+    NL_TEST_ASSERT(inSuite, channel2.DecryptBatch(messages, kMessageCount, failedIndex) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failedIndex == kTamperedIndex);
+    for (size_t i = 0; i < kTamperedIndex; i++)
+    {
+        NL_TEST_ASSERT(inSuite, memcmp(plain_text[i], output[i], messages[i].mInputLength) == 0);
+    }
+
+    NL_TEST_ASSERT(inSuite,
+                   channel2.DecryptBatch(&messages[kTamperedIndex + 1], kMessageCount - kTamperedIndex - 1, failedIndex) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failedIndex == kMessageCount - kTamperedIndex - 1);
+
+    // Invalid arguments
+    messages[2].mOutput = nullptr;
+    NL_TEST_ASSERT(inSuite, channel2.DecryptBatch(messages, kMessageCount, failedIndex) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, failedIndex == 2);
+    NL_TEST_ASSERT(inSuite, channel2.DecryptBatch(nullptr, 1, failedIndex) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, channel2.DecryptBatch(nullptr, 0, failedIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, failedIndex == 0);
+}
+
 // Test Suite
 
 /**
@@ -167,6 +265,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Init",    SecureChannelInitTest),
     NL_TEST_DEF("Encrypt", SecureChannelEncryptTest),
     NL_TEST_DEF("Decrypt", SecureChannelDecryptTest),
+    NL_TEST_DEF("Batch",   SecureChannelBatchTest),
 
     NL_TEST_SENTINEL()
 };
@@ -24,6 +24,7 @@
 #include "TestTransportLayer.h"
 
 #include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
 #include <support/CodeUtils.h>
 #include <transport/SecureSessionMgr.h>
 #include <transport/raw/tests/NetworkTestHelpers.h>
@@ -47,6 +48,11 @@ const char PAYLOAD[]                = "Hello!";
 constexpr NodeId kSourceNodeId      = 123654;
 constexpr NodeId kDestinationNodeId = 111222333;
 
+// Where the last message handed to the loopback transport started, and whether the packet header
+// could have been prepended to it without moving it.
+const uint8_t * sSentMessageStart = nullptr;
+bool sSentMessageHeaderFits       = false;
+
 class LoopbackTransport : public Transport::Base
 {
 public:
@@ -56,6 +62,9 @@ public:
     CHIP_ERROR SendMessage(const PacketHeader & header, Header::Flags payloadFlags, const PeerAddress & address,
                            System::PacketBuffer * msgBuf) override
     {
+        sSentMessageStart      = msgBuf->Start();
+        sSentMessageHeaderFits = msgBuf->ReservedSize() >= header.EncodeSizeBytes();
+
         HandleMessageReceived(header, address, msgBuf);
         return CHIP_NO_ERROR;
     }
@@ -75,7 +84,7 @@ public:
 
         size_t data_len = msgBuf->DataLength();
 
-        int compare = memcmp(msgBuf->Start(), PAYLOAD, data_len);
+        int compare = memcmp(msgBuf->Start(), ExpectedPayload, data_len);
         NL_TEST_ASSERT(mSuite, compare == 0);
 
         ReceiveHandlerCallCount++;
@@ -84,6 +93,7 @@ public:
     void OnNewConnection(PeerConnectionState * state, SecureSessionMgrBase * mgr) override { NewConnectionHandlerCallCount++; }
 
     nlTestSuite * mSuite              = nullptr;
+    const void * ExpectedPayload      = PAYLOAD;
     int ReceiveHandlerCallCount       = 0;
     int NewConnectionHandlerCallCount = 0;
 };
@@ -151,6 +161,79 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
 }
 
+void CheckMessageNoCopyTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    uint8_t expected[64];
+    TLV::TLVWriter writer;
+    uint32_t expectedLen;
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    // Reference encoding of the payload, for the receive callback to compare against.
+    writer.Init(expected, sizeof(expected));
+    NL_TEST_ASSERT(inSuite, writer.PutString(TLV::AnonymousTag, PAYLOAD) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    expectedLen = writer.GetLengthWritten();
+
+    // Encode the same payload straight into a buffer laid out for SendMessage.
+    chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::New(0);
+    NL_TEST_ASSERT(inSuite, buffer != nullptr);
+
+    writer.Init(buffer, buffer->MaxDataLength(), false, SecureSessionMgrBase::kMessageReservedSize,
+                SecureSessionMgrBase::kMessageReservedTailSize);
+    NL_TEST_ASSERT(inSuite, writer.PutString(TLV::AnonymousTag, PAYLOAD) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer->DataLength() == expectedLen);
+    NL_TEST_ASSERT(inSuite, buffer->ReservedSize() >= SecureSessionMgrBase::kMessageReservedSize);
+    NL_TEST_ASSERT(inSuite, buffer->AvailableDataLength() >= SecureSessionMgrBase::kMessageReservedTailSize);
+
+    const uint8_t * payloadStart = buffer->Start();
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SecureSessionMgr<LoopbackTransport> conn;
+
+    err = conn.Init(kSourceNodeId, ctx.GetInetLayer().SystemLayer(), "LOOPBACK");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite          = inSuite;
+    callback.ExpectedPayload = expected;
+
+    conn.SetDelegate(&callback);
+
+    SecurePairingUsingTestSecret pairing1(Optional<NodeId>::Value(kSourceNodeId), 1, 2);
+    Optional<Transport::PeerAddress> peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+
+    err = conn.NewPairing(peer, &pairing1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    SecurePairingUsingTestSecret pairing2(Optional<NodeId>::Value(kDestinationNodeId), 2, 1);
+    err = conn.NewPairing(peer, &pairing2);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.ReceiveHandlerCallCount = 0;
+    sSentMessageStart                = nullptr;
+    sSentMessageHeaderFits           = false;
+
+    err = conn.SendMessage(kDestinationNodeId, buffer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return callback.ReceiveHandlerCallCount != 0; });
+
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
+
+    // The payload header was prepended in front of the encoded payload, which was encrypted in
+    // place: the payload was never moved on its way to the transport.
+    NL_TEST_ASSERT(inSuite, sSentMessageStart + PayloadHeader().EncodeSizeBytes() == payloadStart);
+    NL_TEST_ASSERT(inSuite, sSentMessageHeaderFits);
+
+    callback.ExpectedPayload = PAYLOAD;
+}
+
 // Test Suite
 
 /**
@@ -161,6 +244,7 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Simple Init Test",              CheckSimpleInitTest),
     NL_TEST_DEF("Message Self Test",             CheckMessageTest),
+    NL_TEST_DEF("Message No Copy Test",          CheckMessageNoCopyTest),
 
     NL_TEST_SENTINEL()
 };
@@ -30,6 +30,7 @@ extern "C" {
 
 int TestMessageHeader(void);
 int TestPeerConnectionsFn(void);
+int TestRendezvousSession(void);
 int TestSecurePairingSession(void);
 int TestSecureSession(void);
 int TestSecureSessionMgr(void);